@@ -874,15 +874,30 @@ void MultiHeadAttentionLayer::incremental_forwarding(RunLayerContext &context,
   unsigned int max_timestep =
     std::get<props::MaxTimestep>(multi_head_attention_props).get();
 
+  NNTR_THROW_IF(_to <= _from, std::invalid_argument)
+    << "invalid incremental step from " << _from << " to " << _to
+    << " for layer " << context.getName();
+
   bool cache_shift = false;
   unsigned int from = _from;
   unsigned int to = _to;
   if (to >= max_timestep) {
+    NNTR_THROW_IF(to - from != 1, std::invalid_argument)
+      << "only a single step can shift the cache of layer "
+      << context.getName();
     cache_shift = true;
     from = max_timestep - 1;
     to = max_timestep;
   }
 
+  /**
+   * the to - from steps are held from the first row of the inputs and
+   * outputs, and their keys and values are written to rows [from, to) of the
+   * cache. Rows past @a to are not read, so rejected steps are rolled back by
+   * starting the next call from where they began.
+   */
+  const unsigned int steps = to - from;
+
   const bool disable_bias =
     std::get<props::DisableBias>(*layer_impl_props).get();
 
@@ -1095,44 +1110,44 @@ void MultiHeadAttentionLayer::incremental_forwarding(RunLayerContext &context,
   apply_rotary_emb_tensor(cache_key_step, projected_key_dim_prop, _from);
 
   projected_query_step.reshape(
-    TensorDim({batch_size, 1, num_heads, projected_query_dim_prop}));
+    TensorDim({batch_size, steps, num_heads, projected_query_dim_prop}));
   cached_key.reshape(
     TensorDim({batch_size, to, num_heads, projected_key_dim_prop}));
   cached_value.reshape(
     TensorDim({batch_size, to, num_heads, projected_value_dim_prop}));
 
-  projected_query_step.transpose("1:0:2", projected_query_step);
+  /** a single step has the same layout in heads as in positions */
+  Tensor query_heads = steps == 1 ? projected_query_step
+                                  : projected_query_step.transpose("1:0:2");
   cached_key.transpose("1:0:2", projected_key_step);
   cached_value.transpose("1:0:2", projected_value_step);
 
-  projected_query_step.reshape(
-    TensorDim({batch_size * num_heads, 1, 1, projected_query_dim_prop}));
+  query_heads.reshape(
+    TensorDim({batch_size * num_heads, 1, steps, projected_query_dim_prop}));
   projected_key_step.reshape(
     TensorDim({batch_size * num_heads, 1, to, projected_key_dim_prop}));
   projected_value_step.reshape(
     TensorDim({batch_size * num_heads, 1, to, projected_value_dim_prop}));
 
-  attention_weight_step.reshape(TensorDim({batch_size * num_heads, 1, 1, to}));
+  attention_weight_step.reshape(
+    TensorDim({batch_size * num_heads, 1, steps, to}));
   attention_output_step.reshape(
-    TensorDim({batch_size * num_heads, 1, 1, projected_value_dim_prop}));
+    TensorDim({batch_size * num_heads, 1, steps, projected_value_dim_prop}));
 
   /** scaled dot product attention */
-  projected_query_step.dotBatched(projected_key_step, attention_weight_step,
-                                  false, true);
+  query_heads.dotBatched(projected_key_step, attention_weight_step, false,
+                         true);
   attention_weight_step.multiply_i(1 / sqrt((float)projected_query_dim_prop));
 
-  if (!from) {
-    unsigned int mask_size = attention_weight_step.getDim().width();
-    unsigned int mask_dim_height = mask_size;
-    unsigned int mask_dim_width = mask_size;
-
-    Tensor causal_mask(TensorDim{1, 1, mask_size, mask_size,
-                                 attention_weight_step.getTensorType()});
+  /** a step can see every cached position up to its own */
+  if (steps > 1) {
+    Tensor causal_mask(
+      TensorDim{1, 1, steps, to, attention_weight_step.getTensorType()});
 
     causal_mask.setZero();
 
-    for (unsigned int i = 0; i < mask_dim_height; ++i) {
-      for (unsigned int j = i + 1; j < mask_dim_width; ++j) {
+    for (unsigned int i = 0; i < steps; ++i) {
+      for (unsigned int j = from + i + 1; j < to; ++j) {
         causal_mask.setValue(
           0, 0, i, j, _MASK_NUM(attention_weight.getTensorType().data_type));
       }
@@ -28,6 +28,7 @@
 #include <custom_multi_head_attention_layer.h>
 #include <engine.h>
 #include <optional>
+#include <prefix_cache.h>
 #include <rms_norm.h>
 #include <rotary_embedding.h>
 #include <swiglu.h>
@@ -46,6 +47,9 @@ using ModelHandle = std::unique_ptr<ml::train::Model>;
 
 ModelHandle g_model;
 
+/** key / value caches of prompt prefixes shared across runs */
+nntrainer::PrefixCache g_prefix_cache;
+
 // Hyper params for LLaMA
 int const DIM = 2304;
 int const INTERMEDIATE_SIZE = 2048;
@@ -590,8 +594,22 @@ void run(std::string text, std::string vocab_file_path,
 
   std::vector<int64_t> token_ids;
 
-  auto output =
-    g_model->incremental_inference(1, input, label, MAX_SEQ_LEN, 0, input_len);
+  std::vector<unsigned int> prompt(input_sample, input_sample + input_len);
+  std::vector<float *> output;
+
+  /** prefill starts past the longest prefix cached by a former run */
+  unsigned int cached_len = g_prefix_cache.restore(*g_model, prompt);
+  if (cached_len == 0) {
+    output = g_model->incremental_inference(1, input, label, MAX_SEQ_LEN, 0,
+                                            input_len);
+  } else {
+    /** the uncached tail is a single step, held from the first row */
+    for (unsigned int i = cached_len; i < input_len; ++i)
+      input_sample[i - cached_len] = static_cast<float>(prompt[i]);
+    output = g_model->incremental_inference(1, input, label, MAX_SEQ_LEN,
+                                            cached_len, input_len);
+  }
+  g_prefix_cache.store(*g_model, prompt);
 
   unsigned int ids = std::distance(
     output[0], std::max_element(output[0], output[0] + NUM_VOCAB));
@@ -698,20 +716,32 @@ std::wstring decodeUnicodeEscape(const std::wstring &input) {
   return result.str();
 }
 #endif
-int main(int argc, char *argv[]) {
-  // Setting locale
-  std::locale::global(std::locale("ko_KR.UTF-8"));
-
-  std::string text = "";
 
+/**
+ * @brief read the next prompt, a line from the terminal
+ *
+ * @param[out] text prompt read
+ * @return true if a prompt is read, false at the end of the input
+ */
+bool readPrompt(std::string &text) {
 #if defined(ENABLE_ENCODER)
-  // Getting arguments From terminal
   std::wstring input;
-  std::getline(std::wcin, input);
+  if (!std::getline(std::wcin, input))
+    return false;
   std::wstring test = decodeUnicodeEscape(input);
   std::wstring_convert<std::codecvt_utf16<wchar_t>> converter;
   text = converter.to_bytes(test);
+  return true;
+#else
+  /** the prompt is fixed without the encoder, a line just runs it again */
+  return static_cast<bool>(std::getline(std::cin, text));
 #endif
+}
+
+int main(int argc, char *argv[]) {
+  // Setting locale
+  std::locale::global(std::locale("ko_KR.UTF-8"));
+
   auto &ct_engine = nntrainer::Engine::Global();
   auto app_context =
     static_cast<nntrainer::AppContext *>(ct_engine.getRegisteredContext("cpu"));
@@ -764,7 +794,11 @@ int main(int argc, char *argv[]) {
 
     createAndRun(epoch, batch_size, weight_path);
 
-    run(text, vocab_file_name, merge_file_name, apply_temp);
+    /** every line is a prompt, and the prefill of a prompt starts past the
+     * longest prefix it shares with the prompts before it */
+    std::string text;
+    while (readPrompt(text))
+      run(text, vocab_file_name, merge_file_name, apply_temp);
 
   } catch (const std::exception &e) {
     std::cerr << "uncaught error while running! details: " << e.what()
@@ -0,0 +1,214 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file unittest_llama_speculative.cpp
+ * @date 18 Oct 2026
+ * @brief unittest of multi step incremental inference of the LLaMA layers
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <app_context.h>
+#include <engine.h>
+#include <layer_context.h>
+#include <neuralnet.h>
+#include <nntrainer_test_util.h>
+#include <speculative_decoder.h>
+
+#include <custom_multi_head_attention_layer.h>
+#include <rms_norm.h>
+#include <swiglu.h>
+
+static constexpr unsigned int VOCAB = 11;
+static constexpr unsigned int MAX_LEN = 16;
+
+/**
+ * @brief register the custom layers of the application once
+ */
+static void registerLayers() {
+  static std::once_flag registered;
+  std::call_once(registered, []() {
+    auto app_context = static_cast<nntrainer::AppContext *>(
+      nntrainer::Engine::Global().getRegisteredContext("cpu"));
+    app_context->registerFactory(
+      nntrainer::createLayer<custom::MultiHeadAttentionLayer>);
+    app_context->registerFactory(nntrainer::createLayer<custom::SwiGLULayer>);
+    app_context->registerFactory(nntrainer::createLayer<custom::RMSNormLayer>);
+  });
+}
+
+/**
+ * @brief a single decoder layer shaped as the one of the application, of
+ * token ids 1:1:MAX_LEN to logits, with random weights
+ *
+ * @param dim units of the embedding
+ */
+static std::unique_ptr<nntrainer::NeuralNetwork> makeLLaMA(unsigned int dim) {
+  registerLayers();
+
+  std::unique_ptr<nntrainer::NeuralNetwork> nn(new nntrainer::NeuralNetwork());
+  nn->setProperty({"batch_size=1"});
+
+  const std::string ffn_unit = "unit=" + std::to_string(2 * dim);
+  auto graph = makeGraph({
+    {"input", {"name=in", "input_shape=1:1:" + std::to_string(MAX_LEN)}},
+    {"embedding",
+     {"name=emb", "input_layers=in", "in_dim=" + std::to_string(VOCAB),
+      "out_dim=" + std::to_string(dim)}},
+    {"rms_norm", {"name=attention_norm", "input_layers=emb", "epsilon=1e-6"}},
+    {"custom_multi_head_attention",
+     {"name=attention", "num_heads=2", "disable_bias=true",
+      "max_timestep=" + std::to_string(MAX_LEN),
+      "input_layers=attention_norm,attention_norm,attention_norm"}},
+    {"addition", {"name=attention_add", "input_layers=emb,attention"}},
+    {"rms_norm",
+     {"name=ffn_norm", "input_layers=attention_add", "epsilon=1e-6"}},
+    {"fully_connected",
+     {"name=ffn_1", "input_layers=ffn_norm", ffn_unit, "disable_bias=true"}},
+    {"fully_connected",
+     {"name=ffn_2", "input_layers=ffn_norm", ffn_unit, "disable_bias=true"}},
+    {"swiglu", {"name=ffn_swiglu", "input_layers=ffn_1,ffn_2"}},
+    {"fully_connected",
+     {"name=ffn_output", "input_layers=ffn_swiglu",
+      "unit=" + std::to_string(dim), "disable_bias=true"}},
+    {"addition", {"name=ffn_add", "input_layers=attention_add,ffn_output"}},
+    {"rms_norm", {"name=output_norm", "input_layers=ffn_add", "epsilon=1e-6"}},
+    {"fully_connected",
+     {"name=logits", "input_layers=output_norm",
+      "unit=" + std::to_string(VOCAB), "disable_bias=true"}},
+  });
+  for (auto &node : graph) {
+    nn->addLayer(node);
+  }
+
+  nn->compile(ml::train::ExecutionMode::INFERENCE);
+  nn->initialize(ml::train::ExecutionMode::INFERENCE);
+
+  /** weights are not initialized for inference */
+  nn->allocate(ml::train::ExecutionMode::INFERENCE);
+  nn->forEachLayer(
+    [](ml::train::Layer &, nntrainer::RunLayerContext &rc, void *) {
+      for (unsigned int i = 0; i < rc.getNumWeights(); ++i)
+        rc.getWeight(i).setRandNormal(0.0f, 0.3f);
+    });
+  return nn;
+}
+
+/**
+ * @brief run an incremental step and copy the logits of its positions
+ */
+static std::vector<float> runSteps(nntrainer::NeuralNetwork &model,
+                                   const std::vector<unsigned int> &tokens,
+                                   unsigned int from) {
+  std::vector<float> input(MAX_LEN, 0.0f);
+  std::copy(tokens.begin(), tokens.end(), input.begin());
+
+  unsigned int to = from + tokens.size();
+  auto out = model.incremental_inference(1, {input.data()}, {}, MAX_LEN, from,
+                                         to, true);
+  return std::vector<float>(out[0], out[0] + tokens.size() * VOCAB);
+}
+
+/**
+ * @brief greedy decoding of the model one token at a time
+ */
+static std::vector<unsigned int>
+greedyDecode(nntrainer::NeuralNetwork &model, const std::vector<unsigned int> &prompt,
+             unsigned int max_tokens) {
+  auto argmax = [](const float *logits) {
+    return static_cast<unsigned int>(std::max_element(logits, logits + VOCAB) -
+                                     logits);
+  };
+
+  auto logits = runSteps(model, prompt, 0);
+  unsigned int pos = prompt.size();
+  std::vector<unsigned int> generated = {
+    argmax(logits.data() + (pos - 1) * VOCAB)};
+  while (generated.size() < max_tokens && pos + 1 < MAX_LEN) {
+    logits = runSteps(model, {generated.back()}, pos++);
+    generated.push_back(argmax(logits.data()));
+  }
+  return generated;
+}
+
+/**
+ * @brief steps of several positions give the logits of prefilling them all
+ */
+TEST(llama_speculative, multi_step_01_p) {
+  auto model = makeLLaMA(8);
+  std::vector<unsigned int> tokens = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3};
+
+  auto expected = runSteps(*model, tokens, 0);
+
+  std::vector<float> actual = runSteps(*model, {3, 1, 4}, 0);
+  for (auto [from, to] : std::vector<std::pair<unsigned int, unsigned int>>{
+         {3, 4}, {4, 7}, {7, 8}, {8, 10}}) {
+    std::vector<unsigned int> step_tokens(tokens.begin() + from,
+                                          tokens.begin() + to);
+    auto step = runSteps(*model, step_tokens, from);
+    actual.insert(actual.end(), step.begin(), step.end());
+  }
+
+  ASSERT_EQ(actual.size(), expected.size());
+  for (unsigned int i = 0; i < expected.size(); ++i)
+    EXPECT_NEAR(actual[i], expected[i], 1e-4) << "at " << i;
+}
+
+/**
+ * @brief greedy speculative decoding reproduces greedy decoding of the target
+ */
+TEST(llama_speculative, greedy_01_p) {
+  auto target = makeLLaMA(8);
+  auto draft = makeLLaMA(4);
+  std::vector<unsigned int> prompt = {2, 7, 1};
+
+  auto expected = greedyDecode(*target, prompt, 10);
+
+  nntrainer::SpeculativeDecoder decoder(*target, *draft, VOCAB, 3);
+  auto generated = decoder.generate(prompt, 10);
+
+  EXPECT_EQ(generated, expected);
+  EXPECT_GT(decoder.getNumDrafted(), 0u);
+}
+
+/**
+ * @brief every proposal of a draft identical to the target is accepted
+ */
+TEST(llama_speculative, greedy_same_draft_01_p) {
+  const std::string weights = "llama_speculative_target.bin";
+  auto target = makeLLaMA(8);
+  auto draft = makeLLaMA(8);
+  target->save(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  draft->load(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  std::remove(weights.c_str());
+
+  std::vector<unsigned int> prompt = {5, 3, 9};
+  auto expected = greedyDecode(*target, prompt, 12);
+
+  nntrainer::SpeculativeDecoder decoder(*target, *draft, VOCAB, 4);
+  auto generated = decoder.generate(prompt, 12);
+
+  EXPECT_EQ(generated, expected);
+  EXPECT_GT(decoder.getNumDrafted(), 0u);
+  EXPECT_EQ(decoder.getNumAccepted(), decoder.getNumDrafted());
+}
+
+/**
+ * @brief a step of several positions can not shift the cache
+ */
+TEST(llama_speculative, shift_01_n) {
+  auto model = makeLLaMA(8);
+  runSteps(*model, std::vector<unsigned int>(MAX_LEN - 1, 1), 0);
+  EXPECT_THROW(runSteps(*model, {1, 2}, MAX_LEN - 1), std::invalid_argument);
+}
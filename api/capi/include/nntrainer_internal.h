@@ -324,6 +324,22 @@ typedef struct {
 int ml_train_model_get_all_layer_names(ml_train_model_h model,
                                        const char **layers_name[]);
 
+/**
+ * @brief Get the runtime metrics of the model.
+ * @details Use this function to get the latency histograms of the layers and
+ * the phases of the model, and the memory, cache and swap byte counters, as a
+ * JSON string. These are kept regardless of the profile build.
+ * @since_tizen 6.x
+ * @note The caller must free the metrics string.
+ * @param[in] model The NNTrainer model handler.
+ * @param[out] metrics The runtime metrics of the model in JSON.
+ * @return @c 0 on success. Otherwise a negative error value.
+ * @retval #ML_ERROR_NONE Successful.
+ * @retval #ML_ERROR_INVALID_PARAMETER Invalid parameter.
+ * @retval #ML_ERROR_OUT_OF_MEMORY Failed to allocate the string.
+ */
+int ml_train_model_get_metrics(ml_train_model_h model, char **metrics);
+
 /**
  * @brief Callback function to notify completion of training of the model.
  * @since_tizen 6.0
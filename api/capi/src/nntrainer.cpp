@@ -480,6 +480,74 @@ int ml_train_model_get_summary(ml_train_model_h model,
   return status;
 }
 
+static int ml_train_model_get_metrics_util(ml_train_model_h model,
+                                           std::stringstream &ss) {
+  int status = ML_ERROR_NONE;
+  ml_train_model *nnmodel;
+  std::shared_ptr<ml::train::Model> m;
+
+  {
+    ML_TRAIN_GET_VALID_MODEL_LOCKED(nnmodel, model);
+    ML_TRAIN_ADOPT_LOCK(nnmodel, model_lock);
+
+    m = nnmodel->model;
+  }
+
+  returnable f = [&]() {
+    ml::train::RuntimeMetrics metrics = m->getRuntimeMetrics();
+
+    ss << "{\"memory_pool_bytes\":" << metrics.memory_pool_bytes
+       << ",\"cache_pool_bytes\":" << metrics.cache_pool_bytes
+       << ",\"swap_read_bytes\":" << metrics.swap_read_bytes
+       << ",\"swap_write_bytes\":" << metrics.swap_write_bytes
+       << ",\"latencies\":[";
+    for (size_t i = 0; i < metrics.latencies.size(); ++i) {
+      auto &l = metrics.latencies[i];
+      ss << (i ? "," : "") << "{\"name\":\"" << l.name
+         << "\",\"count\":" << l.count << ",\"p50_us\":" << l.p50_us
+         << ",\"p99_us\":" << l.p99_us << ",\"max_us\":" << l.max_us
+         << ",\"total_us\":" << l.total_us << "}";
+    }
+    ss << "]}";
+    return ML_ERROR_NONE;
+  };
+
+  status = nntrainer_exception_boundary(f);
+  return status;
+}
+
+int ml_train_model_get_metrics(ml_train_model_h model, char **metrics) {
+  int status = ML_ERROR_NONE;
+  std::stringstream ss;
+
+  check_feature_state();
+
+  ML_TRAIN_VERIFY_VALID_HANDLE(model);
+
+  if (metrics == nullptr) {
+    ml_loge("metrics pointer is null");
+    return ML_ERROR_INVALID_PARAMETER;
+  }
+
+  status = ml_train_model_get_metrics_util(model, ss);
+  if (status != ML_ERROR_NONE) {
+    ml_loge("failed to get the metrics: %d", status);
+    return status;
+  }
+
+  std::string str = ss.str();
+  const std::string::size_type size = str.size();
+
+  *metrics = (char *)malloc((size + 1) * sizeof(char));
+  if (*metrics == nullptr) {
+    ml_loge("failed to malloc");
+    return ML_ERROR_OUT_OF_MEMORY;
+  }
+  std::memcpy(*metrics, str.c_str(), size + 1);
+
+  return status;
+}
+
 int ml_train_model_add_layer(ml_train_model_h model, ml_train_layer_h layer) {
   int status = ML_ERROR_NONE;
   ml_train_model *nnmodel;
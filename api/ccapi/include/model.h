@@ -18,6 +18,7 @@
 
 #if __cplusplus >= MIN_CPP_VERSION
 
+#include <cstdint>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -60,6 +61,39 @@ struct RunStats {
     num_correct_predictions(0) {}
 };
 
+/**
+ * @brief     Latency distribution of a layer or a phase of the model
+ */
+struct LatencyStats {
+  std::string name; /** "<layer>:<phase>" or "model:<phase>" */
+  uint64_t count;   /** number of recorded runs */
+  double p50_us;    /** estimated median in microseconds */
+  double p99_us;    /** estimated 99th percentile in microseconds */
+  double max_us;    /** largest latency in microseconds */
+  double total_us;  /** sum of the latencies in microseconds */
+};
+
+/**
+ * @brief     Always-on metrics from running or training a model
+ * @note      byte counters are shared by every model in the process
+ */
+struct RuntimeMetrics {
+  std::vector<LatencyStats> latencies; /** latencies which were recorded */
+  uint64_t memory_pool_bytes; /** bytes currently held by memory pools */
+  uint64_t cache_pool_bytes;  /** bytes currently loaded by cache pools */
+  uint64_t swap_read_bytes;   /** bytes read from swap devices */
+  uint64_t swap_write_bytes;  /** bytes written to swap devices */
+
+  /**
+   * @brief     Initializer of RuntimeMetrics
+   */
+  RuntimeMetrics() :
+    memory_pool_bytes(0),
+    cache_pool_bytes(0),
+    swap_read_bytes(0),
+    swap_write_bytes(0) {}
+};
+
 /**
  * @brief     Enumeration of Network Type
  */
@@ -390,6 +424,19 @@ public:
    */
   virtual RunStats getTestStats() = 0;
 
+  /**
+   * @brief     Get latency histograms of the layers and phases, and the
+   * memory, cache and swap byte counters
+   * @note      these are kept in every build, unlike the profiler
+   * @retval    runtime metrics, empty if the model does not keep them
+   */
+  virtual RuntimeMetrics getRuntimeMetrics() { return RuntimeMetrics(); }
+
+  /**
+   * @brief     Clear the latency histograms and the swap byte counters
+   */
+  virtual void resetRuntimeMetrics() {}
+
   /**
    * @brief     allocate tensor according to execution mode
    */
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   benchmark_cl_gemm.cpp
+ * @date   18 Oct 2026
+ * @brief  benchmark of the OpenCL gemm with the naive kernels, the default
+ * tiled configuration and the tuned tiled configuration
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ */
+#include <vector>
+
+#include <blas_kernel_interface.h>
+#include <cl_kernel_tuner.h>
+#include <tensor.h>
+
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/**
+ * @brief kernels the gemm runs with
+ */
+enum class ClGemmMode {
+  NAIVE,   /**< one output per work item */
+  DEFAULT, /**< tiled kernel with the configuration of the shapes not tuned */
+  TUNED,   /**< tiled kernel with the configuration tuned ahead of time */
+};
+
+/**
+ * @brief set up the tuner of the (M x K) X (K x N) product for the mode
+ */
+void setMode(ClGemmMode mode, const nntrainer::Tensor &A,
+             const nntrainer::Tensor &B) {
+  auto &tuner = nntrainer::ClKernelTuner::getInstance();
+  unsigned int M = A.height(), K = A.width(), N = B.width();
+  const std::vector<unsigned int> shape = {1, M, N, K, K, N, N};
+
+  tuner.clear();
+  switch (mode) {
+  case ClGemmMode::NAIVE:
+    /// an invalid configuration selects the naive kernel
+    tuner.set("sgemm_cl_tiled", shape, {});
+    break;
+  case ClGemmMode::DEFAULT:
+    break;
+  case ClGemmMode::TUNED:
+    tuner.setTuning(true);
+    nntrainer::dotCl(A, B);
+    tuner.setTuning(false);
+    break;
+  }
+}
+
+/**
+ * @brief set the counters shared by the benchmarks
+ */
+void setCounters(benchmark::State &state) {
+  double M = state.range(0), N = state.range(1), K = state.range(2);
+  state.counters["GFLOP/s"] = benchmark::Counter(
+    2.0 * M * N * K * state.iterations(), benchmark::Counter::kIsRate,
+    benchmark::Counter::kIs1000);
+}
+
+} // namespace
+
+/**
+ * @brief (M x K) X (K x N) product with the kernels of the mode
+ */
+template <ClGemmMode mode> static void BM_ClGemm(benchmark::State &state) {
+  nntrainer::Tensor A(1, 1, state.range(0), state.range(2));
+  nntrainer::Tensor B(1, 1, state.range(2), state.range(1));
+  A.setRandUniform(-1.0f, 1.0f);
+  B.setRandUniform(-1.0f, 1.0f);
+  setMode(mode, A, B);
+
+  for (auto _ : state) {
+    nntrainer::Tensor C = nntrainer::dotCl(A, B);
+    benchmark::DoNotOptimize(C.getData());
+  }
+  setCounters(state);
+  nntrainer::ClKernelTuner::getInstance().clear();
+}
+
+/**
+ * @brief one time cost of tuning a shape, which is paid ahead of time
+ */
+static void BM_ClGemmTuning(benchmark::State &state) {
+  nntrainer::Tensor A(1, 1, state.range(0), state.range(2));
+  nntrainer::Tensor B(1, 1, state.range(2), state.range(1));
+  A.setRandUniform(-1.0f, 1.0f);
+  B.setRandUniform(-1.0f, 1.0f);
+
+  auto &tuner = nntrainer::ClKernelTuner::getInstance();
+  for (auto _ : state) {
+    tuner.clear();
+    tuner.setTuning(true);
+    nntrainer::Tensor C = nntrainer::dotCl(A, B);
+    tuner.setTuning(false);
+    benchmark::DoNotOptimize(C.getData());
+  }
+  tuner.clear();
+}
+
+/** M, N, K */
+#define CL_GEMM_SHAPES                                                         \
+  Args({64, 768, 768})                                                         \
+    ->Args({128, 3072, 768})                                                   \
+    ->Args({512, 512, 512})                                                    \
+    ->Args({37, 129, 65})
+
+BENCHMARK_TEMPLATE(BM_ClGemm, ClGemmMode::NAIVE)->CL_GEMM_SHAPES;
+BENCHMARK_TEMPLATE(BM_ClGemm, ClGemmMode::DEFAULT)->CL_GEMM_SHAPES;
+BENCHMARK_TEMPLATE(BM_ClGemm, ClGemmMode::TUNED)->CL_GEMM_SHAPES;
+BENCHMARK(BM_ClGemmTuning)->CL_GEMM_SHAPES->Iterations(3);
+BENCHMARK_MAIN();
@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   benchmark_data_parallel.cpp
+ * @date   18 Oct 2026
+ * @brief  benchmark of the scaling of data parallel training over the worker
+ * processes of a host
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ *
+ * Every worker trains an epoch of the same number of the batches, so the
+ * samples trained per second grow with the workers as long as the cores and
+ * the ring keep up. The time of an epoch is the time of the slowest worker.
+ */
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <data_parallel.h>
+#include <databuffer.h>
+#include <func_data_producer.h>
+#include <layer.h>
+#include <neuralnet.h>
+#include <optimizer.h>
+
+#include "benchmark/benchmark.h"
+
+namespace {
+
+constexpr unsigned int WIDTH = 256;
+constexpr unsigned int BATCH = 32;
+constexpr unsigned int NUM_BATCHES = 16;
+constexpr unsigned int BASE_PORT = 29500;
+
+/**
+ * @brief samples of a worker, input and label of WIDTH each
+ */
+struct Samples {
+  std::vector<float> data; /**< input and label of every sample */
+  unsigned int idx = 0;    /**< next sample */
+};
+
+/**
+ * @brief generate the samples of a worker
+ */
+int generate(float **input, float **label, bool *last, void *user_data) {
+  auto samples = reinterpret_cast<Samples *>(user_data);
+  const float *sample = samples->data.data() + samples->idx * 2 * WIDTH;
+  std::copy(sample, sample + WIDTH, input[0]);
+  std::copy(sample + WIDTH, sample + 2 * WIDTH, label[0]);
+
+  *last = ++samples->idx == NUM_BATCHES * BATCH;
+  if (*last)
+    samples->idx = 0;
+  return 0;
+}
+
+/**
+ * @brief train an epoch of three fully connected layers, and get the
+ * nanoseconds it took
+ *
+ * @param data_parallel workers to train with, or nullptr to train alone
+ */
+long long trainEpoch(std::shared_ptr<nntrainer::DataParallel> data_parallel,
+                     unsigned int seed) {
+  Samples samples;
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  samples.data.resize(NUM_BATCHES * BATCH * 2 * WIDTH);
+  for (auto &x : samples.data)
+    x = dist(rng);
+
+  nntrainer::NeuralNetwork nn;
+  nn.setProperty({"batch_size=" + std::to_string(BATCH), "epochs=1"});
+  const std::string unit = "unit=" + std::to_string(WIDTH);
+  nn.addLayer(ml::train::createLayer(
+    "input", {"name=in", "input_shape=1:1:" + std::to_string(WIDTH)}));
+  nn.addLayer(ml::train::createLayer("fully_connected",
+                                     {"name=fc1", unit, "activation=tanh"}));
+  nn.addLayer(ml::train::createLayer("fully_connected",
+                                     {"name=fc2", unit, "activation=tanh"}));
+  nn.addLayer(ml::train::createLayer("fully_connected", {"name=fc3", unit}));
+  nn.addLayer(ml::train::createLayer("mse", {"name=loss"}));
+  nn.setOptimizer(ml::train::createOptimizer("sgd", {"learning_rate=0.01"}));
+  nn.setDataBuffer(
+    nntrainer::DatasetModeType::MODE_TRAIN,
+    std::make_shared<nntrainer::DataBuffer>(
+      std::make_unique<nntrainer::FuncDataProducer>(generate, &samples)));
+  if (data_parallel)
+    nn.setDataParallel(data_parallel);
+
+  nn.compile(ml::train::ExecutionMode::TRAIN);
+  nn.initialize(ml::train::ExecutionMode::TRAIN);
+
+  auto start = std::chrono::steady_clock::now();
+  nn.train();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now() - start)
+    .count();
+}
+
+/**
+ * @brief run an epoch on each of world_size worker processes, and get the
+ * seconds of the slowest one, or a negative value if a worker failed
+ *
+ * @param data_parallel the workers train as the replicas of a model, or
+ * alone if false
+ */
+double runWorkers(unsigned int world_size, bool data_parallel,
+                  unsigned int port) {
+  std::vector<pid_t> pids;
+  std::vector<int> fds;
+  for (unsigned int rank = 0; rank < world_size; ++rank) {
+    int fd[2];
+    if (pipe(fd) != 0)
+      return -1.0;
+
+    pid_t pid = fork();
+    if (pid == 0) {
+      close(fd[0]);
+      long long ns = -1;
+      try {
+        std::shared_ptr<nntrainer::DataParallel> dp;
+        if (data_parallel)
+          dp = std::make_shared<nntrainer::DataParallel>(rank, world_size,
+                                                         port);
+        ns = trainEpoch(dp, rank);
+      } catch (...) {
+      }
+      ssize_t written = write(fd[1], &ns, sizeof(ns));
+      close(fd[1]);
+      _exit(written == sizeof(ns) ? 0 : 1);
+    }
+
+    close(fd[1]);
+    pids.push_back(pid);
+    fds.push_back(fd[0]);
+  }
+
+  long long slowest = 0;
+  for (unsigned int rank = 0; rank < world_size; ++rank) {
+    long long ns = -1;
+    if (read(fds[rank], &ns, sizeof(ns)) != sizeof(ns))
+      ns = -1;
+    close(fds[rank]);
+    waitpid(pids[rank], nullptr, 0);
+    slowest = (ns < 0 || slowest < 0) ? -1 : std::max(slowest, ns);
+  }
+  return slowest < 0 ? -1.0 : slowest * 1e-9;
+}
+
+} // namespace
+
+/**
+ * @brief an epoch on every worker, which trains as a replica of the others if
+ * data_parallel, or alone otherwise, as the bound of the scaling
+ */
+template <bool data_parallel>
+static void BM_DataParallel(benchmark::State &state) {
+  unsigned int world_size = state.range(0);
+  unsigned int port = BASE_PORT + (getpid() % 1000) * 8;
+
+  for (auto _ : state) {
+    double seconds = runWorkers(world_size, data_parallel, port);
+    if (seconds < 0) {
+      state.SkipWithError("a worker failed");
+      break;
+    }
+    state.SetIterationTime(seconds);
+  }
+  state.counters["samples"] =
+    benchmark::Counter(state.iterations() * world_size * NUM_BATCHES * BATCH,
+                       benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_TEMPLATE(BM_DataParallel, true)
+  ->Arg(1)
+  ->Arg(2)
+  ->Arg(4)
+  ->UseManualTime()
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DataParallel, false)
+  ->Arg(1)
+  ->Arg(2)
+  ->Arg(4)
+  ->UseManualTime()
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_MAIN();
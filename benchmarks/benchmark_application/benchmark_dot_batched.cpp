@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   benchmark_dot_batched.cpp
+ * @date   18 Oct 2026
+ * @brief  benchmark of the attention shaped batched matrix products
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ */
+#include <tensor.h>
+
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/**
+ * @brief tensors of one attention step, batch is batch_size * num_heads
+ */
+struct AttentionTensors {
+  nntrainer::Tensor query;
+  nntrainer::Tensor key;
+  nntrainer::Tensor value;
+  nntrainer::Tensor score;
+  nntrainer::Tensor context;
+
+  /**
+   * @brief allocate the tensors of the given shape
+   */
+  AttentionTensors(unsigned int batch, unsigned int seq, unsigned int dim) :
+    query(batch, 1, seq, dim),
+    key(batch, 1, seq, dim),
+    value(batch, 1, seq, dim),
+    score(batch, 1, seq, seq),
+    context(batch, 1, seq, dim) {
+    query.setRandUniform(-1.0f, 1.0f);
+    key.setRandUniform(-1.0f, 1.0f);
+    value.setRandUniform(-1.0f, 1.0f);
+  }
+};
+
+/**
+ * @brief set the counters shared by the benchmarks
+ */
+void setCounters(benchmark::State &state) {
+  double batch = state.range(0), seq = state.range(1), dim = state.range(2);
+  /// two products of seq x seq x dim multiply-adds per batch
+  state.counters["GFLOP/s"] =
+    benchmark::Counter(4.0 * batch * seq * seq * dim * state.iterations(),
+                       benchmark::Counter::kIsRate,
+                       benchmark::Counter::kIs1000);
+}
+
+} // namespace
+
+/**
+ * @brief score and context products with one dot per batch slice
+ */
+static void BM_AttentionPerSlice(benchmark::State &state) {
+  AttentionTensors t(state.range(0), state.range(1), state.range(2));
+
+  for (auto _ : state) {
+    for (unsigned int b = 0; b < t.query.batch(); ++b) {
+      nntrainer::Tensor score_b = t.score.getBatchSlice(b, 1);
+      nntrainer::Tensor context_b = t.context.getBatchSlice(b, 1);
+      t.query.getBatchSlice(b, 1).dot(t.key.getBatchSlice(b, 1), score_b,
+                                      false, true);
+      score_b.dot(t.value.getBatchSlice(b, 1), context_b);
+    }
+    benchmark::DoNotOptimize(t.context.getData());
+  }
+  setCounters(state);
+}
+
+/**
+ * @brief score and context products with the strided batched gemm
+ */
+static void BM_AttentionBatched(benchmark::State &state) {
+  AttentionTensors t(state.range(0), state.range(1), state.range(2));
+
+  for (auto _ : state) {
+    t.query.dotBatched(t.key, t.score, false, true);
+    t.score.dotBatched(t.value, t.context);
+    benchmark::DoNotOptimize(t.context.getData());
+  }
+  setCounters(state);
+}
+
+/** batch * heads, sequence length, head dimension */
+#define ATTENTION_SHAPES                                                       \
+  Args({8, 64, 64})                                                            \
+    ->Args({32, 128, 64})                                                      \
+    ->Args({96, 32, 32})                                                       \
+    ->Args({12, 512, 64})
+
+BENCHMARK(BM_AttentionPerSlice)->ATTENTION_SHAPES;
+BENCHMARK(BM_AttentionBatched)->ATTENTION_SHAPES;
+BENCHMARK_MAIN();
@@ -0,0 +1,769 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   benchmark_kernels.cpp
+ * @date   18 Oct 2026
+ * @brief  benchmark of the cpu_backend kernels and the Tensor operations over
+ * shapes and data types, compared against the roofline of the machine
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ *
+ * @note every kernel runs both on the architecture backend (x86 or ARM) and
+ * on the fallback implementation where there is one. Each benchmark reports
+ * GFLOP/s, GB/s and the fraction of the attainable roofline performance. Run
+ * with --benchmark_out=<file> --benchmark_out_format=json to keep the results
+ * for comparison across commits, e.g. with compare.py of Google Benchmark.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cpu_backend.h>
+#include <fallback_internal.h>
+#include <tensor.h>
+
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/**
+ * @brief peak performance the kernels are compared against
+ */
+struct Roofline {
+  double flops;     /**< attainable floating point operations per second */
+  double bandwidth; /**< attainable bytes per second from main memory */
+} roofline = {1.0, 1.0};
+
+/**
+ * @brief forward a kernel of the implementation
+ */
+#define KERNEL(name, target)                                                   \
+  template <typename... Args> static decltype(auto) name(Args &&...args) {     \
+    return target(std::forward<Args>(args)...);                                \
+  }
+
+/**
+ * @brief kernels of the architecture backend behind cpu_backend.h
+ */
+struct Backend {
+  KERNEL(sgemm, nntrainer::sgemm)
+  KERNEL(sgemm_strided_batched, nntrainer::sgemm_strided_batched)
+  KERNEL(sgemv, nntrainer::sgemv)
+  KERNEL(sdot, nntrainer::sdot)
+  KERNEL(saxpy, nntrainer::saxpy)
+  KERNEL(sscal, nntrainer::sscal)
+  KERNEL(snrm2, nntrainer::snrm2)
+  KERNEL(scopy, nntrainer::scopy)
+  KERNEL(scopy_int4_to_float32, nntrainer::scopy_int4_to_float32)
+  KERNEL(scopy_int8_to_float32, nntrainer::scopy_int8_to_float32)
+  KERNEL(copy_s16_fp32, nntrainer::copy_s16_fp32)
+  KERNEL(copy_u16_fp32, nntrainer::copy_u16_fp32)
+  KERNEL(ele_mul, nntrainer::ele_mul)
+  KERNEL(ele_add, nntrainer::ele_add)
+  KERNEL(ele_sub, nntrainer::ele_sub)
+  KERNEL(ele_div, nntrainer::ele_div)
+  KERNEL(softmax, nntrainer::softmax)
+  KERNEL(swiglu, nntrainer::swiglu)
+  KERNEL(max_val, nntrainer::max_val)
+  KERNEL(sine, nntrainer::sine)
+  KERNEL(cosine, nntrainer::cosine)
+  KERNEL(inv_sqrt_inplace, nntrainer::inv_sqrt_inplace)
+  KERNEL(is_valid, nntrainer::is_valid)
+  KERNEL(transpose_matrix, nntrainer::transpose_matrix)
+  KERNEL(gemm_epilogue, nntrainer::gemm_epilogue)
+  KERNEL(quantize_rows_s8, nntrainer::quantize_rows_s8)
+  KERNEL(qgemm_s8, nntrainer::qgemm_s8)
+#if defined(__aarch64__) || defined(__ARM_ARCH_7A__) || defined(__arm__)
+  KERNEL(calc_trigonometric_vals_dup, nntrainer::calc_trigonometric_vals_dup)
+#endif
+#ifdef ENABLE_FP16
+  KERNEL(scopy_int4_to_float16, nntrainer::scopy_int4_to_float16)
+  KERNEL(scopy_int8_to_float16, nntrainer::scopy_int8_to_float16)
+#endif
+};
+
+/**
+ * @brief kernels of the architecture independent fallback
+ */
+struct Fallback {
+  KERNEL(sgemm, nntrainer::__fallback_sgemm)
+  KERNEL(sgemm_strided_batched, nntrainer::__fallback_sgemm_strided_batched)
+  KERNEL(sgemv, nntrainer::__fallback_sgemv)
+  KERNEL(sdot, nntrainer::__fallback_sdot)
+  KERNEL(saxpy, nntrainer::__fallback_saxpy)
+  KERNEL(sscal, nntrainer::__fallback_sscal)
+  KERNEL(snrm2, nntrainer::__fallback_snrm2)
+  KERNEL(scopy, nntrainer::__fallback_scopy)
+  KERNEL(scopy_int4_to_float32, nntrainer::__fallback_scopy_int4_to_float32)
+  KERNEL(scopy_int8_to_float32, nntrainer::__fallback_scopy_int8_to_float32)
+  KERNEL(copy_s16_fp32, nntrainer::__fallback_copy_s16_fp32)
+  KERNEL(copy_u16_fp32, nntrainer::__fallback_copy_u16_fp32)
+  KERNEL(ele_mul, nntrainer::__fallback_ele_mul)
+  KERNEL(ele_add, nntrainer::__fallback_ele_add)
+  KERNEL(ele_sub, nntrainer::__fallback_ele_sub)
+  KERNEL(ele_div, nntrainer::__fallback_ele_div)
+  KERNEL(softmax, nntrainer::__fallback_softmax)
+  KERNEL(swiglu, nntrainer::__fallback_swiglu)
+  KERNEL(max_val, nntrainer::__fallback_max)
+  KERNEL(sine, nntrainer::__fallback_sine)
+  KERNEL(cosine, nntrainer::__fallback_cosine)
+  KERNEL(inv_sqrt_inplace, nntrainer::__fallback_inv_sqrt_inplace)
+  KERNEL(is_valid, nntrainer::__fallback_isValid)
+  KERNEL(transpose_matrix, nntrainer::__fallback_transpose_matrix)
+  KERNEL(gemm_epilogue, nntrainer::__fallback_gemm_epilogue)
+  KERNEL(quantize_rows_s8, nntrainer::__fallback_quantize_rows_s8)
+  KERNEL(qgemm_s8, nntrainer::__fallback_qgemm_s8)
+#ifdef ENABLE_FP16
+  KERNEL(scopy_int4_to_float16, nntrainer::__fallback_scopy_int4_to_float16)
+  KERNEL(scopy_int8_to_float16, nntrainer::__fallback_scopy_int8_to_float16)
+#endif
+};
+
+#undef KERNEL
+
+/**
+ * @brief buffer of @a n random values in [lo, hi)
+ */
+template <typename T>
+std::vector<T> randomBuffer(size_t n, float lo = -1.0f, float hi = 1.0f) {
+  static std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(lo, hi);
+  std::vector<T> buf(n);
+  for (auto &v : buf)
+    v = static_cast<T>(dist(rng));
+  return buf;
+}
+
+/**
+ * @brief set throughput counters and the fraction of the roofline
+ *
+ * @param state benchmark state
+ * @param flops floating point operations of an iteration
+ * @param bytes bytes moved from and to memory by an iteration
+ */
+void setCounters(benchmark::State &state, double flops, double bytes) {
+  using benchmark::Counter;
+  state.counters["GFLOP/s"] =
+    Counter(flops, Counter::kIsIterationInvariantRate, Counter::kIs1000);
+  state.counters["GB/s"] =
+    Counter(bytes, Counter::kIsIterationInvariantRate, Counter::kIs1000);
+
+  /// attainable performance is bound by the compute or the memory roof, the
+  /// fraction exceeds 1 when the data is served from the caches
+  double seconds_at_roof =
+    std::max(flops / roofline.flops, bytes / roofline.bandwidth);
+  state.counters["roofline"] =
+    Counter(seconds_at_roof, Counter::kIsIterationInvariantRate);
+}
+
+/** vector lengths fitting in L1, L2 and only in main memory */
+void VectorSizes(benchmark::internal::Benchmark *b) {
+  b->ArgName("N");
+  for (int n : {4 << 10, 64 << 10, 4 << 20})
+    b->Arg(n);
+}
+
+/** square matrices, and the skinny products of token by token inference */
+void GemmShapes(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"M", "N", "K"});
+  for (int n : {64, 256, 512, 1024})
+    b->Args({n, n, n});
+  b->Args({1, 4096, 1024});
+  b->Args({16, 4096, 1024});
+  b->Args({256, 64, 4096});
+}
+
+/** attention heads of the batched products */
+void BatchedShapes(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"batch", "seq", "dim"});
+  b->Args({32, 128, 64});
+  b->Args({32, 512, 64});
+}
+
+/** square matrices of the matrix vector products */
+void GemvShapes(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"N", "trans"});
+  for (int n : {256, 1024, 4096})
+    for (int trans : {0, 1})
+      b->Args({n, trans});
+}
+
+/** matrices of the transposes and the epilogues */
+void MatrixShapes(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"M", "N"});
+  for (int n : {64, 512, 2048})
+    b->Args({n, n});
+  b->Args({128, 4096});
+}
+
+/**
+ * @brief general matrix product
+ */
+template <typename Impl, typename T> void BM_Sgemm(benchmark::State &state) {
+  unsigned int M = state.range(0), N = state.range(1), K = state.range(2);
+  auto A = randomBuffer<T>((size_t)M * K);
+  auto B = randomBuffer<T>((size_t)K * N);
+  std::vector<T> C((size_t)M * N);
+
+  for (auto _ : state) {
+    Impl::sgemm(0, false, false, M, N, K, 1.0f, A.data(), K, B.data(), N, 0.0f,
+                C.data(), N);
+    benchmark::DoNotOptimize(C.data());
+  }
+  setCounters(state, 2.0 * M * N * K,
+              sizeof(T) * ((double)M * K + (double)K * N + (double)M * N));
+}
+
+/**
+ * @brief batched products of attention heads, seq x seq x head dim
+ */
+template <typename Impl, typename T>
+void BM_SgemmStridedBatched(benchmark::State &state) {
+  unsigned int batch = state.range(0), seq = state.range(1),
+               dim = state.range(2);
+  size_t stride = (size_t)seq * dim;
+  auto Q = randomBuffer<T>(batch * stride);
+  auto K = randomBuffer<T>(batch * stride);
+  std::vector<T> S((size_t)batch * seq * seq);
+
+  for (auto _ : state) {
+    Impl::sgemm_strided_batched(0, false, true, batch, seq, seq, dim, 1.0f,
+                                Q.data(), dim, stride, K.data(), dim, stride,
+                                0.0f, S.data(), seq, (size_t)seq * seq);
+    benchmark::DoNotOptimize(S.data());
+  }
+  setCounters(state, 2.0 * batch * seq * seq * dim,
+              sizeof(T) * (2.0 * batch * stride + (double)S.size()));
+}
+
+/**
+ * @brief matrix vector product
+ */
+template <typename Impl, typename T> void BM_Sgemv(benchmark::State &state) {
+  unsigned int N = state.range(0);
+  bool trans = state.range(1);
+  auto A = randomBuffer<T>((size_t)N * N);
+  auto X = randomBuffer<T>(N);
+  std::vector<T> Y(N);
+
+  for (auto _ : state) {
+    Impl::sgemv(0, trans, N, N, 1.0f, A.data(), N, X.data(), 1, 0.0f, Y.data(),
+                1);
+    benchmark::DoNotOptimize(Y.data());
+  }
+  setCounters(state, 2.0 * N * N, sizeof(T) * ((double)N * N + 2.0 * N));
+}
+
+/**
+ * @brief dot product
+ */
+template <typename Impl> void BM_Sdot(benchmark::State &state) {
+  unsigned int N = state.range(0);
+  auto X = randomBuffer<float>(N), Y = randomBuffer<float>(N);
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(Impl::sdot(N, X.data(), 1, Y.data(), 1));
+  setCounters(state, 2.0 * N, 8.0 * N);
+}
+
+/**
+ * @brief Y = alpha * X + Y
+ */
+template <typename Impl> void BM_Saxpy(benchmark::State &state) {
+  unsigned int N = state.range(0);
+  auto X = randomBuffer<float>(N), Y = randomBuffer<float>(N);
+
+  for (auto _ : state) {
+    Impl::saxpy(N, 1e-3f, X.data(), 1, Y.data(), 1);
+    benchmark::DoNotOptimize(Y.data());
+  }
+  setCounters(state, 2.0 * N, 12.0 * N);
+}
+
+/**
+ * @brief X = alpha * X
+ */
+template <typename Impl> void BM_Sscal(benchmark::State &state) {
+  unsigned int N = state.range(0);
+  auto X = randomBuffer<float>(N);
+
+  for (auto _ : state) {
+    Impl::sscal(N, 1.0f, X.data(), 1);
+    benchmark::DoNotOptimize(X.data());
+  }
+  setCounters(state, N, 8.0 * N);
+}
+
+/**
+ * @brief euclidean norm
+ */
+template <typename Impl> void BM_Snrm2(benchmark::State &state) {
+  unsigned int N = state.range(0);
+  auto X = randomBuffer<float>(N);
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(Impl::snrm2(N, X.data(), 1));
+  setCounters(state, 2.0 * N, 4.0 * N);
+}
+
+/**
+ * @brief index of the largest absolute value, backend only
+ */
+void BM_Isamax(benchmark::State &state) {
+  unsigned int N = state.range(0);
+  auto X = randomBuffer<float>(N);
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(nntrainer::isamax(N, X.data(), 1));
+  setCounters(state, N, 4.0 * N);
+}
+
+/**
+ * @brief copy and conversion to float of @a Src
+ */
+template <typename Impl, typename Src>
+void BM_CopyToFloat(benchmark::State &state) {
+  unsigned int N = state.range(0);
+  auto X = randomBuffer<Src>(N, 0.0f, 100.0f);
+  std::vector<float> Y(N);
+
+  for (auto _ : state) {
+    if constexpr (std::is_same_v<Src, float>)
+      Impl::scopy(N, X.data(), 1, Y.data(), 1);
+    else if constexpr (std::is_same_v<Src, int8_t>)
+      Impl::scopy_int8_to_float32(N, X.data(), 1, Y.data(), 1);
+    else if constexpr (std::is_same_v<Src, int16_t>)
+      Impl::copy_s16_fp32(N, X.data(), Y.data());
+    else
+      Impl::copy_u16_fp32(N, X.data(), Y.data());
+    benchmark::DoNotOptimize(Y.data());
+  }
+  setCounters(state, 0, (sizeof(Src) + sizeof(float)) * (double)N);
+}
+
+/**
+ * @brief unpacking of two int4 values per byte to float
+ */
+template <typename Impl> void BM_CopyInt4ToFloat(benchmark::State &state) {
+  unsigned int N = state.range(0);
+  auto X = randomBuffer<uint8_t>(N / 2, 0.0f, 255.0f);
+  std::vector<float> Y(N);
+
+  for (auto _ : state) {
+    Impl::scopy_int4_to_float32(N / 2, X.data(), 1, Y.data(), 1);
+    benchmark::DoNotOptimize(Y.data());
+  }
+  setCounters(state, 0, N / 2.0 + 4.0 * N);
+}
+
+/**
+ * @brief elementwise operations, Z = X op Y
+ */
+enum class EleOp { MUL, ADD, SUB, DIV };
+
+/**
+ * @brief elementwise operation of the benchmark template
+ */
+template <typename Impl, EleOp op>
+void BM_Elementwise(benchmark::State &state) {
+  unsigned int N = state.range(0);
+  auto X = randomBuffer<float>(N), Y = randomBuffer<float>(N, 1.0f, 2.0f);
+  std::vector<float> Z(N);
+
+  for (auto _ : state) {
+    switch (op) {
+    case EleOp::MUL:
+      Impl::ele_mul(N, X.data(), Y.data(), Z.data(), 1.0f, 0.0f, 1, 1);
+      break;
+    case EleOp::ADD:
+      Impl::ele_add(N, X.data(), Y.data(), Z.data(), 1.0f, 0.0f, 1, 1);
+      break;
+    case EleOp::SUB:
+      Impl::ele_sub(N, X.data(), Y.data(), Z.data(), 1.0f, 0.0f, 1, 1);
+      break;
+    case EleOp::DIV:
+      Impl::ele_div(N, X.data(), Y.data(), Z.data(), 1.0f, 0.0f, 1, 1);
+      break;
+    }
+    benchmark::DoNotOptimize(Z.data());
+  }
+  setCounters(state, N, 12.0 * N);
+}
+
+/**
+ * @brief activations and reductions of one input, counted as @a flops per
+ * element
+ */
+enum class UnaryOp { SOFTMAX, MAX, SINE, COSINE, INV_SQRT, IS_VALID };
+
+/**
+ * @brief unary operation of the benchmark template
+ */
+template <typename Impl, UnaryOp op> void BM_Unary(benchmark::State &state) {
+  unsigned int N = state.range(0);
+  auto X = randomBuffer<float>(N, 0.5f, 1.0f);
+  std::vector<float> Y(N);
+  double flops = N, bytes = 8.0 * N;
+
+  for (auto _ : state) {
+    switch (op) {
+    case UnaryOp::SOFTMAX:
+      Impl::softmax(N, X.data(), Y.data());
+      break;
+    case UnaryOp::MAX:
+      benchmark::DoNotOptimize(Impl::max_val(N, X.data()));
+      break;
+    case UnaryOp::SINE:
+      Impl::sine(N, X.data(), Y.data(), 1.0f);
+      break;
+    case UnaryOp::COSINE:
+      Impl::cosine(N, X.data(), Y.data(), 1.0f);
+      break;
+    case UnaryOp::INV_SQRT:
+      /// keeps the values around one so that repeating does not diverge
+      Impl::inv_sqrt_inplace(N, X.data());
+      break;
+    case UnaryOp::IS_VALID:
+      benchmark::DoNotOptimize(Impl::is_valid(N, X.data()));
+      break;
+    }
+    benchmark::DoNotOptimize(Y.data());
+  }
+
+  if (op == UnaryOp::SOFTMAX) {
+    /// max, exponent and sum, then exponent and division, reading X twice
+    flops = 5.0 * N;
+    bytes = 12.0 * N;
+  } else if (op == UnaryOp::MAX || op == UnaryOp::IS_VALID) {
+    bytes = 4.0 * N;
+  }
+  setCounters(state, flops, bytes);
+}
+
+/**
+ * @brief Z = swish(X) * Y
+ */
+template <typename Impl> void BM_Swiglu(benchmark::State &state) {
+  unsigned int N = state.range(0);
+  auto X = randomBuffer<float>(N), Y = randomBuffer<float>(N);
+  std::vector<float> Z(N);
+
+  for (auto _ : state) {
+    Impl::swiglu(N, X.data(), Y.data(), Z.data());
+    benchmark::DoNotOptimize(Z.data());
+  }
+  setCounters(state, 4.0 * N, 12.0 * N);
+}
+
+/**
+ * @brief cosine and sine tables of the rotary embedding
+ */
+template <typename Impl>
+void BM_TrigonometricValsDup(benchmark::State &state) {
+  unsigned int N = state.range(0);
+  auto angle = randomBuffer<float>(N / 2);
+  std::vector<float> cos_(N), sin_(N);
+
+  for (auto _ : state) {
+    Impl::calc_trigonometric_vals_dup(N / 2, angle.data(), cos_.data(),
+                                      sin_.data(), 1);
+    benchmark::DoNotOptimize(sin_.data());
+  }
+  setCounters(state, N, 2.0 * N + 8.0 * N);
+}
+
+/**
+ * @brief matrix transpose
+ */
+template <typename Impl, typename T>
+void BM_TransposeMatrix(benchmark::State &state) {
+  unsigned int M = state.range(0), N = state.range(1);
+  auto src = randomBuffer<T>((size_t)M * N);
+  std::vector<T> dst((size_t)M * N);
+
+  for (auto _ : state) {
+    Impl::transpose_matrix(M, N, src.data(), N, dst.data(), M);
+    benchmark::DoNotOptimize(dst.data());
+  }
+  setCounters(state, 0, 2.0 * sizeof(T) * M * N);
+}
+
+/**
+ * @brief bias and relu applied to the output of a product
+ */
+template <typename Impl> void BM_GemmEpilogue(benchmark::State &state) {
+  unsigned int M = state.range(0), N = state.range(1);
+  auto C = randomBuffer<float>((size_t)M * N);
+  auto bias = randomBuffer<float>(N);
+
+  for (auto _ : state) {
+    Impl::gemm_epilogue(M, N, C.data(), nullptr, bias.data(), true);
+    benchmark::DoNotOptimize(C.data());
+  }
+  setCounters(state, 2.0 * M * N, 8.0 * M * N);
+}
+
+/**
+ * @brief int8 product of dynamically quantized activations and int8 weights
+ */
+template <typename Impl, bool trans_b>
+void BM_Qgemm(benchmark::State &state) {
+  unsigned int M = state.range(0), N = state.range(1), K = state.range(2);
+  auto A = randomBuffer<int8_t>((size_t)M * K, -127.0f, 127.0f);
+  auto B = randomBuffer<int8_t>((size_t)K * N, -128.0f, 127.0f);
+  auto a_scales = randomBuffer<float>(M, 0.0f, 0.1f);
+  auto b_scales = randomBuffer<float>(N, 0.0f, 0.1f);
+  auto bias = randomBuffer<float>(N);
+  std::vector<float> C((size_t)M * N);
+
+  for (auto _ : state) {
+    Impl::qgemm_s8(M, N, K, A.data(), a_scales.data(), B.data(),
+                   b_scales.data(), trans_b, bias.data(), C.data());
+    benchmark::DoNotOptimize(C.data());
+  }
+  setCounters(state, 2.0 * M * N * K,
+              (double)M * K + (double)K * N + 4.0 * M * N);
+}
+
+/**
+ * @brief dynamic quantization of the rows of the activations
+ */
+template <typename Impl> void BM_QuantizeRows(benchmark::State &state) {
+  unsigned int M = state.range(0), N = state.range(1);
+  auto X = randomBuffer<float>((size_t)M * N);
+  std::vector<int8_t> Y((size_t)M * N);
+  std::vector<float> scales(M);
+
+  for (auto _ : state) {
+    Impl::quantize_rows_s8(M, N, X.data(), Y.data(), scales.data());
+    benchmark::DoNotOptimize(Y.data());
+  }
+  setCounters(state, 2.0 * M * N, 5.0 * M * N);
+}
+
+#ifdef ENABLE_FP16
+/**
+ * @brief unpacking of quantized values to half precision
+ */
+template <typename Impl, bool int4>
+void BM_CopyToHalf(benchmark::State &state) {
+  unsigned int N = state.range(0);
+  unsigned int n_in = int4 ? N / 2 : N;
+  auto X = randomBuffer<uint8_t>(n_in, 0.0f, 255.0f);
+  std::vector<_FP16> Y(N);
+
+  for (auto _ : state) {
+    if (int4)
+      Impl::scopy_int4_to_float16(n_in, X.data(), 1, Y.data(), 1);
+    else
+      Impl::scopy_int8_to_float16(n_in, X.data(), 1, Y.data(), 1);
+    benchmark::DoNotOptimize(Y.data());
+  }
+  setCounters(state, 0, n_in + 2.0 * N);
+}
+#endif
+
+/**
+ * @brief Tensor level operations, which add dispatch and broadcasting on top
+ * of the kernels
+ */
+enum class TensorOp { DOT, ADD, MULTIPLY, DIVIDE, ADD_BROADCAST, SUM, COPY };
+
+/**
+ * @brief Tensor operation of the benchmark template on a square @a N x @a N
+ * tensor
+ */
+template <TensorOp op, nntrainer::Tdatatype type>
+void BM_Tensor(benchmark::State &state) {
+  unsigned int N = state.range(0);
+  nntrainer::TensorDim dim(1, 1, N, N, {nntrainer::Tformat::NCHW, type});
+  nntrainer::TensorDim row(1, 1, 1, N, {nntrainer::Tformat::NCHW, type});
+  nntrainer::Tensor A(dim), B(op == TensorOp::ADD_BROADCAST ? row : dim),
+    C(op == TensorOp::SUM ? row.transpose("0:2:1") : dim);
+  A.setRandUniform(0.5f, 1.0f);
+  B.setRandUniform(0.5f, 1.0f);
+
+  double elems = (double)N * N;
+  double bytes = 3 * A.bytes(), flops = elems;
+
+  for (auto _ : state) {
+    switch (op) {
+    case TensorOp::DOT:
+      A.dot(B, C);
+      break;
+    case TensorOp::ADD:
+    case TensorOp::ADD_BROADCAST:
+      A.add(B, C);
+      break;
+    case TensorOp::MULTIPLY:
+      A.multiply(B, C);
+      break;
+    case TensorOp::DIVIDE:
+      A.divide(B, C);
+      break;
+    case TensorOp::SUM:
+      A.sum(3, C);
+      break;
+    case TensorOp::COPY:
+      C.copyData(A);
+      break;
+    }
+    benchmark::DoNotOptimize(C.getData<char>());
+  }
+
+  if (op == TensorOp::DOT)
+    flops = 2.0 * elems * N;
+  else if (op == TensorOp::ADD_BROADCAST || op == TensorOp::SUM)
+    bytes = 2 * A.bytes();
+  else if (op == TensorOp::COPY)
+    bytes = 2 * A.bytes(), flops = 0;
+  setCounters(state, flops, bytes);
+}
+
+/** square tensor sizes of the Tensor benchmarks */
+void TensorSizes(benchmark::internal::Benchmark *b) {
+  b->ArgName("N");
+  for (int n : {64, 512, 2048})
+    b->Arg(n);
+}
+
+/**
+ * @brief measure the roofline of the machine
+ * @note the memory roof is a copy between buffers larger than the last level
+ * cache, and the compute roof is the backend sgemm of 1024 x 1024 matrices
+ */
+Roofline measureRoofline() {
+  using clock = std::chrono::steady_clock;
+  auto best_of = [](int reps, auto &&fn) {
+    double best = 0;
+    for (int i = 0; i < reps; ++i) {
+      auto start = clock::now();
+      fn();
+      std::chrono::duration<double> elapsed = clock::now() - start;
+      best = i == 0 ? elapsed.count() : std::min(best, elapsed.count());
+    }
+    return best;
+  };
+
+  const size_t bytes = 128 << 20;
+  std::vector<char> src(bytes, 1), dst(bytes, 0);
+  double copy_time = best_of(5, [&] {
+    std::memcpy(dst.data(), src.data(), bytes);
+    benchmark::DoNotOptimize(dst.data());
+  });
+
+  const unsigned int n = 1024;
+  auto A = randomBuffer<float>(n * n), B = randomBuffer<float>(n * n);
+  std::vector<float> C(n * n);
+  double gemm_time = best_of(3, [&] {
+    nntrainer::sgemm(0, false, false, n, n, n, 1.0f, A.data(), n, B.data(), n,
+                     0.0f, C.data(), n);
+    benchmark::DoNotOptimize(C.data());
+  });
+
+  return {2.0 * n * n * n / gemm_time, 2.0 * bytes / copy_time};
+}
+
+} // namespace
+
+/**
+ * @brief register the benchmark for the backend and the fallback kernels
+ */
+#define BENCHMARK_IMPLS(grid, func, ...)                                       \
+  BENCHMARK_TEMPLATE(func, Backend, ##__VA_ARGS__)->Apply(grid);               \
+  BENCHMARK_TEMPLATE(func, Fallback, ##__VA_ARGS__)->Apply(grid)
+
+/// level 3
+BENCHMARK_IMPLS(GemmShapes, BM_Sgemm, float);
+BENCHMARK_IMPLS(BatchedShapes, BM_SgemmStridedBatched, float);
+/// level 2
+BENCHMARK_IMPLS(GemvShapes, BM_Sgemv, float);
+/// level 1
+BENCHMARK_IMPLS(VectorSizes, BM_Sdot);
+BENCHMARK_IMPLS(VectorSizes, BM_Saxpy);
+BENCHMARK_IMPLS(VectorSizes, BM_Sscal);
+BENCHMARK_IMPLS(VectorSizes, BM_Snrm2);
+BENCHMARK(BM_Isamax)->Apply(VectorSizes);
+/// conversions
+BENCHMARK_IMPLS(VectorSizes, BM_CopyToFloat, float);
+BENCHMARK_IMPLS(VectorSizes, BM_CopyToFloat, int8_t);
+BENCHMARK_IMPLS(VectorSizes, BM_CopyToFloat, int16_t);
+BENCHMARK_IMPLS(VectorSizes, BM_CopyToFloat, uint16_t);
+BENCHMARK_IMPLS(VectorSizes, BM_CopyInt4ToFloat);
+/// elementwise
+BENCHMARK_IMPLS(VectorSizes, BM_Elementwise, EleOp::MUL);
+BENCHMARK_IMPLS(VectorSizes, BM_Elementwise, EleOp::ADD);
+BENCHMARK_IMPLS(VectorSizes, BM_Elementwise, EleOp::SUB);
+BENCHMARK_IMPLS(VectorSizes, BM_Elementwise, EleOp::DIV);
+/// activations and reductions
+BENCHMARK_IMPLS(VectorSizes, BM_Unary, UnaryOp::SOFTMAX);
+BENCHMARK_IMPLS(VectorSizes, BM_Unary, UnaryOp::MAX);
+BENCHMARK_IMPLS(VectorSizes, BM_Unary, UnaryOp::SINE);
+BENCHMARK_IMPLS(VectorSizes, BM_Unary, UnaryOp::COSINE);
+BENCHMARK_IMPLS(VectorSizes, BM_Unary, UnaryOp::INV_SQRT);
+BENCHMARK_IMPLS(VectorSizes, BM_Unary, UnaryOp::IS_VALID);
+BENCHMARK_IMPLS(VectorSizes, BM_Swiglu);
+/// the rotary tables are implemented with NEON only
+#if defined(__aarch64__) || defined(__ARM_ARCH_7A__) || defined(__arm__)
+BENCHMARK_TEMPLATE(BM_TrigonometricValsDup, Backend)->Apply(VectorSizes);
+#endif
+/// matrix
+BENCHMARK_IMPLS(MatrixShapes, BM_TransposeMatrix, float);
+BENCHMARK_IMPLS(MatrixShapes, BM_GemmEpilogue);
+/// int8
+BENCHMARK_IMPLS(GemmShapes, BM_Qgemm, false);
+BENCHMARK_IMPLS(GemmShapes, BM_Qgemm, true);
+BENCHMARK_IMPLS(MatrixShapes, BM_QuantizeRows);
+
+#ifdef ENABLE_FP16
+BENCHMARK_IMPLS(GemmShapes, BM_Sgemm, _FP16);
+BENCHMARK_IMPLS(GemvShapes, BM_Sgemv, _FP16);
+BENCHMARK_IMPLS(MatrixShapes, BM_TransposeMatrix, _FP16);
+BENCHMARK_IMPLS(VectorSizes, BM_CopyToHalf, true);
+BENCHMARK_IMPLS(VectorSizes, BM_CopyToHalf, false);
+#endif
+
+#define BENCHMARK_TENSOR(op)                                                   \
+  BENCHMARK_TEMPLATE(BM_Tensor, op, nntrainer::Tdatatype::FP32)                \
+    ->Apply(TensorSizes)
+
+BENCHMARK_TENSOR(TensorOp::DOT);
+BENCHMARK_TENSOR(TensorOp::ADD);
+BENCHMARK_TENSOR(TensorOp::ADD_BROADCAST);
+BENCHMARK_TENSOR(TensorOp::MULTIPLY);
+BENCHMARK_TENSOR(TensorOp::DIVIDE);
+BENCHMARK_TENSOR(TensorOp::SUM);
+BENCHMARK_TENSOR(TensorOp::COPY);
+#ifdef ENABLE_FP16
+BENCHMARK_TEMPLATE(BM_Tensor, TensorOp::DOT, nntrainer::Tdatatype::FP16)
+  ->Apply(TensorSizes);
+BENCHMARK_TEMPLATE(BM_Tensor, TensorOp::ADD, nntrainer::Tdatatype::FP16)
+  ->Apply(TensorSizes);
+#endif
+
+/**
+ * @brief run the benchmarks after measuring the roofline, which is saved to
+ * the context of the report
+ */
+int main(int argc, char **argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  roofline = measureRoofline();
+  benchmark::AddCustomContext("roofline_gflops",
+                              std::to_string(roofline.flops / 1e9));
+  benchmark::AddCustomContext("roofline_gbps",
+                              std::to_string(roofline.bandwidth / 1e9));
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
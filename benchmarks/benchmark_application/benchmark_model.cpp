@@ -0,0 +1,635 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   benchmark_model.cpp
+ * @date   18 Oct 2026
+ * @brief  Model level benchmark driver reporting throughput, latency and
+ * memory of training or inference over a grid of configurations
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ *
+ * usage: Benchmark_Model [key=value ...]
+ *   model=mlp|lenet|vgg|<path to ini>    model to run (default: lenet)
+ *   mode=train|inference                 what to measure (default: train)
+ *   batch=1,8,32                         batch sizes to run (default: 16)
+ *   threads=1,4                          openmp threads to run (default: 1)
+ *   dtype=FP32-FP32,FP16-FP16            model_tensor_type (default: FP32-FP32)
+ *   swap=false,true                      memory_swap to run (default: false)
+ *   swap_path=<dir>                      directory of the swap file
+ *   warmup=N                             untimed steps per run (default: 2)
+ *   iterations=N                         timed steps per run (default: 20)
+ *   layers=true|false                    report per layer latencies
+ *   output=<path>                        json result (default: result.json)
+ *
+ * Every combination of batch, threads, dtype and swap is a run on a freshly
+ * created model. A run which fails is reported with its error and the rest of
+ * the grid goes on.
+ */
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#if not defined(_WIN32)
+#include <sys/resource.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <dataset.h>
+#include <layer.h>
+#include <model.h>
+#include <optimizer.h>
+#include <runtime_metrics.h>
+#include <util_func.h>
+
+#include <fake_data_gen.h>
+
+using LayerHandle = std::shared_ptr<ml::train::Layer>;
+using ModelHandle = std::unique_ptr<ml::train::Model>;
+
+namespace {
+
+/**
+ * @brief options of the driver
+ *
+ */
+struct Options {
+  std::string model = "lenet";
+  std::string mode = "train";
+  std::vector<unsigned int> batch = {16};
+  std::vector<unsigned int> threads = {1};
+  std::vector<std::string> dtype = {"FP32-FP32"};
+  std::vector<std::string> swap = {"false"};
+  std::string swap_path;
+  unsigned int warmup = 2;
+  unsigned int iterations = 20;
+  bool layers = false;
+  std::string output = "result.json";
+};
+
+/**
+ * @brief a single point of the configuration grid
+ *
+ */
+struct RunConfig {
+  unsigned int batch;
+  unsigned int threads;
+  std::string dtype;
+  bool swap;
+};
+
+/**
+ * @brief measurements of a run
+ *
+ */
+struct RunResult {
+  RunConfig config;
+  std::string error;
+  unsigned int iterations = 0;
+  double wall_sec = 0;
+  double iterations_per_sec = 0;
+  double samples_per_sec = 0;
+  double p50_ms = 0;
+  double p99_ms = 0;
+  double max_ms = 0;
+  uint64_t peak_rss_kb = 0;
+  uint64_t memory_pool_bytes = 0;
+  uint64_t cache_pool_bytes = 0;
+  uint64_t swap_read_bytes = 0;
+  uint64_t swap_write_bytes = 0;
+  std::vector<ml::train::LatencyStats> layers;
+};
+
+/**
+ * @brief split a comma separated list
+ */
+std::vector<std::string> split(const std::string &value) {
+  std::vector<std::string> items;
+  std::stringstream ss(value);
+  std::string item;
+  while (std::getline(ss, item, ','))
+    if (!item.empty())
+      items.push_back(item);
+  return items;
+}
+
+/**
+ * @brief split a comma separated list of positive numbers
+ */
+std::vector<unsigned int> splitUnsigned(const std::string &value) {
+  std::vector<unsigned int> items;
+  for (auto &item : split(value)) {
+    int v = std::stoi(item);
+    if (v <= 0)
+      throw std::invalid_argument("expected a positive number: " + item);
+    items.push_back(v);
+  }
+  return items;
+}
+
+/**
+ * @brief parse key=value arguments
+ */
+Options parseOptions(int argc, char **argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto pos = arg.find('=');
+    if (pos == std::string::npos)
+      throw std::invalid_argument("argument is not key=value: " + arg);
+
+    std::string key = arg.substr(0, pos);
+    std::string value = arg.substr(pos + 1);
+    if (key == "model") {
+      opt.model = value;
+    } else if (key == "mode") {
+      if (value != "train" && value != "inference")
+        throw std::invalid_argument("unknown mode: " + value);
+      opt.mode = value;
+    } else if (key == "batch") {
+      opt.batch = splitUnsigned(value);
+    } else if (key == "threads") {
+      opt.threads = splitUnsigned(value);
+    } else if (key == "dtype") {
+      opt.dtype = split(value);
+    } else if (key == "swap") {
+      opt.swap = split(value);
+    } else if (key == "swap_path") {
+      opt.swap_path = value;
+    } else if (key == "warmup") {
+      opt.warmup = std::stoul(value);
+    } else if (key == "iterations") {
+      opt.iterations = splitUnsigned(value).at(0);
+    } else if (key == "layers") {
+      opt.layers = value == "true";
+    } else if (key == "output") {
+      opt.output = value;
+    } else {
+      throw std::invalid_argument("unknown option: " + key);
+    }
+  }
+  return opt;
+}
+
+/**
+ * @brief simple multi layer perceptron over 784 features
+ */
+std::vector<LayerHandle> createMLPGraph() {
+  using ml::train::createLayer;
+
+  return {
+    createLayer("input", {nntrainer::withKey("name", "in"),
+                          nntrainer::withKey("input_shape", "1:1:784")}),
+    createLayer("fully_connected", {nntrainer::withKey("name", "fc1"),
+                                    nntrainer::withKey("unit", 512),
+                                    nntrainer::withKey("activation", "relu")}),
+    createLayer("fully_connected", {nntrainer::withKey("name", "fc2"),
+                                    nntrainer::withKey("unit", 512),
+                                    nntrainer::withKey("activation", "relu")}),
+    createLayer("fully_connected",
+                {nntrainer::withKey("name", "out"),
+                 nntrainer::withKey("unit", 10),
+                 nntrainer::withKey("activation", "softmax")}),
+  };
+}
+
+/**
+ * @brief LeNet as in Applications/MNIST
+ */
+std::vector<LayerHandle> createLeNetGraph() {
+  using ml::train::createLayer;
+
+  auto conv = [](const std::string &name, int filters) {
+    return createLayer("conv2d", {nntrainer::withKey("name", name),
+                                  nntrainer::withKey("filters", filters),
+                                  nntrainer::withKey("kernel_size", {5, 5}),
+                                  nntrainer::withKey("activation", "sigmoid")});
+  };
+  auto pool = [](const std::string &name) {
+    return createLayer("pooling2d", {nntrainer::withKey("name", name),
+                                     nntrainer::withKey("pooling", "average"),
+                                     nntrainer::withKey("pool_size", {2, 2}),
+                                     nntrainer::withKey("stride", {2, 2})});
+  };
+
+  return {
+    createLayer("input", {nntrainer::withKey("name", "in"),
+                          nntrainer::withKey("input_shape", "1:28:28")}),
+    conv("c1", 6),
+    pool("p1"),
+    conv("c2", 12),
+    pool("p2"),
+    createLayer("flatten", {nntrainer::withKey("name", "flatten")}),
+    createLayer("fully_connected",
+                {nntrainer::withKey("name", "out"),
+                 nntrainer::withKey("unit", 10),
+                 nntrainer::withKey("activation", "softmax")}),
+  };
+}
+
+/**
+ * @brief small VGG for 32x32 images as in Applications/VGG
+ */
+std::vector<LayerHandle> createVGGGraph() {
+  using ml::train::createLayer;
+
+  std::vector<LayerHandle> layers;
+  layers.push_back(
+    createLayer("input", {nntrainer::withKey("name", "in"),
+                          nntrainer::withKey("input_shape", "3:32:32")}));
+
+  int idx = 0;
+  for (auto [filters, repeat] :
+       std::vector<std::pair<int, int>>{{16, 2}, {32, 2}, {64, 3}, {128, 3}}) {
+    for (int r = 0; r < repeat; ++r)
+      layers.push_back(createLayer(
+        "conv2d", {nntrainer::withKey("name", "conv" + std::to_string(idx++)),
+                   nntrainer::withKey("filters", filters),
+                   nntrainer::withKey("kernel_size", {3, 3}),
+                   nntrainer::withKey("padding", "same"),
+                   nntrainer::withKey("activation", "relu")}));
+    layers.push_back(createLayer(
+      "pooling2d", {nntrainer::withKey("name", "pool" + std::to_string(idx)),
+                    nntrainer::withKey("pooling", "max"),
+                    nntrainer::withKey("pool_size", {2, 2}),
+                    nntrainer::withKey("stride", {2, 2})}));
+  }
+
+  layers.push_back(
+    createLayer("flatten", {nntrainer::withKey("name", "flatten")}));
+  layers.push_back(createLayer(
+    "fully_connected", {nntrainer::withKey("name", "fc"),
+                        nntrainer::withKey("unit", 128),
+                        nntrainer::withKey("activation", "relu")}));
+  layers.push_back(createLayer(
+    "fully_connected", {nntrainer::withKey("name", "out"),
+                        nntrainer::withKey("unit", 100),
+                        nntrainer::withKey("activation", "softmax")}));
+  return layers;
+}
+
+/**
+ * @brief create the model named in the options
+ * @note a name ending with .ini is loaded from the file, the rest are ccapi
+ * builders
+ */
+ModelHandle createModel(const std::string &name) {
+  static const std::map<std::string,
+                        std::function<std::vector<LayerHandle>()>>
+    builders = {{"mlp", createMLPGraph},
+                {"lenet", createLeNetGraph},
+                {"vgg", createVGGGraph}};
+
+  bool is_ini = name.size() > 4 && name.substr(name.size() - 4) == ".ini";
+  if (is_ini) {
+    ModelHandle model =
+      ml::train::createModel(ml::train::ModelType::NEURAL_NET);
+    if (model->loadFromConfig(name) != ML_ERROR_NONE)
+      throw std::invalid_argument("failed to load " + name);
+    return model;
+  }
+
+  auto builder = builders.find(name);
+  if (builder == builders.end())
+    throw std::invalid_argument("unknown model: " + name);
+
+  ModelHandle model = ml::train::createModel(
+    ml::train::ModelType::NEURAL_NET, {nntrainer::withKey("loss", "cross")});
+  for (auto &layer : builder->second())
+    model->addLayer(layer);
+  model->setOptimizer(
+    ml::train::createOptimizer("sgd", {"learning_rate=0.001"}));
+  return model;
+}
+
+/**
+ * @brief clear the peak resident set size of the process, if possible
+ * @return bool true if the peak now follows the current run only
+ */
+bool resetPeakRSS() {
+#if defined(__linux__)
+  int fd = open("/proc/self/clear_refs", O_WRONLY);
+  if (fd < 0)
+    return false;
+  bool done = write(fd, "5", 1) == 1;
+  close(fd);
+  return done;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief get the peak resident set size in KiB
+ */
+uint64_t getPeakRSS() {
+#if defined(__linux__)
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind("VmHWM:", 0) == 0)
+      return std::stoull(line.substr(6));
+  }
+#endif
+#if not defined(_WIN32)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+    return usage.ru_maxrss;
+#endif
+  return 0;
+}
+
+/**
+ * @brief generator callback feeding random samples
+ */
+int dataCallback(float **input, float **label, bool *last, void *user_data) {
+  auto data = reinterpret_cast<nntrainer::util::DataLoader *>(user_data);
+
+  data->next(input, label, last);
+  return 0;
+}
+
+/**
+ * @brief tracks the largest pool sizes seen through the stop callback
+ * @note memory pools hold the tensors of a model without swap, cache pools the
+ * loaded part of them with swap
+ */
+struct PoolWatcher {
+  uint64_t memory_base = 0;
+  uint64_t memory_peak = 0;
+  uint64_t cache_base = 0;
+  uint64_t cache_peak = 0;
+
+  /**
+   * @brief start watching from the current sizes
+   */
+  PoolWatcher() {
+    auto &counters = nntrainer::RuntimeCounters::Global();
+    memory_base = memory_peak =
+      counters.get(nntrainer::RuntimeCounters::MEMORY_POOL_BYTES);
+    cache_base = cache_peak =
+      counters.get(nntrainer::RuntimeCounters::CACHE_POOL_BYTES);
+  }
+};
+
+/**
+ * @brief stop callback which never stops, but samples the pools
+ */
+bool watchPool(void *user_data) {
+  auto watcher = reinterpret_cast<PoolWatcher *>(user_data);
+  auto &counters = nntrainer::RuntimeCounters::Global();
+  watcher->memory_peak =
+    std::max(watcher->memory_peak,
+             counters.get(nntrainer::RuntimeCounters::MEMORY_POOL_BYTES));
+  watcher->cache_peak =
+    std::max(watcher->cache_peak,
+             counters.get(nntrainer::RuntimeCounters::CACHE_POOL_BYTES));
+  return false;
+}
+
+/**
+ * @brief train the model for @a steps iterations of fake data
+ */
+void trainSteps(ml::train::Model &model, unsigned int batch,
+                unsigned int steps, PoolWatcher &watcher) {
+  auto in_dims = model.getInputDimension();
+  auto out_dims = model.getOutputDimension();
+  nntrainer::util::RandomDataLoader loader(in_dims, out_dims, batch * steps);
+
+  model.setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                   ml::train::createDataset(ml::train::DatasetType::GENERATOR,
+                                            dataCallback, &loader));
+  if (model.train({}, watchPool, &watcher) != ML_ERROR_NONE)
+    throw std::runtime_error("training failed");
+}
+
+/**
+ * @brief run a point of the grid
+ */
+RunResult run(const Options &opt, const RunConfig &config) {
+  RunResult result;
+  result.config = config;
+
+#ifdef _OPENMP
+  omp_set_num_threads(config.threads);
+#endif
+
+  bool train = opt.mode == "train";
+  auto mode = train ? ml::train::ExecutionMode::TRAIN
+                    : ml::train::ExecutionMode::INFERENCE;
+  PoolWatcher watcher;
+
+  try {
+    ModelHandle model = createModel(opt.model);
+    std::vector<std::string> props = {
+      nntrainer::withKey("batch_size", config.batch),
+      nntrainer::withKey("epochs", 1),
+      nntrainer::withKey("model_tensor_type", config.dtype),
+      nntrainer::withKey("memory_swap", config.swap ? "true" : "false")};
+    if (config.swap && !opt.swap_path.empty())
+      props.push_back(nntrainer::withKey("memory_swap_path", opt.swap_path));
+    model->setProperty(props);
+
+    if (model->compile(mode) != ML_ERROR_NONE ||
+        model->initialize(mode) != ML_ERROR_NONE)
+      throw std::runtime_error("failed to compile or initialize");
+
+    nntrainer::LatencyHistogram steps;
+    std::vector<std::vector<float>> inputs;
+    std::vector<float *> input_ptrs;
+    if (!train) {
+      std::mt19937 rng;
+      std::uniform_real_distribution<float> dist(0, 1);
+      for (auto &dim : model->getInputDimension()) {
+        inputs.emplace_back(config.batch * dim.getFeatureLen());
+        std::generate(inputs.back().begin(), inputs.back().end(),
+                      [&] { return dist(rng); });
+        input_ptrs.push_back(inputs.back().data());
+      }
+    }
+
+    auto infer = [&]() {
+      nntrainer::ScopedLatency scoped(steps);
+      model->inference(config.batch, input_ptrs);
+      watchPool(&watcher);
+    };
+
+    if (opt.warmup > 0) {
+      if (train)
+        trainSteps(*model, config.batch, opt.warmup, watcher);
+      else
+        for (unsigned int i = 0; i < opt.warmup; ++i)
+          infer();
+    }
+
+    model->resetRuntimeMetrics();
+    steps.reset();
+    resetPeakRSS();
+
+    auto start = std::chrono::steady_clock::now();
+    if (train)
+      trainSteps(*model, config.batch, opt.iterations, watcher);
+    else
+      for (unsigned int i = 0; i < opt.iterations; ++i)
+        infer();
+    result.wall_sec = std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+
+    auto metrics = model->getRuntimeMetrics();
+    for (auto &stat : metrics.latencies) {
+      if (train && stat.name == "model:iteration") {
+        result.iterations = stat.count;
+        result.iterations_per_sec = stat.count / (stat.total_us * 1e-6);
+        result.p50_ms = stat.p50_us / 1000;
+        result.p99_ms = stat.p99_us / 1000;
+        result.max_ms = stat.max_us / 1000;
+      }
+      if (opt.layers && stat.name.rfind("model:", 0) != 0)
+        result.layers.push_back(stat);
+    }
+
+    if (!train) {
+      result.iterations = steps.count();
+      result.iterations_per_sec = steps.count() / (steps.total() * 1e-9);
+      result.p50_ms = steps.percentile(50) / 1e6;
+      result.p99_ms = steps.percentile(99) / 1e6;
+      result.max_ms = steps.max() / 1e6;
+    }
+
+    result.samples_per_sec = result.iterations_per_sec * config.batch;
+    result.peak_rss_kb = getPeakRSS();
+    result.memory_pool_bytes = watcher.memory_peak - watcher.memory_base;
+    result.cache_pool_bytes = watcher.cache_peak - watcher.cache_base;
+    result.swap_read_bytes = metrics.swap_read_bytes;
+    result.swap_write_bytes = metrics.swap_write_bytes;
+  } catch (std::exception &e) {
+    result.error = e.what();
+  }
+
+  return result;
+}
+
+/**
+ * @brief write a string as a json string literal
+ */
+std::string quote(const std::string &s) {
+  std::ostringstream out;
+  out << '"';
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      out << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+          << static_cast<int>(c) << std::dec;
+    else
+      out << c;
+  }
+  out << '"';
+  return out.str();
+}
+
+/**
+ * @brief write the results as json
+ */
+void writeJson(std::ostream &out, const Options &opt,
+               const std::vector<RunResult> &results) {
+  out << "{\n  \"context\": {\"model\": " << quote(opt.model)
+      << ", \"mode\": " << quote(opt.mode) << ", \"warmup\": " << opt.warmup
+      << ", \"iterations\": " << opt.iterations << "},\n  \"results\": [";
+
+  for (size_t i = 0; i < results.size(); ++i) {
+    auto &r = results[i];
+    out << (i ? ",\n" : "\n") << "    {\"batch_size\": " << r.config.batch
+        << ", \"threads\": " << r.config.threads
+        << ", \"dtype\": " << quote(r.config.dtype)
+        << ", \"swap\": " << (r.config.swap ? "true" : "false");
+    if (!r.error.empty()) {
+      out << ", \"error\": " << quote(r.error) << "}";
+      continue;
+    }
+
+    out << ", \"iterations\": " << r.iterations
+        << ", \"wall_sec\": " << r.wall_sec
+        << ", \"iterations_per_sec\": " << r.iterations_per_sec
+        << ", \"samples_per_sec\": " << r.samples_per_sec
+        << ", \"p50_ms\": " << r.p50_ms << ", \"p99_ms\": " << r.p99_ms
+        << ", \"max_ms\": " << r.max_ms
+        << ", \"peak_rss_kb\": " << r.peak_rss_kb
+        << ", \"memory_pool_bytes\": " << r.memory_pool_bytes
+        << ", \"cache_pool_bytes\": " << r.cache_pool_bytes
+        << ", \"swap_read_bytes\": " << r.swap_read_bytes
+        << ", \"swap_write_bytes\": " << r.swap_write_bytes;
+    if (opt.layers) {
+      out << ", \"layers\": [";
+      for (size_t l = 0; l < r.layers.size(); ++l) {
+        auto &s = r.layers[l];
+        out << (l ? ", " : "") << "{\"name\": " << quote(s.name)
+            << ", \"count\": " << s.count << ", \"p50_us\": " << s.p50_us
+            << ", \"p99_us\": " << s.p99_us << ", \"max_us\": " << s.max_us
+            << ", \"total_us\": " << s.total_us << "}";
+      }
+      out << "]";
+    }
+    out << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options opt;
+  try {
+    opt = parseOptions(argc, argv);
+  } catch (std::exception &e) {
+    std::cerr << "invalid argument: " << e.what() << std::endl;
+    return 1;
+  }
+
+  std::vector<RunResult> results;
+  for (auto batch : opt.batch)
+    for (auto threads : opt.threads)
+      for (auto &dtype : opt.dtype)
+        for (auto &swap : opt.swap) {
+          RunConfig config = {batch, threads, dtype, swap == "true"};
+          results.push_back(run(opt, config));
+        }
+
+  std::cout << "\nbatch threads dtype swap | it/s samples/s p50(ms) p99(ms) "
+               "peak_rss(KiB) pool(B) cache(B)\n";
+  for (auto &r : results) {
+    std::cout << r.config.batch << ' ' << r.config.threads << ' '
+              << r.config.dtype << ' ' << r.config.swap << " | ";
+    if (!r.error.empty())
+      std::cout << "error: " << r.error << '\n';
+    else
+      std::cout << r.iterations_per_sec << ' ' << r.samples_per_sec << ' '
+                << r.p50_ms << ' ' << r.p99_ms << ' ' << r.peak_rss_kb << ' '
+                << r.memory_pool_bytes << ' ' << r.cache_pool_bytes << '\n';
+  }
+
+  std::ofstream file(opt.output);
+  if (!file.good()) {
+    std::cerr << "failed to open " << opt.output << std::endl;
+    return 1;
+  }
+  writeJson(file, opt, results);
+  return 0;
+}
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   benchmark_runtime_metrics.cpp
+ * @date   18 Oct 2026
+ * @brief  benchmark of the cost of the always-on latency metrics against the
+ * layer calls they are recorded for
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ */
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <layer.h>
+#include <model.h>
+#include <runtime_metrics.h>
+
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/**
+ * @brief fully connected layers of the same width on a batch of one
+ */
+std::unique_ptr<ml::train::Model> makeModel(unsigned int width,
+                                            unsigned int num_layers) {
+  auto model = ml::train::createModel(ml::train::ModelType::NEURAL_NET,
+                                      {"batch_size=1"});
+  model->addLayer(ml::train::createLayer(
+    "input", {"name=in", "input_shape=1:1:" + std::to_string(width)}));
+  for (unsigned int i = 0; i < num_layers; ++i)
+    model->addLayer(ml::train::createLayer(
+      "fully_connected", {"unit=" + std::to_string(width)}));
+
+  model->compile(ml::train::ExecutionMode::INFERENCE);
+  model->initialize(ml::train::ExecutionMode::INFERENCE);
+  model->allocate(ml::train::ExecutionMode::INFERENCE);
+  return model;
+}
+
+} // namespace
+
+/**
+ * @brief one latency measured and recorded, which every layer call pays
+ */
+static void BM_ScopedLatency(benchmark::State &state) {
+  nntrainer::LatencyHistogram hist;
+  for (auto _ : state) {
+    nntrainer::ScopedLatency latency(hist);
+    benchmark::ClobberMemory();
+  }
+}
+
+/**
+ * @brief inference of fully connected layers, the time per layer call is
+ * what the latency above is recorded for
+ */
+static void BM_Inference(benchmark::State &state) {
+  constexpr unsigned int num_layers = 8;
+  unsigned int width = state.range(0);
+  auto model = makeModel(width, num_layers);
+  std::vector<float> input(width, 0.5f);
+
+  for (auto _ : state) {
+    auto out = model->inference(1, {input.data()});
+    benchmark::DoNotOptimize(out[0]);
+  }
+  state.counters["layer_call"] = benchmark::Counter(
+    state.iterations() * num_layers,
+    benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+BENCHMARK(BM_ScopedLatency);
+BENCHMARK(BM_Inference)->Arg(32)->Arg(128)->Arg(512);
+BENCHMARK_MAIN();
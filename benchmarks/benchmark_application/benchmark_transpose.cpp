@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   benchmark_transpose.cpp
+ * @date   18 Oct 2026
+ * @brief  benchmark of the tensor transpose over directions and shapes
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ */
+#include <array>
+
+#include <tensor.h>
+
+#include "benchmark/benchmark.h"
+
+namespace {
+
+const std::array<const char *, 6> directions = {
+  "0:1:2", "0:2:1", "1:0:2", "1:2:0", "2:0:1", "2:1:0"};
+
+/** batch, channel, height, width */
+const std::array<std::array<unsigned int, 4>, 4> shapes = {{
+  {1, 1, 512, 2048}, /**< weight matrix */
+  {4, 128, 12, 64},  /**< attention head split, seq x heads x head_dim */
+  {8, 64, 56, 56},   /**< convolution feature map */
+  {32, 3, 224, 224}, /**< image batch */
+}};
+
+/**
+ * @brief transpose of the direction and shape of the benchmark arguments
+ */
+template <nntrainer::Tdatatype type>
+void BM_Transpose(benchmark::State &state) {
+  const char *direction = directions[state.range(0)];
+  const auto &shape = shapes[state.range(1)];
+
+  nntrainer::TensorDim dim(shape[0], shape[1], shape[2], shape[3],
+                           {nntrainer::Tformat::NCHW, type});
+  nntrainer::Tensor input(dim);
+  nntrainer::Tensor output(dim.transpose(direction));
+  if (type == nntrainer::Tdatatype::FP32 || type == nntrainer::Tdatatype::FP16)
+    input.setRandUniform(-1.0f, 1.0f);
+
+  for (auto _ : state) {
+    input.transpose(direction, output);
+    benchmark::DoNotOptimize(output.getData<char>());
+  }
+
+  state.SetLabel(direction);
+  /// every element is read and written once
+  state.SetBytesProcessed(2 * state.iterations() * input.bytes());
+}
+
+/**
+ * @brief every direction for every shape
+ */
+void TransposeGrid(benchmark::internal::Benchmark *b) {
+  for (int shape = 0; shape < (int)shapes.size(); ++shape)
+    for (int direction = 0; direction < (int)directions.size(); ++direction)
+      b->Args({direction, shape});
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_Transpose, nntrainer::Tdatatype::FP32)
+  ->Apply(TransposeGrid);
+#ifdef ENABLE_FP16
+BENCHMARK_TEMPLATE(BM_Transpose, nntrainer::Tdatatype::FP16)
+  ->Apply(TransposeGrid);
+#endif
+BENCHMARK_TEMPLATE(BM_Transpose, nntrainer::Tdatatype::UINT16)
+  ->Apply(TransposeGrid);
+BENCHMARK_MAIN();
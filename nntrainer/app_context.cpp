@@ -48,6 +48,7 @@
 #include <dropout.h>
 #include <dynamic_library_loader.h>
 #include <embedding.h>
+#include <fake_quant_layer.h>
 #include <fc_layer.h>
 #include <flatten_layer.h>
 #include <gru.h>
@@ -339,6 +340,8 @@ static void add_default_object(AppContext &ac) {
                      LayerType::LAYER_IDENTITY);
   ac.registerFactory(nntrainer::createLayer<Upsample2dLayer>,
                      Upsample2dLayer::type, LayerType::LAYER_UPSAMPLE2D);
+  ac.registerFactory(nntrainer::createLayer<FakeQuantLayer>,
+                     FakeQuantLayer::type, LayerType::LAYER_FAKE_QUANT);
 
 #ifdef ENABLE_NNSTREAMER_BACKBONE
   ac.registerFactory(nntrainer::createLayer<NNStreamerLayer>,
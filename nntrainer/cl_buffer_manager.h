@@ -101,6 +101,12 @@ public:
    */
   opencl::Buffer *getOutBufferB() { return outBufferB; }
 
+  /**
+   * @brief Get the capacity of each buffer.
+   * @return size_t capacity in bytes
+   */
+  size_t getBufferSize() const { return buffer_size_bytes; }
+
   /**
    * @brief Destroy Buffer pointers.
    *
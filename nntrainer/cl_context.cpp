@@ -20,6 +20,7 @@
 #include <cl_context.h>
 #include <concat_cl.h>
 #include <fc_layer_cl.h>
+#include <opencl_program_cache.h>
 #include <reshape_cl.h>
 #include <rmsnorm_layer_cl.h>
 #include <swiglu_cl.h>
@@ -185,73 +186,75 @@ void ClContext::initAttentionClKernels() {
 }
 
 const ClContext::SharedPtrClKernel
-ClContext::registerClKernel(std::string kernel_string,
-                            std::string kernel_name) {
+ClContext::registerClKernel(std::string kernel_string, std::string kernel_name,
+                            const std::string &compile_options) {
+  // kernels built with different options are different kernel objects
+  const std::string kernel_key =
+    compile_options.empty() ? kernel_name : kernel_name + " " + compile_options;
+
   // check if created before
-  if (ocl_kernel_map.find(kernel_name) != ocl_kernel_map.end()) {
+  if (ocl_kernel_map.find(kernel_key) != ocl_kernel_map.end()) {
     ml_logi("Kernel already registered and initialized: %s",
-            kernel_name.c_str());
-    return ocl_kernel_map[kernel_name];
+            kernel_key.c_str());
+    return ocl_kernel_map[kernel_key];
   }
 
   // creating shared_ptr for kernel object
   SharedPtrClKernel kernelPtr = std::make_shared<opencl::Kernel>();
-  if (!clCreateKernel(kernel_string, kernel_name, kernelPtr)) {
-    ml_loge("Failed to register kernel %s", kernel_name.c_str());
+  if (!clCreateKernel(kernel_string, kernel_name, compile_options,
+                      kernelPtr)) {
+    ml_loge("Failed to register kernel %s", kernel_key.c_str());
     return nullptr;
   }
   // add to map
-  ocl_kernel_map.emplace(kernel_name, kernelPtr);
-  return ocl_kernel_map[kernel_name];
+  ocl_kernel_map.emplace(kernel_key, kernelPtr);
+  return ocl_kernel_map[kernel_key];
 }
 
 bool ClContext::clCreateKernel(std::string &kernel_string,
                                std::string &kernel_name,
+                               const std::string &compile_options,
                                const SharedPtrClKernel &kernel_ptr_) {
 
   ml_logi("Kernel initializing: %s", kernel_name.c_str());
 
+  static const opencl::ProgramCache program_cache(
+    opencl::Program::DEFAULT_KERNEL_PATH);
+
+  auto &context_manager = opencl::ContextManager::GetInstance();
+  const cl_context context = context_manager.GetContext();
+  const cl_device_id device_id = context_manager.GetDeviceId();
+
+  // binaries depend on the device, driver, options and source revision
+  const std::string identity =
+    opencl::ProgramCache::MakeIdentity(kernel_string, compile_options);
+
+  opencl::Program program;
   bool result = false;
 
-  do {
-    opencl::Program program;
-
-    // reading binary
-    std::ifstream fs(opencl::Program::DEFAULT_KERNEL_PATH + "/" + kernel_name +
-                       "_kernel.bin",
-                     std::ios::binary | std::ios::in);
-
-    if (fs.good()) {
-      fs.seekg(0, std::ios::end);
-      size_t binary_size = fs.tellg();
-      fs.seekg(0, std::ios::beg);
-
-      std::vector<unsigned char> chunk(binary_size);
-      fs.read((char *)chunk.data(), binary_size);
-
-      result = program.CreateCLProgramWithBinary(
-        opencl::ContextManager::GetInstance().GetContext(),
-        opencl::ContextManager::GetInstance().GetDeviceId(), binary_size,
-        chunk.data(),
-        opencl::Program::DEFAULT_KERNEL_PATH + "/" + kernel_name +
-          "_kernel.bin",
-        "");
-    } else {
-      result = program.CreateCLProgram(
-        opencl::ContextManager::GetInstance().GetContext(),
-        opencl::ContextManager::GetInstance().GetDeviceId(), kernel_string, "");
-    }
-
-    if (!result) {
-      break;
-    }
-
-    result = kernel_ptr_->CreateKernelFromProgram(program, kernel_name);
-    if (!result) {
-      break;
-    }
-
-  } while (false);
+  std::vector<unsigned char> binary;
+  if (program_cache.Load(kernel_name, identity, binary)) {
+    result = program.CreateCLProgramWithBinary(
+      context, device_id, binary.size(), binary.data(),
+      program_cache.GetEntryPath(kernel_name, identity), compile_options);
+    if (!result)
+      ml_logw("Cached binary of %s rejected, rebuilding from source",
+              kernel_name.c_str());
+  }
+
+  if (!result) {
+    result = program.CreateCLProgram(context, device_id, kernel_string,
+                                     compile_options);
+    if (!result)
+      return false;
+
+    // failing to save only costs a rebuild on the next run
+    if (program_cache.IsEnabled() &&
+        program.GetProgramBinary(device_id, binary))
+      program_cache.Store(kernel_name, identity, binary);
+  }
+
+  result = kernel_ptr_->CreateKernelFromProgram(program, kernel_name);
 
   return result;
 }
@@ -213,10 +213,13 @@ public:
    * @brief register or return already present OpenCl kernel pointer
    * @param kernel_string kernel implementation string
    * @param kernel_name kernel name
+   * @param compile_options build options passed to the OpenCL compiler. The
+   * same kernel built with different options is registered separately
    * @return std::shared_ptr<opencl::Kernel>
    */
-  const SharedPtrClKernel registerClKernel(std::string kernel_string,
-                                           std::string kernel_name);
+  const SharedPtrClKernel
+  registerClKernel(std::string kernel_string, std::string kernel_name,
+                   const std::string &compile_options = "");
 
   /**
    * @brief Initialize and register all blas OpenCl kernels
@@ -289,10 +292,12 @@ private:
    * @brief create OpenCl kernel
    * @param kernel_string reference of implementation string
    * @param kernel_name reference of kernel_name
+   * @param compile_options build options passed to the OpenCL compiler
    * @param kernel_ptr_ reference of shared_ptr of Kernel
    * @return true if successful, false otherwise
    */
   bool clCreateKernel(std::string &kernel_string, std::string &kernel_name,
+                      const std::string &compile_options,
                       const SharedPtrClKernel &kernel_ptr_);
 };
 
@@ -65,6 +65,8 @@ ActivationRealizer::realize(const GraphRepresentation &reference) {
         createLayerNode("activation", {"name=" + act_name,
                                        "activation=" + to_string(act_prop)});
       act_node->setProperty({"input_layers=" + temp_name});
+      if (node->getRecompute())
+        act_node->setProperty({"recompute=true"});
       processed.push_back(std::move(act_node));
     }
   }
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file fake_quant_realizer.cpp
+ * @date 18 Oct 2026
+ * @brief NNTrainer graph realizer which fake quantizes the layers of a
+ * quantized weight for quantization aware training
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+#include <fake_quant_realizer.h>
+
+#include <connection.h>
+#include <conv2d_layer.h>
+#include <fake_quant_layer.h>
+#include <fc_layer.h>
+#include <layer_node.h>
+#include <nntrainer_error.h>
+#include <node_exporter.h>
+
+#include <string>
+
+namespace nntrainer {
+
+static constexpr size_t SINGLE_INOUT_IDX = 0;
+
+namespace {
+
+/**
+ * @brief check if a LoRA is set on the node
+ */
+bool hasLora(const LayerNode &node) {
+  Exporter e;
+  node.exportTo(e, ml::train::ExportMethods::METHOD_STRINGVECTOR);
+  auto props = e.getResult<ml::train::ExportMethods::METHOD_STRINGVECTOR>();
+  for (auto &[k, v] : *props) {
+    if (k == "lora_rank")
+      return !v.empty() && v != "0";
+  }
+  return false;
+}
+
+} // namespace
+
+FakeQuantRealizer::FakeQuantRealizer(
+  ml::train::TensorDim::DataType weight_type_) :
+  weight_type(weight_type_) {
+  NNTR_THROW_IF(weight_type != TensorDim::DataType::QINT8 &&
+                  weight_type != TensorDim::DataType::QINT4,
+                std::invalid_argument)
+    << "fake quantization simulates QINT8 or QINT4 weights only";
+}
+
+GraphRepresentation
+FakeQuantRealizer::realize(const GraphRepresentation &reference) {
+  const bool is_int8 = weight_type == TensorDim::DataType::QINT8;
+  const std::string type = is_int8 ? "QINT8" : "QINT4";
+
+  GraphRepresentation processed;
+  processed.reserve(reference.size());
+
+  for (auto &node : reference) {
+    const bool is_fc =
+      node->getType() == FullyConnectedLayer::type && !hasLora(*node);
+    const bool is_conv = node->getType() == Conv2DLayer::type && is_int8;
+    if (!is_fc && !is_conv) {
+      processed.push_back(node);
+      continue;
+    }
+
+    node->setProperty({"fake_quant=" + type});
+
+    /// the patches of a convolution are quantized as the int8 gemm unfolds
+    /// them, which a layer before it does not see
+    if (is_int8 && is_fc && node->getNumInputConnections() == 1) {
+      auto fake_quant_name = node->getName() + "/fake_quant";
+      Connection input(node->getInputConnectionName(SINGLE_INOUT_IDX),
+                       node->getInputConnectionIndex(SINGLE_INOUT_IDX));
+
+      processed.push_back(createLayerNode(
+        FakeQuantLayer::type,
+        {"name=" + fake_quant_name, "input_layers=" + input.toString(),
+         "fake_quant=" + type, "row_range=true"}));
+      node->setInputConnectionName(SINGLE_INOUT_IDX, fake_quant_name);
+      node->setInputConnectionIndex(SINGLE_INOUT_IDX, 0);
+    }
+
+    processed.push_back(node);
+  }
+
+  return processed;
+}
+
+} // namespace nntrainer
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file fake_quant_realizer.h
+ * @date 18 Oct 2026
+ * @brief NNTrainer graph realizer which fake quantizes the layers of a
+ * quantized weight for quantization aware training
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+#ifndef __FAKE_QUANT_REALIZER_H__
+#define __FAKE_QUANT_REALIZER_H__
+
+#include <memory>
+#include <vector>
+
+#include <realizer.h>
+#include <tensor_dim.h>
+
+namespace nntrainer {
+
+/**
+ * @brief Graph realizer class which inserts fake quantization
+ *
+ * @details The layers QuantizationCalibrator quantizes get the fake_quant
+ * property, so they compute with their weight rounded to the quantized data
+ * type: fully connected layers without LoRA, and conv2d layers for QINT8. For
+ * QINT8 the single input of a fully connected layer also goes through a
+ * fake_quant layer rounding each row with its own range, as the int8 gemm
+ * quantizes it at inference.
+ */
+class FakeQuantRealizer final : public GraphRealizer {
+public:
+  /**
+   * @brief Construct a new Fake Quant Realizer object
+   *
+   * @param weight_type_ QINT8 or QINT4, data type of the weights
+   */
+  FakeQuantRealizer(ml::train::TensorDim::DataType weight_type_);
+
+  /**
+   * @brief Destroy the Fake Quant Realizer object
+   *
+   */
+  ~FakeQuantRealizer() = default;
+
+  /**
+   * @brief graph realizer creates a new graph based on the reference
+   * @note fake quant realizer sets the fake_quant property on the quantized
+   * layers and adds a fake_quant layer named "<layer>/fake_quant" before the
+   * fully connected ones
+   * @param reference GraphRepresentation to be realized
+   * @throw std::invalid_argument if graph is ill formed
+   *
+   */
+  GraphRepresentation realize(const GraphRepresentation &reference) override;
+
+private:
+  ml::train::TensorDim::DataType weight_type;
+};
+
+} // namespace nntrainer
+
+#endif // __FAKE_QUANT_REALIZER_H__
@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file fusion_realizer.cpp
+ * @date 18 Oct 2026
+ * @brief NNTrainer graph realizer which fuses batch normalization and
+ * activation layers into the layer before them for inference
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+#include <fusion_realizer.h>
+
+#include <activation_layer.h>
+#include <addition_layer.h>
+#include <bn_layer.h>
+#include <conv2d_layer.h>
+#include <fc_layer.h>
+#include <layer_node.h>
+#include <nntrainer_error.h>
+#include <nntrainer_log.h>
+#include <node_exporter.h>
+#include <remap_realizer.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace nntrainer {
+
+static constexpr size_t SINGLE_INOUT_IDX = 0;
+
+namespace {
+
+/**
+ * @brief get the exported value of a property of the node
+ *
+ * @param node node to get the property from
+ * @param key key of the property
+ * @return std::string value, empty if not set
+ */
+std::string getPropertyValue(const LayerNode &node, const std::string &key) {
+  Exporter e;
+  node.exportTo(e, ml::train::ExportMethods::METHOD_STRINGVECTOR);
+  auto props = e.getResult<ml::train::ExportMethods::METHOD_STRINGVECTOR>();
+  for (auto &[k, v] : *props) {
+    if (k == key)
+      return v;
+  }
+  return "";
+}
+
+/**
+ * @brief check if the activation can run in place on the output of a layer
+ *
+ * @param act activation type
+ * @return true if the activation is elementwise and in-place safe
+ */
+bool isFusableActivation(ActivationType act) {
+  switch (act) {
+  case ActivationType::ACT_TANH:
+  case ActivationType::ACT_SIGMOID:
+  case ActivationType::ACT_RELU:
+  case ActivationType::ACT_GELU:
+  case ActivationType::ACT_TANH_GELU:
+  case ActivationType::ACT_SIGMOID_GELU:
+  case ActivationType::ACT_SOFTPLUS:
+  case ActivationType::ACT_LEAKY_RELU:
+  case ActivationType::ACT_ELU:
+  case ActivationType::ACT_SELU:
+  case ActivationType::ACT_MISH:
+    return true;
+  default:
+    /// softmax is not elementwise and swish reads its input after writing
+    return false;
+  }
+}
+
+} // namespace
+
+GraphRepresentation
+FusionRealizer::realize(const GraphRepresentation &reference) {
+  std::unordered_map<std::string, LayerNode *> existing_nodes;
+  std::unordered_map<std::string, size_t> order;
+  std::unordered_map<std::string, unsigned int> num_consumers;
+  std::unordered_set<std::string> weight_shared;
+
+  for (auto &node : reference) {
+    existing_nodes.emplace(node->getName(), node.get());
+    order.emplace(node->getName(), order.size());
+    for (auto &input : node->getInputConnections())
+      num_consumers[input]++;
+    if (auto shared_from = getPropertyValue(*node, "shared_from");
+        !shared_from.empty()) {
+      weight_shared.insert(shared_from);
+      weight_shared.insert(node->getName());
+    }
+  }
+
+  /// fused layer name -> name of the layer it is fused into
+  std::unordered_map<std::string, std::string> remap_table;
+  std::unordered_set<std::string> has_activation;
+
+  for (auto &node : reference) {
+    bool is_bn = node->getType() == BatchNormalizationLayer::type;
+    bool is_act = node->getType() == ActivationLayer::type;
+    if ((!is_bn && !is_act) || node->getNumInputConnections() != 1 ||
+        node->getInputConnectionIndex(SINGLE_INOUT_IDX) != 0)
+      continue;
+
+    std::string target_name = node->getInputConnectionName(SINGLE_INOUT_IDX);
+    if (auto iter = remap_table.find(target_name); iter != remap_table.end())
+      target_name = iter->second;
+
+    auto target_iter = existing_nodes.find(target_name);
+    if (target_iter == existing_nodes.end() ||
+        num_consumers[target_name] != 1)
+      continue;
+
+    LayerNode *target = target_iter->second;
+    const auto &target_type = target->getType();
+    bool is_gemm = target_type == Conv2DLayer::type ||
+                   target_type == FullyConnectedLayer::type;
+
+    if (is_bn) {
+      /// a batch normalization after the activation is not foldable, and the
+      /// folded weights are read right after the weights of the target
+      if (!is_gemm || has_activation.count(target_name) ||
+          weight_shared.count(target_name) ||
+          order.at(target_name) > order.at(node->getName()))
+        continue;
+
+      /// an axis not set is derived from the output channel as the batch
+      /// normalization does, which is known here for conv2d only. The fully
+      /// connected layer checks it when it is finalized
+      auto axis = getPropertyValue(*node, "axis");
+      if (target_type == Conv2DLayer::type) {
+        if (axis.empty() && getPropertyValue(*target, "filters") == "1")
+          continue;
+        if (!axis.empty() && axis != "1")
+          continue;
+      } else if (!axis.empty() && axis != "3") {
+        continue;
+      }
+
+      std::vector<std::string> props = {"fused_bn_epsilon=" +
+                                        getPropertyValue(*node, "epsilon")};
+      if (!axis.empty())
+        props.push_back("fused_bn_axis=" + axis);
+      target->setProperty(props);
+    } else {
+      if ((!is_gemm && target_type != AdditionLayer::type) ||
+          has_activation.count(target_name) ||
+          !isFusableActivation(node->getActivationType()))
+        continue;
+
+      props::Activation act;
+      act.set(node->getActivationType());
+      target->setProperty({"fused_activation=" + to_string(act)});
+      has_activation.insert(target_name);
+    }
+
+    ml_logd("fused %s into %s", node->getName().c_str(), target_name.c_str());
+    remap_table[node->getName()] = target_name;
+    num_consumers[target_name] = num_consumers[node->getName()];
+  }
+
+  GraphRepresentation processed;
+  for (auto &node : reference) {
+    if (remap_table.count(node->getName()) == 0)
+      processed.push_back(node);
+  }
+
+  return RemapRealizer([&remap_table](std::string &name, unsigned &idx) {
+           if (auto iter = remap_table.find(name); iter != remap_table.end()) {
+             name = iter->second;
+           }
+         })
+    .realize(processed);
+}
+
+} // namespace nntrainer
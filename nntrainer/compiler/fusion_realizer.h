@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file fusion_realizer.h
+ * @date 18 Oct 2026
+ * @brief NNTrainer graph realizer which fuses batch normalization and
+ * activation layers into the layer before them for inference
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+#ifndef __FUSION_REALIZER_H__
+#define __FUSION_REALIZER_H__
+
+#include <memory>
+#include <vector>
+
+#include <realizer.h>
+
+namespace nntrainer {
+
+/**
+ * @brief Graph realizer class which fuses layers for inference
+ *
+ * @details A batch normalization right after a conv2d or fully_connected layer
+ * is folded into the weight and bias of that layer. An elementwise activation
+ * right after a conv2d, fully_connected or addition layer is run by that layer
+ * on its output. A layer is fused only when it is the single consumer of the
+ * layer before it, so no other layer sees the intermediate result.
+ * @note the batch normalization must come after the layer it is folded into in
+ * the graph, so that the saved weights are read in the same order
+ */
+class FusionRealizer final : public GraphRealizer {
+public:
+  /**
+   * @brief Construct a new Fusion Realizer object
+   *
+   */
+  FusionRealizer() = default;
+
+  /**
+   * @brief Destroy the Fusion Realizer object
+   *
+   */
+  ~FusionRealizer() = default;
+
+  /**
+   * @brief graph realizer creates a new graph based on the reference
+   * @note fusion realizer removes the fused layers and sets the fused
+   * properties on the layers they are fused into
+   * @param reference GraphRepresentation to be realized
+   * @throw std::invalid_argument if graph is ill formed
+   *
+   */
+  GraphRepresentation realize(const GraphRepresentation &reference) override;
+};
+
+} // namespace nntrainer
+
+#endif // __FUSION_REALIZER_H__
@@ -34,6 +34,7 @@
 #include <nntrainer_log.h>
 #include <node_exporter.h>
 #include <numeric>
+#include <profiler.h>
 #include <sstream>
 #include <stdexcept>
 #include <stdio.h>
@@ -43,6 +44,29 @@
 
 namespace nntrainer {
 
+#ifdef PROFILE
+namespace {
+
+/**
+ * @brief profile key of waiting for a filled iteration
+ */
+int fetchEventKey() {
+  static int key = profile::Profiler::Global().registerTimeItem("data_fetch");
+  return key;
+}
+
+/**
+ * @brief profile key of generating a sample
+ */
+int generateEventKey() {
+  static int key =
+    profile::Profiler::Global().registerTimeItem("data_generate");
+  return key;
+}
+
+} // namespace
+#endif
+
 /**
  * @brief Props containing buffer size value
  *
@@ -108,8 +132,10 @@ DataBuffer::startFetchWorker(const std::vector<TensorDim> &input_dims,
           << "[Databuffer] Cannot fill empty buffer";
         auto &sample = sample_view.get();
         try {
+          PROFILE_TIME_START(generateEventKey());
           bool last =
             generator(i, sample.getInputsRef(), sample.getLabelsRef());
+          PROFILE_TIME_END(generateEventKey());
           if (last) {
             break;
           }
@@ -140,8 +166,10 @@ DataBuffer::startFetchWorker(const std::vector<TensorDim> &input_dims,
         << "[Databuffer] Cannot fill empty buffer";
       auto &sample = sample_view.get();
       try {
+        PROFILE_TIME_START(generateEventKey());
         generator(shuffle ? idxes[i] : i, sample.getInputsRef(),
                   sample.getLabelsRef());
+        PROFILE_TIME_END(generateEventKey());
       } catch (std::exception &e) {
         ml_loge("Fetching sample failed, Error: %s", e.what());
         throw;
@@ -158,7 +186,11 @@ ScopedView<Iteration> DataBuffer::fetch() {
   NNTR_THROW_IF(!iq, std::runtime_error)
     << "Cannot fetch, either fetcher is not running or fetcher has ended and "
        "invalidated";
-  return iq->requestFilledSlot();
+
+  PROFILE_TIME_START(fetchEventKey());
+  auto iteration = iq->requestFilledSlot();
+  PROFILE_TIME_END(fetchEventKey());
+  return iteration;
 }
 
 std::tuple<DataProducer::Generator /** generator */, unsigned int /** size */>
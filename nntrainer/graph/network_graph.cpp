@@ -42,6 +42,7 @@
 #include <util_func.h>
 #include <weight_layer.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <stdexcept>
@@ -338,6 +339,9 @@ void NetworkGraph::applyGradients(
 
   TRACE_MEMORY() << node->getName() + ": AG";
   TRACE_TIME() << node->getName() + ": AG";
+  ScopedLatency scoped_latency(
+    node->getLatency(LayerNode::LatencyType::APPLY_GRADIENT));
+  PROFILE_TIME_START(node->apply_grad_event_key);
 
   auto &rc = node->getRunContext();
   auto num_weight = rc.getNumWeights();
@@ -365,14 +369,22 @@ void NetworkGraph::applyGradients(
       continue;
     }
 
+    if (!accumulateGradient(rc.getWeightObject(i))) {
+      continue;
+    }
+
     apply_func(rc.getWeightObject(i));
   }
+  PROFILE_TIME_END(node->apply_grad_event_key);
 }
 
 sharedConstTensors NetworkGraph::forwarding(
   bool training,
   std::function<void(std::shared_ptr<LayerNode>, bool)> forwarding_op,
   std::function<bool(void *userdata)> stop_cb, void *userdata) {
+  if (!recompute_segments.empty())
+    tensor_manager->deactivateRecompute();
+
   for (auto iter = cbegin(); iter != cend() && !stop_cb(userdata); iter++) {
     auto &ln = *iter;
     PROFILE_TIME_START(profile_keys.at(ln->getType()));
@@ -444,6 +456,10 @@ bool NetworkGraph::backwarding(
 
   for (iter_ = iter_begin; iter_ != iter_end && !stop_cb(userdata); iter_++) {
     auto &ln = *iter_;
+    if (auto segment = recompute_segments.find(ln.get());
+        segment != recompute_segments.end())
+      recompute(segment->second, forwarding_op);
+
     PROFILE_TIME_START(profile_keys.at(ln->getType()));
     is_valid = backwarding_op(ln, iteration);
     PROFILE_TIME_END(profile_keys.at(ln->getType()));
@@ -489,6 +505,19 @@ bool NetworkGraph::backwarding(
   if (lazy_weights.empty())
     return true;
 
+  /**
+   * @note the delayed gradients are accumulated once the whole micro-batch is
+   * valid, so a micro-batch run again with a smaller loss scale is not
+   * accumulated twice. They are clipped and applied on the last micro-batch.
+   */
+  if (accumulation_steps > 1) {
+    for (auto w : lazy_weights) {
+      accumulateGradient(*w);
+    }
+    if (isAccumulating())
+      return true;
+  }
+
   if (is_clip_grad) {
     /** calculate the global norm */
     Tensor global_norm_t(
@@ -589,8 +618,136 @@ void NetworkGraph::allocateTensors(ExecutionMode exec_mode_) {
      * @todo if model is gradient clipping, we have to add last execution order
      * + 1
      */
-    tensor_manager->allocateTensors(
-      std::get<3>(backward_iter_end->getExecutionOrder()));
+    unsigned int max_exec_order =
+      std::get<3>(backward_iter_end->getExecutionOrder());
+    planRecompute(max_exec_order);
+    tensor_manager->allocateTensors(max_exec_order);
+  }
+}
+
+void NetworkGraph::planRecompute(unsigned int max_exec_order) {
+  std::vector<bool> recompute(graph.size(), false);
+  for (unsigned int idx = 0; idx < graph.size(); ++idx) {
+    recompute[idx] = getSortedLayerNode(idx)->getRecompute();
+  }
+
+  setRecomputeSegments(recompute, max_exec_order);
+  if (memory_budget == 0)
+    return;
+
+  size_t planned = tensor_manager->planTensors(max_exec_order);
+  if (planned <= memory_budget)
+    return;
+
+  /** layers running in place are recomputed with the layer they run on */
+  std::vector<std::vector<unsigned int>> groups;
+  for (unsigned int idx = 0; idx < graph.size(); ++idx) {
+    auto const &lnode = getSortedLayerNode(idx);
+    if (recompute[idx] || lnode->requireLabel() ||
+        lnode->getNumInputConnections() == 0)
+      continue;
+
+    if (lnode->getInPlaceType() == InPlaceType::NONE)
+      groups.push_back({idx});
+    else if (!groups.empty() && groups.back().back() + 1 == idx)
+      groups.back().push_back(idx);
+  }
+
+  /**
+   * keep every k-th group and recompute the others. Longer segments keep less
+   * activations from the forwarding but recompute more at once, so try each
+   * k and take the smallest one which fits the budget.
+   */
+  std::vector<bool> selected = recompute;
+  size_t selected_planned = planned;
+  for (unsigned int k = 2; k <= groups.size() + 1; ++k) {
+    std::vector<bool> candidate = recompute;
+    for (unsigned int g = 0; g < groups.size(); ++g) {
+      if (g % k == k - 1)
+        continue;
+      for (auto idx : groups[g])
+        candidate[idx] = true;
+    }
+
+    setRecomputeSegments(candidate, max_exec_order);
+    size_t size = tensor_manager->planTensors(max_exec_order);
+    if (size < selected_planned) {
+      selected = candidate;
+      selected_planned = size;
+    }
+    if (size <= memory_budget) {
+      selected = candidate;
+      selected_planned = size;
+      break;
+    }
+  }
+
+  setRecomputeSegments(selected, max_exec_order);
+  if (selected_planned > memory_budget)
+    ml_logw("tensor memory %zu bytes does not fit the budget %zu bytes",
+            selected_planned, memory_budget);
+
+  ml_logi("recomputing %zu layers in %zu segments, tensor memory: %zu bytes",
+          (size_t)std::count(selected.begin(), selected.end(), true),
+          recompute_segments.size(), selected_planned);
+}
+
+void NetworkGraph::setRecomputeSegments(const std::vector<bool> &recompute,
+                                        unsigned int max_exec_order) {
+  tensor_manager->clearRecompute();
+  recompute_segments.clear();
+
+  std::vector<std::shared_ptr<LayerNode>> segment;
+  auto close_segment = [this, &segment]() {
+    if (segment.empty())
+      return;
+
+    /** the segment is forwarded again when its last node starts backwarding */
+    unsigned int order = std::get<1>(segment.back()->getExecutionOrder());
+    for (auto &lnode : segment) {
+      auto &rc = lnode->getRunContext();
+      for (unsigned int i = 0; i < rc.getNumInputs(); ++i)
+        tensor_manager->setRecompute(rc.getInput(i).getName(), order, false);
+      for (unsigned int i = 0; i < rc.getNumOutputs(); ++i)
+        tensor_manager->setRecompute(rc.getOutput(i).getName(), order, true);
+      for (unsigned int i = 0; i < rc.getNumTensors(); ++i)
+        tensor_manager->setRecompute(rc.getTensor(i).getName(), order, true);
+    }
+    recompute_segments.emplace(segment.back().get(), std::move(segment));
+    segment.clear();
+  };
+
+  for (unsigned int idx = 0; idx < graph.size(); ++idx) {
+    auto const &lnode = getSortedLayerNode(idx);
+    /** loss and input layers are not recomputed */
+    if (!recompute[idx] || lnode->requireLabel() ||
+        lnode->getNumInputConnections() == 0 ||
+        std::get<1>(lnode->getExecutionOrder()) > max_exec_order) {
+      close_segment();
+      continue;
+    }
+    segment.push_back(lnode);
+  }
+  close_segment();
+
+  NNTR_THROW_IF(!recompute_segments.empty() && isMixedPrecision(),
+                std::invalid_argument)
+    << "recompute is not supported for mixed precision training";
+}
+
+void NetworkGraph::recompute(
+  const std::vector<std::shared_ptr<LayerNode>> &segment,
+  std::function<void(std::shared_ptr<LayerNode>, bool)> &forwarding_op) {
+  tensor_manager->activateRecompute(
+    std::get<1>(segment.back()->getExecutionOrder()));
+
+  for (auto &lnode : segment) {
+    /** layers restore their states such as the moving statistics and the
+     * dropout mask instead of updating them again */
+    lnode->getRunContext().reStoreData(true);
+    PROFILE_TIME_START(profile_keys.at(lnode->getType()));
+    forwarding_op(lnode, true);
+    PROFILE_TIME_END(profile_keys.at(lnode->getType()));
   }
 }
 
@@ -672,6 +829,11 @@ NetworkGraph::canExecuteInPlace(const std::shared_ptr<LayerNode> &lnode) {
     return inplace_type;
   }
 
+  /** a recomputed layer must not overwrite its input, which is read again */
+  if (lnode->getRecompute() && exec_mode == ExecutionMode::TRAIN) {
+    return InPlaceType::NONE;
+  }
+
   if (lnode->getType() == InputLayer::type &&
       !istrequal(getTensorType()[2], "FP32")) {
     return InPlaceType::NONE;
@@ -1263,7 +1425,8 @@ int NetworkGraph::initialize(ExecutionMode mode,
          */
         if (tensor_manager->isLastAccess(rc.getWeightGrad(i).getName(),
                                          last_grad_access) ||
-            ((rc.isGradientClipByGlobalNorm(i) || rc.isMixedPrecision(i)) &&
+            ((rc.isGradientClipByGlobalNorm(i) || rc.isMixedPrecision(i) ||
+              tensor_manager->isGradientKept()) &&
              tensor_manager->isSecondLastAccess(rc.getWeightGrad(i).getName(),
                                                 last_grad_access))) {
           rc.getWeightObject(i).setAsGradientLastAccess();
@@ -1476,7 +1639,8 @@ int NetworkGraph::reinitialize(
          */
         if (tensor_manager->isLastAccess(rc.getWeightGrad(i).getName(),
                                          last_grad_access) ||
-            (rc.isGradientClipByGlobalNorm(i) &&
+            ((rc.isGradientClipByGlobalNorm(i) ||
+              tensor_manager->isGradientKept()) &&
              tensor_manager->isSecondLastAccess(rc.getWeightGrad(i).getName(),
                                                 last_grad_access))) {
           rc.getWeightObject(i).setAsGradientLastAccess();
@@ -1627,6 +1791,10 @@ bool NetworkGraph::checkLoadComplete(unsigned int order) {
   return tensor_manager->checkLoadComplete(order);
 }
 
+unsigned int NetworkGraph::getAdaptiveLookahead() {
+  return tensor_manager->getAdaptiveLookahead();
+}
+
 bool NetworkGraph::checkUnloadComplete(unsigned int order) {
   return tensor_manager->checkUnloadComplete(order);
 }
@@ -1650,6 +1818,58 @@ void NetworkGraph::requestOptimizerVariable(
   }
 }
 
+void NetworkGraph::requestGradientAccumulators() {
+  grad_accumulators.clear();
+  if (accumulation_steps == 1)
+    return;
+
+  for (auto const &w : tensor_manager->getWeights()) {
+    if (w->isGradientLastAccess() && w->hasGradient()) {
+      /// @note the accumulator is kept in full precision as the optimizer
+      /// variables are
+      TensorDim dim = w->getDim();
+      dim.setDataType(TensorDim::DataType::FP32);
+      grad_accumulators[w] = tensor_manager->requestWeightOptimizerVariables(
+        {dim}, w->getName(), ":grad_accum", TensorLifespan::MAX_LIFESPAN,
+        w->isGradientClipByGlobalNorm(), w->isMixedPrecision(),
+        Initializer::ZEROS)[0];
+    }
+  }
+}
+
+void NetworkGraph::clearGradientAccumulators() {
+  for (auto &[w, sum] : grad_accumulators) {
+    sum->setZero();
+  }
+  accumulation_step = 0;
+}
+
+bool NetworkGraph::accumulateGradient(Weight &w) {
+  if (accumulation_steps == 1)
+    return true;
+
+  Tensor &grad = w.getGradientRef();
+  Tensor &sum = *grad_accumulators.at(&w);
+
+  /// the sum is kept unscaled, as the loss scale may change between the
+  /// micro-batches
+  float scale = w.isMixedPrecision() ? w.getLossScale() : 1.0f;
+  if (grad.getDataType() == sum.getDataType()) {
+    sum.add_i(grad, 1.0f / scale);
+  } else {
+    sum.add_i(grad.clone(sum.getDataType()), 1.0f / scale);
+  }
+
+  if (isAccumulating())
+    return false;
+
+  /// the loss of each micro-batch is averaged over the micro-batch
+  sum.multiply_i(scale / accumulation_steps);
+  grad.copyData(sum);
+  sum.setZero();
+  return true;
+}
+
 void NetworkGraph::resetLossScale(float scale) {
   loss_scale = scale;
   for (auto iter = cbegin(); iter != cend(); iter++) {
@@ -19,6 +19,7 @@
 #include <map>
 #include <memory>
 #include <stack>
+#include <unordered_map>
 #include <vector>
 
 #include <graph_core.h>
@@ -51,7 +52,10 @@ public:
     tensor_format("NCHW"),
     tensor_dtype(split("FP32-FP32", getRegex("\\-"))),
     is_clip_grad(false),
-    loss_scale(1.0f) {
+    loss_scale(1.0f),
+    accumulation_steps(1),
+    accumulation_step(0),
+    memory_budget(0) {
     nan_count = 0;
   }
 
@@ -82,7 +86,10 @@ public:
     tensor_format(tensor_format_),
     tensor_dtype(split(tensor_dtype_, getRegex("\\-"))),
     is_clip_grad(false),
-    loss_scale(1.0f) {
+    loss_scale(1.0f),
+    accumulation_steps(1),
+    accumulation_step(0),
+    memory_budget(0) {
     nan_count = 0;
   }
 
@@ -176,12 +183,14 @@ public:
    * @brief try apply gradient if possible
    * @note if it is not the last of the gradient access, this is noop
    * @note if the gradient is to be clipped by norm, this is noop
+   * @note if the gradient is accumulated for a later micro-batch, this only
+   * accumulates it
    *
    * @param node node to try apply gradient
    * @param apply_func apply function
    */
-  static void applyGradients(LayerNode *node,
-                             const std::function<void(Weight &)> &apply_func);
+  void applyGradients(LayerNode *node,
+                      const std::function<void(Weight &)> &apply_func);
 
   /**
    * @brief     forwarding network graph
@@ -385,6 +394,21 @@ public:
    */
   void deallocateWeights() { tensor_manager->deallocateWeights(); }
 
+  /**
+   * @brief Share the weights of another graph of the same layers instead of
+   * allocating them
+   *
+   * @param owner graph whose weights are allocated
+   */
+  void shareWeights(NetworkGraph &owner) {
+    tensor_manager->shareWeights(*owner.tensor_manager);
+  }
+
+  /**
+   * @brief check if the weights are shared from another graph
+   */
+  bool isWeightShared() const { return tensor_manager->isWeightShared(); }
+
   /**
    * @brief     Enable the memory optimizations for the network
    *
@@ -395,6 +419,24 @@ public:
     optimize_memory = val;
   }
 
+  /**
+   * @brief Keep the gradients until the end of the iteration to apply them
+   * after the backwarding
+   *
+   * @param val true to keep, else false
+   */
+  void setKeepGradients(bool val) { tensor_manager->setKeepGradients(val); }
+
+  /**
+   * @brief Keep the gradients for the whole training so that they outlive the
+   * iteration
+   *
+   * @param val true to keep, else false
+   */
+  void setPersistentGradients(bool val) {
+    tensor_manager->setPersistentGradients(val);
+  }
+
   /**
    * @brief     Create optimizer variable for every weights
    *
@@ -405,6 +447,49 @@ public:
     std::function<std::vector<TensorDim>(const TensorDim &)> cb,
     bool request_only_trainable = true);
 
+  /**
+   * @brief Set the number of the micro-batches whose gradients are summed
+   * before they are applied
+   *
+   * @param steps number of the micro-batches of a batch
+   */
+  void setGradientAccumulation(unsigned int steps) {
+    accumulation_steps = steps;
+    accumulation_step = 0;
+  }
+
+  /**
+   * @brief Get the number of the micro-batches whose gradients are summed
+   * before they are applied
+   */
+  unsigned int getGradientAccumulation() const { return accumulation_steps; }
+
+  /**
+   * @brief Set the micro-batch of the batch to run
+   *
+   * @param step index of the micro-batch in the batch
+   */
+  void setAccumulationStep(unsigned int step) { accumulation_step = step; }
+
+  /**
+   * @brief check if the gradients are only accumulated, as the micro-batch is
+   * not the last one of the batch
+   */
+  bool isAccumulating() const {
+    return accumulation_step + 1 < accumulation_steps;
+  }
+
+  /**
+   * @brief Create a gradient accumulator for every weight to train if the
+   * gradients are accumulated
+   */
+  void requestGradientAccumulators();
+
+  /**
+   * @brief Zero the gradient accumulators
+   */
+  void clearGradientAccumulators();
+
   /**
    * @brief Feed inputs and labels to the graph
    *
@@ -467,6 +552,13 @@ public:
    */
   bool checkLoadComplete(const unsigned int order);
 
+  /**
+   * @brief Get the number of execution orders to preload
+   *
+   * @return lookahead adapted to the measured load and compute time
+   */
+  unsigned int getAdaptiveLookahead();
+
   /**
    * @brief check data of order is Unloaded
    *
@@ -535,6 +627,24 @@ public:
     tensor_manager->setWeightOffset(offsets);
   }
 
+  /**
+   * @brief set the memory budget of the tensors for training, layers are
+   * recomputed in addition to the ones set with recompute=true until the
+   * planned tensor memory fits the budget
+   *
+   * @param budget budget in bytes, 0 to recompute the set layers only
+   */
+  void setMemoryBudget(size_t budget) { memory_budget = budget; }
+
+  /**
+   * @brief set the codec of the swapped data per tensor lifespan
+   *
+   * @param codecs codec of each lifespan
+   */
+  void setSwapCompression(const SwapCompressor::CodecMap &codecs) {
+    tensor_manager->setSwapCompression(codecs);
+  }
+
 private:
   std::map<std::string, std::string> sub_in_out; /** This is map to identify
                  input and output layer name of subgraph */
@@ -576,6 +686,14 @@ private:
   bool is_clip_grad;
   float loss_scale;
   unsigned int nan_count;
+  unsigned int accumulation_steps; /**< micro-batches of a batch */
+  unsigned int accumulation_step;  /**< micro-batch being run */
+  std::unordered_map<const Weight *, Tensor *>
+    grad_accumulators; /**< sum of the gradients of the micro-batches */
+  size_t memory_budget; /**< tensor memory budget for training in bytes */
+  std::map<const LayerNode *, std::vector<std::shared_ptr<LayerNode>>>
+    recompute_segments; /**< last node of a recomputed segment -> nodes of the
+                           segment in the forwarding order */
 
   /**
    * @brief     topological sort
@@ -668,6 +786,44 @@ private:
    */
   void inPlaceOptimize();
 
+  /**
+   * @brief     Plan the recomputation of the layers for training
+   * @details   Consecutive layers with recompute=true form a segment. The
+   * forward activations of a segment are dropped after their last use in the
+   * forwarding, and the segment is forwarded again right before the
+   * backwarding of its last layer. If a memory budget is set, the other
+   * layers are recomputed as well except for every k-th one, with the
+   * smallest k which makes the tensors fit the budget.
+   * @param[in] max_exec_order the maximum order of execution of the tensors
+   */
+  void planRecompute(unsigned int max_exec_order);
+
+  /**
+   * @brief     Set the recomputed segments and their tensors
+   * @param[in] recompute recompute flag of each node in the sorted order
+   * @param[in] max_exec_order the maximum order of execution of the tensors
+   */
+  void setRecomputeSegments(const std::vector<bool> &recompute,
+                            unsigned int max_exec_order);
+
+  /**
+   * @brief     Forward the segment again before its backwarding
+   * @param[in] segment nodes of the segment in the forwarding order
+   * @param[in] forwarding_op operation for the forwarding
+   */
+  void recompute(const std::vector<std::shared_ptr<LayerNode>> &segment,
+                 std::function<void(std::shared_ptr<LayerNode>, bool)>
+                   &forwarding_op);
+
+  /**
+   * @brief     Add the gradient of the micro-batch to the accumulator of the
+   * weight, and turn the gradient into the one of the whole batch on the last
+   * micro-batch
+   * @param[in] w weight whose gradient is finished
+   * @retval    true if the gradient is to be applied
+   */
+  bool accumulateGradient(Weight &w);
+
   /**
    * @brief     Check if the given node can execute in-place
    *
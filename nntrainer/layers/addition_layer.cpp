@@ -24,7 +24,11 @@ namespace nntrainer {
 static constexpr size_t SINGLE_INOUT_IDX = 0;
 
 void AdditionLayer::finalize(InitLayerContext &context) {
+  NNTR_THROW_IF(fusion.hasBatchNorm(), std::invalid_argument)
+    << "batch normalization can not be folded into an addition layer";
+
   context.setOutputDimensions({context.getInputDimensions()[0]});
+  fusion.finalize(context, TensorDim());
 }
 
 void AdditionLayer::forwarding(RunLayerContext &context, bool training) {
@@ -39,6 +43,7 @@ void AdditionLayer::forwarding(RunLayerContext &context, bool training) {
       hidden_.add_i(input_);
     }
   }
+  fusion.runActivation(hidden_);
 }
 
 void AdditionLayer::incremental_forwarding(RunLayerContext &context,
@@ -49,10 +54,8 @@ void AdditionLayer::incremental_forwarding(RunLayerContext &context,
   TensorDim hidden_step_dim = hidden_dim;
 
   if (from) {
-    NNTR_THROW_IF(to - from != 1, std::invalid_argument)
-      << "incremental step size is not 1";
+    to -= from;
     from = 0;
-    to = 1;
   }
 
   hidden_step_dim.batch(1);
@@ -79,6 +82,7 @@ void AdditionLayer::incremental_forwarding(RunLayerContext &context,
         hidden_step.add_i(input_step);
       }
     }
+    fusion.runActivation(hidden_step);
   }
 }
 
@@ -96,7 +100,7 @@ void AdditionLayer::calcDerivative(RunLayerContext &context) {
 }
 
 void AdditionLayer::setProperty(const std::vector<std::string> &values) {
-  auto remain_props = loadProperties(values, add_props);
+  auto remain_props = fusion.setProperty(loadProperties(values, add_props));
   if (!remain_props.empty()) {
     std::string msg = "[AdditionLayer] Unknown Layer Properties count " +
                       std::to_string(values.size());
@@ -17,6 +17,7 @@
 
 #include <common_properties.h>
 #include <layer_devel.h>
+#include <layer_fusion.h>
 
 namespace nntrainer {
 
@@ -80,7 +81,9 @@ public:
    * method)
    */
   void exportTo(Exporter &exporter,
-                const ml::train::ExportMethods &method) const override {}
+                const ml::train::ExportMethods &method) const override {
+    fusion.exportTo(exporter, method);
+  }
 
   /**
    * @copydoc Layer::setProperty(const std::vector<std::string> &values)
@@ -95,6 +98,8 @@ public:
   std::tuple<props::Print>
     add_props; /**< fc layer properties : unit - number of output neurons */
 
+  LayerFusion fusion; /**< activation fused */
+
   static constexpr const char *type = "addition";
 };
 
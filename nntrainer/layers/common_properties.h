@@ -115,6 +115,17 @@ public:
   using prop_tag = bool_prop_tag;
 };
 
+/**
+ * @brief recompute property, the forward activations of the layer are dropped
+ * after use and computed again before its backwarding
+ *
+ */
+class Recompute : public nntrainer::Property<bool> {
+public:
+  static constexpr const char *key = "recompute";
+  using prop_tag = bool_prop_tag;
+};
+
 /**
  * @brief Tensor Dimension property
  *
@@ -1014,6 +1025,79 @@ public:
   static constexpr const char *key = "recurrent_activation";
 };
 
+/**
+ * @brief FusedActivation Enumeration Information, activation run by the layer
+ * on its own output. This is set by the fusion realizer for inference
+ *
+ */
+class FusedActivation final : public EnumProperty<ActivationTypeInfo> {
+public:
+  using prop_tag = enum_class_prop_tag;
+  static constexpr const char *key = "fused_activation";
+};
+
+/**
+ * @brief FusedBatchNormEpsilon property, epsilon of the batch normalization
+ * folded into the layer. This is set by the fusion realizer for inference
+ *
+ */
+class FusedBatchNormEpsilon : public nntrainer::Property<float> {
+public:
+  static constexpr const char *key = "fused_bn_epsilon"; /**< unique key */
+  using prop_tag = float_prop_tag;                       /**< property type */
+};
+
+/**
+ * @brief FusedBatchNormAxis property, axis of the batch normalization folded
+ * into the layer when it is set explicitly. This is set by the fusion realizer
+ * for inference
+ *
+ */
+class FusedBatchNormAxis : public Axis {
+public:
+  static constexpr const char *key = "fused_bn_axis"; /**< unique key */
+  using prop_tag = uint_prop_tag;                     /**< property type */
+};
+
+/**
+ * @brief     Enumeration of the data types fake quantization simulates
+ */
+struct FakeQuantTypeInfo {
+  using Enum = TensorDim::DataType;
+  static constexpr std::initializer_list<Enum> EnumList = {Enum::QINT4,
+                                                           Enum::QINT8};
+  static constexpr const char *EnumStr[] = {"QINT4", "QINT8"};
+};
+
+/**
+ * @brief FakeQuant property, data type whose rounding is simulated during
+ * quantization aware training. Set on a model, the fake quantization realizer
+ * sets it on the layers whose weight is quantized
+ *
+ */
+class FakeQuant final : public EnumProperty<FakeQuantTypeInfo> {
+public:
+  using prop_tag = enum_class_prop_tag;
+  static constexpr const char *key = "fake_quant";
+};
+
+/**
+ * @brief RowRange property, fake quantization takes the range of each row
+ * from the row, as the int8 gemm quantizes its input, instead of the moving
+ * average of the range
+ *
+ */
+class RowRange : public nntrainer::Property<bool> {
+public:
+  /**
+   * @brief Construct a RowRange object
+   *
+   */
+  RowRange(bool val = false) : nntrainer::Property<bool>(val) {}
+  using prop_tag = bool_prop_tag;
+  static constexpr const char *key = "row_range";
+};
+
 /**
  * @brief     Enumeration of tensor initialization type
  */
@@ -1482,6 +1566,33 @@ public:
   using prop_tag = uint_prop_tag;                  /**< property type */
 };
 
+/**
+ * @brief LoRA adapters property, the number of adapters held at once
+ * @details Each item of the batch takes one of the adapters, which share the
+ * rank and the frozen weight of the layer
+ */
+class LoraAdapters : public PositiveIntegerProperty {
+public:
+  static constexpr const char *key =
+    "lora_adapters";              /**< unique key to access */
+  using prop_tag = uint_prop_tag; /**< property type */
+};
+
+/**
+ * @brief LoRA merged property, to add the LoRA into the weight for inference
+ * @details The weight runs alone with the LoRA merged, and is restored as it
+ * was when the property is unset or the layer trains again
+ */
+class LoraMerged : public nntrainer::Property<bool> {
+public:
+  /**
+   * @brief Construct a LoraMerged object
+   */
+  LoraMerged(bool val = false) : nntrainer::Property<bool>(val) {}
+  static constexpr const char *key = "lora_merged"; /**< unique key to access */
+  using prop_tag = bool_prop_tag;                   /**< property type */
+};
+
 /**
  * @brief properties for getting the clipping value to clip the gradient by norm
  *
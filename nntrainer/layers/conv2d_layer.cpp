@@ -15,6 +15,7 @@
 #include <cstring>
 #include <limits>
 #include <string>
+#include <vector>
 
 #include <conv2d_layer.h>
 #include <cpu_backend.h>
@@ -331,7 +332,13 @@ void Conv2DLayer::finalize(InitLayerContext &context) {
   TensorDim kernel_dim = TensorDim(filter_size, in_dim.channel(),
                                    kernel_size[0], kernel_size[1], in_t_type);
 
-  TensorDim bias_dim = TensorDim(1, filter_size, 1, 1, in_t_type);
+  /// a quantized filter keeps its bias in the activation data type
+  auto bias_t_type = in_t_type;
+  if (in_t_type.data_type == Tdatatype::QINT4 ||
+      in_t_type.data_type == Tdatatype::QINT8)
+    bias_t_type.data_type = context.getActivationDataType();
+
+  TensorDim bias_dim = TensorDim(1, filter_size, 1, 1, bias_t_type);
 
   padding = std::get<props::Padding2D>(conv_props)
               .compute(in_dim, kernel_dim, {stride[0], stride[1]},
@@ -375,6 +382,9 @@ void Conv2DLayer::finalize(InitLayerContext &context) {
                   eff_in_width - padding[2] - kernel_size[1] > IM,
                 std::invalid_argument)
     << "Failed to initialize: Calculated patch end is over int max";
+
+  fake_quant.finalize(context, kernel_dim, QScheme::PER_TENSOR_AFFINE);
+  fusion.finalize(context, bias_dim, out_dim, 1);
 }
 
 void Conv2DLayer::forwarding(RunLayerContext &context, bool training) {
@@ -388,7 +398,23 @@ void Conv2DLayer::forwarding(RunLayerContext &context, bool training) {
   Tensor &input_ = context.getInput(SINGLE_INOUT_IDX);
   Tensor &hidden_ = context.getOutput(SINGLE_INOUT_IDX);
 
-  Tensor &filter_kernel = context.getWeight(wt_idx[ConvParams::weight]);
+  Tensor &filter_weight = context.getWeight(wt_idx[ConvParams::weight]);
+
+  Tensor *bias = nullptr;
+  if (auto &disable_bias = std::get<props::DisableBias>(*layer_impl_props);
+      disable_bias.empty() || disable_bias.get() == false) {
+    bias = &context.getWeight(wt_idx[ConvParams::bias]);
+  }
+  foldWeights(context, false);
+  bias = fusion.getBias(context, bias);
+
+  Tensor &filter_kernel = fake_quant.quantize(context, filter_weight);
+
+  /// bias and activation are run on each output while it is in cache
+  const bool run_epilogue =
+    hidden_.getFormat() == Tformat::NCHW &&
+    hidden_.getDataType() == TensorDim::DataType::FP32 &&
+    (!bias || bias->getDataType() == TensorDim::DataType::FP32);
 
   /** Calculate Convolution 2D
    *
@@ -436,6 +462,16 @@ void Conv2DLayer::forwarding(RunLayerContext &context, bool training) {
 
   filter_kernel.reshape(filter_dim_squeezed);
 
+  /// an int8 filter runs an int8 gemm of the patches quantized on the fly
+  const bool int8_gemm =
+    run_epilogue && filter_kernel.getDataType() == Tdatatype::QINT8;
+  std::vector<float> filter_scales;
+  if (int8_gemm) {
+    NNTR_THROW_IF(filter_kernel.scale_size() != 1, std::invalid_argument)
+      << "[Conv2D] only a per tensor scale of an int8 filter is supported";
+    filter_scales.assign(filter_size, *filter_kernel.getScale<float>());
+  }
+
   /**
    * Below sets the pad area values to zero
    * it is faster to do this way than seting selective area to zero
@@ -444,14 +480,40 @@ void Conv2DLayer::forwarding(RunLayerContext &context, bool training) {
                             void *user_data) {
     Tensor result = Tensor(calcCol2ImOutputDim(out_dim, filter_dim));
     result.setZero();
+
+    const unsigned int OHW = out_dim.width() * out_dim.height();
+    const unsigned int CRS = filter_dim_squeezed.width();
+    std::vector<int8_t> q_result;
+    std::vector<float> result_scales, out_t;
+    if (int8_gemm) {
+      q_result.resize((size_t)OHW * CRS);
+      result_scales.resize(OHW);
+      out_t.resize((size_t)OHW * filter_size);
+    }
+
     for (unsigned int b = s; b < e; ++b) {
       Tensor out = hidden_.getBatchSlice(b, 1);
-      out.reshape({filter_size, out_dim.width() * out_dim.height()});
+      out.reshape({filter_size, OHW});
       Tensor in_sub = input_.getBatchSlice(b, 1);
 
       im2col(in_sub, filter_dim, padding, stride, dilation, result);
+      if (int8_gemm) {
+        // result is (OH*OW, CRS) and filter kernel is (K, CRS)
+        quantize_rows_s8(OHW, CRS, result.getData<float>(), q_result.data(),
+                         result_scales.data());
+        qgemm_s8(OHW, filter_size, CRS, q_result.data(), result_scales.data(),
+                 filter_kernel.getData<int8_t>(), filter_scales.data(), true,
+                 bias ? bias->getData<float>() : nullptr, out_t.data());
+        transpose_matrix(OHW, filter_size, out_t.data(), filter_size,
+                         out.getData<float>(), OHW);
+        fusion.runEpilogue(out, filter_size, OHW, nullptr, true);
+        continue;
+      }
+
       // filter kernel is (K, CRS), result is (CRS, OH*OW)
       filter_kernel.dot(result, out, false, true);
+      if (run_epilogue)
+        fusion.runEpilogue(out, filter_size, OHW, bias, true);
     }
     result.deallocate();
   };
@@ -465,13 +527,14 @@ void Conv2DLayer::forwarding(RunLayerContext &context, bool training) {
   }
 
   filter_kernel.reshape(filter_dim);
-  if (auto &disable_bias = std::get<props::DisableBias>(*layer_impl_props);
-      disable_bias.empty() || disable_bias.get() == false) {
-    Tensor &bias_kernel = context.getWeight(wt_idx[ConvParams::bias]);
-    status = hidden_.add_i(bias_kernel);
-    if (status != ML_ERROR_NONE) {
-      throw std::invalid_argument("[Conv2D] adding bias failed");
+  if (!run_epilogue) {
+    if (bias) {
+      status = hidden_.add_i(*bias);
+      if (status != ML_ERROR_NONE) {
+        throw std::invalid_argument("[Conv2D] adding bias failed");
+      }
     }
+    fusion.runActivation(hidden_);
   }
 }
 
@@ -483,7 +546,8 @@ void Conv2DLayer::calcDerivative(RunLayerContext &context) {
 
   const Tensor &derivative = context.getIncomingDerivative(SINGLE_INOUT_IDX);
   Tensor &input_derivative = context.getOutgoingDerivative(SINGLE_INOUT_IDX);
-  Tensor &filter_kernel = context.getWeight(wt_idx[ConvParams::weight]);
+  Tensor &filter_kernel = fake_quant.getWeight(
+    context, context.getWeight(wt_idx[ConvParams::weight]));
 
   TensorDim filter_dim = filter_kernel.getDim();
   TensorDim filter_dim_squeezed{filter_kernel.batch(),
@@ -627,11 +691,46 @@ void Conv2DLayer::exportTo(Exporter &exporter,
                            const ml::train::ExportMethods &method) const {
   LayerImpl::exportTo(exporter, method);
   exporter.saveResult(conv_props, method, this);
+  fusion.exportTo(exporter, method);
+  fake_quant.exportTo(exporter, method);
 }
 
 void Conv2DLayer::setProperty(const std::vector<std::string> &values) {
   auto remain_props = loadProperties(values, conv_props);
-  LayerImpl::setProperty(remain_props);
+  LayerImpl::setProperty(
+    fake_quant.setProperty(fusion.setProperty(remain_props)));
+}
+
+void Conv2DLayer::read(std::ifstream &file, RunLayerContext &run_context,
+                       bool opt_var, ml::train::ExecutionMode mode,
+                       bool trainable,
+                       TensorDim::DataType defineWeightDataType) {
+  LayerImpl::read(file, run_context, opt_var, mode, trainable,
+                  defineWeightDataType);
+
+  /// the weight read anew is folded again
+  if (!opt_var) {
+    fusion.reset();
+    foldWeights(run_context, false);
+  }
+}
+
+void Conv2DLayer::foldWeights(RunLayerContext &run_context, bool folded) {
+  if (folded) {
+    fusion.setFolded();
+    return;
+  }
+
+  unsigned int filter_size = std::get<props::FilterSize>(conv_props);
+  Tensor &filter_weight = run_context.getWeight(wt_idx[ConvParams::weight]);
+  Tensor *bias = nullptr;
+  if (auto &disable_bias = std::get<props::DisableBias>(*layer_impl_props);
+      disable_bias.empty() || disable_bias.get() == false) {
+    bias = &run_context.getWeight(wt_idx[ConvParams::bias]);
+  }
+  fusion.foldBatchNorm(
+    run_context, filter_weight,
+    TensorDim(filter_size, 1, 1, 1, filter_weight.getTensorType()), bias);
 }
 
 } /* namespace nntrainer */
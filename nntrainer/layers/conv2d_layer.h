@@ -18,6 +18,8 @@
 #include <memory.h>
 
 #include <common_properties.h>
+#include <layer_fake_quant.h>
+#include <layer_fusion.h>
 #include <layer_impl.h>
 
 namespace nntrainer {
@@ -98,6 +100,20 @@ public:
    */
   void setProperty(const std::vector<std::string> &values) override;
 
+  /**
+   * @copydoc Layer::foldWeights(RunLayerContext &run_context, bool folded)
+   */
+  void foldWeights(RunLayerContext &run_context, bool folded) override;
+
+  /**
+   * @copydoc Layer::read(std::ifstream &file, RunLayerContext &run_context,
+   * bool opt_var, ml::train::ExecutionMode mode, bool trainable,
+   * TensorDim::DataType defineWeightDataType)
+   */
+  void read(std::ifstream &file, RunLayerContext &run_context, bool opt_var,
+            ml::train::ExecutionMode mode, bool trainable,
+            TensorDim::DataType defineWeightDataType) override;
+
   /* TO DO : support keras type of padding */
   /* enum class PaddingType { */
   /*   full = 0, */
@@ -116,6 +132,8 @@ private:
     conv_props;
 
   std::array<unsigned int, 5> wt_idx; /**< indices of the weights and tensors */
+  LayerFusion fusion; /**< batch normalization and activation fused */
+  LayerFakeQuant fake_quant; /**< fake quantization of the weight */
 };
 
 } // namespace nntrainer
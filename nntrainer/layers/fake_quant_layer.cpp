@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   fake_quant_layer.cpp
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  This is Fake Quantization Layer Class for quantization aware training
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <cpu_backend.h>
+#include <fake_quant_layer.h>
+#include <layer_context.h>
+#include <nntrainer_error.h>
+#include <node_exporter.h>
+
+namespace nntrainer {
+
+static constexpr size_t SINGLE_INOUT_IDX = 0;
+
+FakeQuantLayer::FakeQuantLayer() :
+  Layer(),
+  fake_quant_props(props::FakeQuant(), props::Momentum(), props::RowRange()),
+  range_idx(std::numeric_limits<unsigned>::max()) {}
+
+void FakeQuantLayer::finalize(InitLayerContext &context) {
+  NNTR_THROW_IF(context.getNumInputs() != 1, std::invalid_argument)
+    << "Fake quant layer takes only one input";
+  NNTR_THROW_IF(context.getActivationDataType() != TensorDim::DataType::FP32,
+                std::invalid_argument)
+    << "Fake quant layer supports FP32 activations only";
+
+  context.setOutputDimensions(context.getInputDimensions());
+  if (std::get<props::RowRange>(fake_quant_props))
+    return;
+
+  TensorDim range_dim(1, 1, 1, 1,
+                      {context.getFormat(), TensorDim::DataType::FP32});
+  range_idx =
+    context.requestWeight(range_dim, Initializer::ZEROS,
+                          WeightRegularizer::NONE, 1.0f, 0.0f, "range", false);
+}
+
+float FakeQuantLayer::getQuantMax() const {
+  auto &fake_quant = std::get<props::FakeQuant>(fake_quant_props);
+  /// symmetric as the input quantization of the int8 gemm
+  return !fake_quant.empty() && fake_quant.get() == TensorDim::DataType::QINT4
+           ? 7.0f
+           : 127.0f;
+}
+
+void FakeQuantLayer::forwarding(RunLayerContext &context, bool training) {
+  Tensor &input_ = context.getInput(SINGLE_INOUT_IDX);
+  Tensor &output_ = context.getOutput(SINGLE_INOUT_IDX);
+  const float quant_max = getQuantMax();
+
+  if (std::get<props::RowRange>(fake_quant_props)) {
+    const unsigned int cols = input_.width();
+    const unsigned int rows = input_.size() / cols;
+    const float *data = input_.getData<float>();
+    std::vector<float> scales(rows);
+    for (unsigned int i = 0; i < rows; ++i) {
+      float max_abs = 0.0f;
+      for (unsigned int j = 0; j < cols; ++j)
+        max_abs = std::max(max_abs, std::abs(data[(size_t)i * cols + j]));
+      scales[i] =
+        std::max(max_abs / quant_max, std::numeric_limits<float>::epsilon());
+    }
+    fake_quantize(rows, cols, data, output_.getData<float>(), scales.data(),
+                  false, -quant_max, quant_max);
+    return;
+  }
+
+  Tensor &range = context.getWeight(range_idx);
+  float *range_ = range.getData<float>();
+
+  /// the range is not updated again when the forwarding is recomputed
+  if (training && !context.reStoreData()) {
+    float max_abs = std::abs(input_.max_abs());
+    float momentum = std::get<props::Momentum>(fake_quant_props);
+    *range_ = *range_ > 0.0f
+                ? momentum * *range_ + (1.0f - momentum) * max_abs
+                : max_abs;
+  }
+
+  if (*range_ <= 0.0f) {
+    output_.copyData(input_);
+    return;
+  }
+
+  const float scale = *range_ / quant_max;
+  fake_quantize(1, input_.size(), input_.getData<float>(),
+                output_.getData<float>(), &scale, false, -quant_max,
+                quant_max);
+}
+
+void FakeQuantLayer::calcDerivative(RunLayerContext &context) {
+  const Tensor &derivative_ = context.getIncomingDerivative(SINGLE_INOUT_IDX);
+  Tensor &ret_ = context.getOutgoingDerivative(SINGLE_INOUT_IDX);
+  const Tensor &input_ = context.getInput(SINGLE_INOUT_IDX);
+
+  /// a row is never out of its own range
+  if (std::get<props::RowRange>(fake_quant_props)) {
+    ret_.copyData(derivative_);
+    return;
+  }
+
+  const float range = *context.getWeight(range_idx).getData<float>();
+  if (range <= 0.0f) {
+    ret_.copyData(derivative_);
+    return;
+  }
+
+  const float quant_max = getQuantMax();
+  fake_quantize_grad(input_.size(), input_.getData<float>(),
+                     derivative_.getData<float>(), ret_.getData<float>(),
+                     range / quant_max, -quant_max, quant_max);
+}
+
+void FakeQuantLayer::exportTo(Exporter &exporter,
+                              const ml::train::ExportMethods &method) const {
+  exporter.saveResult(fake_quant_props, method, this);
+}
+
+void FakeQuantLayer::setProperty(const std::vector<std::string> &values) {
+  auto remain_props = loadProperties(values, fake_quant_props);
+  NNTR_THROW_IF(!remain_props.empty(), std::invalid_argument)
+    << "[FakeQuantLayer] Unknown Layer Properties count " +
+         std::to_string(remain_props.size());
+}
+
+} /* namespace nntrainer */
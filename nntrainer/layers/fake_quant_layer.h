@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   fake_quant_layer.h
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  This is Fake Quantization Layer Class for quantization aware training
+ *
+ */
+
+#ifndef __FAKE_QUANT_LAYER_H__
+#define __FAKE_QUANT_LAYER_H__
+#ifdef __cplusplus
+
+#include <common_properties.h>
+#include <layer_devel.h>
+
+namespace nntrainer {
+
+/**
+ * @class   FakeQuantLayer
+ * @brief   Rounds its input to the grid of a symmetric quantization whose
+ * range follows the input
+ *
+ * @details The range is the exponential moving average of the largest
+ * absolute value of the input over the training iterations, kept as a
+ * non-trainable weight. The input passes as it is until a range is observed.
+ * The derivative passes straight through where the input is in the range and
+ * is zero where it is clipped.
+ *
+ * With row_range, every row takes its largest absolute value as its range, as
+ * the int8 gemm quantizes its input at inference, and nothing is clipped.
+ */
+class FakeQuantLayer : public Layer {
+public:
+  /**
+   * @brief     Constructor of Fake Quant Layer
+   */
+  FakeQuantLayer();
+
+  /**
+   * @brief     Destructor of Fake Quant Layer
+   */
+  ~FakeQuantLayer() = default;
+
+  /**
+   *  @brief  Move constructor of FakeQuantLayer.
+   *  @param[in] FakeQuantLayer &&
+   */
+  FakeQuantLayer(FakeQuantLayer &&rhs) noexcept = default;
+
+  /**
+   * @brief  Move assignment operator.
+   * @parma[in] rhs FakeQuantLayer to be moved.
+   */
+  FakeQuantLayer &operator=(FakeQuantLayer &&rhs) = default;
+
+  /**
+   * @copydoc Layer::finalize(InitLayerContext &context)
+   */
+  void finalize(InitLayerContext &context) override;
+
+  /**
+   * @copydoc Layer::forwarding(RunLayerContext &context, bool training)
+   */
+  void forwarding(RunLayerContext &context, bool training) override;
+
+  /**
+   * @copydoc Layer::calcDerivative(RunLayerContext &context)
+   */
+  void calcDerivative(RunLayerContext &context) override;
+
+  /**
+   * @copydoc Layer::exportTo(Exporter &exporter, ml::train::ExportMethods
+   * method)
+   */
+  void exportTo(Exporter &exporter,
+                const ml::train::ExportMethods &method) const override;
+
+  /**
+   * @copydoc Layer::getType()
+   */
+  const std::string getType() const override { return FakeQuantLayer::type; };
+
+  /**
+   * @copydoc Layer::supportBackwarding()
+   */
+  bool supportBackwarding() const override { return true; }
+
+  /**
+   * @copydoc Layer::setProperty(const PropertyType type, const std::string
+   * &value)
+   */
+  void setProperty(const std::vector<std::string> &values) override;
+
+  static constexpr const char *type = "fake_quant";
+
+private:
+  /**
+   * @brief get the largest quantized value
+   */
+  float getQuantMax() const;
+
+  std::tuple<props::FakeQuant, props::Momentum, props::RowRange>
+    fake_quant_props;
+  unsigned int range_idx; /**< index of the range of the input */
+};
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __FAKE_QUANT_LAYER_H__ */
@@ -22,12 +22,14 @@
  */
 
 #include <common_properties.h>
+#include <cpu_backend.h>
 #include <fc_layer.h>
 #include <layer_context.h>
 #include <lazy_tensor.h>
 #include <nntrainer_error.h>
 #include <nntrainer_log.h>
 #include <node_exporter.h>
+#include <quantizer.h>
 #include <util_func.h>
 
 #include <iostream>
@@ -35,19 +37,26 @@
 namespace nntrainer {
 
 static constexpr size_t SINGLE_INOUT_IDX = 0;
+static constexpr size_t ADAPTER_INPUT_IDX = 1;
 
 enum FCParams { weight, bias };
 enum LORAParams { loraA, loraB, loraTmp, loraOut };
+enum QuantParams { input, inputScales, weightScales };
+enum AdapterParams { adaptersA, adaptersB, adapterTmp };
 
 FullyConnectedLayer::FullyConnectedLayer() :
   LayerImpl(),
   lora_scaling(1.0f),
-  fc_props(props::Unit(), props::LoraRank(), props::LoraAlpha()) {
+  fc_props(props::Unit(), props::LoraRank(), props::LoraAlpha(),
+           props::LoraAdapters(), props::LoraMerged()) {
   weight_idx.fill(std::numeric_limits<unsigned>::max());
   lora_idx.fill(std::numeric_limits<unsigned>::max());
+  adapter_idx.fill(std::numeric_limits<unsigned>::max());
+  quant_idx.fill(std::numeric_limits<unsigned>::max());
 }
 
 void FullyConnectedLayer::finalize(InitLayerContext &context) {
+  exec_mode = context.getExecutionMode();
   auto &weight_regularizer =
     std::get<props::WeightRegularizer>(*layer_impl_props);
   auto &weight_regularizer_constant =
@@ -66,9 +75,15 @@ void FullyConnectedLayer::finalize(InitLayerContext &context) {
   lora_scaling = (lora_rank && !std::get<props::LoraAlpha>(fc_props).empty())
                    ? (float)std::get<props::LoraAlpha>(fc_props) / lora_rank
                    : 1;
+  const unsigned int num_adapters =
+    std::get<props::LoraAdapters>(fc_props).empty()
+      ? 0
+      : std::get<props::LoraAdapters>(fc_props).get();
 
-  NNTR_THROW_IF(context.getNumInputs() != 1, std::invalid_argument)
-    << "Fully connected layer takes only one input";
+  NNTR_THROW_IF(context.getNumInputs() != (num_adapters ? 2u : 1u),
+                std::invalid_argument)
+    << "Fully connected layer takes only one input, and the adapter of each "
+       "batch item with lora_adapters";
 
   std::vector<TensorDim> output_dims(1);
 
@@ -92,10 +107,17 @@ void FullyConnectedLayer::finalize(InitLayerContext &context) {
   // @todo : This NCHW format setting is just temporal, it needs to be set by
   // global configuration
 
+  /// a quantized weight keeps its bias in the activation data type
+  const bool is_quantized =
+    context.getWeightDataType() == Tdatatype::QINT4 ||
+    context.getWeightDataType() == Tdatatype::QINT8;
+
   /** Bias Dimension : (1, 1, 1, unit) */
   TensorDim bias_dim(
     1, is_nchw ? 1 : unit, 1, is_nchw ? unit : 1,
-    TensorDim::TensorType(context.getFormat(), context.getWeightDataType()),
+    TensorDim::TensorType(context.getFormat(),
+                          is_quantized ? context.getActivationDataType()
+                                       : context.getWeightDataType()),
     is_nchw ? 0b0001 : 0b0100);
 
   /** Weight Dimension : (1, 1, in_dim.width(), unit)*/
@@ -115,36 +137,34 @@ void FullyConnectedLayer::finalize(InitLayerContext &context) {
                             1.0f, bias_decay, "bias", true);
   }
 
-  /** create weights for LoRA */
-  if (lora_rank) {
+  /** create weights for LoRA, in the activation data type on a quantized
+   * weight to merge it into the dequantized weight */
+  if (lora_rank && !num_adapters) {
+    const TensorDim::TensorType lora_type(
+      context.getFormat(), is_quantized ? context.getActivationDataType()
+                                        : context.getWeightDataType());
 
     /** loraA Dimension : (1, 1, in_dim.width, lora_rank) */
     TensorDim loraA_dim(
       1, is_nchw ? 1 : lora_rank, is_nchw ? in_dim.width() : 1,
-      is_nchw ? lora_rank : in_dim.channel(),
-      TensorDim::TensorType(context.getFormat(), context.getWeightDataType()),
+      is_nchw ? lora_rank : in_dim.channel(), lora_type,
       is_nchw ? 0b0011 : 0b0101);
 
     /** loraB Dimension : (1, 1, lora_rank, unit) */
     TensorDim loraB_dim(
       1, is_nchw ? 1 : unit, is_nchw ? lora_rank : 1,
-      is_nchw ? unit : lora_rank,
-      TensorDim::TensorType(context.getFormat(), context.getWeightDataType()),
-      is_nchw ? 0b0011 : 0b0101);
+      is_nchw ? unit : lora_rank, lora_type, is_nchw ? 0b0011 : 0b0101);
 
     /** loraTmp Dimension : (B, 1, in_dim.height(), lora_rank) */
     TensorDim loraTmp_dim(
       in_dim.batch(), is_nchw ? 1 : lora_rank, is_nchw ? in_dim.height() : 1,
-      is_nchw ? lora_rank : in_dim.width(),
-      TensorDim::TensorType(context.getFormat(), context.getWeightDataType()),
+      is_nchw ? lora_rank : in_dim.width(), lora_type,
       is_nchw ? 0b1011 : 0b1101);
 
     /** loraTmp Dimension : (B, 1, in_dim.height(), unit) */
     TensorDim loraOut_dim(
       in_dim.batch(), is_nchw ? 1 : unit, is_nchw ? in_dim.height() : 1,
-      is_nchw ? unit : in_dim.width(),
-      TensorDim::TensorType(context.getFormat(), context.getWeightDataType()),
-      is_nchw ? 0b1011 : 0b1101);
+      is_nchw ? unit : in_dim.width(), lora_type, is_nchw ? 0b1011 : 0b1101);
 
     lora_idx[LORAParams::loraA] = context.requestWeight(
       loraA_dim, Initializer::ZEROS, weight_regularizer,
@@ -162,52 +182,359 @@ void FullyConnectedLayer::finalize(InitLayerContext &context) {
       context.requestTensor(loraOut_dim, "hidden_lora", Initializer::NONE, true,
                             TensorLifespan::FORWARD_FUNC_LIFESPAN);
   }
+
+  /**
+   * frozen adapters loaded at serving, each batch item takes the one the second
+   * input gives, counted from 1 with 0 for none. They are weights to outlive
+   * the inferences, but not those of the weight file.
+   */
+  if (num_adapters) {
+    NNTR_THROW_IF(!lora_rank, std::invalid_argument)
+      << "lora_adapters of " << context.getName() << " needs lora_rank";
+    NNTR_THROW_IF(std::get<props::LoraMerged>(fc_props).get(),
+                  std::invalid_argument)
+      << "multiple LoRA adapters of " << context.getName()
+      << " cannot be merged into the weight";
+    NNTR_THROW_IF(context.getExecutionMode() !=
+                    ml::train::ExecutionMode::INFERENCE,
+                  std::invalid_argument)
+      << "multiple LoRA adapters of " << context.getName()
+      << " serve inference only";
+    NNTR_THROW_IF(!is_nchw ||
+                    context.getActivationDataType() != Tdatatype::FP32,
+                  std::invalid_argument)
+      << "multiple LoRA adapters need NCHW FP32 activations";
+    NNTR_THROW_IF(
+      context.getInputDimensions()[ADAPTER_INPUT_IDX].getFeatureLen() != 1,
+      std::invalid_argument)
+      << "the adapter input of " << context.getName()
+      << " gives a single value per batch item";
+
+    const TensorDim::TensorType fp32 = {context.getFormat(), Tdatatype::FP32};
+
+    /** adapters A : (num_adapters, 1, in_dim.width, lora_rank) */
+    TensorDim adaptersA_dim(num_adapters, 1, in_dim.width(), lora_rank, fp32);
+    /** adapters B : (num_adapters, 1, lora_rank, unit) */
+    TensorDim adaptersB_dim(num_adapters, 1, lora_rank, unit, fp32);
+    /** low rank products : (B, 1, in_dim.height(), lora_rank) */
+    TensorDim tmp_dim(in_dim.batch(), 1, in_dim.height(), lora_rank, fp32,
+                      0b1011);
+
+    adapter_idx[AdapterParams::adaptersA] = context.requestWeight(
+      adaptersA_dim, Initializer::ZEROS, WeightRegularizer::NONE, 1.0f, 0.0f,
+      "lora_adapters_A", false);
+    adapter_idx[AdapterParams::adaptersB] = context.requestWeight(
+      adaptersB_dim, Initializer::ZEROS, WeightRegularizer::NONE, 1.0f, 0.0f,
+      "lora_adapters_B", false);
+    adapter_idx[AdapterParams::adapterTmp] =
+      context.requestTensor(tmp_dim, "hidden_tmp_lora", Initializer::NONE,
+                            false, TensorLifespan::FORWARD_FUNC_LIFESPAN);
+  }
+
+  /** int8 gemm of the input quantized row by row on the fly */
+  if (context.getWeightDataType() == Tdatatype::QINT8 && is_nchw &&
+      context.getActivationDataType() == Tdatatype::FP32) {
+    TensorDim q_input_dim(
+      in_dim.batch(), in_dim.channel(), in_dim.height(), in_dim.width(),
+      {context.getFormat(), Tdatatype::QINT8}, 0b1011);
+    TensorDim in_scales_dim(in_dim.batch(), in_dim.channel(), in_dim.height(),
+                            1, {context.getFormat(), Tdatatype::FP32}, 0b1010);
+    TensorDim w_scales_dim(1, 1, 1, unit,
+                           {context.getFormat(), Tdatatype::FP32}, 0b0001);
+
+    quant_idx[QuantParams::input] =
+      context.requestTensor(q_input_dim, "quantized_input", Initializer::NONE,
+                            false, TensorLifespan::FORWARD_FUNC_LIFESPAN);
+    quant_idx[QuantParams::inputScales] =
+      context.requestTensor(in_scales_dim, "input_scales", Initializer::NONE,
+                            false, TensorLifespan::FORWARD_FUNC_LIFESPAN);
+    quant_idx[QuantParams::weightScales] =
+      context.requestTensor(w_scales_dim, "weight_scales", Initializer::NONE,
+                            false, TensorLifespan::FORWARD_FUNC_LIFESPAN);
+  }
+
+  NNTR_THROW_IF(lora_rank && fake_quant.enabled(), std::invalid_argument)
+    << "fake quantization of the weight is not supported with LoRA";
+  fake_quant.finalize(context, weight_dim, QScheme::PER_CHANNEL_AFFINE);
+
+  fusion.finalize(context, bias_dim, output_dims[0], is_nchw ? 3 : 1);
 }
 
 void FullyConnectedLayer::exportTo(
   Exporter &exporter, const ml::train::ExportMethods &method) const {
   LayerImpl::exportTo(exporter, method);
   exporter.saveResult(fc_props, method, this);
+  fusion.exportTo(exporter, method);
+  fake_quant.exportTo(exporter, method);
 }
 
 void FullyConnectedLayer::setProperty(const std::vector<std::string> &values) {
   auto remain_props = loadProperties(values, fc_props);
-  LayerImpl::setProperty(remain_props);
+  LayerImpl::setProperty(
+    fake_quant.setProperty(fusion.setProperty(remain_props)));
 }
 
 void FullyConnectedLayer::setBatch(nntrainer::RunLayerContext &context,
                                    unsigned int batch) {
-  if (!std::get<props::LoraRank>(fc_props).empty()) {
+  if (!std::get<props::LoraAdapters>(fc_props).empty()) {
+    context.updateTensor(adapter_idx[AdapterParams::adapterTmp], batch);
+  } else if (!std::get<props::LoraRank>(fc_props).empty()) {
     // update Lora Tensor's batch info.
     context.updateTensor(lora_idx[LORAParams::loraTmp], batch);
     context.updateTensor(lora_idx[LORAParams::loraOut], batch);
   }
+
+  if (quant_idx[QuantParams::input] != std::numeric_limits<unsigned>::max()) {
+    context.updateTensor(quant_idx[QuantParams::input], batch);
+    context.updateTensor(quant_idx[QuantParams::inputScales], batch);
+  }
 }
 
-void FullyConnectedLayer::forwarding(RunLayerContext &context, bool training) {
+void FullyConnectedLayer::read(std::ifstream &file,
+                               RunLayerContext &run_context, bool opt_var,
+                               ml::train::ExecutionMode mode, bool trainable,
+                               TensorDim::DataType defineWeightDataType) {
+  if (std::get<props::LoraAdapters>(fc_props).empty() || opt_var) {
+    LayerImpl::read(file, run_context, opt_var, mode, trainable,
+                    defineWeightDataType);
+  } else {
+    /// the adapters are loaded apart from the frozen weight
+    for (auto idx : weight_idx) {
+      if (idx != std::numeric_limits<unsigned>::max())
+        run_context.getWeight(idx).read(file);
+    }
+  }
+  /// the weight read anew is folded and merged again
+  if (!opt_var) {
+    fusion.reset();
+    foldWeights(run_context, false);
+    lora_base.clear();
+    lora_merged = false;
+  }
+}
+
+void FullyConnectedLayer::foldWeights(RunLayerContext &run_context,
+                                      bool folded) {
+  if (folded)
+    fusion.setFolded();
+  else
+    prepareBias(run_context);
+}
+
+void FullyConnectedLayer::save(
+  std::ofstream &file, RunLayerContext &run_context, bool opt_var,
+  ml::train::ExecutionMode mode, bool trainable,
+  TensorDim::DataType definedWeightDataType) const {
+  if (!std::get<props::LoraAdapters>(fc_props).empty() && !opt_var) {
+    for (auto idx : weight_idx) {
+      if (idx != std::numeric_limits<unsigned>::max())
+        run_context.getWeight(idx).save(file);
+    }
+    return;
+  }
+
+  if (!lora_merged || opt_var) {
+    LayerImpl::save(file, run_context, opt_var, mode, trainable,
+                    definedWeightDataType);
+    return;
+  }
+
+  NNTR_THROW_IF(lora_base.empty(), std::invalid_argument)
+    << "the weight of " << run_context.getName()
+    << " has its LoRA merged in place for inference, and cannot be saved "
+       "apart from it";
+
+  /// a merged weight is saved as it was before the merge, and merged back
+  char *data =
+    run_context.getWeight(weight_idx[FCParams::weight]).getData<char>();
+  std::vector<char> merged(data, data + lora_base.size());
+  std::copy(lora_base.begin(), lora_base.end(), data);
+  try {
+    LayerImpl::save(file, run_context, opt_var, mode, trainable,
+                    definedWeightDataType);
+  } catch (...) {
+    std::copy(merged.begin(), merged.end(), data);
+    throw;
+  }
+  std::copy(merged.begin(), merged.end(), data);
+}
+
+Tensor *FullyConnectedLayer::prepareBias(RunLayerContext &context) {
   Tensor &weight = context.getWeight(weight_idx[FCParams::weight]);
-  Tensor &hidden_ = context.getOutput(SINGLE_INOUT_IDX);
-  Tensor &input_ = context.getInput(SINGLE_INOUT_IDX);
+  Tensor *bias = nullptr;
+  if (auto &disable_bias = std::get<props::DisableBias>(*layer_impl_props);
+      disable_bias.empty() || disable_bias.get() == false) {
+    bias = &context.getWeight(weight_idx[FCParams::bias]);
+  }
 
-  if (weight.getDataType() == nntrainer::Tdatatype::QINT4 ||
-      weight.getDataType() == nntrainer::Tdatatype::QINT8) {
-    Tdatatype dtype = input_.getDataType();
+  /// output channels of the weight are along the axis of the unit
+  TensorDim scale_dim = weight.getDim();
+  if (weight.getFormat() == Tformat::NCHW)
+    scale_dim.height(1);
+  else
+    scale_dim.width(1);
+  fusion.foldBatchNorm(context, weight, scale_dim, bias);
 
-    Tensor weight_(
-      {{weight.batch(), weight.channel(), weight.height(), weight.width()},
-       {weight.getFormat(), dtype}},
-      true);
+  return fusion.getBias(context, bias);
+}
 
-    unsigned int axis =
-      context.getWeightObject(weight_idx[FCParams::weight]).getOutputAxis();
+void FullyConnectedLayer::forwardingQuantized(RunLayerContext &context,
+                                              const Tensor &input,
+                                              const Tensor *bias,
+                                              Tensor &hidden) {
+  const Tensor &weight = context.getWeight(weight_idx[FCParams::weight]);
+  Tensor &q_input = context.getTensor(quant_idx[QuantParams::input]);
+  Tensor &in_scales = context.getTensor(quant_idx[QuantParams::inputScales]);
+
+  const unsigned int unit = std::get<props::Unit>(fc_props);
+  const unsigned int K = weight.height();
+  const unsigned int rows = input.size() / K;
+
+  quantize_rows_s8(rows, K, input.getData<float>(), q_input.getData<int8_t>(),
+                   in_scales.getData<float>());
+
+  /// a per tensor scale is spread over the columns
+  const float *w_scales = weight.getScale<float>();
+  if (weight.scale_size() != unit) {
+    Tensor &scales = context.getTensor(quant_idx[QuantParams::weightScales]);
+    scales.setValue(w_scales[0]);
+    w_scales = scales.getData<float>();
+  }
+
+  qgemm_s8(rows, unit, K, q_input.getData<int8_t>(), in_scales.getData<float>(),
+           weight.getData<int8_t>(), w_scales, false,
+           bias ? bias->getData<float>() : nullptr, hidden.getData<float>());
+}
+
+void FullyConnectedLayer::forwardingAdapters(RunLayerContext &context,
+                                             const Tensor &input,
+                                             Tensor &hidden,
+                                             unsigned int batch_from,
+                                             unsigned int batch_to) {
+  const Tensor &adapters_A =
+    context.getWeight(adapter_idx[AdapterParams::adaptersA]);
+  const Tensor &adapters_B =
+    context.getWeight(adapter_idx[AdapterParams::adaptersB]);
+  const float *index = context.getInput(ADAPTER_INPUT_IDX).getData<float>();
+  Tensor &hidden_tmp =
+    context.getTensor(adapter_idx[AdapterParams::adapterTmp]);
+
+  const unsigned int K = adapters_A.height();
+  const unsigned int R = adapters_A.width();
+  const unsigned int N = adapters_B.width();
+  const unsigned int rows = (input.size() / K) / (batch_to - batch_from);
+
+  /// consecutive batch items of an adapter make a single segment
+  std::vector<unsigned int> seg_start;
+  std::vector<int> adapters;
+  for (unsigned int b = batch_from; b < batch_to; ++b) {
+    const int adapter = std::max(static_cast<int>(index[b]) - 1, -1);
+    NNTR_THROW_IF(adapter >= (int)adapters_A.batch(), std::invalid_argument)
+      << "no LoRA adapter " << adapter << " in " << context.getName();
+    if (adapters.empty() || adapters.back() != adapter) {
+      seg_start.push_back((b - batch_from) * rows);
+      adapters.push_back(adapter);
+    }
+  }
+  seg_start.push_back((batch_to - batch_from) * rows);
+
+  lora_sgmv(adapters.size(), seg_start.data(), adapters.data(), K, N, R,
+            lora_scaling, input.getData<float>(), adapters_A.getData<float>(),
+            adapters_B.getData<float>(), hidden_tmp.getData<float>(),
+            hidden.getData<float>());
+}
+
+void FullyConnectedLayer::updateLoraMerged(RunLayerContext &context,
+                                           bool training) {
+  if (lora_idx[LORAParams::loraA] == std::numeric_limits<unsigned>::max())
+    return;
+
+  const bool merge = !training && std::get<props::LoraMerged>(fc_props).get();
+  if (merge && !lora_merged)
+    mergeLora(context);
+  else if (!merge && lora_merged)
+    unmergeLora(context);
+}
+
+void FullyConnectedLayer::mergeLora(RunLayerContext &context) {
+  Tensor &weight = context.getWeight(weight_idx[FCParams::weight]);
+  const Tensor &loraA = context.getWeight(lora_idx[LORAParams::loraA]);
+  const Tensor &loraB = context.getWeight(lora_idx[LORAParams::loraB]);
+  char *data = weight.getData<char>();
+  const size_t bytes = weight.getMemoryBytes();
+
+  /// the weight to restore is kept only if the layer may train, an inference
+  /// model merges in place
+  const bool keep_base = exec_mode == ml::train::ExecutionMode::TRAIN;
+
+  Tensor delta = loraA.dot(loraB);
+  delta.multiply_i(lora_scaling);
+
+  if (weight.getDataType() == Tdatatype::QINT4 ||
+      weight.getDataType() == Tdatatype::QINT8) {
+    Tensor merged = Quantization::createQuantizer(QScheme::PER_CHANNEL_AFFINE)
+                      ->dequantize(weight, Tdatatype::FP32);
+    merged.add_i(delta.clone(Tdatatype::FP32));
+
+    /// requantized in the scheme of the weight, with the scales of the sum
+    Tensor requantized = Quantization::createQuantizer(weight.q_scheme())
+                           ->quantize(merged, weight.getDataType());
+    NNTR_THROW_IF(requantized.getMemoryBytes() != bytes,
+                  std::invalid_argument)
+      << "LoRA of " << context.getName()
+      << " cannot be merged into the quantized weight";
+    if (keep_base)
+      lora_base.assign(data, data + bytes);
+    const char *q_data = requantized.getData<char>();
+    std::copy(q_data, q_data + bytes, data);
+  } else {
+    if (keep_base)
+      lora_base.assign(data, data + bytes);
+    weight.add_i(delta);
+  }
+  lora_merged = true;
+}
+
+void FullyConnectedLayer::unmergeLora(RunLayerContext &context) {
+  NNTR_THROW_IF(lora_base.empty(), std::invalid_argument)
+    << "the LoRA of " << context.getName()
+    << " is merged in place for inference, and cannot be unmerged";
+
+  Tensor &weight = context.getWeight(weight_idx[FCParams::weight]);
+  std::copy(lora_base.begin(), lora_base.end(), weight.getData<char>());
+  lora_base.clear();
+  lora_base.shrink_to_fit();
+  lora_merged = false;
+}
+
+void FullyConnectedLayer::forwarding(RunLayerContext &context, bool training) {
+  Tensor *bias = prepareBias(context);
+  updateLoraMerged(context, training);
+  Tensor &weight = fake_quant.quantize(
+    context, context.getWeight(weight_idx[FCParams::weight]));
+  Tensor &hidden_ = context.getOutput(SINGLE_INOUT_IDX);
+  Tensor &input_ = context.getInput(SINGLE_INOUT_IDX);
+
+  const bool int8_gemm =
+    quant_idx[QuantParams::input] != std::numeric_limits<unsigned>::max();
+  if (int8_gemm) {
+    forwardingQuantized(context, input_, bias, hidden_);
+  } else if (weight.getDataType() == nntrainer::Tdatatype::QINT4 ||
+             weight.getDataType() == nntrainer::Tdatatype::QINT8) {
+    /// dequantize either scheme, a per channel quantizer handles both
+    Tensor weight_ =
+      Quantization::createQuantizer(QScheme::PER_CHANNEL_AFFINE)
+        ->dequantize(weight, input_.getDataType());
 
-    // weight.dequantize(weight_, axis);
     input_.dot(weight_, hidden_, false, false);
   } else {
     input_.dot(weight, hidden_, false, false);
   }
 
-  if (!std::get<props::LoraRank>(fc_props).empty()) {
+  if (!std::get<props::LoraAdapters>(fc_props).empty()) {
+    forwardingAdapters(context, input_, hidden_, 0, input_.batch());
+  } else if (!std::get<props::LoraRank>(fc_props).empty() &&
+             !lora_merged) {
     Tensor &loraA = context.getWeight(lora_idx[LORAParams::loraA]);
     Tensor &loraB = context.getWeight(lora_idx[LORAParams::loraB]);
     Tensor &hidden_tmp_lora = context.getTensor(lora_idx[LORAParams::loraTmp]);
@@ -219,18 +546,19 @@ void FullyConnectedLayer::forwarding(RunLayerContext &context, bool training) {
     hidden_.add_i(hidden_out_lora);
   }
 
-  if (auto &disable_bias = std::get<props::DisableBias>(*layer_impl_props);
-      disable_bias.empty() || disable_bias.get() == false) {
-    Tensor &bias = context.getWeight(weight_idx[FCParams::bias]);
-    hidden_.add_i(bias);
-  }
+  const unsigned int unit = std::get<props::Unit>(fc_props);
+  fusion.runEpilogue(hidden_, hidden_.size() / unit, unit,
+                     int8_gemm ? nullptr : bias, false);
 }
 
 void FullyConnectedLayer::incremental_forwarding(RunLayerContext &context,
                                                  unsigned int from,
                                                  unsigned int to,
                                                  bool training) {
-  Tensor &weight = context.getWeight(weight_idx[FCParams::weight]);
+  Tensor *bias = prepareBias(context);
+  updateLoraMerged(context, training);
+  Tensor &weight = fake_quant.quantize(
+    context, context.getWeight(weight_idx[FCParams::weight]));
   Tensor &input_ = context.getInput(SINGLE_INOUT_IDX);
   Tensor &hidden_ = context.getOutput(SINGLE_INOUT_IDX);
 
@@ -241,12 +569,13 @@ void FullyConnectedLayer::incremental_forwarding(RunLayerContext &context,
   TensorDim hidden_step_dim = hidden_dim;
 
   if (from) {
-    NNTR_THROW_IF(to - from != 1, std::invalid_argument)
-      << "incremental step size is not 1";
+    to -= from;
     from = 0;
-    to = 1;
   }
 
+  const bool int8_gemm =
+    quant_idx[QuantParams::input] != std::numeric_limits<unsigned>::max();
+
   input_step_dim.batch(1);
   input_step_dim.height(to - from);
   hidden_step_dim.batch(1);
@@ -259,9 +588,15 @@ void FullyConnectedLayer::incremental_forwarding(RunLayerContext &context,
     Tensor hidden_step = hidden_.getSharedDataTensor(
       hidden_step_dim, b * hidden_dim.getFeatureLen(), true);
 
-    input_step.dot(weight, hidden_step, false, false);
+    if (int8_gemm)
+      forwardingQuantized(context, input_step, bias, hidden_step);
+    else
+      input_step.dot(weight, hidden_step, false, false);
 
-    if (!std::get<props::LoraRank>(fc_props).empty()) {
+    if (!std::get<props::LoraAdapters>(fc_props).empty()) {
+      forwardingAdapters(context, input_step, hidden_step, b, b + 1);
+    } else if (!std::get<props::LoraRank>(fc_props).empty() &&
+               !lora_merged) {
       Tensor &loraA = context.getWeight(lora_idx[LORAParams::loraA]);
       Tensor &loraB = context.getWeight(lora_idx[LORAParams::loraB]);
       Tensor &hidden_tmp_lora =
@@ -275,16 +610,15 @@ void FullyConnectedLayer::incremental_forwarding(RunLayerContext &context,
       hidden_step.add_i(hidden_out_lora);
     }
 
-    if (auto &disable_bias = std::get<props::DisableBias>(*layer_impl_props);
-        disable_bias.empty() || disable_bias.get() == false) {
-      Tensor &bias = context.getWeight(weight_idx[FCParams::bias]);
-      hidden_step.add_i(bias);
-    }
+    const unsigned int unit = std::get<props::Unit>(fc_props);
+    fusion.runEpilogue(hidden_step, hidden_step.size() / unit, unit,
+                       int8_gemm ? nullptr : bias, false);
   }
 }
 
 void FullyConnectedLayer::calcDerivative(RunLayerContext &context) {
-  Tensor &weight = context.getWeight(weight_idx[FCParams::weight]);
+  Tensor &weight = fake_quant.getWeight(
+    context, context.getWeight(weight_idx[FCParams::weight]));
 
   const Tensor &derivative_ = context.getIncomingDerivative(SINGLE_INOUT_IDX);
   Tensor &ret_ = context.getOutgoingDerivative(SINGLE_INOUT_IDX);
@@ -16,6 +16,8 @@
 #ifdef __cplusplus
 
 #include <common_properties.h>
+#include <layer_fake_quant.h>
+#include <layer_fusion.h>
 #include <layer_impl.h>
 
 namespace nntrainer {
@@ -109,18 +111,113 @@ public:
   void setBatch(nntrainer::RunLayerContext &context,
                 unsigned int batch) override;
 
+  /**
+   * @copydoc Layer::foldWeights(RunLayerContext &run_context, bool folded)
+   */
+  void foldWeights(RunLayerContext &run_context, bool folded) override;
+
+  /**
+   * @copydoc Layer::read(std::ifstream &file, RunLayerContext &run_context,
+   * bool opt_var, ml::train::ExecutionMode mode, bool trainable,
+   * TensorDim::DataType defineWeightDataType)
+   */
+  void read(std::ifstream &file, RunLayerContext &run_context, bool opt_var,
+            ml::train::ExecutionMode mode, bool trainable,
+            TensorDim::DataType defineWeightDataType) override;
+
+  /**
+   * @copydoc Layer::save(std::ofstream &file, RunLayerContext &run_context,
+   * bool opt_var, ml::train::ExecutionMode mode, bool trainable,
+   * TensorDim::DataType definedWeightDataType)
+   */
+  void save(std::ofstream &file, RunLayerContext &run_context, bool opt_var,
+            ml::train::ExecutionMode mode, bool trainable,
+            TensorDim::DataType definedWeightDataType) const override;
+
   static constexpr const char *type = "fully_connected";
 
 private:
+  /**
+   * @brief fold the fused batch normalization if not yet folded
+   *
+   * @param context run context of the layer
+   * @return Tensor* bias to add to the output, nullptr if none
+   */
+  Tensor *prepareBias(RunLayerContext &context);
+
+  /**
+   * @brief hidden = input x weight + bias for an int8 weight, with the input
+   * quantized row by row on the fly
+   *
+   * @param context run context of the layer
+   * @param input input rows of width of the weight height
+   * @param bias bias to add, nullptr if none
+   * @param hidden output rows of width unit
+   */
+  void forwardingQuantized(RunLayerContext &context, const Tensor &input,
+                           const Tensor *bias, Tensor &hidden);
+
+  /**
+   * @brief hidden += the low rank products of the adapters the batch items
+   * take, the items of one adapter in a row computed at once
+   *
+   * @param context run context of the layer
+   * @param input input rows of the batch items
+   * @param hidden output rows of the batch items
+   * @param batch_from first batch item of the rows
+   * @param batch_to end of the batch items of the rows
+   */
+  void forwardingAdapters(RunLayerContext &context, const Tensor &input,
+                          Tensor &hidden, unsigned int batch_from,
+                          unsigned int batch_to);
+
+  /**
+   * @brief merge the LoRA into the weight for inference or restore the weight
+   * as lora_merged asks, unmerged while training
+   *
+   * @param context run context of the layer
+   * @param training true if the layer trains
+   */
+  void updateLoraMerged(RunLayerContext &context, bool training);
+
+  /**
+   * @brief weight += lora_scaling * loraA x loraB, a quantized weight is
+   * requantized with the scales of the sum. The weight before the merge is
+   * kept to be restored only in the train mode.
+   *
+   * @param context run context of the layer
+   */
+  void mergeLora(RunLayerContext &context);
+
+  /**
+   * @brief restore the weight as it was before mergeLora()
+   *
+   * @param context run context of the layer
+   * @throw std::invalid_argument if the LoRA is merged in place
+   */
+  void unmergeLora(RunLayerContext &context);
+
   float lora_scaling;
-  std::tuple<props::Unit, props::LoraRank, props::LoraAlpha>
+  std::tuple<props::Unit, props::LoraRank, props::LoraAlpha,
+             props::LoraAdapters, props::LoraMerged>
     fc_props;                             /**< fc layer properties :
                                                 unit - number of output neurons,
                                                 lora_rank - rank of lora (optional)
                                                 lora_scaling - scaling factor of LoRA apply, i.e.,
-                                             lora_scaling = alpha / lora_rank */
+                                             lora_scaling = alpha / lora_rank
+                                                lora_adapters - number of LoRA adapters held (optional)
+                                                lora_merged - LoRA merged into the weight (optional) */
   std::array<unsigned int, 2> weight_idx; /**< indices of the weights */
   std::array<unsigned int, 4> lora_idx;   /**< indices of the lora weights */
+  std::array<unsigned int, 3> adapter_idx; /**< indices of the adapters */
+  std::array<unsigned int, 3> quant_idx;  /**< indices of the int8 buffers */
+  LayerFusion fusion; /**< batch normalization and activation fused */
+  LayerFakeQuant fake_quant; /**< fake quantization of the weight */
+  ml::train::ExecutionMode exec_mode =
+    ml::train::ExecutionMode::TRAIN; /**< execution mode finalized for */
+  bool lora_merged = false;          /**< LoRA merged into the weight */
+  std::vector<char> lora_base; /**< weight before the LoRA merged, empty if
+                                  the LoRA is not merged or merged in place */
 };
 } // namespace nntrainer
 
@@ -215,6 +215,9 @@ public:
    * @param     training true if training, false if inference
    *
    * @note      Output must be set in the output tensors.
+   * @note      When from is not 0, the to - from steps are held from the first
+   * row of the inputs and outputs, so that several steps can be verified at
+   * once.
    * @details   context provides access to the weights (if any), inputs,
    * outputs, and tensors (if any) for the layer. Input and output dimensions
    * can be access from the inputs/outputs tensors themselves.
@@ -355,6 +358,15 @@ public:
     }
   }
 
+  /**
+   * @brief     fold what the layer runs fused into its weights, once the
+   * weights are set
+   * @param     run_context run context for the layer
+   * @param     folded true if the weights are folded already, as the weights
+   * shared from a model which folded them, so that only the state is taken
+   */
+  virtual void foldWeights(RunLayerContext &run_context, bool folded) {}
+
   /**
    * @brief     read layer Weight & Bias data from file
    * @param file input file stream
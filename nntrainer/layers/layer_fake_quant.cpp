@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   layer_fake_quant.cpp
+ * @date   18 Oct 2026
+ * @brief  This is the fake quantization a layer runs on its weight for
+ * quantization aware training
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <cpu_backend.h>
+#include <layer_context.h>
+#include <layer_fake_quant.h>
+#include <nntrainer_error.h>
+#include <node_exporter.h>
+
+namespace nntrainer {
+
+LayerFakeQuant::LayerFakeQuant() :
+  qscheme(QScheme::PER_TENSOR_AFFINE),
+  weight_idx(std::numeric_limits<unsigned>::max()) {}
+
+std::vector<std::string>
+LayerFakeQuant::setProperty(const std::vector<std::string> &values) {
+  return loadProperties(values, props);
+}
+
+void LayerFakeQuant::exportTo(Exporter &exporter,
+                              const ml::train::ExportMethods &method) const {
+  if (method == ml::train::ExportMethods::METHOD_STRINGVECTOR)
+    exporter.saveResult(props, method);
+}
+
+void LayerFakeQuant::finalize(InitLayerContext &context,
+                              const TensorDim &weight_dim, QScheme qscheme_) {
+  if (!enabled())
+    return;
+
+  NNTR_THROW_IF(weight_dim.getDataType() != TensorDim::DataType::FP32,
+                std::invalid_argument)
+    << "fake quantization of " << context.getName() << " needs a FP32 weight";
+
+  qscheme = qscheme_;
+  weight_idx =
+    context.requestTensor(weight_dim, "fake_quant_weight", Initializer::NONE,
+                          false, TensorLifespan::FORWARD_DERIV_LIFESPAN);
+}
+
+Tensor &LayerFakeQuant::quantize(RunLayerContext &context, Tensor &weight) {
+  if (!enabled())
+    return weight;
+
+  Tensor &quantized = context.getTensor(weight_idx);
+
+  /// the range of the quantizers, whose scale spans (max - min) / 2
+  const bool is_int8 =
+    std::get<props::FakeQuant>(props).get() == TensorDim::DataType::QINT8;
+  const float quant_min = is_int8 ? -128.0f : -8.0f;
+  const float quant_max = is_int8 ? 127.0f : 7.0f;
+
+  const float *data = weight.getData<float>();
+  unsigned int cols = weight.width();
+  unsigned int rows = weight.size() / cols;
+  const bool col_scales = qscheme == QScheme::PER_CHANNEL_AFFINE && is_int8;
+
+  if (qscheme == QScheme::PER_TENSOR_AFFINE) {
+    scales.assign(1, std::abs(weight.max_abs()));
+    cols = weight.size();
+    rows = 1;
+  } else if (col_scales) {
+    scales.assign(cols, 0.0f);
+    for (unsigned int i = 0; i < rows; ++i)
+      for (unsigned int j = 0; j < cols; ++j)
+        scales[j] = std::max(scales[j], std::abs(data[(size_t)i * cols + j]));
+  } else {
+    scales.assign(rows, 0.0f);
+    for (unsigned int i = 0; i < rows; ++i)
+      for (unsigned int j = 0; j < cols; ++j)
+        scales[i] = std::max(scales[i], std::abs(data[(size_t)i * cols + j]));
+  }
+
+  for (auto &scale : scales)
+    scale = std::max(scale / ((quant_max - quant_min) / 2.0f),
+                     std::numeric_limits<float>::epsilon());
+
+  fake_quantize(rows, cols, data, quantized.getData<float>(), scales.data(),
+                col_scales, quant_min, quant_max);
+  return quantized;
+}
+
+Tensor &LayerFakeQuant::getWeight(RunLayerContext &context, Tensor &weight) {
+  return enabled() ? context.getTensor(weight_idx) : weight;
+}
+
+} // namespace nntrainer
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   layer_fake_quant.h
+ * @date   18 Oct 2026
+ * @brief  This is the fake quantization a layer runs on its weight for
+ * quantization aware training
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ *
+ */
+
+#ifndef __LAYER_FAKE_QUANT_H__
+#define __LAYER_FAKE_QUANT_H__
+#ifdef __cplusplus
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <common_properties.h>
+#include <quantizer.h>
+#include <tensor.h>
+
+namespace nntrainer {
+
+class InitLayerContext;
+class RunLayerContext;
+class Exporter;
+
+/**
+ * @class   LayerFakeQuant
+ * @brief   Weight rounded to the grid of its quantized data type, set by the
+ * FakeQuantRealizer
+ *
+ * @details The layer computes with a copy of its weight quantized and
+ * dequantized with the scales QuantizationCalibrator::save() gives it, so the
+ * trained weight exports to QINT8 / QINT4 as it is simulated. The gradient of
+ * the copy is applied to the float weight as it is, the straight through
+ * estimator.
+ */
+class LayerFakeQuant {
+public:
+  /**
+   * @brief     Constructor of LayerFakeQuant
+   */
+  LayerFakeQuant();
+
+  /**
+   * @brief set the fake quantization properties
+   *
+   * @param values values of the properties
+   * @return std::vector<std::string> properties which are not for the fake
+   * quantization
+   */
+  std::vector<std::string> setProperty(const std::vector<std::string> &values);
+
+  /**
+   * @brief export the fake quantization properties
+   *
+   * @param exporter exporter
+   * @param method export method
+   */
+  void exportTo(Exporter &exporter,
+                const ml::train::ExportMethods &method) const;
+
+  /**
+   * @brief finalize the fake quantization, requests the quantized copy of the
+   * weight
+   *
+   * @param context layer context
+   * @param weight_dim dimension of the weight
+   * @param qscheme_ PER_CHANNEL_AFFINE to quantize the columns of QINT8 and
+   * the rows of QINT4 with a scale each, PER_TENSOR_AFFINE for a single scale
+   * @throw std::invalid_argument if the weight is not of FP32
+   */
+  void finalize(InitLayerContext &context, const TensorDim &weight_dim,
+                QScheme qscheme_);
+
+  /**
+   * @brief check if the weight is fake quantized
+   */
+  bool enabled() const { return !std::get<props::FakeQuant>(props).empty(); }
+
+  /**
+   * @brief quantize the weight for the forwarding
+   *
+   * @param context run context of the layer
+   * @param weight float weight of the layer
+   * @return Tensor& the quantized copy, or @a weight if not enabled
+   */
+  Tensor &quantize(RunLayerContext &context, Tensor &weight);
+
+  /**
+   * @brief get the weight the forwarding computed with, for the derivative
+   *
+   * @param context run context of the layer
+   * @param weight float weight of the layer
+   * @return Tensor& the quantized copy, or @a weight if not enabled
+   */
+  Tensor &getWeight(RunLayerContext &context, Tensor &weight);
+
+private:
+  std::tuple<props::FakeQuant> props; /**< fake quantization properties */
+  QScheme qscheme;                    /**< scheme of the scales */
+  unsigned int weight_idx;            /**< index of the quantized copy */
+  std::vector<float> scales;          /**< scales of the last quantization */
+};
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __LAYER_FAKE_QUANT_H__ */
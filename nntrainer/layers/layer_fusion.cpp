@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   layer_fusion.cpp
+ * @date   18 Oct 2026
+ * @brief  This is the batch normalization and activation a layer runs fused
+ * for inference
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ *
+ */
+
+#include <limits>
+
+#include <cpu_backend.h>
+#include <layer_context.h>
+#include <layer_fusion.h>
+#include <nntrainer_error.h>
+#include <node_exporter.h>
+
+namespace nntrainer {
+
+enum FusedBNParams { mu, var, gamma, beta };
+
+LayerFusion::LayerFusion() : folded(false) {
+  bn_idx.fill(std::numeric_limits<unsigned>::max());
+}
+
+std::vector<std::string>
+LayerFusion::setProperty(const std::vector<std::string> &values) {
+  return loadProperties(values, fusion_props);
+}
+
+void LayerFusion::exportTo(Exporter &exporter,
+                           const ml::train::ExportMethods &method) const {
+  /// fused operations have no tflite counterpart of their own
+  if (method == ml::train::ExportMethods::METHOD_STRINGVECTOR)
+    exporter.saveResult(fusion_props, method);
+}
+
+void LayerFusion::finalize(InitLayerContext &context,
+                           const TensorDim &bn_dim, const TensorDim &out_dim,
+                           unsigned int channel_axis) {
+  auto &act = std::get<props::FusedActivation>(fusion_props);
+  bool fused = hasBatchNorm() || !act.empty();
+
+  NNTR_THROW_IF(fused && context.getExecutionMode() !=
+                           ml::train::ExecutionMode::INFERENCE,
+                std::invalid_argument)
+    << "fused operations of " << context.getName()
+    << " are supported for inference only";
+
+  if (!act.empty()) {
+    if (context.getActivationDataType() == TensorDim::DataType::FP16) {
+#ifdef ENABLE_FP16
+      acti_func.setActiFunc<_FP16>(act.get());
+#else
+      NNTR_THROW_IF(true, std::invalid_argument) << "enable-fp16 is not set!";
+#endif
+    } else {
+      acti_func.setActiFunc<float>(act.get());
+    }
+  }
+
+  if (!hasBatchNorm())
+    return;
+
+  NNTR_THROW_IF(bn_dim.getDataType() != TensorDim::DataType::FP32 &&
+                  bn_dim.getDataType() != TensorDim::DataType::FP16,
+                std::invalid_argument)
+    << "batch normalization can not be folded into quantized weights of "
+    << context.getName();
+
+  /// same as the batch normalization layer, which can not tell the channel is
+  /// actually 1 or it is just not used
+  auto &axis_prop = std::get<props::FusedBatchNormAxis>(fusion_props);
+  unsigned int axis = axis_prop.empty() ? (out_dim.channel() > 1 ? 1 : 3)
+                                        : axis_prop.get();
+  NNTR_THROW_IF(axis != channel_axis, std::invalid_argument)
+    << "batch normalization along axis " << axis << " can not be folded into "
+    << context.getName() << ", set the axis of the batch normalization";
+
+  bn_idx[FusedBNParams::mu] =
+    context.requestWeight(bn_dim, Initializer::ZEROS, WeightRegularizer::NONE,
+                          1.0f, 0.0f, "moving_mean", false);
+  bn_idx[FusedBNParams::var] =
+    context.requestWeight(bn_dim, Initializer::ONES, WeightRegularizer::NONE,
+                          1.0f, 0.0f, "moving_variance", false);
+  bn_idx[FusedBNParams::gamma] =
+    context.requestWeight(bn_dim, Initializer::ONES, WeightRegularizer::NONE,
+                          1.0f, 0.0f, "gamma", false);
+  bn_idx[FusedBNParams::beta] =
+    context.requestWeight(bn_dim, Initializer::ZEROS, WeightRegularizer::NONE,
+                          1.0f, 0.0f, "beta", false);
+}
+
+bool LayerFusion::hasBatchNorm() const {
+  return !std::get<props::FusedBatchNormEpsilon>(fusion_props).empty();
+}
+
+void LayerFusion::foldBatchNorm(RunLayerContext &context, Tensor &weight,
+                                const TensorDim &scale_dim, Tensor *bias) {
+  if (!hasBatchNorm() || folded)
+    return;
+
+  float epsilon = std::get<props::FusedBatchNormEpsilon>(fusion_props);
+  Tensor &mu = context.getWeight(bn_idx[FusedBNParams::mu]);
+  Tensor &var = context.getWeight(bn_idx[FusedBNParams::var]);
+  Tensor &gamma = context.getWeight(bn_idx[FusedBNParams::gamma]);
+  Tensor &beta = context.getWeight(bn_idx[FusedBNParams::beta]);
+
+  /// scale = gamma / sqrt(var + epsilon)
+  Tensor scale = var.add(epsilon);
+  scale.pow_i(-0.5f);
+  scale.multiply_i(gamma);
+
+  /// beta = beta - (mu - bias) * scale, which becomes the bias of the layer
+  if (bias)
+    mu.subtract_i(*bias);
+  mu.multiply_i(scale);
+  beta.subtract_i(mu);
+
+  scale.reshape(scale_dim);
+  weight.multiply_i(scale);
+
+  mu.setZero();
+  var.setValue(1.0f - epsilon);
+  gamma.setValue(1.0f);
+  if (bias)
+    bias->setZero();
+
+  folded = true;
+}
+
+Tensor *LayerFusion::getBias(RunLayerContext &context, Tensor *bias) {
+  if (hasBatchNorm())
+    return &context.getWeight(bn_idx[FusedBNParams::beta]);
+  return bias;
+}
+
+void LayerFusion::runEpilogue(Tensor &out, unsigned int rows,
+                              unsigned int cols, const Tensor *bias,
+                              bool bias_per_row) {
+  auto &act = std::get<props::FusedActivation>(fusion_props);
+  bool relu = !act.empty() && act.get() == ActivationType::ACT_RELU;
+
+  if (out.getDataType() == TensorDim::DataType::FP32 &&
+      (!bias || bias->getDataType() == TensorDim::DataType::FP32)) {
+    const float *bias_data = bias ? bias->getData<float>() : nullptr;
+    gemm_epilogue(rows, cols, out.getData<float>(),
+                  bias_per_row ? bias_data : nullptr,
+                  bias_per_row ? nullptr : bias_data, relu);
+    if (relu)
+      return;
+  } else if (bias) {
+    NNTR_THROW_IF(bias_per_row, std::invalid_argument)
+      << "bias per row is supported for FP32 only";
+    out.add_i(*bias);
+  }
+
+  runActivation(out);
+}
+
+void LayerFusion::runActivation(Tensor &out) {
+  auto &act = std::get<props::FusedActivation>(fusion_props);
+  if (!act.empty() && act.get() != ActivationType::ACT_NONE)
+    acti_func.run_fn(out, out);
+}
+
+} // namespace nntrainer
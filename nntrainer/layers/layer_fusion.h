@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   layer_fusion.h
+ * @date   18 Oct 2026
+ * @brief  This is the batch normalization and activation a layer runs fused
+ * for inference
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ *
+ */
+
+#ifndef __LAYER_FUSION_H__
+#define __LAYER_FUSION_H__
+#ifdef __cplusplus
+
+#include <array>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <acti_func.h>
+#include <common_properties.h>
+#include <tensor.h>
+
+namespace nntrainer {
+
+class InitLayerContext;
+class RunLayerContext;
+class Exporter;
+
+/**
+ * @class   LayerFusion
+ * @brief   Batch normalization folded into the weight of a layer and the
+ * activation run on its output, both set by the FusionRealizer
+ *
+ * @details The layer takes over the weights of the batch normalization in the
+ * order the batch normalization layer requests them, so the weights saved from
+ * the unfused graph are read as they are. After folding, the batch
+ * normalization weights are left as identity so that saving and reading the
+ * folded weights keeps the result.
+ */
+class LayerFusion {
+public:
+  /**
+   * @brief     Constructor of LayerFusion
+   */
+  LayerFusion();
+
+  /**
+   * @brief set the fusion properties
+   *
+   * @param values values of the properties
+   * @return std::vector<std::string> properties which are not for the fusion
+   */
+  std::vector<std::string> setProperty(const std::vector<std::string> &values);
+
+  /**
+   * @brief export the fusion properties
+   *
+   * @param exporter exporter
+   * @param method export method
+   */
+  void exportTo(Exporter &exporter,
+                const ml::train::ExportMethods &method) const;
+
+  /**
+   * @brief finalize the fusion, requests the batch normalization weights
+   *
+   * @param context layer context
+   * @param bn_dim dimension of the batch normalization weights
+   * @param out_dim output dimension of the layer, which the axis of the batch
+   * normalization is derived from when it is not set
+   * @param channel_axis axis of the output the batch normalization can be
+   * folded along
+   * @throw std::invalid_argument if anything is fused for training or the
+   * batch normalization is not along @a channel_axis
+   */
+  void finalize(InitLayerContext &context, const TensorDim &bn_dim,
+                const TensorDim &out_dim = TensorDim(),
+                unsigned int channel_axis = 1);
+
+  /**
+   * @brief check if a batch normalization is folded into the layer
+   *
+   * @return true if a batch normalization is folded
+   */
+  bool hasBatchNorm() const;
+
+  /**
+   * @brief fold the batch normalization into the weight and the bias unless
+   * it is folded, this is done once after the weights are set
+   *
+   * @param context run context of the layer
+   * @param weight weight whose output channels are scaled
+   * @param scale_dim dimension of the per channel scale broadcast on @a weight
+   * @param bias bias of the layer, nullptr if disabled
+   */
+  void foldBatchNorm(RunLayerContext &context, Tensor &weight,
+                     const TensorDim &scale_dim, Tensor *bias);
+
+  /**
+   * @brief get the bias to add after the gemm
+   *
+   * @param context run context of the layer
+   * @param bias bias of the layer, nullptr if disabled
+   * @return Tensor* bias to add, nullptr if none
+   */
+  Tensor *getBias(RunLayerContext &context, Tensor *bias);
+
+  /**
+   * @brief add the bias and run the activation on the gemm output
+   *
+   * @param out row major @a rows x @a cols matrix
+   * @param rows number of rows
+   * @param cols number of columns
+   * @param bias bias to add, nullptr if none
+   * @param bias_per_row add the bias per row if true, per column otherwise
+   * @note bias per row is supported for FP32 only
+   */
+  void runEpilogue(Tensor &out, unsigned int rows, unsigned int cols,
+                   const Tensor *bias, bool bias_per_row);
+
+  /**
+   * @brief run the activation in place
+   *
+   * @param out tensor to run the activation on
+   */
+  void runActivation(Tensor &out);
+
+  /**
+   * @brief mark the batch normalization to be folded again, when the weights
+   * are read anew
+   */
+  void reset() { folded = false; }
+
+  /**
+   * @brief mark the batch normalization folded, when the weights are shared
+   * from a model which folded them
+   */
+  void setFolded() { folded = true; }
+
+private:
+  std::tuple<props::FusedActivation, props::FusedBatchNormEpsilon,
+             props::FusedBatchNormAxis>
+    fusion_props; /**< fusion properties */
+  std::array<unsigned int, 4>
+    bn_idx;          /**< mean, variance, gamma and beta of the batch norm */
+  ActiFunc acti_func; /**< fused activation */
+  bool folded;        /**< batch normalization is folded */
+};
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __LAYER_FUSION_H__ */
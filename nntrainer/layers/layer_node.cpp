@@ -44,6 +44,7 @@ namespace nntrainer {
 static constexpr const char *FORWARD_SUFFIX = ":forward";
 static constexpr const char *CALC_DERIV_SUFFIX = ":calcDeriv";
 static constexpr const char *CALC_GRAD_SUFFIX = ":calcGrad";
+static constexpr const char *APPLY_GRAD_SUFFIX = ":applyGrad";
 #endif
 
 namespace props {
@@ -202,7 +203,7 @@ LayerNode::LayerNode(std::unique_ptr<nntrainer::Layer> &&l) :
   layer_node_props(new PropsType(
     props::Name(), props::Distribute(), props::Trainable(), {}, {},
     props::SharedFrom(), props::ClipGradByGlobalNorm(), props::Packed(),
-    props::LossScaleForMixed(), props::ComputeEngine())),
+    props::LossScaleForMixed(), props::ComputeEngine(), props::Recompute())),
   layer_node_props_realization(
     new RealizationPropsType(props::Flatten(), props::Activation())),
   loss(new props::Loss()),
@@ -401,6 +402,11 @@ bool LayerNode::getFlatten() const {
   return flatten.get();
 }
 
+bool LayerNode::getRecompute() const {
+  auto &recompute = std::get<props::Recompute>(*layer_node_props);
+  return !recompute.empty() && recompute.get();
+}
+
 std::string LayerNode::getSharedFrom() const {
   auto &shared_from = std::get<props::SharedFrom>(*layer_node_props);
   return shared_from.empty() ? "" : shared_from.get();
@@ -492,6 +498,12 @@ void LayerNode::read(std::ifstream &file, bool opt_var,
   }
 }
 
+void LayerNode::foldWeights(bool folded) {
+  NNTR_THROW_IF(!run_context, std::runtime_error)
+    << __func__ << " layer needs to be finalized first!";
+  getLayer()->foldWeights(*run_context, folded);
+}
+
 void LayerNode::save(std::ofstream &file, bool opt_var,
                      ml::train::ExecutionMode mode) const {
   NNTR_THROW_IF(!run_context, std::runtime_error)
@@ -646,6 +658,8 @@ InitLayerContext LayerNode::finalize(const std::vector<TensorDim> &input_dims,
                               profile_name(CALC_DERIV_SUFFIX));
   PROFILE_TIME_REGISTER_EVENT(calc_grad_event_key,
                               profile_name(CALC_GRAD_SUFFIX));
+  PROFILE_TIME_REGISTER_EVENT(apply_grad_event_key,
+                              profile_name(APPLY_GRAD_SUFFIX));
 
   return context;
 }
@@ -739,6 +753,8 @@ LayerNode::refinalize(const std::vector<TensorDim> &input_dims) {
                               profile_name(CALC_DERIV_SUFFIX));
   PROFILE_TIME_REGISTER_EVENT(calc_grad_event_key,
                               profile_name(CALC_GRAD_SUFFIX));
+  PROFILE_TIME_REGISTER_EVENT(apply_grad_event_key,
+                              profile_name(APPLY_GRAD_SUFFIX));
 
   return context;
 }
@@ -749,6 +765,7 @@ LayerNode::refinalize(const std::vector<TensorDim> &input_dims) {
 void LayerNode::forwarding(bool training) {
   loss->set(run_context->getRegularizationLoss());
 
+  ScopedLatency scoped_latency(getLatency(LatencyType::FORWARD));
   PROFILE_TIME_START(forward_event_key);
   if (reStoreData()) {
     if (getInPlaceType() == InPlaceType::NONE) {
@@ -765,7 +782,11 @@ void LayerNode::forwarding(bool training) {
     }
   }
 
+  if (forward_observer)
+    forward_observer(*this, *run_context, false);
   layer->forwarding(*run_context, training);
+  if (forward_observer)
+    forward_observer(*this, *run_context, true);
   reStoreData(false);
   PROFILE_TIME_END(forward_event_key);
   TRACE_MEMORY() << getName() + ": F";
@@ -788,8 +809,13 @@ void LayerNode::forwarding(bool training) {
 void LayerNode::incremental_forwarding(unsigned int from, unsigned int to,
                                        bool training) {
   loss->set(run_context->getRegularizationLoss());
+  ScopedLatency scoped_latency(getLatency(LatencyType::FORWARD));
   PROFILE_TIME_START(forward_event_key);
+  if (forward_observer)
+    forward_observer(*this, *run_context, false);
   layer->incremental_forwarding(*run_context, from, to, training);
+  if (forward_observer)
+    forward_observer(*this, *run_context, true);
   PROFILE_TIME_END(forward_event_key);
   TRACE_MEMORY() << getName() + ": F";
   TRACE_TIME() << getName() + ": F";
@@ -809,6 +835,7 @@ void LayerNode::incremental_forwarding(unsigned int from, unsigned int to,
  * @brief     calc the derivative to be passed to the previous layer
  */
 void LayerNode::calcDerivative() {
+  ScopedLatency scoped_latency(getLatency(LatencyType::CALC_DERIVATIVE));
   PROFILE_TIME_START(calc_deriv_event_key);
   PROFILE_MEM_ANNOTATE("CalcDerivative: " + getName());
   layer->calcDerivative(*run_context);
@@ -827,6 +854,7 @@ void LayerNode::calcDerivative() {
  * @brief     Calculate the derivative of a layer
  */
 void LayerNode::calcGradient() {
+  ScopedLatency scoped_latency(getLatency(LatencyType::CALC_GRADIENT));
   PROFILE_TIME_START(calc_grad_event_key);
   if (needs_calc_gradient) {
     PROFILE_MEM_ANNOTATE("CalcGradient: " + getName());
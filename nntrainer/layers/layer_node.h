@@ -25,6 +25,7 @@
 #ifndef __LAYER_NODE_H__
 #define __LAYER_NODE_H__
 
+#include <functional>
 #include <memory>
 #include <tuple>
 #include <vector>
@@ -33,6 +34,7 @@
 #include <layer.h>
 #include <layer_context.h>
 #include <layer_devel.h>
+#include <runtime_metrics.h>
 #include <weight.h>
 
 namespace nntrainer {
@@ -429,6 +431,13 @@ public:
    */
   bool getFlatten() const;
 
+  /**
+   * @brief     get if the forward activations of this layer are recomputed
+   * before its backwarding
+   * @retval    recompute value
+   */
+  bool getRecompute() const;
+
   /**
    * @brief Get the Shared From property of the layer node
    *
@@ -762,6 +771,12 @@ public:
             ml::train::ExecutionMode mode = ml::train::ExecutionMode::TRAIN,
             bool swap = false);
 
+  /**
+   * @brief     fold what the layer runs fused into its weights
+   * @param folded true if the weights are folded already
+   */
+  void foldWeights(bool folded);
+
   /**
    * @brief     save layer Weight & Bias data from file
    * @param file output file stream
@@ -783,10 +798,52 @@ public:
    */
   float getLoss() const;
 
+  /**
+   * @brief Latencies kept for each layer regardless of the profile build
+   */
+  enum class LatencyType {
+    FORWARD = 0,     /**< forwarding and incremental forwarding */
+    CALC_GRADIENT,   /**< calculating the gradient of the weights */
+    CALC_DERIVATIVE, /**< calculating the derivative of the inputs */
+    APPLY_GRADIENT,  /**< applying the gradient to the weights */
+    NUM_TYPES,
+  };
+
+  /**
+   * @brief Get the latency histogram of the layer
+   *
+   * @param type type of the latency
+   * @return LatencyHistogram& histogram of the latency
+   */
+  LatencyHistogram &getLatency(LatencyType type) {
+    return latency[static_cast<unsigned int>(type)];
+  }
+
+  /**
+   * @brief Observer of the tensors of the layer around its forwarding
+   *
+   * @param node layer node being forwarded
+   * @param context run context of the layer
+   * @param done false right before the forwarding, true right after it
+   */
+  using ForwardObserver =
+    std::function<void(LayerNode &node, RunLayerContext &context, bool done)>;
+
+  /**
+   * @brief Set the observer called around forwarding and incremental
+   * forwarding, or reset it with an empty function
+   *
+   * @param observer observer to set
+   */
+  void setForwardObserver(ForwardObserver observer) {
+    forward_observer = std::move(observer);
+  }
+
 #ifdef PROFILE
   int forward_event_key;
   int calc_deriv_event_key;
   int calc_grad_event_key;
+  int apply_grad_event_key;
 #endif
 
   /**
@@ -1026,7 +1083,8 @@ properties in the context/graph unless intended. */
                std::vector<props::InputConnection>,
                std::vector<props::InputShape>, props::SharedFrom,
                props::ClipGradByGlobalNorm, props::Packed,
-               props::LossScaleForMixed, props::ComputeEngine>;
+               props::LossScaleForMixed, props::ComputeEngine,
+               props::Recompute>;
 
   using RealizationPropsType = std::tuple<props::Flatten, props::Activation>;
   /** these realization properties results in addition of new layers, hence
@@ -1046,6 +1104,12 @@ properties in the context/graph unless intended. */
   ExecutionOrder exec_order; /**< order/location of execution for this node
                                    in forward and backwarding operations */
 
+  std::array<LatencyHistogram,
+             static_cast<unsigned int>(LatencyType::NUM_TYPES)>
+    latency; /**< always-on latencies of the layer */
+
+  ForwardObserver forward_observer; /**< observer of the forwarding */
+
   bool needs_restore_data; /**< cache if this layer needs reinitialization
                                  output  */
 
@@ -22,6 +22,12 @@
 
 namespace nntrainer {
 
+#ifdef ENABLE_FP16
+#define _MASK_NUM -1e4
+#else
+#define _MASK_NUM -1e10
+#endif
+
 MultiHeadAttentionLayer::MultiHeadAttentionLayer() :
   multi_head_attention_props(
     props::NumHeads(), props::ProjectedKeyDim(), props::ProjectedValueDim(),
@@ -554,38 +560,15 @@ void MultiHeadAttentionLayer::incremental_forwarding(RunLayerContext &context,
     std::get<props::ProjectedKeyDim>(multi_head_attention_props).get();
   const unsigned int projected_value_dim_prop =
     std::get<props::ProjectedValueDim>(multi_head_attention_props).get();
-  const float dropout_rate =
-    std::get<props::DropOutRate>(multi_head_attention_props).get();
-  const props::ReturnAttentionWeightInfo::Enum return_attention_weight =
-    std::get<props::ReturnAttentionWeight>(multi_head_attention_props).get();
-  const bool average_attention_weight =
-    std::get<props::AverageAttentionWeight>(multi_head_attention_props).get();
-
-  const bool provide_attention_mask = context.getNumInputs() == 4;
   const unsigned int projected_query_dim_prop = projected_key_dim_prop;
-  const bool enable_dropout = dropout_rate > epsilon;
 
   /** get inputs/outputs */
   Tensor &query = context.getInput(INOUT_INDEX::QUERY);
   Tensor &key = context.getInput(INOUT_INDEX::KEY);
   Tensor &value = context.getInput(INOUT_INDEX::VALUE);
-
-  Tensor empty_tensor("empty", value.getFormat(), value.getDataType());
-
-  Tensor &mask =
-    provide_attention_mask ? context.getInput(INOUT_INDEX::MASK) : empty_tensor;
-
-  TensorDim query_dim = query.getDim();
-  TensorDim key_dim = key.getDim();
-  TensorDim value_dim = value.getDim();
-
   Tensor &output = context.getOutput(INOUT_INDEX::OUTPUT);
 
-  TensorDim output_dim = output.getDim();
-  Tensor &ret_attention_weight =
-    return_attention_weight != props::ReturnAttentionWeightInfo::Enum::none
-      ? context.getOutput(INOUT_INDEX::RETURN_ATTENTION_WEIGHT)
-      : empty_tensor;
+  Tensor empty_tensor("empty", value.getFormat(), value.getDataType());
 
   /** get weights */
   Tensor &query_fc_weight =
@@ -620,153 +603,134 @@ void MultiHeadAttentionLayer::incremental_forwarding(RunLayerContext &context,
   Tensor &cache_key = context.getTensor(weight_idx[AttentionParams::cache_key]);
   Tensor &cache_value =
     context.getTensor(weight_idx[AttentionParams::cache_value]);
-
-  TensorDim projected_query_dim = projected_query.getDim();
-  TensorDim projected_key_dim = projected_key.getDim();
-  TensorDim projected_value_dim = projected_value.getDim();
-  TensorDim cache_key_dim = cache_key.getDim();
-  TensorDim cache_value_dim = cache_value.getDim();
-
-  TensorDim projected_query_step_dim = projected_query_dim;
-
-  TensorDim projected_key_step_dim = projected_key_dim;
-  TensorDim projected_value_step_dim = projected_value_dim;
-  TensorDim cache_key_step_dim = cache_key_dim;
-  TensorDim cache_value_step_dim = cache_value_dim;
-  projected_query_step_dim.height(to - from);
-
-  projected_key_step_dim.height(to);
-  projected_value_step_dim.height(to);
-  cache_key_step_dim.height(to - from);
-  cache_value_step_dim.height(to - from);
-
-  Tensor projected_query_step =
-    projected_query.getSharedDataTensor(projected_query_step_dim, 0, true);
-  Tensor projected_key_step =
-    projected_key.getSharedDataTensor(projected_key_step_dim, 0, true);
-  Tensor projected_value_step =
-    projected_value.getSharedDataTensor(projected_value_step_dim, 0, true);
-
-  Tensor cache_key_step = cache_key.getSharedDataTensor(
-    cache_key_step_dim, from * cache_key_dim.width(), true);
-  Tensor cache_value_step = cache_value.getSharedDataTensor(
-    cache_value_step_dim, from * cache_value_dim.width(), true);
-
-  TensorDim cached_key_dim = {cache_key_dim.batch(), cache_key_dim.channel(),
-                              to, cache_key_dim.width(),
-                              cache_key.getTensorType()};
-  TensorDim cached_value_dim = {
-    cache_value_dim.batch(), cache_value_dim.channel(), to,
-    cache_value_dim.width(), cache_value.getTensorType()};
-  Tensor cached_key = cache_key.getSharedDataTensor(cached_key_dim, 0, true);
-  Tensor cached_value =
-    cache_value.getSharedDataTensor(cached_value_dim, 0, true);
-
   Tensor &attention_weight =
     context.getTensor(weight_idx[AttentionParams::attention_weight]);
   Tensor &attention_output =
     context.getTensor(weight_idx[AttentionParams::attention_output]);
-  TensorDim attention_weight_dim = attention_weight.getDim();
-
-  TensorDim attention_weight_step_dim = attention_weight_dim;
-  attention_weight_step_dim.height(to - from);
-  attention_weight_step_dim.width(to);
-
-  Tensor attention_weight_step =
-    attention_weight.getSharedDataTensor(attention_weight_step_dim, 0, true);
-
-  TensorDim attention_output_dim = attention_output.getDim();
-  TensorDim attention_output_step_dim = attention_output_dim;
-  attention_output_step_dim.height(to - from);
 
-  Tensor attention_output_step =
-    attention_output.getSharedDataTensor(attention_output_step_dim, 0, true);
-
-  const unsigned int batch_size = query_dim.batch();
-  const unsigned int query_height = query_dim.height();
-  const unsigned int key_height = key_dim.height();
-  const unsigned int value_height = value_dim.height();
-
-  query.dot(query_fc_weight, projected_query_step);
-  if (!disable_bias) {
-    projected_query_step.add_i(query_fc_bias);
-  }
-  key.dot(key_fc_weight, cache_key_step);
-  if (!disable_bias) {
-    cache_key_step.add_i(key_fc_bias);
-  }
-  value.dot(value_fc_weight, cache_value_step);
-  if (!disable_bias) {
-    cache_value_step.add_i(value_fc_bias);
-  }
-
-  projected_query_step.reshape(
-    TensorDim({batch_size, 1, num_heads, projected_query_dim_prop}));
-  cached_key.reshape(
-    TensorDim({batch_size, to, num_heads, projected_key_dim_prop}));
-  cached_value.reshape(
-    TensorDim({batch_size, to, num_heads, projected_value_dim_prop}));
-
-  projected_query_step.transpose("1:0:2", projected_query_step);
-  cached_key.transpose("1:0:2", projected_key_step);
-  cached_value.transpose("1:0:2", projected_value_step);
-
-  projected_query_step.reshape(
-    TensorDim({batch_size * num_heads, 1, 1, projected_query_dim_prop}));
-  projected_key_step.reshape(
-    TensorDim({batch_size * num_heads, 1, to, projected_key_dim_prop}));
-  projected_value_step.reshape(
-    TensorDim({batch_size * num_heads, 1, to, projected_value_dim_prop}));
-
-  attention_weight_step.reshape(TensorDim({batch_size * num_heads, 1, 1, to}));
-  attention_output_step.reshape(
-    TensorDim({batch_size * num_heads, 1, 1, projected_value_dim_prop}));
-
-  /** scaled dot product attention */
-  projected_query_step.dotBatched(projected_key_step, attention_weight_step,
-                                  false, true);
-  attention_weight_step.multiply_i(1 / sqrt((float)projected_query_dim_prop));
-
-  if (!from) {
-    unsigned int mask_size = attention_weight_step.getDim().width();
-    unsigned int mask_dim_height = mask_size;
-    unsigned int mask_dim_width = mask_size;
-
-    Tensor causal_mask(TensorDim{1, 1, mask_size, mask_size,
-                                 attention_weight_step.getTensorType()});
+  NNTR_THROW_IF(to <= from || to > cache_key.height(), std::invalid_argument)
+    << "invalid incremental step from " << from << " to " << to
+    << " for layer " << context.getName();
 
+  /**
+   * the steps are held from the first row of the inputs and outputs, and
+   * their keys and values are written to rows [from, to) of the cache. Rows
+   * past @a to are not read, so rejected steps are rolled back by starting the
+   * next call from where they began.
+   */
+  const unsigned int steps = to - from;
+  auto step_dim = [](const Tensor &t, unsigned int b, unsigned int c,
+                     unsigned int h, unsigned int w) {
+    return TensorDim({b, c, h, w}, t.getTensorType());
+  };
+  auto batch_slice = [](const Tensor &t, const TensorDim &dim, unsigned int b,
+                        size_t offset = 0) {
+    return t.getSharedDataTensor(dim, b * t.getDim().getFeatureLen() + offset,
+                                 true);
+  };
+
+  /** a step can see every cached position up to its own */
+  Tensor causal_mask;
+  if (steps > 1) {
+    causal_mask = Tensor(step_dim(attention_weight, 1, 1, steps, to));
     causal_mask.setZero();
-
-#ifdef ENABLE_FP16
-#define _MASK_NUM -1e4
-#else
-#define _MASK_NUM -1e10
-#endif
-
-    for (unsigned int i = 0; i < mask_dim_height; ++i) {
-      for (unsigned int j = i + 1; j < mask_dim_width; ++j) {
+    for (unsigned int i = 0; i < steps; ++i) {
+      for (unsigned int j = from + i + 1; j < to; ++j) {
         causal_mask.setValue(0, 0, i, j, _MASK_NUM);
       }
     }
-
-    attention_weight_step.add_i(causal_mask);
   }
 
-  sm.run_fn(attention_weight_step, attention_weight_step);
-
-  attention_weight_step.dotBatched(projected_value_step, attention_output_step);
-
-  attention_output_step.reshape(
-    TensorDim({batch_size, num_heads, to - from, projected_value_dim_prop}));
-
-  attention_output_step = attention_output_step.transpose("1:0:2");
+  for (unsigned int b = 0; b < query.batch(); ++b) {
+    Tensor query_step = batch_slice(
+      query, step_dim(query, 1, 1, steps, query.width()), b);
+    Tensor key_step =
+      batch_slice(key, step_dim(key, 1, 1, steps, key.width()), b);
+    Tensor value_step =
+      batch_slice(value, step_dim(value, 1, 1, steps, value.width()), b);
+
+    Tensor projected_query_step = batch_slice(
+      projected_query,
+      step_dim(projected_query, 1, 1, steps, projected_query.width()), b);
+    Tensor cache_key_step = batch_slice(
+      cache_key, step_dim(cache_key, 1, 1, steps, cache_key.width()), b,
+      from * cache_key.width());
+    Tensor cache_value_step = batch_slice(
+      cache_value, step_dim(cache_value, 1, 1, steps, cache_value.width()), b,
+      from * cache_value.width());
+
+    query_step.dot(query_fc_weight, projected_query_step);
+    if (!disable_bias) {
+      projected_query_step.add_i(query_fc_bias);
+    }
+    key_step.dot(key_fc_weight, cache_key_step);
+    if (!disable_bias) {
+      cache_key_step.add_i(key_fc_bias);
+    }
+    value_step.dot(value_fc_weight, cache_value_step);
+    if (!disable_bias) {
+      cache_value_step.add_i(value_fc_bias);
+    }
 
-  attention_output_step.reshape(TensorDim(
-    {batch_size * (to - from), 1, 1, num_heads * projected_value_dim_prop}));
+    /** split heads: (position, head, dim) to (head, position, dim) */
+    Tensor cached_key = batch_slice(
+      cache_key, step_dim(cache_key, 1, to, num_heads, projected_key_dim_prop),
+      b);
+    Tensor cached_value = batch_slice(
+      cache_value,
+      step_dim(cache_value, 1, to, num_heads, projected_value_dim_prop), b);
+    Tensor key_heads = batch_slice(
+      projected_key,
+      step_dim(projected_key, 1, num_heads, to, projected_key_dim_prop), b);
+    Tensor value_heads = batch_slice(
+      projected_value,
+      step_dim(projected_value, 1, num_heads, to, projected_value_dim_prop),
+      b);
+    cached_key.transpose("1:0:2", key_heads);
+    cached_value.transpose("1:0:2", value_heads);
+
+    projected_query_step.reshape(
+      step_dim(projected_query_step, 1, steps, num_heads,
+               projected_query_dim_prop));
+    Tensor query_heads = projected_query_step.transpose("1:0:2");
+
+    query_heads.reshape(
+      step_dim(query_heads, num_heads, 1, steps, projected_query_dim_prop));
+    key_heads.reshape(
+      step_dim(key_heads, num_heads, 1, to, projected_key_dim_prop));
+    value_heads.reshape(
+      step_dim(value_heads, num_heads, 1, to, projected_value_dim_prop));
+
+    /** scaled dot product attention */
+    Tensor attention_weight_step = batch_slice(
+      attention_weight, step_dim(attention_weight, num_heads, 1, steps, to), b);
+    query_heads.dotBatched(key_heads, attention_weight_step, false, true);
+    attention_weight_step.multiply_i(1 / sqrt((float)projected_query_dim_prop));
+    if (steps > 1) {
+      attention_weight_step.add_i(causal_mask);
+    }
 
-  attention_output_step.dot(fc_weight, output);
-  if (!disable_bias) {
-    output.add_i(fc_bias);
+    sm.run_fn(attention_weight_step, attention_weight_step);
+
+    Tensor attention_output_step = batch_slice(
+      attention_output,
+      step_dim(attention_output, num_heads, 1, steps, projected_value_dim_prop),
+      b);
+    attention_weight_step.dotBatched(value_heads, attention_output_step);
+
+    /** merge heads: (head, position, dim) to (position, head, dim) */
+    attention_output_step.reshape(step_dim(attention_output_step, 1, num_heads,
+                                           steps, projected_value_dim_prop));
+    Tensor merged = attention_output_step.transpose("1:0:2");
+    merged.reshape(
+      step_dim(merged, 1, 1, steps, num_heads * projected_value_dim_prop));
+
+    Tensor output_step =
+      batch_slice(output, step_dim(output, 1, 1, steps, output.width()), b);
+    merged.dot(fc_weight, output_step);
+    if (!disable_bias) {
+      output_step.add_i(fc_bias);
+    }
   }
 }
 
@@ -44,10 +44,8 @@ void MultiOutLayer::incremental_forwarding(RunLayerContext &context,
                                            bool training) {
   if (!context.getInPlace()) {
     if (from) {
-      NNTR_THROW_IF(to - from != 1, std::invalid_argument)
-        << "incremental step size is not 1";
+      to -= from;
       from = 0;
-      to = 1;
     }
 
     const Tensor &input_ = context.getInput(SINGLE_INOUT_IDX);
@@ -50,10 +50,8 @@ public:
   void incremental_forwarding(RunLayerContext &context, unsigned int from,
                               unsigned int to, bool training) override {
     if (from) {
-      NNTR_THROW_IF(to - from != 1, std::invalid_argument)
-        << "incremental step size is not 1";
+      to -= from;
       from = 0;
-      to = 1;
     }
 
     Tensor &hidden_ = context.getOutput(SINGLE_INOUT_IDX);
@@ -116,10 +114,8 @@ public:
   void incremental_forwarding(RunLayerContext &context, unsigned int from,
                               unsigned int to, bool training) override {
     if (from) {
-      NNTR_THROW_IF(to - from != 1, std::invalid_argument)
-        << "incremental step size is not 1";
+      to -= from;
       from = 0;
-      to = 1;
     }
 
     Tensor &hidden_ = context.getOutput(SINGLE_INOUT_IDX);
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   async_updater.cpp
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  Asynchronous update of the weights by a pool of workers
+ */
+
+#include <async_updater.h>
+#include <nntrainer_error.h>
+#include <task.h>
+#include <task_executor.h>
+#include <weight.h>
+
+namespace nntrainer {
+
+AsyncUpdater::AsyncUpdater(unsigned int num_workers) {
+  NNTR_THROW_IF(num_workers == 0, std::invalid_argument)
+    << "async updater needs a worker at least";
+  executor = std::make_unique<TaskExecutor>("async_updater", num_workers);
+}
+
+AsyncUpdater::~AsyncUpdater() {
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this] { return pending.empty(); });
+  }
+  /// join the workers before the members they use are destroyed
+  executor.reset();
+}
+
+void AsyncUpdater::submit(Weight &w, std::function<void(Weight &)> update) {
+  const void *key = w.getVariableRef().getData<void>();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending[key]++;
+  }
+
+  auto work = [this, &w, update = std::move(update)](std::atomic_bool &,
+                                                     void *) -> int {
+    try {
+      update(w);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      error = std::current_exception();
+    }
+    return 0;
+  };
+
+  auto complete = [this, key](int, TaskExecutor::CompleteStatus) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (--pending[key] == 0)
+      pending.erase(key);
+    cv.notify_all();
+  };
+
+  executor->run(std::make_shared<TaskAsync<>>(work, nullptr), complete);
+}
+
+void AsyncUpdater::wait(const std::vector<Weight *> &weights) {
+  std::unique_lock<std::mutex> lock(mutex);
+  for (auto w : weights) {
+    const void *key = w->getVariableRef().getData<void>();
+    cv.wait(lock, [this, key] { return pending.find(key) == pending.end(); });
+  }
+  rethrow();
+}
+
+void AsyncUpdater::waitAll() {
+  std::unique_lock<std::mutex> lock(mutex);
+  cv.wait(lock, [this] { return pending.empty(); });
+  rethrow();
+}
+
+void AsyncUpdater::rethrow() {
+  if (error) {
+    auto e = error;
+    error = nullptr;
+    std::rethrow_exception(e);
+  }
+}
+
+} // namespace nntrainer
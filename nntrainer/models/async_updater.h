@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   async_updater.h
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  Asynchronous update of the weights by a pool of workers
+ *
+ * A weight is updated by a worker as soon as its gradient is final, while the
+ * backwarding goes on with the other layers. A layer waits only for the
+ * updates of the weights it reads before it forwards the next iteration.
+ */
+
+#ifndef __ASYNC_UPDATER_H__
+#define __ASYNC_UPDATER_H__
+#ifdef __cplusplus
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace nntrainer {
+
+class TaskExecutor;
+class Weight;
+
+/**
+ * @class   AsyncUpdater
+ * @brief   Pool of workers updating the weights
+ * @note    the gradient of a weight must stay valid until its update is done
+ */
+class AsyncUpdater {
+public:
+  /**
+   * @brief Construct a new Async Updater object
+   *
+   * @param num_workers number of the workers
+   */
+  explicit AsyncUpdater(unsigned int num_workers);
+
+  /**
+   * @brief Destroy the Async Updater object after the updates are done
+   */
+  ~AsyncUpdater();
+
+  /**
+   * @brief update a weight on a worker
+   *
+   * @param w weight whose gradient is final
+   * @param update function updating the weight with its gradient
+   */
+  void submit(Weight &w, std::function<void(Weight &)> update);
+
+  /**
+   * @brief wait for the updates of the weights
+   *
+   * @param weights weights to be read
+   * @throw the exception an update threw
+   */
+  void wait(const std::vector<Weight *> &weights);
+
+  /**
+   * @brief wait for every update
+   *
+   * @throw the exception an update threw
+   */
+  void waitAll();
+
+private:
+  /**
+   * @brief rethrow the exception an update threw, if any
+   * @note  mutex must be held
+   */
+  void rethrow();
+
+  std::unique_ptr<TaskExecutor> executor; /**< workers */
+  std::unordered_map<const void *, unsigned int>
+    pending;                  /**< updates in flight by the weight data */
+  std::exception_ptr error;   /**< exception an update threw */
+  std::mutex mutex;           /**< guards pending and error */
+  std::condition_variable cv; /**< notified when an update is done */
+};
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __ASYNC_UPDATER_H__ */
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   data_parallel.cpp
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  Data parallel training of the worker processes of a host
+ */
+
+#include <cstring>
+
+#include <data_parallel.h>
+#include <nntrainer_error.h>
+#include <weight.h>
+
+namespace nntrainer {
+
+DataParallel::DataParallel(unsigned int rank, unsigned int world_size,
+                           unsigned int base_port, size_t bucket_size_) :
+  ring(rank, world_size, base_port),
+  bucket_size(bucket_size_),
+  bucket_bytes(0),
+  pending(0),
+  stop(false) {
+  comm = std::thread(&DataParallel::run, this);
+}
+
+DataParallel::~DataParallel() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  cv.notify_all();
+  comm.join();
+}
+
+void DataParallel::broadcast(const std::vector<Weight *> &weights) {
+  for (auto w : weights) {
+    Tensor &var = w->getVariableRef();
+    NNTR_THROW_IF(var.getDataType() != TensorDim::DataType::FP32,
+                  std::invalid_argument)
+      << "data parallel training supports FP32 weights only";
+    ring.broadcast(var.getData<float>(), var.size());
+  }
+}
+
+void DataParallel::average(const std::vector<Weight *> &weights) {
+  const float scale = 1.0f / ring.getWorldSize();
+  for (auto w : weights) {
+    Tensor &var = w->getVariableRef();
+    NNTR_THROW_IF(var.getDataType() != TensorDim::DataType::FP32,
+                  std::invalid_argument)
+      << "data parallel training supports FP32 weights only";
+    ring.allReduce(var.getData<float>(), var.size());
+    var.multiply_i(scale);
+  }
+}
+
+void DataParallel::push(Weight &w) {
+  Tensor &grad = w.getGradientRef();
+  NNTR_THROW_IF(grad.getDataType() != TensorDim::DataType::FP32,
+                std::invalid_argument)
+    << "data parallel training supports FP32 gradients only";
+
+  bucket.push_back(&w);
+  pushed.push_back(&w);
+  bucket_bytes += grad.bytes();
+  if (bucket_bytes >= bucket_size)
+    submit();
+}
+
+void DataParallel::submit() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push_back(std::move(bucket));
+    pending++;
+  }
+  cv.notify_all();
+  bucket.clear();
+  bucket_bytes = 0;
+}
+
+void DataParallel::flush(const std::function<void(Weight &)> &apply_func) {
+  if (!bucket.empty())
+    submit();
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this] { return pending == 0; });
+    if (error) {
+      auto e = error;
+      error = nullptr;
+      pushed.clear();
+      std::rethrow_exception(e);
+    }
+  }
+
+  for (auto w : pushed)
+    apply_func(*w);
+  pushed.clear();
+}
+
+void DataParallel::run() {
+  const float scale = 1.0f / ring.getWorldSize();
+
+  while (true) {
+    std::vector<Weight *> weights;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [this] { return stop || !queue.empty(); });
+      if (queue.empty())
+        return;
+      weights = std::move(queue.front());
+      queue.pop_front();
+    }
+
+    try {
+      size_t len = 0;
+      for (auto w : weights)
+        len += w->getGradientRef().size();
+      staging.resize(len);
+
+      float *dst = staging.data();
+      for (auto w : weights) {
+        Tensor &grad = w->getGradientRef();
+        std::memcpy(dst, grad.getData<float>(), grad.bytes());
+        dst += grad.size();
+      }
+
+      ring.allReduce(staging.data(), len);
+
+      const float *src = staging.data();
+      for (auto w : weights) {
+        Tensor &grad = w->getGradientRef();
+        float *data = grad.getData<float>();
+        for (size_t i = 0; i < grad.size(); ++i)
+          data[i] = src[i] * scale;
+        src += grad.size();
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      error = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      pending--;
+    }
+    cv.notify_all();
+  }
+}
+
+} // namespace nntrainer
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   data_parallel.h
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  Data parallel training of the worker processes of a host
+ *
+ * Every worker trains a replica of the model on its own shard of the data.
+ * The gradients are pushed in the order the backwarding finishes them, and
+ * gathered into buckets which a communication thread averages over the ring
+ * of the workers while the backwarding goes on. The gradients are applied
+ * once every bucket is averaged, so the trainable weights of the replicas
+ * stay identical. The weights without a gradient, as the moving statistics of
+ * a batch normalization, are updated by every worker on its own shard, and
+ * are averaged over the workers at the end of every epoch.
+ */
+
+#ifndef __DATA_PARALLEL_H__
+#define __DATA_PARALLEL_H__
+#ifdef __cplusplus
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ring_all_reduce.h>
+
+namespace nntrainer {
+
+class Weight;
+
+/**
+ * @class   DataParallel
+ * @brief   Gradient averaging among the replicas of a model
+ * @note    every worker must run the same number of the iterations, so the
+ * shards of the data must hold as many batches
+ */
+class DataParallel {
+public:
+  /**
+   * @brief Construct a new Data Parallel object, which blocks until every
+   * worker joins
+   *
+   * @param rank rank of this worker
+   * @param world_size number of the workers
+   * @param base_port port of the worker of rank 0 on localhost, the others
+   * take the following ports
+   * @param bucket_size bytes of the gradients averaged at once
+   */
+  DataParallel(unsigned int rank, unsigned int world_size,
+               unsigned int base_port, size_t bucket_size = 4u << 20);
+
+  /**
+   * @brief Destroy the Data Parallel object
+   */
+  ~DataParallel();
+
+  /**
+   * @brief get the rank of this worker
+   */
+  unsigned int getRank() const { return ring.getRank(); }
+
+  /**
+   * @brief get the number of the workers
+   */
+  unsigned int getWorldSize() const { return ring.getWorldSize(); }
+
+  /**
+   * @brief copy the weights of rank 0 to every worker
+   *
+   * @param weights weights of the replica in the same order on every worker
+   */
+  void broadcast(const std::vector<Weight *> &weights);
+
+  /**
+   * @brief average the weights over the workers
+   *
+   * @param weights weights of the replica in the same order on every worker
+   * @note the gradients pushed must be flushed before
+   */
+  void average(const std::vector<Weight *> &weights);
+
+  /**
+   * @brief push a gradient which the backwarding finished
+   *
+   * @param w weight of the gradient, which must stay valid until flush()
+   */
+  void push(Weight &w);
+
+  /**
+   * @brief wait for the gradients pushed to be averaged and apply them in the
+   * order they are pushed
+   *
+   * @param apply_func function applying the gradient of a weight
+   * @throw std::runtime_error if the averaging failed
+   */
+  void flush(const std::function<void(Weight &)> &apply_func);
+
+private:
+  /**
+   * @brief hand the bucket over to the communication thread
+   */
+  void submit();
+
+  /**
+   * @brief average the buckets as they are submitted
+   */
+  void run();
+
+  RingAllReduce ring;           /**< ring of the workers */
+  size_t bucket_size;           /**< bytes of a bucket */
+  std::vector<Weight *> bucket; /**< gradients of the next bucket */
+  size_t bucket_bytes;          /**< bytes of the next bucket */
+  std::vector<Weight *> pushed; /**< gradients pushed since the flush */
+
+  std::deque<std::vector<Weight *>> queue; /**< buckets to average */
+  unsigned int pending;                    /**< buckets not averaged yet */
+  bool stop;                               /**< the thread stops */
+  std::exception_ptr error;                /**< error of the averaging */
+  std::mutex mutex;                        /**< guards the queue */
+  std::condition_variable cv;              /**< notified on the queue */
+  std::vector<float> staging;              /**< a bucket packed */
+  std::thread comm;                        /**< communication thread */
+};
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __DATA_PARALLEL_H__ */
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   inference_context_pool.cpp
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  Concurrent inference of a single model on a pool of execution
+ * contexts
+ */
+
+#include <inference_context_pool.h>
+#include <neuralnet.h>
+#include <nntrainer_error.h>
+#include <tensor.h>
+
+namespace nntrainer {
+
+InferenceContextPool::InferenceContextPool(
+  NeuralNetwork &model, unsigned int num_contexts,
+  const std::function<std::unique_ptr<NeuralNetwork>()> &make_context) {
+  NNTR_THROW_IF(num_contexts == 0, std::invalid_argument)
+    << "an inference context pool needs a context at least";
+  NNTR_THROW_IF(!model.getInitialized(), std::invalid_argument)
+    << "the model must be initialized before its contexts are made";
+
+  contexts.reserve(num_contexts);
+  for (unsigned int i = 0; i < num_contexts; ++i) {
+    auto context = make_context();
+    context->compile(ml::train::ExecutionMode::INFERENCE);
+    context->initialize(ml::train::ExecutionMode::INFERENCE);
+    context->shareWeights(model);
+    context->allocate(ml::train::ExecutionMode::INFERENCE);
+    contexts.push_back(std::move(context));
+  }
+
+  for (auto &context : contexts)
+    idle.push_back(context.get());
+}
+
+InferenceContextPool::~InferenceContextPool() {
+  std::unique_lock<std::mutex> lock(mutex);
+  idle_cond.wait(lock, [this] { return idle.size() == contexts.size(); });
+}
+
+std::vector<std::vector<float>>
+InferenceContextPool::inference(unsigned int batch,
+                                const std::vector<float *> &input) {
+  NeuralNetwork *context = acquire();
+
+  std::vector<std::vector<float>> outputs;
+  try {
+    sharedConstTensors in;
+    auto in_dim = context->getInputDimension();
+    for (unsigned int i = 0; i < in_dim.size(); ++i) {
+      in_dim[i].batch(batch);
+      in.emplace_back(MAKE_SHARED_TENSOR(Tensor::Map(
+        input[i], in_dim[i].getDataLen() * sizeof(float), in_dim[i], 0)));
+    }
+
+    auto out = context->inference(in, false);
+    outputs.reserve(out.size());
+    for (auto &tensor : out) {
+      const float *data = tensor->getData<float>();
+      outputs.emplace_back(data, data + tensor->size());
+    }
+  } catch (...) {
+    release(context);
+    throw;
+  }
+
+  release(context);
+  return outputs;
+}
+
+NeuralNetwork *InferenceContextPool::acquire() {
+  std::unique_lock<std::mutex> lock(mutex);
+  idle_cond.wait(lock, [this] { return !idle.empty(); });
+
+  NeuralNetwork *context = idle.back();
+  idle.pop_back();
+  return context;
+}
+
+void InferenceContextPool::release(NeuralNetwork *context) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    idle.push_back(context);
+  }
+  idle_cond.notify_all();
+}
+
+} // namespace nntrainer
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   inference_context_pool.h
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  Concurrent inference of a single model on a pool of execution
+ * contexts
+ *
+ * An execution context is another instance of the model, made by the same
+ * function which configures the model, which shares the weights of the model
+ * and plans its own inputs, outputs and intermediate tensors. A call of
+ * inference() takes an idle context, runs on it and copies the outputs out,
+ * so as many calls run at once as the pool holds contexts while the weights
+ * are held once.
+ */
+
+#ifndef __INFERENCE_CONTEXT_POOL_H__
+#define __INFERENCE_CONTEXT_POOL_H__
+#ifdef __cplusplus
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace nntrainer {
+
+class NeuralNetwork;
+
+/**
+ * @class   InferenceContextPool
+ * @brief   Execution contexts running the inference of a model concurrently
+ * @note    the contexts keep the weights alive, which must not be loaded
+ * into the model again while the pool runs
+ */
+class InferenceContextPool {
+public:
+  /**
+   * @brief Construct a new Inference Context Pool object
+   *
+   * @param model model initialized and allocated for inference, whose weights
+   * are loaded
+   * @param num_contexts number of the contexts, which is the number of the
+   * calls running at once
+   * @param make_context function which configures a model of the same layers
+   * as the model, to be compiled and initialized by the pool
+   * @throw std::invalid_argument if the model is not initialized for
+   * inference, num_contexts is 0 or a context does not fit the model
+   */
+  InferenceContextPool(
+    NeuralNetwork &model, unsigned int num_contexts,
+    const std::function<std::unique_ptr<NeuralNetwork>()> &make_context);
+
+  /**
+   * @brief Destroy the Inference Context Pool object
+   */
+  ~InferenceContextPool();
+
+  /**
+   * @brief run the inference of a batch on an idle context, waiting for one
+   * if every context runs
+   *
+   * @param batch batch size of the inputs
+   * @param input inputs of the model in the order of the model inputs
+   * @return std::vector<std::vector<float>> outputs of the model
+   * @note this is safe to call from many threads at once
+   */
+  std::vector<std::vector<float>> inference(unsigned int batch,
+                                            const std::vector<float *> &input);
+
+  /**
+   * @brief get the number of the contexts
+   */
+  unsigned int size() const { return contexts.size(); }
+
+private:
+  /**
+   * @brief take an idle context, waiting for one if none is idle
+   */
+  NeuralNetwork *acquire();
+
+  /**
+   * @brief give a context back to the idle ones
+   */
+  void release(NeuralNetwork *context);
+
+  std::vector<std::unique_ptr<NeuralNetwork>> contexts; /**< the contexts */
+  std::vector<NeuralNetwork *> idle;                    /**< idle contexts */
+  std::mutex mutex;                   /**< guards the idle contexts */
+  std::condition_variable idle_cond; /**< notified on release */
+};
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __INFERENCE_CONTEXT_POOL_H__ */
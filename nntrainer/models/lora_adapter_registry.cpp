@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   lora_adapter_registry.cpp
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  Serving of many LoRA adapters on a single frozen base model
+ */
+
+#include <fstream>
+#include <string>
+
+#include <layer_context.h>
+#include <lora_adapter_registry.h>
+#include <nntrainer_error.h>
+#include <tensor.h>
+#include <util_func.h>
+
+namespace nntrainer {
+
+namespace {
+
+/**
+ * @brief check if a weight name ends with a suffix
+ */
+bool endsWith(const std::string &name, const std::string &suffix) {
+  return name.size() >= suffix.size() &&
+         name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/**
+ * @brief bytes of the slot of an adapter tensor
+ */
+size_t slotBytes(const Tensor &adapters) {
+  return adapters.getDim().getFeatureLen() * sizeof(float);
+}
+
+} // namespace
+
+std::vector<LoraAdapterRegistry::LayerAdapters>
+LoraAdapterRegistry::getLayers(ml::train::Model &model) {
+  std::vector<LayerAdapters> layers;
+  model.forEachLayer(
+    [&layers](ml::train::Layer &, RunLayerContext &rc, void *) {
+      LayerAdapters layer = {nullptr, nullptr};
+      for (unsigned int i = 0; i < rc.getNumWeights(); ++i) {
+        const auto &name = rc.getWeightName(i);
+        if (endsWith(name, ":lora_adapters_A"))
+          layer.A = &rc.getWeight(i);
+        else if (endsWith(name, ":lora_adapters_B"))
+          layer.B = &rc.getWeight(i);
+      }
+      if (layer.A)
+        layers.push_back(layer);
+    });
+
+  NNTR_THROW_IF(layers.empty(), std::invalid_argument)
+    << "the model has no layer of lora_adapters";
+  for (auto &layer : layers) {
+    NNTR_THROW_IF(!layer.A->isAllocated(), std::invalid_argument)
+      << "the adapters of a model are loaded after its allocation";
+    NNTR_THROW_IF(layer.A->batch() != layers[0].A->batch(),
+                  std::invalid_argument)
+      << "every layer of a model must hold the same number of adapters";
+  }
+  return layers;
+}
+
+unsigned int LoraAdapterRegistry::load(ml::train::Model &model,
+                                       const std::string &name,
+                                       const std::string &path) {
+  NNTR_THROW_IF(contains(name), std::invalid_argument)
+    << "LoRA adapter " << name << " is already loaded";
+
+  auto layers = getLayers(model);
+  const unsigned int num_slots = layers[0].A->batch();
+
+  std::vector<bool> used(num_slots, false);
+  for (auto &[adapter, slot] : slots)
+    used[slot] = true;
+  unsigned int slot = 0;
+  while (slot < num_slots && used[slot])
+    ++slot;
+  NNTR_THROW_IF(slot == num_slots, std::invalid_argument)
+    << "no free slot for LoRA adapter " << name << ", the model holds "
+    << num_slots;
+
+  size_t bytes = 0;
+  for (auto &layer : layers)
+    bytes += slotBytes(*layer.A) + slotBytes(*layer.B);
+
+  auto file = checkedOpenStream<std::ifstream>(path, std::ios::in |
+                                                       std::ios::binary |
+                                                       std::ios::ate);
+  NNTR_THROW_IF((size_t)file.tellg() != bytes, std::invalid_argument)
+    << "LoRA adapter file " << path << " of " << file.tellg()
+    << " bytes does not fit the layers of " << bytes << " bytes";
+  file.seekg(0, std::ios::beg);
+
+  for (auto &layer : layers) {
+    for (Tensor *adapters : {layer.A, layer.B}) {
+      const size_t len = adapters->getDim().getFeatureLen();
+      checkedRead(file,
+                  reinterpret_cast<char *>(adapters->getData<float>() +
+                                           slot * len),
+                  slotBytes(*adapters), "failed to read a LoRA adapter");
+    }
+  }
+
+  slots[name] = slot;
+  return slot;
+}
+
+void LoraAdapterRegistry::unload(const std::string &name) {
+  NNTR_THROW_IF(!contains(name), std::invalid_argument)
+    << "LoRA adapter " << name << " is not loaded";
+  slots.erase(name);
+}
+
+std::vector<float> LoraAdapterRegistry::getAdapterInput(
+  const std::vector<std::string> &adapters) const {
+  std::vector<float> input(adapters.size(), 0.0f);
+  for (unsigned int b = 0; b < adapters.size(); ++b) {
+    if (adapters[b].empty())
+      continue;
+    auto it = slots.find(adapters[b]);
+    NNTR_THROW_IF(it == slots.end(), std::invalid_argument)
+      << "LoRA adapter " << adapters[b] << " is not loaded";
+    input[b] = static_cast<float>(it->second + 1);
+  }
+  return input;
+}
+
+void LoraAdapterRegistry::save(ml::train::Model &model,
+                               const std::string &path) {
+  std::vector<Tensor *> weights;
+  model.forEachLayer(
+    [&weights](ml::train::Layer &, RunLayerContext &rc, void *) {
+      for (unsigned int i = 0; i < rc.getNumWeights(); ++i) {
+        const auto &name = rc.getWeightName(i);
+        if (endsWith(name, ":loraA") || endsWith(name, ":loraB"))
+          weights.push_back(&rc.getWeight(i));
+      }
+    });
+
+  NNTR_THROW_IF(weights.empty(), std::invalid_argument)
+    << "the model has no LoRA weight to save";
+  for (auto weight : weights) {
+    NNTR_THROW_IF(weight->getDataType() != TensorDim::DataType::FP32,
+                  std::invalid_argument)
+      << "LoRA adapters are saved from FP32 weights only";
+  }
+
+  auto file = checkedOpenStream<std::ofstream>(
+    path, std::ios::out | std::ios::binary | std::ios::trunc);
+  for (auto weight : weights)
+    checkedWrite(file, reinterpret_cast<const char *>(weight->getData<float>()),
+                 weight->size() * sizeof(float),
+                 "failed to write a LoRA adapter");
+}
+
+} // namespace nntrainer
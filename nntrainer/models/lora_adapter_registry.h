@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   lora_adapter_registry.h
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  Serving of many LoRA adapters on a single frozen base model
+ *
+ * The fully connected layers of lora_rank and lora_adapters=N hold N adapter
+ * slots next to their frozen weight, and take the adapter of each batch item
+ * as a second input. An adapter file holds loraA and then loraB of every LoRA
+ * layer in the order of the model, as save() writes them out of a model
+ * trained with a single adapter. Loading an adapter fills a free slot of every
+ * layer, so a batch mixes requests of many adapters while an extra adapter
+ * costs its own weights only.
+ */
+
+#ifndef __LORA_ADAPTER_REGISTRY_H__
+#define __LORA_ADAPTER_REGISTRY_H__
+#ifdef __cplusplus
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <model.h>
+
+namespace nntrainer {
+
+class Tensor;
+
+/**
+ * @class   LoraAdapterRegistry
+ * @brief   Named LoRA adapters loaded into the slots of a model
+ * @note    a registry serves a single model, which must have been allocated
+ * for inference
+ */
+class LoraAdapterRegistry {
+public:
+  /**
+   * @brief Construct a new Lora Adapter Registry object
+   */
+  LoraAdapterRegistry() = default;
+
+  /**
+   * @brief load an adapter file into a free slot of the model
+   *
+   * @param model model of multiple LoRA adapters
+   * @param name name of the adapter
+   * @param path adapter file written by save()
+   * @return unsigned int slot the adapter is loaded into
+   * @throw std::invalid_argument if the name is taken, no slot is free or the
+   * file does not fit the layers of the model
+   */
+  unsigned int load(ml::train::Model &model, const std::string &name,
+                    const std::string &path);
+
+  /**
+   * @brief free the slot of an adapter
+   *
+   * @param name name of the adapter
+   * @throw std::invalid_argument if the adapter is not loaded
+   */
+  void unload(const std::string &name);
+
+  /**
+   * @brief check if an adapter is loaded
+   */
+  bool contains(const std::string &name) const {
+    return slots.find(name) != slots.end();
+  }
+
+  /**
+   * @brief get the number of loaded adapters
+   */
+  unsigned int size() const { return slots.size(); }
+
+  /**
+   * @brief get the adapter input of a batch, which is the slot of the adapter
+   * of each item counted from 1
+   *
+   * @param adapters name of the adapter of each batch item, empty for the base
+   * model alone
+   * @return std::vector<float> adapter input of the batch
+   * @throw std::invalid_argument if an adapter is not loaded
+   */
+  std::vector<float>
+  getAdapterInput(const std::vector<std::string> &adapters) const;
+
+  /**
+   * @brief write the adapter of a model trained with a single LoRA adapter
+   *
+   * @param model model of fully connected layers of lora_rank
+   * @param path adapter file to write
+   * @throw std::invalid_argument if the model has no FP32 LoRA weight
+   */
+  static void save(ml::train::Model &model, const std::string &path);
+
+private:
+  /**
+   * @brief adapter slots of a layer
+   */
+  struct LayerAdapters {
+    Tensor *A; /**< A of the slots, slots:1:in:rank */
+    Tensor *B; /**< B of the slots, slots:1:rank:unit */
+  };
+
+  /**
+   * @brief collect the adapter weights of the model
+   * @throw std::invalid_argument if the model has no adapter slot
+   */
+  static std::vector<LayerAdapters> getLayers(ml::train::Model &model);
+
+  std::unordered_map<std::string, unsigned int> slots; /**< slot of a name */
+};
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __LORA_ADAPTER_REGISTRY_H__ */
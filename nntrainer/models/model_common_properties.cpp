@@ -13,6 +13,7 @@
 #include <model_common_properties.h>
 
 #include <nntrainer_log.h>
+#include <swap_compressor.h>
 #include <util_func.h>
 
 namespace nntrainer::props {
@@ -26,6 +27,8 @@ bool LossType::isValid(const std::string &value) const {
 
 TrainingBatchSize::TrainingBatchSize(unsigned int value) { set(value); }
 
+GradientAccumulation::GradientAccumulation(unsigned int value) { set(value); }
+
 ContinueTrain::ContinueTrain(bool value) { set(value); }
 
 MemoryOptimization::MemoryOptimization(bool value) { set(value); }
@@ -37,6 +40,18 @@ MemorySwapPath::MemorySwapPath(const std::string &value) { set(value); }
 MemorySwapLookahead::MemorySwapLookahead(const unsigned int &value) {
   set(value);
 }
+
+MemoryBudget::MemoryBudget(const unsigned int &value) { set(value); }
+
+bool MemorySwapCompression::isValid(const std::string &value) const {
+  try {
+    SwapCompressor::parse(value);
+  } catch (std::invalid_argument &e) {
+    ml_loge("%s", e.what());
+    return false;
+  }
+  return true;
+}
 ModelTensorDataType::ModelTensorDataType(ModelTensorDataTypeInfo::Enum value) {
   set(value);
 }
@@ -49,4 +64,8 @@ bool LossScale::isValid(const float &value) const {
   return is_valid;
 }
 
+AsyncUpdate::AsyncUpdate(unsigned int value) { set(value); }
+
+FuseLayers::FuseLayers(bool value) { set(value); }
+
 } // namespace nntrainer::props
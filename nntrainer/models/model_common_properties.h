@@ -90,6 +90,26 @@ public:
   TrainingBatchSize(unsigned int value = 1);
 };
 
+/**
+ * @brief model gradient accumulation property, which is the number of the
+ * micro-batches each batch is split into. Activations are planned for a
+ * micro-batch while the gradients are applied once per batch.
+ *
+ */
+class GradientAccumulation : public PositiveIntegerProperty {
+public:
+  static constexpr const char *key =
+    "gradient_accumulation";      /**< unique key to access */
+  using prop_tag = uint_prop_tag; /**< property type */
+
+  /**
+   * @brief Construct a new Gradient Accumulation object
+   *
+   * @param value value to set, defaults to 1
+   */
+  GradientAccumulation(unsigned int value = 1);
+};
+
 /**
  * @brief model continue property
  *
@@ -179,6 +199,46 @@ public:
   MemorySwapLookahead(const unsigned int &value = 0);
 };
 
+/**
+ * @brief swap data compression property, comma separated list of
+ * <lifespan>:<codec>, eg. "forward_func:sparse, forward_grad:fp16"
+ *
+ */
+class MemorySwapCompression : public Property<std::string> {
+public:
+  static constexpr const char *key =
+    "memory_swap_compression";   /**< unique key to access */
+  using prop_tag = str_prop_tag; /**< property type */
+
+  /**
+   * @brief check if the codecs can be parsed
+   *
+   * @param value value to check
+   * @return bool true if valid
+   */
+  bool isValid(const std::string &value) const override;
+};
+
+/**
+ * @brief tensor memory budget property in MiB, layers are recomputed during
+ * training until the tensors fit the budget, 0 to recompute the layers set
+ * with recompute=true only
+ *
+ */
+class MemoryBudget : public Property<unsigned int> {
+public:
+  static constexpr const char *key =
+    "memory_budget";              /**< unique key to access */
+  using prop_tag = uint_prop_tag; /**< property type */
+
+  /**
+   * @brief Constructor
+   *
+   * @param value value to set, defaults to 0
+   */
+  MemoryBudget(const unsigned int &value = 0);
+};
+
 /**
  * @brief     Enumeration of Data Type for model & layer
  */
@@ -245,6 +305,45 @@ public:
   bool isValid(const float &value) const override;
 };
 
+/**
+ * @brief model asynchronous update property, which is the number of the
+ * workers updating the weights while the training goes on. 0 updates the
+ * weights in the training thread.
+ *
+ */
+class AsyncUpdate : public Property<unsigned int> {
+public:
+  static constexpr const char *key =
+    "async_update";               /**< unique key to access */
+  using prop_tag = uint_prop_tag; /**< property type */
+
+  /**
+   * @brief Construct a new Async Update object
+   *
+   * @param value value to set, defaults to 0
+   */
+  AsyncUpdate(unsigned int value = 0);
+};
+
+/**
+ * @brief model fusion property, folds the batch normalization and fuses the
+ * activation into the layer before them when compiled for inference
+ *
+ */
+class FuseLayers : public Property<bool> {
+public:
+  static constexpr const char *key =
+    "fuse_layers";                /**< unique key to access */
+  using prop_tag = bool_prop_tag; /**< property type */
+
+  /**
+   * @brief Constructor
+   *
+   * @param value value to set, defaults to false
+   */
+  FuseLayers(bool value = false);
+};
+
 } // namespace nntrainer::props
 
 #endif
@@ -31,9 +31,14 @@
 #include <sstream>
 
 #include <activation_realizer.h>
+#include <async_updater.h>
 #include <common_properties.h>
+#include <data_parallel.h>
 #include <databuffer.h>
+#include <fake_quant_realizer.h>
+#include <fc_layer.h>
 #include <flatten_realizer.h>
+#include <fusion_realizer.h>
 #include <ini_interpreter.h>
 #include <ini_wrapper.h>
 #include <input_realizer.h>
@@ -48,7 +53,9 @@
 #include <profiler.h>
 #include <recurrent_realizer.h>
 #include <remap_realizer.h>
+#include <runtime_metrics.h>
 #include <slice_realizer.h>
+#include <swap_compressor.h>
 #include <util_func.h>
 
 #ifdef ENABLE_TFLITE_INTERPRETER
@@ -66,12 +73,14 @@ namespace nntrainer {
 
 NeuralNetwork::NeuralNetwork() :
   model_props(props::LossType(), {}, {}, props::ClipGradByGlobalNorm(),
-              props::LossScale()),
+              props::LossScale(), props::AsyncUpdate()),
   model_flex_props(
     props::Epochs(), props::TrainingBatchSize(), props::SavePath(),
     props::ContinueTrain(), props::SaveBestPath(), props::MemoryOptimization(),
     props::MemorySwap(), props::MemorySwapPath(), props::MemorySwapLookahead(),
-    props::TensorFormat(), props::ModelTensorDataType()),
+    props::MemorySwapCompression(), props::MemoryBudget(),
+    props::TensorFormat(), props::ModelTensorDataType(), props::FakeQuant(),
+    props::GradientAccumulation(), props::FuseLayers()),
   load_path(std::string()),
   epoch_idx(0),
   iter(0),
@@ -80,18 +89,21 @@ NeuralNetwork::NeuralNetwork() :
   initialized(false),
   compiled(false),
   loadedFromConfig(false),
-  exec_mode(ExecutionMode::TRAIN) {
+  exec_mode(ExecutionMode::TRAIN),
+  latency(std::make_shared<decltype(latency)::element_type>()) {
   ct_engine = Engine(Engine::Global());
 }
 
 NeuralNetwork::NeuralNetwork(Engine ct_engine_) :
   model_props(props::LossType(), {}, {}, props::ClipGradByGlobalNorm(),
-              props::LossScale()),
+              props::LossScale(), props::AsyncUpdate()),
   model_flex_props(
     props::Epochs(), props::TrainingBatchSize(), props::SavePath(),
     props::ContinueTrain(), props::SaveBestPath(), props::MemoryOptimization(),
     props::MemorySwap(), props::MemorySwapPath(), props::MemorySwapLookahead(),
-    props::TensorFormat(), props::ModelTensorDataType()),
+    props::MemorySwapCompression(), props::MemoryBudget(),
+    props::TensorFormat(), props::ModelTensorDataType(), props::FakeQuant(),
+    props::GradientAccumulation(), props::FuseLayers()),
   load_path(std::string()),
   epoch_idx(0),
   iter(0),
@@ -101,7 +113,8 @@ NeuralNetwork::NeuralNetwork(Engine ct_engine_) :
   compiled(false),
   loadedFromConfig(false),
   exec_mode(ExecutionMode::TRAIN),
-  ct_engine(ct_engine_) {}
+  ct_engine(ct_engine_),
+  latency(std::make_shared<decltype(latency)::element_type>()) {}
 
 int NeuralNetwork::loadFromConfig(const std::string &config) {
   if (loadedFromConfig == true) {
@@ -169,6 +182,12 @@ int NeuralNetwork::compile(ExecutionMode mode) {
   realizers.emplace_back(new MultioutRealizer());
   realizers.emplace_back(new FlattenRealizer());
   realizers.emplace_back(new ActivationRealizer());
+  if (auto &fake_quant = std::get<props::FakeQuant>(model_flex_props);
+      !fake_quant.empty())
+    realizers.emplace_back(new FakeQuantRealizer(fake_quant.get()));
+  if (mode == ExecutionMode::INFERENCE &&
+      std::get<props::FuseLayers>(model_flex_props))
+    realizers.emplace_back(new FusionRealizer());
 
   for (auto &realizer : realizers) {
     graph_representation = realizer->realize(graph_representation);
@@ -191,7 +210,19 @@ int NeuralNetwork::compile(ExecutionMode mode) {
 
   model_graph.setMemoryOptimizations(
     std::get<props::MemoryOptimization>(model_flex_props));
+  if (auto &prop = std::get<props::MemorySwapCompression>(model_flex_props);
+      !prop.empty()) {
+    model_graph.setSwapCompression(SwapCompressor::parse(prop.get()));
+  }
+  unsigned int memory_budget = std::get<props::MemoryBudget>(model_flex_props);
+  NNTR_THROW_IF(memory_swap && memory_budget, std::invalid_argument)
+    << "memory budget can not be used with memory swap";
+  model_graph.setMemoryBudget(static_cast<size_t>(memory_budget) << 20);
+
   for (auto &node : graph_representation) {
+    NNTR_THROW_IF(memory_swap && node->getRecompute(), std::invalid_argument)
+      << "recompute of " << node->getName()
+      << " can not be used with memory swap";
     if (auto &prop = std::get<props::ClipGradByGlobalNorm>(model_props);
         !prop.empty()) {
       node->setProperty({"clip_grad_by_norm=" + to_string(prop)});
@@ -254,13 +285,38 @@ int NeuralNetwork::initialize(ExecutionMode mode) {
                                             label_layer_prop.end());
   }
 
+  if (data_parallel) {
+    NNTR_THROW_IF(exec_mode != ExecutionMode::TRAIN, std::invalid_argument)
+      << "data parallel training needs the model compiled for training";
+    NNTR_THROW_IF(!std::get<props::ClipGradByGlobalNorm>(model_props).empty() ||
+                    model_graph.isMixedPrecision() ||
+                    std::get<props::MemorySwap>(model_flex_props),
+                  std::invalid_argument)
+      << "data parallel training does not support clipping the gradients by "
+         "global norm, mixed precision or memory swap";
+    /// the gradients are applied once they are averaged over the workers
+    model_graph.setKeepGradients(true);
+  }
+
+  if (unsigned int workers = std::get<props::AsyncUpdate>(model_props);
+      workers > 0 && exec_mode == ExecutionMode::TRAIN) {
+    NNTR_THROW_IF(std::get<props::MemorySwap>(model_flex_props),
+                  std::invalid_argument)
+      << "asynchronous update can not be used with memory swap";
+    /// the gradients are applied while the next iteration runs
+    model_graph.setPersistentGradients(true);
+    async_updater = std::make_shared<AsyncUpdater>(workers);
+  }
+
+  /// activations are planned for a micro-batch of the batch
+  unsigned int micro_batch = getMicroBatchSize();
+
   status = model_graph.initialize(
     exec_mode, input_conn,
     std::vector<Connection>(label_layers.begin(), label_layers.end()));
   NN_RETURN_STATUS();
 
-  model_graph.setBatchSize(
-    std::get<props::TrainingBatchSize>(model_flex_props));
+  model_graph.setBatchSize(micro_batch);
 
   // If the execution mode is `train`, the optimizer and its relevant variables
   // are initialized. Throws an error if the optimizer is not set for training;
@@ -279,6 +335,10 @@ int NeuralNetwork::initialize(ExecutionMode mode) {
         return opt->getOptimizerVariableDim(dim);
       };
     model_graph.requestOptimizerVariable(cb, true);
+
+    model_graph.setGradientAccumulation(
+      std::get<props::GradientAccumulation>(model_flex_props));
+    model_graph.requestGradientAccumulators();
   }
 
   // Allocate weights
@@ -347,6 +407,7 @@ NeuralNetwork::~NeuralNetwork() {
  */
 sharedConstTensors NeuralNetwork::forwarding(
   bool training, std::function<bool(void *userdata)> stop_cb, void *userdata) {
+  ScopedLatency scoped_latency(getLatency(LatencyType::FORWARD));
 
   std::function<void(std::shared_ptr<LayerNode>, bool)> forwarding_op =
     [this, stop_cb, userdata](std::shared_ptr<LayerNode> node,
@@ -360,6 +421,9 @@ sharedConstTensors NeuralNetwork::forwarding(
     if (exec_mode == ExecutionMode::TRAIN or
         (exec_mode == ExecutionMode::INFERENCE and !swap_mode)) {
       model_graph.flushCacheExcept(f);
+      /// the layer waits only for the updates of the weights it reads
+      if (async_updater)
+        async_updater->wait(node->getRunContext().getWeights());
       node->forwarding(training);
     } else {
       /**
@@ -388,7 +452,7 @@ sharedConstTensors NeuralNetwork::forwarding(
                the forwarding, ask load tensors for next n layers.
       **/
 
-      model_graph.LoadTensors(f);
+      model_graph.LoadTensors(f, model_graph.getAdaptiveLookahead());
       model_graph.checkLoadComplete(f);
       node->forwarding(training);
     }
@@ -425,6 +489,8 @@ sharedConstTensors NeuralNetwork::forwarding(sharedConstTensors input,
 sharedConstTensors NeuralNetwork::incremental_forwarding(
   unsigned int from, unsigned int to, bool training,
   std::function<bool(void *userdata)> stop_cb, void *userdata) {
+  ScopedLatency scoped_latency(getLatency(LatencyType::FORWARD));
+
   std::function<void(std::shared_ptr<LayerNode>, bool)> forwarding_op =
     [this, from, to, stop_cb, userdata](std::shared_ptr<LayerNode> node,
                                         bool training) -> void {
@@ -469,6 +535,7 @@ void NeuralNetwork::backwarding(int iteration,
 #ifdef DEBUG
   NNTR_THROW_IF(!opt, std::invalid_argument) << "optimizer is null!";
 #endif
+  ScopedLatency scoped_latency(getLatency(LatencyType::BACKWARD));
 
   std::function<void(std::shared_ptr<LayerNode>, bool)> forwarding_op =
     [this, stop_cb, userdata](std::shared_ptr<LayerNode> node,
@@ -482,9 +549,26 @@ void NeuralNetwork::backwarding(int iteration,
     node->forwarding(training);
   };
 
+  std::function<void(Weight &, int)> lazy_apply_grad_op =
+    [this, opt_ = opt.get()](Weight &w, int iteration) -> void {
+    auto apply = [opt_, iteration](Weight &w) {
+      w.calcRegularizationGradient();
+      w.calcWeightDecayGradient();
+      RunOptimizerContext opt_context(&w, iteration,
+                                      opt_->getLearningRate(iteration));
+      opt_->applyGradient(opt_context);
+    };
+
+    /// the next iteration reads the weight once its update is done
+    if (async_updater)
+      async_updater->submit(w, apply);
+    else
+      apply(w);
+  };
+
   std::function<bool(std::shared_ptr<LayerNode>, int)> backwarding_op =
-    [this, stop_cb, userdata](std::shared_ptr<LayerNode> node,
-                              int iteration) -> bool {
+    [this, stop_cb, userdata, &lazy_apply_grad_op](
+      std::shared_ptr<LayerNode> node, int iteration) -> bool {
     /**
      * Do not change this order:
      * 1. calcGradient
@@ -546,29 +630,20 @@ void NeuralNetwork::backwarding(int iteration,
     model_graph.flushCacheExcept(std::get<3>(node->getExecutionOrder()));
     PROFILE_MEM_ANNOTATE("ApplyGradient: " + node->getName());
 
-    if (apply_gradient) {
-      /// Apply gradient only at the end of the last shared weight access
+    if (apply_gradient && data_parallel) {
+      /// the gradient is applied once it is averaged over the workers
       model_graph.applyGradients(
-        node.get(), [iteration, opt_ = opt.get()](Weight &w) {
-          w.calcRegularizationGradient();
-          w.calcWeightDecayGradient();
-          RunOptimizerContext opt_context(&w, iteration,
-                                          opt_->getLearningRate(iteration));
-          opt_->applyGradient(opt_context);
-        });
+        node.get(), [this](Weight &w) { data_parallel->push(w); });
+    } else if (apply_gradient) {
+      /// Apply gradient only at the end of the last shared weight access
+      model_graph.applyGradients(node.get(),
+                                 [&lazy_apply_grad_op, iteration](Weight &w) {
+                                   lazy_apply_grad_op(w, iteration);
+                                 });
     }
     return true;
   };
 
-  std::function<void(Weight &, int)> lazy_apply_grad_op =
-    [opt_ = opt.get()](Weight &w, int iteration) -> void {
-    w.calcRegularizationGradient();
-    w.calcWeightDecayGradient();
-    RunOptimizerContext opt_context(&w, iteration,
-                                    opt_->getLearningRate(iteration));
-    opt_->applyGradient(opt_context);
-  };
-
   // return false if the gradient is not valid
   bool ret = false;
 
@@ -576,6 +651,12 @@ void NeuralNetwork::backwarding(int iteration,
     ret = model_graph.backwarding(iteration, forwarding_op, backwarding_op,
                                   lazy_apply_grad_op, stop_cb, userdata);
   }
+
+  if (data_parallel) {
+    data_parallel->flush([&lazy_apply_grad_op, iteration](Weight &w) {
+      lazy_apply_grad_op(w, iteration);
+    });
+  }
 }
 
 void NeuralNetwork::save(const std::string &file_path,
@@ -638,6 +719,9 @@ void NeuralNetwork::load(const std::string &file_path,
   /// @todo this switch case should be delegating the function call only. It's
   /// not delegating for now as required logics are manageable for now.
 
+  NNTR_THROW_IF(model_graph.isWeightShared(), std::invalid_argument)
+    << "the weights of a model sharing them are loaded by their owner";
+
   bool swap_mode = std::get<props::MemorySwap>(model_flex_props);
 
   const std::regex reg_("\\s*\\:\\s*");
@@ -775,6 +859,20 @@ float NeuralNetwork::getLoss() {
 
 void NeuralNetwork::setLoss(float l) { loss = l; }
 
+unsigned int NeuralNetwork::getMicroBatchSize() {
+  unsigned int batch_size =
+    std::get<props::TrainingBatchSize>(model_flex_props);
+  if (exec_mode != ExecutionMode::TRAIN)
+    return batch_size;
+
+  unsigned int accumulation =
+    std::get<props::GradientAccumulation>(model_flex_props);
+  NNTR_THROW_IF(batch_size % accumulation != 0, std::invalid_argument)
+    << "batch size " << batch_size
+    << " is not divisible by the gradient accumulation " << accumulation;
+  return batch_size / accumulation;
+}
+
 NeuralNetwork &NeuralNetwork::copy(NeuralNetwork &from) {
   if (this != &from) {
     model_props = from.model_props;
@@ -1001,7 +1099,8 @@ std::vector<float *> NeuralNetwork::incremental_inference(
 
   std::vector<float *> output;
 
-  unsigned int step = from ? 0 : to - 1;
+  /// the positions of a step are held from the first row, return the last
+  unsigned int step = to - from - 1;
 
   for (auto &out : output_tensors) {
     auto out_t = *out.get();
@@ -1082,9 +1181,13 @@ int NeuralNetwork::train(const std::vector<std::string> &values,
 
   setTrainConfig(values);
 
+  NNTR_THROW_IF(std::get<props::GradientAccumulation>(model_flex_props) !=
+                  model_graph.getGradientAccumulation(),
+                std::invalid_argument)
+    << "gradient accumulation can not be changed after the initialization";
+
   /** set batch size just before training */
-  model_graph.setBatchSize(
-    std::get<props::TrainingBatchSize>(model_flex_props));
+  model_graph.setBatchSize(getMicroBatchSize());
 
   status = allocate(ExecutionMode::TRAIN);
   NN_RETURN_STATUS();
@@ -1119,12 +1222,32 @@ int NeuralNetwork::train_run(
     }
   }
 
+  if (data_parallel) {
+    /// every worker starts from the weights of rank 0
+    std::vector<Weight *> weights;
+    for (auto iter = model_graph.cbegin(); iter != model_graph.cend(); iter++) {
+      auto &rc = (*iter)->getRunContext();
+      for (unsigned int i = 0; i < rc.getNumWeights(); ++i)
+        weights.push_back(&rc.getWeightObject(i));
+    }
+    data_parallel->broadcast(weights);
+  }
+
+  model_graph.clearGradientAccumulators();
+
   auto batch_size = std::get<props::TrainingBatchSize>(model_flex_props);
+  unsigned int micro_batch = getMicroBatchSize();
 
   auto const &outputs = model_graph.getOutputTensors();
   auto in_dims = model_graph.getInputDimension();
   auto label_dims = model_graph.getOutputDimension();
 
+  /// the data buffers hand out whole batches, which run a micro-batch at a time
+  for (auto &dim : in_dims)
+    dim.batch(batch_size);
+  for (auto &dim : label_dims)
+    dim.batch(batch_size);
+
   auto &[train_buffer, valid_buffer, test_buffer] = data_buffers;
 
   if (train_buffer == nullptr) {
@@ -1142,7 +1265,8 @@ int NeuralNetwork::train_run(
    * @param on_epoch_end function that will receive reference to stat,
    * buffer which will be called on the epoch end
    */
-  auto run_epoch = [this, &in_dims, &label_dims, &outputs, batch_size](
+  auto run_epoch = [this, &in_dims, &label_dims, &outputs, batch_size,
+                    micro_batch](
                      DataBuffer *buffer, bool shuffle,
                      auto &&on_iteration_fetch, auto &&on_iteration_update_stat,
                      auto &&on_epoch_end, RunStats &stat) {
@@ -1160,7 +1284,10 @@ int NeuralNetwork::train_run(
     std::future<std::shared_ptr<IterationQueue>> future_iq =
       buffer->startFetchWorker(in_dims, label_dims, shuffle);
     while (true) {
+      auto fetch_start = std::chrono::steady_clock::now();
       ScopedView<Iteration> iter_view = buffer->fetch();
+      getLatency(LatencyType::DATA_WAIT)
+        .record(std::chrono::steady_clock::now() - fetch_start);
       if (iter_view.isEmpty()) {
         break;
       }
@@ -1172,10 +1299,21 @@ int NeuralNetwork::train_run(
 
       auto const &labels = iteration.getLabelsRef();
       auto const &inputs = iteration.getInputsRef();
-      model_graph.setInputsLabels(inputs, labels);
-
-      on_iteration_fetch(stat, *buffer);
-      on_iteration_update_stat(stat, outputs, labels);
+      for (unsigned int m = 0; m * micro_batch < batch_size; ++m) {
+        std::vector<Tensor> micro_inputs, micro_labels;
+        for (auto const &input : inputs)
+          micro_inputs.push_back(
+            input.getBatchSlice(m * micro_batch, micro_batch));
+        for (auto const &label : labels)
+          micro_labels.push_back(
+            label.getBatchSlice(m * micro_batch, micro_batch));
+
+        model_graph.setAccumulationStep(m);
+        model_graph.setInputsLabels(micro_inputs, micro_labels);
+
+        on_iteration_fetch(stat, *buffer);
+        on_iteration_update_stat(stat, outputs, micro_labels);
+      }
     }
     future_iq.get();
     on_epoch_end(stat, *buffer);
@@ -1190,8 +1328,14 @@ int NeuralNetwork::train_run(
   auto train_for_iteration =
     [this, stop_cb, stop_user_data](RunStats &stat, DataBuffer &buffer) {
       ml_logi("train for iteration");
-      forwarding(true, stop_cb, stop_user_data);
-      backwarding(iter++, stop_cb, stop_user_data);
+      {
+        ScopedLatency scoped_latency(getLatency(LatencyType::ITERATION));
+        forwarding(true, stop_cb, stop_user_data);
+        backwarding(iter, stop_cb, stop_user_data);
+        /// an iteration trains a whole batch
+        if (!model_graph.isAccumulating())
+          iter++;
+      }
 
       // To avoid unconsidered memory leak, we need to clear the cache
       model_graph.flushCache();
@@ -1213,6 +1357,24 @@ int NeuralNetwork::train_run(
 
   auto train_epoch_end = [this, stop_cb, stop_user_data](RunStats &stat,
                                                          DataBuffer &buffer) {
+    /// the weights are saved and validated once their updates are done
+    if (async_updater)
+      async_updater->waitAll();
+
+    if (data_parallel) {
+      /// the weights without a gradient are updated on the shard of each
+      /// worker, so they are averaged to keep the replicas identical
+      std::vector<Weight *> weights;
+      for (auto iter = model_graph.cbegin(); iter != model_graph.cend();
+           iter++) {
+        auto &rc = (*iter)->getRunContext();
+        for (unsigned int i = 0; i < rc.getNumWeights(); ++i)
+          if (!rc.weightHasGradient(i))
+            weights.push_back(&rc.getWeightObject(i));
+      }
+      data_parallel->average(weights);
+    }
+
     if (stat.num_iterations != 0) {
       stat.loss /= static_cast<float>(stat.num_iterations);
     } else {
@@ -1243,13 +1405,13 @@ int NeuralNetwork::train_run(
     forwarding(false, stop_cb, stop_user_data);
   };
 
-  auto update_eval_stat = [batch_size, &update_train_stat](
+  auto update_eval_stat = [micro_batch, &update_train_stat](
                             RunStats &stat, const std::vector<Tensor> &outputs,
                             const std::vector<Tensor> &labels) {
     auto model_out = outputs[0].argmax();
     auto label_out = labels[0].argmax();
 
-    for (unsigned int b = 0; b < batch_size; b++) {
+    for (unsigned int b = 0; b < micro_batch; b++) {
       if (model_out[b] == label_out[b])
         stat.num_correct_predictions++;
     }
@@ -1257,7 +1419,7 @@ int NeuralNetwork::train_run(
     update_train_stat(stat, outputs, labels);
   };
 
-  auto eval_epoch_end = [this, batch_size, max_acc = 0.0f,
+  auto eval_epoch_end = [this, micro_batch, max_acc = 0.0f,
                          min_loss = std::numeric_limits<float>::max()](
                           RunStats &stat, DataBuffer &buffer) mutable {
     if (stat.num_iterations != 0) {
@@ -1267,7 +1429,7 @@ int NeuralNetwork::train_run(
       return;
     }
     stat.accuracy = stat.num_correct_predictions /
-                    static_cast<float>(stat.num_iterations * batch_size) *
+                    static_cast<float>(stat.num_iterations * micro_batch) *
                     100.0f;
 
     if (stat.accuracy > max_acc ||
@@ -1305,6 +1467,8 @@ int NeuralNetwork::train_run(
     std::cout << '\n';
     epoch_complete_cb(epoch_user_data);
   }
+  if (async_updater)
+    async_updater->waitAll();
   PROFILE_MEM_ANNOTATE("TRAIN END");
 
   if (test_buffer) {
@@ -1336,9 +1500,62 @@ void swap(NeuralNetwork &lhs, NeuralNetwork &rhs) {
     swap(lhs.graph_representation, rhs.graph_representation);
     swap(lhs.compiled, rhs.compiled);
     swap(lhs.loadedFromConfig, rhs.loadedFromConfig);
+    swap(lhs.latency, rhs.latency);
   }
 }
 
+RuntimeMetrics NeuralNetwork::getRuntimeMetrics() {
+  RuntimeMetrics metrics;
+
+  auto add_latency = [&metrics](const std::string &name,
+                                const LatencyHistogram &hist) {
+    if (hist.count() == 0)
+      return;
+    constexpr double ns_per_us = 1000.0;
+    metrics.latencies.push_back({name, hist.count(),
+                                 hist.percentile(50) / ns_per_us,
+                                 hist.percentile(99) / ns_per_us,
+                                 hist.max() / ns_per_us,
+                                 hist.total() / ns_per_us});
+  };
+
+  static const char *model_phases[] = {"forward", "backward", "iteration",
+                                       "data_wait"};
+  for (unsigned int i = 0; i < latency->size(); ++i)
+    add_latency(std::string("model:") + model_phases[i], latency->at(i));
+
+  static const char *layer_phases[] = {"forward", "calcGradient",
+                                       "calcDerivative", "applyGradient"};
+  for (auto iter = model_graph.cbegin(); iter != model_graph.cend(); iter++) {
+    for (unsigned int i = 0; i < std::size(layer_phases); ++i) {
+      auto type = static_cast<LayerNode::LatencyType>(i);
+      add_latency((*iter)->getName() + ":" + layer_phases[i],
+                  (*iter)->getLatency(type));
+    }
+  }
+
+  auto &counters = RuntimeCounters::Global();
+  metrics.memory_pool_bytes = counters.get(RuntimeCounters::MEMORY_POOL_BYTES);
+  metrics.cache_pool_bytes = counters.get(RuntimeCounters::CACHE_POOL_BYTES);
+  metrics.swap_read_bytes = counters.get(RuntimeCounters::SWAP_READ_BYTES);
+  metrics.swap_write_bytes = counters.get(RuntimeCounters::SWAP_WRITE_BYTES);
+
+  return metrics;
+}
+
+void NeuralNetwork::resetRuntimeMetrics() {
+  for (auto &hist : *latency)
+    hist.reset();
+
+  for (auto iter = model_graph.cbegin(); iter != model_graph.cend(); iter++) {
+    for (unsigned int i = 0;
+         i < static_cast<unsigned int>(LayerNode::LatencyType::NUM_TYPES); ++i)
+      (*iter)->getLatency(static_cast<LayerNode::LatencyType>(i)).reset();
+  }
+
+  RuntimeCounters::Global().resetCumulative();
+}
+
 int NeuralNetwork::addLayer(NodeType layer) {
   int status = ML_ERROR_NONE;
 
@@ -1675,6 +1892,69 @@ void NeuralNetwork::forEachLayer(
   };
 }
 
+void NeuralNetwork::setLoraMerged(bool merged) {
+  NNTR_THROW_IF(model_graph.isWeightShared(), std::invalid_argument)
+    << "the LoRA of shared weights cannot be merged";
+  for (auto iter = model_graph.cbegin(); iter != model_graph.cend(); iter++) {
+    auto ln = std::static_pointer_cast<LayerNode>(*iter);
+    if (ln->getType() == FullyConnectedLayer::type)
+      ln->setProperty({std::string("lora_merged=") +
+                       (merged ? "true" : "false")});
+  }
+}
+
+/**
+ * @brief check if a fully connected layer of the graph merges its LoRA into
+ * its weight
+ */
+static bool isLoraMerged(NetworkGraph &graph) {
+  for (auto iter = graph.cbegin(); iter != graph.cend(); iter++) {
+    auto ln = std::static_pointer_cast<LayerNode>(*iter);
+    if (ln->getType() != FullyConnectedLayer::type)
+      continue;
+
+    Exporter e;
+    ln->exportTo(e, ml::train::ExportMethods::METHOD_STRINGVECTOR);
+    auto props = e.getResult<ml::train::ExportMethods::METHOD_STRINGVECTOR>();
+    for (auto &[key, value] : *props) {
+      if (key == "lora_merged" && value == "true")
+        return true;
+    }
+  }
+  return false;
+}
+
+void NeuralNetwork::shareWeights(NeuralNetwork &owner) {
+  NNTR_THROW_IF(&owner == this, std::invalid_argument)
+    << "a model cannot share its own weights";
+  NNTR_THROW_IF(!initialized || !owner.initialized, std::invalid_argument)
+    << "the models must be initialized to share the weights";
+  NNTR_THROW_IF(exec_mode != ExecutionMode::INFERENCE ||
+                  owner.exec_mode != ExecutionMode::INFERENCE,
+                std::invalid_argument)
+    << "the weights are shared for inference only";
+  NNTR_THROW_IF(isLoraMerged(model_graph) || isLoraMerged(owner.model_graph),
+                std::invalid_argument)
+    << "the weights of a LoRA merged on the first run are not shared";
+
+  model_graph.shareWeights(owner.model_graph);
+
+  /// the owner folds the weights once, before any model runs on them, and the
+  /// models sharing them take them as folded
+  for (auto iter = owner.model_graph.cbegin(); iter != owner.model_graph.cend();
+       iter++)
+    std::static_pointer_cast<LayerNode>(*iter)->foldWeights(false);
+  for (auto iter = model_graph.cbegin(); iter != model_graph.cend(); iter++)
+    std::static_pointer_cast<LayerNode>(*iter)->foldWeights(true);
+}
+
+void NeuralNetwork::setDataParallel(
+  std::shared_ptr<DataParallel> data_parallel_) {
+  NNTR_THROW_IF(initialized, std::invalid_argument)
+    << "data parallel training is set before the initialization";
+  data_parallel = data_parallel_;
+}
+
 void NeuralNetwork::exports(const ml::train::ExportMethods &method,
                             const std::string file_path) {
   switch (method) {
@@ -41,6 +41,7 @@
 #include <model_common_properties.h>
 #include <network_graph.h>
 #include <optimizer_wrapped.h>
+#include <runtime_metrics.h>
 #include <tensor.h>
 
 #include <model.h>
@@ -66,9 +67,12 @@ using NetType = ml::train::ModelType;
 using ExecutionMode = ml::train::ExecutionMode;
 
 class DataBuffer;
+class AsyncUpdater;
+class DataParallel;
 using DatasetType = ml::train::DatasetType;
 using DatasetModeType = ml::train::DatasetModeType;
 using RunStats = ml::train::RunStats;
+using RuntimeMetrics = ml::train::RuntimeMetrics;
 
 /**
  * @class   NeuralNetwork Class
@@ -141,6 +145,16 @@ public:
 
   RunStats getTestStats() override { return testing; }
 
+  /**
+   * @copydoc Model::getRuntimeMetrics()
+   */
+  RuntimeMetrics getRuntimeMetrics() override;
+
+  /**
+   * @copydoc Model::resetRuntimeMetrics()
+   */
+  void resetRuntimeMetrics() override;
+
   /**
    * @brief     Get Learning rate
    * @retval    Learning rate
@@ -431,6 +445,41 @@ s   * @retval shared_ptr<const Tensor>
       fn,
     void *user_data = nullptr) override;
 
+  /**
+   * @brief     Merge the LoRA of the fully connected layers into their weights
+   * for inference, or restore the weights as they were
+   * @param[in] merged true to merge, false to keep the LoRA apart
+   * @note      the weights change at the next inference, and training always
+   * runs with the LoRA apart. A model of the inference mode merges in place,
+   * so its weights cannot be restored or saved apart from the LoRA.
+   */
+  void setLoraMerged(bool merged);
+
+  /**
+   * @brief     Share the weights of another model of the same layers for
+   * inference, instead of holding a copy of them
+   * @param[in] owner initialized model for inference whose weights are loaded
+   * @note      call after initialize() and before allocate(). The shared
+   * weights are read only: loading or merging the weights of a sharing model
+   * throws. What the layers fold into their weights (e.g. fused batch
+   * normalization) is folded on the owner here, so the models may run at once.
+   * The weights stay alive as long as any of the models holds them.
+   * @throw     std::invalid_argument if a model is not initialized for
+   * inference, merges a LoRA or the weights of the models differ
+   */
+  void shareWeights(NeuralNetwork &owner);
+
+  /**
+   * @brief     Train as a worker of data parallel training, which averages
+   * the gradients over the workers before applying them
+   * @param[in] data_parallel workers this model trains with
+   * @note      call before initialize(). Every worker sets its own shard of
+   * the train dataset of the same number of the batches, and the weights of
+   * rank 0 are copied to every worker when the training starts.
+   * @throw     std::invalid_argument if the model is initialized already
+   */
+  void setDataParallel(std::shared_ptr<DataParallel> data_parallel);
+
   /**
    * @brief     Run NeuralNetwork train with callback function by user
    * @param[in] dt datatype (mode) where it should be
@@ -629,11 +678,14 @@ private:
                props::ContinueTrain, props::SaveBestPath,
                props::MemoryOptimization, props::MemorySwap,
                props::MemorySwapPath, props::MemorySwapLookahead,
-               props::TensorFormat, props::ModelTensorDataType>;
+               props::MemorySwapCompression, props::MemoryBudget,
+               props::TensorFormat, props::ModelTensorDataType,
+               props::FakeQuant, props::GradientAccumulation,
+               props::FuseLayers>;
   using RigidPropTypes =
     std::tuple<props::LossType, std::vector<props::InputConnection>,
                std::vector<props::LabelLayer>, props::ClipGradByGlobalNorm,
-               props::LossScale>;
+               props::LossScale, props::AsyncUpdate>;
 
   RigidPropTypes model_props;         /**< model props */
   FlexiblePropTypes model_flex_props; /**< model train props */
@@ -664,6 +716,12 @@ private:
   std::array<std::shared_ptr<DataBuffer>, 3>
     data_buffers; /**< Data Buffers to get Input */
 
+  std::shared_ptr<DataParallel>
+    data_parallel; /**< workers of data parallel training */
+
+  std::shared_ptr<AsyncUpdater>
+    async_updater; /**< workers updating the weights asynchronously */
+
   bool initialized; /**< Network is initialized */
 
   bool compiled; /**< Network is compiled */
@@ -685,6 +743,31 @@ private:
   DynamicTrainingOptimization dynamic_training_opt; /**< Dynamic fine-tuning
    optimization mode. supported modes are "max" and "norm" */
 
+  /**
+   * @brief   Latencies kept for the phases of the model
+   */
+  enum class LatencyType {
+    FORWARD = 0, /**< forwarding of the whole graph */
+    BACKWARD,    /**< backwarding of the whole graph */
+    ITERATION,   /**< a whole training iteration */
+    DATA_WAIT,   /**< waiting for the data buffer to hand out an iteration */
+    NUM_TYPES,
+  };
+
+  std::shared_ptr<std::array<LatencyHistogram,
+                             static_cast<unsigned int>(LatencyType::NUM_TYPES)>>
+    latency; /**< always-on latencies of the model */
+
+  /**
+   * @brief   Get the latency histogram of a phase of the model
+   *
+   * @param type type of the latency
+   * @return LatencyHistogram& histogram of the latency
+   */
+  LatencyHistogram &getLatency(LatencyType type) {
+    return latency->at(static_cast<unsigned int>(type));
+  }
+
   /**
    * @brief save model in ini
    *
@@ -708,6 +791,13 @@ private:
    */
   void setLoss(float l);
 
+  /**
+   * @brief     Get the size of the micro-batches a batch is split into
+   * @retval    batch size divided by the gradient accumulation
+   * @throw     std::invalid_argument if the batch size is not divisible
+   */
+  unsigned int getMicroBatchSize();
+
   /**
    * @brief     Run NeuralNetwork train
    * @param[in] stop_cb callback function to decide stop training or not
@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   prefix_cache.cpp
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  Reuse of the attention key / value caches of shared prompt prefixes
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string>
+
+#include <layer_context.h>
+#include <nntrainer_error.h>
+#include <nntrainer_log.h>
+#include <prefix_cache.h>
+#include <tensor.h>
+
+namespace nntrainer {
+
+namespace {
+
+/**
+ * @brief check if a tensor name ends with a suffix
+ */
+bool endsWith(const std::string &name, const std::string &suffix) {
+  return name.size() >= suffix.size() &&
+         name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/**
+ * @brief bytes of a row of a cache tensor
+ */
+size_t rowBytes(const Tensor &cache) {
+  return cache.width() * cache.getDim().getDataTypeSize();
+}
+
+} // namespace
+
+PrefixCache::PrefixCache(unsigned int block_size_, unsigned int max_blocks_) :
+  block_size(block_size_),
+  max_blocks(max_blocks_),
+  num_hit_tokens(0),
+  num_lookup_tokens(0) {
+  NNTR_THROW_IF(block_size == 0, std::invalid_argument)
+    << "block size of a prefix cache must be positive";
+  NNTR_THROW_IF(max_blocks == 0, std::invalid_argument)
+    << "a prefix cache must hold at least a block";
+}
+
+std::vector<Tensor *> PrefixCache::getCaches(ml::train::Model &model) const {
+  std::vector<Tensor *> caches;
+  model.forEachLayer(
+    [&caches](ml::train::Layer &, RunLayerContext &rc, void *) {
+      for (unsigned int i = 0; i < rc.getNumTensors(); ++i) {
+        const auto &name = rc.getTensorName(i);
+        if (endsWith(name, ":cache_key") || endsWith(name, ":cache_value"))
+          caches.push_back(&rc.getTensor(i));
+      }
+    });
+
+  for (auto cache : caches) {
+    if (!cache->isAllocated())
+      return {};
+  }
+  return caches;
+}
+
+size_t PrefixCache::hashBlock(size_t parent, const unsigned int *ids,
+                              unsigned int len) {
+  size_t seed = parent;
+  for (unsigned int i = 0; i < len; ++i)
+    seed ^= std::hash<unsigned int>{}(ids[i]) + 0x9e3779b9 + (seed << 6) +
+            (seed >> 2);
+  return seed;
+}
+
+PrefixCache::Block *PrefixCache::find(size_t hash, size_t parent,
+                                      const unsigned int *ids) {
+  auto it = blocks.find(hash);
+  if (it == blocks.end() || it->second.parent != parent ||
+      !std::equal(it->second.ids.begin(), it->second.ids.end(), ids))
+    return nullptr;
+  return &it->second;
+}
+
+void PrefixCache::touch(Block &block) {
+  lru_order.splice(lru_order.begin(), lru_order, block.lru);
+}
+
+unsigned int PrefixCache::restore(ml::train::Model &model,
+                                  const std::vector<unsigned int> &tokens) {
+  num_lookup_tokens += tokens.size();
+
+  auto caches = getCaches(model);
+  if (caches.empty() || tokens.empty())
+    return 0;
+
+  size_t max_len = tokens.size() - 1;
+  for (auto cache : caches)
+    max_len = std::min<size_t>(max_len, cache->height());
+
+  std::vector<Block *> hits;
+  size_t parent = 0;
+  for (unsigned int b = 0; b < max_len / block_size; ++b) {
+    const unsigned int *ids = tokens.data() + b * block_size;
+    size_t hash = hashBlock(parent, ids, block_size);
+    Block *block = find(hash, parent, ids);
+    if (block == nullptr || block->rows.size() != caches.size())
+      break;
+
+    bool fits = true;
+    for (unsigned int c = 0; c < caches.size(); ++c)
+      fits = fits && block->rows[c].size() == rowBytes(*caches[c]) * block_size;
+    if (!fits)
+      break;
+
+    hits.push_back(block);
+    parent = hash;
+  }
+
+  for (unsigned int b = 0; b < hits.size(); ++b) {
+    for (unsigned int c = 0; c < caches.size(); ++c) {
+      char *dst = caches[c]->getData<char>() +
+                  b * block_size * rowBytes(*caches[c]);
+      std::memcpy(dst, hits[b]->rows[c].data(), hits[b]->rows[c].size());
+    }
+  }
+
+  /** the deepest block is evicted before its parents */
+  for (auto it = hits.rbegin(); it != hits.rend(); ++it)
+    touch(**it);
+
+  unsigned int restored = hits.size() * block_size;
+  num_hit_tokens += restored;
+  ml_logd("[PrefixCache] restored %u of %zu prompt tokens", restored,
+          tokens.size());
+  return restored;
+}
+
+void PrefixCache::store(ml::train::Model &model,
+                        const std::vector<unsigned int> &tokens) {
+  auto caches = getCaches(model);
+  if (caches.empty())
+    return;
+
+  size_t max_len = tokens.size();
+  for (auto cache : caches)
+    max_len = std::min<size_t>(max_len, cache->height());
+
+  std::vector<size_t> stored;
+  size_t parent = 0;
+  for (unsigned int b = 0; b < max_len / block_size; ++b) {
+    const unsigned int *ids = tokens.data() + b * block_size;
+    size_t hash = hashBlock(parent, ids, block_size);
+
+    if (find(hash, parent, ids) == nullptr) {
+      /** a different prefix of the same hash is kept as is */
+      if (blocks.count(hash))
+        break;
+
+      Block &block = blocks[hash];
+      block.parent = parent;
+      block.ids.assign(ids, ids + block_size);
+      for (auto cache : caches) {
+        size_t bytes = rowBytes(*cache) * block_size;
+        const char *src = cache->getData<char>() + b * bytes;
+        block.rows.emplace_back(src, src + bytes);
+      }
+      lru_order.push_front(hash);
+      block.lru = lru_order.begin();
+    }
+
+    stored.push_back(hash);
+    parent = hash;
+  }
+
+  for (auto it = stored.rbegin(); it != stored.rend(); ++it)
+    touch(blocks[*it]);
+
+  while (blocks.size() > max_blocks) {
+    blocks.erase(lru_order.back());
+    lru_order.pop_back();
+  }
+}
+
+void PrefixCache::clear() {
+  blocks.clear();
+  lru_order.clear();
+}
+
+} // namespace nntrainer
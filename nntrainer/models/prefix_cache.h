@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   prefix_cache.h
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  Reuse of the attention key / value caches of shared prompt prefixes
+ *
+ * The prompt is split into blocks of a fixed number of tokens. A block is
+ * identified by the hash of every token up to its end, so equal hashes mean
+ * equal prefixes. After a prefill the key / value rows of each full block are
+ * copied out of the cache tensors of the attention layers; a later session
+ * with the same prefix copies them back and starts prefilling at the first
+ * uncached token. Blocks are evicted in least recently used order.
+ */
+
+#ifndef __PREFIX_CACHE_H__
+#define __PREFIX_CACHE_H__
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include <model.h>
+
+namespace nntrainer {
+
+class Tensor;
+
+/**
+ * @class   PrefixCache
+ * @brief   Bounded LRU store of key / value cache blocks of token prefixes
+ * @note    the caches are the tensors named cache_key and cache_value of the
+ * attention layers, of shape batch:1:max_len:width. Only the first batch is
+ * stored and restored. A prefix cache serves a single model architecture.
+ */
+class PrefixCache {
+public:
+  /**
+   * @brief Construct a new Prefix Cache object
+   *
+   * @param block_size_ number of tokens in a block
+   * @param max_blocks_ maximum number of blocks held
+   */
+  PrefixCache(unsigned int block_size_ = 16, unsigned int max_blocks_ = 256);
+
+  /**
+   * @brief copy the cached blocks of the longest known prefix into the model
+   *
+   * @param model model to restore, which must have been allocated
+   * @param tokens tokens of the prompt
+   * @return unsigned int number of restored positions, where prefill starts
+   * @note the last token of the prompt is never restored so that its prefill
+   * still yields the logits of the next token
+   */
+  unsigned int restore(ml::train::Model &model,
+                       const std::vector<unsigned int> &tokens);
+
+  /**
+   * @brief copy the full blocks of a prefilled prompt out of the model
+   *
+   * @param model model which has prefilled @a tokens from position 0
+   * @param tokens tokens of the prompt
+   */
+  void store(ml::train::Model &model, const std::vector<unsigned int> &tokens);
+
+  /**
+   * @brief drop every block
+   */
+  void clear();
+
+  /**
+   * @brief get the number of blocks held
+   */
+  unsigned int size() const { return blocks.size(); }
+
+  /**
+   * @brief get the number of positions restored so far
+   */
+  size_t getNumHitTokens() const { return num_hit_tokens; }
+
+  /**
+   * @brief get the number of prompt positions looked up so far
+   */
+  size_t getNumLookupTokens() const { return num_lookup_tokens; }
+
+private:
+  /**
+   * @brief key / value rows of a block
+   */
+  struct Block {
+    size_t parent;                       /**< hash of the former block */
+    std::vector<unsigned int> ids;       /**< tokens of the block */
+    std::vector<std::vector<char>> rows; /**< rows of each cache tensor */
+    std::list<size_t>::iterator lru;     /**< position in the lru order */
+  };
+
+  /**
+   * @brief collect the key / value cache tensors of the model
+   */
+  std::vector<Tensor *> getCaches(ml::train::Model &model) const;
+
+  /**
+   * @brief hash of a prefix given the hash of the prefix without a block
+   */
+  static size_t hashBlock(size_t parent, const unsigned int *ids,
+                          unsigned int len);
+
+  /**
+   * @brief find the block of a prefix, or nullptr if it is not cached
+   */
+  Block *find(size_t hash, size_t parent, const unsigned int *ids);
+
+  /**
+   * @brief mark a block as the most recently used
+   */
+  void touch(Block &block);
+
+  unsigned int block_size;
+  unsigned int max_blocks;
+  std::unordered_map<size_t, Block> blocks;
+  std::list<size_t> lru_order; /**< most recently used first */
+
+  size_t num_hit_tokens;
+  size_t num_lookup_tokens;
+};
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __PREFIX_CACHE_H__ */
@@ -0,0 +1,422 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   quantization_calibrator.cpp
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  Post training quantization of the weights of a float model
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+#include <conv2d_layer.h>
+#include <cpu_backend.h>
+#include <databuffer.h>
+#include <fake_quant_layer.h>
+#include <fc_layer.h>
+#include <layer_context.h>
+#include <layer_node.h>
+#include <neuralnet.h>
+#include <nntrainer_error.h>
+#include <nntrainer_log.h>
+#include <quantization_calibrator.h>
+#include <tensor.h>
+#include <util_func.h>
+
+namespace nntrainer {
+
+namespace {
+
+/**
+ * @brief quantize every row of length K of a tensor to int8 with the scale of
+ * its largest value and back, as the int8 gemm quantizes its input
+ */
+void fakeQuantizeRows(Tensor &tensor, unsigned int K) {
+  const unsigned int rows = tensor.size() / K;
+  std::vector<int8_t> q(tensor.size());
+  std::vector<float> scales(rows);
+
+  float *data = tensor.getData<float>();
+  quantize_rows_s8(rows, K, data, q.data(), scales.data());
+  for (size_t i = 0; i < tensor.size(); ++i)
+    data[i] = q[i] * scales[i / K];
+}
+
+} // namespace
+
+RangeObserver::RangeObserver(unsigned int num_bins_) :
+  hist(num_bins_, 0.0),
+  bin_width(0.0f),
+  min_val(std::numeric_limits<float>::max()),
+  max_val(std::numeric_limits<float>::lowest()),
+  count(0) {
+  NNTR_THROW_IF(num_bins_ == 0, std::invalid_argument)
+    << "a range observer needs at least a bin";
+}
+
+void RangeObserver::grow(float max_abs) {
+  float width = max_abs / hist.size();
+  if (width <= bin_width)
+    return;
+
+  /** every bin moves to the bin of its center, zeros stay in the first */
+  if (bin_width > 0.0f) {
+    std::vector<double> wider(hist.size(), 0.0);
+    for (size_t i = 0; i < hist.size(); ++i) {
+      size_t j = static_cast<size_t>((i + 0.5f) * bin_width / width);
+      wider[std::min(j, hist.size() - 1)] += hist[i];
+    }
+    hist.swap(wider);
+  }
+  bin_width = width;
+}
+
+void RangeObserver::observe(const Tensor &tensor) {
+  NNTR_THROW_IF(tensor.getDataType() != ml::train::TensorDim::DataType::FP32,
+                std::invalid_argument)
+    << "range observer supports FP32 tensors only";
+
+  const float *data = tensor.getData<float>();
+  const size_t len = tensor.size();
+  if (len == 0)
+    return;
+
+  auto [lo, hi] = std::minmax_element(data, data + len);
+  min_val = std::min(min_val, *lo);
+  max_val = std::max(max_val, *hi);
+  grow(std::max(std::abs(*lo), std::abs(*hi)));
+
+  if (bin_width == 0.0f) {
+    hist[0] += len;
+  } else {
+    for (size_t i = 0; i < len; ++i) {
+      size_t bin = static_cast<size_t>(std::abs(data[i]) / bin_width);
+      hist[std::min(bin, hist.size() - 1)] += 1.0;
+    }
+  }
+  count += len;
+}
+
+float RangeObserver::percentileThreshold(float percentile) const {
+  double target = count * (percentile / 100.0);
+  double cumulative = 0.0;
+  for (size_t i = 0; i < hist.size(); ++i) {
+    cumulative += hist[i];
+    if (cumulative >= target)
+      return (i + 1) * bin_width;
+  }
+  return hist.size() * bin_width;
+}
+
+float RangeObserver::mseThreshold() const {
+  /** suffix sums of the counts, and of the first and second moments */
+  const size_t num_bins = hist.size();
+  std::vector<double> s0(num_bins + 1, 0.0), s1(num_bins + 1, 0.0),
+    s2(num_bins + 1, 0.0);
+  for (size_t i = num_bins; i-- > 0;) {
+    double center = (i + 0.5) * bin_width;
+    s0[i] = s0[i + 1] + hist[i];
+    s1[i] = s1[i + 1] + hist[i] * center;
+    s2[i] = s2[i + 1] + hist[i] * center * center;
+  }
+
+  /**
+   * values under the threshold get the rounding error of step^2 / 12 and the
+   * ones over it are clipped to the threshold
+   */
+  size_t best = num_bins;
+  double best_error = std::numeric_limits<double>::max();
+  for (size_t k = 1; k <= num_bins; ++k) {
+    double t = k * bin_width;
+    double step = t / 127.0;
+    double error = (s0[0] - s0[k]) * step * step / 12.0 + s2[k] -
+                   2.0 * t * s1[k] + t * t * s0[k];
+    if (error < best_error) {
+      best_error = error;
+      best = k;
+    }
+  }
+  return best * bin_width;
+}
+
+std::pair<float, float> RangeObserver::getRange(CalibrationMethod method,
+                                                float percentile) const {
+  NNTR_THROW_IF(count == 0, std::invalid_argument)
+    << "range observer has not observed any value";
+  NNTR_THROW_IF(percentile <= 0.0f || percentile > 100.0f,
+                std::invalid_argument)
+    << "percentile must be in (0, 100], given: " << percentile;
+
+  if (method == CalibrationMethod::MIN_MAX)
+    return {min_val, max_val};
+
+  float threshold = method == CalibrationMethod::PERCENTILE
+                      ? percentileThreshold(percentile)
+                      : mseThreshold();
+  return {std::max(min_val, -threshold), std::min(max_val, threshold)};
+}
+
+QuantizationCalibrator::QuantizationCalibrator(
+  NeuralNetwork &model_, ml::train::TensorDim::DataType weight_type_,
+  CalibrationMethod method_, float percentile_) :
+  model(model_),
+  weight_type(weight_type_),
+  method(method_),
+  percentile(percentile_) {
+  NNTR_THROW_IF(weight_type != ml::train::TensorDim::DataType::QINT8 &&
+                  weight_type != ml::train::TensorDim::DataType::QINT4,
+                std::invalid_argument)
+    << "weights can be quantized to QINT8 or QINT4 only";
+  NNTR_THROW_IF(percentile <= 0.0f || percentile > 100.0f,
+                std::invalid_argument)
+    << "percentile must be in (0, 100], given: " << percentile;
+
+  model.forEachLayer([this](ml::train::Layer &layer, RunLayerContext &rc,
+                            void *) {
+    auto &node = static_cast<LayerNode &>(layer);
+    const bool is_fc = node.getType() == FullyConnectedLayer::type;
+    const bool is_conv = node.getType() == Conv2DLayer::type &&
+                         weight_type == ml::train::TensorDim::DataType::QINT8;
+    if ((!is_fc && !is_conv) || rc.getNumWeights() > 2)
+      return;
+
+    NNTR_THROW_IF(rc.getWeight(0).getDataType() !=
+                    ml::train::TensorDim::DataType::FP32,
+                  std::invalid_argument)
+      << "only a model of FP32 weights can be quantized, layer: "
+      << node.getName();
+
+    targets.push_back({&node,
+                       is_fc ? QScheme::PER_CHANNEL_AFFINE
+                             : QScheme::PER_TENSOR_AFFINE,
+                       RangeObserver()});
+  });
+}
+
+void QuantizationCalibrator::setObservers(const TargetObserver &observer) {
+  for (auto &target : targets) {
+    if (!observer) {
+      target.node->setForwardObserver(nullptr);
+      continue;
+    }
+    target.node->setForwardObserver(
+      [&target, observer](LayerNode &, RunLayerContext &rc, bool done) {
+        observer(target, rc, done);
+      });
+  }
+}
+
+void QuantizationCalibrator::run(
+  DataBuffer &buffer,
+  const std::function<void(const std::vector<float *> &)> &on_batch) {
+  auto in_dims = model.getInputDimension();
+  const unsigned int batch = in_dims[0].batch();
+  unsigned int num_batches = 0;
+
+  auto future_iq = buffer.startFetchWorker(in_dims, {}, false);
+  try {
+    while (true) {
+      ScopedView<Iteration> iter_view = buffer.fetch();
+      if (iter_view.isEmpty())
+        break;
+
+      auto &iteration = iter_view.get();
+      if (iteration.batch() != batch)
+        continue;
+
+      std::vector<float *> inputs;
+      for (auto &input : iteration.getInputsRef())
+        inputs.push_back(input.getData<float>());
+      on_batch(inputs);
+      ++num_batches;
+    }
+  } catch (...) {
+    setObservers(nullptr);
+    throw;
+  }
+  future_iq.get();
+  setObservers(nullptr);
+
+  NNTR_THROW_IF(num_batches == 0, std::invalid_argument)
+    << "no batch came from the data buffer";
+}
+
+void QuantizationCalibrator::calibrate(DataBuffer &buffer) {
+  run(buffer, [this](const std::vector<float *> &inputs) {
+    setObservers([](Target &target, RunLayerContext &rc, bool done) {
+      if (!done)
+        target.inputs.observe(rc.getInput(0));
+    });
+    model.inference(model.getInputDimension()[0].batch(), inputs, {});
+  });
+}
+
+std::pair<float, float>
+QuantizationCalibrator::getActivationRange(const std::string &layer) const {
+  auto it = std::find_if(targets.begin(), targets.end(), [&layer](auto &t) {
+    return t.node->getName() == layer;
+  });
+  NNTR_THROW_IF(it == targets.end(), std::invalid_argument)
+    << "layer is not quantized: " << layer;
+  return it->inputs.getRange(method, percentile);
+}
+
+Tensor QuantizationCalibrator::quantize(const Target &target) const {
+  const Tensor &weight = target.node->getRunContext().getWeight(0);
+  auto quantizer = Quantization::createQuantizer(target.qscheme);
+  return quantizer->quantize(weight,
+                             target.qscheme == QScheme::PER_TENSOR_AFFINE
+                               ? ml::train::TensorDim::DataType::QINT8
+                               : weight_type);
+}
+
+std::vector<QuantizationDelta>
+QuantizationCalibrator::evaluate(DataBuffer &buffer) {
+  /// fully connected layers run on the dequantized weight, and convolutions
+  /// on the quantized filter with their own int8 gemm of the patches
+  std::vector<Tensor> weights, quantized;
+  for (auto &target : targets) {
+    Tensor &weight = target.node->getRunContext().getWeight(0);
+    weights.push_back(weight.clone());
+    if (target.qscheme == QScheme::PER_TENSOR_AFFINE)
+      quantized.push_back(quantize(target));
+    else
+      quantized.push_back(
+        Quantization::createQuantizer(QScheme::PER_CHANNEL_AFFINE)
+          ->dequantize(quantize(target),
+                       ml::train::TensorDim::DataType::FP32));
+  }
+
+  auto setWeights = [this](std::vector<Tensor> &from) {
+    for (unsigned int i = 0; i < targets.size(); ++i)
+      if (targets[i].qscheme != QScheme::PER_TENSOR_AFFINE)
+        targets[i].node->getRunContext().getWeight(0).copyData(from[i]);
+  };
+  auto swapFilters = [this, &quantized]() {
+    for (unsigned int i = 0; i < targets.size(); ++i)
+      if (targets[i].qscheme == QScheme::PER_TENSOR_AFFINE)
+        std::swap(targets[i].node->getRunContext().getWeight(0), quantized[i]);
+  };
+
+  std::vector<Tensor> reference(targets.size());
+  std::vector<double> error_sq(targets.size(), 0.0);
+  std::vector<double> reference_sq(targets.size(), 0.0);
+  std::vector<float> max_error(targets.size(), 0.0f);
+  auto index = [this](Target &target) {
+    return static_cast<unsigned int>(&target - targets.data());
+  };
+
+  auto float_pass = [&](Target &target, RunLayerContext &rc, bool done) {
+    if (done)
+      reference[index(target)] = rc.getOutput(0).clone();
+  };
+
+  /// the int8 gemm of a QINT8 fully connected layer quantizes every row of
+  /// its input on the fly, a QINT4 one runs on the float input
+  const bool quantize_rows =
+    weight_type == ml::train::TensorDim::DataType::QINT8;
+  Tensor input_backup;
+  auto quantized_pass = [&](Target &target, RunLayerContext &rc, bool done) {
+    unsigned int i = index(target);
+    const bool is_fc = target.qscheme != QScheme::PER_TENSOR_AFFINE;
+    Tensor &input = rc.getInput(0);
+    if (!done) {
+      if (is_fc && quantize_rows) {
+        input_backup = input.clone();
+        fakeQuantizeRows(input, rc.getWeight(0).height());
+      }
+      return;
+    }
+    if (is_fc && quantize_rows)
+      input.copyData(input_backup);
+
+    const float *ref = reference[i].getData<float>();
+    const float *out = rc.getOutput(0).getData<float>();
+    for (size_t j = 0; j < reference[i].size(); ++j) {
+      double diff = out[j] - ref[j];
+      error_sq[i] += diff * diff;
+      reference_sq[i] += static_cast<double>(ref[j]) * ref[j];
+      max_error[i] = std::max(max_error[i], static_cast<float>(std::abs(diff)));
+    }
+  };
+
+  const unsigned int batch = model.getInputDimension()[0].batch();
+  try {
+    run(buffer, [&](const std::vector<float *> &inputs) {
+      setObservers(float_pass);
+      model.inference(batch, inputs, {});
+
+      setObservers(quantized_pass);
+      setWeights(quantized);
+      swapFilters();
+      try {
+        model.inference(batch, inputs, {});
+      } catch (...) {
+        swapFilters();
+        throw;
+      }
+      swapFilters();
+      setWeights(weights);
+    });
+  } catch (...) {
+    setWeights(weights);
+    throw;
+  }
+
+  std::vector<QuantizationDelta> deltas;
+  for (unsigned int i = 0; i < targets.size(); ++i) {
+    float relative = reference_sq[i] > 0.0
+                       ? std::sqrt(error_sq[i] / reference_sq[i])
+                       : std::sqrt(error_sq[i]);
+    deltas.push_back({targets[i].node->getName(), max_error[i], relative});
+    ml_logi("[QuantizationCalibrator] %s: max abs error %f, relative error %f",
+            deltas.back().layer.c_str(), deltas.back().max_abs_error,
+            deltas.back().relative_error);
+  }
+  return deltas;
+}
+
+void QuantizationCalibrator::save(const std::string &file_path) {
+  auto file = checkedOpenStream<std::ofstream>(
+    file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+  /** the weights are written in the order NeuralNetwork::save writes them */
+  model.forEachLayer([this, &file](ml::train::Layer &layer,
+                                   RunLayerContext &rc, void *) {
+    auto *node = static_cast<LayerNode *>(&layer);
+    /// the fake quantization of quantization aware training is left out
+    if (node->getType() == FakeQuantLayer::type)
+      return;
+
+    auto target = std::find_if(targets.begin(), targets.end(),
+                               [node](auto &t) { return t.node == node; });
+    for (unsigned int i = 0; i < rc.getNumWeights(); ++i) {
+      if (!rc.isGradientFirstAccess(i))
+        continue;
+      if (target != targets.end() && i == 0)
+        quantize(*target).save(file);
+      else
+        rc.getWeight(i).save(file);
+    }
+  });
+
+  unsigned int epoch_idx = 0, iter = 0;
+  file.write((char *)&epoch_idx, sizeof(epoch_idx));
+  file.write((char *)&iter, sizeof(iter));
+  file.close();
+}
+
+std::vector<std::string> QuantizationCalibrator::getQuantizedLayers() const {
+  std::vector<std::string> names;
+  for (auto &target : targets)
+    names.push_back(target.node->getName());
+  return names;
+}
+
+} // namespace nntrainer
@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   quantization_calibrator.h
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  Post training quantization of the weights of a float model
+ *
+ * The weights of every fully connected and convolution layer are quantized,
+ * the fully connected ones with a scale factor per channel, and written to a
+ * weight file which a model of a quantized weight data type reads. The
+ * accuracy of each quantized layer is reported by running the evaluation data
+ * through both the float model and a simulation of the quantized one.
+ *
+ * The int8 gemm of the quantized model quantizes its input row by row on the
+ * fly, so no activation range is stored. The calibration data may still run
+ * through the float model while observers on the layer nodes collect the range
+ * of the input of those layers, for a runtime quantizing them statically.
+ */
+
+#ifndef __QUANTIZATION_CALIBRATOR_H__
+#define __QUANTIZATION_CALIBRATOR_H__
+#ifdef __cplusplus
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <quantizer.h>
+#include <tensor_dim.h>
+
+namespace nntrainer {
+
+class DataBuffer;
+class LayerNode;
+class NeuralNetwork;
+class RunLayerContext;
+class Tensor;
+
+/**
+ * @brief method to choose the clipping range of an activation
+ */
+enum class CalibrationMethod {
+  MIN_MAX = 0, /**< range of every observed value */
+  PERCENTILE,  /**< clip the absolute values beyond a percentile */
+  MSE,         /**< clip minimizing the mean squared quantization error */
+};
+
+/**
+ * @class   RangeObserver
+ * @brief   Observes the values of a tensor over the calibration data
+ * @note    the absolute values are kept in a histogram whose range grows with
+ * the observed values, so that percentile and mse clipping can be chosen after
+ * every batch is observed.
+ */
+class RangeObserver {
+public:
+  /**
+   * @brief Construct a new Range Observer object
+   *
+   * @param num_bins_ number of bins of the histogram
+   */
+  RangeObserver(unsigned int num_bins_ = 2048);
+
+  /**
+   * @brief observe the values of a FP32 tensor
+   */
+  void observe(const Tensor &tensor);
+
+  /**
+   * @brief get the clipping range of the observed values
+   *
+   * @param method method to choose the range
+   * @param percentile percentile of the absolute values kept by PERCENTILE
+   * @return std::pair<float, float> min and max of the range
+   */
+  std::pair<float, float> getRange(CalibrationMethod method,
+                                   float percentile = 99.99f) const;
+
+  /**
+   * @brief get the number of observed values
+   */
+  size_t getCount() const { return count; }
+
+private:
+  /**
+   * @brief widen the histogram to hold values up to @a max_abs
+   */
+  void grow(float max_abs);
+
+  /**
+   * @brief threshold keeping @a percentile of the absolute values
+   */
+  float percentileThreshold(float percentile) const;
+
+  /**
+   * @brief threshold minimizing the expected error of int8 quantization
+   */
+  float mseThreshold() const;
+
+  std::vector<double> hist; /**< counts of absolute values */
+  float bin_width;
+  float min_val;
+  float max_val;
+  size_t count;
+};
+
+/**
+ * @brief accuracy of a quantized layer on the evaluation data
+ */
+struct QuantizationDelta {
+  std::string layer;    /**< name of the layer */
+  float max_abs_error;  /**< largest absolute error of an output */
+  float relative_error; /**< norm of the error over the norm of the output */
+};
+
+/**
+ * @class   QuantizationCalibrator
+ * @brief   Post training quantization of a float model
+ * @note    the model must be initialized for inference with FP32 weights and
+ * activations. Fully connected layers are quantized per channel to the weight
+ * data type, and convolution layers per tensor to QINT8 as their int8 kernel
+ * requires; convolutions are kept in float for QINT4. Layers with weights
+ * other than the weight and the bias, e.g. of LoRA, are kept in float.
+ *
+ * The saved file is read by the same model whose model_tensor_type is
+ * "QINT8-FP32" or "QINT4-FP32" and whose layers not in getQuantizedLayers()
+ * are set "packed=false". A model trained with the fake_quant property exports
+ * the weights it simulated this way, read by the model without fake_quant.
+ */
+class QuantizationCalibrator {
+public:
+  /**
+   * @brief Construct a new Quantization Calibrator object
+   *
+   * @param model_ model to quantize
+   * @param weight_type_ QINT8 or QINT4
+   * @param method_ method to choose the activation ranges
+   * @param percentile_ percentile of the absolute values kept by PERCENTILE
+   */
+  QuantizationCalibrator(
+    NeuralNetwork &model_,
+    ml::train::TensorDim::DataType weight_type_ =
+      ml::train::TensorDim::DataType::QINT8,
+    CalibrationMethod method_ = CalibrationMethod::MIN_MAX,
+    float percentile_ = 99.99f);
+
+  /**
+   * @brief run the calibration data through the model and observe the inputs
+   * of the quantized layers
+   *
+   * @param buffer calibration data, of the input dimension of the model
+   * @note can be called several times to observe more data. The ranges are not
+   * used by evaluate() or save(), as the quantized model quantizes its
+   * activations dynamically.
+   */
+  void calibrate(DataBuffer &buffer);
+
+  /**
+   * @brief get the calibrated range of the input of a quantized layer
+   *
+   * @param layer name of the layer
+   * @return std::pair<float, float> min and max of the range
+   */
+  std::pair<float, float> getActivationRange(const std::string &layer) const;
+
+  /**
+   * @brief compare the outputs of the quantized layers with the float ones
+   *
+   * @param buffer evaluation data, of the input dimension of the model
+   * @return std::vector<QuantizationDelta> delta of each quantized layer
+   * @note the quantized model is simulated as it runs: a convolution runs its
+   * int8 gemm on the quantized filter, a QINT8 fully connected layer runs on
+   * its input quantized row by row and a QINT4 one on the float input. The
+   * delta of a layer includes the error propagated from the former layers.
+   */
+  std::vector<QuantizationDelta> evaluate(DataBuffer &buffer);
+
+  /**
+   * @brief save the weights of the model with the quantized layers quantized
+   *
+   * @param file_path path of the weight file, in the binary model format
+   */
+  void save(const std::string &file_path);
+
+  /**
+   * @brief get the names of the layers to quantize
+   */
+  std::vector<std::string> getQuantizedLayers() const;
+
+private:
+  /**
+   * @brief layer to quantize
+   */
+  struct Target {
+    LayerNode *node;      /**< node of the layer */
+    QScheme qscheme;      /**< scheme of the weight */
+    RangeObserver inputs; /**< observer of the input */
+  };
+
+  /**
+   * @brief observer of the forwarding of a target
+   */
+  using TargetObserver =
+    std::function<void(Target &target, RunLayerContext &context, bool done)>;
+
+  /**
+   * @brief set the observer of every target, or reset them if empty
+   */
+  void setObservers(const TargetObserver &observer);
+
+  /**
+   * @brief fetch every batch of a data buffer
+   *
+   * @param buffer data buffer of the input dimension of the model
+   * @param on_batch called with the inputs of each batch
+   * @note the observers are reset at the end
+   */
+  void run(DataBuffer &buffer,
+           const std::function<void(const std::vector<float *> &)> &on_batch);
+
+  /**
+   * @brief quantize the weight of a target
+   */
+  Tensor quantize(const Target &target) const;
+
+  NeuralNetwork &model;
+  ml::train::TensorDim::DataType weight_type;
+  CalibrationMethod method;
+  float percentile;
+
+  std::vector<Target> targets;
+};
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __QUANTIZATION_CALIBRATOR_H__ */
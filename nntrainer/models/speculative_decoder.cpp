@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   speculative_decoder.cpp
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  Speculative decoding of a target model with a draft model
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <nntrainer_error.h>
+#include <speculative_decoder.h>
+
+namespace nntrainer {
+
+SpeculativeDecoder::SpeculativeDecoder(ml::train::Model &target_,
+                                       ml::train::Model &draft_,
+                                       unsigned int vocab_,
+                                       unsigned int num_draft_,
+                                       float temperature_, unsigned int seed_) :
+  target(target_),
+  draft(draft_),
+  num_draft(num_draft_),
+  temperature(temperature_),
+  rng(seed_),
+  vocab(vocab_),
+  num_drafted(0),
+  num_accepted(0) {
+  NNTR_THROW_IF(vocab == 0, std::invalid_argument)
+    << "vocabulary must not be empty";
+  NNTR_THROW_IF(num_draft == 0, std::invalid_argument)
+    << "number of draft tokens must be positive";
+  NNTR_THROW_IF(temperature < 0.0f, std::invalid_argument)
+    << "temperature must not be negative, given: " << temperature;
+
+  auto target_in = target.getInputDimension();
+  auto draft_in = draft.getInputDimension();
+  NNTR_THROW_IF(target_in.size() != 1 || draft_in.size() != 1,
+                std::invalid_argument)
+    << "speculative decoding needs models of a single input";
+
+  /** the input holds a token id for each position */
+  max_len =
+    std::min(target_in[0].getFeatureLen(), draft_in[0].getFeatureLen());
+  target_input.resize(target_in[0].getFeatureLen());
+  draft_input.resize(draft_in[0].getFeatureLen());
+}
+
+const float *SpeculativeDecoder::step(ml::train::Model &model,
+                                      std::vector<float> &input,
+                                      const std::vector<unsigned int> &tokens,
+                                      unsigned int from) {
+  std::fill(input.begin(), input.end(), 0.0f);
+  std::copy(tokens.begin(), tokens.end(), input.begin());
+
+  unsigned int to = from + tokens.size();
+  auto out =
+    model.incremental_inference(1, {input.data()}, {}, max_len, from, to, true);
+  return out[0];
+}
+
+std::vector<float>
+SpeculativeDecoder::distribution(const float *logits) const {
+  std::vector<float> probs(vocab, 0.0f);
+  unsigned int argmax = std::max_element(logits, logits + vocab) - logits;
+
+  if (temperature == 0.0f) {
+    probs[argmax] = 1.0f;
+    return probs;
+  }
+
+  float sum = 0.0f;
+  for (unsigned int i = 0; i < vocab; ++i) {
+    probs[i] = std::exp((logits[i] - logits[argmax]) / temperature);
+    sum += probs[i];
+  }
+  for (auto &p : probs)
+    p /= sum;
+  return probs;
+}
+
+unsigned int SpeculativeDecoder::sample(const std::vector<float> &probs) {
+  std::discrete_distribution<unsigned int> dist(probs.begin(), probs.end());
+  return dist(rng);
+}
+
+std::vector<unsigned int>
+SpeculativeDecoder::generate(const std::vector<unsigned int> &prompt,
+                             unsigned int max_tokens,
+                             std::function<bool(unsigned int)> stop_cb) {
+  NNTR_THROW_IF(prompt.empty(), std::invalid_argument)
+    << "prompt must not be empty";
+  NNTR_THROW_IF(prompt.size() >= max_len, std::invalid_argument)
+    << "prompt of " << prompt.size() << " tokens leaves no room in "
+    << max_len << " positions";
+
+  std::vector<unsigned int> generated;
+  if (max_tokens == 0)
+    return generated;
+
+  /** returns true if the generation is over */
+  auto commit = [&generated, &stop_cb, max_tokens](unsigned int token) {
+    generated.push_back(token);
+    return stop_cb(token) || generated.size() >= max_tokens;
+  };
+
+  /** prefilling from 0 also clears what was cached by a former generation */
+  unsigned int pos = prompt.size();
+  const float *logits = step(target, target_input, prompt, 0);
+  step(draft, draft_input, prompt, 0);
+
+  unsigned int next = sample(distribution(logits + (pos - 1) * vocab));
+  if (commit(next))
+    return generated;
+
+  /**
+   * @a next is at @a pos and has not been fed to the target yet. @a pending
+   * are the tokens up to @a pos which have not been fed to the draft yet.
+   */
+  std::vector<unsigned int> pending = {next};
+  std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+
+  while (pos + 1 < max_len) {
+    unsigned int num_steps =
+      std::min({num_draft, max_len - 1 - pos,
+                max_tokens - static_cast<unsigned int>(generated.size())});
+
+    /** propose */
+    std::vector<unsigned int> drafted;
+    std::vector<std::vector<float>> draft_probs;
+    const float *draft_logits =
+      step(draft, draft_input, pending, pos + 1 - pending.size());
+    draft_logits += (pending.size() - 1) * vocab;
+    for (unsigned int i = 0; i < num_steps; ++i) {
+      if (i > 0)
+        draft_logits = step(draft, draft_input, {drafted.back()}, pos + i);
+      draft_probs.push_back(distribution(draft_logits));
+      drafted.push_back(sample(draft_probs.back()));
+    }
+    num_drafted += num_steps;
+
+    /** verify every proposal at once */
+    std::vector<unsigned int> verified = {next};
+    verified.insert(verified.end(), drafted.begin(), drafted.end());
+    const float *target_logits = step(target, target_input, verified, pos);
+
+    unsigned int accepted = 0;
+    unsigned int correction = 0;
+    for (; accepted < num_steps; ++accepted) {
+      auto p = distribution(target_logits + accepted * vocab);
+      auto &q = draft_probs[accepted];
+      unsigned int token = drafted[accepted];
+      if (uniform(rng) < std::min(1.0f, p[token] / q[token]))
+        continue;
+
+      /** resample from where the target is more likely than the draft */
+      float residual_sum = 0.0f;
+      for (unsigned int i = 0; i < vocab; ++i) {
+        q[i] = std::max(0.0f, p[i] - q[i]);
+        residual_sum += q[i];
+      }
+      correction = sample(residual_sum > 0.0f ? q : p);
+      break;
+    }
+    if (accepted == num_steps)
+      correction = sample(distribution(target_logits + num_steps * vocab));
+    num_accepted += accepted;
+
+    for (unsigned int i = 0; i < accepted; ++i)
+      if (commit(drafted[i]))
+        return generated;
+    if (commit(correction))
+      return generated;
+
+    /**
+     * steps past the accepted ones are rolled back by overwriting them from
+     * the next round. The draft has not seen its last proposal when all of
+     * them are accepted.
+     */
+    pending = {correction};
+    if (accepted == num_steps)
+      pending.insert(pending.begin(), drafted.back());
+    pos += accepted + 1;
+    next = correction;
+  }
+
+  return generated;
+}
+
+} // namespace nntrainer
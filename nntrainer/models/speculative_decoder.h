@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   speculative_decoder.h
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  Speculative decoding of a target model with a draft model
+ *
+ * A small draft model proposes a few tokens one by one, and the target model
+ * verifies all of them in a single multi step incremental inference. The
+ * longest prefix the target agrees with is kept together with one token of
+ * the target itself, so every round yields at least one token.
+ *
+ * With temperature 0 a proposal is kept if it is the argmax of the target,
+ * which reproduces greedy decoding of the target exactly. Otherwise the
+ * proposals are accepted with probability min(1, p / q) and a rejected one is
+ * resampled from max(0, p - q), which leaves the output distribution of the
+ * target unchanged.
+ */
+
+#ifndef __SPECULATIVE_DECODER_H__
+#define __SPECULATIVE_DECODER_H__
+#ifdef __cplusplus
+
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <model.h>
+
+namespace nntrainer {
+
+/**
+ * @class   SpeculativeDecoder
+ * @brief   Generates tokens of a target model with the help of a draft model
+ * @note    both models take a token id per position, e.g. of shape
+ * 1:1:max_len, and produce logits of shape 1:max_len:vocab in FP32 with batch
+ * size 1. They must be initialized for inference, and their incremental steps
+ * must support more than a single position.
+ */
+class SpeculativeDecoder {
+public:
+  /**
+   * @brief Construct a new Speculative Decoder object
+   *
+   * @param target_ model whose output is generated
+   * @param draft_ model which proposes tokens, sharing the vocabulary
+   * @param vocab_ size of the vocabulary, the width of the logits
+   * @param num_draft_ number of tokens proposed each round
+   * @param temperature_ sampling temperature, 0 for greedy decoding
+   * @param seed_ seed of the sampler
+   */
+  SpeculativeDecoder(ml::train::Model &target_, ml::train::Model &draft_,
+                     unsigned int vocab_, unsigned int num_draft_,
+                     float temperature_ = 0.0f, unsigned int seed_ = 0);
+
+  /**
+   * @brief generate tokens following the prompt
+   *
+   * @param prompt token ids of the prompt
+   * @param max_tokens maximum number of tokens to generate
+   * @param stop_cb called with every generated token, stops if returns true
+   * @return std::vector<unsigned int> generated tokens
+   * @note generation also stops when the sequence reaches the max length of
+   * either model
+   */
+  std::vector<unsigned int>
+  generate(const std::vector<unsigned int> &prompt, unsigned int max_tokens,
+           std::function<bool(unsigned int)> stop_cb =
+             [](unsigned int) { return false; });
+
+  /**
+   * @brief get the number of tokens proposed by the draft model so far
+   */
+  unsigned int getNumDrafted() const { return num_drafted; }
+
+  /**
+   * @brief get the number of proposed tokens accepted by the target so far
+   */
+  unsigned int getNumAccepted() const { return num_accepted; }
+
+private:
+  /**
+   * @brief run an incremental step of a model
+   *
+   * @param model model to run
+   * @param input input buffer of the model
+   * @param tokens tokens to feed at positions [from, from + tokens.size())
+   * @param from position of the first token
+   * @return const float* logits of the steps, one row per token
+   */
+  const float *step(ml::train::Model &model, std::vector<float> &input,
+                    const std::vector<unsigned int> &tokens,
+                    unsigned int from);
+
+  /**
+   * @brief turn a row of logits into the distribution to sample from
+   *
+   * @param logits logits of a position
+   * @return std::vector<float> probabilities, one-hot on the argmax for
+   * greedy decoding
+   */
+  std::vector<float> distribution(const float *logits) const;
+
+  /**
+   * @brief sample a token from a distribution
+   */
+  unsigned int sample(const std::vector<float> &probs);
+
+  ml::train::Model &target;
+  ml::train::Model &draft;
+  unsigned int num_draft;
+  float temperature;
+  std::mt19937 rng;
+
+  unsigned int vocab;   /**< size of the vocabulary */
+  unsigned int max_len; /**< positions both models can hold */
+  std::vector<float> target_input;
+  std::vector<float> draft_input;
+
+  unsigned int num_drafted;
+  unsigned int num_accepted;
+};
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __SPECULATIVE_DECODER_H__ */
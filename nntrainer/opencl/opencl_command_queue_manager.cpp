@@ -18,6 +18,10 @@
 
 #include <nntrainer_log.h>
 
+#ifdef PROFILE
+#include <profiler.h>
+#endif
+
 namespace nntrainer::opencl {
 
 /**
@@ -52,14 +56,34 @@ bool CommandQueueManager::CreateCommandQueue() {
   // getting GPU device ID
   cl_device_id device_id = context_instance.GetDeviceId();
 
+  cl_command_queue_properties properties = 0;
+#ifdef PROFILE
+  // device timestamps of every command are reported to the profiler
+  properties |= CL_QUEUE_PROFILING_ENABLE;
+  profiling_enabled_ = true;
+#endif
+
   // returns NULL with error code if fails
-  command_queue_ = clCreateCommandQueue(context, device_id, 0, &error_code);
+  command_queue_ =
+    clCreateCommandQueue(context, device_id, properties, &error_code);
   if (!command_queue_) {
     ml_loge("Failed to create a command queue. OpenCL error code: %d",
             error_code);
     return false;
   }
   ml_logi("opencl_command_queue_manager: Created command queue");
+
+  // a second in-order queue lets transfers overlap with kernels
+  transfer_queue_ =
+    clCreateCommandQueue(context, device_id, properties, &error_code);
+  if (!transfer_queue_) {
+    ml_logw("Failed to create a transfer queue, transfers share the command "
+            "queue. OpenCL error code: %d",
+            error_code);
+    transfer_queue_ = command_queue_;
+    clRetainCommandQueue(transfer_queue_);
+  }
+
   // increments the command_queue reference count
   clRetainCommandQueue(command_queue_);
   ml_logi("opencl_command_queue_manager: Retained command queue");
@@ -82,6 +106,15 @@ void CommandQueueManager::ReleaseCommandQueue() {
  *
  */
 CommandQueueManager::~CommandQueueManager() {
+  if (transfer_queue_) {
+    clReleaseCommandQueue(transfer_queue_);
+    transfer_queue_ = nullptr;
+  }
+
+  for (auto &[event, name] : profiled_events_)
+    clReleaseEvent(event);
+  profiled_events_.clear();
+
   if (command_queue_) {
     ml_logi("opencl_command_queue_manager: Destroyed command queue");
     // decrements the command_queue reference count
@@ -103,6 +136,10 @@ const cl_command_queue CommandQueueManager::GetCommandQueue() {
   return command_queue_;
 }
 
+cl_command_queue CommandQueueManager::GetQueue(QueueType type) {
+  return type == QueueType::TRANSFER ? transfer_queue_ : command_queue_;
+}
+
 /**
  * @brief Reading buffer object. Used from Buffer class
  *
@@ -128,6 +165,9 @@ bool CommandQueueManager::EnqueueReadBuffer(cl_mem buffer, size_t size_in_bytes,
     return false;
   }
 
+  if (blocking)
+    ReportProfiledEvents();
+
   return true;
 }
 
@@ -163,6 +203,9 @@ bool CommandQueueManager::EnqueueReadBufferRegion(
     return false;
   }
 
+  if (blocking)
+    ReportProfiledEvents();
+
   return true;
 }
 
@@ -302,67 +345,257 @@ bool CommandQueueManager::EnqueueUnmapMemObject(cl_mem buffer, void *mapped_ptr,
  * @param work_group_size Number of work items that make up a work group
  * @param event Object that identifies this command and can be used to query
  * or wait for this command to complete
+ * @param wait_events events the kernel waits for
  * @return true if command queue execution is successful or false otherwise
  */
-bool CommandQueueManager::DispatchCommand(Kernel kernel,
-                                          const int (&work_groups_count)[3],
-                                          const int (&work_group_size)[3],
-                                          cl_event *event) {
+bool CommandQueueManager::DispatchCommand(
+  Kernel kernel, const int (&work_groups_count)[3],
+  const int (&work_group_size)[3], cl_event *event,
+  const std::vector<cl_event> &wait_events) {
 
-  // work_dim of 2 has been hardcoded, might be modified later based on
-  // requirements
+  // the third dimension is 1 unless the kernel walks a batch on it
 
   // setting the local_work_size referred to as the size of the
   // work-group
-  const size_t local[2] = {static_cast<size_t>(work_group_size[0]),
-                           static_cast<size_t>(work_group_size[1])};
+  const size_t local[3] = {static_cast<size_t>(work_group_size[0]),
+                           static_cast<size_t>(work_group_size[1]),
+                           static_cast<size_t>(work_group_size[2])};
 
   // setting the global_work_size that describe the number of global work-items
-  const size_t global[2] = {static_cast<size_t>(work_groups_count[0]),
-                            static_cast<size_t>(work_groups_count[1])};
+  const size_t global[3] = {static_cast<size_t>(work_groups_count[0]),
+                            static_cast<size_t>(work_groups_count[1]),
+                            static_cast<size_t>(work_groups_count[2])};
 
   cl_kernel kernel_ = kernel.GetKernel();
 
+  // an event is needed to read the device timestamps of the kernel
+  cl_event profile_event = nullptr;
+  cl_event *out_event =
+    event ? event : (profiling_enabled_ ? &profile_event : nullptr);
+
   // returns NULL with error code if fails
   const int error_code = clEnqueueNDRangeKernel(
-    command_queue_, kernel_, 2, nullptr, global, local, 0, nullptr, event);
+    command_queue_, kernel_, 3, nullptr, global, local, wait_events.size(),
+    wait_events.empty() ? nullptr : wait_events.data(), out_event);
   if (error_code != CL_SUCCESS) {
     ml_loge("Failed to clEnqueueNDRangeKernel. OpenCL error code: %d",
             error_code);
     return false;
   }
 
+  if (out_event)
+    TrackEvent(*out_event, kernel.GetName(), out_event == event);
+
   return true;
 }
 
 bool CommandQueueManager::DispatchCommand(
   const std::shared_ptr<Kernel> &kernel_ptr, const int (&work_groups_count)[3],
-  const int (&work_group_size)[3], cl_event *event) {
+  const int (&work_group_size)[3], cl_event *event,
+  const std::vector<cl_event> &wait_events) {
 
-  // work_dim of 2 has been hardcoded, might be modified later based on
-  // requirements
+  // the third dimension is 1 unless the kernel walks a batch on it
 
   // setting the local_work_size referred to as the size of the
   // work-group
-  const size_t local[2] = {static_cast<size_t>(work_group_size[0]),
-                           static_cast<size_t>(work_group_size[1])};
+  const size_t local[3] = {static_cast<size_t>(work_group_size[0]),
+                           static_cast<size_t>(work_group_size[1]),
+                           static_cast<size_t>(work_group_size[2])};
 
   // setting the global_work_size that describe the number of global work-items
-  const size_t global[2] = {static_cast<size_t>(work_groups_count[0]),
-                            static_cast<size_t>(work_groups_count[1])};
+  const size_t global[3] = {static_cast<size_t>(work_groups_count[0]),
+                            static_cast<size_t>(work_groups_count[1]),
+                            static_cast<size_t>(work_groups_count[2])};
 
   cl_kernel kernel_ = kernel_ptr->GetKernel();
 
+  // an event is needed to read the device timestamps of the kernel
+  cl_event profile_event = nullptr;
+  cl_event *out_event =
+    event ? event : (profiling_enabled_ ? &profile_event : nullptr);
+
   // returns NULL with error code if fails
   const int error_code = clEnqueueNDRangeKernel(
-    command_queue_, kernel_, 2, nullptr, global, local, 0, nullptr, event);
+    command_queue_, kernel_, 3, nullptr, global, local, wait_events.size(),
+    wait_events.empty() ? nullptr : wait_events.data(), out_event);
   if (error_code != CL_SUCCESS) {
     ml_loge("Failed to clEnqueueNDRangeKernel. OpenCL error code: %d",
             error_code);
     return false;
   }
 
+  if (out_event)
+    TrackEvent(*out_event, kernel_ptr->GetName(), out_event == event);
+
   return true;
 }
 
+/**
+ * @brief Block until all previously queued commands have completed
+ *
+ * @return true if all commands have completed or false otherwise
+ */
+bool CommandQueueManager::Finish() {
+  for (auto queue : {command_queue_, transfer_queue_}) {
+    if (!queue)
+      continue;
+
+    const cl_int error_code = clFinish(queue);
+    if (error_code != CL_SUCCESS) {
+      ml_loge("Failed to clFinish. OpenCL error code: %d", error_code);
+      return false;
+    }
+  }
+
+  ReportProfiledEvents();
+  return true;
+}
+
+bool CommandQueueManager::EnqueueWriteBufferAsync(
+  cl_mem buffer, size_t size_in_bytes, const void *data, cl_event *event,
+  const std::vector<cl_event> &wait_events) {
+  cl_int error_code = clEnqueueWriteBuffer(
+    transfer_queue_, buffer, CL_FALSE, 0, size_in_bytes, data,
+    wait_events.size(), wait_events.empty() ? nullptr : wait_events.data(),
+    event);
+  if (error_code != CL_SUCCESS) {
+    ml_loge("Failed to upload data to GPU (clEnqueueWriteBuffer). OpenCL error "
+            "code: %d",
+            error_code);
+    return false;
+  }
+
+  TrackEvent(*event, "opencl_write_buffer", true);
+  return true;
+}
+
+bool CommandQueueManager::EnqueueReadBufferAsync(
+  cl_mem buffer, size_t size_in_bytes, void *data, cl_event *event,
+  const std::vector<cl_event> &wait_events) {
+  cl_int error_code = clEnqueueReadBuffer(
+    transfer_queue_, buffer, CL_FALSE, 0, size_in_bytes, data,
+    wait_events.size(), wait_events.empty() ? nullptr : wait_events.data(),
+    event);
+  if (error_code != CL_SUCCESS) {
+    ml_loge("Failed to read data from GPU (clEnqueueReadBuffer). OpenCL error "
+            "code: %d",
+            error_code);
+    return false;
+  }
+
+  TrackEvent(*event, "opencl_read_buffer", true);
+  return true;
+}
+
+bool CommandQueueManager::EnqueueBarrier(
+  QueueType type, const std::vector<cl_event> &wait_events) {
+  if (wait_events.empty())
+    return true;
+
+  cl_int error_code = clEnqueueBarrierWithWaitList(
+    GetQueue(type), wait_events.size(), wait_events.data(), nullptr);
+  if (error_code != CL_SUCCESS) {
+    ml_loge("Failed to clEnqueueBarrierWithWaitList. OpenCL error code: %d",
+            error_code);
+    return false;
+  }
+
+  return true;
+}
+
+bool CommandQueueManager::EnqueueMarker(QueueType type, cl_event *event) {
+  cl_int error_code =
+    clEnqueueMarkerWithWaitList(GetQueue(type), 0, nullptr, event);
+  if (error_code != CL_SUCCESS) {
+    ml_loge("Failed to clEnqueueMarkerWithWaitList. OpenCL error code: %d",
+            error_code);
+    return false;
+  }
+
+  return true;
+}
+
+bool CommandQueueManager::WaitForEvents(std::vector<cl_event> &events) {
+  std::vector<cl_event> valid_events;
+  for (auto event : events) {
+    if (event)
+      valid_events.push_back(event);
+  }
+  events.clear();
+
+  if (valid_events.empty())
+    return true;
+
+  const cl_int error_code =
+    clWaitForEvents(valid_events.size(), valid_events.data());
+  if (error_code != CL_SUCCESS) {
+    ml_loge("Failed to clWaitForEvents. OpenCL error code: %d", error_code);
+  }
+
+  for (auto event : valid_events)
+    clReleaseEvent(event);
+
+  ReportProfiledEvents();
+  return error_code == CL_SUCCESS;
+}
+
+void CommandQueueManager::TrackEvent(cl_event event, const std::string &name,
+                                     bool retain) {
+  if (!profiling_enabled_ || !event)
+    return;
+
+  // the caller releases its own reference independently
+  if (retain)
+    clRetainEvent(event);
+
+  std::lock_guard<std::mutex> lock(profile_mutex_);
+  profiled_events_.emplace_back(event, name);
+}
+
+void CommandQueueManager::ReportProfiledEvents() {
+  if (!profiling_enabled_)
+    return;
+
+  std::lock_guard<std::mutex> lock(profile_mutex_);
+
+  auto it = profiled_events_.begin();
+  while (it != profiled_events_.end()) {
+    cl_event event = it->first;
+
+    cl_int status = CL_QUEUED;
+    cl_int error_code =
+      clGetEventInfo(event, CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(status),
+                     &status, nullptr);
+    // still queued, submitted or running
+    if (error_code == CL_SUCCESS && status > CL_COMPLETE) {
+      ++it;
+      continue;
+    }
+
+    cl_ulong start = 0;
+    cl_ulong end = 0;
+    if (error_code == CL_SUCCESS && status == CL_COMPLETE &&
+        clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_START,
+                                sizeof(start), &start,
+                                nullptr) == CL_SUCCESS &&
+        clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_END, sizeof(end),
+                                &end, nullptr) == CL_SUCCESS) {
+#ifdef PROFILE
+      auto item = profile_items_.find(it->second);
+      if (item == profile_items_.end()) {
+        int key = profile::Profiler::Global().registerTimeItem(it->second);
+        item = profile_items_.emplace(it->second, key).first;
+      }
+
+      // device timestamps are in nanoseconds
+      profile::Profiler::Global().record(
+        item->second, std::chrono::microseconds((end - start) / 1000));
+#endif
+    }
+
+    clReleaseEvent(event);
+    it = profiled_events_.erase(it);
+  }
+}
+
 } // namespace nntrainer::opencl
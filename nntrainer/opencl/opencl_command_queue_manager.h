@@ -17,6 +17,11 @@
 #include "opencl_kernel.h"
 #include "third_party/cl.h"
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace nntrainer::opencl {
 
@@ -27,13 +32,72 @@ namespace nntrainer::opencl {
  *
  */
 class CommandQueueManager {
+public:
+  /**
+   * @brief Queues owned by the manager. Commands of a queue run in order,
+   * commands of different queues only wait for the events they depend on so
+   * that transfers can overlap with kernels
+   *
+   */
+  enum class QueueType {
+    COMPUTE = 0, /**< kernels and the blocking transfer calls */
+    TRANSFER = 1 /**< asynchronous uploads and downloads */
+  };
 
+private:
   /**
    * @brief cl_command_queue instance
    *
    */
   cl_command_queue command_queue_{nullptr};
 
+  /**
+   * @brief cl_command_queue for asynchronous transfers, same as
+   * command_queue_ if a second queue could not be created
+   *
+   */
+  cl_command_queue transfer_queue_{nullptr};
+
+  /**
+   * @brief true if the queues are created with CL_QUEUE_PROFILING_ENABLE
+   *
+   */
+  bool profiling_enabled_{false};
+
+  /**
+   * @brief events waiting to be reported to the profiler with their names
+   *
+   */
+  std::vector<std::pair<cl_event, std::string>> profiled_events_;
+
+  /**
+   * @brief profiler time item of each event name
+   *
+   */
+  std::unordered_map<std::string, int> profile_items_;
+
+  /**
+   * @brief guards profiled_events_ and profile_items_
+   *
+   */
+  std::mutex profile_mutex_;
+
+  /**
+   * @brief Get the queue of the given type
+   *
+   */
+  cl_command_queue GetQueue(QueueType type);
+
+  /**
+   * @brief Keep an event of a finished enqueue call to report its execution
+   * time once it has completed. No-op if profiling is disabled
+   *
+   * @param event event of the command
+   * @param name name reported to the profiler
+   * @param retain true if the caller also owns the event
+   */
+  void TrackEvent(cl_event event, const std::string &name, bool retain);
+
   /**
    * @brief Private constructor to prevent object creation
    *
@@ -153,11 +217,14 @@ public:
    * @param work_group_size Number of work items that make up a work group
    * @param event Object that identifies this command and can be used to query
    * or wait for this command to complete
+   * @param wait_events events the kernel waits for, the rest of the queue is
+   * not waited for
    * @return true if command queue execution is successful or false otherwise
    */
   bool DispatchCommand(Kernel kernel, const int (&work_groups_count)[3],
                        const int (&work_group_size)[3],
-                       cl_event *event = nullptr);
+                       cl_event *event = nullptr,
+                       const std::vector<cl_event> &wait_events = {});
 
   /**
    * @brief Overloaded function to initiate execution of the command queue.
@@ -168,12 +235,87 @@ public:
    * @param work_group_size Number of work items that make up a work group
    * @param event Object that identifies this command and can be used to query
    * or wait for this command to complete
+   * @param wait_events events the kernel waits for, the rest of the queue is
+   * not waited for
    * @return true if command queue execution is successful or false otherwise
    */
   bool DispatchCommand(const std::shared_ptr<Kernel> &kernel_ptr,
                        const int (&work_groups_count)[3],
                        const int (&work_group_size)[3],
-                       cl_event *event = nullptr);
+                       cl_event *event = nullptr,
+                       const std::vector<cl_event> &wait_events = {});
+
+  /**
+   * @brief Asynchronously write a buffer object on the transfer queue
+   * @note @a data must stay valid until @a event has completed
+   *
+   * @param buffer cl_mem buffer object
+   * @param size_in_bytes size of data
+   * @param data to be enqueued into the buffer
+   * @param event event of the write, must be released by the caller
+   * @param wait_events events to complete before the write starts
+   * @return true if enqueuing is successful or false otherwise
+   */
+  bool EnqueueWriteBufferAsync(cl_mem buffer, size_t size_in_bytes,
+                               const void *data, cl_event *event,
+                               const std::vector<cl_event> &wait_events = {});
+
+  /**
+   * @brief Asynchronously read a buffer object on the transfer queue
+   * @note @a data is valid only after @a event has completed
+   *
+   * @param buffer cl_mem buffer object
+   * @param size_in_bytes size of data
+   * @param data getting the data stored in buffer
+   * @param event event of the read, must be released by the caller
+   * @param wait_events events to complete before the read starts
+   * @return true if enqueuing is successful or false otherwise
+   */
+  bool EnqueueReadBufferAsync(cl_mem buffer, size_t size_in_bytes, void *data,
+                              cl_event *event,
+                              const std::vector<cl_event> &wait_events = {});
+
+  /**
+   * @brief Make every command enqueued later on the queue wait for the events
+   *
+   * @param type queue to stall
+   * @param wait_events events to wait for
+   * @return true if enqueuing is successful or false otherwise
+   */
+  bool EnqueueBarrier(QueueType type, const std::vector<cl_event> &wait_events);
+
+  /**
+   * @brief Get an event completing when every command enqueued so far on the
+   * queue has completed
+   *
+   * @param type queue to mark
+   * @param event marker event, must be released by the caller
+   * @return true if enqueuing is successful or false otherwise
+   */
+  bool EnqueueMarker(QueueType type, cl_event *event);
+
+  /**
+   * @brief Block until the events have completed and release them. Null
+   * events are skipped
+   *
+   * @param events events to wait for, cleared on return
+   * @return true if all events have completed successfully or false otherwise
+   */
+  bool WaitForEvents(std::vector<cl_event> &events);
+
+  /**
+   * @brief Block until all previously queued commands have completed
+   *
+   * @return true if all commands have completed or false otherwise
+   */
+  bool Finish();
+
+  /**
+   * @brief Report the device execution time of completed commands to the
+   * profiler. No-op if profiling is disabled
+   *
+   */
+  void ReportProfiledEvents();
 
   /**
    * @brief Get the OpenCL Command Queue object
@@ -92,6 +92,70 @@ void ContextManager::ReleaseContext() {
  */
 const cl_device_id ContextManager::GetDeviceId() { return device_id_; }
 
+/**
+ * @brief Query a string property of a device
+ *
+ * @param device_id OpenCL device id
+ * @param param_name property to query
+ * @return std::string property value, empty if it can not be queried
+ */
+static std::string getDeviceInfoString(cl_device_id device_id,
+                                       cl_device_info param_name) {
+  size_t info_size = 0;
+  cl_int status =
+    clGetDeviceInfo(device_id, param_name, 0, nullptr, &info_size);
+  if (status != CL_SUCCESS || info_size == 0) {
+    ml_loge("clGetDeviceInfo returned %d", status);
+    return "";
+  }
+
+  std::vector<char> info(info_size);
+  status =
+    clGetDeviceInfo(device_id, param_name, info_size, info.data(), nullptr);
+  if (status != CL_SUCCESS) {
+    ml_loge("clGetDeviceInfo returned %d", status);
+    return "";
+  }
+
+  return std::string(info.data());
+}
+
+/**
+ * @brief Get the name of the selected device
+ *
+ * @return std::string device name, empty if it can not be queried
+ */
+std::string ContextManager::GetDeviceName() {
+  return getDeviceInfoString(device_id_, CL_DEVICE_NAME);
+}
+
+/**
+ * @brief Get the version of the OpenCL driver of the selected device
+ *
+ * @return std::string driver version, empty if it can not be queried
+ */
+std::string ContextManager::GetDriverVersion() {
+  return getDeviceInfoString(device_id_, CL_DRIVER_VERSION);
+}
+
+/**
+ * @brief Get the maximum number of work items in a work group
+ *
+ * @return size_t CL_DEVICE_MAX_WORK_GROUP_SIZE, 0 if it can not be queried
+ */
+size_t ContextManager::GetMaxWorkGroupSize() {
+  size_t max_work_group_size = 0;
+  cl_int status =
+    clGetDeviceInfo(device_id_, CL_DEVICE_MAX_WORK_GROUP_SIZE, sizeof(size_t),
+                    &max_work_group_size, nullptr);
+  if (status != CL_SUCCESS) {
+    ml_loge("clGetDeviceInfo returned %d", status);
+    return 0;
+  }
+
+  return max_work_group_size;
+}
+
 /**
  * @brief Destroy the Context Manager object
  *
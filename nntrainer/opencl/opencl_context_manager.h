@@ -15,6 +15,7 @@
 #define __OPENCL_CONTEXT_MANAGER_H__
 
 #include <mutex>
+#include <string>
 
 #include "third_party/cl.h"
 
@@ -78,6 +79,27 @@ public:
    */
   const cl_device_id GetDeviceId();
 
+  /**
+   * @brief Get the name of the selected device
+   *
+   * @return std::string device name, empty if it can not be queried
+   */
+  std::string GetDeviceName();
+
+  /**
+   * @brief Get the version of the OpenCL driver of the selected device
+   *
+   * @return std::string driver version, empty if it can not be queried
+   */
+  std::string GetDriverVersion();
+
+  /**
+   * @brief Get the maximum number of work items in a work group
+   *
+   * @return size_t CL_DEVICE_MAX_WORK_GROUP_SIZE, 0 if it can not be queried
+   */
+  size_t GetMaxWorkGroupSize();
+
   /**
    * @brief Deleting operator overload
    *
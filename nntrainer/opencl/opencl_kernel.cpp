@@ -42,6 +42,7 @@ bool Kernel::CreateKernelFromProgram(Program program,
   }
   // increments the program reference count.
   clRetainProgram(prgm);
+  name_ = function_name;
 
   return true;
 }
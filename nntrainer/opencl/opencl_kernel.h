@@ -28,6 +28,7 @@ namespace nntrainer::opencl {
  */
 class Kernel {
   cl_kernel kernel_{nullptr};
+  std::string name_;
 
 public:
   /**
@@ -57,6 +58,13 @@ public:
    * @return const cl_kernel
    */
   const cl_kernel GetKernel();
+
+  /**
+   * @brief Get the name of the kernel function
+   *
+   * @return const std::string& kernel function name
+   */
+  const std::string &GetName() const { return name_; }
 };
 } // namespace nntrainer::opencl
 #endif // __OPENCL_KERNEL_H__
@@ -169,6 +169,34 @@ typedef cl_int(CL_API_CALL *PFN_clReleaseCommandQueue)(
 
 typedef cl_int(CL_API_CALL *PFN_clReleaseMemObject)(cl_mem /**< memobj */);
 
+typedef cl_int(CL_API_CALL *PFN_clFinish)(
+  cl_command_queue /**< command_queue */);
+
+typedef cl_int(CL_API_CALL *PFN_clFlush)(
+  cl_command_queue /**< command_queue */);
+
+typedef cl_int(CL_API_CALL *PFN_clWaitForEvents)(
+  cl_uint /**< num_events */, const cl_event * /**< event_list */);
+
+typedef cl_int(CL_API_CALL *PFN_clRetainEvent)(cl_event /**< event */);
+
+typedef cl_int(CL_API_CALL *PFN_clReleaseEvent)(cl_event /**< event */);
+
+typedef cl_int(CL_API_CALL *PFN_clGetEventInfo)(
+  cl_event /**< event */, cl_event_info /**< param_name */,
+  size_t /**< param_value_size */, void * /**< param_value */,
+  size_t * /**< param_value_size_ret */);
+
+typedef cl_int(CL_API_CALL *PFN_clEnqueueMarkerWithWaitList)(
+  cl_command_queue /**< command_queue */,
+  cl_uint /**< num_events_in_wait_list */,
+  const cl_event * /**< event_wait_list */, cl_event * /**< event */);
+
+typedef cl_int(CL_API_CALL *PFN_clEnqueueBarrierWithWaitList)(
+  cl_command_queue /**< command_queue */,
+  cl_uint /**< num_events_in_wait_list */,
+  const cl_event * /**< event_wait_list */, cl_event * /**< event */);
+
 extern PFN_clGetPlatformIDs clGetPlatformIDs;
 extern PFN_clGetDeviceIDs clGetDeviceIDs;
 extern PFN_clGetDeviceInfo clGetDeviceInfo;
@@ -196,6 +224,14 @@ extern PFN_clReleaseContext clReleaseContext;
 extern PFN_clRetainCommandQueue clRetainCommandQueue;
 extern PFN_clReleaseCommandQueue clReleaseCommandQueue;
 extern PFN_clReleaseMemObject clReleaseMemObject;
+extern PFN_clFinish clFinish;
+extern PFN_clFlush clFlush;
+extern PFN_clWaitForEvents clWaitForEvents;
+extern PFN_clRetainEvent clRetainEvent;
+extern PFN_clReleaseEvent clReleaseEvent;
+extern PFN_clGetEventInfo clGetEventInfo;
+extern PFN_clEnqueueMarkerWithWaitList clEnqueueMarkerWithWaitList;
+extern PFN_clEnqueueBarrierWithWaitList clEnqueueBarrierWithWaitList;
 
 } // namespace nntrainer::opencl
 
@@ -35,12 +35,10 @@ const std::string Program::DEFAULT_KERNEL_PATH = stringify(OPENCL_KERNEL_PATH);
  *
  * @param device_id OpenCL device id
  * @param compiler_options string compiler options
- * @param binaryCreated true if binary is already present false otherwise
  * @return true if successful or false otherwise
  */
 bool Program::BuildProgram(cl_device_id device_id,
-                           const std::string &compiler_options,
-                           bool binaryCreated) {
+                           const std::string &compiler_options) {
   // clBuildProgram returns NULL with error code if fails
   const int error_code = clBuildProgram(
     program_, 0, nullptr, compiler_options.c_str(), nullptr, nullptr);
@@ -51,117 +49,42 @@ bool Program::BuildProgram(cl_device_id device_id,
     return false;
   }
 
-  // saving kernel binary
-  /// @note: Temporary disabled due to failing
-  // if (!binaryCreated)
-  //   return GetProgramInfo(device_id);
-
   return true;
 }
 
 /**
- * @brief Utility to get program info and save kernel binaries
+ * @brief Get the device binary of the built program
  *
  * @param device_id OpenCL device id
+ * @param binary output buffer for the binary
  * @return true if successful or false otherwise
  */
-bool Program::GetProgramInfo(cl_device_id device_id) {
+bool Program::GetProgramBinary(cl_device_id device_id,
+                               std::vector<unsigned char> &binary) {
   // since only one GPU is being used
-  unsigned int num_devices = 1;
-
-  cl_int error_code = CL_SUCCESS;
-
-  // Read the binary size
-  std::vector<size_t> binaries_size(num_devices);
-  error_code = clGetProgramInfo(program_, CL_PROGRAM_BINARY_SIZES,
-                                sizeof(size_t) * num_devices,
-                                binaries_size.data(), nullptr);
-
-  if (error_code != CL_SUCCESS) {
+  size_t binary_size = 0;
+  cl_int error_code =
+    clGetProgramInfo(program_, CL_PROGRAM_BINARY_SIZES, sizeof(size_t),
+                     &binary_size, nullptr);
+  if (error_code != CL_SUCCESS || binary_size == 0) {
     ml_loge("Failed to get program binary size. OpenCL error code: %d. %s",
             error_code,
             (GetProgramBuildInfo(device_id, CL_PROGRAM_BUILD_LOG)).c_str());
     return false;
   }
 
-  // Read the kernel name size
-  size_t kernel_names_size;
-  error_code = clGetProgramInfo(program_, CL_PROGRAM_KERNEL_NAMES, 0, nullptr,
-                                &kernel_names_size);
-
-  if (error_code != CL_SUCCESS) {
-    ml_loge("Failed to get program kernel name size. OpenCL error code: %d. %s",
-            error_code,
-            (GetProgramBuildInfo(device_id, CL_PROGRAM_BUILD_LOG)).c_str());
-    return false;
-  }
-
-  // getting the kernel names
-  std::vector<char> kernel_names(kernel_names_size);
-  error_code =
-    clGetProgramInfo(program_, CL_PROGRAM_KERNEL_NAMES, kernel_names_size,
-                     kernel_names.data(), nullptr);
-
-  if (error_code != CL_SUCCESS) {
-    ml_loge("Failed to get program kernel names. OpenCL error code: %d. %s",
-            error_code,
-            (GetProgramBuildInfo(device_id, CL_PROGRAM_BUILD_LOG)).c_str());
-    return false;
-  } else {
-    ml_logi("Saving kernel binary for: %s",
-            std::string(kernel_names.data()).c_str());
-  }
-
-  // Read the binary
-  size_t binaries_ptr_alloc_size = sizeof(unsigned char *) * num_devices;
-  std::vector<unsigned char *> binaries_ptr(num_devices);
-
-  for (unsigned int i = 0; i < num_devices; ++i) {
-    binaries_ptr[i] = new unsigned char[binaries_size[i]];
-  }
-
-  error_code =
-    clGetProgramInfo(program_, CL_PROGRAM_BINARIES, binaries_ptr_alloc_size,
-                     binaries_ptr.data(), nullptr);
-
+  binary.resize(binary_size);
+  unsigned char *binary_ptr = binary.data();
+  error_code = clGetProgramInfo(program_, CL_PROGRAM_BINARIES,
+                                sizeof(unsigned char *), &binary_ptr, nullptr);
   if (error_code != CL_SUCCESS) {
     ml_loge("Failed to get program binary data. OpenCL error code: %d. %s",
             error_code,
             (GetProgramBuildInfo(device_id, CL_PROGRAM_BUILD_LOG)).c_str());
-
-    // cleanup
-    for (unsigned int i = 0; i < num_devices; ++i) {
-      delete[] binaries_ptr[i];
-    }
+    binary.clear();
     return false;
   }
 
-  // Write the binary to file
-  // All kernels in the program will be saved in the binary file
-  for (unsigned int i = 0; i < num_devices; ++i) {
-    std::ofstream fs(Program::DEFAULT_KERNEL_PATH + "/" +
-                       std::string(kernel_names.data()) + "_kernel.bin",
-                     std::ios::out | std::ios::binary | std::ios::app);
-    if (!fs) {
-      ml_loge(
-        "opencl_program: could not find directory to save kernel binary - %s",
-        Program::DEFAULT_KERNEL_PATH.c_str());
-
-      // cleanup
-      for (unsigned int i = 0; i < num_devices; ++i) {
-        delete[] binaries_ptr[i];
-      }
-      return false;
-    }
-    fs.write((char *)binaries_ptr[i], binaries_size[i]);
-    fs.close();
-  }
-
-  // cleanup
-  for (unsigned int i = 0; i < num_devices; ++i) {
-    delete[] binaries_ptr[i];
-  }
-
   return true;
 }
 
@@ -256,7 +179,7 @@ bool Program::CreateCLProgramWithBinary(const cl_context &context,
 
   ml_logi("Loaded program from binary for: %s", binary_name.c_str());
 
-  return BuildProgram(device_id, compiler_options, true);
+  return BuildProgram(device_id, compiler_options);
 }
 
 /**
@@ -15,6 +15,7 @@
 #define __OPENCL_PROGRAM_H__
 
 #include <string>
+#include <vector>
 
 #include "third_party/cl.h"
 
@@ -33,19 +34,10 @@ class Program {
    *
    * @param device_id OpenCL device id
    * @param compiler_options string compiler options
-   * @param binaryCreated true if binary is already present false otherwise
    * @return true if successful or false otherwise
    */
-  bool BuildProgram(cl_device_id device_id, const std::string &compiler_options,
-                    bool binaryCreated = false);
-
-  /**
-   * @brief Utility to get program info and save kernel binaries
-   *
-   * @param device_id OpenCL device id
-   * @return true if successful or false otherwise
-   */
-  bool GetProgramInfo(cl_device_id device_id);
+  bool BuildProgram(cl_device_id device_id,
+                    const std::string &compiler_options);
 
   /**
    * @brief Get the information on the program build
@@ -89,6 +81,16 @@ public:
                                  unsigned char *binary, std::string binary_name,
                                  const std::string &compiler_options);
 
+  /**
+   * @brief Get the device binary of the built program
+   *
+   * @param device_id OpenCL device id
+   * @param binary output buffer for the binary
+   * @return true if successful or false otherwise
+   */
+  bool GetProgramBinary(cl_device_id device_id,
+                        std::vector<unsigned char> &binary);
+
   /**
    * @brief Get the Program object
    *
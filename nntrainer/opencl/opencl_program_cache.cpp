@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file    opencl_program_cache.cpp
+ * @date    18 Oct 2026
+ * @see     https://github.com/nnstreamer/nntrainer
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ * @brief   On-disk cache of OpenCL program binaries
+ *
+ */
+
+#include "opencl_program_cache.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include "opencl_context_manager.h"
+
+#include <nntrainer_log.h>
+
+namespace nntrainer::opencl {
+
+namespace {
+
+/** magic of the entry header */
+constexpr char CACHE_MAGIC[8] = {'N', 'N', 'T', 'R', 'C', 'L', 'B', '\0'};
+
+/** format version of the entry, bump when the layout changes */
+constexpr uint32_t CACHE_FORMAT_VERSION = 1;
+
+/**
+ * @brief 64 bit FNV-1a hash, stable across runs and platforms
+ */
+uint64_t fnv1a64(const void *data, size_t size) {
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+/**
+ * @brief hex string of a 64 bit value
+ */
+std::string toHex(uint64_t value) {
+  char buf[17];
+  std::snprintf(buf, sizeof(buf), "%016llx",
+                static_cast<unsigned long long>(value));
+  return std::string(buf);
+}
+
+} // namespace
+
+ProgramCache::ProgramCache(const std::string &cache_dir) :
+  cache_dir_(cache_dir) {}
+
+std::string ProgramCache::MakeIdentity(const std::string &code,
+                                       const std::string &compiler_options) {
+  ContextManager &context_manager = ContextManager::GetInstance();
+
+  std::stringstream ss;
+  ss << "device=" << context_manager.GetDeviceName()
+     << ";driver=" << context_manager.GetDriverVersion()
+     << ";options=" << compiler_options
+     << ";source=" << toHex(fnv1a64(code.data(), code.size()));
+  return ss.str();
+}
+
+std::string ProgramCache::GetEntryPath(const std::string &kernel_name,
+                                       const std::string &identity) const {
+  return cache_dir_ + "/" + kernel_name + "_" +
+         toHex(fnv1a64(identity.data(), identity.size())) + ".bin";
+}
+
+bool ProgramCache::Load(const std::string &kernel_name,
+                        const std::string &identity,
+                        std::vector<unsigned char> &binary) const {
+  if (!IsEnabled())
+    return false;
+
+  const std::string path = GetEntryPath(kernel_name, identity);
+  std::ifstream fs(path, std::ios::binary | std::ios::in);
+  if (!fs.good())
+    return false;
+
+  char magic[sizeof(CACHE_MAGIC)];
+  uint32_t version = 0;
+  uint64_t identity_size = 0;
+  fs.read(magic, sizeof(magic));
+  fs.read(reinterpret_cast<char *>(&version), sizeof(version));
+  fs.read(reinterpret_cast<char *>(&identity_size), sizeof(identity_size));
+  if (!fs.good() || std::memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 ||
+      version != CACHE_FORMAT_VERSION || identity_size != identity.size()) {
+    ml_logw("opencl_program_cache: invalid header, ignoring %s", path.c_str());
+    return false;
+  }
+
+  std::string stored_identity(identity_size, '\0');
+  fs.read(&stored_identity[0], identity_size);
+  if (!fs.good() || stored_identity != identity) {
+    ml_logw("opencl_program_cache: identity mismatch, ignoring %s",
+            path.c_str());
+    return false;
+  }
+
+  uint64_t binary_size = 0;
+  uint64_t checksum = 0;
+  fs.read(reinterpret_cast<char *>(&binary_size), sizeof(binary_size));
+  fs.read(reinterpret_cast<char *>(&checksum), sizeof(checksum));
+  if (!fs.good() || binary_size == 0) {
+    ml_logw("opencl_program_cache: truncated entry, ignoring %s",
+            path.c_str());
+    return false;
+  }
+
+  binary.resize(binary_size);
+  fs.read(reinterpret_cast<char *>(binary.data()), binary_size);
+  if (static_cast<uint64_t>(fs.gcount()) != binary_size ||
+      fnv1a64(binary.data(), binary.size()) != checksum) {
+    ml_logw("opencl_program_cache: corrupted binary, ignoring %s",
+            path.c_str());
+    binary.clear();
+    return false;
+  }
+
+  ml_logi("opencl_program_cache: loaded %s", path.c_str());
+  return true;
+}
+
+bool ProgramCache::Store(const std::string &kernel_name,
+                         const std::string &identity,
+                         const std::vector<unsigned char> &binary) const {
+  if (!IsEnabled() || binary.empty())
+    return false;
+
+  std::error_code ec;
+  std::filesystem::create_directories(cache_dir_, ec);
+  if (ec) {
+    ml_loge("opencl_program_cache: could not create directory %s - %s",
+            cache_dir_.c_str(), ec.message().c_str());
+    return false;
+  }
+
+  const std::string path = GetEntryPath(kernel_name, identity);
+
+  // unique temporary name so that concurrent writers do not interleave, the
+  // pid keeps the processes sharing the cache directory apart
+  std::stringstream tmp_ss;
+  tmp_ss << path << ".tmp." << getpid() << "."
+         << std::hash<std::thread::id>{}(std::this_thread::get_id()) << "."
+         << reinterpret_cast<uintptr_t>(&binary);
+  const std::string tmp_path = tmp_ss.str();
+
+  {
+    std::ofstream fs(tmp_path,
+                     std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!fs) {
+      ml_loge("opencl_program_cache: could not write %s", tmp_path.c_str());
+      return false;
+    }
+
+    const uint32_t version = CACHE_FORMAT_VERSION;
+    const uint64_t identity_size = identity.size();
+    const uint64_t binary_size = binary.size();
+    const uint64_t checksum = fnv1a64(binary.data(), binary.size());
+
+    fs.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    fs.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    fs.write(reinterpret_cast<const char *>(&identity_size),
+             sizeof(identity_size));
+    fs.write(identity.data(), identity.size());
+    fs.write(reinterpret_cast<const char *>(&binary_size),
+             sizeof(binary_size));
+    fs.write(reinterpret_cast<const char *>(&checksum), sizeof(checksum));
+    fs.write(reinterpret_cast<const char *>(binary.data()), binary.size());
+
+    if (!fs.good()) {
+      fs.close();
+      std::remove(tmp_path.c_str());
+      ml_loge("opencl_program_cache: failed writing %s", tmp_path.c_str());
+      return false;
+    }
+  }
+
+  // rename is atomic within a file system, readers see old or new entry
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    std::remove(tmp_path.c_str());
+    ml_loge("opencl_program_cache: could not replace %s - %s", path.c_str(),
+            ec.message().c_str());
+    return false;
+  }
+
+  ml_logi("opencl_program_cache: saved %s", path.c_str());
+  return true;
+}
+
+} // namespace nntrainer::opencl
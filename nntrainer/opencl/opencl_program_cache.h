@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file    opencl_program_cache.h
+ * @date    18 Oct 2026
+ * @see     https://github.com/nnstreamer/nntrainer
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ * @brief   On-disk cache of OpenCL program binaries
+ *
+ */
+
+#ifndef __OPENCL_PROGRAM_CACHE_H__
+#define __OPENCL_PROGRAM_CACHE_H__
+
+#include <string>
+#include <vector>
+
+namespace nntrainer::opencl {
+
+/**
+ * @class ProgramCache contains helpers to save and load program binaries
+ * @brief On-disk program binary cache
+ *
+ * Every entry is identified by the device name, driver version, build options
+ * and a hash of the kernel source, so a binary is never reused for another
+ * device, driver, configuration or kernel revision. Entries carry a header
+ * that is validated on load, and are written to a temporary file that is
+ * renamed into place so that readers never observe a partial entry.
+ */
+class ProgramCache {
+public:
+  /**
+   * @brief Construct a new Program Cache object
+   *
+   * @param cache_dir directory of the cache, caching is disabled if empty
+   */
+  explicit ProgramCache(const std::string &cache_dir);
+
+  /**
+   * @brief Create the identity of a program built for the current device
+   *
+   * @param code kernel source code string
+   * @param compiler_options string compiler options
+   * @return std::string identity of the cache entry
+   */
+  static std::string MakeIdentity(const std::string &code,
+                                  const std::string &compiler_options);
+
+  /**
+   * @brief Load a cached program binary
+   *
+   * @param kernel_name name of the kernel for the file name
+   * @param identity identity created by MakeIdentity
+   * @param binary output buffer for the binary
+   * @return true if a valid entry is found or false otherwise
+   */
+  bool Load(const std::string &kernel_name, const std::string &identity,
+            std::vector<unsigned char> &binary) const;
+
+  /**
+   * @brief Store a program binary, replacing the entry atomically
+   *
+   * @param kernel_name name of the kernel for the file name
+   * @param identity identity created by MakeIdentity
+   * @param binary program binary
+   * @return true if successful or false otherwise
+   */
+  bool Store(const std::string &kernel_name, const std::string &identity,
+             const std::vector<unsigned char> &binary) const;
+
+  /**
+   * @brief Get the path of the entry file
+   *
+   * @param kernel_name name of the kernel
+   * @param identity identity created by MakeIdentity
+   * @return std::string path of the entry
+   */
+  std::string GetEntryPath(const std::string &kernel_name,
+                           const std::string &identity) const;
+
+  /**
+   * @brief Check if caching is enabled
+   *
+   * @return true if a cache directory is set
+   */
+  bool IsEnabled() const { return !cache_dir_.empty(); }
+
+private:
+  std::string cache_dir_;
+};
+
+} // namespace nntrainer::opencl
+
+#endif // __OPENCL_PROGRAM_CACHE_H__
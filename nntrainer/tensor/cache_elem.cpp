@@ -17,6 +17,7 @@
 #include <vector>
 
 #include <profiler.h>
+#include <runtime_metrics.h>
 
 namespace nntrainer {
 
@@ -49,9 +50,13 @@ inline bool checkDeallocOnly(CachePolicy policy, CacheElem::Options opt) {
 
 } // namespace
 
-void CacheElem::swapIn(Options opt) {
+bool CacheElem::swapIn(Options opt) {
   std::lock_guard<std::mutex> lock(device_mutex);
 
+  /** several loaders may request the same element concurrently */
+  if (active)
+    return false;
+
   opt = static_cast<Options>(opt | initial_opt);
   bool alloc_only = checkAllocOnly(policy, opt);
 
@@ -61,11 +66,13 @@ void CacheElem::swapIn(Options opt) {
   mem_data->setAddr((void *)buf);
   mem_data->setValid(true);
   active = true;
+  RuntimeCounters::Global().add(RuntimeCounters::CACHE_POOL_BYTES, length);
 #ifdef PROFILE
   std::string msg("CacheElem(");
   msg += device->getDevicePath() + ") #" + std::to_string(id);
   PROFILE_CACHE_ALLOC(buf, length, msg, policyToStr[policy], !alloc_only);
 #endif
+  return true;
 }
 
 void CacheElem::swapOut(Options opt) {
@@ -75,10 +82,11 @@ void CacheElem::swapOut(Options opt) {
   bool dealloc_only = checkDeallocOnly(policy, opt);
   void *buf = (void *)mem_data->getAddr();
   initial_opt = static_cast<Options>(initial_opt & ~Options::FIRST_WRITE);
-  device->putBuffer(buf, dealloc_only);
+  device->putBuffer(buf, dealloc_only, codec);
   mem_data->setAddr(nullptr);
   mem_data->setValid(false);
   active = false;
+  RuntimeCounters::Global().sub(RuntimeCounters::CACHE_POOL_BYTES, length);
 
 #ifdef PROFILE
   PROFILE_CACHE_DEALLOC(buf, policyToStr[policy], !dealloc_only);
@@ -63,7 +63,8 @@ public:
   explicit CacheElem(std::shared_ptr<SwapDevice> dev, unsigned int mem_id,
                      size_t off, size_t len, std::shared_ptr<MemoryData> data,
                      CachePolicy pol = CachePolicy::ALWAYS_SYNCED,
-                     void *ptr = nullptr) :
+                     void *ptr = nullptr,
+                     SwapCodec swap_codec = SwapCodec::NONE) :
     initial_opt(Options::FIRST_ACCESS_WRITE),
     device(dev),
     active(false),
@@ -72,7 +73,8 @@ public:
     length(len),
     policy(pol),
     mem_data(data),
-    memory_ptr(ptr) {}
+    memory_ptr(ptr),
+    codec(swap_codec) {}
 
   /**
    * @brief CacheElem destructor
@@ -84,8 +86,9 @@ public:
    * @brief load data from swap device
    *
    * @param alloc_only only allocate buffer without reading data
+   * @return true if loaded, false if the element is already active
    */
-  void swapIn(Options opt = Options::NONE);
+  bool swapIn(Options opt = Options::NONE);
 
   /**
    * @brief unload data to swap device
@@ -135,6 +138,7 @@ private:
   CachePolicy policy;                   /**< cache policy */
   std::shared_ptr<MemoryData> mem_data; /**< allocated memory data */
   void *memory_ptr;
+  SwapCodec codec; /**< codec to store the data in the swap device */
 };
 
 } // namespace nntrainer
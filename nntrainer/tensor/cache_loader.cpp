@@ -16,19 +16,36 @@
 #include "task_executor.h"
 
 #include <cache_pool.h>
+#include <chrono>
 #include <climits>
 #include <cstdint>
 #include <exception>
 #include <memory>
 #include <nntrainer_error.h>
 #include <nntrainer_log.h>
+#include <profiler.h>
+#include <thread>
 
 namespace nntrainer {
 
-CacheLoader::CacheLoader(std::shared_ptr<CachePool> cache_pool) :
+namespace {
+
+/** upper bound of the default number of load threads */
+constexpr unsigned int MAX_DEFAULT_LOAD_WORKERS = 4;
+
+} // namespace
+
+CacheLoader::CacheLoader(std::shared_ptr<CachePool> cache_pool,
+                         unsigned int num_load_workers_) :
   pool(cache_pool),
+  num_load_workers(num_load_workers_),
   load_task_executor(nullptr),
-  unload_task_executor(nullptr) {}
+  unload_task_executor(nullptr),
+  load_time_us(0) {
+  PROFILE_TIME_REGISTER_EVENT(load_event_key, "cache_load:" + pool->getName());
+  PROFILE_TIME_REGISTER_EVENT(unload_event_key,
+                              "cache_unload:" + pool->getName());
+}
 
 CacheLoader::~CacheLoader() {
   if (load_task_executor)
@@ -39,8 +56,20 @@ CacheLoader::~CacheLoader() {
 
 void CacheLoader::init() {
 
+  if (num_load_workers == 0) {
+    /**
+     * Inference maps the weights in the order they are requested, so it keeps
+     * a single loader. Training loads the execution orders in parallel.
+     */
+    num_load_workers = 1;
+    if (pool->getExecMode() == ml::train::ExecutionMode::TRAIN)
+      num_load_workers =
+        std::clamp(std::thread::hardware_concurrency(), 1u,
+                   MAX_DEFAULT_LOAD_WORKERS);
+  }
+
   if (load_task_executor == nullptr)
-    load_task_executor = new TaskExecutor(pool->getName());
+    load_task_executor = new TaskExecutor(pool->getName(), num_load_workers);
   if (unload_task_executor == nullptr)
     unload_task_executor = new TaskExecutor(pool->getName());
 }
@@ -52,7 +81,11 @@ void CacheLoader::finish() {
   unload_task_executor = nullptr;
 }
 
-void CacheLoader::load(unsigned int order) { pool->loadExec(order); }
+void CacheLoader::load(unsigned int order) {
+  PROFILE_TIME_START(load_event_key);
+  pool->loadExec(order);
+  PROFILE_TIME_END(load_event_key);
+}
 
 int CacheLoader::loadAsync(unsigned int order,
                            TaskExecutor::CompleteCallback complete) {
@@ -61,7 +94,7 @@ int CacheLoader::loadAsync(unsigned int order,
 
 int CacheLoader::loadAsync(unsigned int order,
                            TaskExecutor::CompleteCallback complete,
-                           long timeout_ms) {
+                           long timeout_ms, TaskAsync<>::Priority priority) {
   if (!load_task_executor) {
     ml_loge("init is needed");
     return ML_ERROR_INVALID_PARAMETER;
@@ -71,7 +104,13 @@ int CacheLoader::loadAsync(unsigned int order,
     unsigned int exe_order = (unsigned int)(std::uintptr_t)data;
 
     // pool->flushExcept({exe_order - 1, exe_order});
+    auto start = std::chrono::steady_clock::now();
+    PROFILE_TIME_START(load_event_key);
     pool->loadExec(exe_order);
+    PROFILE_TIME_END(load_event_key);
+    updateLoadTime(std::chrono::duration_cast<std::chrono::microseconds>(
+                     std::chrono::steady_clock::now() - start)
+                     .count());
 
     return ML_ERROR_NONE;
   };
@@ -79,6 +118,7 @@ int CacheLoader::loadAsync(unsigned int order,
   auto task =
     std::make_shared<TaskAsync<>>(work, (void *)(std::uintptr_t)order);
   task->setTimeout(timeout_ms);
+  task->setPriority(priority);
 
   return load_task_executor->run(task, complete);
 }
@@ -100,7 +140,9 @@ int CacheLoader::flushAsync(unsigned int order,
     unsigned int exe_order = (unsigned int)(std::uintptr_t)data;
 
     // pool->flushExcept({exe_order - 1, exe_order});
+    PROFILE_TIME_START(unload_event_key);
     pool->flushExcept(exe_order);
+    PROFILE_TIME_END(unload_event_key);
 
     return ML_ERROR_NONE;
   };
@@ -128,4 +170,13 @@ unsigned int CacheLoader::getNumLoadedTensors() {
   return pool->getNumLoadedTensors();
 }
 
+int64_t CacheLoader::getAverageLoadTime() const { return load_time_us.load(); }
+
+void CacheLoader::updateLoadTime(int64_t us) {
+  /** exponential moving average with 1/8 weight, concurrent updates may
+   * drop a sample which is fine for an estimate */
+  int64_t prev = load_time_us.load();
+  load_time_us.store(prev == 0 ? us : prev + (us - prev) / 8);
+}
+
 } // namespace nntrainer
@@ -34,8 +34,12 @@ public:
   /**
    * @brief CacheLoader default constructor
    *
+   * @param cache_pool cache pool to load
+   * @param num_load_workers number of threads loading concurrently, 0 to
+   * decide by the execution mode of the pool
    */
-  explicit CacheLoader(std::shared_ptr<CachePool> cache_pool);
+  explicit CacheLoader(std::shared_ptr<CachePool> cache_pool,
+                       unsigned int num_load_workers = 0);
 
   /**
    * @brief CacheLoader destructor
@@ -77,12 +81,14 @@ public:
    * @param order execution order
    * @param complete complete callback
    * @param timeout timeout time in ms
+   * @param priority priority among the queued loads
    * @return async task id
    * @note timeout_ms does not work now.
    */
-  virtual int loadAsync(unsigned int order,
-                        TaskExecutor::CompleteCallback callback,
-                        long timeout_ms);
+  virtual int
+  loadAsync(unsigned int order, TaskExecutor::CompleteCallback callback,
+            long timeout_ms,
+            TaskAsync<>::Priority priority = TaskAsync<>::Priority::MID);
 
   /**
    * @brief Load cache data asynchronously with execution order
@@ -122,10 +128,31 @@ public:
    */
   virtual unsigned int getNumLoadedTensors();
 
+  /**
+   * @brief Get the average time to load the data of an execution order
+   *
+   * @return moving average in microseconds, 0 if nothing is loaded yet
+   */
+  virtual int64_t getAverageLoadTime() const;
+
 private:
+  /**
+   * @brief Add a load time to the moving average
+   *
+   * @param us load time in microseconds
+   */
+  void updateLoadTime(int64_t us);
+
   std::shared_ptr<CachePool> pool; /**< cache pool */
+  unsigned int num_load_workers;      /**< number of load threads */
   TaskExecutor *load_task_executor;   /**< task executor */
   TaskExecutor *unload_task_executor; /**< task executor */
+  std::atomic<int64_t> load_time_us;  /**< moving average of load time */
+
+#ifdef PROFILE
+  int load_event_key;   /**< profile key of the loads */
+  int unload_event_key; /**< profile key of the unloads */
+#endif
 };
 
 } // namespace nntrainer
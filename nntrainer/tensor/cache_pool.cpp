@@ -160,17 +160,61 @@ void CachePool::deallocate() {
 }
 
 void CachePool::validate(unsigned int id) {
-  if (!elems[id]->isActive()) {
-    elems[id]->swapIn();
-    actives.push_back(elems[id]);
+  auto &elem = elems.at(id);
+
+  /** the element is marked in flight under the lock and loaded without it, so
+   * that loaders of different elements overlap their I/O */
+  {
+    std::unique_lock lock(mod_mutex);
+    in_flight_cv.wait(lock, [&] { return in_flight.count(id) == 0; });
+    if (elem->isActive())
+      return;
+    in_flight.insert(id);
   }
+
+  bool loaded = false;
+  try {
+    loaded = loadElem(id);
+  } catch (...) {
+    finishInFlight(id, nullptr);
+    throw;
+  }
+  finishInFlight(id, loaded ? elem : nullptr);
 }
 
 void CachePool::invalidate(unsigned int id) {
-  if (elems[id]->isActive()) {
-    actives.remove(elems[id]);
-    elems[id]->swapOut();
+  auto &elem = elems[id];
+
+  /** an element being loaded is unloaded once its load is done */
+  {
+    std::unique_lock lock(mod_mutex);
+    in_flight_cv.wait(lock, [&] { return in_flight.count(id) == 0; });
+    if (!elem->isActive())
+      return;
+    actives.remove(elem);
+    in_flight.insert(id);
+  }
+
+  try {
+    elem->swapOut();
+  } catch (...) {
+    finishInFlight(id, nullptr);
+    throw;
+  }
+  finishInFlight(id, nullptr);
+}
+
+bool CachePool::loadElem(unsigned int id) { return elems.at(id)->swapIn(); }
+
+void CachePool::finishInFlight(unsigned int id,
+                               const std::shared_ptr<CacheElem> &loaded) {
+  {
+    std::scoped_lock lock(mod_mutex);
+    in_flight.erase(id);
+    if (loaded)
+      actives.push_back(loaded);
   }
+  in_flight_cv.notify_all();
 }
 
 unsigned int CachePool::requestMemory(size_t bytes, unsigned int start_time,
@@ -183,6 +227,7 @@ unsigned int CachePool::requestMemory(size_t bytes, unsigned int start_time,
   const CachePolicy policy = convertTensorLifespanToCachePolicy(lifespan);
 
   policies.push_back(policy);
+  lifespans.push_back(lifespan);
 
   NNTR_THROW_IF(id != policies.size(), std::runtime_error)
     << "Invalid requqestMemory call exist";
@@ -207,8 +252,13 @@ std::shared_ptr<MemoryData> CachePool::getMemory(unsigned int id) {
     memory_ptr = getMemoryPtrs().at(id - 1);
   }
 
+  SwapCodec codec = SwapCodec::NONE;
+  if (auto found = swap_codecs.find(lifespans.at(id - 1));
+      found != swap_codecs.end())
+    codec = found->second;
+
   auto elem = std::make_shared<CacheElem>(swap_device, id, offset, len,
-                                          mem_data, policy, memory_ptr);
+                                          mem_data, policy, memory_ptr, codec);
   elems[id] = elem;
 
   std::string ords;
@@ -224,6 +274,8 @@ std::shared_ptr<MemoryData> CachePool::getMemory(unsigned int id) {
 }
 
 void CachePool::flush() {
+  std::unique_lock lock(mod_mutex);
+  in_flight_cv.wait(lock, [&] { return in_flight.empty(); });
   for (auto &elem : actives) {
     elem->swapOut(CacheElem::LAST_ACCESS);
   }
@@ -237,6 +289,7 @@ void CachePool::flush() {
 void CachePool::flushExcept(unsigned int order) {
   auto exe_orders = getMemoryExecOrder();
 
+  std::scoped_lock lock(mod_mutex);
   actives.remove_if([&, order](auto elem) -> bool {
     auto id = elem->getId();
     auto exe_order = exe_orders.at(id - 1);
@@ -261,6 +314,7 @@ void CachePool::flushExcept(unsigned int order) {
 void CachePool::flushExcept(std::vector<unsigned int> order) {
   auto exe_orders = getMemoryExecOrder();
 
+  std::scoped_lock lock(mod_mutex);
   actives.remove_if([&, order](const auto elem) -> bool {
     auto id = elem->getId();
     auto exe_order = exe_orders.at(id - 1);
@@ -287,13 +341,19 @@ void CachePool::clear() {
   flush();
   deallocate();
   policies.clear();
+  lifespans.clear();
   MemoryPool::clear();
 }
 
 bool CachePool::isAllocated() const { return swap_device->isOperating(); }
 
 void CachePool::loadExec(unsigned int order) {
-  for (auto &id : exec_ids[order])
+  /** find() as loaders of different orders may run concurrently */
+  auto found = exec_ids.find(order);
+  if (found == exec_ids.end())
+    return;
+
+  for (auto &id : found->second)
     validate(id);
 }
 
@@ -320,6 +380,7 @@ void CachePool::unloadExec(unsigned int order) {
 void CachePool::loadActives() {
   ml_logd("load active caches");
 
+  std::scoped_lock lock(mod_mutex);
   for (auto &elem : actives)
     elem->swapIn();
 }
@@ -327,6 +388,7 @@ void CachePool::loadActives() {
 void CachePool::unloadActives() {
   ml_logd("unload active caches");
 
+  std::scoped_lock lock(mod_mutex);
   for (auto &elem : actives)
     elem->swapOut();
 }
@@ -14,8 +14,10 @@
 #ifndef __CACHE_POOL_H__
 #define __CACHE_POOL_H__
 
+#include <condition_variable>
 #include <list>
 #include <mutex>
+#include <unordered_set>
 #include <vector>
 
 #include <cache_elem.h>
@@ -200,6 +202,25 @@ public:
     swap_device->setWeightOffset(offsets);
   }
 
+  /**
+   * @brief set the codec of the swapped data per tensor lifespan
+   *
+   * @param codecs codec of each lifespan, others are stored as is
+   * @note applies to the memory created by getMemory() afterwards
+   */
+  void setSwapCompression(const SwapCompressor::CodecMap &codecs) override {
+    swap_codecs = codecs;
+  }
+
+  /**
+   * @brief Get the statistics of the compressed swap data
+   *
+   * @return statistics of the swap device
+   */
+  SwapDevice::CompressionStats getCompressionStats() {
+    return swap_device->getCompressionStats();
+  }
+
 protected:
   /**
    * @brief validate cache element
@@ -215,6 +236,15 @@ protected:
    */
   virtual void invalidate(unsigned int id);
 
+  /**
+   * @brief load the data of a cache element, which runs without the lock of
+   * the pool
+   *
+   * @param id cache element id
+   * @return true if loaded, false if the element is already active
+   */
+  virtual bool loadElem(unsigned int id);
+
   /**
    * @brief Get cache policies
    *
@@ -223,15 +253,28 @@ protected:
   std::vector<CachePolicy> &getCachePolicy() { return policies; }
 
 private:
+  /**
+   * @brief end the load or unload of an element in flight
+   *
+   * @param id cache element id
+   * @param loaded the element to register as active, or nullptr
+   */
+  void finishInFlight(unsigned int id,
+                      const std::shared_ptr<CacheElem> &loaded);
+
   std::string name;                         /**< pool name */
   ml::train::ExecutionMode execution_mode_; /**< execution mode */
   std::shared_ptr<SwapDevice> swap_device;  /**< swap device */
   CacheElems elems;                         /**< cache elements */
   std::list<std::shared_ptr<CacheElem>> actives;
   std::vector<CachePolicy> policies;
+  std::vector<TensorLifespan> lifespans;  /**< lifespan of each memory */
+  SwapCompressor::CodecMap swap_codecs; /**< codec of each lifespan */
   std::unordered_map<unsigned int, ExecIds> exec_ids;
 
   std::mutex mod_mutex;
+  std::unordered_set<unsigned int> in_flight; /**< ids loaded or unloaded */
+  std::condition_variable in_flight_cv; /**< notified at the end of those */
 };
 
 } // namespace nntrainer
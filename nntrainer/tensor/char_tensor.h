@@ -236,6 +236,13 @@ public:
    */
   void copy_with_stride(const Tensor &input, Tensor &output) override;
 
+  /**
+   * @copydoc Tensor::transpose(const std::string &direction, Tensor &out)
+   * @note only per tensor quantized tensors can be transposed
+   */
+  Tensor &transpose(const std::string &direction,
+                    Tensor &output) const override;
+
   /**
    * @copydoc Tensor::save(std::ostream &file)
    */
@@ -13,6 +13,7 @@
 
 #include <blas_kernel_interface.h>
 #include <blas_kernels.h>
+#include <cl_buffer_manager.h>
 
 namespace nntrainer {
 void dotBatchedCl(Tensor const &input, Tensor const &m, Tensor &result,
@@ -20,6 +21,57 @@ void dotBatchedCl(Tensor const &input, Tensor const &m, Tensor &result,
   if (!result.isAllocated())
     throw std::invalid_argument(
       "Output tensor must be preallocated for dotBatched operation");
+
+  /// per batch matrices of the operands, rows x cols
+  auto rows = [](Tensor const &t) {
+    return t.getFormat() == Tformat::NHWC ? t.height() * t.width()
+                                          : t.channel() * t.height();
+  };
+  auto cols = [](Tensor const &t) {
+    return t.getFormat() == Tformat::NHWC ? t.channel() : t.width();
+  };
+
+  unsigned int M = trans ? cols(input) : rows(input);
+  unsigned int K = trans ? rows(input) : cols(input);
+  unsigned int N = trans_m ? rows(m) : cols(m);
+  unsigned int m_K = trans_m ? cols(m) : rows(m);
+
+  /// every product of the batch runs in one dispatch of the tiled kernel when
+  /// it is a real matrix product; vector shaped ones keep the gemv paths
+  bool batched = input.getDataType() == m.getDataType() &&
+                 input.getDataType() == result.getDataType() &&
+                 input.getFormat() == m.getFormat() && K == m_K && M > 1 &&
+                 N > 1 && (m.batch() == input.batch() || m.batch() == 1) &&
+                 result.batch() == input.batch() &&
+                 result.getDim().getFeatureLen() == M * N;
+
+  /// all the operands of the batch have to fit the device buffers at once
+  const size_t capacity = ClBufferManager::getInstance().getBufferSize();
+  batched = batched && input.getMemoryBytes() <= capacity &&
+            m.getMemoryBytes() <= capacity &&
+            result.getMemoryBytes() <= capacity;
+
+  if (batched) {
+    unsigned int stride = input.getDim().getFeatureLen();
+    unsigned int m_stride = m.batch() == 1 ? 0 : m.getDim().getFeatureLen();
+
+    if (input.getDataType() == ml::train::TensorDim::DataType::FP32) {
+      sgemm_batched_cl(trans, trans_m, input.getData(), m.getData(),
+                       result.getData(), input.batch(), M, N, K, cols(input),
+                       cols(m), N, stride, m_stride, M * N);
+      return;
+    }
+#ifdef ENABLE_FP16
+    if (input.getDataType() == ml::train::TensorDim::DataType::FP16) {
+      sgemm_batched_cl(trans, trans_m, input.getData<_FP16>(),
+                       m.getData<_FP16>(), result.getData<_FP16>(),
+                       input.batch(), M, N, K, cols(input), cols(m), N, stride,
+                       m_stride, M * N);
+      return;
+    }
+#endif
+  }
+
   for (unsigned int b = 0; b < input.batch(); b++) {
     /** @todo try using transpose to speedup the operation */
     const Tensor this_b = input.getBatchSlice(b, 1);
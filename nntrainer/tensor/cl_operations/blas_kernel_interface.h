@@ -43,7 +43,9 @@ void dotCl(Tensor const &input, Tensor const &m, Tensor &result,
            bool trans = false, bool trans_m = false);
 
 /**
- * @brief Process data and dimensions for OpenCL dot operation
+ * @brief Process data and dimensions for OpenCL batched dot operation
+ * @details matrix products of the whole batch run in a single dispatch, @a m
+ * with batch 1 is shared by every batch of @a input
  * @param[in] input Tensor
  * @param[in] m Tensor
  * @param[in] result Tensor
@@ -202,6 +202,148 @@ static const std::string transpose_cl_kernel_axis2 =
     }
 })";
 
+static const std::string sgemm_cl_tiled_kernel_ =
+  R"(
+    // TS : edge of the square tile of C computed by one work group
+    // WPT : number of C elements of a row computed by one work item
+    #ifndef TS
+    #define TS 16
+    #endif
+    #ifndef WPT
+    #define WPT 1
+    #endif
+    #define RTS (TS / WPT)
+
+    #ifdef TRANS_A
+    #define A_AT(m, k) A[(k) * lda + (m)]
+    #else
+    #define A_AT(m, k) A[(m) * lda + (k)]
+    #endif
+
+    #ifdef TRANS_B
+    #define B_AT(k, n) B[(n) * ldb + (k)]
+    #else
+    #define B_AT(k, n) B[(k) * ldb + (n)]
+    #endif
+
+    __kernel void sgemm_cl_tiled(const __global float *A, const __global float *B,
+                                 __global float *C, unsigned int M, unsigned int N,
+                                 unsigned int K, unsigned int lda, unsigned int ldb,
+                                 unsigned int ldc, unsigned int stride_a,
+                                 unsigned int stride_b, unsigned int stride_c) {
+        // dimension 2 of the range walks the batch of products
+        const unsigned int batch = get_group_id(2);
+        A += batch * stride_a;
+        B += batch * stride_b;
+        C += batch * stride_c;
+
+        const unsigned int lx = get_local_id(0);
+        const unsigned int ly = get_local_id(1);
+        const unsigned int m = get_group_id(1) * TS + ly;
+        const unsigned int n0 = get_group_id(0) * TS;
+
+        __local float Asub[TS][TS];
+        __local float Bsub[TS][TS];
+
+        float acc[WPT];
+        for (unsigned int w = 0; w < WPT; ++w)
+            acc[w] = 0.0f;
+
+        for (unsigned int t = 0; t < K; t += TS) {
+            // cooperative load of A and B tiles, zero padded at the edges
+            for (unsigned int w = 0; w < WPT; ++w) {
+                const unsigned int c = lx + w * RTS;
+                const unsigned int ka = t + c;
+                const unsigned int kb = t + ly;
+                const unsigned int n = n0 + c;
+                Asub[ly][c] = (m < M && ka < K) ? A_AT(m, ka) : 0.0f;
+                Bsub[ly][c] = (kb < K && n < N) ? B_AT(kb, n) : 0.0f;
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+
+            for (unsigned int k = 0; k < TS; ++k) {
+                const float a = Asub[ly][k];
+                for (unsigned int w = 0; w < WPT; ++w)
+                    acc[w] += a * Bsub[k][lx + w * RTS];
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        for (unsigned int w = 0; w < WPT; ++w) {
+            const unsigned int n = n0 + lx + w * RTS;
+            if (m < M && n < N)
+                C[m * ldc + n] = acc[w];
+        }
+    })";
+
+static const std::string sgemv_cl_tiled_kernel_ =
+  R"(
+    // WG : number of work items in a work group, X is staged by WG elements
+    #ifndef WG
+    #define WG 64
+    #endif
+
+    __kernel void sgemv_cl_tiled(const __global float* A, const __global float* X,
+                                 __global float* Y, unsigned int M, unsigned int N,
+                                 unsigned int lda) {
+        const unsigned int i = get_global_id(0);
+        const unsigned int lid = get_local_id(0);
+
+        __local float x_tile[WG];
+
+        float y0 = 0.0f;
+        for (unsigned int t = 0; t < N; t += WG) {
+            x_tile[lid] = (t + lid < N) ? X[t + lid] : 0.0f;
+            barrier(CLK_LOCAL_MEM_FENCE);
+
+            const unsigned int len = min((unsigned int)WG, N - t);
+            if (i < M) {
+                for (unsigned int k = 0; k < len; ++k)
+                    y0 += A[i + (t + k) * lda] * x_tile[k];
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        if (i < M)
+            Y[i] = y0;
+    })";
+
+static const std::string sgemv_cl_noTrans_tiled_kernel_ =
+  R"(
+    // WG : number of work items reducing one row of A, must be a power of 2
+    #ifndef WG
+    #define WG 64
+    #endif
+
+    __kernel void sgemv_cl_noTrans_tiled(const __global float* A, const __global float* X,
+                                         __global float* Y, unsigned int M, unsigned int N,
+                                         unsigned int lda) {
+        const unsigned int row = get_group_id(0);
+        const unsigned int lid = get_local_id(0);
+        const __global float* a_row = A + row * lda;
+
+        __local float partial[WG];
+
+        float y0 = 0.0f;
+        const unsigned int N4 = N & ~3u;
+        for (unsigned int j = lid * 4; j < N4; j += WG * 4)
+            y0 += dot(vload4(0, a_row + j), vload4(0, X + j));
+        for (unsigned int j = N4 + lid; j < N; j += WG)
+            y0 += a_row[j] * X[j];
+
+        partial[lid] = y0;
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for (unsigned int s = WG / 2; s > 0; s >>= 1) {
+            if (lid < s)
+                partial[lid] += partial[lid + s];
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        if (lid == 0 && row < M)
+            Y[row] = partial[0];
+    })";
+
 #ifdef ENABLE_FP16
 static const std::string sgemv_cl_kernel_fp16_ =
   R"(
@@ -415,6 +557,154 @@ static const std::string transpose_cl_kernel_fp16_axis2 =
         }
     }
 })";
+
+static const std::string sgemm_cl_tiled_kernel_fp16_ =
+  R"(
+    #pragma OPENCL EXTENSION cl_khr_fp16 : enable
+
+    // TS : edge of the square tile of C computed by one work group
+    // WPT : number of C elements of a row computed by one work item
+    #ifndef TS
+    #define TS 16
+    #endif
+    #ifndef WPT
+    #define WPT 1
+    #endif
+    #define RTS (TS / WPT)
+
+    #ifdef TRANS_A
+    #define A_AT(m, k) A[(k) * lda + (m)]
+    #else
+    #define A_AT(m, k) A[(m) * lda + (k)]
+    #endif
+
+    #ifdef TRANS_B
+    #define B_AT(k, n) B[(n) * ldb + (k)]
+    #else
+    #define B_AT(k, n) B[(k) * ldb + (n)]
+    #endif
+
+    __kernel void sgemm_cl_tiled_fp16(const __global half *A, const __global half *B,
+                                      __global half *C, unsigned int M, unsigned int N,
+                                      unsigned int K, unsigned int lda, unsigned int ldb,
+                                      unsigned int ldc, unsigned int stride_a,
+                                      unsigned int stride_b, unsigned int stride_c) {
+        // dimension 2 of the range walks the batch of products
+        const unsigned int batch = get_group_id(2);
+        A += batch * stride_a;
+        B += batch * stride_b;
+        C += batch * stride_c;
+
+        const unsigned int lx = get_local_id(0);
+        const unsigned int ly = get_local_id(1);
+        const unsigned int m = get_group_id(1) * TS + ly;
+        const unsigned int n0 = get_group_id(0) * TS;
+
+        __local half Asub[TS][TS];
+        __local half Bsub[TS][TS];
+
+        float acc[WPT];
+        for (unsigned int w = 0; w < WPT; ++w)
+            acc[w] = 0.0f;
+
+        for (unsigned int t = 0; t < K; t += TS) {
+            // cooperative load of A and B tiles, zero padded at the edges
+            for (unsigned int w = 0; w < WPT; ++w) {
+                const unsigned int c = lx + w * RTS;
+                const unsigned int ka = t + c;
+                const unsigned int kb = t + ly;
+                const unsigned int n = n0 + c;
+                Asub[ly][c] = (m < M && ka < K) ? A_AT(m, ka) : (half)0.0f;
+                Bsub[ly][c] = (kb < K && n < N) ? B_AT(kb, n) : (half)0.0f;
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+
+            for (unsigned int k = 0; k < TS; ++k) {
+                const float a = Asub[ly][k];
+                for (unsigned int w = 0; w < WPT; ++w)
+                    acc[w] += a * (float)Bsub[k][lx + w * RTS];
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        for (unsigned int w = 0; w < WPT; ++w) {
+            const unsigned int n = n0 + lx + w * RTS;
+            if (m < M && n < N)
+                C[m * ldc + n] = (half)acc[w];
+        }
+    })";
+
+static const std::string sgemv_cl_tiled_kernel_fp16_ =
+  R"(
+    #pragma OPENCL EXTENSION cl_khr_fp16 : enable
+
+    // WG : number of work items in a work group, X is staged by WG elements
+    #ifndef WG
+    #define WG 64
+    #endif
+
+    __kernel void sgemv_cl_tiled_fp16(const __global half* A, const __global half* X,
+                                      __global half* Y, unsigned int M, unsigned int N,
+                                      unsigned int lda) {
+        const unsigned int i = get_global_id(0);
+        const unsigned int lid = get_local_id(0);
+
+        __local half x_tile[WG];
+
+        float y0 = 0.0f;
+        for (unsigned int t = 0; t < N; t += WG) {
+            x_tile[lid] = (t + lid < N) ? X[t + lid] : (half)0.0f;
+            barrier(CLK_LOCAL_MEM_FENCE);
+
+            const unsigned int len = min((unsigned int)WG, N - t);
+            if (i < M) {
+                for (unsigned int k = 0; k < len; ++k)
+                    y0 += (float)A[i + (t + k) * lda] * (float)x_tile[k];
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        if (i < M)
+            Y[i] = (half)y0;
+    })";
+
+static const std::string sgemv_cl_noTrans_tiled_kernel_fp16_ =
+  R"(
+    #pragma OPENCL EXTENSION cl_khr_fp16 : enable
+
+    // WG : number of work items reducing one row of A, must be a power of 2
+    #ifndef WG
+    #define WG 64
+    #endif
+
+    __kernel void sgemv_cl_noTrans_tiled_fp16(const __global half* A, const __global half* X,
+                                              __global half* Y, unsigned int M, unsigned int N,
+                                              unsigned int lda) {
+        const unsigned int row = get_group_id(0);
+        const unsigned int lid = get_local_id(0);
+        const __global half* a_row = A + row * lda;
+
+        __local float partial[WG];
+
+        float y0 = 0.0f;
+        const unsigned int N4 = N & ~3u;
+        for (unsigned int j = lid * 4; j < N4; j += WG * 4)
+            y0 += dot(vload_half4(0, a_row + j), vload_half4(0, X + j));
+        for (unsigned int j = N4 + lid; j < N; j += WG)
+            y0 += vload_half(j, a_row) * vload_half(j, X);
+
+        partial[lid] = y0;
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for (unsigned int s = WG / 2; s > 0; s >>= 1) {
+            if (lid < s)
+                partial[lid] += partial[lid + s];
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        if (lid == 0 && row < M)
+            Y[row] = (half)partial[0];
+    })";
 #endif
 } // namespace nntrainer
 #endif /* __BLAS_KERNEL_INTERFACE_H__ */
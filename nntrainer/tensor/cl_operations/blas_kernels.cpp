@@ -16,93 +16,252 @@
 
 namespace nntrainer {
 
-void sgemv_cl(const float *matAdata, const float *vecXdata, float *vecYdata,
-              bool TransA, unsigned int dim1, unsigned int dim2,
-              unsigned int lda) {
+std::vector<ClKernelTuneParam> getSgemmTuneCandidates() {
+  /// {tile edge, outputs per work item}, work group is (TS / WPT) x TS. The
+  /// first one runs the shapes not tuned and fits any device.
+  static const std::vector<ClKernelTuneParam> all_candidates = {
+    {16, 4}, {8, 1}, {16, 1}, {32, 4}, {32, 8}, {64, 8}};
+
+  const size_t max_wg_size = ClKernelTuner::getInstance().getMaxWorkGroupSize();
+
+  std::vector<ClKernelTuneParam> candidates;
+  for (auto &param : all_candidates) {
+    if ((param.tile_size / param.work_per_item) * param.tile_size <=
+        max_wg_size)
+      candidates.push_back(param);
+  }
+  return candidates;
+}
 
-  bool result = false;
+std::vector<ClKernelTuneParam> getSgemvTuneCandidates() {
+  /// {work group size, 1}, the first one runs the shapes not tuned
+  static const std::vector<ClKernelTuneParam> all_candidates = {
+    {64, 1}, {32, 1}, {128, 1}, {256, 1}};
 
-  do {
-    ClContext::SharedPtrClKernel kernel_sgemv_ptr;
+  const size_t max_wg_size = ClKernelTuner::getInstance().getMaxWorkGroupSize();
 
-    if (TransA) {
-      kernel_sgemv_ptr =
-        blas_cc->registerClKernel(sgemv_cl_kernel_, "sgemv_cl");
-    } else {
-      kernel_sgemv_ptr =
-        blas_cc->registerClKernel(sgemv_cl_noTrans_kernel_, "sgemv_cl_noTrans");
-    }
+  std::vector<ClKernelTuneParam> candidates;
+  for (auto &param : all_candidates) {
+    if (param.tile_size <= max_wg_size)
+      candidates.push_back(param);
+  }
+  return candidates;
+}
 
-    if (!kernel_sgemv_ptr) {
-      break;
-    }
+bool sgemm_cl_tiled(const std::string &kernel_string,
+                    const std::string &kernel_name, bool TransA, bool TransB,
+                    unsigned int M, unsigned int N, unsigned int K,
+                    unsigned int lda, unsigned int ldb, unsigned int ldc,
+                    unsigned int batch, unsigned int stride_a,
+                    unsigned int stride_b, unsigned int stride_c,
+                    const ClKernelTuneParam &param,
+                    const std::vector<cl_event> &wait_events,
+                    cl_event *event) {
+  std::string options = param.getBuildOptions("TS", "WPT");
+  if (TransA)
+    options += " -DTRANS_A";
+  if (TransB)
+    options += " -DTRANS_B";
+
+  ClContext::SharedPtrClKernel kernel_ptr =
+    blas_cc->registerClKernel(kernel_string, kernel_name, options);
+  if (!kernel_ptr) {
+    return false;
+  }
 
-    size_t dim1_size = sizeof(float) * dim1;
-    size_t dim2_size = sizeof(float) * dim2;
+  if (!kernel_ptr->SetKernelArguments(0, clbuffInstance.getInBufferA(),
+                                      sizeof(cl_mem)) ||
+      !kernel_ptr->SetKernelArguments(1, clbuffInstance.getInBufferB(),
+                                      sizeof(cl_mem)) ||
+      !kernel_ptr->SetKernelArguments(2, clbuffInstance.getOutBufferA(),
+                                      sizeof(cl_mem)) ||
+      !kernel_ptr->SetKernelArguments(3, &M, sizeof(int)) ||
+      !kernel_ptr->SetKernelArguments(4, &N, sizeof(int)) ||
+      !kernel_ptr->SetKernelArguments(5, &K, sizeof(int)) ||
+      !kernel_ptr->SetKernelArguments(6, &lda, sizeof(int)) ||
+      !kernel_ptr->SetKernelArguments(7, &ldb, sizeof(int)) ||
+      !kernel_ptr->SetKernelArguments(8, &ldc, sizeof(int)) ||
+      !kernel_ptr->SetKernelArguments(9, &stride_a, sizeof(int)) ||
+      !kernel_ptr->SetKernelArguments(10, &stride_b, sizeof(int)) ||
+      !kernel_ptr->SetKernelArguments(11, &stride_c, sizeof(int))) {
+    return false;
+  }
 
-    result = clbuffInstance.getInBufferA()->WriteDataRegion(
-      blas_cc->command_queue_inst_, dim1 * dim2 * sizeof(float), matAdata);
-    if (!result) {
-      break;
-    }
+  const unsigned int ts = param.tile_size;
+  const unsigned int rts = ts / param.work_per_item;
+  const unsigned int m_tiles = (M + ts - 1) / ts;
+  const unsigned int n_tiles = (N + ts - 1) / ts;
 
-    result = clbuffInstance.getInBufferB()->WriteDataRegion(
-      blas_cc->command_queue_inst_, dim2_size, vecXdata);
-    if (!result) {
-      break;
-    }
+  /// dimension 0 walks the columns of C so that loads of a row are coalesced,
+  /// dimension 2 walks the batch
+  const int work_groups_count[3] = {(int)(n_tiles * rts), (int)(m_tiles * ts),
+                                    (int)batch};
+  const int work_group_size[3] = {(int)rts, (int)ts, 1};
 
-    result = clbuffInstance.getOutBufferA()->WriteDataRegion(
-      blas_cc->command_queue_inst_, dim1_size, vecYdata);
-    if (!result) {
-      break;
-    }
+  return blas_cc->command_queue_inst_.DispatchCommand(
+    kernel_ptr, work_groups_count, work_group_size, event, wait_events);
+}
 
-    result = kernel_sgemv_ptr->SetKernelArguments(
-      0, clbuffInstance.getInBufferA(), sizeof(cl_mem));
-    if (!result) {
-      break;
-    }
+bool sgemv_cl_tiled(const std::string &kernel_string,
+                    const std::string &kernel_name, bool TransA,
+                    unsigned int dim1, unsigned int dim2, unsigned int lda,
+                    const ClKernelTuneParam &param,
+                    const std::vector<cl_event> &wait_events,
+                    cl_event *event) {
+  ClContext::SharedPtrClKernel kernel_ptr = blas_cc->registerClKernel(
+    kernel_string, kernel_name, param.getBuildOptions("WG"));
+  if (!kernel_ptr) {
+    return false;
+  }
 
-    result = kernel_sgemv_ptr->SetKernelArguments(
-      1, clbuffInstance.getInBufferB(), sizeof(cl_mem));
-    if (!result) {
-      break;
-    }
+  if (!kernel_ptr->SetKernelArguments(0, clbuffInstance.getInBufferA(),
+                                      sizeof(cl_mem)) ||
+      !kernel_ptr->SetKernelArguments(1, clbuffInstance.getInBufferB(),
+                                      sizeof(cl_mem)) ||
+      !kernel_ptr->SetKernelArguments(2, clbuffInstance.getOutBufferA(),
+                                      sizeof(cl_mem)) ||
+      !kernel_ptr->SetKernelArguments(3, &dim1, sizeof(int)) ||
+      !kernel_ptr->SetKernelArguments(4, &dim2, sizeof(int)) ||
+      !kernel_ptr->SetKernelArguments(5, &lda, sizeof(int))) {
+    return false;
+  }
 
-    result = kernel_sgemv_ptr->SetKernelArguments(
-      2, clbuffInstance.getOutBufferA(), sizeof(cl_mem));
-    if (!result) {
-      break;
-    }
+  const unsigned int wg = param.tile_size;
+  /// transposed: a work item per output, otherwise a work group per output
+  const unsigned int global_size =
+    TransA ? (dim1 + wg - 1) / wg * wg : dim1 * wg;
+
+  const int work_groups_count[3] = {(int)global_size, 1, 1};
+  const int work_group_size[3] = {(int)wg, 1, 1};
+
+  return blas_cc->command_queue_inst_.DispatchCommand(
+    kernel_ptr, work_groups_count, work_group_size, event, wait_events);
+}
+
+void sgemv_cl(const float *matAdata, const float *vecXdata, float *vecYdata,
+              bool TransA, unsigned int dim1, unsigned int dim2,
+              unsigned int lda) {
+
+  bool result = false;
+  opencl::CommandQueueManager &queue = blas_cc->command_queue_inst_;
+  /// commands in flight, waited for before returning since the transfers
+  /// access the host buffers
+  std::vector<cl_event> events;
 
-    result = kernel_sgemv_ptr->SetKernelArguments(3, &dim2, sizeof(int));
+  do {
+    size_t dim1_size = sizeof(float) * dim1;
+    size_t dim2_size = sizeof(float) * dim2;
+
+    events.push_back(nullptr);
+    result = queue.EnqueueWriteBufferAsync(
+      clbuffInstance.getInBufferA()->GetBuffer(), dim1 * dim2 * sizeof(float),
+      matAdata, &events.back());
     if (!result) {
       break;
     }
 
-    result = kernel_sgemv_ptr->SetKernelArguments(4, &lda, sizeof(int));
+    events.push_back(nullptr);
+    result = queue.EnqueueWriteBufferAsync(
+      clbuffInstance.getInBufferB()->GetBuffer(), dim2_size, vecXdata,
+      &events.back());
     if (!result) {
       break;
     }
 
-    const int work_groups_count[3] = {(int)dim1, 1, 1};
-    /// @todo: create a group size by device & input
-    const int work_group_size[3] = {32, 1, 1};
+    // the kernel waits only for the operand uploads, the output is fully
+    // overwritten by the kernel so it is not uploaded
+    const std::vector<cl_event> uploads = events;
+    cl_event kernel_done = nullptr;
 
-    result = opencl::CommandQueueManager::GetInstance().DispatchCommand(
-      kernel_sgemv_ptr, work_groups_count, work_group_size);
-    if (!result) {
-      break;
-    }
+    const std::string &tiled_kernel_string =
+      TransA ? sgemv_cl_tiled_kernel_ : sgemv_cl_noTrans_tiled_kernel_;
+    const std::string tiled_kernel_name =
+      TransA ? "sgemv_cl_tiled" : "sgemv_cl_noTrans_tiled";
 
-    result = clbuffInstance.getOutBufferA()->ReadDataRegion(
-      blas_cc->command_queue_inst_, dim1_size, vecYdata);
+    ClKernelTuneParam tuned = ClKernelTuner::getInstance().tune(
+      tiled_kernel_name, {dim1, dim2, lda}, getSgemvTuneCandidates(),
+      [&](const ClKernelTuneParam &param) {
+        return sgemv_cl_tiled(tiled_kernel_string, tiled_kernel_name, TransA,
+                              dim1, dim2, lda, param, uploads);
+      });
+
+    if (tuned.isValid()) {
+      result = sgemv_cl_tiled(tiled_kernel_string, tiled_kernel_name, TransA,
+                              dim1, dim2, lda, tuned, uploads, &kernel_done);
+      if (!result) {
+        break;
+      }
+    } else {
+      /// fall back to the naive kernel with one output per work item
+      ClContext::SharedPtrClKernel kernel_sgemv_ptr;
+
+      if (TransA) {
+        kernel_sgemv_ptr =
+          blas_cc->registerClKernel(sgemv_cl_kernel_, "sgemv_cl");
+      } else {
+        kernel_sgemv_ptr = blas_cc->registerClKernel(sgemv_cl_noTrans_kernel_,
+                                                     "sgemv_cl_noTrans");
+      }
+
+      if (!kernel_sgemv_ptr) {
+        result = false;
+        break;
+      }
+
+      result = kernel_sgemv_ptr->SetKernelArguments(
+        0, clbuffInstance.getInBufferA(), sizeof(cl_mem));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemv_ptr->SetKernelArguments(
+        1, clbuffInstance.getInBufferB(), sizeof(cl_mem));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemv_ptr->SetKernelArguments(
+        2, clbuffInstance.getOutBufferA(), sizeof(cl_mem));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemv_ptr->SetKernelArguments(3, &dim2, sizeof(int));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemv_ptr->SetKernelArguments(4, &lda, sizeof(int));
+      if (!result) {
+        break;
+      }
+
+      const int work_groups_count[3] = {(int)dim1, 1, 1};
+      const int work_group_size[3] = {32, 1, 1};
+
+      result = opencl::CommandQueueManager::GetInstance().DispatchCommand(
+        kernel_sgemv_ptr, work_groups_count, work_group_size, &kernel_done,
+        uploads);
+      if (!result) {
+        break;
+      }
+    }
+
+    // the result is read back on the transfer queue after the kernel
+    events.push_back(kernel_done);
+    const cl_event compute_done = kernel_done;
+    events.push_back(nullptr);
+    result = queue.EnqueueReadBufferAsync(
+      clbuffInstance.getOutBufferA()->GetBuffer(), dim1_size, vecYdata,
+      &events.back(), {compute_done});
     if (!result) {
       break;
     }
 
   } while (false);
+
+  // the host synchronizes only where the result is consumed
+  queue.WaitForEvents(events);
 }
 
 float dot_cl(const float *vecAdata, const float *vecXdata, unsigned int dim1) {
@@ -176,114 +335,171 @@ float dot_cl(const float *vecAdata, const float *vecXdata, unsigned int dim1) {
   return cl_ret;
 }
 
-void sgemm_cl(bool TransA, bool TransB, const float *A, const float *B,
-              float *C, unsigned int M, unsigned int N, unsigned int K,
-              unsigned int lda, unsigned int ldb, unsigned int ldc) {
-
-  std::string kernel_func_;
-  std::string sgemm_cl_kernel_;
-
-  if (!TransA && !TransB) {
-    kernel_func_ = "sgemm_cl_noTrans";
-    sgemm_cl_kernel_ = sgemm_cl_noTrans_kernel_;
-  } else if (TransA && !TransB) {
-    kernel_func_ = "sgemm_cl_transA";
-    sgemm_cl_kernel_ = sgemm_cl_transA_kernel_;
-  } else if (!TransA && TransB) {
-    kernel_func_ = "sgemm_cl_transB";
-    sgemm_cl_kernel_ = sgemm_cl_transB_kernel_;
-  } else {
-    kernel_func_ = "sgemm_cl_transAB";
-    sgemm_cl_kernel_ = sgemm_cl_transAB_kernel_;
-  }
+void sgemm_batched_cl(bool TransA, bool TransB, const float *A, const float *B,
+                      float *C, unsigned int batch, unsigned int M,
+                      unsigned int N, unsigned int K, unsigned int lda,
+                      unsigned int ldb, unsigned int ldc, unsigned int stride_a,
+                      unsigned int stride_b, unsigned int stride_c) {
 
   bool result = false;
+  /// true if the products are left to the naive kernel of a single product
+  bool per_batch = false;
+  opencl::CommandQueueManager &queue = blas_cc->command_queue_inst_;
+  /// commands in flight, waited for before returning since the transfers
+  /// access the host buffers
+  std::vector<cl_event> events;
 
   do {
-    ClContext::SharedPtrClKernel kernel_sgemm_ptr =
-      blas_cc->registerClKernel(sgemm_cl_kernel_, kernel_func_);
-    if (!kernel_sgemm_ptr) {
-      break;
-    }
+    // sizes will be same for transpose, a zero stride shares one matrix
+    size_t m_k_size = ((size_t)(batch - 1) * stride_a + M * K) * sizeof(float);
+    size_t k_n_size = ((size_t)(batch - 1) * stride_b + K * N) * sizeof(float);
+    size_t m_n_size = ((size_t)(batch - 1) * stride_c + M * N) * sizeof(float);
 
-    // sizes will be same for transpose
-    size_t m_k_size = M * K * sizeof(float);
-    size_t k_n_size = K * N * sizeof(float);
-    size_t m_n_size = M * N * sizeof(float);
-
-    result = clbuffInstance.getInBufferA()->WriteDataRegion(
-      blas_cc->command_queue_inst_, m_k_size, A);
+    events.push_back(nullptr);
+    result = queue.EnqueueWriteBufferAsync(
+      clbuffInstance.getInBufferA()->GetBuffer(), m_k_size, A, &events.back());
     if (!result) {
       break;
     }
 
-    result = clbuffInstance.getInBufferB()->WriteDataRegion(
-      blas_cc->command_queue_inst_, k_n_size, B);
+    events.push_back(nullptr);
+    result = queue.EnqueueWriteBufferAsync(
+      clbuffInstance.getInBufferB()->GetBuffer(), k_n_size, B, &events.back());
     if (!result) {
       break;
     }
 
-    result = clbuffInstance.getOutBufferA()->WriteDataRegion(
-      blas_cc->command_queue_inst_, m_n_size, C);
-    if (!result) {
-      break;
-    }
+    // the kernel waits only for the operand uploads, the output is fully
+    // overwritten by the kernel so it is not uploaded
+    const std::vector<cl_event> uploads = events;
+    cl_event kernel_done = nullptr;
 
-    result = kernel_sgemm_ptr->SetKernelArguments(
-      0, clbuffInstance.getInBufferA(), sizeof(cl_mem));
-    if (!result) {
-      break;
-    }
+    const std::string tune_op = std::string("sgemm_cl_tiled") +
+                                (TransA ? "_transA" : "") +
+                                (TransB ? "_transB" : "");
 
-    result = kernel_sgemm_ptr->SetKernelArguments(
-      1, clbuffInstance.getInBufferB(), sizeof(cl_mem));
-    if (!result) {
-      break;
-    }
+    ClKernelTuneParam tuned = ClKernelTuner::getInstance().tune(
+      tune_op, {batch, M, N, K, lda, ldb, ldc}, getSgemmTuneCandidates(),
+      [&](const ClKernelTuneParam &param) {
+        return sgemm_cl_tiled(sgemm_cl_tiled_kernel_, "sgemm_cl_tiled", TransA,
+                              TransB, M, N, K, lda, ldb, ldc, batch, stride_a,
+                              stride_b, stride_c, param, uploads);
+      });
 
-    result = kernel_sgemm_ptr->SetKernelArguments(
-      2, clbuffInstance.getOutBufferA(), sizeof(cl_mem));
-    if (!result) {
+    if (tuned.isValid()) {
+      result = sgemm_cl_tiled(sgemm_cl_tiled_kernel_, "sgemm_cl_tiled", TransA,
+                              TransB, M, N, K, lda, ldb, ldc, batch, stride_a,
+                              stride_b, stride_c, tuned, uploads, &kernel_done);
+      if (!result) {
+        break;
+      }
+    } else if (batch > 1) {
+      /// the naive kernels compute a single product
+      per_batch = true;
       break;
-    }
-
-    result = kernel_sgemm_ptr->SetKernelArguments(3, &K, sizeof(int));
-    if (!result) {
-      break;
-    }
-
-    result = kernel_sgemm_ptr->SetKernelArguments(4, &lda, sizeof(int));
-    if (!result) {
-      break;
-    }
-
-    result = kernel_sgemm_ptr->SetKernelArguments(5, &ldb, sizeof(int));
+    } else {
+      /// fall back to the naive kernel with one output per work item
+      std::string kernel_func_;
+      std::string sgemm_cl_kernel_;
+
+      if (!TransA && !TransB) {
+        kernel_func_ = "sgemm_cl_noTrans";
+        sgemm_cl_kernel_ = sgemm_cl_noTrans_kernel_;
+      } else if (TransA && !TransB) {
+        kernel_func_ = "sgemm_cl_transA";
+        sgemm_cl_kernel_ = sgemm_cl_transA_kernel_;
+      } else if (!TransA && TransB) {
+        kernel_func_ = "sgemm_cl_transB";
+        sgemm_cl_kernel_ = sgemm_cl_transB_kernel_;
+      } else {
+        kernel_func_ = "sgemm_cl_transAB";
+        sgemm_cl_kernel_ = sgemm_cl_transAB_kernel_;
+      }
+
+      ClContext::SharedPtrClKernel kernel_sgemm_ptr =
+        blas_cc->registerClKernel(sgemm_cl_kernel_, kernel_func_);
+      if (!kernel_sgemm_ptr) {
+        result = false;
+        break;
+      }
+
+      result = kernel_sgemm_ptr->SetKernelArguments(
+        0, clbuffInstance.getInBufferA(), sizeof(cl_mem));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemm_ptr->SetKernelArguments(
+        1, clbuffInstance.getInBufferB(), sizeof(cl_mem));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemm_ptr->SetKernelArguments(
+        2, clbuffInstance.getOutBufferA(), sizeof(cl_mem));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemm_ptr->SetKernelArguments(3, &K, sizeof(int));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemm_ptr->SetKernelArguments(4, &lda, sizeof(int));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemm_ptr->SetKernelArguments(5, &ldb, sizeof(int));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemm_ptr->SetKernelArguments(6, &ldc, sizeof(int));
+      if (!result) {
+        break;
+      }
+
+      const int work_groups_count[3] = {(int)M, (int)N, 1};
+      const int work_group_size[3] = {32, 32, 1}; // test-value
+
+      result = blas_cc->command_queue_inst_.DispatchCommand(
+        kernel_sgemm_ptr, work_groups_count, work_group_size, &kernel_done,
+        uploads);
+      if (!result) {
+        break;
+      }
+    }
+
+    // the result is read back on the transfer queue after the kernel
+    events.push_back(kernel_done);
+    const cl_event compute_done = kernel_done;
+    events.push_back(nullptr);
+    result = queue.EnqueueReadBufferAsync(
+      clbuffInstance.getOutBufferA()->GetBuffer(), m_n_size, C, &events.back(),
+      {compute_done});
     if (!result) {
       break;
     }
 
-    result = kernel_sgemm_ptr->SetKernelArguments(6, &ldc, sizeof(int));
-    if (!result) {
-      break;
-    }
+  } while (false);
 
-    const int work_groups_count[3] = {(int)M, (int)N, 1};
-    /// @todo: create a group size by device & input
-    const int work_group_size[3] = {32, 32, 1}; // test-value
+  // the host synchronizes only where the result is consumed
+  queue.WaitForEvents(events);
 
-    result = blas_cc->command_queue_inst_.DispatchCommand(
-      kernel_sgemm_ptr, work_groups_count, work_group_size);
-    if (!result) {
-      break;
-    }
-
-    result = clbuffInstance.getOutBufferA()->ReadDataRegion(
-      blas_cc->command_queue_inst_, m_n_size, C);
-    if (!result) {
-      break;
-    }
+  if (per_batch) {
+    for (unsigned int b = 0; b < batch; ++b)
+      sgemm_cl(TransA, TransB, A + b * stride_a, B + b * stride_b,
+               C + b * stride_c, M, N, K, lda, ldb, ldc);
+  }
+}
 
-  } while (false);
+void sgemm_cl(bool TransA, bool TransB, const float *A, const float *B,
+              float *C, unsigned int M, unsigned int N, unsigned int K,
+              unsigned int lda, unsigned int ldb, unsigned int ldc) {
+  sgemm_batched_cl(TransA, TransB, A, B, C, 1, M, N, K, lda, ldb, ldc, 0, 0,
+                   0);
 }
 
 void addition_cl(const float *input, float *res, unsigned int size_input,
@@ -16,6 +16,7 @@
 
 #include <cl_buffer_manager.h>
 #include <cl_context.h>
+#include <cl_kernel_tuner.h>
 #include <engine.h>
 #include <opencl_buffer.h>
 #include <opencl_kernel.h>
@@ -29,6 +30,73 @@ static ClContext *blas_cc =
   static_cast<ClContext *>(Engine::Global().getRegisteredContext("gpu"));
 static ClBufferManager &clbuffInstance = ClBufferManager::getInstance();
 
+/**
+ * @brief     Get the launch configurations tried by the tuner for the tiled
+ * gemm kernels, limited by the work group size of the device
+ * @return    std::vector<ClKernelTuneParam> candidate tile configurations
+ */
+std::vector<ClKernelTuneParam> getSgemmTuneCandidates();
+
+/**
+ * @brief     Get the launch configurations tried by the tuner for the tiled
+ * gemv kernels, limited by the work group size of the device
+ * @return    std::vector<ClKernelTuneParam> candidate work group sizes
+ */
+std::vector<ClKernelTuneParam> getSgemvTuneCandidates();
+
+/**
+ * @brief     Run a local memory tiled gemm kernel on the operands already
+ * uploaded to InBufferA (A), InBufferB (B) and writing OutBufferA (C)
+ * @param[in] kernel_string tiled kernel source of the data type
+ * @param[in] kernel_name tiled kernel name of the data type
+ * @param[in] TransA bool transpose
+ * @param[in] TransB bool transpose
+ * @param[in] M number of op(A)'s and C's row
+ * @param[in] N number of op(B)'s and C's columns
+ * @param[in] K number of op(A)'s and columns and op(B)'s rows
+ * @param[in] lda number of A's columns
+ * @param[in] ldb number of B's columns
+ * @param[in] ldc number of C's columns
+ * @param[in] batch number of the products
+ * @param[in] stride_a elements between the matrices of A, 0 to share one
+ * @param[in] stride_b elements between the matrices of B, 0 to share one
+ * @param[in] stride_c elements between the matrices of C
+ * @param[in] param tile configuration
+ * @param[in] wait_events events the kernel waits for, e.g. the uploads
+ * @param[out] event event of the kernel, released by the caller, or nullptr
+ * @return    true if the kernel is dispatched successfully
+ */
+bool sgemm_cl_tiled(const std::string &kernel_string,
+                    const std::string &kernel_name, bool TransA, bool TransB,
+                    unsigned int M, unsigned int N, unsigned int K,
+                    unsigned int lda, unsigned int ldb, unsigned int ldc,
+                    unsigned int batch, unsigned int stride_a,
+                    unsigned int stride_b, unsigned int stride_c,
+                    const ClKernelTuneParam &param,
+                    const std::vector<cl_event> &wait_events = {},
+                    cl_event *event = nullptr);
+
+/**
+ * @brief     Run a tiled gemv kernel on the operands already uploaded to
+ * InBufferA (A), InBufferB (X) and writing OutBufferA (Y)
+ * @param[in] kernel_string tiled kernel source of the data type
+ * @param[in] kernel_name tiled kernel name of the data type
+ * @param[in] TransA bool transpose
+ * @param[in] dim1 number of elements of Y
+ * @param[in] dim2 number of elements of X
+ * @param[in] lda number of A's columns
+ * @param[in] param work group configuration
+ * @param[in] wait_events events the kernel waits for, e.g. the uploads
+ * @param[out] event event of the kernel, released by the caller, or nullptr
+ * @return    true if the kernel is dispatched successfully
+ */
+bool sgemv_cl_tiled(const std::string &kernel_string,
+                    const std::string &kernel_name, bool TransA,
+                    unsigned int dim1, unsigned int dim2, unsigned int lda,
+                    const ClKernelTuneParam &param,
+                    const std::vector<cl_event> &wait_events = {},
+                    cl_event *event = nullptr);
+
 /**
  * @brief     sgemv computation : Y = A*X + Y
  * @param[in] matAdata float * for Matrix A
@@ -74,6 +142,31 @@ void sgemm_cl(bool TransA, bool TransB, const float *A, const float *B,
               float *C, unsigned int M, unsigned int N, unsigned int K,
               unsigned int lda, unsigned int ldb, unsigned int ldc);
 
+/**
+ * @brief     strided batched sgemm computation : Y_i = op(A_i)*op(B_i),
+ * where X_i = X + i * stride_x, running all the products in one dispatch
+ * @param[in] transA bool transpose
+ * @param[in] transB bool transpose
+ * @param[in] A float * for the first Matrix A
+ * @param[in] B float * for the first Matrix B
+ * @param[in] C float * for the first Matrix C
+ * @param[in] batch number of the products
+ * @param[in] M number of op(A)'s and C's row
+ * @param[in] N number of op(B)'s and C's columns
+ * @param[in] K number of op(A)'s and columns and op(B)'s rows
+ * @param[in] lda number of A's columns
+ * @param[in] ldb number of B's columns
+ * @param[in] ldc number of C's columns
+ * @param[in] stride_a elements between the matrices of A, 0 to share one
+ * @param[in] stride_b elements between the matrices of B, 0 to share one
+ * @param[in] stride_c elements between the matrices of C
+ */
+void sgemm_batched_cl(bool TransA, bool TransB, const float *A, const float *B,
+                      float *C, unsigned int batch, unsigned int M,
+                      unsigned int N, unsigned int K, unsigned int lda,
+                      unsigned int ldb, unsigned int ldc, unsigned int stride_a,
+                      unsigned int stride_b, unsigned int stride_c);
+
 /**
  * @brief     addition : sum of all input vectors
  * @param[in] input float * for input
@@ -157,6 +250,31 @@ void sgemm_cl(bool TransA, bool TransB, const _FP16 *A, const _FP16 *B,
               _FP16 *C, unsigned int M, unsigned int N, unsigned int K,
               unsigned int lda, unsigned int ldb, unsigned int ldc);
 
+/**
+ * @brief     strided batched fp16 sgemm computation : Y_i = op(A_i)*op(B_i),
+ * where X_i = X + i * stride_x, running all the products in one dispatch
+ * @param[in] transA bool transpose
+ * @param[in] transB bool transpose
+ * @param[in] A fp16 * for the first Matrix A
+ * @param[in] B fp16 * for the first Matrix B
+ * @param[in] C fp16 * for the first Matrix C
+ * @param[in] batch number of the products
+ * @param[in] M number of op(A)'s and C's row
+ * @param[in] N number of op(B)'s and C's columns
+ * @param[in] K number of op(A)'s and columns and op(B)'s rows
+ * @param[in] lda number of A's columns
+ * @param[in] ldb number of B's columns
+ * @param[in] ldc number of C's columns
+ * @param[in] stride_a elements between the matrices of A, 0 to share one
+ * @param[in] stride_b elements between the matrices of B, 0 to share one
+ * @param[in] stride_c elements between the matrices of C
+ */
+void sgemm_batched_cl(bool TransA, bool TransB, const _FP16 *A, const _FP16 *B,
+                      _FP16 *C, unsigned int batch, unsigned int M,
+                      unsigned int N, unsigned int K, unsigned int lda,
+                      unsigned int ldb, unsigned int ldc, unsigned int stride_a,
+                      unsigned int stride_b, unsigned int stride_c);
+
 /**
  * @brief     fp16 addition : sum of all input vectors
  * @param[in] input fp16 * for input
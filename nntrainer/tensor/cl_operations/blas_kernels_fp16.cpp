@@ -21,88 +21,126 @@ void sgemv_cl(const _FP16 *matAdata, const _FP16 *vecXdata, _FP16 *vecYdata,
               unsigned int lda) {
 
   bool result = false;
+  opencl::CommandQueueManager &queue = blas_cc->command_queue_inst_;
+  /// commands in flight, waited for before returning since the transfers
+  /// access the host buffers
+  std::vector<cl_event> events;
 
   do {
-    ClContext::SharedPtrClKernel kernel_sgemv_fp16_ptr;
-
-    if (TransA) {
-      kernel_sgemv_fp16_ptr =
-        blas_cc->registerClKernel(sgemv_cl_kernel_fp16_, "sgemv_cl_fp16");
-    } else {
-      kernel_sgemv_fp16_ptr = blas_cc->registerClKernel(
-        sgemv_cl_noTrans_kernel_fp16_, "sgemv_cl_noTrans_fp16");
-    }
-
-    if (!kernel_sgemv_fp16_ptr) {
-      break;
-    }
-
     size_t dim1_size = sizeof(_FP16) * dim1;
     size_t dim2_size = sizeof(_FP16) * dim2;
 
-    result = clbuffInstance.getInBufferA()->WriteDataRegion(
-      blas_cc->command_queue_inst_, dim1 * dim2 * sizeof(_FP16), matAdata);
+    events.push_back(nullptr);
+    result = queue.EnqueueWriteBufferAsync(
+      clbuffInstance.getInBufferA()->GetBuffer(), dim1 * dim2 * sizeof(_FP16),
+      matAdata, &events.back());
     if (!result) {
       break;
     }
 
-    result = clbuffInstance.getInBufferB()->WriteDataRegion(
-      blas_cc->command_queue_inst_, dim2_size, vecXdata);
+    events.push_back(nullptr);
+    result = queue.EnqueueWriteBufferAsync(
+      clbuffInstance.getInBufferB()->GetBuffer(), dim2_size, vecXdata,
+      &events.back());
     if (!result) {
       break;
     }
 
-    result = clbuffInstance.getOutBufferA()->WriteDataRegion(
-      blas_cc->command_queue_inst_, dim1_size, vecYdata);
-    if (!result) {
-      break;
-    }
+    // the kernel waits only for the operand uploads, the output is fully
+    // overwritten by the kernel so it is not uploaded
+    const std::vector<cl_event> uploads = events;
+    cl_event kernel_done = nullptr;
 
-    result = kernel_sgemv_fp16_ptr->SetKernelArguments(
-      0, clbuffInstance.getInBufferA(), sizeof(cl_mem));
-    if (!result) {
-      break;
-    }
-
-    result = kernel_sgemv_fp16_ptr->SetKernelArguments(
-      1, clbuffInstance.getInBufferB(), sizeof(cl_mem));
-    if (!result) {
-      break;
-    }
+    const std::string &tiled_kernel_string =
+      TransA ? sgemv_cl_tiled_kernel_fp16_
+             : sgemv_cl_noTrans_tiled_kernel_fp16_;
+    const std::string tiled_kernel_name =
+      TransA ? "sgemv_cl_tiled_fp16" : "sgemv_cl_noTrans_tiled_fp16";
 
-    result = kernel_sgemv_fp16_ptr->SetKernelArguments(
-      2, clbuffInstance.getOutBufferA(), sizeof(cl_mem));
-    if (!result) {
-      break;
-    }
+    ClKernelTuneParam tuned = ClKernelTuner::getInstance().tune(
+      tiled_kernel_name, {dim1, dim2, lda}, getSgemvTuneCandidates(),
+      [&](const ClKernelTuneParam &param) {
+        return sgemv_cl_tiled(tiled_kernel_string, tiled_kernel_name, TransA,
+                              dim1, dim2, lda, param, uploads);
+      });
 
-    result = kernel_sgemv_fp16_ptr->SetKernelArguments(3, &dim2, sizeof(int));
-    if (!result) {
-      break;
-    }
-
-    result = kernel_sgemv_fp16_ptr->SetKernelArguments(4, &lda, sizeof(int));
-    if (!result) {
-      break;
-    }
-
-    const int work_groups_count[3] = {(int)dim1, 1, 1};
-    /// @todo: create a group size by device & input
-    const int work_group_size[3] = {32, 1, 1}; // test-value
-
-    result = blas_cc->command_queue_inst_.DispatchCommand(
-      kernel_sgemv_fp16_ptr, work_groups_count, work_group_size);
-    if (!result) {
-      break;
-    }
-
-    result = clbuffInstance.getOutBufferA()->ReadDataRegion(
-      blas_cc->command_queue_inst_, dim1_size, vecYdata);
+    if (tuned.isValid()) {
+      result = sgemv_cl_tiled(tiled_kernel_string, tiled_kernel_name, TransA,
+                              dim1, dim2, lda, tuned, uploads, &kernel_done);
+      if (!result) {
+        break;
+      }
+    } else {
+      /// fall back to the naive kernel with one output per work item
+      ClContext::SharedPtrClKernel kernel_sgemv_fp16_ptr;
+
+      if (TransA) {
+        kernel_sgemv_fp16_ptr =
+          blas_cc->registerClKernel(sgemv_cl_kernel_fp16_, "sgemv_cl_fp16");
+      } else {
+        kernel_sgemv_fp16_ptr = blas_cc->registerClKernel(
+          sgemv_cl_noTrans_kernel_fp16_, "sgemv_cl_noTrans_fp16");
+      }
+
+      if (!kernel_sgemv_fp16_ptr) {
+        result = false;
+        break;
+      }
+
+      result = kernel_sgemv_fp16_ptr->SetKernelArguments(
+        0, clbuffInstance.getInBufferA(), sizeof(cl_mem));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemv_fp16_ptr->SetKernelArguments(
+        1, clbuffInstance.getInBufferB(), sizeof(cl_mem));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemv_fp16_ptr->SetKernelArguments(
+        2, clbuffInstance.getOutBufferA(), sizeof(cl_mem));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemv_fp16_ptr->SetKernelArguments(3, &dim2, sizeof(int));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemv_fp16_ptr->SetKernelArguments(4, &lda, sizeof(int));
+      if (!result) {
+        break;
+      }
+
+      const int work_groups_count[3] = {(int)dim1, 1, 1};
+      const int work_group_size[3] = {32, 1, 1};
+
+      result = opencl::CommandQueueManager::GetInstance().DispatchCommand(
+        kernel_sgemv_fp16_ptr, work_groups_count, work_group_size, &kernel_done,
+        uploads);
+      if (!result) {
+        break;
+      }
+    }
+
+    // the result is read back on the transfer queue after the kernel
+    events.push_back(kernel_done);
+    const cl_event compute_done = kernel_done;
+    events.push_back(nullptr);
+    result = queue.EnqueueReadBufferAsync(
+      clbuffInstance.getOutBufferA()->GetBuffer(), dim1_size, vecYdata,
+      &events.back(), {compute_done});
     if (!result) {
       break;
     }
 
   } while (false);
+
+  // the host synchronizes only where the result is consumed
+  queue.WaitForEvents(events);
 }
 
 _FP16 dot_cl(const _FP16 *vecAdata, const _FP16 *vecXdata, unsigned int dim1) {
@@ -177,114 +215,173 @@ _FP16 dot_cl(const _FP16 *vecAdata, const _FP16 *vecXdata, unsigned int dim1) {
   return cl_ret;
 }
 
-void sgemm_cl(bool TransA, bool TransB, const _FP16 *A, const _FP16 *B,
-              _FP16 *C, unsigned int M, unsigned int N, unsigned int K,
-              unsigned int lda, unsigned int ldb, unsigned int ldc) {
-
-  std::string kernel_func_;
-  std::string sgemm_cl_kernel_fp16_;
-
-  if (!TransA && !TransB) {
-    kernel_func_ = "sgemm_cl_noTrans_fp16";
-    sgemm_cl_kernel_fp16_ = sgemm_cl_noTrans_kernel_fp16_;
-  } else if (TransA && !TransB) {
-    kernel_func_ = "sgemm_cl_transA_fp16";
-    sgemm_cl_kernel_fp16_ = sgemm_cl_transA_kernel_fp16_;
-  } else if (!TransA && TransB) {
-    kernel_func_ = "sgemm_cl_transB_fp16";
-    sgemm_cl_kernel_fp16_ = sgemm_cl_transB_kernel_fp16_;
-  } else {
-    kernel_func_ = "sgemm_cl_transAB_fp16";
-    sgemm_cl_kernel_fp16_ = sgemm_cl_transAB_kernel_fp16_;
-  }
+void sgemm_batched_cl(bool TransA, bool TransB, const _FP16 *A, const _FP16 *B,
+                      _FP16 *C, unsigned int batch, unsigned int M,
+                      unsigned int N, unsigned int K, unsigned int lda,
+                      unsigned int ldb, unsigned int ldc, unsigned int stride_a,
+                      unsigned int stride_b, unsigned int stride_c) {
 
   bool result = false;
+  /// true if the products are left to the naive kernel of a single product
+  bool per_batch = false;
+  opencl::CommandQueueManager &queue = blas_cc->command_queue_inst_;
+  /// commands in flight, waited for before returning since the transfers
+  /// access the host buffers
+  std::vector<cl_event> events;
 
   do {
-    ClContext::SharedPtrClKernel kernel_sgemm_fp16_ptr =
-      blas_cc->registerClKernel(sgemm_cl_kernel_fp16_, kernel_func_);
-    if (!kernel_sgemm_fp16_ptr) {
-      break;
-    }
+    // sizes will be same for transpose, a zero stride shares one matrix
+    size_t m_k_size = ((size_t)(batch - 1) * stride_a + M * K) * sizeof(_FP16);
+    size_t k_n_size = ((size_t)(batch - 1) * stride_b + K * N) * sizeof(_FP16);
+    size_t m_n_size = ((size_t)(batch - 1) * stride_c + M * N) * sizeof(_FP16);
 
-    // sizes will be same for transpose
-    size_t m_k_size = M * K * sizeof(_FP16);
-    size_t k_n_size = K * N * sizeof(_FP16);
-    size_t m_n_size = M * N * sizeof(_FP16);
-
-    result = clbuffInstance.getInBufferA()->WriteDataRegion(
-      blas_cc->command_queue_inst_, m_k_size, A);
+    events.push_back(nullptr);
+    result = queue.EnqueueWriteBufferAsync(
+      clbuffInstance.getInBufferA()->GetBuffer(), m_k_size, A, &events.back());
     if (!result) {
       break;
     }
 
-    result = clbuffInstance.getInBufferB()->WriteDataRegion(
-      blas_cc->command_queue_inst_, k_n_size, B);
+    events.push_back(nullptr);
+    result = queue.EnqueueWriteBufferAsync(
+      clbuffInstance.getInBufferB()->GetBuffer(), k_n_size, B, &events.back());
     if (!result) {
       break;
     }
 
-    result = clbuffInstance.getOutBufferA()->WriteDataRegion(
-      blas_cc->command_queue_inst_, m_n_size, C);
-    if (!result) {
-      break;
-    }
+    // the kernel waits only for the operand uploads, the output is fully
+    // overwritten by the kernel so it is not uploaded
+    const std::vector<cl_event> uploads = events;
+    cl_event kernel_done = nullptr;
 
-    result = kernel_sgemm_fp16_ptr->SetKernelArguments(
-      0, clbuffInstance.getInBufferA(), sizeof(cl_mem));
-    if (!result) {
-      break;
-    }
+    const std::string tune_op = std::string("sgemm_cl_tiled_fp16") +
+                                (TransA ? "_transA" : "") +
+                                (TransB ? "_transB" : "");
 
-    result = kernel_sgemm_fp16_ptr->SetKernelArguments(
-      1, clbuffInstance.getInBufferB(), sizeof(cl_mem));
-    if (!result) {
-      break;
-    }
-
-    result = kernel_sgemm_fp16_ptr->SetKernelArguments(
-      2, clbuffInstance.getOutBufferA(), sizeof(cl_mem));
-    if (!result) {
-      break;
-    }
+    ClKernelTuneParam tuned = ClKernelTuner::getInstance().tune(
+      tune_op, {batch, M, N, K, lda, ldb, ldc}, getSgemmTuneCandidates(),
+      [&](const ClKernelTuneParam &param) {
+        return sgemm_cl_tiled(sgemm_cl_tiled_kernel_fp16_,
+                              "sgemm_cl_tiled_fp16", TransA, TransB, M, N, K,
+                              lda, ldb, ldc, batch, stride_a, stride_b,
+                              stride_c, param, uploads);
+      });
 
-    result = kernel_sgemm_fp16_ptr->SetKernelArguments(3, &K, sizeof(int));
-    if (!result) {
+    if (tuned.isValid()) {
+      result = sgemm_cl_tiled(sgemm_cl_tiled_kernel_fp16_,
+                              "sgemm_cl_tiled_fp16", TransA, TransB, M, N, K,
+                              lda, ldb, ldc, batch, stride_a, stride_b,
+                              stride_c, tuned, uploads, &kernel_done);
+      if (!result) {
+        break;
+      }
+    } else if (batch > 1) {
+      /// the naive kernels compute a single product
+      per_batch = true;
       break;
-    }
-
-    result = kernel_sgemm_fp16_ptr->SetKernelArguments(4, &lda, sizeof(int));
-    if (!result) {
-      break;
-    }
-
-    result = kernel_sgemm_fp16_ptr->SetKernelArguments(5, &ldb, sizeof(int));
-    if (!result) {
-      break;
-    }
-
-    result = kernel_sgemm_fp16_ptr->SetKernelArguments(6, &ldc, sizeof(int));
+    } else {
+      /// fall back to the naive kernel with one output per work item
+      std::string kernel_func_;
+      std::string sgemm_cl_kernel_fp16_;
+
+      if (!TransA && !TransB) {
+        kernel_func_ = "sgemm_cl_noTrans_fp16";
+        sgemm_cl_kernel_fp16_ = sgemm_cl_noTrans_kernel_fp16_;
+      } else if (TransA && !TransB) {
+        kernel_func_ = "sgemm_cl_transA_fp16";
+        sgemm_cl_kernel_fp16_ = sgemm_cl_transA_kernel_fp16_;
+      } else if (!TransA && TransB) {
+        kernel_func_ = "sgemm_cl_transB_fp16";
+        sgemm_cl_kernel_fp16_ = sgemm_cl_transB_kernel_fp16_;
+      } else {
+        kernel_func_ = "sgemm_cl_transAB_fp16";
+        sgemm_cl_kernel_fp16_ = sgemm_cl_transAB_kernel_fp16_;
+      }
+
+      ClContext::SharedPtrClKernel kernel_sgemm_fp16_ptr =
+        blas_cc->registerClKernel(sgemm_cl_kernel_fp16_, kernel_func_);
+      if (!kernel_sgemm_fp16_ptr) {
+        result = false;
+        break;
+      }
+
+      result = kernel_sgemm_fp16_ptr->SetKernelArguments(
+        0, clbuffInstance.getInBufferA(), sizeof(cl_mem));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemm_fp16_ptr->SetKernelArguments(
+        1, clbuffInstance.getInBufferB(), sizeof(cl_mem));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemm_fp16_ptr->SetKernelArguments(
+        2, clbuffInstance.getOutBufferA(), sizeof(cl_mem));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemm_fp16_ptr->SetKernelArguments(3, &K, sizeof(int));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemm_fp16_ptr->SetKernelArguments(4, &lda, sizeof(int));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemm_fp16_ptr->SetKernelArguments(5, &ldb, sizeof(int));
+      if (!result) {
+        break;
+      }
+
+      result = kernel_sgemm_fp16_ptr->SetKernelArguments(6, &ldc, sizeof(int));
+      if (!result) {
+        break;
+      }
+
+      const int work_groups_count[3] = {(int)M, (int)N, 1};
+      const int work_group_size[3] = {32, 32, 1}; // test-value
+
+      result = blas_cc->command_queue_inst_.DispatchCommand(
+        kernel_sgemm_fp16_ptr, work_groups_count, work_group_size, &kernel_done,
+        uploads);
+      if (!result) {
+        break;
+      }
+    }
+
+    // the result is read back on the transfer queue after the kernel
+    events.push_back(kernel_done);
+    const cl_event compute_done = kernel_done;
+    events.push_back(nullptr);
+    result = queue.EnqueueReadBufferAsync(
+      clbuffInstance.getOutBufferA()->GetBuffer(), m_n_size, C, &events.back(),
+      {compute_done});
     if (!result) {
       break;
     }
 
-    const int work_groups_count[3] = {(int)M, (int)N, 1};
-    /// @todo: create a group size by device & input
-    const int work_group_size[3] = {32, 32, 1}; // test-value
+  } while (false);
 
-    result = blas_cc->command_queue_inst_.DispatchCommand(
-      kernel_sgemm_fp16_ptr, work_groups_count, work_group_size);
-    if (!result) {
-      break;
-    }
+  // the host synchronizes only where the result is consumed
+  queue.WaitForEvents(events);
 
-    result = clbuffInstance.getOutBufferA()->ReadDataRegion(
-      blas_cc->command_queue_inst_, m_n_size, C);
-    if (!result) {
-      break;
-    }
+  if (per_batch) {
+    for (unsigned int b = 0; b < batch; ++b)
+      sgemm_cl(TransA, TransB, A + b * stride_a, B + b * stride_b,
+               C + b * stride_c, M, N, K, lda, ldb, ldc);
+  }
+}
 
-  } while (false);
+void sgemm_cl(bool TransA, bool TransB, const _FP16 *A, const _FP16 *B,
+              _FP16 *C, unsigned int M, unsigned int N, unsigned int K,
+              unsigned int lda, unsigned int ldb, unsigned int ldc) {
+  sgemm_batched_cl(TransA, TransB, A, B, C, 1, M, N, K, lda, ldb, ldc, 0, 0,
+                   0);
 }
 
 void addition_cl(const _FP16 *input, _FP16 *res, unsigned int size_input,
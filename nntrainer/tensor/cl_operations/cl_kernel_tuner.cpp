@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file	cl_kernel_tuner.cpp
+ * @date	18 Oct 2026
+ * @brief	On-device auto-tuner for work group and tile sizes of OpenCL
+ * kernels
+ * @see		https://github.com/nnstreamer/nntrainer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ *
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include <cl_kernel_tuner.h>
+#include <nntrainer_log.h>
+#include <opencl_command_queue_manager.h>
+#include <opencl_context_manager.h>
+
+namespace nntrainer {
+
+std::string
+ClKernelTuneParam::getBuildOptions(const std::string &tile_macro,
+                                   const std::string &work_macro) const {
+  std::string options = "-D" + tile_macro + "=" + std::to_string(tile_size);
+  if (!work_macro.empty())
+    options += " -D" + work_macro + "=" + std::to_string(work_per_item);
+  return options;
+}
+
+ClKernelTuner &ClKernelTuner::getInstance() {
+  static ClKernelTuner instance;
+  return instance;
+}
+
+size_t ClKernelTuner::getMaxWorkGroupSize() {
+  if (max_work_group_size == 0)
+    max_work_group_size =
+      opencl::ContextManager::GetInstance().GetMaxWorkGroupSize();
+  return max_work_group_size;
+}
+
+std::string ClKernelTuner::makeKey(const std::string &op,
+                                   const std::vector<unsigned int> &shape) {
+  if (device_name.empty()) {
+    device_name = opencl::ContextManager::GetInstance().GetDeviceName();
+    /// keys are saved as white space separated fields
+    std::replace_if(
+      device_name.begin(), device_name.end(),
+      [](unsigned char c) { return std::isspace(c); }, '_');
+  }
+
+  std::string key = device_name + ":" + op;
+  for (auto dim : shape)
+    key += ":" + std::to_string(dim);
+  return key;
+}
+
+ClKernelTuneParam
+ClKernelTuner::tune(const std::string &op,
+                    const std::vector<unsigned int> &shape,
+                    const std::vector<ClKernelTuneParam> &candidates,
+                    const RunFunc &run) {
+  std::lock_guard<std::mutex> lock(tune_mutex);
+
+  const std::string key = makeKey(op, shape);
+  auto found = tuned_params.find(key);
+  if (found != tuned_params.end())
+    return found->second;
+
+  if (!tuning)
+    return candidates.empty() ? ClKernelTuneParam() : candidates.front();
+
+  auto &queue = opencl::CommandQueueManager::GetInstance();
+
+  ClKernelTuneParam best;
+  double best_time = std::numeric_limits<double>::max();
+
+  for (auto &param : candidates) {
+    /// first run builds the kernel and warms up the device
+    if (!run(param) || !queue.Finish())
+      continue;
+
+    auto start = std::chrono::steady_clock::now();
+    bool ok = true;
+    for (unsigned int i = 0; i < NUM_TUNE_TRIALS && ok; ++i)
+      ok = run(param);
+    ok = ok && queue.Finish();
+    auto end = std::chrono::steady_clock::now();
+
+    if (!ok)
+      continue;
+
+    double elapsed = std::chrono::duration<double>(end - start).count();
+    if (elapsed < best_time) {
+      best_time = elapsed;
+      best = param;
+    }
+  }
+
+  if (best.isValid()) {
+    ml_logi("ClKernelTuner: %s tuned to tile %u, work per item %u",
+            key.c_str(), best.tile_size, best.work_per_item);
+  } else {
+    ml_logw("ClKernelTuner: no runnable configuration for %s", key.c_str());
+  }
+
+  /// cache failures as well so that an unsupported shape is not retried
+  tuned_params[key] = best;
+  return best;
+}
+
+void ClKernelTuner::setTuning(bool enable) {
+  std::lock_guard<std::mutex> lock(tune_mutex);
+  tuning = enable;
+}
+
+bool ClKernelTuner::isTuning() {
+  std::lock_guard<std::mutex> lock(tune_mutex);
+  return tuning;
+}
+
+void ClKernelTuner::set(const std::string &op,
+                        const std::vector<unsigned int> &shape,
+                        const ClKernelTuneParam &param) {
+  std::lock_guard<std::mutex> lock(tune_mutex);
+  tuned_params[makeKey(op, shape)] = param;
+}
+
+bool ClKernelTuner::save(const std::string &path) {
+  std::lock_guard<std::mutex> lock(tune_mutex);
+  std::ofstream file(path, std::ios::trunc);
+  if (!file.good())
+    return false;
+
+  /// a key has no white space, so a line is "key tile_size work_per_item"
+  for (auto &[key, param] : tuned_params)
+    file << key << ' ' << param.tile_size << ' ' << param.work_per_item
+         << '\n';
+  return file.good();
+}
+
+bool ClKernelTuner::load(const std::string &path) {
+  std::ifstream file(path);
+  if (!file.good())
+    return false;
+
+  std::unordered_map<std::string, ClKernelTuneParam> loaded;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream entry(line);
+    std::string key;
+    ClKernelTuneParam param;
+    if (!(entry >> key >> param.tile_size >> param.work_per_item)) {
+      ml_logw("ClKernelTuner: invalid entry in %s", path.c_str());
+      return false;
+    }
+    loaded[key] = param;
+  }
+
+  std::lock_guard<std::mutex> lock(tune_mutex);
+  for (auto &[key, param] : loaded)
+    tuned_params[key] = param;
+  return true;
+}
+
+bool ClKernelTuner::isTuned(const std::string &op,
+                            const std::vector<unsigned int> &shape) {
+  std::lock_guard<std::mutex> lock(tune_mutex);
+  return tuned_params.find(makeKey(op, shape)) != tuned_params.end();
+}
+
+void ClKernelTuner::clear() {
+  std::lock_guard<std::mutex> lock(tune_mutex);
+  tuned_params.clear();
+}
+
+} // namespace nntrainer
@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file	cl_kernel_tuner.h
+ * @date	18 Oct 2026
+ * @brief	On-device auto-tuner for work group and tile sizes of OpenCL
+ * kernels
+ * @see		https://github.com/nnstreamer/nntrainer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ *
+ */
+
+#ifndef __CL_KERNEL_TUNER_H__
+#define __CL_KERNEL_TUNER_H__
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nntrainer {
+
+/**
+ * @brief Launch configuration of a tunable kernel
+ * @note for gemm kernels, tile_size is the edge of the output tile of a work
+ * group and work_per_item is the number of outputs of a work item. For gemv
+ * kernels, tile_size is the work group size and work_per_item is 1.
+ */
+struct ClKernelTuneParam {
+  unsigned int tile_size = 0;     /**< tile edge / work group size */
+  unsigned int work_per_item = 0; /**< outputs computed by a work item */
+
+  /**
+   * @brief check if the parameter is a valid launch configuration
+   */
+  bool isValid() const { return tile_size != 0 && work_per_item != 0; }
+
+  /**
+   * @brief get the build options defining this configuration
+   * @param tile_macro macro name for tile_size
+   * @param work_macro macro name for work_per_item, empty to omit
+   * @return std::string OpenCL compiler options
+   */
+  std::string getBuildOptions(const std::string &tile_macro,
+                              const std::string &work_macro = "") const;
+};
+
+/**
+ * @class ClKernelTuner
+ * @brief Picks the fastest launch configuration of a kernel by timing every
+ * candidate on the device. Results are cached per device and problem shape.
+ *
+ * Timing the candidates launches every one of them, so it does not run on the
+ * inference path by default: a shape which is not tuned runs with the first
+ * candidate. Tuning is enabled ahead of time, e.g. for a warm-up run over the
+ * shapes of a model, and the results are saved to be loaded by later
+ * processes.
+ */
+class ClKernelTuner {
+public:
+  /**
+   * @brief function running a kernel with the given configuration, returns
+   * false if the configuration can not run on the device
+   */
+  using RunFunc = std::function<bool(const ClKernelTuneParam &)>;
+
+  /**
+   * @brief Get the global instance
+   *
+   * @return ClKernelTuner& global instance
+   */
+  static ClKernelTuner &getInstance();
+
+  /**
+   * @brief Get the tuned configuration of a kernel for the given shape. If
+   * not tuned yet, all candidates are run and timed with @a run when tuning
+   * is enabled, or the first candidate is returned without being cached
+   *
+   * @param op name of the operation including data type and transpose flags
+   * @param shape problem size identifying the tuning entry
+   * @param candidates configurations to try, the default one first
+   * @param run function to run the kernel with a configuration
+   * @return ClKernelTuneParam fastest configuration, invalid if no candidate
+   * could run
+   */
+  ClKernelTuneParam tune(const std::string &op,
+                         const std::vector<unsigned int> &shape,
+                         const std::vector<ClKernelTuneParam> &candidates,
+                         const RunFunc &run);
+
+  /**
+   * @brief enable or disable timing the candidates of the shapes not tuned
+   *
+   * @param enable true to tune on a cache miss
+   */
+  void setTuning(bool enable);
+
+  /**
+   * @brief check if the candidates are timed on a cache miss
+   *
+   * @return true if tuning is enabled
+   */
+  bool isTuning();
+
+  /**
+   * @brief set the configuration of an operation for the given shape
+   *
+   * @param op name of the operation
+   * @param shape problem size
+   * @param param configuration, invalid to use the fallback kernel
+   */
+  void set(const std::string &op, const std::vector<unsigned int> &shape,
+           const ClKernelTuneParam &param);
+
+  /**
+   * @brief save the tuned configurations of every device
+   *
+   * @param path file to write
+   * @return true if successful or false otherwise
+   */
+  bool save(const std::string &path);
+
+  /**
+   * @brief load the configurations saved by save()
+   *
+   * @param path file to read
+   * @return true if successful or false otherwise
+   */
+  bool load(const std::string &path);
+
+  /**
+   * @brief check if the operation has been tuned for the given shape
+   *
+   * @param op name of the operation
+   * @param shape problem size
+   * @return true if a cached configuration exists
+   */
+  bool isTuned(const std::string &op, const std::vector<unsigned int> &shape);
+
+  /**
+   * @brief Drop every cached configuration
+   */
+  void clear();
+
+  /**
+   * @brief Get the maximum work group size of the current device
+   *
+   * @return size_t maximum number of work items in a work group
+   */
+  size_t getMaxWorkGroupSize();
+
+private:
+  /**
+   * @brief Private constructor to prevent object creation
+   */
+  ClKernelTuner() = default;
+
+  /**
+   * @brief create cache key from the device name, operation and shape
+   */
+  std::string makeKey(const std::string &op,
+                      const std::vector<unsigned int> &shape);
+
+  static constexpr unsigned int NUM_TUNE_TRIALS = 3; /**< timed runs */
+
+  std::mutex tune_mutex; /**< guards tuned_params */
+  bool tuning = false;   /**< time the candidates on a cache miss */
+  std::string device_name; /**< cached name of the current device */
+  size_t max_work_group_size = 0; /**< cached device limit */
+  std::unordered_map<std::string, ClKernelTuneParam>
+    tuned_params; /**< key -> best configuration */
+};
+
+} // namespace nntrainer
+
+#endif /* __CL_KERNEL_TUNER_H__ */
@@ -92,6 +92,20 @@ static inline uint32_t vaddvq_u32(uint32x4_t a) {
   return ret;
 }
 
+/**
+ * @brief vaddvq_s32
+ *
+ * @param a input vector
+ * @return int32_t
+ */
+static inline int32_t vaddvq_s32(int32x4_t a) {
+  int32_t ret = a[0];
+  for (unsigned int i = 1; i < 4; ++i) {
+    ret += a[i];
+  }
+  return ret;
+}
+
 static inline int32x4_t vcvtnq_s32_f32(float32x4_t a) {
   int32x4_t ret;
   for (unsigned int i = 0; i < 4; ++i) {
@@ -906,4 +906,71 @@ void exp_i(const unsigned int N, float *X) {
   }
 }
 
+void qgemm_s8(const unsigned int M, const unsigned int N, const unsigned int K,
+              const int8_t *A, const float *a_scales, const int8_t *B,
+              const float *b_scales, bool trans_b, const float *bias,
+              float *C) {
+  for (unsigned int m = 0; m < M; ++m) {
+    const int8_t *a = A + (size_t)m * K;
+    float *c = C + (size_t)m * N;
+
+    if (trans_b) {
+      for (unsigned int n = 0; n < N; ++n) {
+        const int8_t *b = B + (size_t)n * K;
+        int32x4_t acc = vdupq_n_s32(0);
+        unsigned int k = 0;
+        for (; K - k >= 16; k += 16) {
+          int8x16_t va = vld1q_s8(a + k);
+          int8x16_t vb = vld1q_s8(b + k);
+#ifdef __ARM_FEATURE_DOTPROD
+          acc = vdotq_s32(acc, va, vb);
+#else
+          /// |a| <= 127, so a pair of products fits int16
+          int16x8_t p = vmull_s8(vget_low_s8(va), vget_low_s8(vb));
+          p = vmlal_s8(p, vget_high_s8(va), vget_high_s8(vb));
+          acc = vpadalq_s16(acc, p);
+#endif
+        }
+        int32_t sum = vaddvq_s32(acc);
+        for (; k < K; ++k)
+          sum += static_cast<int32_t>(a[k]) * b[k];
+        c[n] = sum * a_scales[m] * b_scales[n] + (bias ? bias[n] : 0.0f);
+      }
+      continue;
+    }
+
+    const float32x4_t a_scale = vdupq_n_f32(a_scales[m]);
+    unsigned int n = 0;
+    for (; N - n >= 16; n += 16) {
+      int32x4_t acc[4] = {vdupq_n_s32(0), vdupq_n_s32(0), vdupq_n_s32(0),
+                          vdupq_n_s32(0)};
+      for (unsigned int k = 0; k < K; ++k) {
+        int8x16_t vb = vld1q_s8(B + (size_t)k * N + n);
+        int16x8_t lo = vmovl_s8(vget_low_s8(vb));
+        int16x8_t hi = vmovl_s8(vget_high_s8(vb));
+        int16_t s = a[k];
+        acc[0] = vmlal_n_s16(acc[0], vget_low_s16(lo), s);
+        acc[1] = vmlal_n_s16(acc[1], vget_high_s16(lo), s);
+        acc[2] = vmlal_n_s16(acc[2], vget_low_s16(hi), s);
+        acc[3] = vmlal_n_s16(acc[3], vget_high_s16(hi), s);
+      }
+
+      for (unsigned int j = 0; j < 4; ++j) {
+        float32x4_t scale = vmulq_f32(a_scale, vld1q_f32(b_scales + n + 4 * j));
+        float32x4_t v = vmulq_f32(vcvtq_f32_s32(acc[j]), scale);
+        if (bias)
+          v = vaddq_f32(v, vld1q_f32(bias + n + 4 * j));
+        vst1q_f32(c + n + 4 * j, v);
+      }
+    }
+
+    for (; n < N; ++n) {
+      int32_t sum = 0;
+      for (unsigned int k = 0; k < K; ++k)
+        sum += static_cast<int32_t>(a[k]) * B[(size_t)k * N + n];
+      c[n] = sum * a_scales[m] * b_scales[n] + (bias ? bias[n] : 0.0f);
+    }
+  }
+}
+
 } // namespace nntrainer::neon
@@ -558,6 +558,27 @@ void ele_div(const unsigned N, const float *X, const float *Y, float *Z,
 void transpose_matrix(const unsigned int M, const unsigned int N,
                       const float *src, unsigned int ld_src, float *dst,
                       unsigned int ld_dst);
+
+/**
+ * @brief int8 gemm accumulating in int32 with the dequantization and the bias
+ * fused, C[m][n] = a_scales[m] * b_scales[n] * sum_k A[m][k] * B[k][n]
+ * + bias[n]. The transposed layout uses sdot when built with the dot product
+ * extension (enable-arm-dotprod).
+ *
+ * @param M number of rows of A and C
+ * @param N number of columns of B and C
+ * @param K number of columns of A and rows of B
+ * @param A int8_t * for row major M x K Matrix A, in [-127, 127]
+ * @param a_scales float * for the M scales of the rows of A
+ * @param B int8_t * for row major K x N Matrix B, or N x K if trans_b
+ * @param b_scales float * for the N scales of the columns of B
+ * @param trans_b B is stored transposed
+ * @param bias float * for bias of size N, nullptr if none
+ * @param C float * for row major M x N Matrix C
+ */
+void qgemm_s8(const unsigned int M, const unsigned int N, const unsigned int K,
+              const int8_t *A, const float *a_scales, const int8_t *B,
+              const float *b_scales, bool trans_b, const float *bias, float *C);
 } // namespace nntrainer::neon
 
 #endif /* __cplusplus */
@@ -13,6 +13,9 @@
 
 #include <cblas.h>
 #include <cblas_interface.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace nntrainer {
 void __cblas_saxpy(const unsigned int N, const float alpha, const float *X,
@@ -85,6 +88,42 @@ void __cblas_sgemm(const unsigned int TStorageOrder, bool TransA, bool TransB,
               ldc);
 }
 
+void __cblas_sgemm_strided_batched(const unsigned int TStorageOrder,
+                                   bool TransA, bool TransB,
+                                   const unsigned int batch,
+                                   const unsigned int M, const unsigned int N,
+                                   const unsigned int K, const float alpha,
+                                   const float *A, const unsigned int lda,
+                                   const size_t strideA, const float *B,
+                                   const unsigned int ldb, const size_t strideB,
+                                   const float beta, float *C,
+                                   const unsigned int ldc,
+                                   const size_t strideC) {
+  CBLAS_TRANSPOSE transA = TransA ? CblasTrans : CblasNoTrans;
+  CBLAS_TRANSPOSE transB = TransB ? CblasTrans : CblasNoTrans;
+  CBLAS_ORDER order = TStorageOrder ? CblasColMajor : CblasRowMajor;
+#ifdef BLAS_NUM_THREADS
+  openblas_set_num_threads(BLAS_NUM_THREADS);
+#endif
+  /// products up to this many multiply-adds do not keep the threads of the
+  /// library busy, so the batch is split across threads instead. The
+  /// threading of the library is process wide and left as is, so the batch is
+  /// split only if the library runs single threaded and no parallel region
+  /// runs already, which keeps the cores from being oversubscribed
+  constexpr size_t parallel_batch_work = 128 * 128 * 128;
+  bool parallel_batch = batch > 1 &&
+                        (size_t)M * N * K <= parallel_batch_work &&
+                        openblas_get_num_threads() == 1;
+#ifdef _OPENMP
+  parallel_batch = parallel_batch && !omp_in_parallel();
+#endif
+
+#pragma omp parallel for schedule(static) if (parallel_batch)
+  for (int b = 0; b < (int)batch; ++b)
+    cblas_sgemm(order, transA, transB, M, N, K, alpha, A + b * strideA, lda,
+                B + b * strideB, ldb, beta, C + b * strideC, ldc);
+}
+
 unsigned int __cblas_isamax(const unsigned int N, const float *X,
                             const unsigned int incX) {
 #ifdef BLAS_NUM_THREADS
@@ -15,6 +15,8 @@
 #define __CBLAS_INTERFACE_H__
 #ifdef __cplusplus
 
+#include <cstddef>
+
 namespace nntrainer {
 /**
  * @brief     saxpy computation : Y = alpha*X + Y
@@ -92,6 +94,35 @@ void __cblas_sgemm(const unsigned int TStorageOrder, bool TransA, bool TransB,
                    const unsigned int lda, const float *B,
                    const unsigned int ldb, const float beta, float *C,
                    const unsigned int ldc);
+/**
+ * @brief     strided batched sgemm computation : Y_i = alpha*op(A_i)*op(B_i) +
+ * beta*C_i for i in [0, batch), where X_i = X + i * strideX. Small products
+ * run in parallel across the batch if the library is single threaded and no
+ * parallel region runs, others use the threads of the library
+ * @param[in] batch number of the matrix products
+ * @param[in] A float * for the first Matrix A
+ * @param[in] strideA elements between the Matrices A, 0 to share one Matrix
+ * @param[in] B float * for the first Matrix B
+ * @param[in] strideB elements between the Matrices B, 0 to share one Matrix
+ * @param[in] C float * for the first Matrix C
+ * @param[in] strideC elements between the Matrices C
+ * @param[in] M number of op(A)'s and C's row
+ * @param[in] N number of op(B)'s and C's columns
+ * @param[in] K number of op(A)'s and columns and op(B)'s rows
+ * @param[in] alpha float number
+ * @param[in] beta float number
+ */
+void __cblas_sgemm_strided_batched(const unsigned int TStorageOrder,
+                                   bool TransA, bool TransB,
+                                   const unsigned int batch,
+                                   const unsigned int M, const unsigned int N,
+                                   const unsigned int K, const float alpha,
+                                   const float *A, const unsigned int lda,
+                                   const size_t strideA, const float *B,
+                                   const unsigned int ldb, const size_t strideB,
+                                   const float beta, float *C,
+                                   const unsigned int ldc,
+                                   const size_t strideC);
 /**
  * @brief     isamax function : index of first maxima
  * @param[in] N number of elements in X
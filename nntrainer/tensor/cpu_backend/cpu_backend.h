@@ -189,6 +189,33 @@ extern void sgemm(const unsigned int TStorageOrder, bool TransA, bool TransB,
                   const unsigned int lda, const _FP16 *B,
                   const unsigned int ldb, const float beta, _FP16 *C,
                   const unsigned int ldc);
+/**
+ * @brief     strided batched sgemm computation : Y_i = alpha*op(A_i)*op(B_i) +
+ * beta*C_i for i in [0, batch), where X_i = X + i * strideX
+ * @param[in] batch number of the matrix products
+ * @param[in] A _FP16 * for the first Matrix A
+ * @param[in] strideA elements between the Matrices A, 0 to share one Matrix
+ * @param[in] B _FP16 * for the first Matrix B
+ * @param[in] strideB elements between the Matrices B, 0 to share one Matrix
+ * @param[in] C _FP16 * for the first Matrix C
+ * @param[in] strideC elements between the Matrices C
+ * @param[in] M number of op(A)'s and C's row
+ * @param[in] N number of op(B)'s and C's columns
+ * @param[in] K number of op(A)'s and columns and op(B)'s rows
+ * @param[in] alpha float number
+ * @param[in] beta float number
+ */
+extern void sgemm_strided_batched(const unsigned int TStorageOrder,
+                                  bool TransA, bool TransB,
+                                  const unsigned int batch,
+                                  const unsigned int M, const unsigned int N,
+                                  const unsigned int K, const float alpha,
+                                  const _FP16 *A, const unsigned int lda,
+                                  const size_t strideA, const _FP16 *B,
+                                  const unsigned int ldb, const size_t strideB,
+                                  const float beta, _FP16 *C,
+                                  const unsigned int ldc,
+                                  const size_t strideC);
 /**
  * @brief     sgemv computation : Y = alpha*A*X + beta*Y
  * @param[in] A float * for Matrix A
@@ -340,6 +367,118 @@ extern float max_val(const unsigned int N, float *X);
  */
 extern void softmax(const unsigned int N, float *X, float *Y);
 
+/**
+ * @brief epilogue of a gemm, C = C + bias followed by ReLU when requested.
+ * The bias is added per row or per column of the row major M x N matrix C
+ *
+ * @param M number of rows of C
+ * @param N number of columns of C
+ * @param C float * for Matrix C
+ * @param row_bias float * for bias of size M, nullptr if none
+ * @param col_bias float * for bias of size N, nullptr if none
+ * @param relu clamp the result to zero from below
+ */
+extern void gemm_epilogue(const unsigned int M, const unsigned int N, float *C,
+                          const float *row_bias, const float *col_bias,
+                          bool relu);
+
+/**
+ * @brief quantize each row of a row major M x K matrix to int8 with a
+ * symmetric scale of its own, Y = round(X / scale) in [-127, 127]
+ *
+ * @param M number of rows of X
+ * @param K number of columns of X
+ * @param X float * for Matrix X
+ * @param Y int8_t * for quantized Matrix Y
+ * @param scales float * for the M scales, max |x| / 127 of each row
+ */
+extern void quantize_rows_s8(const unsigned int M, const unsigned int K,
+                             const float *X, int8_t *Y, float *scales);
+
+/**
+ * @brief int8 gemm accumulating in int32 with the dequantization and the bias
+ * fused, C[m][n] = a_scales[m] * b_scales[n] * sum_k A[m][k] * B[k][n]
+ * + bias[n]
+ *
+ * @param M number of rows of A and C
+ * @param N number of columns of B and C
+ * @param K number of columns of A and rows of B
+ * @param A int8_t * for row major M x K Matrix A, in [-127, 127]
+ * @param a_scales float * for the M scales of the rows of A
+ * @param B int8_t * for row major K x N Matrix B, or N x K if trans_b
+ * @param b_scales float * for the N scales of the columns of B
+ * @param trans_b B is stored transposed
+ * @param bias float * for bias of size N, nullptr if none
+ * @param C float * for row major M x N Matrix C
+ */
+extern void qgemm_s8(const unsigned int M, const unsigned int N,
+                     const unsigned int K, const int8_t *A,
+                     const float *a_scales, const int8_t *B,
+                     const float *b_scales, bool trans_b, const float *bias,
+                     float *C);
+
+/**
+ * @brief fake quantization of a row major M x N matrix to the grid of a
+ * symmetric quantization, Y = clamp(round(X / scale), quant_min, quant_max) *
+ * scale with a scale per row or per column
+ *
+ * @param M number of rows of X
+ * @param N number of columns of X
+ * @param X float * for Matrix X
+ * @param Y float * for Matrix Y, may be X
+ * @param scales float * for the M positive scales of the rows, or the N of the
+ * columns if col_scales
+ * @param col_scales the scales are of the columns
+ * @param quant_min smallest quantized value
+ * @param quant_max largest quantized value
+ */
+extern void fake_quantize(const unsigned int M, const unsigned int N,
+                          const float *X, float *Y, const float *scales,
+                          bool col_scales, const float quant_min,
+                          const float quant_max);
+
+/**
+ * @brief straight through gradient of the fake quantization with a single
+ * scale, dX = dY where quant_min <= round(X / scale) <= quant_max and 0
+ * elsewhere
+ *
+ * @param N number of elements of X
+ * @param X float * for Vector X, the input of the fake quantization
+ * @param dY float * for Vector dY, the derivative of the output
+ * @param dX float * for Vector dX, the derivative of the input, may be dY
+ * @param scale positive scale of the quantization
+ * @param quant_min smallest quantized value
+ * @param quant_max largest quantized value
+ */
+extern void fake_quantize_grad(const unsigned int N, const float *X,
+                               const float *dY, float *dX, const float scale,
+                               const float quant_min, const float quant_max);
+
+/**
+ * @brief segmented gather gemm of low rank adapters : the rows of a segment
+ * s take the adapter a = adapters[s], T_s = X_s * A_a and
+ * Y_s = Y_s + alpha * T_s * B_a, where the segment s spans the rows from
+ * seg_start[s] to seg_start[s + 1]
+ *
+ * @param num_segments number of the segments
+ * @param seg_start row where each segment starts, and the end of the last
+ * @param adapters adapter of each segment, negative to leave the rows be
+ * @param K number of columns of X and rows of A_a
+ * @param N number of columns of Y and B_a
+ * @param R rank, the number of columns of A_a and rows of B_a
+ * @param alpha scaling of the low rank product
+ * @param X float * for Matrix X of the input rows
+ * @param A float * for the K x R Matrices A_a, stacked
+ * @param B float * for the R x N Matrices B_a, stacked
+ * @param T float * for Matrix T of the rows x R intermediate products
+ * @param Y float * for Matrix Y of the output rows, accumulated
+ */
+extern void lora_sgmv(const unsigned int num_segments,
+                      const unsigned int *seg_start, const int *adapters,
+                      const unsigned int K, const unsigned int N,
+                      const unsigned int R, const float alpha, const float *X,
+                      const float *A, const float *B, float *T, float *Y);
+
 /**
  * @brief Matrix transpose / 2D Tensor transpose
  *
@@ -481,6 +620,33 @@ extern void sgemm(const unsigned int TStorageOrder, bool TransA, bool TransB,
                   const unsigned int lda, const float *B,
                   const unsigned int ldb, const float beta, float *C,
                   const unsigned int ldc);
+/**
+ * @brief     strided batched sgemm computation : Y_i = alpha*op(A_i)*op(B_i) +
+ * beta*C_i for i in [0, batch), where X_i = X + i * strideX
+ * @param[in] batch number of the matrix products
+ * @param[in] A float * for the first Matrix A
+ * @param[in] strideA elements between the Matrices A, 0 to share one Matrix
+ * @param[in] B float * for the first Matrix B
+ * @param[in] strideB elements between the Matrices B, 0 to share one Matrix
+ * @param[in] C float * for the first Matrix C
+ * @param[in] strideC elements between the Matrices C
+ * @param[in] M number of op(A)'s and C's row
+ * @param[in] N number of op(B)'s and C's columns
+ * @param[in] K number of op(A)'s and columns and op(B)'s rows
+ * @param[in] alpha float number
+ * @param[in] beta float number
+ */
+extern void sgemm_strided_batched(const unsigned int TStorageOrder,
+                                  bool TransA, bool TransB,
+                                  const unsigned int batch,
+                                  const unsigned int M, const unsigned int N,
+                                  const unsigned int K, const float alpha,
+                                  const float *A, const unsigned int lda,
+                                  const size_t strideA, const float *B,
+                                  const unsigned int ldb, const size_t strideB,
+                                  const float beta, float *C,
+                                  const unsigned int ldc,
+                                  const size_t strideC);
 /**
  * @brief     sgemv computation  : Y = alpha*A*X + beta*Y
  * @param[in] A float * for Matrix A
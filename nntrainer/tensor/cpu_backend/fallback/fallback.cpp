@@ -116,6 +116,20 @@ void sgemm(const unsigned int TStorageOrder, bool TransA, bool TransB,
                    ldb, beta, C, ldc);
 }
 
+void sgemm_strided_batched(const unsigned int TStorageOrder, bool TransA,
+                           bool TransB, const unsigned int batch,
+                           const unsigned int M, const unsigned int N,
+                           const unsigned int K, const float alpha,
+                           const float *A, const unsigned int lda,
+                           const size_t strideA, const float *B,
+                           const unsigned int ldb, const size_t strideB,
+                           const float beta, float *C, const unsigned int ldc,
+                           const size_t strideC) {
+  __fallback_sgemm_strided_batched(TStorageOrder, TransA, TransB, batch, M, N,
+                                   K, alpha, A, lda, strideA, B, ldb, strideB,
+                                   beta, C, ldc, strideC);
+}
+
 unsigned int isamax(const unsigned int N, const float *X,
                     const unsigned int incX) {
   return __fallback_isamax(N, X, incX);
@@ -167,4 +181,42 @@ float max_val(const unsigned int N, float *X) { return __fallback_max(N, X); }
 void softmax(const unsigned int N, float *X, float *Y) {
   __fallback_softmax(N, X, Y);
 }
+
+void gemm_epilogue(const unsigned int M, const unsigned int N, float *C,
+                   const float *row_bias, const float *col_bias, bool relu) {
+  __fallback_gemm_epilogue(M, N, C, row_bias, col_bias, relu);
+}
+
+void quantize_rows_s8(const unsigned int M, const unsigned int K,
+                      const float *X, int8_t *Y, float *scales) {
+  __fallback_quantize_rows_s8(M, K, X, Y, scales);
+}
+
+void qgemm_s8(const unsigned int M, const unsigned int N, const unsigned int K,
+              const int8_t *A, const float *a_scales, const int8_t *B,
+              const float *b_scales, bool trans_b, const float *bias,
+              float *C) {
+  __fallback_qgemm_s8(M, N, K, A, a_scales, B, b_scales, trans_b, bias, C);
+}
+
+void fake_quantize(const unsigned int M, const unsigned int N, const float *X,
+                   float *Y, const float *scales, bool col_scales,
+                   const float quant_min, const float quant_max) {
+  __fallback_fake_quantize(M, N, X, Y, scales, col_scales, quant_min,
+                           quant_max);
+}
+
+void fake_quantize_grad(const unsigned int N, const float *X, const float *dY,
+                        float *dX, const float scale, const float quant_min,
+                        const float quant_max) {
+  __fallback_fake_quantize_grad(N, X, dY, dX, scale, quant_min, quant_max);
+}
+
+void lora_sgmv(const unsigned int num_segments, const unsigned int *seg_start,
+               const int *adapters, const unsigned int K, const unsigned int N,
+               const unsigned int R, const float alpha, const float *X,
+               const float *A, const float *B, float *T, float *Y) {
+  __fallback_lora_sgmv(num_segments, seg_start, adapters, K, N, R, alpha, X, A,
+                       B, T, Y);
+}
 } /* namespace nntrainer */
@@ -84,6 +84,20 @@ void sgemm(const unsigned int TStorageOrder, bool TransA, bool TransB,
                    ldb, beta, C, ldc);
 }
 
+void sgemm_strided_batched(const unsigned int TStorageOrder, bool TransA,
+                           bool TransB, const unsigned int batch,
+                           const unsigned int M, const unsigned int N,
+                           const unsigned int K, const float alpha,
+                           const _FP16 *A, const unsigned int lda,
+                           const size_t strideA, const _FP16 *B,
+                           const unsigned int ldb, const size_t strideB,
+                           const float beta, _FP16 *C, const unsigned int ldc,
+                           const size_t strideC) {
+  __fallback_sgemm_strided_batched(TStorageOrder, TransA, TransB, batch, M, N,
+                                   K, alpha, A, lda, strideA, B, ldb, strideB,
+                                   beta, C, ldc, strideC);
+}
+
 void sgemv(const unsigned int TStorageOrder, bool TransA, const unsigned int M,
            const unsigned int N, const float alpha, const _FP16 *A,
            const unsigned int lda, const _FP16 *X, const unsigned int incX,
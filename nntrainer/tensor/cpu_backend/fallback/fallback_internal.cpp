@@ -15,10 +15,13 @@
 #include <assert.h>
 #include <climits>
 #include <cmath>
+#include <cpu_backend.h>
 #include <cstdint>
 #include <fallback_internal.h>
+#include <numeric>
 #include <stdexcept>
 #include <tensor_dim.h>
+#include <vector>
 
 #define sgemv_loop(ci, cj, cM, cN)                                             \
   do {                                                                         \
@@ -170,6 +173,25 @@ void __fallback_sgemm(const unsigned int TStorageOrder, bool TransA,
   }
 }
 
+void __fallback_sgemm_strided_batched(const unsigned int TStorageOrder,
+                                      bool TransA, bool TransB,
+                                      const unsigned int batch,
+                                      const unsigned int M,
+                                      const unsigned int N,
+                                      const unsigned int K, const float alpha,
+                                      const float *A, const unsigned int lda,
+                                      const size_t strideA, const float *B,
+                                      const unsigned int ldb,
+                                      const size_t strideB, const float beta,
+                                      float *C, const unsigned int ldc,
+                                      const size_t strideC) {
+#pragma omp parallel for schedule(static) if (batch > 1)
+  for (int b = 0; b < (int)batch; ++b)
+    __fallback_sgemm(TStorageOrder, TransA, TransB, M, N, K, alpha,
+                     A + b * strideA, lda, B + b * strideB, ldb, beta,
+                     C + b * strideC, ldc);
+}
+
 void __fallback_sgemv(const unsigned int TStorageOrder, bool TransA,
                       const unsigned int M, const unsigned int N,
                       const float alpha, const float *A, const unsigned int lda,
@@ -267,9 +289,17 @@ void __fallback_ele_div(const unsigned N, const float *X, const float *Y,
 void __fallback_transpose_matrix(const unsigned int M, const unsigned int N,
                                  const float *src, unsigned int ld_src,
                                  float *dst, unsigned int ld_dst) {
-  for (unsigned int i = 0; i < M; i++) {
-    for (unsigned int j = 0; j < N; j++) {
-      dst[i + j * ld_dst] = src[i * ld_src + j];
+  /// tiles keep both the rows read and the rows written in cache
+  constexpr unsigned int tile = 32;
+  for (unsigned int i0 = 0; i0 < M; i0 += tile) {
+    const unsigned int i1 = std::min(i0 + tile, M);
+    for (unsigned int j0 = 0; j0 < N; j0 += tile) {
+      const unsigned int j1 = std::min(j0 + tile, N);
+      for (unsigned int i = i0; i < i1; i++) {
+        for (unsigned int j = j0; j < j1; j++) {
+          dst[i + j * ld_dst] = src[i * ld_src + j];
+        }
+      }
     }
   }
 }
@@ -319,4 +349,157 @@ void __fallback_softmax(const unsigned int N, float *X, float *Y) {
     ++i;
   }
 }
+
+void __fallback_gemm_epilogue(const unsigned int M, const unsigned int N,
+                              float *C, const float *row_bias,
+                              const float *col_bias, bool relu) {
+  /// one pass over each row while it is in cache
+  for (unsigned int i = 0; i < M; ++i) {
+    float *row = C + (size_t)i * N;
+    const float bias = row_bias ? row_bias[i] : 0.0f;
+    if (col_bias) {
+      for (unsigned int j = 0; j < N; ++j)
+        row[j] += bias + col_bias[j];
+    } else if (row_bias) {
+      for (unsigned int j = 0; j < N; ++j)
+        row[j] += bias;
+    }
+    if (relu) {
+      for (unsigned int j = 0; j < N; ++j)
+        row[j] = std::max(row[j], 0.0f);
+    }
+  }
+}
+
+void __fallback_quantize_rows_s8(const unsigned int M, const unsigned int K,
+                                 const float *X, int8_t *Y, float *scales) {
+  for (unsigned int i = 0; i < M; ++i) {
+    const float *row = X + (size_t)i * K;
+    float amax = 0.0f;
+    for (unsigned int k = 0; k < K; ++k)
+      amax = std::max(amax, std::abs(row[k]));
+
+    scales[i] = amax / 127.0f;
+    const float inv_scale = amax > 0.0f ? 127.0f / amax : 0.0f;
+    for (unsigned int k = 0; k < K; ++k)
+      Y[(size_t)i * K + k] = static_cast<int8_t>(
+        std::clamp(std::nearbyint(row[k] * inv_scale), -127.0f, 127.0f));
+  }
+}
+
+void __fallback_qgemm_s8(const unsigned int M, const unsigned int N,
+                         const unsigned int K, const int8_t *A,
+                         const float *a_scales, const int8_t *B,
+                         const float *b_scales, bool trans_b, const float *bias,
+                         float *C) {
+  std::vector<int32_t> acc(N);
+  for (unsigned int i = 0; i < M; ++i) {
+    const int8_t *a = A + (size_t)i * K;
+    std::fill(acc.begin(), acc.end(), 0);
+    if (trans_b) {
+      for (unsigned int j = 0; j < N; ++j) {
+        const int8_t *b = B + (size_t)j * K;
+        for (unsigned int k = 0; k < K; ++k)
+          acc[j] += (int32_t)a[k] * b[k];
+      }
+    } else {
+      for (unsigned int k = 0; k < K; ++k) {
+        const int8_t *b = B + (size_t)k * N;
+        for (unsigned int j = 0; j < N; ++j)
+          acc[j] += (int32_t)a[k] * b[j];
+      }
+    }
+
+    float *c = C + (size_t)i * N;
+    for (unsigned int j = 0; j < N; ++j)
+      c[j] = acc[j] * a_scales[i] * b_scales[j] + (bias ? bias[j] : 0.0f);
+  }
+}
+
+void __fallback_fake_quantize(const unsigned int M, const unsigned int N,
+                              const float *X, float *Y, const float *scales,
+                              bool col_scales, const float quant_min,
+                              const float quant_max) {
+  for (unsigned int i = 0; i < M; ++i) {
+    const float *x = X + (size_t)i * N;
+    float *y = Y + (size_t)i * N;
+    for (unsigned int j = 0; j < N; ++j) {
+      const float scale = col_scales ? scales[j] : scales[i];
+      const float q = std::round(x[j] / scale);
+      y[j] = std::clamp(q, quant_min, quant_max) * scale;
+    }
+  }
+}
+
+void __fallback_fake_quantize_grad(const unsigned int N, const float *X,
+                                   const float *dY, float *dX,
+                                   const float scale, const float quant_min,
+                                   const float quant_max) {
+  for (unsigned int i = 0; i < N; ++i) {
+    const float q = std::round(X[i] / scale);
+    dX[i] = (q >= quant_min && q <= quant_max) ? dY[i] : 0.0f;
+  }
+}
+
+void __fallback_lora_sgmv(const unsigned int num_segments,
+                          const unsigned int *seg_start, const int *adapters,
+                          const unsigned int K, const unsigned int N,
+                          const unsigned int R, const float alpha,
+                          const float *X, const float *A, const float *B,
+                          float *T, float *Y) {
+  /// the segments of an adapter are gathered so that every adapter runs a
+  /// single pair of gemms however its rows are spread over the batch
+  std::vector<unsigned int> order(num_segments);
+  std::iota(order.begin(), order.end(), 0u);
+  std::stable_sort(order.begin(), order.end(),
+                   [adapters](unsigned int a, unsigned int b) {
+                     return adapters[a] < adapters[b];
+                   });
+
+  std::vector<float> X_g, Y_g;
+  for (unsigned int i = 0, j = 0; i < num_segments; i = j) {
+    const int adapter = adapters[order[i]];
+    unsigned int M = 0;
+    for (j = i; j < num_segments && adapters[order[j]] == adapter; ++j)
+      M += seg_start[order[j] + 1] - seg_start[order[j]];
+    if (adapter < 0)
+      continue;
+
+    const float *A_a = A + (size_t)adapter * K * R;
+    const float *B_a = B + (size_t)adapter * R * N;
+    if (j - i == 1) {
+      const size_t row = seg_start[order[i]];
+      sgemm(0, false, false, M, R, K, 1.0f, X + row * K, K, A_a, R, 0.0f,
+            T + row * R, R);
+      sgemm(0, false, false, M, N, R, alpha, T + row * R, R, B_a, N, 1.0f,
+            Y + row * N, N);
+      continue;
+    }
+
+    X_g.resize((size_t)M * K);
+    Y_g.resize((size_t)M * N);
+    size_t g = 0;
+    for (unsigned int s = i; s < j; ++s) {
+      const unsigned int seg = order[s];
+      const size_t len = seg_start[seg + 1] - seg_start[seg];
+      std::copy(X + seg_start[seg] * (size_t)K,
+                X + (seg_start[seg] + len) * K, X_g.data() + g * K);
+      g += len;
+    }
+
+    sgemm(0, false, false, M, R, K, 1.0f, X_g.data(), K, A_a, R, 0.0f, T, R);
+    sgemm(0, false, false, M, N, R, alpha, T, R, B_a, N, 0.0f, Y_g.data(), N);
+
+    g = 0;
+    for (unsigned int s = i; s < j; ++s) {
+      const unsigned int seg = order[s];
+      const size_t len = seg_start[seg + 1] - seg_start[seg];
+      float *y = Y + seg_start[seg] * (size_t)N;
+      const float *y_g = Y_g.data() + g * N;
+      for (size_t k = 0; k < len * N; ++k)
+        y[k] += y_g[k];
+      g += len;
+    }
+  }
+}
 } // namespace nntrainer
@@ -199,6 +199,25 @@ void __fallback_sgemm(const unsigned int TStorageOrder, bool TransA,
   hgemm_loop();
 }
 
+void __fallback_sgemm_strided_batched(const unsigned int TStorageOrder,
+                                      bool TransA, bool TransB,
+                                      const unsigned int batch,
+                                      const unsigned int M,
+                                      const unsigned int N,
+                                      const unsigned int K, const float alpha,
+                                      const _FP16 *A, const unsigned int lda,
+                                      const size_t strideA, const _FP16 *B,
+                                      const unsigned int ldb,
+                                      const size_t strideB, const float beta,
+                                      _FP16 *C, const unsigned int ldc,
+                                      const size_t strideC) {
+#pragma omp parallel for schedule(static) if (batch > 1)
+  for (int b = 0; b < (int)batch; ++b)
+    __fallback_sgemm(TStorageOrder, TransA, TransB, M, N, K, alpha,
+                     A + b * strideA, lda, B + b * strideB, ldb, beta,
+                     C + b * strideC, ldc);
+}
+
 void __fallback_sgemv(const unsigned int TStorageOrder, bool TransA,
                       const unsigned int M, const unsigned int N,
                       const float alpha, const _FP16 *A, const unsigned int lda,
@@ -279,9 +298,17 @@ void __fallback_inv_sqrt_inplace(const unsigned int N, _FP16 *X) {
 void __fallback_transpose_matrix(const unsigned int M, const unsigned int N,
                                  const _FP16 *src, unsigned int ld_src,
                                  _FP16 *dst, unsigned int ld_dst) {
-  for (unsigned int i = 0; i < M; i++) {
-    for (unsigned int j = 0; j < N; j++) {
-      dst[i + j * ld_dst] = src[i * ld_src + j];
+  /// tiles keep both the rows read and the rows written in cache
+  constexpr unsigned int tile = 32;
+  for (unsigned int i0 = 0; i0 < M; i0 += tile) {
+    const unsigned int i1 = std::min(i0 + tile, M);
+    for (unsigned int j0 = 0; j0 < N; j0 += tile) {
+      const unsigned int j1 = std::min(j0 + tile, N);
+      for (unsigned int i = i0; i < i1; i++) {
+        for (unsigned int j = j0; j < j1; j++) {
+          dst[i + j * ld_dst] = src[i * ld_src + j];
+        }
+      }
     }
   }
 }
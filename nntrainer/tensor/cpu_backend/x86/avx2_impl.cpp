@@ -12,15 +12,126 @@
  *
  */
 
+#include <algorithm>
 #include <avx2_impl.h>
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <immintrin.h>
 #include <limits>
+#include <vector>
 
 namespace nntrainer::avx2 {
 
+namespace {
+
+/**
+ * @brief transpose a 8x8 block of float with AVX registers
+ */
+inline void transpose_8x8(const float *src, unsigned int ld_src, float *dst,
+                          unsigned int ld_dst) {
+  __m256 r0 = _mm256_loadu_ps(src);
+  __m256 r1 = _mm256_loadu_ps(src + ld_src);
+  __m256 r2 = _mm256_loadu_ps(src + 2 * ld_src);
+  __m256 r3 = _mm256_loadu_ps(src + 3 * ld_src);
+  __m256 r4 = _mm256_loadu_ps(src + 4 * ld_src);
+  __m256 r5 = _mm256_loadu_ps(src + 5 * ld_src);
+  __m256 r6 = _mm256_loadu_ps(src + 6 * ld_src);
+  __m256 r7 = _mm256_loadu_ps(src + 7 * ld_src);
+
+  __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+  __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+  __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+  __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+  __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+  __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+  __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+  __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+  r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+  r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+  r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  r4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+  r5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+  r6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+  r7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+  _mm256_storeu_ps(dst, _mm256_permute2f128_ps(r0, r4, 0x20));
+  _mm256_storeu_ps(dst + ld_dst, _mm256_permute2f128_ps(r1, r5, 0x20));
+  _mm256_storeu_ps(dst + 2 * ld_dst, _mm256_permute2f128_ps(r2, r6, 0x20));
+  _mm256_storeu_ps(dst + 3 * ld_dst, _mm256_permute2f128_ps(r3, r7, 0x20));
+  _mm256_storeu_ps(dst + 4 * ld_dst, _mm256_permute2f128_ps(r0, r4, 0x31));
+  _mm256_storeu_ps(dst + 5 * ld_dst, _mm256_permute2f128_ps(r1, r5, 0x31));
+  _mm256_storeu_ps(dst + 6 * ld_dst, _mm256_permute2f128_ps(r2, r6, 0x31));
+  _mm256_storeu_ps(dst + 7 * ld_dst, _mm256_permute2f128_ps(r3, r7, 0x31));
+}
+
+/**
+ * @brief transpose a 8x8 block of 16-bit data with SSE registers
+ */
+inline void transpose_8x8(const uint16_t *src, unsigned int ld_src,
+                          uint16_t *dst, unsigned int ld_dst) {
+  __m128i r[8], t[8];
+  for (unsigned int i = 0; i < 8; ++i)
+    r[i] = _mm_loadu_si128((const __m128i *)(src + i * ld_src));
+
+  for (unsigned int i = 0; i < 4; ++i) {
+    t[2 * i] = _mm_unpacklo_epi16(r[2 * i], r[2 * i + 1]);
+    t[2 * i + 1] = _mm_unpackhi_epi16(r[2 * i], r[2 * i + 1]);
+  }
+
+  r[0] = _mm_unpacklo_epi32(t[0], t[2]);
+  r[1] = _mm_unpackhi_epi32(t[0], t[2]);
+  r[2] = _mm_unpacklo_epi32(t[1], t[3]);
+  r[3] = _mm_unpackhi_epi32(t[1], t[3]);
+  r[4] = _mm_unpacklo_epi32(t[4], t[6]);
+  r[5] = _mm_unpackhi_epi32(t[4], t[6]);
+  r[6] = _mm_unpacklo_epi32(t[5], t[7]);
+  r[7] = _mm_unpackhi_epi32(t[5], t[7]);
+
+  for (unsigned int i = 0; i < 4; ++i) {
+    _mm_storeu_si128((__m128i *)(dst + 2 * i * ld_dst),
+                     _mm_unpacklo_epi64(r[i], r[i + 4]));
+    _mm_storeu_si128((__m128i *)(dst + (2 * i + 1) * ld_dst),
+                     _mm_unpackhi_epi64(r[i], r[i + 4]));
+  }
+}
+
+/**
+ * @brief transpose tile by tile so that both the rows read and the rows
+ * written by a tile stay in L1, 8x8 blocks of a tile move in registers
+ */
+template <typename T>
+void transpose_tiled(const unsigned int M, const unsigned int N, const T *src,
+                     unsigned int ld_src, T *dst, unsigned int ld_dst) {
+  constexpr unsigned int tile = 64;
+
+  for (unsigned int i0 = 0; i0 < M; i0 += tile) {
+    const unsigned int i1 = std::min(i0 + tile, M);
+    for (unsigned int j0 = 0; j0 < N; j0 += tile) {
+      const unsigned int j1 = std::min(j0 + tile, N);
+
+      unsigned int i = i0;
+      for (; i + 8 <= i1; i += 8) {
+        unsigned int j = j0;
+        for (; j + 8 <= j1; j += 8)
+          transpose_8x8(src + i * ld_src + j, ld_src, dst + j * ld_dst + i,
+                        ld_dst);
+        for (; j < j1; ++j)
+          for (unsigned int k = i; k < i + 8; ++k)
+            dst[j * ld_dst + k] = src[k * ld_src + j];
+      }
+      for (; i < i1; ++i)
+        for (unsigned int j = j0; j < j1; ++j)
+          dst[j * ld_dst + i] = src[i * ld_src + j];
+    }
+  }
+}
+
+} // namespace
+
 bool is_valid(const unsigned int N, const float *input) {
   assert(N != 0);
   assert(input != NULL);
@@ -118,4 +229,417 @@ void custom_scopy(const unsigned int N, const float *X, const int incX,
   }
 }
 
+void transpose_matrix(const unsigned int M, const unsigned int N,
+                      const float *src, unsigned int ld_src, float *dst,
+                      unsigned int ld_dst) {
+  transpose_tiled(M, N, src, ld_src, dst, ld_dst);
+}
+
+void transpose_matrix(const unsigned int M, const unsigned int N,
+                      const uint16_t *src, unsigned int ld_src, uint16_t *dst,
+                      unsigned int ld_dst) {
+  transpose_tiled(M, N, src, ld_src, dst, ld_dst);
+}
+
+namespace {
+
+/**
+ * @brief add the sums of 4 products of unsigned bytes of u and signed bytes
+ * of s to each 32-bit lane of acc
+ */
+inline __m256i dot_u8s8(__m256i acc, __m256i u, __m256i s) {
+#if defined(__AVX512VNNI__) && defined(__AVX512VL__)
+  return _mm256_dpbusd_epi32(acc, u, s);
+#elif defined(__AVXVNNI__)
+  return _mm256_dpbusd_avx_epi32(acc, u, s);
+#else
+  /// u <= 128 and |s| <= 127, so the pairwise sums do not saturate
+  const __m256i ones = _mm256_set1_epi16(1);
+  return _mm256_add_epi32(
+    acc, _mm256_madd_epi16(_mm256_maddubs_epi16(u, s), ones));
+#endif
+}
+
+/**
+ * @brief horizontal sum of 8 int32
+ */
+inline int32_t hsum_epi32(__m256i v) {
+  __m128i s =
+    _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+  s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+  s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(s);
+}
+
+/**
+ * @brief dequantize 8 int32 accumulators of a row and store them
+ */
+inline void store_dequantized(__m256i acc, float a_scale,
+                              const float *b_scales, const float *bias,
+                              float *c) {
+  __m256 scale =
+    _mm256_mul_ps(_mm256_set1_ps(a_scale), _mm256_loadu_ps(b_scales));
+  __m256 v = _mm256_mul_ps(_mm256_cvtepi32_ps(acc), scale);
+  if (bias)
+    v = _mm256_add_ps(v, _mm256_loadu_ps(bias));
+  _mm256_storeu_ps(c, v);
+}
+
+/**
+ * @brief 4 consecutive bytes of a row of A from k as an int32, zero padded
+ * past K
+ */
+inline int32_t load_quad(const int8_t *a, unsigned int k, unsigned int K) {
+  int32_t v;
+  if (k + 4 <= K) {
+    std::memcpy(&v, a + k, sizeof(v));
+    return v;
+  }
+
+  int8_t quad[4] = {0, 0, 0, 0};
+  for (unsigned int i = 0; i < 4 && k + i < K; ++i)
+    quad[i] = a[k + i];
+  std::memcpy(&v, quad, sizeof(v));
+  return v;
+}
+
+/**
+ * @brief 4 rows from k of 16 columns of a K x N matrix B interleaved so that
+ * each 32-bit lane holds the 4 k of a column, zero padded past K
+ */
+inline void interleave_quads(const int8_t *B, const unsigned int N,
+                             const unsigned int k, const unsigned int K,
+                             __m256i b[2]) {
+  __m128i rows[4];
+  for (unsigned int i = 0; i < 4; ++i)
+    rows[i] = k + i < K ? _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                            B + (size_t)(k + i) * N))
+                        : _mm_setzero_si128();
+
+  __m128i lo01 = _mm_unpacklo_epi8(rows[0], rows[1]);
+  __m128i hi01 = _mm_unpackhi_epi8(rows[0], rows[1]);
+  __m128i lo23 = _mm_unpacklo_epi8(rows[2], rows[3]);
+  __m128i hi23 = _mm_unpackhi_epi8(rows[2], rows[3]);
+
+  b[0] = _mm256_inserti128_si256(
+    _mm256_castsi128_si256(_mm_unpacklo_epi16(lo01, lo23)),
+    _mm_unpackhi_epi16(lo01, lo23), 1);
+  b[1] = _mm256_inserti128_si256(
+    _mm256_castsi128_si256(_mm_unpacklo_epi16(hi01, hi23)),
+    _mm_unpackhi_epi16(hi01, hi23), 1);
+}
+
+/**
+ * @brief R rows x 16 G columns of C from a K x N matrix B. Without packing
+ * the quads of k are interleaved on the fly, which leaves B as stored;
+ * packed B holds them for every 16 columns, @a ld_b bytes apart.
+ */
+template <unsigned int R, unsigned int G, bool Packed>
+void qgemm_kn_tile(const unsigned int N, const unsigned int K, const int8_t *A,
+                   const float *a_scales, const int8_t *B, const size_t ld_b,
+                   const float *b_scales, const float *bias, float *C) {
+  __m256i acc[R][2 * G];
+  for (unsigned int r = 0; r < R; ++r)
+    for (unsigned int j = 0; j < 2 * G; ++j)
+      acc[r][j] = _mm256_setzero_si256();
+
+  for (unsigned int k = 0; k < K; k += 4) {
+    __m256i a[R];
+    for (unsigned int r = 0; r < R; ++r)
+      a[r] = _mm256_set1_epi32(load_quad(A + r * K, k, K));
+
+    for (unsigned int g = 0; g < G; ++g) {
+      __m256i b[2];
+      if constexpr (Packed) {
+        const int8_t *quads = B + g * ld_b + (size_t)k * 16;
+        b[0] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(quads));
+        b[1] =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(quads + 32));
+      } else {
+        interleave_quads(B + 16 * g, N, k, K, b);
+      }
+
+      for (unsigned int j = 0; j < 2; ++j) {
+        __m256i u = _mm256_abs_epi8(b[j]);
+        for (unsigned int r = 0; r < R; ++r)
+          acc[r][2 * g + j] =
+            dot_u8s8(acc[r][2 * g + j], u, _mm256_sign_epi8(a[r], b[j]));
+      }
+    }
+  }
+
+  for (unsigned int r = 0; r < R; ++r)
+    for (unsigned int j = 0; j < 2 * G; ++j)
+      store_dequantized(acc[r][j], a_scales[r], b_scales + 8 * j,
+                        bias ? bias + 8 * j : nullptr, C + r * N + 8 * j);
+}
+
+/**
+ * @brief R rows x C columns of C from an N x K matrix B, reducing along k
+ */
+template <unsigned int R, unsigned int C>
+void qgemm_nk_tile(const unsigned int N, const unsigned int K, const int8_t *A,
+                   const float *a_scales, const int8_t *B,
+                   const float *b_scales, const float *bias, float *out) {
+  __m256i acc[R][C];
+  for (unsigned int r = 0; r < R; ++r)
+    for (unsigned int c = 0; c < C; ++c)
+      acc[r][c] = _mm256_setzero_si256();
+
+  unsigned int k = 0;
+  for (; k + 32 <= K; k += 32) {
+    __m256i b[C], u[C];
+    for (unsigned int c = 0; c < C; ++c) {
+      b[c] =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(B + c * K + k));
+      u[c] = _mm256_abs_epi8(b[c]);
+    }
+    for (unsigned int r = 0; r < R; ++r) {
+      __m256i a =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(A + r * K + k));
+      for (unsigned int c = 0; c < C; ++c)
+        acc[r][c] = dot_u8s8(acc[r][c], u[c], _mm256_sign_epi8(a, b[c]));
+    }
+  }
+
+  for (unsigned int r = 0; r < R; ++r) {
+    for (unsigned int c = 0; c < C; ++c) {
+      int32_t sum = hsum_epi32(acc[r][c]);
+      for (unsigned int i = k; i < K; ++i)
+        sum += static_cast<int32_t>(A[r * K + i]) * B[c * K + i];
+      out[r * N + c] = sum * a_scales[r] * b_scales[c] + (bias ? bias[c] : 0);
+    }
+  }
+}
+
+/**
+ * @brief rows [m0, m1) and columns [n0, N) of C from a K x N matrix B
+ */
+void qgemm_kn_scalar(const unsigned int m0, const unsigned int m1,
+                     const unsigned int n0, const unsigned int N,
+                     const unsigned int K, const int8_t *A,
+                     const float *a_scales, const int8_t *B,
+                     const float *b_scales, const float *bias, float *C) {
+  for (unsigned int m = m0; m < m1; ++m) {
+    for (unsigned int n = n0; n < N; ++n) {
+      int32_t sum = 0;
+      for (unsigned int k = 0; k < K; ++k)
+        sum += static_cast<int32_t>(A[m * K + k]) * B[k * N + n];
+      C[m * N + n] = sum * a_scales[m] * b_scales[n] + (bias ? bias[n] : 0);
+    }
+  }
+}
+
+/**
+ * @brief R rows of C from a K x N matrix B, packed in blocks of 16 columns
+ * of @a ld_b bytes if @a packed is not nullptr
+ */
+template <unsigned int R>
+void qgemm_kn_rows(const unsigned int N, const unsigned int K, const int8_t *A,
+                   const float *a_scales, const int8_t *B,
+                   const int8_t *packed, const size_t ld_b,
+                   const float *b_scales, const float *bias, float *C) {
+  unsigned int n = 0;
+  if (packed) {
+    for (; n + 16 <= N; n += 16)
+      qgemm_kn_tile<R, 1, true>(N, K, A, a_scales, packed + n / 16 * ld_b,
+                                ld_b, b_scales + n, bias ? bias + n : nullptr,
+                                C + n);
+  } else {
+    /// a single row takes 64 columns at a time to reuse the broadcast of A
+    if (R == 1) {
+      for (; n + 64 <= N; n += 64)
+        qgemm_kn_tile<1, 4, false>(N, K, A, a_scales, B + n, 0, b_scales + n,
+                                   bias ? bias + n : nullptr, C + n);
+    }
+    for (; n + 16 <= N; n += 16)
+      qgemm_kn_tile<R, 1, false>(N, K, A, a_scales, B + n, 0, b_scales + n,
+                                 bias ? bias + n : nullptr, C + n);
+  }
+  qgemm_kn_scalar(0, R, n, N, K, A, a_scales, B, b_scales, bias, C);
+}
+
+/**
+ * @brief R rows of C from an N x K matrix B
+ */
+template <unsigned int R>
+void qgemm_nk_rows(const unsigned int N, const unsigned int K, const int8_t *A,
+                   const float *a_scales, const int8_t *B,
+                   const float *b_scales, const float *bias, float *C) {
+  unsigned int n = 0;
+  for (; n + 4 <= N; n += 4)
+    qgemm_nk_tile<R, 4>(N, K, A, a_scales, B + (size_t)n * K, b_scales + n,
+                        bias ? bias + n : nullptr, C + n);
+  for (; n < N; ++n)
+    qgemm_nk_tile<R, 1>(N, K, A, a_scales, B + (size_t)n * K, b_scales + n,
+                        bias ? bias + n : nullptr, C + n);
+}
+
+} // namespace
+
+void quantize_rows_s8(const unsigned int M, const unsigned int K,
+                      const float *X, int8_t *Y, float *scales) {
+  const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  const __m256i shuffle =
+    _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                     -1, 0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                     -1, -1);
+
+  for (unsigned int m = 0; m < M; ++m) {
+    const float *x = X + (size_t)m * K;
+    int8_t *y = Y + (size_t)m * K;
+
+    unsigned int k = 0;
+    __m256 vmax = _mm256_setzero_ps();
+    for (; k + 8 <= K; k += 8)
+      vmax =
+        _mm256_max_ps(vmax, _mm256_and_ps(_mm256_loadu_ps(x + k), abs_mask));
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, vmax);
+    float amax = *std::max_element(lanes, lanes + 8);
+    for (; k < K; ++k)
+      amax = std::max(amax, std::abs(x[k]));
+
+    scales[m] = amax / 127.0f;
+    const float inv = amax > 0.0f ? 127.0f / amax : 0.0f;
+    const __m256 vinv = _mm256_set1_ps(inv);
+    const __m256i lo = _mm256_set1_epi32(-127);
+    const __m256i hi = _mm256_set1_epi32(127);
+
+    for (k = 0; k + 8 <= K; k += 8) {
+      /// round to nearest even as std::nearbyint does by default
+      __m256i q =
+        _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(x + k), vinv));
+      q = _mm256_min_epi32(_mm256_max_epi32(q, lo), hi);
+      q = _mm256_shuffle_epi8(q, shuffle);
+      int32_t quads[2] = {_mm256_extract_epi32(q, 0),
+                          _mm256_extract_epi32(q, 4)};
+      std::memcpy(y + k, quads, sizeof(quads));
+    }
+    for (; k < K; ++k) {
+      float q = std::nearbyint(x[k] * inv);
+      y[k] = static_cast<int8_t>(std::min(127.0f, std::max(-127.0f, q)));
+    }
+  }
+}
+
+void qgemm_s8(const unsigned int M, const unsigned int N, const unsigned int K,
+              const int8_t *A, const float *a_scales, const int8_t *B,
+              const float *b_scales, bool trans_b, const float *bias,
+              float *C) {
+  unsigned int m = 0;
+  if (trans_b) {
+    for (; m + 4 <= M; m += 4)
+      qgemm_nk_rows<4>(N, K, A + (size_t)m * K, a_scales + m, B, b_scales,
+                       bias, C + (size_t)m * N);
+    for (; m < M; ++m)
+      qgemm_nk_rows<1>(N, K, A + (size_t)m * K, a_scales + m, B, b_scales,
+                       bias, C + (size_t)m * N);
+    return;
+  }
+
+  /// B is interleaved once when enough rows reuse it
+  std::vector<int8_t> packed;
+  const size_t ld_b = (size_t)(K + 3) / 4 * 64;
+  if (M >= 8 && N >= 16) {
+    packed.resize(N / 16 * ld_b);
+    for (unsigned int n = 0; n + 16 <= N; n += 16) {
+      int8_t *block = packed.data() + n / 16 * ld_b;
+      for (unsigned int k = 0; k < K; k += 4) {
+        __m256i b[2];
+        interleave_quads(B + n, N, k, K, b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(block + k * 16), b[0]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(block + k * 16 + 32),
+                            b[1]);
+      }
+    }
+  }
+  const int8_t *packed_b = packed.empty() ? nullptr : packed.data();
+
+  for (; m + 4 <= M; m += 4)
+    qgemm_kn_rows<4>(N, K, A + (size_t)m * K, a_scales + m, B, packed_b, ld_b,
+                     b_scales, bias, C + (size_t)m * N);
+  for (; m < M; ++m)
+    qgemm_kn_rows<1>(N, K, A + (size_t)m * K, a_scales + m, B, packed_b, ld_b,
+                     b_scales, bias, C + (size_t)m * N);
+}
+
+namespace {
+
+/**
+ * @brief round halfway cases away from zero as std::round, which the
+ * quantizers round with
+ */
+inline __m256 round_half_away(__m256 v) {
+  const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+  const __m256 sign = _mm256_and_ps(v, sign_mask);
+  const __m256 t = _mm256_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+  const __m256 frac = _mm256_andnot_ps(sign_mask, _mm256_sub_ps(v, t));
+  const __m256 up = _mm256_cmp_ps(frac, _mm256_set1_ps(0.5f), _CMP_GE_OQ);
+  return _mm256_add_ps(
+    t, _mm256_and_ps(up, _mm256_or_ps(_mm256_set1_ps(1.0f), sign)));
+}
+
+} // namespace
+
+void fake_quantize(const unsigned int M, const unsigned int N, const float *X,
+                   float *Y, const float *scales, bool col_scales,
+                   const float quant_min, const float quant_max) {
+  const __m256 vmin = _mm256_set1_ps(quant_min);
+  const __m256 vmax = _mm256_set1_ps(quant_max);
+
+  for (unsigned int m = 0; m < M; ++m) {
+    const float *x = X + (size_t)m * N;
+    float *y = Y + (size_t)m * N;
+
+    unsigned int n = 0;
+    if (col_scales) {
+      for (; n + 8 <= N; n += 8) {
+        const __m256 scale = _mm256_loadu_ps(scales + n);
+        __m256 q =
+          round_half_away(_mm256_div_ps(_mm256_loadu_ps(x + n), scale));
+        q = _mm256_min_ps(_mm256_max_ps(q, vmin), vmax);
+        _mm256_storeu_ps(y + n, _mm256_mul_ps(q, scale));
+      }
+      for (; n < N; ++n) {
+        float q = std::round(x[n] / scales[n]);
+        y[n] = std::min(quant_max, std::max(quant_min, q)) * scales[n];
+      }
+      continue;
+    }
+
+    const __m256 vscale = _mm256_set1_ps(scales[m]);
+    for (; n + 8 <= N; n += 8) {
+      __m256 q =
+        round_half_away(_mm256_div_ps(_mm256_loadu_ps(x + n), vscale));
+      q = _mm256_min_ps(_mm256_max_ps(q, vmin), vmax);
+      _mm256_storeu_ps(y + n, _mm256_mul_ps(q, vscale));
+    }
+    for (; n < N; ++n) {
+      float q = std::round(x[n] / scales[m]);
+      y[n] = std::min(quant_max, std::max(quant_min, q)) * scales[m];
+    }
+  }
+}
+
+void fake_quantize_grad(const unsigned int N, const float *X, const float *dY,
+                        float *dX, const float scale, const float quant_min,
+                        const float quant_max) {
+  const __m256 vscale = _mm256_set1_ps(scale);
+  const __m256 vmin = _mm256_set1_ps(quant_min);
+  const __m256 vmax = _mm256_set1_ps(quant_max);
+
+  unsigned int i = 0;
+  for (; i + 8 <= N; i += 8) {
+    __m256 q = round_half_away(_mm256_div_ps(_mm256_loadu_ps(X + i), vscale));
+    __m256 inside = _mm256_and_ps(_mm256_cmp_ps(q, vmin, _CMP_GE_OQ),
+                                  _mm256_cmp_ps(q, vmax, _CMP_LE_OQ));
+    _mm256_storeu_ps(dX + i, _mm256_and_ps(_mm256_loadu_ps(dY + i), inside));
+  }
+  for (; i < N; ++i) {
+    const float q = std::round(X[i] / scale);
+    dX[i] = (q >= quant_min && q <= quant_max) ? dY[i] : 0.0f;
+  }
+}
+
 } // namespace nntrainer::avx2
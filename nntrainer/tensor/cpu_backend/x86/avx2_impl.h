@@ -15,6 +15,8 @@
 #define __AVX2_IMPL_H_
 #ifdef __cplusplus
 
+#include <cstdint>
+
 namespace nntrainer::avx2 {
 
 #ifdef ENABLE_FP16
@@ -67,6 +69,105 @@ bool is_valid(const unsigned int N, const float *X);
 void custom_scopy(const unsigned int N, const float *X, const int incX,
                   float *Y, const int incY);
 
+/**
+ * @brief Matrix transpose / 2D Tensor transpose, tiled to stay in cache and
+ * moving 8x8 blocks in registers
+ *
+ * @param M row length of input matrix
+ * @param N col length of input matrix
+ * @param src src data of input matrix
+ * @param ld_src data offset of input matrix
+ * @param dst destination of output matrix
+ * @param ld_dst data offset of output matrix
+ */
+void transpose_matrix(const unsigned int M, const unsigned int N,
+                      const float *src, unsigned int ld_src, float *dst,
+                      unsigned int ld_dst);
+
+/**
+ * @brief Matrix transpose / 2D Tensor transpose of any 16-bit data, tiled to
+ * stay in cache and moving 8x8 blocks in registers
+ *
+ * @param M row length of input matrix
+ * @param N col length of input matrix
+ * @param src src data of input matrix
+ * @param ld_src data offset of input matrix
+ * @param dst destination of output matrix
+ * @param ld_dst data offset of output matrix
+ */
+void transpose_matrix(const unsigned int M, const unsigned int N,
+                      const uint16_t *src, unsigned int ld_src, uint16_t *dst,
+                      unsigned int ld_dst);
+
+/**
+ * @brief quantize each row of a row major M x K matrix to int8 with a
+ * symmetric scale of its own
+ *
+ * @param M number of rows of X
+ * @param K number of columns of X
+ * @param X float * for Matrix X
+ * @param Y int8_t * for quantized Matrix Y
+ * @param scales float * for the M scales, max |x| / 127 of each row
+ */
+void quantize_rows_s8(const unsigned int M, const unsigned int K,
+                      const float *X, int8_t *Y, float *scales);
+
+/**
+ * @brief int8 gemm accumulating in int32 with the dequantization and the bias
+ * fused. Products of 4 pairs are summed with vpdpbusd where VNNI is available
+ * and vpmaddubsw otherwise, with the sign of B moved onto A.
+ *
+ * @param M number of rows of A and C
+ * @param N number of columns of B and C
+ * @param K number of columns of A and rows of B
+ * @param A int8_t * for row major M x K Matrix A, in [-127, 127]
+ * @param a_scales float * for the M scales of the rows of A
+ * @param B int8_t * for row major K x N Matrix B, or N x K if trans_b
+ * @param b_scales float * for the N scales of the columns of B
+ * @param trans_b B is stored transposed
+ * @param bias float * for bias of size N, nullptr if none
+ * @param C float * for row major M x N Matrix C
+ */
+void qgemm_s8(const unsigned int M, const unsigned int N, const unsigned int K,
+              const int8_t *A, const float *a_scales, const int8_t *B,
+              const float *b_scales, bool trans_b, const float *bias, float *C);
+
+/**
+ * @brief fake quantization of a row major M x N matrix to the grid of a
+ * symmetric quantization with a scale per row or per column, 8 values at a
+ * time rounded to nearest even as std::nearbyint does
+ *
+ * @param M number of rows of X
+ * @param N number of columns of X
+ * @param X float * for Matrix X
+ * @param Y float * for Matrix Y, may be X
+ * @param scales float * for the M positive scales of the rows, or the N of the
+ * columns if col_scales
+ * @param col_scales the scales are of the columns
+ * @param quant_min smallest quantized value
+ * @param quant_max largest quantized value
+ */
+void fake_quantize(const unsigned int M, const unsigned int N, const float *X,
+                   float *Y, const float *scales, bool col_scales,
+                   const float quant_min, const float quant_max);
+
+/**
+ * @brief straight through gradient of the fake quantization with a single
+ * scale, dX = dY where quant_min <= round(X / scale) <= quant_max and 0
+ * elsewhere
+ *
+ * @param N number of elements of X
+ * @param X float * for Vector X, the input of the fake quantization
+ * @param dY float * for Vector dY, the derivative of the output
+ * @param dX float * for Vector dX, the derivative of the input, may be dY
+ * @param scale positive scale of the quantization
+ * @param quant_min smallest quantized value
+ * @param quant_max largest quantized value
+ */
+void fake_quantize_grad(const unsigned int N, const float *X, const float *dY,
+                        float *dX, const float scale, const float quant_min,
+                        const float quant_max);
+
 } // namespace nntrainer::avx2
 
 #endif /* __cplusplus */
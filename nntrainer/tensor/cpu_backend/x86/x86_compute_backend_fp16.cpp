@@ -17,6 +17,8 @@
 #include <fallback_internal.h>
 #include <nntrainer_error.h>
 #include <tensor_dim.h>
+#include <utility>
+#include <vector>
 #include <x86_compute_backend.h>
 
 #define ROW_MAJOR 0
@@ -115,6 +117,46 @@ void sgemm(const unsigned int TStorageOrder, bool TransA, bool TransB,
   delete[] C_;
 }
 
+void sgemm_strided_batched(const unsigned int TStorageOrder, bool TransA,
+                           bool TransB, const unsigned int batch,
+                           const unsigned int M, const unsigned int N,
+                           const unsigned int K, const float alpha,
+                           const _FP16 *A, const unsigned int lda,
+                           const size_t strideA, const _FP16 *B,
+                           const unsigned int ldb, const size_t strideB,
+                           const float beta, _FP16 *C, const unsigned int ldc,
+                           const size_t strideC) {
+  if (batch == 0 || M == 0 || N == 0)
+    return;
+
+  /// number of elements spanned by the matrices of an operand
+  auto span = [&](unsigned int rows, unsigned int cols, unsigned int ld,
+                  size_t stride) {
+    if (TStorageOrder)
+      std::swap(rows, cols);
+    size_t matrix = rows ? (size_t)(rows - 1) * ld + cols : 0;
+    return stride ? (batch - 1) * stride + matrix : matrix;
+  };
+
+  const size_t a_len =
+    TransA ? span(K, M, lda, strideA) : span(M, K, lda, strideA);
+  const size_t b_len =
+    TransB ? span(N, K, ldb, strideB) : span(K, N, ldb, strideB);
+  const size_t c_len = span(M, N, ldc, strideC);
+
+  /// the operands are converted once for the whole batch, so that an operand
+  /// shared by the products is converted only once
+  std::vector<float> A_(a_len), B_(b_len), C_(c_len);
+  scopy(a_len, A, 1, A_.data(), 1);
+  scopy(b_len, B, 1, B_.data(), 1);
+  scopy(c_len, C, 1, C_.data(), 1);
+
+  __cblas_sgemm_strided_batched(TStorageOrder, TransA, TransB, batch, M, N, K,
+                                alpha, A_.data(), lda, strideA, B_.data(), ldb,
+                                strideB, beta, C_.data(), ldc, strideC);
+  scopy(c_len, C_.data(), 1, C, 1);
+}
+
 void sgemv(const unsigned int TStorageOrder, bool TransA, const unsigned int M,
            const unsigned int N, const float alpha, const _FP16 *A,
            const unsigned int lda, const _FP16 *X, const unsigned int incX,
@@ -178,7 +220,9 @@ void inv_sqrt_inplace(const unsigned int N, _FP16 *X) {
 void transpose_matrix(const unsigned int M, const unsigned int N,
                       const _FP16 *src, unsigned int ld_src, _FP16 *dst,
                       unsigned int ld_dst) {
-  __fallback_transpose_matrix(M, N, src, ld_src, dst, ld_dst);
+  /// a transpose only moves the bits of the elements
+  nntrainer::avx2::transpose_matrix(M, N, (const uint16_t *)src, ld_src,
+                                    (uint16_t *)dst, ld_dst);
 }
 
 bool is_valid(const unsigned int N, const _FP16 *input) {
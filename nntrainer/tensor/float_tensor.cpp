@@ -742,6 +742,22 @@ Tensor &FloatTensor::dot(Tensor const &input, Tensor &output, bool trans,
   return output;
 }
 
+Tensor &FloatTensor::dotBatched(Tensor const &input, Tensor &output, bool trans,
+                                bool trans_in, float beta) const {
+  unsigned int M, N, K, lda, ldb, ldc;
+  size_t stride, input_stride, output_stride;
+
+  calculateBatchedDot(input, output, trans, trans_in, M, N, K, lda, ldb, ldc,
+                      stride, input_stride, output_stride);
+
+  sgemm_strided_batched((unsigned int)dim.getStorageOrder(), trans, trans_in,
+                        batch(), M, N, K, 1.0f, (float *)getData(), lda, stride,
+                        input.getData<float>(), ldb, input_stride, beta,
+                        output.getData<float>(), ldc, output_stride);
+
+  return output;
+}
+
 void FloatTensor::copy(const Tensor &from) {
   reshape(from.getDim());
   copy(from.getData<float>());
@@ -849,73 +865,14 @@ float FloatTensor::minValue() const {
 
 Tensor &FloatTensor::transpose(const std::string &direction,
                                Tensor &output) const {
-  unsigned int SL, SI, SJ, SK;
-
   output.reshape(dim.transpose(direction));
 
-  int indexI = direction[0] - '0';
-  int indexJ = direction[2] - '0';
-
-  SL = dim.batch(), SI = dim.channel(), SJ = dim.height(), SK = dim.width();
-
-  bool is_format_nchw = (getFormat() == Tformat::NCHW);
-
-  const float *inptr = (float *)getData();
-  float *outptr = output.getData<float>();
-  switch (indexI) {
-  case 0:
-    if (indexJ == 1) {
-      if (is_format_nchw) {
-        transposeloop(l, i, j, k, SL, SI, SJ, SK);
-      } else {
-        transposeloop_nhwc(l, j, k, i, SL, SJ, SK, SI);
-      }
-    } else {
-      if (is_format_nchw) {
-        for (unsigned int b = 0; b < batch(); ++b) {
-          for (unsigned int c = 0; c < channel(); ++c) {
-            transpose_matrix(
-              height(), width(), (float *)getData() + getIndex(b, c, 0, 0),
-              width(), (float *)output.getData() + output.getIndex(b, c, 0, 0),
-              output.width());
-          }
-        }
-      } else {
-        transposeloop_nhwc(l, k, j, i, SL, SK, SJ, SI);
-      }
-    }
-    break;
-  case 1:
-    if (indexJ == 0) {
-      if (is_format_nchw) {
-        transposeloop(l, j, i, k, SL, SJ, SI, SK);
-      } else {
-        transposeloop_nhwc(l, i, k, j, SL, SI, SK, SJ);
-      }
-    } else {
-      if (is_format_nchw) {
-        transposeloop(l, j, k, i, SL, SJ, SK, SI);
-      } else {
-        transposeloop_nhwc(l, k, i, j, SL, SK, SI, SJ);
-      }
-    }
-    break;
-  case 2:
-    if (indexJ == 0) {
-      if (is_format_nchw) {
-        transposeloop(l, k, i, j, SL, SK, SI, SJ);
-      } else {
-        transposeloop_nhwc(l, i, j, k, SL, SI, SJ, SK);
-      }
-    } else {
-      if (is_format_nchw) {
-        transposeloop(l, k, j, i, SL, SK, SJ, SI);
-      } else {
-        transposeloop_nhwc(l, j, i, k, SL, SJ, SI, SK);
-      }
-    }
-    break;
-  }
+  transposeData(computeTransposeInfo(direction), (float *)getData(),
+                output.getData<float>(),
+                [](const unsigned int M, const unsigned int N, const float *src,
+                   unsigned int ld_src, float *dst, unsigned int ld_dst) {
+                  transpose_matrix(M, N, src, ld_src, dst, ld_dst);
+                });
 
   return output;
 }
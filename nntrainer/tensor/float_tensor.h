@@ -397,6 +397,13 @@ public:
   Tensor &dot(Tensor const &input, Tensor &output, bool trans, bool trans_in,
               float beta) const override;
 
+  /**
+   *  @copydoc Tensor::dotBatched(Tensor const &input, Tensor &result, bool
+   * trans, bool trans_in, float beta)
+   */
+  Tensor &dotBatched(Tensor const &input, Tensor &output, bool trans,
+                     bool trans_in, float beta) const override;
+
   /**
    * @copydoc Tensor::dropout_mask(float dropout)
    */
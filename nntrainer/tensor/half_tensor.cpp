@@ -697,6 +697,22 @@ Tensor &HalfTensor::dot(Tensor const &input, Tensor &output, bool trans,
   return output;
 }
 
+Tensor &HalfTensor::dotBatched(Tensor const &input, Tensor &output, bool trans,
+                               bool trans_in, float beta) const {
+  unsigned int M, N, K, lda, ldb, ldc;
+  size_t stride, input_stride, output_stride;
+
+  calculateBatchedDot(input, output, trans, trans_in, M, N, K, lda, ldb, ldc,
+                      stride, input_stride, output_stride);
+
+  sgemm_strided_batched((unsigned int)dim.getStorageOrder(), trans, trans_in,
+                        batch(), M, N, K, 1.0f, (_FP16 *)getData(), lda, stride,
+                        input.getData<_FP16>(), ldb, input_stride, beta,
+                        output.getData<_FP16>(), ldc, output_stride);
+
+  return output;
+}
+
 void HalfTensor::dropout_mask(float dropout) {
   _FP16 scale = static_cast<_FP16>(1.0 / (1 - dropout));
   _FP16 *data_ = (_FP16 *)getData();
@@ -1059,73 +1075,14 @@ float HalfTensor::minValue() const {
 
 Tensor &HalfTensor::transpose(const std::string &direction,
                               Tensor &output) const {
-  unsigned int SL, SI, SJ, SK;
-
   output.reshape(dim.transpose(direction));
 
-  int indexI = direction[0] - '0';
-  int indexJ = direction[2] - '0';
-
-  SL = dim.batch(), SI = dim.channel(), SJ = dim.height(), SK = dim.width();
-
-  bool is_format_nchw = (getFormat() == Tformat::NCHW);
-
-  const _FP16 *inptr = (_FP16 *)getData();
-  _FP16 *outptr = output.getData<_FP16>();
-  switch (indexI) {
-  case 0:
-    if (indexJ == 1) {
-      if (is_format_nchw) {
-        transposeloop(l, i, j, k, SL, SI, SJ, SK);
-      } else {
-        transposeloop_nhwc(l, j, k, i, SL, SJ, SK, SI);
-      }
-    } else {
-      if (is_format_nchw) {
-        for (unsigned int b = 0; b < batch(); ++b) {
-          for (unsigned int c = 0; c < channel(); ++c) {
-            transpose_matrix(
-              height(), width(), (_FP16 *)getData() + getIndex(b, c, 0, 0),
-              width(), (_FP16 *)output.getData() + output.getIndex(b, c, 0, 0),
-              output.width());
-          }
-        }
-      } else {
-        transposeloop_nhwc(l, k, j, i, SL, SK, SJ, SI);
-      }
-    }
-    break;
-  case 1:
-    if (indexJ == 0) {
-      if (is_format_nchw) {
-        transposeloop(l, j, i, k, SL, SJ, SI, SK);
-      } else {
-        transposeloop_nhwc(l, i, k, j, SL, SI, SK, SJ);
-      }
-    } else {
-      if (is_format_nchw) {
-        transposeloop(l, j, k, i, SL, SJ, SK, SI);
-      } else {
-        transposeloop_nhwc(l, k, i, j, SL, SK, SI, SJ);
-      }
-    }
-    break;
-  case 2:
-    if (indexJ == 0) {
-      if (is_format_nchw) {
-        transposeloop(l, k, i, j, SL, SK, SI, SJ);
-      } else {
-        transposeloop_nhwc(l, i, j, k, SL, SI, SJ, SK);
-      }
-    } else {
-      if (is_format_nchw) {
-        transposeloop(l, k, j, i, SL, SK, SJ, SI);
-      } else {
-        transposeloop_nhwc(l, j, i, k, SL, SJ, SI, SK);
-      }
-    }
-    break;
-  }
+  transposeData(computeTransposeInfo(direction), (_FP16 *)getData(),
+                output.getData<_FP16>(),
+                [](const unsigned int M, const unsigned int N, const _FP16 *src,
+                   unsigned int ld_src, _FP16 *dst, unsigned int ld_dst) {
+                  transpose_matrix(M, N, src, ld_src, dst, ld_dst);
+                });
 
   return output;
 }
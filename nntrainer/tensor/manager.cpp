@@ -158,7 +158,22 @@ void Manager::allocateWeights(unsigned int max_exec_order_, bool init) {
   }
 }
 
-void Manager::deallocateWeights() { weight_pool.deallocate(); }
+void Manager::deallocateWeights() {
+  if (!weight_shared)
+    weight_pool.deallocate();
+}
+
+void Manager::shareWeights(Manager &owner) {
+  NNTR_THROW_IF(enable_swap || owner.enable_swap, std::invalid_argument)
+    << "swapped weights cannot be shared";
+  NNTR_THROW_IF(!owner.weight_pool.isAllocated(), std::invalid_argument)
+    << "weights are shared after their allocation";
+
+  if (!weight_pool.isAllocated())
+    finalizeTensorPool(weight_pool, 0, owner.max_exec_order);
+  weight_pool.share(owner.weight_pool);
+  weight_shared = true;
+}
 
 static Tensor *requestTensor_(const TensorSpecV2 &spec,
                               const GraphNode::ExecutionOrder &exec_order,
@@ -266,6 +281,12 @@ void Manager::allocateTensors(unsigned int max_exec_order_) {
   }
 }
 
+size_t Manager::planTensors(unsigned int max_exec_order_) {
+  if (!tensor_pool.isAllocated())
+    finalizeTensorPool(tensor_pool, 0, max_exec_order_);
+  return tensor_pool.size();
+}
+
 /**
  * @brief Deallocate memory for all the managed tensors
  */
@@ -395,7 +416,9 @@ std::vector<Weight *> Manager::requestWeights(
     }
   }
 
-  TensorLifespan grad_ls = TensorLifespan::BACKWARD_FUNC_LIFESPAN;
+  TensorLifespan grad_ls = persistent_gradients
+                             ? TensorLifespan::MAX_LIFESPAN
+                             : TensorLifespan::BACKWARD_FUNC_LIFESPAN;
 
   std::vector<Weight *> ret;
   size_t current_size = weights_v2.size();
@@ -425,10 +448,11 @@ std::vector<Weight *> Manager::requestWeights(
     /**
      * If the weight is supposed to be clip by global norm, extend its exec
      * order with the max exec order where it will be used for clipping and then
-     * applied to the weight.
+     * applied to the weight. So are the gradients kept to be applied after the
+     * backwarding.
      */
     if (Weight::isGradientClipByGlobalNorm(clip_by_global_norm) ||
-        isMixedPrecision()) {
+        isMixedPrecision() || keep_gradients) {
       grad_exec_order.push_back(TensorPool::PERSIST_END_ORDER);
       // TODO: We need double check if it is OK not to add PERSIST_END_ORDER
       // here or add other conditions
@@ -783,9 +807,28 @@ bool Manager::checkLoadComplete(unsigned int order) {
   } else {
     ml_logd("without wait completed %d", order);
   }
+  load_complete_time = std::chrono::steady_clock::now();
+  load_complete_valid = true;
   return true;
 }
 
+unsigned int Manager::getAdaptiveLookahead() {
+  int64_t load_us = weight_pool.getCacheLoadTime();
+  if (exec_mode != ml::train::ExecutionMode::INFERENCE)
+    load_us = std::max(load_us, tensor_pool.getCacheLoadTime());
+
+  if (compute_time_us <= 0 || load_us <= 0)
+    return swap_lookahead;
+
+  /**
+   * Loading order + n starts n orders ahead, so n compute times have to cover
+   * one load. Use no more preloads than that to keep the memory footprint low.
+   */
+  int64_t needed = (load_us + compute_time_us - 1) / compute_time_us;
+  return static_cast<unsigned int>(
+    std::min<int64_t>(needed, static_cast<int64_t>(swap_lookahead)));
+}
+
 bool Manager::checkUnloadComplete(unsigned int order) {
   if (async_unload_tensor.count(order)) {
     auto &tasks = async_unload_tensor[order];
@@ -811,12 +854,26 @@ bool Manager::checkUnloadComplete(unsigned int order) {
 
 void Manager::LoadTensors(unsigned int order,
                           unsigned int remainder_lookahead) {
-  auto loadTensorsAsync = [&](TensorPool &pool, unsigned int order) {
+  /** time between the previous order became ready and now is its compute */
+  if (load_complete_valid) {
+    int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - load_complete_time)
+                   .count();
+    compute_time_us = compute_time_us == 0
+                        ? us
+                        : compute_time_us + (us - compute_time_us) / 8;
+    load_complete_valid = false;
+  }
+
+  auto loadTensorsAsync = [&](TensorPool &pool, unsigned int order,
+                              TaskAsync<>::Priority priority) {
     return pool.loadCacheExecAsync(
-      order, [&](int id, TaskExecutor::CompleteStatus status) {
+      order,
+      [&](int id, TaskExecutor::CompleteStatus status) {
         std::scoped_lock<std::mutex> lock(completed_load_mutex);
         completed_load_tensor[id].set_value(true);
-      });
+      },
+      priority);
   };
 
   auto enqueTasks = [&](unsigned int o) {
@@ -824,11 +881,14 @@ void Manager::LoadTensors(unsigned int order,
       ml_logd("Task loadTensors (%d) is in progress", o);
       return;
     }
-    auto load_weight = loadTensorsAsync(weight_pool, o);
+    /** the order to be run next goes before the preloads */
+    auto priority = o == order ? TaskAsync<>::Priority::HIGH
+                               : TaskAsync<>::Priority::LOW;
+    auto load_weight = loadTensorsAsync(weight_pool, o, priority);
     ml_logd("load weigth is requested in LoadTensors with order - %d", o);
     int load_tensor = 0;
     if (exec_mode != ml::train::ExecutionMode::INFERENCE) {
-      load_tensor = loadTensorsAsync(tensor_pool, o);
+      load_tensor = loadTensorsAsync(tensor_pool, o, priority);
       ml_logd("load tensor is requested in LoadTensors with order - %d", o);
     }
     NNTR_THROW_IF(load_weight < 0 || load_tensor < 0, std::runtime_error)
@@ -895,23 +955,51 @@ void Manager::flushCacheExcept(unsigned int order) {
     async_task_eos.erase(o);
   };
 
-  // TODO: lookahead > 1 is required.
-  if (swap_lookahead == 1) {
+  if (swap_lookahead >= 1) {
     if (async_task_eos.count(order) == 1)
       waitComplete(order);
 
-    auto load_weight = loadAsync(weight_pool, order + 1);
-    auto load_tensor = loadAsync(tensor_pool, order + 1);
+    /** keep the next swap_lookahead orders in flight */
+    for (unsigned int o = order + 1; o <= order + swap_lookahead; ++o) {
+      if (async_task_eos.count(o) == 1)
+        continue;
+      if (o > order + 1 && max_exec_order != 0 && o > max_exec_order)
+        break;
 
-    NNTR_THROW_IF(load_weight < 0 || load_tensor < 0, std::runtime_error)
-      << "Failed to launch preloading task";
-    async_task_eos[order + 1] = std::make_tuple(load_weight, load_tensor);
+      auto load_weight = loadAsync(weight_pool, o);
+      auto load_tensor = loadAsync(tensor_pool, o);
+
+      NNTR_THROW_IF(load_weight < 0 || load_tensor < 0, std::runtime_error)
+        << "Failed to launch preloading task";
+      async_task_eos[o] = std::make_tuple(load_weight, load_tensor);
+    }
   } else {
     weight_pool.flushCacheExcept(order);
     tensor_pool.flushCacheExcept(order);
   }
 }
 
+void Manager::setSwapCompression(const SwapCompressor::CodecMap &codecs) {
+  auto filter = [&codecs](const std::string &dtype) {
+    if (istrequal(dtype, "FP32"))
+      return codecs;
+
+    SwapCompressor::CodecMap lossless;
+    for (auto &[lifespan, codec] : codecs) {
+      if (SwapCompressor::isLossy(codec)) {
+        ml_logw("swap codec %s needs FP32 data, ignored for %s tensors",
+                SwapCompressor::toString(codec).c_str(), dtype.c_str());
+        continue;
+      }
+      lossless[lifespan] = codec;
+    }
+    return lossless;
+  };
+
+  weight_pool.setSwapCompression(filter(tensor_dtype[0]));
+  tensor_pool.setSwapCompression(filter(tensor_dtype[1]));
+}
+
 void Manager::finalizeTensorPool(TensorPool &pool, unsigned int start,
                                  unsigned int end) {
   if (enable_optimizations) {
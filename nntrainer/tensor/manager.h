@@ -23,6 +23,7 @@
 #include "tensor_wrap_specs.h"
 #ifdef __cplusplus
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <unordered_map>
@@ -140,7 +141,9 @@ public:
     swap_lookahead(0),
     tensor_format("NCHW"),
     tensor_dtype(split("FP32-FP32", getRegex("\\-"))),
-    exec_mode(ExecutionMode::TRAIN) {}
+    exec_mode(ExecutionMode::TRAIN) {
+    weight_pool.setReserveChannelScales(true);
+  }
 
   /**
    * @brief     Constructor of Manager
@@ -157,7 +160,9 @@ public:
     swap_lookahead(lookahead),
     tensor_format(tensor_format_),
     tensor_dtype(split(tensor_dtype_, getRegex("\\-"))),
-    exec_mode(exec_mode_) {}
+    exec_mode(exec_mode_) {
+    weight_pool.setReserveChannelScales(true);
+  }
 
   /**
    * @brief Construct a new Manager object (deleted)
@@ -375,6 +380,48 @@ public:
    */
   void deallocateTensors(bool dealloc_weights = false);
 
+  /**
+   * @brief Plan the memory layout of the managed tensors without allocating
+   *
+   * @param[in] max_exec_order The maximum order of execution to determine
+   * memory layout
+   * @return size_t planned size of the tensors in bytes
+   */
+  size_t planTensors(unsigned int max_exec_order_);
+
+  /**
+   * @brief set the tensor to be used when a forward segment is recomputed
+   *
+   * @param name name of the tensor
+   * @param order execution order of the recomputation
+   * @param written true if the tensor is written by the recomputation
+   */
+  void setRecompute(const std::string &name, unsigned int order,
+                    bool written) {
+    tensor_pool.setRecompute(name, order, written);
+  }
+
+  /**
+   * @brief clear all the recomputation set
+   */
+  void clearRecompute() { tensor_pool.clearRecompute(); }
+
+  /**
+   * @brief switch the tensors recomputed at the given order to their memory
+   * after the recomputation
+   *
+   * @param order execution order of the recomputation
+   */
+  void activateRecompute(unsigned int order) {
+    tensor_pool.activateRecompute(order);
+  }
+
+  /**
+   * @brief switch all the recomputed tensors back to their memory from the
+   * forwarding
+   */
+  void deactivateRecompute() { tensor_pool.deactivateRecompute(); }
+
   /**
    * @brief Allocate memory for all the managed weights
    *
@@ -393,9 +440,27 @@ public:
 
   /**
    * @brief Deallocate memory for all the weights
+   * @note shared weights are kept until the manager is destroyed
    */
   void deallocateWeights();
 
+  /**
+   * @brief Share the weights of another manager instead of allocating them
+   *
+   * @param owner manager of the same weights, which are allocated
+   * @throw std::invalid_argument if the weights differ or are swapped
+   * @note the shared weights outlive the owner as long as a manager shares
+   * them
+   */
+  void shareWeights(Manager &owner);
+
+  /**
+   * @brief Check if the weights are shared from another manager
+   *
+   * @return true if the weights are shared
+   */
+  bool isWeightShared() const { return weight_shared; }
+
   /**
    * @brief Set optimizations for manager
    *
@@ -403,6 +468,29 @@ public:
    */
   void setOptimizations(bool val) { enable_optimizations = val; }
 
+  /**
+   * @brief Keep the gradients of the weights requested after this until the
+   * end of the iteration, for the gradients applied after the backwarding
+   *
+   * @param val true to keep, else false
+   */
+  void setKeepGradients(bool val) { keep_gradients = val; }
+
+  /**
+   * @brief Check if the gradients are kept until the end of the iteration
+   *
+   * @return true if the gradients are kept
+   */
+  bool isGradientKept() const { return keep_gradients; }
+
+  /**
+   * @brief Keep the gradients of the weights requested after this for the
+   * whole training, for the gradients applied while the next iteration runs
+   *
+   * @param val true to keep, else false
+   */
+  void setPersistentGradients(bool val) { persistent_gradients = val; }
+
   /**
    * @brief Update externally dependent tensors
    *
@@ -507,6 +595,14 @@ public:
    */
   bool checkLoadComplete(unsigned int order);
 
+  /**
+   * @brief Get the lookahead needed to hide the load time behind the compute
+   * time of the execution orders, bounded by the configured lookahead
+   *
+   * @return number of execution orders to preload
+   */
+  unsigned int getAdaptiveLookahead();
+
   /**
    * @brief check completion of unload data for the execution order
    *
@@ -572,6 +668,14 @@ public:
     weight_pool.setWeightOffset(offsets);
   }
 
+  /**
+   * @brief set the codec of the swapped data per tensor lifespan
+   *
+   * @param codecs codec of each lifespan
+   * @note lossy codecs are dropped for a pool whose data type is not FP32
+   */
+  void setSwapCompression(const SwapCompressor::CodecMap &codecs);
+
 private:
   /** @todo: merge this list to one */
   std::vector<std::unique_ptr<Weight>> weights_v2; /**< weights for the layers
@@ -624,8 +728,15 @@ private:
 
   bool enable_swap; /**< to enable swap */
 
+  bool weight_shared = false; /**< weights are shared from another manager */
+
   bool enable_optimizations; /**< to enable memory optimizations */
 
+  bool keep_gradients = false; /**< gradients live until the iteration ends */
+
+  bool persistent_gradients =
+    false; /**< gradients live for the whole training */
+
   unsigned int swap_lookahead; /** lookahead for memory swap */
 
   std::string tensor_format;
@@ -636,6 +747,14 @@ private:
 
   unsigned int max_exec_order = 0;
 
+  std::chrono::steady_clock::time_point
+    load_complete_time; /**< end of the last checkLoadComplete */
+
+  bool load_complete_valid =
+    false; /**< true if load_complete_time is not consumed yet */
+
+  int64_t compute_time_us = 0; /**< moving average of compute per order */
+
   /**
    * @brief Finalize the given tensor pool
    *
@@ -23,6 +23,7 @@
 #include <nntrainer_log.h>
 #include <numeric>
 #include <profiler.h>
+#include <runtime_metrics.h>
 #include <vector>
 
 #if defined(_WIN32)
@@ -186,6 +187,10 @@ void MemoryPool::allocate() {
   }
 #endif
 
+  counted_bytes = pool_size;
+  RuntimeCounters::Global().add(RuntimeCounters::MEMORY_POOL_BYTES,
+                                counted_bytes);
+
 #ifdef PROFILE
   static long long seq = 0;
 
@@ -242,6 +247,39 @@ void MemoryPool::allocateFSU() {
   if (mem_pool == nullptr)
     throw std::runtime_error(
       "Failed to allocate memory: " + std::to_string(pool_size) + "bytes");
+
+  counted_bytes = 0;
+  for (auto &[offset, size] : allocated_size)
+    counted_bytes += size;
+  RuntimeCounters::Global().add(RuntimeCounters::MEMORY_POOL_BYTES,
+                                counted_bytes);
+}
+
+void MemoryPool::share(MemoryPool &owner) {
+  NNTR_THROW_IF(!owner.isAllocated(), std::invalid_argument)
+    << func_tag << "cannot share the memory of a pool not allocated";
+  NNTR_THROW_IF(owner.pool_size != pool_size ||
+                  owner.memory_offset != memory_offset,
+                std::invalid_argument)
+    << func_tag << "cannot share the memory of a pool of another layout";
+
+  /// the owner hands its memory over to the shared ownership at first
+  if (!owner.shared_pool)
+    owner.shared_pool = std::shared_ptr<void>(owner.mem_pool, free);
+
+  if (mem_pool != nullptr) {
+    if (shared_pool)
+      shared_pool.reset();
+    else
+      free(mem_pool);
+    RuntimeCounters::Global().sub(RuntimeCounters::MEMORY_POOL_BYTES,
+                                  counted_bytes);
+  }
+
+  shared_pool = owner.shared_pool;
+  mem_pool = shared_pool.get();
+  memory_ptrs = owner.memory_ptrs;
+  counted_bytes = 0;
 }
 
 /**
@@ -270,7 +308,13 @@ std::shared_ptr<MemoryData> MemoryPool::getMemory(unsigned int idx) {
  */
 void MemoryPool::deallocate() {
   if (mem_pool != nullptr) {
-    free(mem_pool);
+    if (shared_pool)
+      shared_pool.reset();
+    else
+      free(mem_pool);
+    RuntimeCounters::Global().sub(RuntimeCounters::MEMORY_POOL_BYTES,
+                                  counted_bytes);
+    counted_bytes = 0;
     memory_size.clear();
     memory_validity.clear();
     memory_exec_order.clear();
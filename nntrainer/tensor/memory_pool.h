@@ -25,6 +25,7 @@
 
 #include <memory_data.h>
 #include <memory_planner.h>
+#include <swap_compressor.h>
 #include <tensor_wrap_specs.h>
 
 #include <cstdlib>
@@ -75,7 +76,11 @@ public:
    *
    */
   explicit MemoryPool() :
-    mem_pool(nullptr), pool_size(0), min_pool_size(0), n_wgrad(0) {
+    mem_pool(nullptr),
+    pool_size(0),
+    min_pool_size(0),
+    n_wgrad(0),
+    counted_bytes(0) {
 
 #if defined(__ANDROID__)
     void *handle =
@@ -154,6 +159,17 @@ public:
    */
   virtual void allocateFSU();
 
+  /**
+   * @brief Share the allocated memory of another pool of the same layout
+   * instead of allocating
+   *
+   * @param owner memory pool allocated with the same layout
+   *
+   * @details The memory is freed when the last pool sharing it is deallocated.
+   * This does not share the memory of FSU or cached pools.
+   */
+  void share(MemoryPool &owner);
+
   /**
    * @brief Get the allocated memory
    *
@@ -227,6 +243,13 @@ public:
   virtual void
   setWeightOffset(std::vector<std::pair<size_t, size_t>> offsets){};
 
+  /**
+   * @brief set the codec of the swapped data per tensor lifespan
+   *
+   * @param codecs codec of each lifespan, others are stored as is
+   */
+  virtual void setSwapCompression(const SwapCompressor::CodecMap &codecs){};
+
 protected:
   /**
    * @brief  Get memory offset
@@ -308,12 +331,16 @@ private:
 
   void *mem_pool; /**< memory pool allocated at once */
 
+  std::shared_ptr<void> shared_pool; /**< mem_pool once it is shared */
+
   size_t pool_size; /**< memory requirement for this pool */
 
   size_t min_pool_size; /**< minimum theoretical memory requirement */
 
   size_t n_wgrad;
 
+  size_t counted_bytes; /**< allocated bytes added to the runtime counters */
+
   std::unordered_map<std::string, std::shared_ptr<nntrainer::MemAllocator>>
     allocators;
   RpcMemAllocFn_t rpcmem_alloc;
@@ -8,6 +8,7 @@
  * @bug		No known bugs except for NYI items
  */
 
+#include <algorithm>
 #include <math.h>
 #include <quantizer.h>
 #include <tensor.h>
@@ -60,7 +61,8 @@ std::unique_ptr<Quantizer> PerTensorAffineQuantizer::create() {
 
 void PerTensorAffineQuantizer::calculateQParams(const Tensor &input,
                                                 Tdatatype qtype) {
-  float max_val = input.max_abs();
+  /** max_abs() gives the signed value of the largest magnitude */
+  float max_val = std::abs(input.max_abs());
   scale = max_val / ((quant_max - quant_min) / 2.0f);
   scale = std::max(scale, std::numeric_limits<float>::epsilon());
 
@@ -179,23 +181,142 @@ std::unique_ptr<Quantizer> PerChannelAffineQuantizer::create() {
   return std::make_unique<PerChannelAffineQuantizer>();
 }
 
+void PerChannelAffineQuantizer::calculateQParams(const Tensor &input,
+                                                 Tdatatype qtype) {
+  NNTR_THROW_IF(input.getDataType() != Tdatatype::FP32, std::invalid_argument)
+    << "[Quantizer::quantize] Tensor data type is not floating point.";
+
+  const TensorDim &dim = input.getDim();
+  const bool by_column = qtype == Tdatatype::QINT8;
+  const unsigned int num_channels = by_column ? dim.width() : dim.height();
+  const float *data = input.getData<float>();
+
+  std::vector<float> max_abs(num_channels, 0.0f);
+  for (size_t i = 0; i < input.size(); ++i) {
+    unsigned int ch =
+      by_column ? i % dim.width() : (i / dim.width()) % dim.height();
+    max_abs[ch] = std::max(max_abs[ch], std::abs(data[i]));
+  }
+
+  scales.resize(num_channels);
+  for (unsigned int ch = 0; ch < num_channels; ++ch) {
+    scales[ch] = std::max(max_abs[ch] / ((quant_max - quant_min) / 2.0f),
+                          std::numeric_limits<float>::epsilon());
+  }
+}
+
 Tensor PerChannelAffineQuantizer::quantize(const Tensor &input,
                                            Tdatatype qtype) {
-  /// @todo NYI
-  return input;
+  NNTR_THROW_IF(qtype != Tdatatype::QINT8 && qtype != Tdatatype::QINT4,
+                std::invalid_argument)
+    << "[Quantizer::quantize] per channel quantization supports QINT8 and "
+       "QINT4 only.";
+
+  // 1. Calculate quantization parameters
+  calculateMinMaxValue(qtype);
+  calculateQParams(input, qtype);
+
+  // 2. Create output tensor holding a scale factor per channel
+  TensorDim dim = input.getDim();
+  dim.setDataType(qtype);
+  Tensor output(dim, true, Initializer::NONE, input.getName(),
+                QScheme::PER_CHANNEL_AFFINE);
+
+  // 3. perform quantization
+  quantize(input, output, scales.data());
+
+  return output;
 }
 
-Tensor &PerChannelAffineQuantizer::quantize(const Tensor &input, Tensor &output,
-                                            float *scales,
+Tensor &PerChannelAffineQuantizer::quantize(const Tensor &input,
+                                            Tensor &output, float *scales,
                                             unsigned int *zero_points) {
-  /// @todo NYI
+  NNTR_THROW_IF(input.getDataType() != Tdatatype::FP32, std::invalid_argument)
+    << "[Quantizer::quantize] Tensor data type is not floating point.";
+
+  NNTR_THROW_IF(output.empty(), std::invalid_argument)
+    << "[Quantizer::quantize] Cannot quantize to an empty tensor.";
+
+  NNTR_THROW_IF(output.getDataType() != Tdatatype::QINT8 &&
+                  output.getDataType() != Tdatatype::QINT4,
+                std::invalid_argument)
+    << "[Quantizer::quantize] per channel quantization supports QINT8 and "
+       "QINT4 only.";
+
+  NNTR_THROW_IF(output.q_scheme() != QScheme::PER_CHANNEL_AFFINE,
+                std::invalid_argument)
+    << "[Quantizer::quantize] Output tensor is not quantized per channel.";
+
+  NNTR_THROW_IF(scales == nullptr, std::invalid_argument)
+    << "[Quantizer::quantize] Output scale factor is invalid.";
+
+  NNTR_THROW_IF(input.size() != output.size(), std::invalid_argument)
+    << "[Quantizer::quantize] Tensor size does not match.";
+
+  calculateMinMaxValue(output.getDataType());
+
+  const TensorDim &dim = output.getDim();
+  const bool by_column = output.getDataType() == Tdatatype::QINT8;
+  const unsigned int num_channels = output.scale_size();
+  const float *in = input.getData<float>();
+  int8_t *out = output.getData<int8_t>();
+
+  for (unsigned int ch = 0; ch < num_channels; ++ch) {
+    NNTR_THROW_IF(std::fpclassify(scales[ch]) == FP_ZERO, std::invalid_argument)
+      << "[Quantizer::quantize] Output scale factor is invalid.";
+  }
+
+  if (!by_column)
+    std::fill(out, out + (output.size() + 1) / 2, 0);
+
+  for (size_t i = 0; i < output.size(); ++i) {
+    unsigned int ch =
+      by_column ? i % dim.width() : (i / dim.width()) % dim.height();
+    int8_t val = clip(std::lround(in[i] / scales[ch]), quant_min, quant_max);
+
+    if (by_column) {
+      out[i] = val;
+    } else {
+      /// two 4-bit values are packed in a byte, the former in the high nibble
+      out[i / 2] |= (i % 2 == 0) ? (val << 4) : (val & 0x0f);
+    }
+  }
+
+  std::copy(scales, scales + num_channels, output.getScale<float>());
+
   return output;
 }
 
 Tensor PerChannelAffineQuantizer::dequantize(const Tensor &input,
                                              Tdatatype dtype) {
-  /// @todo NYI
-  return input;
+  NNTR_THROW_IF(input.getDataType() != Tdatatype::QINT8 &&
+                  input.getDataType() != Tdatatype::QINT4,
+                std::invalid_argument)
+    << "[Quantizer::dequantize] per channel quantization supports QINT8 and "
+       "QINT4 only.";
+
+  TensorDim dim = input.getDim();
+  dim.setDataType(Tdatatype::FP32);
+  Tensor output(dim, true);
+
+  const bool by_column = input.getDataType() == Tdatatype::QINT8;
+  const bool per_tensor = input.scale_size() == 1;
+  const int8_t *in = input.getData<int8_t>();
+  const float *q_scales = input.getScale<float>();
+  float *out = output.getData<float>();
+
+  for (size_t i = 0; i < output.size(); ++i) {
+    unsigned int ch =
+      per_tensor  ? 0
+      : by_column ? i % dim.width()
+                  : (i / dim.width()) % dim.height();
+    int8_t val = by_column ? in[i] : in[i / 2];
+    if (!by_column)
+      val = (i % 2 == 0) ? val >> 4 : (int8_t)(val << 4) >> 4;
+    out[i] = val * q_scales[ch];
+  }
+
+  return dtype == Tdatatype::FP32 ? output : output.clone(dtype);
 }
 
 QScheme PerChannelAffineQuantizer::qscheme() const {
@@ -15,6 +15,7 @@
 #include <memory>
 #include <stdexcept>
 #include <unordered_map>
+#include <vector>
 
 #include <tensor_dim.h>
 
@@ -241,18 +242,16 @@ private:
  * it has separate scale and zero_point parameters for each channel. This allows
  * for more precise quantization of different channels within the same tensor.
  *
+ * The channels follow the scale layout of the quantized tensor: the columns of
+ * QINT8 and the rows of QINT4. Only symmetric quantization to signed types is
+ * supported for now, thus the zero points are zero.
  */
 class PerChannelAffineQuantizer : public UniformQuantizer {
 public:
   /**
    * @brief Basic Constructor of a PerChannelAffineQuantizer
    */
-  PerChannelAffineQuantizer() :
-    UniformQuantizer(),
-    scales(nullptr),
-    zero_points(nullptr),
-    quant_min(0),
-    quant_max(0) {}
+  PerChannelAffineQuantizer() : UniformQuantizer() {}
 
   /**
    * @copydoc Quantizer::create()
@@ -268,12 +267,14 @@ public:
   /**
    * @copydoc Quantizer::quantize(const Tensor &input, Tensor &output, float
    * *scales, unsigned int *zero_points)
+   * @note @a scales holds a scale factor per channel of @a output
    */
   Tensor &quantize(const Tensor &input, Tensor &output, float *scales,
                    unsigned int *zero_points = nullptr) override;
 
   /**
    * @copydoc Quantizer::dequantize(const Tensor &input)
+   * @note a tensor quantized per tensor is dequantized as well
    */
   Tensor dequantize(const Tensor &input,
                     ml::train::TensorDim::DataType dtype) override;
@@ -284,17 +285,14 @@ public:
   QScheme qscheme() const override;
 
 private:
-  float *scales;
-  int *zero_points;
-  long int quant_min = 0;
-  long int quant_max = 0;
+  std::vector<float> scales; /**< scale factor of each channel */
 
   /**
    * @copydoc Quantizer::calculateQParams(const Tensor &input,
    * ml::train::TensorDim::DataType qtype)
    */
   void calculateQParams(const Tensor &input,
-                        ml::train::TensorDim::DataType qtype) override {}
+                        ml::train::TensorDim::DataType qtype) override;
 };
 
 /**
@@ -303,6 +303,23 @@ void ShortTensor::copy_with_stride(const Tensor &input, Tensor &output) {
   }
 }
 
+Tensor &ShortTensor::transpose(const std::string &direction,
+                               Tensor &output) const {
+  /// per channel scales would have to follow the channel axis
+  NNTR_THROW_IF(qscheme != QScheme::PER_TENSOR_AFFINE ||
+                  output.q_scheme() != QScheme::PER_TENSOR_AFFINE,
+                std::invalid_argument)
+    << getName() << " is not quantized per tensor, cannot transpose.";
+
+  output.reshape(dim.transpose(direction));
+
+  transposeData(computeTransposeInfo(direction), (int16_t *)getData(),
+                output.getData<int16_t>(), transposeMatrix<int16_t>);
+  scopy(scale_size(), (float *)getScale(), 1, output.getScale<float>(), 1);
+
+  return output;
+}
+
 void ShortTensor::save(std::ostream &file) {
   /// @note Save quantization information
   save_quantization_info(file);
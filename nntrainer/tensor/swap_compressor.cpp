@@ -0,0 +1,498 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   swap_compressor.cpp
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  Codecs to compress tensor data written to the swap device
+ *
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <nntrainer_error.h>
+#include <swap_compressor.h>
+
+namespace nntrainer {
+
+namespace {
+
+/** minimum length of a match of the LZ codec */
+constexpr size_t LZ_MIN_MATCH = 4;
+
+/** the last bytes of a block are always literals */
+constexpr size_t LZ_LAST_LITERALS = 5;
+
+/** a match never starts in the last bytes of a block */
+constexpr size_t LZ_MATCH_LIMIT = 12;
+
+/** largest back reference distance of the LZ codec */
+constexpr size_t LZ_MAX_DISTANCE = 65535;
+
+/** log2 of the number of entries of the match finder */
+constexpr unsigned int LZ_HASH_LOG = 12;
+
+uint32_t read32(const uint8_t *p) {
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+uint32_t lzHash(uint32_t seq) {
+  return (seq * 2654435761U) >> (32 - LZ_HASH_LOG);
+}
+
+/**
+ * @brief write a length in the LZ4 length extension format
+ */
+uint8_t *lzWriteLength(uint8_t *op, size_t len) {
+  while (len >= 255) {
+    *op++ = 255;
+    len -= 255;
+  }
+  *op++ = static_cast<uint8_t>(len);
+  return op;
+}
+
+/**
+ * @brief LZ4 block compression with a single entry hash match finder
+ *
+ * @return compressed size, 0 if it exceeds @a capacity
+ */
+size_t lzCompress(const uint8_t *src, size_t size, uint8_t *dst,
+                  size_t capacity) {
+  uint8_t *op = dst;
+  uint8_t *const op_end = dst + capacity;
+  size_t anchor = 0;
+
+  auto emit = [&](size_t literal_len, size_t match_len,
+                  size_t distance) -> bool {
+    /** token, length extensions, literals and offset */
+    size_t needed = 1 + literal_len / 255 + 1 + literal_len + 2 +
+                    (match_len ? match_len / 255 + 1 : 0);
+    if (op + needed > op_end)
+      return false;
+
+    uint8_t *token = op++;
+    *token = static_cast<uint8_t>(std::min<size_t>(literal_len, 15) << 4);
+    if (literal_len >= 15)
+      op = lzWriteLength(op, literal_len - 15);
+    std::memcpy(op, src + anchor, literal_len);
+    op += literal_len;
+
+    if (match_len == 0)
+      return true;
+
+    *op++ = static_cast<uint8_t>(distance & 0xff);
+    *op++ = static_cast<uint8_t>(distance >> 8);
+    size_t ml = match_len - LZ_MIN_MATCH;
+    *token |= static_cast<uint8_t>(std::min<size_t>(ml, 15));
+    if (ml >= 15)
+      op = lzWriteLength(op, ml - 15);
+    return true;
+  };
+
+  if (size > LZ_MATCH_LIMIT) {
+    std::vector<int64_t> table(1u << LZ_HASH_LOG, -1);
+    const size_t match_limit = size - LZ_MATCH_LIMIT;
+    const size_t match_end = size - LZ_LAST_LITERALS;
+
+    size_t ip = 0;
+    while (ip < match_limit) {
+      uint32_t seq = read32(src + ip);
+      uint32_t h = lzHash(seq);
+      int64_t candidate = table[h];
+      table[h] = static_cast<int64_t>(ip);
+
+      size_t ref = static_cast<size_t>(candidate);
+      if (candidate < 0 || ip - ref > LZ_MAX_DISTANCE ||
+          read32(src + ref) != seq) {
+        ++ip;
+        continue;
+      }
+
+      size_t match_len = LZ_MIN_MATCH;
+      while (ip + match_len < match_end &&
+             src[ref + match_len] == src[ip + match_len])
+        ++match_len;
+
+      if (!emit(ip - anchor, match_len, ip - ref))
+        return 0;
+      ip += match_len;
+      anchor = ip;
+    }
+  }
+
+  if (!emit(size - anchor, 0, 0))
+    return 0;
+
+  return op - dst;
+}
+
+/**
+ * @brief LZ4 block decompression, rejects any out of bounds access
+ */
+bool lzDecompress(const uint8_t *src, size_t src_size, uint8_t *dst,
+                  size_t size) {
+  const uint8_t *ip = src;
+  const uint8_t *const ip_end = src + src_size;
+  uint8_t *op = dst;
+  uint8_t *const op_end = dst + size;
+
+  auto readLength = [&](size_t &len) -> bool {
+    uint8_t b;
+    do {
+      if (ip >= ip_end)
+        return false;
+      b = *ip++;
+      len += b;
+    } while (b == 255);
+    return true;
+  };
+
+  while (ip < ip_end) {
+    uint8_t token = *ip++;
+
+    size_t literal_len = token >> 4;
+    if (literal_len == 15 && !readLength(literal_len))
+      return false;
+    if (literal_len > static_cast<size_t>(ip_end - ip) ||
+        literal_len > static_cast<size_t>(op_end - op))
+      return false;
+    std::memcpy(op, ip, literal_len);
+    ip += literal_len;
+    op += literal_len;
+
+    /** the last sequence has no match */
+    if (ip == ip_end)
+      break;
+
+    if (ip_end - ip < 2)
+      return false;
+    size_t distance = ip[0] | (ip[1] << 8);
+    ip += 2;
+    if (distance == 0 || distance > static_cast<size_t>(op - dst))
+      return false;
+
+    size_t match_len = token & 0x0f;
+    if (match_len == 15 && !readLength(match_len))
+      return false;
+    match_len += LZ_MIN_MATCH;
+    if (match_len > static_cast<size_t>(op_end - op))
+      return false;
+
+    /** byte by byte as the match may overlap the output */
+    const uint8_t *match = op - distance;
+    for (size_t i = 0; i < match_len; ++i)
+      op[i] = match[i];
+    op += match_len;
+  }
+
+  return op == op_end;
+}
+
+/**
+ * @brief non-zero bitmap followed by the non-zero 32 bit words
+ *
+ * @return compressed size, 0 if it is not smaller than @a size
+ */
+size_t sparseCompress(const uint8_t *src, size_t size, uint8_t *dst) {
+  const size_t words = size / 4;
+  const size_t bitmap_size = (words + 7) / 8;
+
+  std::memset(dst, 0, bitmap_size);
+  uint8_t *op = dst + bitmap_size;
+  for (size_t i = 0; i < words; ++i) {
+    uint32_t w = read32(src + i * 4);
+    if (w == 0)
+      continue;
+    if (static_cast<size_t>(op - dst) + 4 >= size)
+      return 0;
+    dst[i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+    std::memcpy(op, &w, 4);
+    op += 4;
+  }
+
+  return op - dst;
+}
+
+bool sparseDecompress(const uint8_t *src, size_t src_size, uint8_t *dst,
+                      size_t size) {
+  const size_t words = size / 4;
+  const size_t bitmap_size = (words + 7) / 8;
+  if (src_size < bitmap_size)
+    return false;
+
+  const uint8_t *ip = src + bitmap_size;
+  const uint8_t *const ip_end = src + src_size;
+  for (size_t i = 0; i < words; ++i) {
+    if (src[i / 8] & (1u << (i % 8))) {
+      if (ip_end - ip < 4)
+        return false;
+      std::memcpy(dst + i * 4, ip, 4);
+      ip += 4;
+    } else {
+      std::memset(dst + i * 4, 0, 4);
+    }
+  }
+
+  return ip == ip_end;
+}
+
+/**
+ * @brief fp32 to fp16 bits, rounding to nearest even
+ */
+uint16_t fp32ToFp16(uint32_t x) {
+  uint32_t sign = (x >> 16) & 0x8000;
+  uint32_t exp = (x >> 23) & 0xff;
+  uint32_t mant = x & 0x7fffff;
+
+  if (exp == 0xff)
+    return static_cast<uint16_t>(sign | 0x7c00 | (mant ? 0x200 : 0));
+
+  int e = static_cast<int>(exp) - 127 + 15;
+  if (e >= 31)
+    return static_cast<uint16_t>(sign | 0x7c00);
+
+  if (e <= 0) {
+    if (e < -10)
+      return static_cast<uint16_t>(sign);
+    mant |= 0x800000;
+    unsigned int shift = 14 - e;
+    uint32_t half = mant >> shift;
+    uint32_t rem = mant & ((1u << shift) - 1);
+    uint32_t halfway = 1u << (shift - 1);
+    if (rem > halfway || (rem == halfway && (half & 1)))
+      ++half;
+    return static_cast<uint16_t>(sign | half);
+  }
+
+  uint32_t half = sign | (static_cast<uint32_t>(e) << 10) | (mant >> 13);
+  uint32_t rem = mant & 0x1fff;
+  /** a carry rounds up to the next exponent, or to infinity */
+  if (rem > 0x1000 || (rem == 0x1000 && (half & 1)))
+    ++half;
+  return static_cast<uint16_t>(half);
+}
+
+uint32_t fp16ToFp32(uint16_t h) {
+  uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+  uint32_t exp = (h >> 10) & 0x1f;
+  uint32_t mant = h & 0x3ff;
+
+  if (exp == 0) {
+    if (mant == 0)
+      return sign;
+    /** subnormal, normalize the mantissa */
+    int e = -14;
+    while (!(mant & 0x400)) {
+      mant <<= 1;
+      --e;
+    }
+    mant &= 0x3ff;
+    return sign | (static_cast<uint32_t>(e + 127) << 23) | (mant << 13);
+  }
+
+  if (exp == 31)
+    return sign | 0x7f800000 | (mant << 13);
+
+  return sign | ((exp - 15 + 127) << 23) | (mant << 13);
+}
+
+/**
+ * @brief fp32 to bf16 bits, rounding to nearest even
+ */
+uint16_t fp32ToBf16(uint32_t x) {
+  if ((x & 0x7f800000) == 0x7f800000 && (x & 0x7fffff))
+    return static_cast<uint16_t>((x >> 16) | 0x40);
+  x += 0x7fff + ((x >> 16) & 1);
+  return static_cast<uint16_t>(x >> 16);
+}
+
+/**
+ * @brief convert each 32 bit word of @a src to 16 bits
+ */
+template <typename F>
+size_t narrow(const uint8_t *src, size_t size, uint8_t *dst, F convert) {
+  const size_t words = size / 4;
+  for (size_t i = 0; i < words; ++i) {
+    uint16_t h = convert(read32(src + i * 4));
+    std::memcpy(dst + i * 2, &h, 2);
+  }
+  return words * 2;
+}
+
+/**
+ * @brief convert each 16 bit word of @a src to 32 bits
+ */
+template <typename F>
+bool widen(const uint8_t *src, size_t src_size, uint8_t *dst, size_t size,
+           F convert) {
+  const size_t words = size / 4;
+  if (src_size != words * 2)
+    return false;
+  for (size_t i = 0; i < words; ++i) {
+    uint16_t h;
+    std::memcpy(&h, src + i * 2, 2);
+    uint32_t w = convert(h);
+    std::memcpy(dst + i * 4, &w, 4);
+  }
+  return true;
+}
+
+/**
+ * @brief strip the surrounding white spaces and lower the case
+ */
+std::string normalize(const std::string &str) {
+  auto begin = str.find_first_not_of(" \t\n");
+  if (begin == std::string::npos)
+    return "";
+  auto end = str.find_last_not_of(" \t\n");
+  std::string out = str.substr(begin, end - begin + 1);
+  std::transform(out.begin(), out.end(), out.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return out;
+}
+
+} // namespace
+
+size_t SwapCompressor::getBound(SwapCodec codec, size_t size) {
+  /** the codecs give up as soon as the output reaches the input size */
+  return isLossy(codec) ? size / 2 : size;
+}
+
+size_t SwapCompressor::compress(SwapCodec codec, const void *src, size_t size,
+                                void *dst) {
+  auto in = static_cast<const uint8_t *>(src);
+  auto out = static_cast<uint8_t *>(dst);
+
+  /** the word based codecs only take fp32 sized data */
+  if (codec != SwapCodec::LZ && size % 4 != 0)
+    return 0;
+
+  size_t compressed = 0;
+  switch (codec) {
+  case SwapCodec::LZ:
+    compressed = lzCompress(in, size, out, size);
+    break;
+  case SwapCodec::SPARSE:
+    compressed = sparseCompress(in, size, out);
+    break;
+  case SwapCodec::FP16:
+    compressed = narrow(in, size, out, fp32ToFp16);
+    break;
+  case SwapCodec::BF16:
+    compressed = narrow(in, size, out, fp32ToBf16);
+    break;
+  case SwapCodec::NONE:
+  default:
+    return 0;
+  }
+
+  return compressed < size ? compressed : 0;
+}
+
+bool SwapCompressor::decompress(SwapCodec codec, const void *src,
+                                size_t src_size, void *dst, size_t size) {
+  auto in = static_cast<const uint8_t *>(src);
+  auto out = static_cast<uint8_t *>(dst);
+
+  switch (codec) {
+  case SwapCodec::LZ:
+    return lzDecompress(in, src_size, out, size);
+  case SwapCodec::SPARSE:
+    return sparseDecompress(in, src_size, out, size);
+  case SwapCodec::FP16:
+    return widen(in, src_size, out, size, fp16ToFp32);
+  case SwapCodec::BF16:
+    return widen(in, src_size, out, size,
+                 [](uint16_t h) { return static_cast<uint32_t>(h) << 16; });
+  case SwapCodec::NONE:
+    if (src_size != size)
+      return false;
+    std::memcpy(out, in, size);
+    return true;
+  default:
+    return false;
+  }
+}
+
+SwapCompressor::CodecMap SwapCompressor::parse(const std::string &str) {
+  static const std::unordered_map<std::string, TensorLifespan> lifespans = {
+    {"unmanaged", TensorLifespan::UNMANAGED},
+    {"forward_func", TensorLifespan::FORWARD_FUNC_LIFESPAN},
+    {"calc_deriv", TensorLifespan::CALC_DERIV_LIFESPAN},
+    {"calc_grad", TensorLifespan::CALC_GRAD_LIFESPAN},
+    {"calc_agrad", TensorLifespan::CALC_AGRAD_LIFESPAN},
+    {"calc_grad_deriv", TensorLifespan::CALC_GRAD_DERIV_LIFESPAN},
+    {"calc_grad_deriv_agrad", TensorLifespan::CALC_GRAD_DERIV_AGRAD_LIFESPAN},
+    {"forward_grad", TensorLifespan::FORWARD_GRAD_LIFESPAN},
+    {"forward_grad_agrad", TensorLifespan::FORWARD_GRAD_AGRAD_LIFESPAN},
+    {"forward_deriv", TensorLifespan::FORWARD_DERIV_LIFESPAN},
+    {"backward_func", TensorLifespan::BACKWARD_FUNC_LIFESPAN},
+    {"iteration", TensorLifespan::ITERATION_LIFESPAN},
+    {"epoch", TensorLifespan::EPOCH_LIFESPAN},
+    {"forward_infer", TensorLifespan::FORWARD_INFER_LIFESPAN},
+    {"max", TensorLifespan::MAX_LIFESPAN},
+  };
+  static const std::unordered_map<std::string, SwapCodec> codecs = {
+    {"none", SwapCodec::NONE}, {"lz", SwapCodec::LZ},
+    {"sparse", SwapCodec::SPARSE}, {"fp16", SwapCodec::FP16},
+    {"bf16", SwapCodec::BF16},
+  };
+
+  CodecMap result;
+  std::stringstream ss(str);
+  std::string entry;
+  while (std::getline(ss, entry, ',')) {
+    entry = normalize(entry);
+    if (entry.empty())
+      continue;
+
+    auto sep = entry.find(':');
+    NNTR_THROW_IF(sep == std::string::npos, std::invalid_argument)
+      << "swap compression entry must be <lifespan>:<codec>, given: "
+      << entry;
+
+    std::string lifespan = normalize(entry.substr(0, sep));
+    std::string codec = normalize(entry.substr(sep + 1));
+
+    auto l = lifespans.find(lifespan);
+    NNTR_THROW_IF(l == lifespans.end(), std::invalid_argument)
+      << "unknown lifespan for swap compression: " << lifespan;
+    auto c = codecs.find(codec);
+    NNTR_THROW_IF(c == codecs.end(), std::invalid_argument)
+      << "unknown swap compression codec: " << codec;
+
+    result[l->second] = c->second;
+  }
+
+  return result;
+}
+
+std::string SwapCompressor::toString(SwapCodec codec) {
+  switch (codec) {
+  case SwapCodec::LZ:
+    return "lz";
+  case SwapCodec::SPARSE:
+    return "sparse";
+  case SwapCodec::FP16:
+    return "fp16";
+  case SwapCodec::BF16:
+    return "bf16";
+  case SwapCodec::NONE:
+  default:
+    return "none";
+  }
+}
+
+} // namespace nntrainer
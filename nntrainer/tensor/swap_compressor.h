@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   swap_compressor.h
+ * @date   18 Oct 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ * @brief  Codecs to compress tensor data written to the swap device
+ *
+ */
+
+#ifndef __SWAP_COMPRESSOR_H__
+#define __SWAP_COMPRESSOR_H__
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+#include <tensor_wrap_specs.h>
+
+namespace nntrainer {
+
+/**
+ * @brief Codec of the data stored in the swap device
+ */
+enum class SwapCodec {
+  NONE = 0,   /**< stored as is */
+  LZ = 1,     /**< lossless LZ77 byte codec in LZ4 block format */
+  SPARSE = 2, /**< lossless bitmap of non-zero 32 bit words, eg. ReLU outputs */
+  FP16 = 3,   /**< lossy, fp32 data stored as fp16 */
+  BF16 = 4,   /**< lossy, fp32 data stored as bf16 */
+};
+
+/**
+ * @class   SwapCompressor
+ * @brief   Compress and decompress the swap device data
+ */
+class SwapCompressor {
+public:
+  using CodecMap = std::unordered_map<TensorLifespan, SwapCodec>;
+
+  /**
+   * @brief Get the maximum compressed size of the data
+   *
+   * @param codec codec to use
+   * @param size size of the data in bytes
+   * @return size of the buffer the compressed data always fits in
+   */
+  static size_t getBound(SwapCodec codec, size_t size);
+
+  /**
+   * @brief Compress data
+   *
+   * @param codec codec to use
+   * @param src data to compress
+   * @param size size of the data in bytes
+   * @param dst output buffer of at least getBound() bytes
+   * @return size of the compressed data, 0 if the codec does not apply to
+   * the data or the result would not be smaller than the data
+   */
+  static size_t compress(SwapCodec codec, const void *src, size_t size,
+                         void *dst);
+
+  /**
+   * @brief Decompress data
+   *
+   * @param codec codec the data is compressed with
+   * @param src compressed data
+   * @param src_size size of the compressed data
+   * @param dst output buffer
+   * @param size size of the original data in bytes
+   * @return true if successful or false if the data is malformed
+   */
+  static bool decompress(SwapCodec codec, const void *src, size_t src_size,
+                         void *dst, size_t size);
+
+  /**
+   * @brief Check if the codec changes the values of the data
+   *
+   * @param codec codec to check
+   * @return true if the data is not restored exactly
+   */
+  static bool isLossy(SwapCodec codec) {
+    return codec == SwapCodec::FP16 || codec == SwapCodec::BF16;
+  }
+
+  /**
+   * @brief Parse the codecs per lifespan
+   *
+   * @param str comma separated list of <lifespan>:<codec>, where lifespan is
+   * the name of a TensorLifespan without the _LIFESPAN suffix, eg.
+   * "forward_func:sparse, forward_grad:fp16". Codecs are none, lz, sparse,
+   * fp16 and bf16.
+   * @return codec of each listed lifespan
+   * @throw std::invalid_argument if the string is malformed
+   */
+  static CodecMap parse(const std::string &str);
+
+  /**
+   * @brief Get the name of the codec
+   *
+   * @param codec codec
+   * @return name of the codec
+   */
+  static std::string toString(SwapCodec codec);
+};
+
+} // namespace nntrainer
+
+#endif /** __SWAP_COMPRESSOR_H__ */
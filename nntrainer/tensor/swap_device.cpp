@@ -11,19 +11,82 @@
  *
  */
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
 #include <cstring>
 #include <fcntl.h>
 #include <malloc.h>
 #include <profiler.h>
+#include <sstream>
 #include <stdlib.h>
 #include <sys/types.h>
 
 #include <nntrainer_error.h>
 #include <nntrainer_log.h>
+#include <runtime_metrics.h>
+#include <swap_compressor.h>
 #include <swap_device.h>
 
 namespace nntrainer {
 
+namespace {
+
+/**
+ * @brief read @a size bytes at @a offset of @a fd without moving the shared
+ * file position so that concurrent loaders do not interfere
+ *
+ * @return number of bytes read, negative on error
+ */
+ssize_t readAt(int fd, void *buf, size_t size, off_t offset) {
+  size_t done = 0;
+  while (done < size) {
+#if defined(_WIN32)
+    if (lseek(fd, offset + done, SEEK_SET) < 0)
+      return -1;
+    ssize_t len = read(fd, static_cast<char *>(buf) + done, size - done);
+#else
+    ssize_t len =
+      pread(fd, static_cast<char *>(buf) + done, size - done, offset + done);
+#endif
+    if (len < 0 && errno == EINTR)
+      continue;
+    if (len <= 0)
+      return len < 0 ? len : static_cast<ssize_t>(done);
+    done += len;
+  }
+  RuntimeCounters::Global().add(RuntimeCounters::SWAP_READ_BYTES, done);
+  return static_cast<ssize_t>(done);
+}
+
+/**
+ * @brief write @a size bytes at @a offset of @a fd, counterpart of readAt
+ *
+ * @return number of bytes written, negative on error
+ */
+ssize_t writeAt(int fd, const void *buf, size_t size, off_t offset) {
+  size_t done = 0;
+  while (done < size) {
+#if defined(_WIN32)
+    if (lseek(fd, offset + done, SEEK_SET) < 0)
+      return -1;
+    ssize_t len = write(fd, static_cast<const char *>(buf) + done, size - done);
+#else
+    ssize_t len = pwrite(fd, static_cast<const char *>(buf) + done,
+                         size - done, offset + done);
+#endif
+    if (len < 0 && errno == EINTR)
+      continue;
+    if (len <= 0)
+      return len < 0 ? len : static_cast<ssize_t>(done);
+    done += len;
+  }
+  RuntimeCounters::Global().add(RuntimeCounters::SWAP_WRITE_BYTES, done);
+  return static_cast<ssize_t>(done);
+}
+
+} // namespace
+
 void SwapDevice::start(size_t size, ml::train::ExecutionMode _execution_mode) {
   if (fd > 0)
     return;
@@ -53,6 +116,88 @@ void SwapDevice::start(size_t size, ml::train::ExecutionMode _execution_mode) {
   off = lseek(fd, 0, SEEK_SET);
   NNTR_THROW_IF(off < 0, std::runtime_error)
     << "SwapDevice: seek file: " << dev_path;
+
+#ifdef PROFILE
+  if (compress_item < 0) {
+    PROFILE_TIME_REGISTER_EVENT(compress_item, "swap_compress:" + dev_path);
+    PROFILE_TIME_REGISTER_EVENT(decompress_item,
+                                "swap_decompress:" + dev_path);
+  }
+#endif
+}
+
+ssize_t SwapDevice::readData(off_t offset, void *buf, size_t size) {
+  SwapCodec codec = SwapCodec::NONE;
+  size_t stored_size = size;
+  {
+    std::scoped_lock lock(device_mutex);
+    auto found = stored.find(offset);
+    if (found != stored.end())
+      std::tie(codec, stored_size) = found->second;
+  }
+
+  if (codec == SwapCodec::NONE)
+    return readAt(fd, buf, size, offset);
+
+  thread_local std::vector<char> scratch;
+  scratch.resize(stored_size);
+  ssize_t len = readAt(fd, scratch.data(), stored_size, offset);
+  if (len != (ssize_t)stored_size)
+    return -1;
+
+  auto start = std::chrono::steady_clock::now();
+  bool ok = SwapCompressor::decompress(codec, scratch.data(), stored_size,
+                                       buf, size);
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - start);
+  NNTR_THROW_IF(!ok, std::runtime_error)
+    << "SwapDevice: corrupted " << SwapCompressor::toString(codec)
+    << " data at " << offset << " of " << dev_path;
+
+  std::scoped_lock lock(device_mutex);
+  compression_stats.decompress_us += us.count();
+#ifdef PROFILE
+  profile::Profiler::Global().record(decompress_item, us);
+#endif
+  return (ssize_t)size;
+}
+
+ssize_t SwapDevice::writeData(off_t offset, const void *buf, size_t size,
+                              SwapCodec codec) {
+  size_t compressed = 0;
+  thread_local std::vector<char> scratch;
+
+  std::chrono::microseconds us(0);
+  if (codec != SwapCodec::NONE) {
+    auto start = std::chrono::steady_clock::now();
+    scratch.resize(SwapCompressor::getBound(codec, size));
+    compressed = SwapCompressor::compress(codec, buf, size, scratch.data());
+    us = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  }
+
+  /** data the codec can not shrink is stored as is */
+  const void *data = compressed ? scratch.data() : buf;
+  size_t data_size = compressed ? compressed : size;
+  ssize_t len = writeAt(fd, data, data_size, offset);
+  if (len != (ssize_t)data_size)
+    return len;
+
+  std::scoped_lock lock(device_mutex);
+  if (compressed)
+    stored[offset] = std::make_pair(codec, compressed);
+  else
+    stored.erase(offset);
+
+  if (codec != SwapCodec::NONE) {
+    compression_stats.raw_bytes += size;
+    compression_stats.stored_bytes += data_size;
+    compression_stats.compress_us += us.count();
+#ifdef PROFILE
+    profile::Profiler::Global().record(compress_item, us);
+#endif
+  }
+  return (ssize_t)size;
 }
 
 void *SwapDevice::getBuffer(off_t offset, size_t size, void *memory_ptr,
@@ -63,6 +208,7 @@ void *SwapDevice::getBuffer(off_t offset, size_t size, void *memory_ptr,
 #ifdef USE_MMAP
   // page aligned
   if (execution_mode == ml::train::ExecutionMode::INFERENCE) {
+    std::scoped_lock lock(device_mutex);
     auto len_offset = weight_offset.at(offset_index);
 
     // size_t off = (offset / sysconf(_SC_PAGE_SIZE)) * sysconf(_SC_PAGE_SIZE);
@@ -100,60 +246,85 @@ void *SwapDevice::getBuffer(off_t offset, size_t size, void *memory_ptr,
       << "SwapDevice: mmap: "
       << std::string(strerror_r(errno, error_buf, error_buflen));
     void *buf = static_cast<void *>(ptr + diff);
+
+    /** the mapping shows the stored form, restore compressed data */
+    if (!alloc_only && isCompressed(offset)) {
+      ssize_t read_len = readData(offset, buf, size);
+      NNTR_THROW_IF(read_len != (ssize_t)size, std::runtime_error)
+        << "SwapDevice: read file: " << dev_path;
+    }
+
+    std::scoped_lock lock(device_mutex);
     mapped[buf] = std::make_tuple(ptr, len, offset, (ssize_t)size);
 
     ++num_loaded_tensors;
     return buf;
   }
 #else
-  off_t off;
   ssize_t len;
-  void *ptr;
+  void *ptr = nullptr;
+
+  {
+    std::scoped_lock lock(device_mutex);
+    auto staged = staging.find(size);
+    if (staged != staging.end()) {
+      ptr = staged->second;
+      staging.erase(staged);
+      staged_bytes -= size;
+    }
+  }
 
-  ptr = calloc(1, size);
-  NNTR_THROW_IF(ptr == NULL, std::runtime_error)
-    << "SwapDevice: memory alloc failed";
+  if (ptr == nullptr) {
+    ptr = calloc(1, size);
+    NNTR_THROW_IF(ptr == NULL, std::runtime_error)
+      << "SwapDevice: memory alloc failed";
+  } else if (alloc_only) {
+    /** keep the zero-filled contract of a fresh allocation */
+    std::memset(ptr, 0, size);
+  }
 
   if (!alloc_only) {
-    off = lseek(fd, offset, SEEK_SET);
-    NNTR_THROW_IF(off < 0, std::runtime_error)
-      << "SwapDevice: seek file: " << dev_path;
-
-    len = read(fd, ptr, size);
-    NNTR_THROW_IF(len != (size_t)size, std::runtime_error)
+    len = readData(offset, ptr, size);
+    if (len != (ssize_t)size)
+      free(ptr);
+    NNTR_THROW_IF(len != (ssize_t)size, std::runtime_error)
       << "SwapDevice: read file: " << dev_path;
   }
 
+  std::scoped_lock lock(device_mutex);
   allocated[ptr] = std::make_pair(offset, (ssize_t)size);
 
   ++num_loaded_tensors;
+  loaded_bytes += size;
+  peak_loaded_bytes = std::max(peak_loaded_bytes, loaded_bytes);
 
   return ptr;
 #endif
 }
 
-void SwapDevice::putBuffer(void *ptr, bool dealloc_only) {
+void SwapDevice::putBuffer(void *ptr, bool dealloc_only, SwapCodec codec) {
   NNTR_THROW_IF(fd <= 0, std::runtime_error)
     << "SwapDevice: Device is not started";
 #ifdef USE_MMAP
-  if (mapped.size() == 0) {
-    return;
+  std::tuple<void *, size_t, off_t, ssize_t> info;
+  {
+    std::scoped_lock lock(device_mutex);
+    if (mapped.size() == 0) {
+      return;
+    }
+
+    NNTR_THROW_IF(mapped.find(ptr) == mapped.end(), std::runtime_error)
+      << "Couldn't find buffer";
+
+    info = mapped[ptr];
+    mapped.erase(ptr);
   }
   int ret;
 
-  NNTR_THROW_IF(mapped.find(ptr) == mapped.end(), std::runtime_error)
-    << "Couldn't find buffer";
-
-  off_t off;
   ssize_t len;
-  auto info = mapped[ptr];
   if (!dealloc_only) {
-    off = lseek(fd, std::get<2>(info), SEEK_SET);
-    NNTR_THROW_IF(off < 0, std::runtime_error)
-      << "SwapDevice: seek file: " << dev_path;
-
     ssize_t size = std::get<3>(info);
-    len = write(fd, ptr, size);
+    len = writeData(std::get<2>(info), ptr, size, codec);
     NNTR_THROW_IF(len != size, std::runtime_error)
       << "SwapDevice: write file: " << len << "::" << std::to_string(size)
       << dev_path;
@@ -166,43 +337,67 @@ void SwapDevice::putBuffer(void *ptr, bool dealloc_only) {
     << "SwapDevice: munmap: "
     << std::string(strerror_r(errno, error_buf, error_buflen));
 
-  mapped.erase(ptr);
-
 #ifndef __ANDROID__
   madvise(std::get<void *>(info), std::get<size_t>(info), MADV_FREE);
 #endif
 
+  std::scoped_lock lock(device_mutex);
 #else
-  off_t off;
   ssize_t len;
-
-  NNTR_THROW_IF(allocated.find(ptr) == allocated.end(), std::invalid_argument)
-    << "SwapDevice: Couldn't find buffer";
-
-  auto [offset, size] = allocated[ptr];
+  off_t offset;
+  ssize_t size;
+
+  {
+    std::scoped_lock lock(device_mutex);
+    auto found = allocated.find(ptr);
+    NNTR_THROW_IF(found == allocated.end(), std::invalid_argument)
+      << "SwapDevice: Couldn't find buffer";
+    std::tie(offset, size) = found->second;
+    allocated.erase(found);
+  }
 
   if (!dealloc_only) {
-    off = lseek(fd, offset, SEEK_SET);
-    NNTR_THROW_IF(off < 0, std::runtime_error)
-      << "SwapDevice: seek file: " << dev_path;
-
-    len = write(fd, ptr, size);
+    len = writeData(offset, ptr, size, codec);
     NNTR_THROW_IF(len != size, std::runtime_error)
       << "SwapDevice: write file: " << dev_path;
   }
 
-  free(ptr);
-  allocated.erase(ptr);
-
+  std::scoped_lock lock(device_mutex);
+  loaded_bytes -= size;
+
+  /**
+   * Keep the buffer for the next load of the same size as long as the loaded
+   * and the staged buffers together stay under the peak of loaded buffers, so
+   * that staging never raises the memory footprint.
+   */
+  if (loaded_bytes + staged_bytes + size <= peak_loaded_bytes) {
+    staging.emplace(size, ptr);
+    staged_bytes += size;
+  } else {
+    free(ptr);
 #if !defined(__ANDROID__) && !defined(_WIN32)
-  malloc_trim(0);
+    malloc_trim(0);
 #endif
+  }
 
 #endif
   --num_loaded_tensors;
 }
 
-unsigned int SwapDevice::getNumLoadedTensors() { return num_loaded_tensors; }
+unsigned int SwapDevice::getNumLoadedTensors() {
+  std::scoped_lock lock(device_mutex);
+  return num_loaded_tensors;
+}
+
+bool SwapDevice::isCompressed(off_t offset) {
+  std::scoped_lock lock(device_mutex);
+  return stored.find(offset) != stored.end();
+}
+
+SwapDevice::CompressionStats SwapDevice::getCompressionStats() {
+  std::scoped_lock lock(device_mutex);
+  return compression_stats;
+}
 
 /**
  * @brief Close device
@@ -222,8 +417,26 @@ void SwapDevice::finish() {
   for (auto &alloc : allocated)
     free(alloc.first);
   allocated.clear();
+  for (auto &[size, ptr] : staging)
+    free(ptr);
+  staging.clear();
+  staged_bytes = loaded_bytes = peak_loaded_bytes = 0;
 #endif
 
+  if (compression_stats.raw_bytes > 0) {
+    std::stringstream ss;
+    ss << "SwapDevice(" << dev_path << "): compressed "
+       << compression_stats.raw_bytes << " -> "
+       << compression_stats.stored_bytes << " bytes, ratio "
+       << compression_stats.getRatio() << ", compress "
+       << compression_stats.compress_us << " us, decompress "
+       << compression_stats.decompress_us << " us";
+    ml_logi("%s", ss.str().c_str());
+    PROFILE_MEM_ANNOTATE(ss.str());
+  }
+  stored.clear();
+  compression_stats = CompressionStats();
+
   close(fd);
   fd = -1;
   if (execution_mode == ml::train::ExecutionMode::TRAIN) {
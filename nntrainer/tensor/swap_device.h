@@ -18,8 +18,10 @@
 #include <fcntl.h>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <nntrainer_error.h>
 #include <string>
+#include <swap_compressor.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <system_error>
@@ -44,6 +46,26 @@ namespace nntrainer {
  */
 class SwapDevice {
 public:
+  /**
+   * @brief Statistics of the compressed writes and reads
+   */
+  struct CompressionStats {
+    size_t raw_bytes = 0;      /**< bytes given to the codecs */
+    size_t stored_bytes = 0;   /**< bytes written for them */
+    int64_t compress_us = 0;   /**< time spent to compress */
+    int64_t decompress_us = 0; /**< time spent to decompress */
+
+    /**
+     * @brief Get the compression ratio
+     *
+     * @return raw bytes per stored byte, 1 if nothing is compressed
+     */
+    double getRatio() const {
+      return stored_bytes ? static_cast<double>(raw_bytes) / stored_bytes
+                          : 1.0;
+    }
+  };
+
   /**
    * @brief swap device default path
    *
@@ -107,8 +129,11 @@ public:
    *
    * @param ptr The pointer obtained from getBuffer
    * @param dealloc_only only deallocate buffer without writing data
+   * @param codec codec to store the data with, the data is stored as is if
+   * the codec can not shrink it
    */
-  void putBuffer(void *ptr, bool dealloc_only = false);
+  void putBuffer(void *ptr, bool dealloc_only = false,
+                 SwapCodec codec = SwapCodec::NONE);
 
   /**
    * @brief Close device
@@ -139,6 +164,13 @@ public:
    */
   unsigned int getNumLoadedTensors();
 
+  /**
+   * @brief Get the statistics of the compressed data
+   *
+   * @return statistics since the device is started
+   */
+  CompressionStats getCompressionStats();
+
   /**
    * @brief set FSU weight path
    *
@@ -156,6 +188,27 @@ public:
   }
 
 private:
+  /**
+   * @brief Read data at the offset, decompressing it if it is stored
+   * compressed
+   *
+   * @return size on success, negative or less than size on failure
+   */
+  ssize_t readData(off_t offset, void *buf, size_t size);
+
+  /**
+   * @brief Write data at the offset with the codec
+   *
+   * @return size on success, negative or less than size on failure
+   */
+  ssize_t writeData(off_t offset, const void *buf, size_t size,
+                    SwapCodec codec);
+
+  /**
+   * @brief Check if the data at the offset is stored compressed
+   */
+  bool isCompressed(off_t offset);
+
   std::string dev_path; /**< device path */
   int fd;               /**< device file description */
   std::vector<std::pair<size_t, size_t>> weight_offset;
@@ -168,7 +221,18 @@ private:
 #else
   std::map<void *, std::pair<off_t, ssize_t>>
     allocated; /**< <pointer, <offset, size>> */
+  std::multimap<size_t, void *>
+    staging;                    /**< <size, pointer> of reusable buffers */
+  size_t staged_bytes = 0;      /**< bytes held by staging */
+  size_t loaded_bytes = 0;      /**< bytes of allocated buffers */
+  size_t peak_loaded_bytes = 0; /**< peak of loaded_bytes */
 #endif
+  std::map<off_t, std::pair<SwapCodec, size_t>>
+    stored; /**< <offset, <codec, stored size>> of compressed data */
+  CompressionStats compression_stats; /**< statistics of the codecs */
+  int compress_item = -1;   /**< profiler item of compression time */
+  int decompress_item = -1; /**< profiler item of decompression time */
+  std::mutex device_mutex; /**< protect the buffer maps from the loaders */
 };
 } // namespace nntrainer
 
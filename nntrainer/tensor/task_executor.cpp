@@ -29,34 +29,55 @@ namespace nntrainer {
 
 std::atomic_int32_t TaskExecutor::ids(1);
 
-TaskExecutor::TaskExecutor(const std::string &n) :
+TaskExecutor::TaskExecutor(const std::string &n, unsigned int num_workers) :
   name(n), run_thread(true), wait_complete(false), stop_all(false) {
-  task_thread = std::thread([&]() {
-    ml_logd("Task Thread(%s): start thread", name.c_str());
-    while (run_thread) {
-      std::unique_lock<std::mutex> lk(task_mutex);
-      task_cv.wait(lk, [&] { return !task_queue.empty() || stop_all; });
-      if (stop_all && task_queue.empty())
-        return;
-      auto &task_info = task_queue.front();
-
-      const auto &id = std::get<int>(task_info);
-      const auto &callback = std::get<CompleteCallback>(task_info);
-
-      auto status = worker(task_info);
-      callback(id, status);
-
-      task_queue.pop_front();
-    }
-    ml_logd("Task Thread(%s): finish thread", name.c_str());
-  });
+  num_workers = std::max(num_workers, 1u);
+  for (unsigned int i = 0; i < num_workers; ++i)
+    task_threads.emplace_back(&TaskExecutor::workerLoop, this);
 }
 
 TaskExecutor::~TaskExecutor() {
-  run_thread = false;
-  stop_all = true;
+  {
+    std::scoped_lock lock(task_mutex);
+    run_thread = false;
+    stop_all = true;
+  }
   task_cv.notify_all();
-  task_thread.join();
+  for (auto &thread : task_threads)
+    thread.join();
+}
+
+void TaskExecutor::workerLoop() {
+  ml_logd("Task Thread(%s): start thread", name.c_str());
+  std::unique_lock<std::mutex> lk(task_mutex);
+  while (run_thread) {
+    task_cv.wait(lk, [&] { return !task_queue.empty() || stop_all; });
+    if (stop_all && task_queue.empty())
+      break;
+
+    /** highest priority first, the earliest one among the same priority */
+    auto it = std::min_element(
+      task_queue.begin(), task_queue.end(), [](auto &lhs, auto &rhs) {
+        return std::get<std::shared_ptr<TaskAsync<>>>(lhs)->getPriority() <
+               std::get<std::shared_ptr<TaskAsync<>>>(rhs)->getPriority();
+      });
+    running_tasks.splice(running_tasks.end(), task_queue, it);
+
+    /** list nodes are stable, the info stays valid while unlocked */
+    auto &task_info = running_tasks.back();
+    auto task_it = std::prev(running_tasks.end());
+    lk.unlock();
+
+    const auto &id = std::get<int>(task_info);
+    const auto &callback = std::get<CompleteCallback>(task_info);
+
+    auto status = worker(task_info);
+    callback(id, status);
+
+    lk.lock();
+    running_tasks.erase(task_it);
+  }
+  ml_logd("Task Thread(%s): finish thread", name.c_str());
 }
 
 int TaskExecutor::run(std::shared_ptr<Task> task) {
@@ -68,20 +89,33 @@ int TaskExecutor::run(std::shared_ptr<Task> task) {
 void TaskExecutor::cancel(int id) {
   std::scoped_lock lock(task_mutex);
 
-  auto it = std::find_if(task_queue.begin(), task_queue.end(),
-                         [&](auto &info) { return std::get<int>(info) == id; });
+  auto match = [&](auto &info) { return std::get<int>(info) == id; };
+
+  auto it = std::find_if(task_queue.begin(), task_queue.end(), match);
+  if (it != task_queue.end()) {
+    std::get<std::atomic_bool>(*it).store(false);
+    return;
+  }
 
-  if (it != task_queue.end())
+  it = std::find_if(running_tasks.begin(), running_tasks.end(), match);
+  if (it != running_tasks.end())
     std::get<std::atomic_bool>(*it).store(false);
 }
 
 void TaskExecutor::cancelAll(void) {
+  std::scoped_lock lock(task_mutex);
+
   for (auto &task_info : task_queue) {
     std::get<std::atomic_bool>(task_info).store(false);
   }
+  for (auto &task_info : running_tasks) {
+    std::get<std::atomic_bool>(task_info).store(false);
+  }
 }
 
 void TaskExecutor::clean(void) {
+  std::scoped_lock lock(task_mutex);
+
   for (auto it = task_queue.begin(); it != task_queue.end();) {
     auto running = std::get<std::atomic_bool>(*it).load();
     if (running == false)
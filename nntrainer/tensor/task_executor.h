@@ -22,6 +22,7 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include <task.h>
 
@@ -58,8 +59,12 @@ public:
   /**
    * @brief TaskExecutor constructor
    *
+   * @param name name of the executor for logging
+   * @param num_workers number of worker threads, tasks run concurrently if
+   * more than one
    */
-  explicit TaskExecutor(const std::string &name = "");
+  explicit TaskExecutor(const std::string &name = "",
+                        unsigned int num_workers = 1);
 
   /**
    * @brief TaskExecutor destructor
@@ -76,7 +81,8 @@ public:
   virtual int run(std::shared_ptr<Task> task);
 
   /**
-   * @brief Run task asynchronously
+   * @brief Run task asynchronously. Queued tasks are picked by priority of
+   * the task, in submission order among the same priority
    *
    * @param task async task to be run
    * @param callback complete callback
@@ -148,17 +154,24 @@ protected:
   virtual CompleteStatus handleWork(std::atomic_bool &running, Task::Work &work,
                                     void *data);
 
+  /**
+   * @brief worker thread loop, takes a task from task_queue and runs it
+   * without holding task_mutex
+   */
+  void workerLoop();
+
   static std::atomic_int32_t ids;
   std::string name;
   bool run_thread;
   bool wait_complete;
   bool stop_all;
 
-  std::list<TaskInfo<>> task_queue;
+  std::list<TaskInfo<>> task_queue;    /**< tasks waiting for a worker */
+  std::list<TaskInfo<>> running_tasks; /**< tasks taken by a worker */
 
   std::condition_variable task_cv;
   std::condition_variable comp_cv;
-  std::thread task_thread;
+  std::vector<std::thread> task_threads;
   std::mutex task_mutex;
 };
 
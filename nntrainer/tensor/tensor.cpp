@@ -1009,6 +1009,26 @@ Tensor &Tensor::dotBatched(Tensor const &m, Tensor &result, bool trans,
   if (!result.isAllocated())
     throw std::invalid_argument(
       "Output tensor must be preallocated for dotBatched operation");
+
+  bool contiguous =
+    getContiguous() && m.getContiguous() && result.getContiguous();
+
+  /// a matrix shared by every batch folds the batch into the rows of a single
+  /// product
+  if (contiguous && !trans && m.batch() == 1 && batch() > 1)
+    return dot(m, result, trans, trans_m, beta);
+
+  /// floating point tensors run the batches as a single strided batched gemm
+  bool batched_gemm =
+    (getDataType() == Tdatatype::FP32 || getDataType() == Tdatatype::FP16) &&
+    m.getDataType() == getDataType() && result.getDataType() == getDataType();
+
+  if (contiguous && batched_gemm &&
+      (m.batch() == batch() || m.batch() == 1)) {
+    itensor->dotBatched(m, result, trans, trans_m, beta);
+    return result;
+  }
+
   for (unsigned int b = 0; b < batch(); b++) {
     /** @todo try using transpose to speedup the operation */
     const Tensor this_b = this->getBatchSlice(b, 1);
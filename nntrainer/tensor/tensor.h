@@ -1355,7 +1355,9 @@ public:
   /**
    * @copydoc Tensor::dot(Tensor const &input, Tensor &output, bool trans,
               bool trans_in, float beta) const
-   * @details performs dot operation over a batch of inputs
+   * @details performs dot operation over a batch of inputs. An input with a
+   * single batch is used for every batch. Floating point tensors run all the
+   * batches as a single strided batched gemm.
    */
   Tensor &dotBatched(Tensor const &input, Tensor &result, bool trans = false,
                      bool trans_in = false, float beta = 0.0f) const;
@@ -363,6 +363,109 @@ void TensorBase::calculateFlattenDot(
   ldc = (getFormat() == Tformat::NHWC) ? output.channel() : output.width();
 }
 
+void TensorBase::calculateBatchedDot(Tensor const &input, Tensor &output,
+                                     bool trans, bool trans_in,
+                                     unsigned int &M, unsigned int &N,
+                                     unsigned int &K, unsigned int &lda,
+                                     unsigned int &ldb, unsigned int &ldc,
+                                     size_t &stride, size_t &input_stride,
+                                     size_t &output_stride) const {
+  bool nhwc = getFormat() == Tformat::NHWC;
+  unsigned int rows = nhwc ? height() * width() : channel() * height();
+  unsigned int cols = nhwc ? channel() : width();
+  unsigned int input_rows =
+    nhwc ? input.height() * input.width() : input.channel() * input.height();
+  unsigned int input_cols = nhwc ? input.channel() : input.width();
+
+  M = trans ? cols : rows;
+  K = trans ? rows : cols;
+  N = trans_in ? input_rows : input_cols;
+  if (K != (trans_in ? input_cols : input_rows))
+    throw std::runtime_error("Error: incompatible dimensions for dot product");
+
+  NNTR_THROW_IF(input.batch() != batch() && input.batch() != 1,
+                std::invalid_argument)
+    << "Error: batch of the input must be " << batch() << " or 1";
+  NNTR_THROW_IF(output.batch() != batch() ||
+                  output.getDim().getFeatureLen() != (size_t)M * N,
+                std::invalid_argument)
+    << "Error: output of the batched dot product must be " << batch()
+    << " batches of " << M << "x" << N;
+
+  lda = cols;
+  ldb = input_cols;
+  ldc = N;
+  stride = dim.getFeatureLen();
+  input_stride = input.batch() == 1 ? 0 : input.getDim().getFeatureLen();
+  output_stride = output.getDim().getFeatureLen();
+}
+
+TensorBase::TransposeInfo
+TensorBase::computeTransposeInfo(const std::string &direction) const {
+  int dirs[3];
+  int status = getValues(3, direction, dirs);
+  NNTR_THROW_IF(status != ML_ERROR_NONE, std::invalid_argument)
+    << "parsing direction failed";
+
+  /// channel, height and width (0, 1, 2) in the order they are laid out
+  const bool nchw = getFormat() == Tformat::NCHW;
+  const std::array<int, 3> in_order =
+    nchw ? std::array<int, 3>{0, 1, 2} : std::array<int, 3>{1, 2, 0};
+  const std::array<int, 3> out_order =
+    nchw ? std::array<int, 3>{dirs[0], dirs[1], dirs[2]}
+         : std::array<int, 3>{dirs[1], dirs[2], dirs[0]};
+
+  /// sizes of the axes in memory and the memory axis of the input each axis
+  /// of the output comes from
+  unsigned int d[3];
+  int p[3];
+  for (int i = 0; i < 3; ++i) {
+    d[i] = dim.getTensorDim(in_order[i] + 1);
+    auto it = std::find(in_order.begin(), in_order.end(), out_order[i]);
+    NNTR_THROW_IF(it == in_order.end(), std::invalid_argument)
+      << "invalid transpose direction: " << direction;
+    p[i] = it - in_order.begin();
+  }
+  NNTR_THROW_IF(p[0] == p[1] || p[1] == p[2] || p[0] == p[2],
+                std::invalid_argument)
+    << "invalid transpose direction: " << direction;
+
+  /// axes of size 1 can go anywhere, so pick the cheapest permutation which
+  /// keeps the order of the other axes, e.g. 2:1:0 of a 1 x H x W tensor is a
+  /// single H x W transpose
+  auto squeezed = [&d](const int *perm) {
+    std::vector<int> axes;
+    for (int i = 0; i < 3; ++i)
+      if (d[perm[i]] != 1)
+        axes.push_back(perm[i]);
+    return axes;
+  };
+  static constexpr int by_cost[6][3] = {{0, 1, 2}, {1, 2, 0}, {2, 0, 1},
+                                        {0, 2, 1}, {1, 0, 2}, {2, 1, 0}};
+  for (auto &perm : by_cost) {
+    if (squeezed(perm) == squeezed(p)) {
+      std::copy(perm, perm + 3, p);
+      break;
+    }
+  }
+
+  switch (p[0] * 100 + p[1] * 10 + p[2]) {
+  case 12: /** [d0][d1][d2] as is */
+    return {1, 1, 1, d[0] * d[1] * d[2], 0, 0, 0, 0};
+  case 21: /** [d1][d2] of each d0 */
+    return {d[0], d[1], d[2], 1, d[2], d[1], (size_t)d[1] * d[2],
+            (size_t)d[1] * d[2]};
+  case 102: /** [d0][d1] of rows of d2 */
+    return {1, d[0], d[1], d[2], d[1] * d[2], d[0] * d[2], 0, 0};
+  case 120: /** [d0][d1 * d2] */
+    return {1, d[0], d[1] * d[2], 1, d[1] * d[2], d[0], 0, 0};
+  case 201: /** [d0 * d1][d2] */
+    return {1, d[0] * d[1], d[2], 1, d[2], d[0] * d[1], 0, 0};
+  default: /** [d0][d2] strided by d1 for each d1 */
+    return {d[1], d[0], d[2], 1, d[1] * d[2], d[1] * d[0], d[2], d[0]};
+  }
+}
+
 /**
  * Please note that the following functions need to be implemented in a child
  * class to utilize tensor operations fully — operations such as addition,
@@ -532,6 +635,13 @@ Tensor &TensorBase::dot(Tensor const &input, Tensor &output, bool trans,
     getStringDataType());
 }
 
+Tensor &TensorBase::dotBatched(Tensor const &input, Tensor &output,
+                               bool trans, bool trans_in, float beta) const {
+  throw std::invalid_argument(
+    "Tensor::dotBatched() is currently not supported in tensor data type " +
+    getStringDataType());
+}
+
 void TensorBase::dropout_mask(float dropout) {
   throw std::invalid_argument(
     "Tensor::dropout_mask() is currently not supported in tensor data type " +
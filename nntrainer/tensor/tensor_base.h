@@ -13,6 +13,7 @@
 #define __TENSOR_BASE_H__
 #ifdef __cplusplus
 
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 
@@ -22,34 +23,6 @@
 #include <tensor_dim.h>
 #include <util_func.h>
 
-#define transposeloop(cl, ci, cj, ck, sl, si, sj, sk)                          \
-  do {                                                                         \
-    unsigned int i, j, k, l;                                                   \
-    int inidx = 0, outidx = 0;                                                 \
-    for (cl = 0; cl < sl; cl++)                                                \
-      for (ci = 0; ci < si; ci++)                                              \
-        for (cj = 0; cj < sj; cj++)                                            \
-          for (ck = 0; ck < sk; ck++) {                                        \
-            outidx = si * sj * sk * cl + sj * sk * ci + sk * cj + ck;          \
-            inidx = l * SI * SJ * SK + i * SJ * SK + j * SK + k;               \
-            outptr[outidx] = inptr[inidx];                                     \
-          }                                                                    \
-  } while (0);
-
-#define transposeloop_nhwc(cl, ci, cj, ck, sl, si, sj, sk)                     \
-  do {                                                                         \
-    unsigned int i, j, k, l;                                                   \
-    int inidx = 0, outidx = 0;                                                 \
-    for (cl = 0; cl < sl; cl++)                                                \
-      for (ci = 0; ci < si; ci++)                                              \
-        for (cj = 0; cj < sj; cj++)                                            \
-          for (ck = 0; ck < sk; ck++) {                                        \
-            outidx = si * sj * sk * cl + sj * sk * ci + sk * cj + ck;          \
-            inidx = l * SJ * SK * SI + j * SK * SI + k * SI + i;               \
-            outptr[outidx] = inptr[inidx];                                     \
-          }                                                                    \
-  } while (0);
-
 namespace nntrainer {
 
 using TensorDim = ml::train::TensorDim;
@@ -424,6 +397,20 @@ public:
   virtual Tensor &dot(Tensor const &input, Tensor &output, bool trans,
                       bool trans_in, float beta) const;
 
+  /**
+   * @brief     Batched Dot Product of Tensor
+   * @details   This applies dot of each batch of this and the same batch of
+   * input, or the only batch of input if it has a single batch.
+   * @param[in] input Tensor
+   * @param[in] output preallocated output Tensor
+   * @param[in] trans Transpose
+   * @param[in] trans_in Transpose input
+   * @param[in] beta beta
+   * @retval    Calculated Tensor
+   */
+  virtual Tensor &dotBatched(Tensor const &input, Tensor &output, bool trans,
+                             bool trans_in, float beta) const;
+
   /**
    * @copydoc Tensor::dropout_mask(float dropout)
    */
@@ -839,6 +826,143 @@ protected:
                            unsigned int &N, unsigned int &K, unsigned int &lda,
                            unsigned int &ldb, unsigned int &ldc) const;
 
+  /**
+   * @brief Calcuates variables needed to perform the dot product of each batch
+   *
+   * @param[in]  input Tensor
+   * @param[in]  output preallocated output Tensor
+   * @param[in]  trans Transpose
+   * @param[in]  trans_in Transpose input
+   * @param[out] M number of op(this)'s and output's row of a batch
+   * @param[out] N number of op(inputs)'s and output's columns of a batch
+   * @param[out] K number of op(this)'s column and op(input)'s row of a batch
+   * @param[out] lda leading dimension of this
+   * @param[out] ldb leading dimension of input
+   * @param[out] ldc leading dimension of output
+   * @param[out] stride elements between the batches of this
+   * @param[out] input_stride elements between the batches of input, 0 if the
+   * single batch of input is used for every batch
+   * @param[out] output_stride elements between the batches of output
+   *
+   * @note op(X) is one of X or X**T
+   */
+  void calculateBatchedDot(Tensor const &input, Tensor &output, bool trans,
+                           bool trans_in, unsigned int &M, unsigned int &N,
+                           unsigned int &K, unsigned int &lda,
+                           unsigned int &ldb, unsigned int &ldc,
+                           size_t &stride, size_t &input_stride,
+                           size_t &output_stride) const;
+
+  /**
+   * @struct TransposeInfo
+   * @brief Every direction of transpose moves the three inner axes of each
+   * batch as @a count strided 2D transposes. Elements of a 2D transpose are
+   * blocks of @a block contiguous elements, which is 1 unless the innermost
+   * axis stays in place.
+   */
+  struct TransposeInfo {
+    unsigned int count;  /**< number of 2D transposes in a batch */
+    unsigned int rows;   /**< rows of a 2D transpose */
+    unsigned int cols;   /**< columns of a 2D transpose */
+    unsigned int block;  /**< contiguous elements moved together */
+    unsigned int ld_src; /**< elements between the rows of the source */
+    unsigned int ld_dst; /**< elements between the rows of the destination */
+    size_t src_step;     /**< elements between the 2D transposes in source */
+    size_t dst_step; /**< elements between the 2D transposes in destination */
+  };
+
+  /**
+   * @brief Reduce the transpose of @a direction to strided 2D transposes
+   *
+   * @param[in] direction to transpose, e.g. "0:2:1"
+   * @return TransposeInfo 2D transposes of a batch
+   */
+  TransposeInfo computeTransposeInfo(const std::string &direction) const;
+
+  /**
+   * @brief Run the 2D transposes of @a info over every batch. Rows of the
+   * transposes are handed to the threads in bands, so both a single large
+   * transpose and many small ones are parallelized. Transposes of a few rows
+   * are run in groups over the same columns, as they write next to each
+   * other in the destination.
+   *
+   * @param[in] info 2D transposes of a batch
+   * @param[in] in data of this tensor
+   * @param[out] out data of the output tensor
+   * @param[in] transpose_2d kernel of the signature of transpose_matrix()
+   */
+  template <typename T, typename Transpose2D>
+  void transposeData(const TransposeInfo &info, const T *in, T *out,
+                     Transpose2D transpose_2d) const {
+    /// rows of a job and columns of a tile, a band of rows writes whole cache
+    /// lines of the destination
+    constexpr unsigned int band = 64;
+    const size_t feature_len = dim.getFeatureLen();
+    const unsigned int bands = (info.rows + band - 1) / band;
+    const unsigned int group = std::max(1u, band / info.rows);
+    const unsigned int groups = (info.count + group - 1) / group;
+    const long jobs = (long)batch() * groups * bands;
+
+#pragma omp parallel for schedule(static) if (size() >= (1u << 16))
+    for (long job = 0; job < jobs; ++job) {
+      const size_t b = job / bands / groups;
+      const unsigned int t0 = job / bands % groups * group;
+      const unsigned int t1 = std::min(t0 + group, info.count);
+      const unsigned int r0 = job % bands * band;
+      const unsigned int rows = std::min(band, info.rows - r0);
+
+      for (unsigned int c0 = 0; c0 < info.cols; c0 += band) {
+        const unsigned int cols = std::min(band, info.cols - c0);
+        for (unsigned int t = t0; t < t1; ++t) {
+          const T *src = in + b * feature_len + t * info.src_step +
+                         (size_t)r0 * info.ld_src + (size_t)c0 * info.block;
+          T *dst = out + b * feature_len + t * info.dst_step +
+                   (size_t)r0 * info.block + (size_t)c0 * info.ld_dst;
+
+          if (info.block == 1) {
+            transpose_2d(rows, cols, src, info.ld_src, dst, info.ld_dst);
+            continue;
+          }
+
+          for (unsigned int r = 0; r < rows; ++r)
+            for (unsigned int c = 0; c < cols; ++c)
+              std::copy_n(src + (size_t)r * info.ld_src +
+                            (size_t)c * info.block,
+                          info.block,
+                          dst + (size_t)c * info.ld_dst +
+                            (size_t)r * info.block);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Cache blocked 2D transpose for the data types without a kernel in
+   * the compute backend
+   *
+   * @param M row length of input matrix
+   * @param N col length of input matrix
+   * @param src src data of input matrix
+   * @param ld_src data offset of input matrix
+   * @param dst destination of output matrix
+   * @param ld_dst data offset of output matrix
+   */
+  template <typename T>
+  static void transposeMatrix(const unsigned int M, const unsigned int N,
+                              const T *src, unsigned int ld_src, T *dst,
+                              unsigned int ld_dst) {
+    constexpr unsigned int tile = 32;
+    for (unsigned int i0 = 0; i0 < M; i0 += tile) {
+      const unsigned int i1 = std::min(i0 + tile, M);
+      for (unsigned int j0 = 0; j0 < N; j0 += tile) {
+        const unsigned int j1 = std::min(j0 + tile, N);
+        for (unsigned int i = i0; i < i1; ++i)
+          for (unsigned int j = j0; j < j1; ++j)
+            dst[(size_t)j * ld_dst + i] = src[(size_t)i * ld_src + j];
+      }
+    }
+  }
+
   /**
    * @brief  Get the Data Type String object
    * @return std::string of tensor data type
@@ -14,6 +14,9 @@
  * @todo   check before allocate that finalize is done
  */
 
+#include <algorithm>
+#include <climits>
+
 #include <memory_pool.h>
 #include <nntrainer_log.h>
 #include <tensor.h>
@@ -128,6 +131,12 @@ void TensorPool::finalize(const MemoryPlanner &planner,
       continue;
     }
     details->token = 0;
+    details->recompute_token = 0;
+
+    /// a plan made before, e.g. to fit the memory budget, resolved the
+    /// persist end order in place, so it is requested again for this plan
+    if (details->persist_idx < details->exec_order.size())
+      details->exec_order[details->persist_idx] = PERSIST_END_ORDER;
 
     /**
      * 1. create the validity ranges for the all the requested tensors.
@@ -157,6 +166,7 @@ void TensorPool::finalize(const MemoryPlanner &planner,
         }
         validity_end = end_order;
         details->exec_order[idx] = validity_end;
+        details->persist_idx = idx;
         break;
       }
 
@@ -164,6 +174,11 @@ void TensorPool::finalize(const MemoryPlanner &planner,
         validity_end = std::max(validity_end, details->exec_order[idx]);
       }
     }
+    for (auto order : details->recompute_exec_order) {
+      validity_start = std::min(validity_start, order);
+      validity_end = std::max(validity_end, order);
+    }
+
     /**
      * use lifespan to update the validity.
      * if the validity is long term, the tensor must stay valid for the
@@ -174,6 +189,30 @@ void TensorPool::finalize(const MemoryPlanner &planner,
       validity_end = end_order;
     }
 
+    /**
+     * a tensor written again by the recomputation does not need to be valid
+     * from its last use before the recomputation until the recomputation
+     */
+    unsigned int recompute_order = details->recompute_order;
+    bool recompute = recompute_order != 0 &&
+                     !isTensorLongTerm(details->lifespan) &&
+                     validity_start < recompute_order;
+    std::vector<unsigned int> forward_exec_order, recompute_exec_order;
+    unsigned int forward_end = validity_start;
+    if (recompute) {
+      for (auto order : details->exec_order) {
+        if (order < recompute_order) {
+          forward_exec_order.push_back(order);
+          forward_end = std::max(forward_end, order);
+        } else {
+          recompute_exec_order.push_back(order);
+        }
+      }
+      recompute_exec_order.insert(recompute_exec_order.end(),
+                                  details->recompute_exec_order.begin(),
+                                  details->recompute_exec_order.end());
+    }
+
     /** 2. for each tensor request if it is in the provided range */
     if (validity_end < start_order || validity_start > end_order) {
       continue;
@@ -183,8 +222,17 @@ void TensorPool::finalize(const MemoryPlanner &planner,
      * 3. requestMemory for all the tensors and set their tokens
      * @note +1 is to make the validity_end exlusive in the interval range
      */
-    size_t tensor_bytes =
-      spec.tensor->bytes() + spec.tensor->scale_size() * sizeof(float);
+    size_t num_scales = spec.tensor->scale_size();
+
+    if (reserve_channel_scales &&
+        (spec.tensor->getDataType() == Tdatatype::QINT8 ||
+         spec.tensor->getDataType() == Tdatatype::QINT4)) {
+      Tensor per_channel(spec.tensor->getDim(), false, Initializer::NONE, "",
+                         QScheme::PER_CHANNEL_AFFINE);
+      num_scales = std::max(num_scales, per_channel.scale_size());
+    }
+
+    size_t tensor_bytes = spec.tensor->bytes() + num_scales * sizeof(float);
 
     /// @note this is a temporal way to reserve memory space for zero point
     if (spec.tensor->getDataType() == Tdatatype::UINT8 ||
@@ -193,9 +241,18 @@ void TensorPool::finalize(const MemoryPlanner &planner,
       tensor_bytes += spec.tensor->scale_size() * sizeof(unsigned int);
     }
 
-    details->token = mem_pool->requestMemory(
-      tensor_bytes, validity_start, validity_end + 1, details->exec_order,
-      details->lifespan, spec.is_weight_grad);
+    if (recompute) {
+      details->token = mem_pool->requestMemory(
+        tensor_bytes, validity_start, forward_end + 1, forward_exec_order,
+        details->lifespan, spec.is_weight_grad);
+      details->recompute_token = mem_pool->requestMemory(
+        tensor_bytes, recompute_order, validity_end + 1, recompute_exec_order,
+        details->lifespan, spec.is_weight_grad);
+    } else {
+      details->token = mem_pool->requestMemory(
+        tensor_bytes, validity_start, validity_end + 1, details->exec_order,
+        details->lifespan, spec.is_weight_grad);
+    }
 #ifdef DEBUG
     if (details->token == 0)
       throw std::runtime_error("Received invalid token from memory pool");
@@ -245,6 +302,29 @@ void TensorPool::allocate(bool init) {
   }
 }
 
+void TensorPool::share(TensorPool &owner) {
+  NNTR_THROW_IF(pool.size() != owner.pool.size(), std::invalid_argument)
+    << "cannot share the tensors of a pool of other tensors";
+  for (unsigned int i = 0; i < pool.size(); ++i) {
+    const Tensor &tensor = *pool[i].tensor;
+    const Tensor &shared = *owner.pool[i].tensor;
+    NNTR_THROW_IF(tensor.getName() != shared.getName() ||
+                    tensor.getDim() != shared.getDim(),
+                  std::invalid_argument)
+      << "cannot share " << shared.getName() << " as " << tensor.getName();
+  }
+
+  mem_pool->share(*owner.mem_pool);
+  for (auto &spec : pool) {
+    auto details = std::get_if<SourceDetails>(&spec.details);
+    if (!details || details->token == 0) {
+      continue;
+    }
+    spec.tensor->setData(mem_pool->getMemory(details->token), 0, false);
+    syncDependents(spec);
+  }
+}
+
 /**
  * @brief Deallocate memory for all the managed tensors
  */
@@ -260,6 +340,58 @@ void TensorPool::deallocate() {
   }
 }
 
+void TensorPool::setRecompute(const std::string &name, unsigned int order,
+                              bool written) {
+  auto &spec = getSourceSpec(name);
+  auto &details = std::get<SourceDetails>(spec.details);
+  if (details.lifespan == TensorLifespan::UNMANAGED)
+    return;
+
+  /// only the tensor itself is rewritten, a view rewrites part of its source
+  bool is_source = spec.tensor->getName() == name;
+  if (written && is_source) {
+    /// tensors not used in the forwarding are not written by recomputation,
+    /// and tensors with iteration lifespan keep states such as the backups
+    /// the recomputation restores from
+    if (enum_class_logical_and(details.lifespan,
+                               TensorLifespan::FORWARD_FUNC_LIFESPAN) &&
+        details.lifespan != TensorLifespan::ITERATION_LIFESPAN)
+      details.recompute_order = order;
+  }
+  details.recompute_exec_order.push_back(order);
+}
+
+void TensorPool::clearRecompute() {
+  for (auto &spec : pool) {
+    if (auto details = std::get_if<SourceDetails>(&spec.details)) {
+      details->recompute_order = 0;
+      details->recompute_exec_order.clear();
+    }
+  }
+}
+
+void TensorPool::activateRecompute(unsigned int order) {
+  for (auto &spec : pool) {
+    auto details = std::get_if<SourceDetails>(&spec.details);
+    if (!details || details->recompute_token == 0 ||
+        details->recompute_order != order)
+      continue;
+    spec.tensor->setData(mem_pool->getMemory(details->recompute_token), 0,
+                         false);
+    syncDependents(spec);
+  }
+}
+
+void TensorPool::deactivateRecompute() {
+  for (auto &spec : pool) {
+    auto details = std::get_if<SourceDetails>(&spec.details);
+    if (!details || details->recompute_token == 0)
+      continue;
+    spec.tensor->setData(mem_pool->getMemory(details->token), 0, false);
+    syncDependents(spec);
+  }
+}
+
 const std::vector<unsigned int> &
 TensorPool::getExecutionOrder(const std::string &name) {
   return std::get<SourceDetails>(getSourceSpec(name).details).exec_order;
@@ -476,9 +608,11 @@ void TensorPool::loadCacheExec(unsigned int order) {
 }
 
 int TensorPool::loadCacheExecAsync(
-  unsigned int order, TaskExecutor::CompleteCallback complete_callback) {
+  unsigned int order, TaskExecutor::CompleteCallback complete_callback,
+  TaskAsync<>::Priority priority) {
   if (dynamic_cast<CachePool *>(mem_pool.get()))
-    return cache_loader->loadAsync(order, complete_callback);
+    return cache_loader->loadAsync(order, complete_callback, LONG_MAX,
+                                   priority);
   else
     return 0;
 }
@@ -502,4 +636,11 @@ unsigned int TensorPool::getNumLoadedTensors() {
   return cache_loader->getNumLoadedTensors();
 }
 
+int64_t TensorPool::getCacheLoadTime() {
+  if (dynamic_cast<CachePool *>(mem_pool.get()) == nullptr)
+    return 0;
+
+  return cache_loader->getAverageLoadTime();
+}
+
 } // namespace nntrainer
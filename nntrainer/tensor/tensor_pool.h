@@ -98,6 +98,15 @@ public:
    */
   void allocate(bool init = true);
 
+  /**
+   * @brief Share the memory of the tensors of another pool instead of
+   * allocating
+   *
+   * @param owner allocated pool which requested the same tensors
+   * @throw std::invalid_argument if the pools requested other tensors
+   */
+  void share(TensorPool &owner);
+
   /**
    * @brief Deallocate memory for all the managed tensors
    */
@@ -110,6 +119,40 @@ public:
    */
   const std::vector<unsigned int> &getExecutionOrder(const std::string &name);
 
+  /**
+   * @brief set the tensor to be used when a forward segment is recomputed
+   * at the given order
+   * @note a source tensor which is written by the recomputation is planned
+   * as two memories, one valid until its last use before @a order and the
+   * other valid from @a order, so that it does not hold memory in between.
+   * Tensors with iteration or long term lifespan are kept as they are.
+   *
+   * @param name name of the tensor
+   * @param order execution order of the recomputation
+   * @param written true if the tensor is written by the recomputation
+   */
+  void setRecompute(const std::string &name, unsigned int order,
+                    bool written);
+
+  /**
+   * @brief clear all the recomputation set
+   */
+  void clearRecompute();
+
+  /**
+   * @brief switch the tensors recomputed at the given order to the memory
+   * valid after the recomputation
+   *
+   * @param order execution order of the recomputation
+   */
+  void activateRecompute(unsigned int order);
+
+  /**
+   * @brief switch all the recomputed tensors back to the memory valid from
+   * the forwarding
+   */
+  void deactivateRecompute();
+
   /**
    * @brief Get the maximum real memory requirement
    *
@@ -287,10 +330,12 @@ public:
    * @brief load cache data by execution order
    *
    * @param order execution order
+   * @param priority priority among the queued loads
    * @return async task id
    */
-  int loadCacheExecAsync(unsigned int order,
-                         TaskExecutor::CompleteCallback complete_callback);
+  int loadCacheExecAsync(
+    unsigned int order, TaskExecutor::CompleteCallback complete_callback,
+    TaskAsync<>::Priority priority = TaskAsync<>::Priority::MID);
 
   /**
    * @brief load cache data by execution order
@@ -315,6 +360,13 @@ public:
    */
   unsigned int getNumLoadedTensors();
 
+  /**
+   * @brief Get the average time to load the cache data of an execution order
+   *
+   * @return time in microseconds, 0 if unknown
+   */
+  int64_t getCacheLoadTime();
+
   /**
    * @brief set FSU weight path
    *
@@ -337,6 +389,27 @@ public:
     }
   }
 
+  /**
+   * @brief set if quantized tensors reserve a scale factor per channel
+   *
+   * @param reserve true to reserve, as a quantized weight may be read with a
+   * scale factor per channel whatever the scheme it is requested with
+   */
+  void setReserveChannelScales(bool reserve) {
+    reserve_channel_scales = reserve;
+  }
+
+  /**
+   * @brief set the codec of the swapped data per tensor lifespan
+   *
+   * @param codecs codec of each lifespan
+   */
+  void setSwapCompression(const SwapCompressor::CodecMap &codecs) {
+    if (mem_pool) {
+      mem_pool->setSwapCompression(codecs);
+    }
+  }
+
 private:
   /**
    * @brief Source tensor detailed specification
@@ -348,6 +421,14 @@ private:
     std::vector<unsigned int> exec_order; /**< exec order */
     std::vector<unsigned int>
       dependents; /**< list of dependents to the source */
+    unsigned int recompute_order = 0; /**< order at which the tensor is
+                                         recomputed, 0 if not recomputed */
+    unsigned int recompute_token = 0; /**< memory token after recomputation */
+    std::vector<unsigned int>
+      recompute_exec_order; /**< exec order added by the recomputation */
+    unsigned int persist_idx =
+      std::numeric_limits<unsigned int>::max(); /**< index of the persist end
+                                                   order resolved by a plan */
   };
 
   /**
@@ -435,6 +516,8 @@ private:
     name_map;                           /**< indexing of requested tensors */
   std::shared_ptr<MemoryPool> mem_pool; /**< memory pool for the tensors */
   std::unique_ptr<CacheLoader> cache_loader; /**< memory pool for the tensors */
+  bool reserve_channel_scales =
+    false; /**< quantized tensors reserve a scale per channel */
 
   /**
    * @brief     Check if the lifespan leads to long term valitidy
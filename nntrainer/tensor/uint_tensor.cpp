@@ -355,6 +355,24 @@ void UIntTensor<T>::copy_with_stride(const Tensor &input, Tensor &output) {
   }
 }
 
+template <typename T>
+Tensor &UIntTensor<T>::transpose(const std::string &direction,
+                                 Tensor &output) const {
+  /// per channel scales would have to follow the channel axis
+  NNTR_THROW_IF(qscheme != QScheme::PER_TENSOR_AFFINE ||
+                  output.q_scheme() != QScheme::PER_TENSOR_AFFINE,
+                std::invalid_argument)
+    << getName() << " is not quantized per tensor, cannot transpose.";
+
+  output.reshape(dim.transpose(direction));
+
+  transposeData(computeTransposeInfo(direction), (T *)getData(),
+                output.getData<T>(), transposeMatrix<T>);
+  scopy(scale_size(), (float *)getScale(), 1, output.getScale<float>(), 1);
+
+  return output;
+}
+
 template <typename T> void UIntTensor<T>::save(std::ostream &file) {
   /// @note Save quantization information
   save_quantization_info(file);
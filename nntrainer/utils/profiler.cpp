@@ -12,6 +12,7 @@
  */
 #include <algorithm>
 #include <atomic>
+#include <fstream>
 #include <iomanip>
 #include <map>
 #include <numeric>
@@ -26,6 +27,53 @@
 namespace nntrainer {
 namespace profile {
 
+namespace {
+
+/**
+ * @brief get the start times of the time items in progress on the calling
+ * thread
+ *
+ * @param profiler profiler the items belong to
+ * @return std::unordered_map<int, timepoint>& start times (time_item, time)
+ */
+std::unordered_map<int, timepoint> &threadTimes(const Profiler *profiler) {
+  thread_local std::unordered_map<const Profiler *,
+                                  std::unordered_map<int, timepoint>>
+    times;
+  return times[profiler];
+}
+
+/**
+ * @brief write a string as a json string
+ *
+ * @param out outstream to write
+ * @param str string to write
+ */
+void writeJsonString(std::ostream &out, const std::string &str) {
+  out << '"';
+  for (unsigned char c : str) {
+    switch (c) {
+    case '"':
+      out << "\\\"";
+      break;
+    case '\\':
+      out << "\\\\";
+      break;
+    default:
+      if (c < 0x20) {
+        out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+            << (int)c << std::dec << std::setfill(' ');
+      } else {
+        out << c;
+      }
+      break;
+    }
+  }
+  out << '"';
+}
+
+} // namespace
+
 void GenericProfileListener::onNotifyTimeEvent(
   PROFILE_EVENT event, const int time_item, const std::string &str,
   const std::chrono::microseconds &duration) {
@@ -73,6 +121,7 @@ void GenericProfileListener::onNotifyMemoryEvent(
 
 void GenericProfileListener::notify(
   PROFILE_EVENT event, const std::shared_ptr<ProfileEventData> data) {
+  std::lock_guard<std::mutex> lock(listener_mutex);
   switch (event) {
   case EVENT_TIME_START:
     /* ignore start time. we only consider duration of item */
@@ -103,6 +152,7 @@ void GenericProfileListener::reset(const int time_item,
 
 const std::chrono::microseconds
 GenericProfileListener::result(const int time_item) {
+  std::lock_guard<std::mutex> lock(listener_mutex);
   auto iter = time_taken.find(time_item);
 
   if (iter == time_taken.end() ||
@@ -254,59 +304,227 @@ void GenericProfileListener::report(std::ostream &out) const {
   out << "Average Memory Size = " << mem_average << std::endl;
 }
 
+static std::atomic<unsigned int> chrome_trace_listener_id{0};
+
+ChromeTraceListener::ChromeTraceListener(size_t max_events_) :
+  ProfileListener(),
+  id(chrome_trace_listener_id++),
+  max_events(max_events_),
+  start_time(std::chrono::steady_clock::now()) {}
+
+ChromeTraceListener::ThreadBuffer &ChromeTraceListener::getThreadBuffer() {
+  /// buffers are shared with the threads, so a thread which outlives the
+  /// listener does not see a dangling buffer
+  thread_local std::unordered_map<unsigned int, std::shared_ptr<ThreadBuffer>>
+    thread_buffers;
+
+  auto &buffer = thread_buffers[id];
+  if (!buffer) {
+    buffer = std::make_shared<ThreadBuffer>();
+    buffer->events.reserve(std::min<size_t>(max_events, 4096));
+
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    buffer->tid = buffers.size();
+    buffers.push_back(buffer);
+  }
+
+  return *buffer;
+}
+
+void ChromeTraceListener::notify(PROFILE_EVENT event,
+                                 const std::shared_ptr<ProfileEventData> data) {
+  /* only complete events are recorded for the time items */
+  if (event == EVENT_TIME_START)
+    return;
+
+  ThreadBuffer &buffer = getThreadBuffer();
+  if (buffer.events.size() >= max_events) {
+    buffer.dropped++;
+    return;
+  }
+
+  switch (event) {
+  case EVENT_TIME_END:
+    if (buffer.names.find(data->time_item) == buffer.names.end())
+      buffer.names.emplace(data->time_item, data->event_str);
+    buffer.events.push_back(
+      {event, data->time_item, data->start_time, data->duration, 0, ""});
+    break;
+  case EVENT_MEM_ALLOC:
+  case EVENT_MEM_DEALLOC:
+    buffer.events.push_back({event, 0, data->start_time,
+                             std::chrono::microseconds(0), data->alloc_total,
+                             ""});
+    break;
+  case EVENT_MEM_ANNOTATE:
+    buffer.events.push_back({event, 0, data->start_time,
+                             std::chrono::microseconds(0), 0,
+                             data->event_str});
+    break;
+  default:
+    throw std::runtime_error("Invalid PROFILE_EVENT");
+    break;
+  }
+}
+
+void ChromeTraceListener::reset(const int time_item, const std::string &str) {
+  std::lock_guard<std::mutex> lock(buffers_mutex);
+  for (auto &buffer : buffers) {
+    auto &events = buffer->events;
+    events.erase(std::remove_if(events.begin(), events.end(),
+                                [time_item](const TraceEvent &e) {
+                                  return e.event == EVENT_TIME_END &&
+                                         e.time_item == time_item;
+                                }),
+                 events.end());
+  }
+}
+
+const std::chrono::microseconds
+ChromeTraceListener::result(const int time_item) {
+  auto &events = getThreadBuffer().events;
+  auto iter = std::find_if(events.rbegin(), events.rend(),
+                           [time_item](const TraceEvent &e) {
+                             return e.event == EVENT_TIME_END &&
+                                    e.time_item == time_item;
+                           });
+
+  if (iter == events.rend())
+    throw std::invalid_argument("time_item has never recorded");
+
+  return iter->duration;
+}
+
+void ChromeTraceListener::report(std::ostream &out) const {
+  auto timestamp = [this](const timepoint &t) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(t -
+                                                                 start_time)
+      .count();
+  };
+
+  size_t dropped = 0;
+  out << "{\"traceEvents\":[\n";
+  out << R"({"name":"process_name","ph":"M","pid":0,)"
+      << R"("args":{"name":"nntrainer"}})";
+
+  std::lock_guard<std::mutex> lock(buffers_mutex);
+  for (auto &buffer : buffers) {
+    dropped += buffer->dropped;
+    out << ",\n"
+        << R"({"name":"thread_name","ph":"M","pid":0,"tid":)" << buffer->tid
+        << R"(,"args":{"name":"thread )" << buffer->tid << "\"}}";
+
+    for (auto &e : buffer->events) {
+      out << ",\n{\"name\":";
+      switch (e.event) {
+      case EVENT_TIME_END:
+        writeJsonString(out, buffer->names.at(e.time_item));
+        out << R"(,"cat":"time","ph":"X","ts":)" << timestamp(e.start)
+            << ",\"dur\":" << e.duration.count();
+        break;
+      case EVENT_MEM_ALLOC:
+      case EVENT_MEM_DEALLOC:
+        out << R"("memory","ph":"C","ts":)" << timestamp(e.start)
+            << R"(,"args":{"total":)" << e.value << "}";
+        break;
+      default:
+        writeJsonString(out, e.str);
+        out << R"(,"cat":"annotation","ph":"i","s":"t","ts":)"
+            << timestamp(e.start);
+        break;
+      }
+      out << ",\"pid\":0,\"tid\":" << buffer->tid << "}";
+    }
+  }
+
+  out << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":"
+      << dropped << "}}\n";
+}
+
+void ChromeTraceListener::save(const std::string &path) const {
+  std::ofstream file(path, std::ios::out | std::ios::trunc);
+  if (!file.good())
+    throw std::invalid_argument("cannot open trace file: " + path);
+
+  report(file);
+}
+
 Profiler &Profiler::Global() {
   static Profiler instance;
   return instance;
 }
 
 void Profiler::start(const int item) {
+  auto &times = threadTimes(this);
 #ifdef DEBUG
-  /// @todo: consider race condition
-  if (time_item_times.find(item) != time_item_times.end())
+  if (times.find(item) != times.end())
     throw std::invalid_argument("profiler has already started");
 #endif
 
-  auto name = time_item_names.find(item);
-  if (name == time_item_names.end())
-    throw std::invalid_argument("the item is not registered");
+  auto name = getTimeItemName(item);
 
-  time_item_times[item] = std::chrono::steady_clock::now();
+  times[item] = std::chrono::steady_clock::now();
 
-  auto data = std::make_shared<ProfileEventData>(item, 0, 0, name->second,
+  auto data = std::make_shared<ProfileEventData>(item, 0, 0, name,
                                                  std::chrono::microseconds(0));
   notifyListeners(EVENT_TIME_START, data);
 }
 
 void Profiler::end(const int item) {
-  /// @todo: consider race condition
   auto end = std::chrono::steady_clock::now();
+  auto &times = threadTimes(this);
 
 #ifdef DEBUG
-  if (time_item_times.find(item) == time_item_times.end())
+  if (times.find(item) == times.end())
     throw std::invalid_argument("profiler hasn't started with the item");
 #endif
 
-  auto name = time_item_names.find(item);
-  if (name == time_item_names.end())
-    throw std::invalid_argument("the item is not registered");
+  auto name = getTimeItemName(item);
 
-  auto start = time_item_times[item];
+  auto start = times[item];
   auto duration =
     std::chrono::duration_cast<std::chrono::microseconds>(end - start);
   auto data =
-    std::make_shared<ProfileEventData>(item, 0, 0, name->second, duration);
+    std::make_shared<ProfileEventData>(item, 0, 0, name, duration);
+  data->start_time = start;
 
   notifyListeners(EVENT_TIME_END, data);
 
-  time_item_times.erase(item);
+  times.erase(item);
+}
+
+void Profiler::record(const int item,
+                      const std::chrono::microseconds &duration) {
+  auto name = getTimeItemName(item);
+
+  auto data =
+    std::make_shared<ProfileEventData>(item, 0, 0, name, duration);
+  /// the duration is measured elsewhere, assume it has just ended
+  data->start_time -= duration;
+
+  notifyListeners(EVENT_TIME_END, data);
+}
+
+std::string Profiler::getTimeItemName(const int item) {
+  std::shared_lock<std::shared_mutex> lock(listeners_mutex);
+
+  auto name = time_item_names.find(item);
+  if (name == time_item_names.end())
+    throw std::invalid_argument("the item is not registered");
+
+  return name->second;
 }
 
 void Profiler::notifyListeners(PROFILE_EVENT event,
                                const std::shared_ptr<ProfileEventData> data) {
-  std::lock_guard<std::mutex> lock(listeners_mutex);
+  std::shared_lock<std::shared_mutex> lock(listeners_mutex);
 
-  for (auto &l : time_item_listeners[data->time_item])
-    l->notify(event, data);
+  /// the map is only read under the shared lock, memory events of item 0
+  /// have no listeners of their own
+  auto item_listeners = time_item_listeners.find(data->time_item);
+  if (item_listeners != time_item_listeners.end())
+    for (auto &l : item_listeners->second)
+      l->notify(event, data);
 
   for (auto &l : listeners)
     l->notify(event, data);
@@ -318,7 +536,7 @@ void Profiler::subscribe(std::shared_ptr<ProfileListener> listener,
     throw std::invalid_argument("listener is null!");
   }
 
-  std::lock_guard<std::mutex> lock(listeners_mutex);
+  std::unique_lock<std::shared_mutex> lock(listeners_mutex);
   if (time_items.empty()) {
     listeners.insert(listener);
   } else {
@@ -328,7 +546,7 @@ void Profiler::subscribe(std::shared_ptr<ProfileListener> listener,
 }
 
 void Profiler::unsubscribe(std::shared_ptr<ProfileListener> listener) {
-  std::lock_guard<std::mutex> lock(listeners_mutex);
+  std::unique_lock<std::shared_mutex> lock(listeners_mutex);
   listeners.erase(listener);
 
   for (auto &[item, listeners] : time_item_listeners) {
@@ -339,7 +557,7 @@ void Profiler::unsubscribe(std::shared_ptr<ProfileListener> listener) {
 }
 
 int Profiler::registerTimeItem(const std::string &name) {
-  std::lock_guard<std::mutex> lock_listener(listeners_mutex);
+  std::unique_lock<std::shared_mutex> lock_listener(listeners_mutex);
   std::lock_guard<std::mutex> lock(registr_mutex);
 
   int item = time_item_names.size() + 1;
@@ -13,12 +13,14 @@
 #ifndef __PROFILER_H__
 #define __PROFILER_H__
 
+#include <atomic>
 #include <chrono>
 #include <future>
 #include <iosfwd>
 #include <list>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -109,7 +111,8 @@ public:
     alloc_total(total),
     cache_swap(false),
     event_str(str),
-    duration(dur) {}
+    duration(dur),
+    start_time(std::chrono::steady_clock::now()) {}
 
   /**
    * @brief Construct a new ProfileEventData struct
@@ -124,7 +127,8 @@ public:
     cache_policy(policy),
     cache_swap(swap),
     event_str(str),
-    duration(dur) {}
+    duration(dur),
+    start_time(std::chrono::steady_clock::now()) {}
 
   /* for time profile */
   int time_item;
@@ -141,6 +145,9 @@ public:
   /* common data */
   std::string event_str;
   std::chrono::microseconds duration;
+
+  /* time the event started, the end of the event is start_time + duration */
+  timepoint start_time;
 };
 
 class Profiler;
@@ -165,6 +172,8 @@ public:
 
   /**
    * @brief A callback function to be called from a profiler
+   * @note the profiler calls this from the thread where the event occurred,
+   * so this can be called from several threads at the same time
    *
    * @param event event type
    * @param data event data
@@ -289,6 +298,113 @@ private:
   size_t mem_count;   /**< memory count */
 
   std::unordered_map<int, std::string> names;
+
+  mutable std::mutex listener_mutex; /**< protect the records */
+};
+
+/**
+ * @brief Profile listener which records the events as a timeline in the
+ * chrome trace event format, to be opened with chrome://tracing or perfetto
+ * @details Time events become complete events on the thread they ended on,
+ * memory events become a counter of the total allocation and annotations
+ * become instant events. Each thread records to its own buffer, so recording
+ * takes no lock after the first event of the thread.
+ * @note report() and reset() must not be called while the events are being
+ * recorded
+ */
+class ChromeTraceListener : public ProfileListener {
+public:
+  static constexpr size_t DEFAULT_MAX_EVENTS = 1 << 20;
+
+  /**
+   * @brief Construct a new Chrome Trace Listener object
+   *
+   * @param max_events_ maximum number of events recorded for each thread,
+   * events after that are dropped and counted
+   */
+  explicit ChromeTraceListener(size_t max_events_ = DEFAULT_MAX_EVENTS);
+
+  /**
+   * @brief Destroy the Chrome Trace Listener object
+   *
+   */
+  virtual ~ChromeTraceListener() = default;
+
+  /**
+   * @copydoc ProfileListener::notify(PROFILE_EVENT event, const
+   * std::shared_ptr<ProfileEventData> data)
+   */
+  virtual void notify(PROFILE_EVENT event,
+                      const std::shared_ptr<ProfileEventData> data) override;
+
+  /**
+   * @brief remove the recorded events of the time item
+   *
+   * @param time_item time item to remove
+   * @param str name of the time item
+   */
+  virtual void reset(const int time_item, const std::string &str) override;
+
+  /**
+   * @brief get the latest duration of the time item on the calling thread
+   *
+   * @param time_item time item to query the result
+   * @return const std::chrono::microseconds
+   * @throw std::invalid_argument if the item is never recorded on the thread
+   */
+  virtual const std::chrono::microseconds result(const int time_item) override;
+
+  /**
+   * @brief write the trace in the chrome trace event json format
+   *
+   * @param out outstream object to write the trace
+   */
+  virtual void report(std::ostream &out) const override;
+
+  /**
+   * @brief write the trace to a file
+   *
+   * @param path path of the file, usually with .json extension
+   * @throw std::invalid_argument if the file can not be opened
+   */
+  void save(const std::string &path) const;
+
+private:
+  /**
+   * @brief a recorded event
+   */
+  struct TraceEvent {
+    PROFILE_EVENT event;                /**< event type */
+    int time_item;                      /**< time item of time events */
+    timepoint start;                    /**< start of the event */
+    std::chrono::microseconds duration; /**< duration of time events */
+    size_t value;                       /**< total allocation of mem events */
+    std::string str;                    /**< message of annotations */
+  };
+
+  /**
+   * @brief events recorded by a thread
+   */
+  struct ThreadBuffer {
+    unsigned int tid;                           /**< index of the thread */
+    std::vector<TraceEvent> events;             /**< recorded events */
+    std::unordered_map<int, std::string> names; /**< time item names */
+    size_t dropped = 0;                         /**< dropped events */
+  };
+
+  /**
+   * @brief get the buffer of the calling thread, creating it if needed
+   *
+   * @return ThreadBuffer& buffer of the calling thread
+   */
+  ThreadBuffer &getThreadBuffer();
+
+  const unsigned int id;   /**< id to find the buffers of this listener */
+  const size_t max_events; /**< maximum number of events for each thread */
+  const timepoint start_time; /**< origin of the timestamps */
+
+  mutable std::mutex buffers_mutex; /**< protect buffers */
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers; /**< thread buffers */
 };
 
 /**
@@ -343,6 +459,15 @@ public:
    */
   void end(const int time_item);
 
+  /**
+   * @brief notify a duration measured outside of the profiler, such as the
+   * execution time of a device command
+   *
+   * @param time_item time item to be recorded
+   * @param duration measured duration
+   */
+  void record(const int time_item, const std::chrono::microseconds &duration);
+
   /**
    * @brief trace memory allocation
    *
@@ -405,13 +530,20 @@ private:
   void notifyListeners(PROFILE_EVENT event,
                        const std::shared_ptr<ProfileEventData> data);
 
+  /**
+   * @brief get the name of a registered time item
+   *
+   * @param item time item
+   * @return name of the item
+   * @throws std::invalid_argument if the item is not registered
+   */
+  std::string getTimeItemName(const int item);
+
   std::unordered_set<std::shared_ptr<ProfileListener>>
     listeners; /**< event listeners */
 
   std::unordered_map<int, std::string>
     time_item_names; /**< registered item names (time_item, string) */
-  std::unordered_map<int, timepoint>
-    time_item_times; /**< registered time items (time_item, time) */
   std::unordered_map<int, std::set<std::shared_ptr<ProfileListener>>>
     time_item_listeners;
   /**< registered listeners for each itemtems (time_item, listeners) */
@@ -421,7 +553,7 @@ private:
 
   std::atomic<std::size_t> total_size; /**< total allocated memory size */
 
-  std::mutex listeners_mutex; /**< protect listeners */
+  std::shared_mutex listeners_mutex; /**< protect listeners */
   std::mutex allocates_mutex; /**< protect allocates */
   std::mutex registr_mutex;   /**< protect custom event registration */
 };
@@ -0,0 +1,243 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file ring_all_reduce.cpp
+ * @date 18 Oct 2026
+ * @brief Ring all-reduce among the worker processes of a host
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <nntrainer_error.h>
+#include <ring_all_reduce.h>
+
+namespace nntrainer {
+
+#if !defined(_WIN32)
+
+namespace {
+
+/**
+ * @brief address of a port of localhost
+ */
+sockaddr_in localAddress(unsigned int port) {
+  sockaddr_in addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(static_cast<uint16_t>(port));
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  return addr;
+}
+
+/**
+ * @brief make a connected socket non-blocking without delaying small sends
+ */
+void setupSocket(int fd) {
+  int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+} // namespace
+
+RingAllReduce::RingAllReduce(unsigned int rank_, unsigned int world_size_,
+                             unsigned int base_port, unsigned int timeout_ms_) :
+  rank(rank_),
+  world_size(world_size_),
+  timeout_ms(timeout_ms_),
+  next_fd(-1),
+  prev_fd(-1) {
+  NNTR_THROW_IF(world_size == 0 || rank >= world_size, std::invalid_argument)
+    << "rank " << rank << " is out of the world of " << world_size;
+  if (world_size == 1)
+    return;
+
+  int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+  NNTR_THROW_IF(listen_fd < 0, std::runtime_error)
+    << "RingAllReduce: socket: " << std::strerror(errno);
+
+  int one = 1;
+  setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  auto addr = localAddress(base_port + rank);
+  if (bind(listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 ||
+      listen(listen_fd, 1) < 0) {
+    int err = errno;
+    close(listen_fd);
+    NNTR_THROW_IF(true, std::runtime_error)
+      << "RingAllReduce: listen on port " << base_port + rank << ": "
+      << std::strerror(err);
+  }
+
+  /// connect to the next worker, which may not listen yet
+  auto next_addr = localAddress(base_port + (rank + 1) % world_size);
+  auto deadline =
+    std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+  while (next_fd < 0) {
+    next_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (connect(next_fd, reinterpret_cast<sockaddr *>(&next_addr),
+                sizeof(next_addr)) == 0)
+      break;
+
+    close(next_fd);
+    next_fd = -1;
+    if (std::chrono::steady_clock::now() > deadline) {
+      close(listen_fd);
+      NNTR_THROW_IF(true, std::runtime_error)
+        << "RingAllReduce: rank " << rank << " failed to connect to rank "
+        << (rank + 1) % world_size;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  pollfd pfd = {listen_fd, POLLIN, 0};
+  if (poll(&pfd, 1, timeout_ms) == 1)
+    prev_fd = accept(listen_fd, nullptr, nullptr);
+  close(listen_fd);
+  if (prev_fd < 0) {
+    close(next_fd);
+    NNTR_THROW_IF(true, std::runtime_error)
+      << "RingAllReduce: rank " << rank << " is not connected from rank "
+      << (rank + world_size - 1) % world_size;
+  }
+
+  setupSocket(next_fd);
+  setupSocket(prev_fd);
+}
+
+RingAllReduce::~RingAllReduce() {
+  if (next_fd >= 0)
+    close(next_fd);
+  if (prev_fd >= 0)
+    close(prev_fd);
+}
+
+void RingAllReduce::exchange(const void *send_buf, size_t send_bytes,
+                             void *recv_buf, size_t recv_bytes) {
+  const char *send_ptr = static_cast<const char *>(send_buf);
+  char *recv_ptr = static_cast<char *>(recv_buf);
+
+  while (send_bytes > 0 || recv_bytes > 0) {
+    pollfd pfd[2];
+    nfds_t n = 0;
+    if (send_bytes > 0)
+      pfd[n++] = {next_fd, POLLOUT, 0};
+    if (recv_bytes > 0)
+      pfd[n++] = {prev_fd, POLLIN, 0};
+
+    int ready = poll(pfd, n, timeout_ms);
+    NNTR_THROW_IF(ready <= 0, std::runtime_error)
+      << "RingAllReduce: rank " << rank << " timed out exchanging";
+
+    for (nfds_t i = 0; i < n; ++i) {
+      if (!pfd[i].revents)
+        continue;
+
+      if (pfd[i].fd == next_fd) {
+        ssize_t sent = send(next_fd, send_ptr, send_bytes, MSG_NOSIGNAL);
+        NNTR_THROW_IF(sent < 0 && errno != EAGAIN && errno != EINTR,
+                      std::runtime_error)
+          << "RingAllReduce: send: " << std::strerror(errno);
+        if (sent > 0) {
+          send_ptr += sent;
+          send_bytes -= sent;
+        }
+      } else {
+        ssize_t got = ::recv(prev_fd, recv_ptr, recv_bytes, 0);
+        NNTR_THROW_IF(got == 0, std::runtime_error)
+          << "RingAllReduce: rank " << rank << " lost the previous worker";
+        NNTR_THROW_IF(got < 0 && errno != EAGAIN && errno != EINTR,
+                      std::runtime_error)
+          << "RingAllReduce: recv: " << std::strerror(errno);
+        if (got > 0) {
+          recv_ptr += got;
+          recv_bytes -= got;
+        }
+      }
+    }
+  }
+}
+
+#else
+
+RingAllReduce::RingAllReduce(unsigned int rank_, unsigned int world_size_,
+                             unsigned int base_port, unsigned int timeout_ms_) :
+  rank(rank_),
+  world_size(world_size_),
+  timeout_ms(timeout_ms_),
+  next_fd(-1),
+  prev_fd(-1) {
+  NNTR_THROW_IF(world_size == 0 || rank >= world_size, std::invalid_argument)
+    << "rank " << rank << " is out of the world of " << world_size;
+  NNTR_THROW_IF(world_size > 1, std::runtime_error)
+    << "RingAllReduce: multiple workers are not supported on this platform";
+}
+
+RingAllReduce::~RingAllReduce() = default;
+
+void RingAllReduce::exchange(const void *send_buf, size_t send_bytes,
+                             void *recv_buf, size_t recv_bytes) {}
+
+#endif
+
+void RingAllReduce::allReduce(float *data, size_t len) {
+  if (world_size == 1)
+    return;
+
+  auto chunk_begin = [this, len](unsigned int c) {
+    return len * c / world_size;
+  };
+  auto chunk_len = [&chunk_begin](unsigned int c) {
+    return chunk_begin(c + 1) - chunk_begin(c);
+  };
+
+  /// reduce-scatter: chunk (rank + 1) % world_size ends up summed here
+  recv.resize(len / world_size + 1);
+  for (unsigned int step = 0; step + 1 < world_size; ++step) {
+    unsigned int send_c = (rank + world_size - step) % world_size;
+    unsigned int recv_c = (rank + world_size - step - 1) % world_size;
+    exchange(data + chunk_begin(send_c), chunk_len(send_c) * sizeof(float),
+             recv.data(), chunk_len(recv_c) * sizeof(float));
+
+    float *dst = data + chunk_begin(recv_c);
+    for (size_t i = 0; i < chunk_len(recv_c); ++i)
+      dst[i] += recv[i];
+  }
+
+  /// all-gather of the summed chunks
+  for (unsigned int step = 0; step + 1 < world_size; ++step) {
+    unsigned int send_c = (rank + world_size - step + 1) % world_size;
+    unsigned int recv_c = (rank + world_size - step) % world_size;
+    exchange(data + chunk_begin(send_c), chunk_len(send_c) * sizeof(float),
+             data + chunk_begin(recv_c), chunk_len(recv_c) * sizeof(float));
+  }
+}
+
+void RingAllReduce::broadcast(float *data, size_t len) {
+  if (world_size == 1)
+    return;
+
+  const size_t bytes = len * sizeof(float);
+  if (rank != 0)
+    exchange(nullptr, 0, data, bytes);
+  if (rank + 1 != world_size)
+    exchange(data, bytes, nullptr, 0);
+}
+
+} // namespace nntrainer
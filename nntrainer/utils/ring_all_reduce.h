@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file ring_all_reduce.h
+ * @date 18 Oct 2026
+ * @brief Ring all-reduce among the worker processes of a host
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ *
+ * The workers of ranks 0 to world_size - 1 form a ring over localhost TCP.
+ * A worker listens on base_port + rank, connects to the next rank and accepts
+ * the previous one. allReduce() runs a reduce-scatter and then an all-gather
+ * of world_size chunks, so every worker sends and receives 2 * (world_size -
+ * 1) / world_size of the buffer whatever the number of the workers.
+ */
+#ifndef __RING_ALL_REDUCE_H__
+#define __RING_ALL_REDUCE_H__
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <vector>
+
+namespace nntrainer {
+
+/**
+ * @class   RingAllReduce
+ * @brief   Ring of the worker processes exchanging float buffers
+ * @note    every worker must run the same calls in the same order
+ */
+class RingAllReduce {
+public:
+  /**
+   * @brief Construct a new Ring All Reduce object, which blocks until the
+   * ring is connected
+   *
+   * @param rank rank of this worker
+   * @param world_size number of the workers
+   * @param base_port port of the worker of rank 0, the others listen on the
+   * following ports
+   * @param timeout_ms time to wait for the other workers to connect or send
+   * @throw std::invalid_argument if the rank is out of the world
+   * @throw std::runtime_error if the ring fails to connect
+   */
+  RingAllReduce(unsigned int rank, unsigned int world_size,
+                unsigned int base_port, unsigned int timeout_ms = 60000);
+
+  /**
+   * @brief Destroy the Ring All Reduce object
+   */
+  ~RingAllReduce();
+
+  /**
+   * @brief Copy constructor is deleted
+   */
+  RingAllReduce(const RingAllReduce &) = delete;
+
+  /**
+   * @brief Copy assignment is deleted
+   */
+  RingAllReduce &operator=(const RingAllReduce &) = delete;
+
+  /**
+   * @brief sum the buffers of every worker in place
+   *
+   * @param data buffer of the same length on every worker
+   * @param len number of the elements
+   * @throw std::runtime_error if a worker is lost
+   */
+  void allReduce(float *data, size_t len);
+
+  /**
+   * @brief copy the buffer of rank 0 to every worker
+   *
+   * @param data buffer of the same length on every worker
+   * @param len number of the elements
+   * @throw std::runtime_error if a worker is lost
+   */
+  void broadcast(float *data, size_t len);
+
+  /**
+   * @brief get the rank of this worker
+   */
+  unsigned int getRank() const { return rank; }
+
+  /**
+   * @brief get the number of the workers
+   */
+  unsigned int getWorldSize() const { return world_size; }
+
+private:
+  /**
+   * @brief send to the next worker and receive from the previous one at once
+   */
+  void exchange(const void *send_buf, size_t send_bytes, void *recv_buf,
+                size_t recv_bytes);
+
+  unsigned int rank;       /**< rank of this worker */
+  unsigned int world_size; /**< number of the workers */
+  unsigned int timeout_ms; /**< timeout of connecting and exchanging */
+  int next_fd;             /**< socket to the next worker */
+  int prev_fd;             /**< socket from the previous worker */
+  std::vector<float> recv; /**< chunk received for the reduction */
+};
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __RING_ALL_REDUCE_H__ */
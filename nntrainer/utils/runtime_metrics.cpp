@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   runtime_metrics.cpp
+ * @date   18 Oct 2026
+ * @brief  Always-on latency histograms and byte counters of nntrainer runtime
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <runtime_metrics.h>
+
+namespace nntrainer {
+
+LatencyHistogram::LatencyHistogram() { reset(); }
+
+unsigned int LatencyHistogram::bucketOf(uint64_t ns) {
+  if (ns < SUB_BUCKETS)
+    return static_cast<unsigned int>(ns);
+
+  unsigned int msb = 63;
+  while (!(ns >> msb))
+    --msb;
+
+  unsigned int shift = msb - SUB_BUCKETS_BITS;
+  unsigned int sub = static_cast<unsigned int>(ns >> shift) & (SUB_BUCKETS - 1);
+  unsigned int bucket = (shift + 1) * SUB_BUCKETS + sub;
+  return std::min(bucket, NUM_BUCKETS - 1);
+}
+
+uint64_t LatencyHistogram::lowerBoundOf(unsigned int bucket) {
+  if (bucket < SUB_BUCKETS)
+    return bucket;
+
+  unsigned int shift = bucket / SUB_BUCKETS - 1;
+  uint64_t sub = bucket % SUB_BUCKETS;
+  return (SUB_BUCKETS + sub) << shift;
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+  buckets[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+  num.fetch_add(1, std::memory_order_relaxed);
+  sum.fetch_add(ns, std::memory_order_relaxed);
+
+  uint64_t prev = largest.load(std::memory_order_relaxed);
+  while (prev < ns &&
+         !largest.compare_exchange_weak(prev, ns, std::memory_order_relaxed))
+    ;
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+  uint64_t total_count = count();
+  if (total_count == 0)
+    return 0;
+
+  p = std::clamp(p, 0.0, 100.0);
+  uint64_t rank = std::max<uint64_t>(
+    1, static_cast<uint64_t>(std::ceil(p / 100.0 * total_count)));
+
+  uint64_t seen = 0;
+  for (unsigned int b = 0; b < NUM_BUCKETS; ++b) {
+    seen += buckets[b].load(std::memory_order_relaxed);
+    if (seen < rank)
+      continue;
+
+    /// report the middle of the bucket, which can not exceed the largest value
+    uint64_t lower = lowerBoundOf(b);
+    uint64_t upper = b + 1 < NUM_BUCKETS ? lowerBoundOf(b + 1) : lower + 1;
+    return std::min(lower + (upper - lower - 1) / 2, max());
+  }
+
+  return max();
+}
+
+void LatencyHistogram::reset() {
+  for (auto &b : buckets)
+    b.store(0, std::memory_order_relaxed);
+  num.store(0, std::memory_order_relaxed);
+  sum.store(0, std::memory_order_relaxed);
+  largest.store(0, std::memory_order_relaxed);
+}
+
+RuntimeCounters::RuntimeCounters() {
+  for (auto &c : counters)
+    c.store(0, std::memory_order_relaxed);
+}
+
+RuntimeCounters &RuntimeCounters::Global() {
+  static RuntimeCounters instance;
+  return instance;
+}
+
+void RuntimeCounters::resetCumulative() {
+  counters[SWAP_READ_BYTES].store(0, std::memory_order_relaxed);
+  counters[SWAP_WRITE_BYTES].store(0, std::memory_order_relaxed);
+}
+
+} // namespace nntrainer
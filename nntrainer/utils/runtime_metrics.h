@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   runtime_metrics.h
+ * @date   18 Oct 2026
+ * @brief  Always-on latency histograms and byte counters of nntrainer runtime
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ *
+ */
+
+#ifndef __RUNTIME_METRICS_H__
+#define __RUNTIME_METRICS_H__
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace nntrainer {
+
+/**
+ * @brief Lock free log-linear latency histogram
+ *
+ * @details every power of two is split into SUB_BUCKETS buckets, so that the
+ * estimated percentiles are off by less than 1 / SUB_BUCKETS of the value.
+ * Recording is a handful of relaxed atomic operations, which makes it cheap
+ * enough to be enabled in release builds.
+ */
+class LatencyHistogram {
+public:
+  static constexpr unsigned int SUB_BUCKETS_BITS = 2;
+  static constexpr unsigned int SUB_BUCKETS = 1u << SUB_BUCKETS_BITS;
+  /** the last bucket keeps everything of about 5 days and longer */
+  static constexpr unsigned int NUM_BUCKETS = 48 * SUB_BUCKETS;
+
+  /**
+   * @brief Construct a new empty Latency Histogram object
+   *
+   */
+  LatencyHistogram();
+
+  LatencyHistogram(const LatencyHistogram &) = delete;
+  LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+  /**
+   * @brief record a latency
+   *
+   * @param ns latency in nanoseconds
+   */
+  void record(uint64_t ns);
+
+  /**
+   * @brief record a latency
+   *
+   * @param duration latency to record
+   */
+  template <typename Rep, typename Period>
+  void record(std::chrono::duration<Rep, Period> duration) {
+    auto ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    record(static_cast<uint64_t>(ns < 0 ? 0 : ns));
+  }
+
+  /**
+   * @brief get the number of recorded latencies
+   */
+  uint64_t count() const { return num.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief get the sum of recorded latencies in nanoseconds
+   */
+  uint64_t total() const { return sum.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief get the largest recorded latency in nanoseconds
+   */
+  uint64_t max() const { return largest.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief estimate a percentile of the recorded latencies
+   *
+   * @param p percentile in [0, 100]
+   * @return uint64_t the estimated latency in nanoseconds, 0 if empty
+   */
+  uint64_t percentile(double p) const;
+
+  /**
+   * @brief clear recorded latencies
+   * @note not atomic with respect to concurrent record() calls
+   */
+  void reset();
+
+  /**
+   * @brief get the bucket index of a value
+   */
+  static unsigned int bucketOf(uint64_t ns);
+
+  /**
+   * @brief get the smallest value which falls into the bucket
+   */
+  static uint64_t lowerBoundOf(unsigned int bucket);
+
+private:
+  std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets;
+  std::atomic<uint64_t> num;
+  std::atomic<uint64_t> sum;
+  std::atomic<uint64_t> largest;
+};
+
+/**
+ * @brief Records the time from construction to destruction to a histogram
+ *
+ */
+class ScopedLatency {
+public:
+  /**
+   * @brief Construct a new Scoped Latency object and start measuring
+   *
+   * @param hist_ histogram to record to
+   */
+  explicit ScopedLatency(LatencyHistogram &hist_) :
+    hist(hist_), start(std::chrono::steady_clock::now()) {}
+
+  /**
+   * @brief Destroy the Scoped Latency object and record the elapsed time
+   *
+   */
+  ~ScopedLatency() { hist.record(std::chrono::steady_clock::now() - start); }
+
+private:
+  LatencyHistogram &hist;
+  std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * @brief Process wide byte counters of memory, cache and swap
+ *
+ */
+class RuntimeCounters {
+public:
+  /**
+   * @brief counters which are kept
+   *
+   */
+  enum Counter {
+    MEMORY_POOL_BYTES = 0, /**< bytes currently held by memory pools */
+    CACHE_POOL_BYTES,      /**< bytes of cache elements currently loaded */
+    SWAP_READ_BYTES,       /**< bytes read from swap devices */
+    SWAP_WRITE_BYTES,      /**< bytes written to swap devices */
+    NUM_COUNTERS,
+  };
+
+  /**
+   * @brief get the process wide instance
+   *
+   */
+  static RuntimeCounters &Global();
+
+  /**
+   * @brief add to a counter
+   *
+   * @param counter counter to add to
+   * @param bytes bytes to add
+   */
+  void add(Counter counter, uint64_t bytes) {
+    counters[counter].fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief subtract from a counter
+   *
+   * @param counter counter to subtract from
+   * @param bytes bytes to subtract
+   */
+  void sub(Counter counter, uint64_t bytes) {
+    counters[counter].fetch_sub(bytes, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief get the value of a counter
+   *
+   */
+  uint64_t get(Counter counter) const {
+    return counters[counter].load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief clear the cumulative swap counters
+   * @note the memory and cache counters follow live allocations, and are kept
+   */
+  void resetCumulative();
+
+private:
+  RuntimeCounters();
+
+  std::array<std::atomic<uint64_t>, NUM_COUNTERS> counters;
+};
+
+} // namespace nntrainer
+
+#endif /* __RUNTIME_METRICS_H__ */
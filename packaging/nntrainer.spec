@@ -530,7 +530,9 @@ cp -r result %{buildroot}%{_datadir}/nntrainer/unittest/
 %{_includedir}/nntrainer/base_properties.h
 %{_includedir}/nntrainer/node_exporter.h
 %{_includedir}/nntrainer/nntr_threads.h
+%{_includedir}/nntrainer/ring_all_reduce.h
 %{_includedir}/nntrainer/profiler.h
+%{_includedir}/nntrainer/runtime_metrics.h
 # tensor headers
 %{_includedir}/nntrainer/memory_data.h
 %{_includedir}/nntrainer/tensor.h
@@ -615,6 +617,13 @@ cp -r result %{buildroot}%{_datadir}/nntrainer/unittest/
 %{_includedir}/nntrainer/acti_func.h
 # model headers
 %{_includedir}/nntrainer/neuralnet.h
+%{_includedir}/nntrainer/speculative_decoder.h
+%{_includedir}/nntrainer/prefix_cache.h
+%{_includedir}/nntrainer/quantization_calibrator.h
+%{_includedir}/nntrainer/lora_adapter_registry.h
+%{_includedir}/nntrainer/inference_context_pool.h
+%{_includedir}/nntrainer/data_parallel.h
+%{_includedir}/nntrainer/async_updater.h
 ## neuralnet.h
 %{_includedir}/nntrainer/compiler_fwd.h 
 %{_includedir}/nntrainer/dynamic_training_optimization.h
@@ -342,6 +342,56 @@ TEST(nntrainer_ccapi, train_dataset_with_generator_01_p) {
   EXPECT_NEAR(model->getValidationLoss(), 2.0042247, tolerance);
 }
 
+/**
+ * @brief Neural Network Model runtime metrics
+ */
+TEST(nntrainer_ccapi, runtime_metrics_01_p) {
+  std::unique_ptr<ml::train::Model> model;
+  std::shared_ptr<ml::train::Dataset> dataset;
+
+  EXPECT_NO_THROW(model =
+                    ml::train::createModel(ml::train::ModelType::NEURAL_NET));
+  EXPECT_NO_THROW(model->addLayer(ml::train::layer::Input(
+    {"name=in", "input_shape=1:1:62720", "normalization=true"})));
+  EXPECT_NO_THROW(model->addLayer(ml::train::layer::FullyConnected(
+    {"name=fc", "unit=10", "activation=softmax", "input_layers=in"})));
+  EXPECT_NO_THROW(model->setOptimizer(ml::train::optimizer::SGD({})));
+
+  auto train_data = createTrainData();
+  EXPECT_NO_THROW(dataset = ml::train::createDataset(
+                    ml::train::DatasetType::GENERATOR, getSample, &train_data));
+  EXPECT_EQ(model->setDataset(ml::train::DatasetModeType::MODE_TRAIN, dataset),
+            ML_ERROR_NONE);
+
+  EXPECT_NO_THROW(model->setProperty({"loss=cross", "batch_size=16",
+                                      "epochs=1", "save_path=model.bin"}));
+  EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+  EXPECT_NO_THROW(model->train());
+
+  auto metrics = model->getRuntimeMetrics();
+  EXPECT_GT(metrics.memory_pool_bytes, 0u);
+
+  auto find = [&metrics](const std::string &name) {
+    for (auto &l : metrics.latencies)
+      if (l.name == name)
+        return l;
+    return ml::train::LatencyStats{name, 0, 0, 0, 0, 0};
+  };
+
+  auto iteration = find("model:iteration");
+  EXPECT_GT(iteration.count, 0u);
+  EXPECT_GT(find("model:data_wait").count, iteration.count);
+  EXPECT_EQ(find("fc:forward").count, iteration.count);
+  EXPECT_EQ(find("fc:calcGradient").count, iteration.count);
+  EXPECT_LE(iteration.p50_us, iteration.p99_us);
+  EXPECT_LE(iteration.p99_us, iteration.max_us);
+  EXPECT_LE(iteration.max_us, iteration.total_us);
+
+  model->resetRuntimeMetrics();
+  EXPECT_EQ(model->getRuntimeMetrics().latencies.size(), 0u);
+}
+
 /**
  * @brief Neural Network Model Training
  */
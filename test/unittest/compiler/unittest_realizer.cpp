@@ -16,7 +16,9 @@
 #include <activation_realizer.h>
 #include <bn_realizer.h>
 #include <connection.h>
+#include <fake_quant_realizer.h>
 #include <flatten_realizer.h>
+#include <fusion_realizer.h>
 #include <input_realizer.h>
 #include <loss_realizer.h>
 #include <multiout_realizer.h>
@@ -923,6 +925,121 @@ TEST(BnRealizer, bn_realizer_resblock_p) {
   EXPECT_NO_THROW(compileAndRealizeAndEqual(r, realizers, before, after));
 }
 
+TEST(FusionRealizer, fusion_realizer_p) {
+  std::vector<LayerRepresentation> before = {
+    {"input", {"name=input0"}},
+    {"conv2d", {"name=conv0", "kernel_size=3,3", "input_layers=input0"}},
+    {"batch_normalization",
+     {"name=bn0", "epsilon=0.01", "input_layers=conv0"}},
+    {"activation", {"name=ac0", "activation=relu", "input_layers=bn0"}},
+    {"conv2d", {"name=conv1", "kernel_size=3,3", "input_layers=ac0"}},
+    {"addition", {"name=add0", "input_layers=conv1,input0"}},
+    {"activation", {"name=ac1", "activation=tanh", "input_layers=add0"}},
+    {"fully_connected", {"name=fc0", "unit=4", "input_layers=ac1"}},
+    {"batch_normalization", {"name=bn1", "axis=3", "input_layers=fc0"}},
+  };
+  std::vector<LayerRepresentation> after = {
+    {"input", {"name=input0"}},
+    {"conv2d",
+     {"name=conv0", "kernel_size=3,3", "input_layers=input0",
+      "fused_bn_epsilon=0.01", "fused_activation=relu"}},
+    {"conv2d", {"name=conv1", "kernel_size=3,3", "input_layers=conv0"}},
+    {"addition",
+     {"name=add0", "input_layers=conv1,input0", "fused_activation=tanh"}},
+    {"fully_connected",
+     {"name=fc0", "unit=4", "input_layers=add0", "fused_bn_epsilon=0.001",
+      "fused_bn_axis=3"}},
+  };
+  FusionRealizer r;
+  EXPECT_NO_THROW(realizeAndEqual(r, before, after));
+}
+
+TEST(FusionRealizer, fusion_realizer_not_fused_p) {
+  std::vector<LayerRepresentation> before = {
+    {"input", {"name=input0"}},
+    {"fully_connected", {"name=fc0", "unit=4", "input_layers=input0"}},
+    {"activation", {"name=ac0", "activation=relu", "input_layers=fc0"}},
+    {"batch_normalization", {"name=bn0", "input_layers=ac0"}},
+    {"fully_connected", {"name=fc1", "unit=4", "input_layers=bn0"}},
+    {"activation", {"name=ac1", "activation=softmax", "input_layers=fc1"}},
+    {"fully_connected", {"name=fc2", "unit=4", "input_layers=ac1"}},
+    {"activation", {"name=ac2", "activation=relu", "input_layers=fc2"}},
+    {"fully_connected", {"name=fc3", "unit=4", "input_layers=fc2"}},
+    {"conv2d",
+     {"name=conv0", "kernel_size=3,3", "filters=1", "input_layers=fc3"}},
+    {"batch_normalization", {"name=bn1", "input_layers=conv0"}},
+    {"conv2d",
+     {"name=conv1", "kernel_size=3,3", "filters=2", "input_layers=bn1"}},
+    {"batch_normalization", {"name=bn2", "axis=3", "input_layers=conv1"}},
+  };
+  std::vector<LayerRepresentation> after = {
+    {"input", {"name=input0"}},
+    {"fully_connected",
+     {"name=fc0", "unit=4", "input_layers=input0", "fused_activation=relu"}},
+    {"batch_normalization", {"name=bn0", "input_layers=fc0"}},
+    {"fully_connected", {"name=fc1", "unit=4", "input_layers=bn0"}},
+    {"activation", {"name=ac1", "activation=softmax", "input_layers=fc1"}},
+    {"fully_connected", {"name=fc2", "unit=4", "input_layers=ac1"}},
+    {"activation", {"name=ac2", "activation=relu", "input_layers=fc2"}},
+    {"fully_connected", {"name=fc3", "unit=4", "input_layers=fc2"}},
+    {"conv2d",
+     {"name=conv0", "kernel_size=3,3", "filters=1", "input_layers=fc3"}},
+    {"batch_normalization", {"name=bn1", "input_layers=conv0"}},
+    {"conv2d",
+     {"name=conv1", "kernel_size=3,3", "filters=2", "input_layers=bn1"}},
+    {"batch_normalization", {"name=bn2", "axis=3", "input_layers=conv1"}},
+  };
+  FusionRealizer r;
+  EXPECT_NO_THROW(realizeAndEqual(r, before, after));
+}
+
+TEST(FakeQuantRealizer, fake_quant_realizer_qint8_p) {
+  std::vector<LayerRepresentation> before = {
+    {"input", {"name=input0"}},
+    {"conv2d", {"name=conv0", "kernel_size=3,3", "input_layers=input0"}},
+    {"activation", {"name=ac0", "activation=relu", "input_layers=conv0"}},
+    {"fully_connected", {"name=fc0", "unit=4", "input_layers=ac0"}},
+    {"fully_connected",
+     {"name=fc1", "unit=4", "lora_rank=2", "input_layers=fc0"}},
+  };
+  std::vector<LayerRepresentation> after = {
+    {"input", {"name=input0"}},
+    {"fake_quant", {"name=conv0/fake_quant", "input_layers=input0"}},
+    {"conv2d",
+     {"name=conv0", "kernel_size=3,3", "input_layers=conv0/fake_quant",
+      "fake_quant=QINT8"}},
+    {"activation", {"name=ac0", "activation=relu", "input_layers=conv0"}},
+    {"fake_quant", {"name=fc0/fake_quant", "input_layers=ac0"}},
+    {"fully_connected",
+     {"name=fc0", "unit=4", "input_layers=fc0/fake_quant", "fake_quant=QINT8"}},
+    {"fully_connected",
+     {"name=fc1", "unit=4", "lora_rank=2", "input_layers=fc0"}},
+  };
+  FakeQuantRealizer r(ml::train::TensorDim::DataType::QINT8);
+  EXPECT_NO_THROW(realizeAndEqual(r, before, after));
+}
+
+TEST(FakeQuantRealizer, fake_quant_realizer_qint4_p) {
+  std::vector<LayerRepresentation> before = {
+    {"input", {"name=input0"}},
+    {"conv2d", {"name=conv0", "kernel_size=3,3", "input_layers=input0"}},
+    {"fully_connected", {"name=fc0", "unit=4", "input_layers=conv0"}},
+  };
+  std::vector<LayerRepresentation> after = {
+    {"input", {"name=input0"}},
+    {"conv2d", {"name=conv0", "kernel_size=3,3", "input_layers=input0"}},
+    {"fully_connected",
+     {"name=fc0", "unit=4", "input_layers=conv0", "fake_quant=QINT4"}},
+  };
+  FakeQuantRealizer r(ml::train::TensorDim::DataType::QINT4);
+  EXPECT_NO_THROW(realizeAndEqual(r, before, after));
+}
+
+TEST(FakeQuantRealizer, fake_quant_realizer_n) {
+  EXPECT_THROW(FakeQuantRealizer(ml::train::TensorDim::DataType::FP32),
+               std::invalid_argument);
+}
+
 TEST(LossRealizer, loss_realizer_p) {
   /// realization without identifying custom input
   std::vector<LayerRepresentation> before = {
@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file unittest_layers_fake_quant.cpp
+ * @date 18 Oct 2026
+ * @brief Fake Quant Layer Test
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+#include <fake_quant_layer.h>
+#include <layers_common_tests.h>
+
+auto semantic_fake_quant = LayerSemanticsParamType(
+  nntrainer::createLayer<nntrainer::FakeQuantLayer>,
+  nntrainer::FakeQuantLayer::type, {"fake_quant=QINT8", "momentum=0.9"},
+  LayerCreateSetPropertyOptions::AVAILABLE_FROM_APP_CONTEXT, false, 1);
+
+auto semantic_fake_quant_row = LayerSemanticsParamType(
+  nntrainer::createLayer<nntrainer::FakeQuantLayer>,
+  nntrainer::FakeQuantLayer::type, {"fake_quant=QINT8", "row_range=true"},
+  LayerCreateSetPropertyOptions::AVAILABLE_FROM_APP_CONTEXT, false, 1);
+
+GTEST_PARAMETER_TEST(FakeQuant, LayerSemantics,
+                     ::testing::Values(semantic_fake_quant,
+                                       semantic_fake_quant_row));
@@ -11,8 +11,13 @@
  */
 
 #include "optimized_v1_planner.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
 #include <random>
+#include <thread>
 #include <vector>
 
 #include <gmock/gmock.h>
@@ -636,3 +641,123 @@ TEST_F(CachePoolTest, load_unload_actives_01_p) {
 
   EXPECT_NO_THROW(pool->deallocate());
 }
+
+/**
+ * @brief Cache pool holding each load until the given number of loads run at
+ * once, or a second passes
+ */
+class BlockingCachePool : public nntrainer::CachePool {
+public:
+  BlockingCachePool(const std::string &name, unsigned int wait_for) :
+    nntrainer::CachePool(name), wait_for(wait_for) {}
+
+  using nntrainer::CachePool::invalidate;
+  using nntrainer::CachePool::validate;
+
+  /**
+   * @brief hold the load, then load the element
+   */
+  bool loadElem(unsigned int id) override {
+    {
+      std::unique_lock lock(mutex);
+      max_loading = std::max(max_loading, ++loading);
+      cv.notify_all();
+      cv.wait_for(lock, std::chrono::seconds(1),
+                  [&] { return max_loading >= wait_for || released; });
+    }
+    bool loaded = nntrainer::CachePool::loadElem(id);
+
+    std::scoped_lock lock(mutex);
+    --loading;
+    return loaded;
+  }
+
+  /**
+   * @brief wait until a load is held
+   */
+  void waitLoading() {
+    std::unique_lock lock(mutex);
+    cv.wait(lock, [&] { return loading > 0; });
+  }
+
+  /**
+   * @brief let the held loads go
+   */
+  void release() {
+    std::scoped_lock lock(mutex);
+    released = true;
+    cv.notify_all();
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  unsigned int wait_for;
+  unsigned int loading = 0;
+  unsigned int max_loading = 0;
+  bool released = false;
+};
+
+/**
+ * @brief loads of different elements of a pool run at once
+ */
+TEST(CachePoolConcurrencyTest, load_overlap_01_p) {
+  BlockingCachePool pool("tmp pool", 2);
+
+  std::shared_ptr<nntrainer::MemoryData> mem1, mem2;
+  auto idx1 = pool.requestMemory(4, 1, 2);
+  auto idx2 = pool.requestMemory(4, 3, 4);
+  EXPECT_NO_THROW(pool.planLayout(nntrainer::BasicPlanner()));
+  EXPECT_NO_THROW(pool.allocate());
+  EXPECT_NO_THROW(mem1 = pool.getMemory(idx1));
+  EXPECT_NO_THROW(mem2 = pool.getMemory(idx2));
+
+  std::thread loader1([&] { mem1->validate(); });
+  std::thread loader2([&] { mem2->validate(); });
+  loader1.join();
+  loader2.join();
+
+  /** a load holding the lock of the pool would leave the other waiting */
+  EXPECT_EQ(pool.max_loading, 2u);
+  EXPECT_NE(mem1->getAddr<float>(), nullptr);
+  EXPECT_NE(mem2->getAddr<float>(), nullptr);
+
+  EXPECT_NO_THROW(pool.clear());
+}
+
+/**
+ * @brief an element invalidated while it is loaded is unloaded after the load
+ */
+TEST(CachePoolConcurrencyTest, validate_invalidate_01_p) {
+  BlockingCachePool pool("tmp pool", 2);
+
+  std::shared_ptr<nntrainer::MemoryData> mem;
+  auto idx = pool.requestMemory(4, 1, 2);
+  EXPECT_NO_THROW(pool.planLayout(nntrainer::BasicPlanner()));
+  EXPECT_NO_THROW(pool.allocate());
+  EXPECT_NO_THROW(mem = pool.getMemory(idx));
+
+  std::thread loader([&] { mem->validate(); });
+  pool.waitLoading();
+
+  std::atomic<bool> unloaded(false);
+  std::thread unloader([&] {
+    pool.invalidate(idx);
+    unloaded = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(unloaded);
+
+  pool.release();
+  loader.join();
+  unloader.join();
+  EXPECT_EQ(mem->getAddr<float>(), nullptr);
+
+  /** the element is not left in the active list */
+  mem->validate();
+  EXPECT_NE(mem->getAddr<float>(), nullptr);
+  *(mem->getAddr<float>()) = TEMP_DATA1;
+  pool.flush();
+  EXPECT_EQ(mem->getAddr<float>(), nullptr);
+
+  EXPECT_NO_THROW(pool.clear());
+}
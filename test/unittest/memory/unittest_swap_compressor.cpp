@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file unittest_swap_compressor.cpp
+ * @date 18 Oct 2026
+ * @brief Swap data compression test
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <swap_compressor.h>
+#include <swap_device.h>
+
+using nntrainer::SwapCodec;
+using nntrainer::SwapCompressor;
+
+namespace {
+
+/**
+ * @brief compress and decompress, return the compressed size
+ */
+size_t roundTrip(SwapCodec codec, const std::vector<float> &in,
+                 std::vector<float> &out) {
+  size_t size = in.size() * sizeof(float);
+  std::vector<char> buf(SwapCompressor::getBound(codec, size));
+  size_t compressed = SwapCompressor::compress(codec, in.data(), size,
+                                               buf.data());
+  out.assign(in.size(), -1.0f);
+  if (compressed == 0)
+    return 0;
+  EXPECT_TRUE(SwapCompressor::decompress(codec, buf.data(), compressed,
+                                         out.data(), size));
+  return compressed;
+}
+
+/**
+ * @brief ReLU output like data, @a zero_ratio of the values are zero
+ */
+std::vector<float> reluData(size_t len, float zero_ratio) {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+  std::vector<float> data(len);
+  for (auto &v : data)
+    v = dist(rng) < zero_ratio ? 0.0f : dist(rng) * 8.0f;
+  return data;
+}
+
+} // namespace
+
+TEST(SwapCompressor, lz_round_trip_p) {
+  std::vector<float> in(4096);
+  for (size_t i = 0; i < in.size(); ++i)
+    in[i] = static_cast<float>(i % 16);
+
+  std::vector<float> out;
+  size_t compressed = roundTrip(SwapCodec::LZ, in, out);
+  EXPECT_GT(compressed, 0u);
+  EXPECT_LT(compressed, in.size() * sizeof(float) / 4);
+  EXPECT_EQ(in, out);
+}
+
+TEST(SwapCompressor, lz_incompressible_n) {
+  std::mt19937 rng(0);
+  std::vector<uint32_t> in(1024);
+  for (auto &v : in)
+    v = rng();
+
+  size_t size = in.size() * sizeof(uint32_t);
+  std::vector<char> buf(SwapCompressor::getBound(SwapCodec::LZ, size));
+  EXPECT_EQ(
+    SwapCompressor::compress(SwapCodec::LZ, in.data(), size, buf.data()), 0u);
+}
+
+TEST(SwapCompressor, sparse_round_trip_p) {
+  auto in = reluData(1000, 0.7f);
+
+  std::vector<float> out;
+  size_t compressed = roundTrip(SwapCodec::SPARSE, in, out);
+  EXPECT_GT(compressed, 0u);
+  EXPECT_LT(compressed, in.size() * sizeof(float) / 2);
+  EXPECT_EQ(in, out);
+}
+
+TEST(SwapCompressor, sparse_dense_n) {
+  auto in = reluData(1000, 0.0f);
+
+  std::vector<float> out;
+  EXPECT_EQ(roundTrip(SwapCodec::SPARSE, in, out), 0u);
+}
+
+TEST(SwapCompressor, fp16_round_trip_p) {
+  std::vector<float> in = {0.0f,   -0.0f,  1.0f,     -2.5f,   3.14159f,
+                           1e-5f,  65504.f, 1e-8f,    1e6f,    -1e-3f,
+                           0.333f, 100.0f,  INFINITY, -INFINITY};
+
+  std::vector<float> out;
+  EXPECT_EQ(roundTrip(SwapCodec::FP16, in, out), in.size() * 2);
+  for (size_t i = 0; i < in.size(); ++i) {
+    if (std::isinf(in[i]) || std::fabs(in[i]) > 65504.f)
+      EXPECT_TRUE(std::isinf(out[i]));
+    else if (std::fabs(in[i]) < 6e-8f)
+      EXPECT_NEAR(out[i], 0.0f, 6e-8f);
+    else
+      EXPECT_NEAR(out[i], in[i], std::fabs(in[i]) * 1e-3f + 1e-7f);
+  }
+}
+
+TEST(SwapCompressor, bf16_round_trip_p) {
+  auto in = reluData(256, 0.2f);
+
+  std::vector<float> out;
+  EXPECT_EQ(roundTrip(SwapCodec::BF16, in, out), in.size() * 2);
+  for (size_t i = 0; i < in.size(); ++i)
+    EXPECT_NEAR(out[i], in[i], std::fabs(in[i]) * 8e-3f);
+}
+
+TEST(SwapCompressor, corrupted_data_n) {
+  auto in = reluData(1000, 0.7f);
+  size_t size = in.size() * sizeof(float);
+
+  for (auto codec : {SwapCodec::LZ, SwapCodec::SPARSE}) {
+    std::vector<char> buf(SwapCompressor::getBound(codec, size));
+    size_t compressed =
+      SwapCompressor::compress(codec, in.data(), size, buf.data());
+    ASSERT_GT(compressed, 0u);
+
+    std::vector<float> out(in.size());
+    EXPECT_FALSE(SwapCompressor::decompress(codec, buf.data(), compressed / 2,
+                                            out.data(), size));
+  }
+}
+
+TEST(SwapCompressor, parse_p) {
+  auto codecs =
+    SwapCompressor::parse("forward_func:sparse, Forward_Grad : FP16,max:lz");
+
+  EXPECT_EQ(codecs.size(), 3u);
+  EXPECT_EQ(codecs.at(nntrainer::TensorLifespan::FORWARD_FUNC_LIFESPAN),
+            SwapCodec::SPARSE);
+  EXPECT_EQ(codecs.at(nntrainer::TensorLifespan::FORWARD_GRAD_LIFESPAN),
+            SwapCodec::FP16);
+  EXPECT_EQ(codecs.at(nntrainer::TensorLifespan::MAX_LIFESPAN),
+            SwapCodec::LZ);
+}
+
+TEST(SwapCompressor, parse_n) {
+  EXPECT_THROW(SwapCompressor::parse("forward_func"), std::invalid_argument);
+  EXPECT_THROW(SwapCompressor::parse("forward:lz"), std::invalid_argument);
+  EXPECT_THROW(SwapCompressor::parse("max:zstd"), std::invalid_argument);
+}
+
+TEST(SwapCompressor, swap_device_round_trip_p) {
+  nntrainer::SwapDevice device("unittest_swap_compressor.swap");
+  const size_t len = 4096;
+  const size_t size = len * sizeof(float);
+  auto in = reluData(len, 0.8f);
+
+  device.start(size * 2);
+
+  void *buf = device.getBuffer(0, size, nullptr, true);
+  std::memcpy(buf, in.data(), size);
+  device.putBuffer(buf, false, SwapCodec::SPARSE);
+
+  buf = device.getBuffer(0, size, nullptr);
+  EXPECT_EQ(std::memcmp(buf, in.data(), size), 0);
+
+  /** overwrite with data the codec can not shrink */
+  auto dense = reluData(len, 0.0f);
+  std::memcpy(buf, dense.data(), size);
+  device.putBuffer(buf, false, SwapCodec::SPARSE);
+
+  buf = device.getBuffer(0, size, nullptr);
+  EXPECT_EQ(std::memcmp(buf, dense.data(), size), 0);
+  device.putBuffer(buf, true);
+
+  auto stats = device.getCompressionStats();
+  EXPECT_EQ(stats.raw_bytes, size * 2);
+  EXPECT_LT(stats.stored_bytes, size * 2);
+  EXPECT_GT(stats.getRatio(), 1.0);
+
+  device.finish();
+}
@@ -13,8 +13,12 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <random>
 
+#include <databuffer.h>
+#include <func_data_producer.h>
 #include <identity_layer.h>
+#include <layer_context.h>
 #include <models_test_utils.h>
 #include <multiout_layer.h>
 #include <nntrainer_test_util.h>
@@ -553,3 +557,122 @@ void GraphWatcher::readIteration(std::ifstream &f) {
     f.read((char *)&expected_losses[i], sizeof(float));
   }
 }
+
+std::unique_ptr<NeuralNetwork> makeTinyLM(unsigned int units) {
+  std::unique_ptr<NeuralNetwork> nn(new NeuralNetwork());
+  nn->setProperty({"batch_size=1"});
+
+  auto graph = makeGraph({
+    {"input",
+     {"name=in", "input_shape=1:1:" + std::to_string(TINY_LM_MAX_LEN)}},
+    {"embedding",
+     {"name=emb", "input_layers=in",
+      "in_dim=" + std::to_string(TINY_LM_VOCAB),
+      "out_dim=" + std::to_string(units)}},
+    {"multi_head_attention",
+     {"name=mha", "input_layers=emb,emb,emb", "num_heads=2"}},
+    {"fully_connected",
+     {"name=logits", "input_layers=mha",
+      "unit=" + std::to_string(TINY_LM_VOCAB)}},
+  });
+  for (auto &node : graph) {
+    nn->addLayer(node);
+  }
+
+  nn->compile(ml::train::ExecutionMode::INFERENCE);
+  nn->initialize(ml::train::ExecutionMode::INFERENCE);
+
+  /** weights are not initialized for inference */
+  nn->allocate(ml::train::ExecutionMode::INFERENCE);
+  setRandomWeights(*nn);
+  return nn;
+}
+
+void setRandomWeights(NeuralNetwork &nn) {
+  nn.forEachLayer([](ml::train::Layer &, RunLayerContext &rc, void *) {
+    for (unsigned int i = 0; i < rc.getNumWeights(); ++i) {
+      if (rc.getWeightName(i).find("var") != std::string::npos)
+        rc.getWeight(i).setRandUniform(0.5f, 1.5f);
+      else
+        rc.getWeight(i).setRandNormal(0.0f, 0.3f);
+    }
+  });
+}
+
+std::vector<float> makeRandomInput(unsigned int size, unsigned int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> input(size);
+  for (auto &x : input)
+    x = dist(rng);
+  return input;
+}
+
+TrainSamples makeTrainSamples(unsigned int num_samples, unsigned int input_len,
+                              unsigned int label_len) {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  TrainSamples samples;
+  samples.input_len = input_len;
+  for (unsigned int i = 0; i < num_samples; ++i) {
+    std::vector<float> sample(input_len + label_len);
+    for (auto &x : sample)
+      x = dist(rng);
+    samples.data.push_back(sample);
+  }
+  return samples;
+}
+
+int generateTrainSamples(float **input, float **label, bool *last,
+                         void *user_data) {
+  auto samples = reinterpret_cast<TrainSamples *>(user_data);
+  auto &sample = samples->data[samples->idx++];
+  std::copy(sample.begin(), sample.begin() + samples->input_len, input[0]);
+  std::copy(sample.begin() + samples->input_len, sample.end(), label[0]);
+
+  *last = samples->idx == samples->data.size();
+  if (*last)
+    samples->idx = 0;
+  return ML_ERROR_NONE;
+}
+
+void setTrainSamples(NeuralNetwork &nn, TrainSamples *samples) {
+  nn.setDataBuffer(
+    DatasetModeType::MODE_TRAIN,
+    std::make_shared<DataBuffer>(
+      std::make_unique<FuncDataProducer>(generateTrainSamples, samples)));
+}
+
+std::vector<std::vector<float>> getWeightValues(NeuralNetwork &nn) {
+  std::vector<std::vector<float>> weights;
+  nn.forEachLayer([&weights](ml::train::Layer &, RunLayerContext &rc, void *) {
+    for (unsigned int i = 0; i < rc.getNumWeights(); ++i) {
+      auto &w = rc.getWeight(i);
+      weights.emplace_back(w.getData<float>(), w.getData<float>() + w.size());
+    }
+  });
+  return weights;
+}
+
+void setWeightValues(NeuralNetwork &nn,
+                     const std::vector<std::vector<float>> &weights) {
+  unsigned int idx = 0;
+  nn.forEachLayer([&](ml::train::Layer &, RunLayerContext &rc, void *) {
+    for (unsigned int i = 0; i < rc.getNumWeights(); ++i, ++idx)
+      std::copy(weights[idx].begin(), weights[idx].end(),
+                rc.getWeight(i).getData<float>());
+  });
+}
+
+void expectSameTraining(const std::vector<std::vector<float>> &trained,
+                        const std::vector<std::vector<float>> &expected,
+                        const std::vector<std::vector<float>> &initial) {
+  ASSERT_EQ(trained.size(), expected.size());
+  ASSERT_EQ(initial.size(), expected.size());
+  for (unsigned int w = 0; w < expected.size(); ++w) {
+    EXPECT_NE(expected[w], initial[w]);
+    ASSERT_EQ(trained[w].size(), expected[w].size());
+    for (unsigned int i = 0; i < expected[w].size(); ++i)
+      EXPECT_NEAR(trained[w][i], expected[w][i], 1e-5);
+  }
+}
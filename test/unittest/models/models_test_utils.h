@@ -224,4 +224,100 @@ private:
   bool optimize;
 };
 
+/** vocabulary size of the tiny language model */
+static constexpr unsigned int TINY_LM_VOCAB = 11;
+
+/** maximum sequence length of the tiny language model */
+static constexpr unsigned int TINY_LM_MAX_LEN = 16;
+
+/**
+ * @brief tiny causal language model of token ids 1:1:TINY_LM_MAX_LEN to
+ * logits, compiled and initialized for inference with random weights
+ *
+ * @param units units of the embedding
+ * @return std::unique_ptr<nntrainer::NeuralNetwork> the model
+ */
+std::unique_ptr<nntrainer::NeuralNetwork> makeTinyLM(unsigned int units = 8);
+
+/**
+ * @brief set random weights to an initialized model, the variances of the
+ * batch normalizations are kept positive
+ *
+ * @param nn the model
+ */
+void setRandomWeights(nntrainer::NeuralNetwork &nn);
+
+/**
+ * @brief random input in [-1, 1)
+ *
+ * @param size number of the elements
+ * @param seed seed of the random engine
+ * @return std::vector<float> the input
+ */
+std::vector<float> makeRandomInput(unsigned int size, unsigned int seed);
+
+/**
+ * @brief samples of an input and a label fed to a data buffer by
+ * generateTrainSamples()
+ */
+struct TrainSamples {
+  unsigned int input_len;               /**< length of the input */
+  std::vector<std::vector<float>> data; /**< input followed by the label */
+  unsigned int idx = 0;                 /**< sample fed next */
+};
+
+/**
+ * @brief random samples in [-1, 1)
+ *
+ * @param num_samples number of the samples
+ * @param input_len length of the input
+ * @param label_len length of the label
+ * @return TrainSamples the samples
+ */
+TrainSamples makeTrainSamples(unsigned int num_samples, unsigned int input_len,
+                              unsigned int label_len);
+
+/**
+ * @brief generator of the samples of a TrainSamples, one per call
+ */
+int generateTrainSamples(float **input, float **label, bool *last,
+                         void *user_data);
+
+/**
+ * @brief feed the samples to the training of a model
+ *
+ * @param nn the model
+ * @param samples samples which outlive the training
+ */
+void setTrainSamples(nntrainer::NeuralNetwork &nn, TrainSamples *samples);
+
+/**
+ * @brief copy the weights of a model
+ *
+ * @param nn the model
+ * @return std::vector<std::vector<float>> data of every weight in order
+ */
+std::vector<std::vector<float>> getWeightValues(nntrainer::NeuralNetwork &nn);
+
+/**
+ * @brief set the weights of a model
+ *
+ * @param nn the model
+ * @param weights data of every weight in order
+ */
+void setWeightValues(nntrainer::NeuralNetwork &nn,
+                     const std::vector<std::vector<float>> &weights);
+
+/**
+ * @brief expect weights trained from the initial weights to be the weights
+ * trained by a reference model
+ *
+ * @param trained the weights trained
+ * @param expected the weights trained by the reference
+ * @param initial the weights both trained from
+ */
+void expectSameTraining(const std::vector<std::vector<float>> &trained,
+                        const std::vector<std::vector<float>> &expected,
+                        const std::vector<std::vector<float>> &initial);
+
 #endif // __MODEL_TEST_UTILS_H__
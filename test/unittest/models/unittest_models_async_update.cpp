@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file unittest_models_async_update.cpp
+ * @date 18 Oct 2026
+ * @brief unittest of the asynchronous update of the weights
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include <async_updater.h>
+#include <models_test_utils.h>
+#include <neuralnet.h>
+#include <nntrainer_test_util.h>
+#include <weight.h>
+
+using namespace nntrainer;
+
+static constexpr unsigned int BATCH = 2;
+static constexpr unsigned int IN = 4;
+static constexpr unsigned int OUT = 3;
+
+/**
+ * @brief three fully connected layers trained by adam on the mean squared
+ * error
+ */
+static std::unique_ptr<NeuralNetwork>
+makeModel(const std::vector<std::string> &props, TrainSamples *samples) {
+  std::unique_ptr<NeuralNetwork> nn(new NeuralNetwork());
+  nn->setProperty({"batch_size=" + std::to_string(BATCH), "epochs=3"});
+  nn->setProperty(props);
+
+  for (auto &node : makeGraph({
+         {"input", {"name=in", "input_shape=1:1:" + std::to_string(IN)}},
+         {"fully_connected",
+          {"name=fc1", "input_layers=in", "unit=8", "activation=tanh"}},
+         {"fully_connected",
+          {"name=fc2", "input_layers=fc1", "unit=8", "activation=tanh"}},
+         {"fully_connected",
+          {"name=fc3", "input_layers=fc2", "unit=" + std::to_string(OUT)}},
+         {"mse", {"name=loss", "input_layers=fc3"}},
+       }))
+    nn->addLayer(node);
+
+  nn->setOptimizer(
+    ml::train::createOptimizer("adam", {"learning_rate=0.01"}));
+  setTrainSamples(*nn, samples);
+
+  nn->compile(ml::train::ExecutionMode::TRAIN);
+  nn->initialize(ml::train::ExecutionMode::TRAIN);
+  return nn;
+}
+
+/**
+ * @brief train a model updating its weights asynchronously as the model
+ * updating them synchronously
+ *
+ * @param props properties of both of the models
+ */
+static void expectSameTraining(const std::vector<std::string> &props) {
+  TrainSamples reference_samples = makeTrainSamples(4 * BATCH, IN, OUT);
+  TrainSamples async_samples = reference_samples;
+
+  auto reference = makeModel(props, &reference_samples);
+  auto initial = getWeightValues(*reference);
+  reference->train();
+  auto expected = getWeightValues(*reference);
+
+  auto async_props = props;
+  async_props.push_back("async_update=2");
+  auto async = makeModel(async_props, &async_samples);
+  setWeightValues(*async, initial);
+  async->train();
+  auto trained = getWeightValues(*async);
+
+  expectSameTraining(trained, expected, initial);
+}
+
+/**
+ * @brief the weights updated by the workers are the weights updated in order
+ */
+TEST(nntrainer_models_async_update, train_01_p) { expectSameTraining({}); }
+
+/**
+ * @brief the gradients clipped at the end of the backwarding are applied by
+ * the workers
+ */
+TEST(nntrainer_models_async_update, train_02_p) {
+  expectSameTraining({"clip_grad_by_norm=0.1"});
+}
+
+/**
+ * @brief the weights are read once their updates are done
+ */
+TEST(nntrainer_models_async_update, wait_01_p) {
+  std::vector<Weight> weights;
+  for (unsigned int i = 0; i < 8; ++i) {
+    weights.emplace_back(TensorDim(1, 1, 1, 16), Initializer::ZEROS,
+                         WeightRegularizer::NONE, 1.0f, 0.0f, 0.0f, true,
+                         true);
+    weights.back().getVariableRef().setZero();
+  }
+
+  AsyncUpdater updater(2);
+  for (unsigned int i = 0; i < weights.size(); ++i)
+    updater.submit(weights[i], [i](Weight &w) {
+      w.getVariableRef().add_i(static_cast<float>(i));
+    });
+
+  for (unsigned int i = 0; i < weights.size(); ++i) {
+    updater.wait({&weights[i]});
+    const Tensor &var = weights[i].getVariableRef();
+    for (unsigned int j = 0; j < var.size(); ++j)
+      EXPECT_FLOAT_EQ(var.getData<float>()[j], static_cast<float>(i));
+  }
+}
+
+/**
+ * @brief the exception of an update is thrown when the weight is waited for
+ */
+TEST(nntrainer_models_async_update, wait_02_n) {
+  Weight w(TensorDim(1, 1, 1, 4), Initializer::ZEROS, WeightRegularizer::NONE,
+           1.0f, 0.0f, 0.0f, true, true);
+  AsyncUpdater updater(1);
+
+  updater.submit(w, [](Weight &) { throw std::runtime_error("failed"); });
+  EXPECT_THROW(updater.wait({&w}), std::runtime_error);
+  EXPECT_NO_THROW(updater.waitAll());
+}
+
+/**
+ * @brief asynchronous update needs a worker, and does not swap the gradients
+ */
+TEST(nntrainer_models_async_update, invalid_01_n) {
+  EXPECT_THROW(AsyncUpdater(0), std::invalid_argument);
+
+  TrainSamples samples = makeTrainSamples(BATCH, IN, OUT);
+  EXPECT_THROW(makeModel({"async_update=2", "memory_swap=true"}, &samples),
+               std::invalid_argument);
+}
@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file unittest_models_data_parallel.cpp
+ * @date 18 Oct 2026
+ * @brief unittest of data parallel training with the ring all-reduce
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <data_parallel.h>
+#include <models_test_utils.h>
+#include <neuralnet.h>
+#include <nntrainer_test_util.h>
+#include <ring_all_reduce.h>
+
+using namespace nntrainer;
+
+static constexpr unsigned int BATCH = 2;
+static constexpr unsigned int IN = 4;
+static constexpr unsigned int OUT = 3;
+
+/**
+ * @brief a worker process running the training of its rank
+ */
+struct WorkerProcess {
+  pid_t pid; /**< pid of the worker */
+  int fd;    /**< read end of the pipe the weights are written to */
+};
+
+/**
+ * @brief fork a worker process which writes the weights fn returns to a pipe
+ */
+static WorkerProcess
+forkWorker(const std::function<std::vector<std::vector<float>>()> &fn) {
+  int fd[2];
+  if (pipe(fd) != 0)
+    return {-1, -1};
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fd[0]);
+    std::vector<float> result;
+    try {
+      for (auto &w : fn())
+        result.insert(result.end(), w.begin(), w.end());
+    } catch (...) {
+    }
+    const char *data = reinterpret_cast<const char *>(result.data());
+    size_t left = result.size() * sizeof(float);
+    while (left > 0) {
+      ssize_t written = write(fd[1], data, left);
+      if (written <= 0)
+        break;
+      data += written;
+      left -= written;
+    }
+    close(fd[1]);
+    _exit(0);
+  }
+
+  close(fd[1]);
+  return {pid, fd[0]};
+}
+
+/**
+ * @brief wait for the worker process, and get the weights it wrote
+ */
+static std::vector<float> joinWorker(const WorkerProcess &worker) {
+  std::vector<char> bytes;
+  char buf[4096];
+  ssize_t len;
+  while ((len = read(worker.fd, buf, sizeof(buf))) > 0)
+    bytes.insert(bytes.end(), buf, buf + len);
+  close(worker.fd);
+  waitpid(worker.pid, nullptr, 0);
+
+  std::vector<float> result(bytes.size() / sizeof(float));
+  std::copy(bytes.begin(), bytes.begin() + result.size() * sizeof(float),
+            reinterpret_cast<char *>(result.data()));
+  return result;
+}
+
+/**
+ * @brief a port of this test process, so that processes running the test at
+ * once do not collide
+ */
+static unsigned int getPort(unsigned int offset) {
+  return 20000 + (getpid() % 2000) * 16 + offset;
+}
+
+/**
+ * @brief two fully connected layers trained by sgd on the mean squared error,
+ * with a batch normalization in between if batch_norm
+ */
+static std::unique_ptr<NeuralNetwork>
+makeModel(unsigned int batch, std::shared_ptr<DataParallel> data_parallel,
+          TrainSamples *samples, bool batch_norm = false) {
+  std::unique_ptr<NeuralNetwork> nn(new NeuralNetwork());
+  nn->setProperty({"batch_size=" + std::to_string(batch), "epochs=2"});
+
+  std::vector<LayerRepresentation> layers = {
+    {"input", {"name=in", "input_shape=1:1:" + std::to_string(IN)}},
+    {"fully_connected",
+     {"name=fc1", "input_layers=in", "unit=8", "activation=tanh"}},
+  };
+  std::string hidden = "fc1";
+  if (batch_norm) {
+    layers.push_back({"batch_normalization", {"name=bn", "input_layers=fc1"}});
+    hidden = "bn";
+  }
+  layers.push_back({"fully_connected",
+                    {"name=fc2", "input_layers=" + hidden,
+                     "unit=" + std::to_string(OUT)}});
+  layers.push_back({"mse", {"name=loss", "input_layers=fc2"}});
+
+  for (auto &node : makeGraph(layers))
+    nn->addLayer(node);
+
+  nn->setOptimizer(ml::train::createOptimizer("sgd", {"learning_rate=0.1"}));
+  setTrainSamples(*nn, samples);
+  if (data_parallel)
+    nn->setDataParallel(data_parallel);
+
+  nn->compile(ml::train::ExecutionMode::TRAIN);
+  nn->initialize(ml::train::ExecutionMode::TRAIN);
+  return nn;
+}
+
+/**
+ * @brief the ring sums and broadcasts buffers of a length not divided by the
+ * workers
+ */
+TEST(nntrainer_models_data_parallel, ring_01_p) {
+  constexpr unsigned int WORLD = 3;
+  constexpr size_t LEN = 10;
+  std::vector<std::vector<float>> summed(WORLD), broadcast(WORLD);
+
+  std::vector<std::thread> workers;
+  for (unsigned int rank = 0; rank < WORLD; ++rank) {
+    workers.emplace_back([&, rank]() {
+      RingAllReduce ring(rank, WORLD, getPort(0));
+      summed[rank].resize(LEN);
+      broadcast[rank].resize(LEN);
+      for (size_t i = 0; i < LEN; ++i) {
+        summed[rank][i] = rank * 100.0f + i;
+        broadcast[rank][i] = rank * 100.0f + i;
+      }
+      ring.allReduce(summed[rank].data(), LEN);
+      ring.broadcast(broadcast[rank].data(), LEN);
+    });
+  }
+  for (auto &worker : workers)
+    worker.join();
+
+  for (unsigned int rank = 0; rank < WORLD; ++rank) {
+    for (size_t i = 0; i < LEN; ++i) {
+      EXPECT_FLOAT_EQ(summed[rank][i], 300.0f + 3.0f * i);
+      EXPECT_FLOAT_EQ(broadcast[rank][i], static_cast<float>(i));
+    }
+  }
+}
+
+/**
+ * @brief two workers of a batch each train as a model of the batch of both
+ */
+TEST(nntrainer_models_data_parallel, train_01_p) {
+  constexpr unsigned int WORLD = 2;
+  constexpr unsigned int NUM_BATCHES = 4;
+
+  /// the batches of the reference are split into a batch of each worker
+  TrainSamples all = makeTrainSamples(NUM_BATCHES * WORLD * BATCH, IN, OUT);
+  std::vector<TrainSamples> shards(WORLD, TrainSamples{IN, {}});
+  for (unsigned int i = 0; i < all.data.size(); ++i)
+    shards[(i / BATCH) % WORLD].data.push_back(all.data[i]);
+
+  auto reference = makeModel(BATCH * WORLD, nullptr, &all);
+  auto initial = getWeightValues(*reference);
+  reference->train();
+  auto expected = getWeightValues(*reference);
+
+  std::vector<std::vector<std::vector<float>>> trained(WORLD);
+  std::vector<std::thread> workers;
+  for (unsigned int rank = 0; rank < WORLD; ++rank) {
+    workers.emplace_back([&, rank]() {
+      /// a small bucket splits the gradients into many buckets
+      auto data_parallel =
+        std::make_shared<DataParallel>(rank, WORLD, getPort(4), 64);
+      auto nn = makeModel(BATCH, data_parallel, &shards[rank]);
+      if (rank == 0)
+        setWeightValues(*nn, initial);
+      nn->train();
+      trained[rank] = getWeightValues(*nn);
+    });
+  }
+  for (auto &worker : workers)
+    worker.join();
+
+  EXPECT_EQ(trained[0], trained[1]);
+  expectSameTraining(trained[0], expected, initial);
+}
+
+/**
+ * @brief worker processes training a batch normalization, whose moving
+ * statistics are updated on the shard of each worker, end up with identical
+ * replicas
+ */
+TEST(nntrainer_models_data_parallel, train_02_p) {
+  constexpr unsigned int WORLD = 3;
+  constexpr unsigned int NUM_BATCHES = 4;
+
+  std::vector<TrainSamples> shards;
+  for (unsigned int rank = 0; rank < WORLD; ++rank) {
+    shards.push_back(makeTrainSamples(NUM_BATCHES * BATCH, IN, OUT));
+    for (auto &sample : shards.back().data)
+      for (auto &x : sample)
+        x += static_cast<float>(rank);
+  }
+
+  /// the port is taken before the fork, as the workers have their own pids
+  const unsigned int port = getPort(12);
+  std::vector<WorkerProcess> workers;
+  for (unsigned int rank = 0; rank < WORLD; ++rank) {
+    workers.push_back(forkWorker([&, rank]() {
+      auto data_parallel = std::make_shared<DataParallel>(rank, WORLD, port);
+      auto nn = makeModel(BATCH, data_parallel, &shards[rank], true);
+      nn->train();
+      return getWeightValues(*nn);
+    }));
+    ASSERT_GE(workers.back().pid, 0);
+  }
+
+  std::vector<std::vector<float>> trained;
+  for (auto &worker : workers)
+    trained.push_back(joinWorker(worker));
+
+  ASSERT_FALSE(trained[0].empty());
+  for (unsigned int rank = 1; rank < WORLD; ++rank)
+    EXPECT_EQ(trained[rank], trained[0]) << "at rank " << rank;
+}
+
+/**
+ * @brief data parallel training is set before the initialization, and does
+ * not clip the gradients by global norm
+ */
+TEST(nntrainer_models_data_parallel, invalid_01_n) {
+  EXPECT_THROW(RingAllReduce(2, 2, getPort(8)), std::invalid_argument);
+
+  TrainSamples samples{IN, {}};
+  auto data_parallel = std::make_shared<DataParallel>(0, 1, getPort(8));
+  auto nn = makeModel(BATCH, nullptr, &samples);
+  EXPECT_THROW(nn->setDataParallel(data_parallel), std::invalid_argument);
+
+  std::unique_ptr<NeuralNetwork> clipped(new NeuralNetwork());
+  clipped->setProperty({"batch_size=2", "clip_grad_by_norm=1.0"});
+  for (auto &node : makeGraph({
+         {"input", {"name=in", "input_shape=1:1:" + std::to_string(IN)}},
+         {"fully_connected", {"name=fc", "input_layers=in", "unit=3"}},
+         {"mse", {"name=loss", "input_layers=fc"}},
+       }))
+    clipped->addLayer(node);
+  clipped->setOptimizer(ml::train::createOptimizer("sgd", {}));
+  clipped->setDataParallel(data_parallel);
+  clipped->compile(ml::train::ExecutionMode::TRAIN);
+  EXPECT_THROW(clipped->initialize(ml::train::ExecutionMode::TRAIN),
+               std::invalid_argument);
+}
@@ -0,0 +1,422 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file unittest_models_fake_quant.cpp
+ * @date 18 Oct 2026
+ * @brief unittest of quantization aware training with fake quantization
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <layer_context.h>
+#include <models_test_utils.h>
+#include <neuralnet.h>
+#include <nntrainer_test_util.h>
+#include <quantization_calibrator.h>
+#include <tensor.h>
+
+using namespace nntrainer;
+
+static constexpr unsigned int BATCH = 2;
+static constexpr unsigned int OUT = 3;
+
+/**
+ * @brief convolutions before fully connected layers on 2:4:4 if conv, or
+ * fully connected layers on 1:1:8
+ *
+ * @param fake_quant a fake_quant layer rounding each row is put before the
+ * fully connected layers, as the FakeQuantRealizer does for QINT8
+ * @param loss the mean squared error follows
+ */
+static std::vector<LayerRepresentation>
+makeLayers(bool conv, bool fake_quant = false, bool loss = true) {
+  const std::string input_shape = conv ? "2:4:4" : "1:1:8";
+  std::vector<LayerRepresentation> layers = {
+    {"input", {"name=in", "input_shape=" + input_shape}}};
+  std::string prev = "in";
+
+  auto add = [&](const std::string &type, const std::string &name,
+                 std::vector<std::string> props) {
+    if (fake_quant && type == "fully_connected") {
+      layers.push_back({"fake_quant",
+                        {"name=" + name + "/fake_quant", "input_layers=" + prev,
+                         "fake_quant=QINT8", "row_range=true"}});
+      prev = name + "/fake_quant";
+    }
+    props.push_back("name=" + name);
+    props.push_back("input_layers=" + prev);
+    layers.push_back({type, props});
+    prev = name;
+  };
+
+  if (conv) {
+    add("conv2d", "conv0", {"filters=2", "kernel_size=3,3", "padding=same"});
+    add("conv2d", "conv1", {"filters=2", "kernel_size=3,3", "padding=same"});
+    add("flatten", "flatten", {});
+  }
+  add("fully_connected", "fc0", {"unit=8", "activation=tanh"});
+  add("fully_connected", "fc1", {"unit=" + std::to_string(OUT)});
+  if (loss)
+    layers.push_back({"mse", {"name=loss", "input_layers=" + prev}});
+  return layers;
+}
+
+/**
+ * @brief model trained by sgd on the samples
+ */
+static std::unique_ptr<NeuralNetwork>
+makeModel(const std::vector<LayerRepresentation> &layers,
+          const std::vector<std::string> &props, TrainSamples *samples,
+          float learning_rate = 0.1f) {
+  std::unique_ptr<NeuralNetwork> nn(new NeuralNetwork());
+  nn->setProperty({"batch_size=" + std::to_string(BATCH), "epochs=1"});
+  nn->setProperty(props);
+
+  for (auto &node : makeGraph(layers))
+    nn->addLayer(node);
+
+  nn->setOptimizer(ml::train::createOptimizer(
+    "sgd", {"learning_rate=" + std::to_string(learning_rate)}));
+  setTrainSamples(*nn, samples);
+
+  nn->compile(ml::train::ExecutionMode::TRAIN);
+  nn->initialize(ml::train::ExecutionMode::TRAIN);
+  return nn;
+}
+
+/**
+ * @brief model running the inference of the layers in a tensor type
+ */
+static std::unique_ptr<NeuralNetwork>
+makeInferenceModel(const std::vector<LayerRepresentation> &layers,
+                   const std::string &tensor_type) {
+  std::unique_ptr<NeuralNetwork> nn(new NeuralNetwork());
+  nn->setProperty({"batch_size=" + std::to_string(BATCH),
+                   "model_tensor_type=" + tensor_type});
+
+  for (auto &node : makeGraph(layers))
+    nn->addLayer(node);
+
+  nn->compile(ml::train::ExecutionMode::INFERENCE);
+  nn->initialize(ml::train::ExecutionMode::INFERENCE);
+  nn->allocate(ml::train::ExecutionMode::INFERENCE);
+  return nn;
+}
+
+/**
+ * @brief get a weight of a layer
+ */
+static Tensor &getWeight(NeuralNetwork &nn, const std::string &name,
+                         unsigned int idx) {
+  Tensor *weight = nullptr;
+  nn.forEachLayer([&](ml::train::Layer &l, RunLayerContext &rc, void *) {
+    if (l.getName() == name)
+      weight = &rc.getWeight(idx);
+  });
+  EXPECT_NE(weight, nullptr) << name;
+  return *weight;
+}
+
+/**
+ * @brief run the inputs of the samples through a model and gather the outputs
+ */
+static std::vector<float> infer(NeuralNetwork &nn, TrainSamples &samples) {
+  std::vector<float> outputs;
+  for (unsigned int b = 0; b + BATCH <= samples.data.size(); b += BATCH) {
+    std::vector<float> input;
+    for (unsigned int i = b; i < b + BATCH; ++i)
+      input.insert(input.end(), samples.data[i].begin(),
+                   samples.data[i].begin() + samples.input_len);
+    auto out = nn.inference(BATCH, {input.data()}, {});
+    outputs.insert(outputs.end(), out[0], out[0] + BATCH * OUT);
+  }
+  return outputs;
+}
+
+/**
+ * @brief relative error of outputs to the reference
+ */
+static float relativeError(const std::vector<float> &out,
+                           const std::vector<float> &ref) {
+  double err = 0.0, norm = 0.0;
+  for (unsigned int i = 0; i < ref.size(); ++i) {
+    err += (out[i] - ref[i]) * (out[i] - ref[i]);
+    norm += ref[i] * ref[i];
+  }
+  return std::sqrt(err / norm);
+}
+
+/**
+ * @brief round a weight to the grid LayerFakeQuant computes with, the columns
+ * of a QINT8 and the rows of a QINT4 fully connected weight with a scale each,
+ * and a convolution with a single scale
+ */
+static std::vector<float> fakeQuantize(const std::vector<float> &weight,
+                                       unsigned int cols, bool is_int8,
+                                       bool per_tensor) {
+  const float quant_min = is_int8 ? -128.0f : -8.0f;
+  const float quant_max = is_int8 ? 127.0f : 7.0f;
+  const unsigned int rows = weight.size() / cols;
+  auto scaleIdx = [&](unsigned int i, unsigned int j) {
+    return per_tensor ? 0u : is_int8 ? j : i;
+  };
+
+  std::vector<float> scales(per_tensor ? 1 : is_int8 ? cols : rows, 0.0f);
+  for (unsigned int i = 0; i < rows; ++i)
+    for (unsigned int j = 0; j < cols; ++j)
+      scales[scaleIdx(i, j)] = std::max(scales[scaleIdx(i, j)],
+                                        std::abs(weight[i * cols + j]));
+  for (auto &scale : scales)
+    scale = std::max(scale / ((quant_max - quant_min) / 2.0f),
+                     std::numeric_limits<float>::epsilon());
+
+  std::vector<float> quantized(weight.size());
+  for (unsigned int i = 0; i < rows; ++i) {
+    for (unsigned int j = 0; j < cols; ++j) {
+      const float scale = scales[scaleIdx(i, j)];
+      const float q = std::round(weight[i * cols + j] / scale);
+      quantized[i * cols + j] = std::clamp(q, quant_min, quant_max) * scale;
+    }
+  }
+  return quantized;
+}
+
+/**
+ * @brief train a step with fake quantization, which is the step of the model
+ * without it whose weights are rounded, as the derivatives are computed with
+ * the rounded weights
+ */
+static void expectFakeQuantizedStep(bool conv, const std::string &type) {
+  const bool is_int8 = type == "QINT8";
+  TrainSamples samples = makeTrainSamples(BATCH, conv ? 32 : 8, OUT);
+  TrainSamples ref_samples = samples;
+
+  /// a large step, so the derivatives of the float weights would show
+  auto nn = makeModel(makeLayers(conv), {"fake_quant=" + type}, &samples, 1.0f);
+  auto initial = getWeightValues(*nn);
+
+  auto quantized = initial;
+  unsigned int idx = 0;
+  nn->forEachLayer([&](ml::train::Layer &l, RunLayerContext &rc, void *) {
+    for (unsigned int i = 0; i < rc.getNumWeights(); ++i, ++idx) {
+      const bool is_conv = l.getType() == "conv2d";
+      if (i == 0 &&
+          (l.getType() == "fully_connected" || (is_conv && is_int8)))
+        quantized[idx] = fakeQuantize(initial[idx], rc.getWeight(i).width(),
+                                      is_int8, is_conv);
+    }
+  });
+
+  auto ref = makeModel(makeLayers(conv, is_int8), {}, &ref_samples, 1.0f);
+  setWeightValues(*ref, quantized);
+
+  nn->train();
+  ref->train();
+  auto trained = getWeightValues(*nn);
+  auto expected = getWeightValues(*ref);
+
+  ASSERT_EQ(trained.size(), expected.size());
+  for (unsigned int w = 0; w < trained.size(); ++w) {
+    ASSERT_EQ(trained[w].size(), expected[w].size());
+    for (unsigned int i = 0; i < trained[w].size(); ++i) {
+      /// the step of a float weight is the step of its rounded copy
+      float step = trained[w][i] - initial[w][i];
+      float expected_step = expected[w][i] - quantized[w][i];
+      EXPECT_NEAR(step, expected_step, 1e-5f)
+        << "weight " << w << " at " << i;
+    }
+  }
+}
+
+/**
+ * @brief train a model with fake quantization, and export it to the integer
+ * model, which computes as the trained model
+ */
+static void expectExported(bool conv, const std::string &type,
+                           ml::train::TensorDim::DataType weight_type,
+                           float max_error) {
+  const std::string file = "qat_" + type + ".bin";
+  TrainSamples samples = makeTrainSamples(4 * BATCH, conv ? 32 : 8, OUT);
+
+  auto nn = makeModel(makeLayers(conv), {"fake_quant=" + type, "epochs=3"},
+                      &samples);
+  nn->train();
+  auto qat_out = infer(*nn, samples);
+
+  /// the trained float weights without the rounding
+  std::map<std::string, std::vector<Tensor>> trained;
+  nn->forEachLayer([&](ml::train::Layer &l, RunLayerContext &rc, void *) {
+    for (unsigned int i = 0; i < rc.getNumWeights(); ++i)
+      trained[l.getName()].push_back(rc.getWeight(i).clone());
+  });
+  auto float_nn =
+    makeInferenceModel(makeLayers(conv, false, false), "FP32-FP32");
+  float_nn->forEachLayer([&](ml::train::Layer &l, RunLayerContext &rc, void *) {
+    for (unsigned int i = 0; i < rc.getNumWeights(); ++i)
+      rc.getWeight(i).copyData(trained[l.getName()][i]);
+  });
+  auto float_out = infer(*float_nn, samples);
+  EXPECT_NE(qat_out, float_out);
+
+  QuantizationCalibrator calibrator(*nn, weight_type);
+  calibrator.save(file);
+
+  auto qnn =
+    makeInferenceModel(makeLayers(conv, false, false), type + "-FP32");
+  qnn->load(file, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  std::remove(file.c_str());
+  qnn->forEachLayer([&](ml::train::Layer &l, RunLayerContext &rc, void *) {
+    if (l.getType() == "fully_connected")
+      EXPECT_EQ(rc.getWeight(0).getDataType(), weight_type);
+  });
+  auto actual = infer(*qnn, samples);
+
+  EXPECT_LT(relativeError(actual, qat_out), relativeError(actual, float_out));
+  EXPECT_LT(relativeError(actual, qat_out), max_error);
+}
+
+/**
+ * @brief the range is the moving average of the largest absolute value of
+ * the input of every iteration
+ */
+TEST(nntrainer_models_fake_quant, range_01_p) {
+  constexpr unsigned int IN = 4;
+  TrainSamples samples = makeTrainSamples(2 * BATCH, IN, OUT);
+
+  auto nn = makeModel(
+    {
+      {"input", {"name=in", "input_shape=1:1:" + std::to_string(IN)}},
+      {"fake_quant", {"name=fq", "input_layers=in", "momentum=0.75"}},
+      {"fully_connected",
+       {"name=fc", "input_layers=fq", "unit=" + std::to_string(OUT)}},
+      {"mse", {"name=loss", "input_layers=fc"}},
+    },
+    {}, &samples);
+  EXPECT_EQ(getWeight(*nn, "fq", 0).getValue(0), 0.0f);
+
+  float max_abs[2] = {0.0f, 0.0f};
+  for (unsigned int i = 0; i < samples.data.size(); ++i)
+    for (unsigned int j = 0; j < IN; ++j)
+      max_abs[i / BATCH] =
+        std::max(max_abs[i / BATCH], std::abs(samples.data[i][j]));
+
+  nn->train();
+
+  /// the first range is taken as it is
+  EXPECT_FLOAT_EQ(getWeight(*nn, "fq", 0).getValue(0),
+                  0.75f * max_abs[0] + 0.25f * max_abs[1]);
+}
+
+/**
+ * @brief the derivative is zero where the input is clipped to the range
+ */
+TEST(nntrainer_models_fake_quant, derivative_01_p) {
+  constexpr unsigned int IN = 4;
+  constexpr unsigned int UNIT = 4;
+  TrainSamples samples = makeTrainSamples(BATCH, IN, OUT);
+
+  auto nn = makeModel(
+    {
+      {"input", {"name=in", "input_shape=1:1:" + std::to_string(IN)}},
+      {"fully_connected",
+       {"name=fc0", "input_layers=in", "unit=" + std::to_string(UNIT)}},
+      {"fake_quant",
+       {"name=fq", "input_layers=fc0", "fake_quant=QINT4", "momentum=0.9"}},
+      {"fully_connected",
+       {"name=fc1", "input_layers=fq", "unit=" + std::to_string(OUT)}},
+      {"mse", {"name=loss", "input_layers=fc1"}},
+    },
+    {}, &samples);
+
+  /// the outputs 1 and 3 are far out of the range, the others are in it
+  getWeight(*nn, "fc0", 0).multiply_i(0.1f);
+  float *bias = getWeight(*nn, "fc0", 1).getData<float>();
+  std::fill(bias, bias + UNIT, 0.0f);
+  bias[1] = 10.0f;
+  bias[3] = -10.0f;
+  getWeight(*nn, "fq", 0).setValue(0.5f);
+
+  auto initial = getWeightValues(*nn);
+  nn->train();
+  auto trained = getWeightValues(*nn);
+
+  float range = getWeight(*nn, "fq", 0).getValue(0);
+  EXPECT_GT(range, 1.0f);
+  EXPECT_LT(range, 5.0f);
+
+  /// the weight and the bias of fc0 are its first weights
+  for (unsigned int j = 0; j < UNIT; ++j) {
+    bool clipped = j % 2 == 1;
+    for (unsigned int i = 0; i < IN; ++i) {
+      if (clipped)
+        EXPECT_EQ(trained[0][i * UNIT + j], initial[0][i * UNIT + j]);
+      else
+        EXPECT_NE(trained[0][i * UNIT + j], initial[0][i * UNIT + j]);
+    }
+    if (clipped)
+      EXPECT_EQ(trained[1][j], initial[1][j]);
+    else
+      EXPECT_NE(trained[1][j], initial[1][j]);
+  }
+}
+
+/**
+ * @brief the fully connected layers and the convolutions pass the derivative
+ * computed with their QINT8 weights
+ */
+TEST(nntrainer_models_fake_quant, derivative_02_p) {
+  expectFakeQuantizedStep(true, "QINT8");
+}
+
+/**
+ * @brief the fully connected layers pass the derivative computed with their
+ * QINT4 weights
+ */
+TEST(nntrainer_models_fake_quant, derivative_03_p) {
+  expectFakeQuantizedStep(false, "QINT4");
+}
+
+/**
+ * @brief a model trained with QINT8 fake quantization exports to the QINT8
+ * model, whose int8 gemm rounds the rows of the input as they are trained
+ */
+TEST(nntrainer_models_fake_quant, export_qint8_01_p) {
+  expectExported(false, "QINT8", ml::train::TensorDim::DataType::QINT8, 1e-5f);
+}
+
+/**
+ * @brief the patches of a convolution are rounded by the int8 gemm only, so
+ * their rounding is left
+ */
+TEST(nntrainer_models_fake_quant, export_qint8_02_p) {
+  expectExported(true, "QINT8", ml::train::TensorDim::DataType::QINT8, 0.02f);
+}
+
+/**
+ * @brief a model trained with QINT4 fake quantization exports to the QINT4
+ * model
+ */
+TEST(nntrainer_models_fake_quant, export_qint4_01_p) {
+  expectExported(false, "QINT4", ml::train::TensorDim::DataType::QINT4, 1e-5f);
+}
+
+/**
+ * @brief fake quantization simulates QINT8 or QINT4 only
+ */
+TEST(nntrainer_models_fake_quant, invalid_01_n) {
+  TrainSamples samples = makeTrainSamples(BATCH, 8, OUT);
+  EXPECT_THROW(makeModel(makeLayers(false), {"fake_quant=FP32"}, &samples),
+               std::invalid_argument);
+}
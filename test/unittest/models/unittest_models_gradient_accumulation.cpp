@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file unittest_models_gradient_accumulation.cpp
+ * @date 18 Oct 2026
+ * @brief unittest of the gradient accumulation over micro-batches
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include <models_test_utils.h>
+#include <neuralnet.h>
+#include <nntrainer_test_util.h>
+
+using namespace nntrainer;
+
+static constexpr unsigned int BATCH = 4;
+static constexpr unsigned int IN = 4;
+static constexpr unsigned int OUT = 3;
+
+/**
+ * @brief two fully connected layers trained by adam on the mean squared error
+ */
+static std::unique_ptr<NeuralNetwork>
+makeModel(const std::vector<std::string> &props, TrainSamples *samples) {
+  std::unique_ptr<NeuralNetwork> nn(new NeuralNetwork());
+  nn->setProperty({"batch_size=" + std::to_string(BATCH), "epochs=2"});
+  nn->setProperty(props);
+
+  for (auto &node : makeGraph({
+         {"input", {"name=in", "input_shape=1:1:" + std::to_string(IN)}},
+         {"fully_connected",
+          {"name=fc1", "input_layers=in", "unit=8", "activation=tanh"}},
+         {"fully_connected",
+          {"name=fc2", "input_layers=fc1", "unit=" + std::to_string(OUT)}},
+         {"mse", {"name=loss", "input_layers=fc2"}},
+       }))
+    nn->addLayer(node);
+
+  nn->setOptimizer(
+    ml::train::createOptimizer("adam", {"learning_rate=0.01"}));
+  setTrainSamples(*nn, samples);
+
+  nn->compile(ml::train::ExecutionMode::TRAIN);
+  nn->initialize(ml::train::ExecutionMode::TRAIN);
+  return nn;
+}
+
+/**
+ * @brief train a model with micro-batches as the model of the whole batch
+ *
+ * @param props properties of both of the models
+ */
+static void expectSameTraining(const std::vector<std::string> &props) {
+  TrainSamples reference_samples = makeTrainSamples(3 * BATCH, IN, OUT);
+  TrainSamples accumulated_samples = reference_samples;
+
+  auto reference = makeModel(props, &reference_samples);
+  auto initial = getWeightValues(*reference);
+  reference->train();
+  auto expected = getWeightValues(*reference);
+
+  auto accumulated_props = props;
+  accumulated_props.push_back("gradient_accumulation=2");
+  auto accumulated = makeModel(accumulated_props, &accumulated_samples);
+  EXPECT_EQ(accumulated->getInputDimension()[0].batch(), BATCH / 2);
+  setWeightValues(*accumulated, initial);
+  accumulated->train();
+  auto trained = getWeightValues(*accumulated);
+
+  expectSameTraining(trained, expected, initial);
+}
+
+/**
+ * @brief the gradients of two micro-batches are applied as the gradient of
+ * the whole batch
+ */
+TEST(nntrainer_models_gradient_accumulation, accumulate_01_p) {
+  expectSameTraining({});
+}
+
+/**
+ * @brief the gradients accumulated are clipped by the global norm of the
+ * whole batch
+ */
+TEST(nntrainer_models_gradient_accumulation, accumulate_02_p) {
+  expectSameTraining({"clip_grad_by_norm=0.1"});
+}
+
+/**
+ * @brief the batch size is divided by the gradient accumulation, which is
+ * fixed at the initialization
+ */
+TEST(nntrainer_models_gradient_accumulation, invalid_01_n) {
+  TrainSamples samples = makeTrainSamples(BATCH, IN, OUT);
+
+  std::unique_ptr<NeuralNetwork> nn(new NeuralNetwork());
+  nn->setProperty({"batch_size=3", "gradient_accumulation=2"});
+  for (auto &node : makeGraph({
+         {"input", {"name=in", "input_shape=1:1:" + std::to_string(IN)}},
+         {"fully_connected", {"name=fc", "input_layers=in", "unit=3"}},
+         {"mse", {"name=loss", "input_layers=fc"}},
+       }))
+    nn->addLayer(node);
+  nn->setOptimizer(ml::train::createOptimizer("sgd", {}));
+  nn->compile(ml::train::ExecutionMode::TRAIN);
+  EXPECT_THROW(nn->initialize(ml::train::ExecutionMode::TRAIN),
+               std::invalid_argument);
+
+  auto model = makeModel({"gradient_accumulation=2"}, &samples);
+  EXPECT_THROW(model->train({"gradient_accumulation=4"}),
+               std::invalid_argument);
+}
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file unittest_models_inference_context_pool.cpp
+ * @date 18 Oct 2026
+ * @brief unittest of concurrent inference on a pool of execution contexts
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <inference_context_pool.h>
+#include <models_test_utils.h>
+#include <neuralnet.h>
+#include <nntrainer_test_util.h>
+
+using namespace nntrainer;
+
+static constexpr unsigned int BATCH = 2;
+static constexpr unsigned int IN = 8;
+static constexpr unsigned int OUT = 4;
+
+/**
+ * @brief a fully connected layer with a batch normalization, which is folded
+ * into the layer once its weights are set, and another fully connected layer
+ * on 1:1:IN
+ */
+static std::unique_ptr<NeuralNetwork>
+configureModel(const std::vector<std::string> &fc_props = {}) {
+  std::unique_ptr<NeuralNetwork> nn(new NeuralNetwork());
+  nn->setProperty(
+    {"batch_size=" + std::to_string(BATCH), "fuse_layers=true"});
+
+  std::vector<std::string> fc1 = {"name=fc1", "input_layers=in", "unit=16"};
+  fc1.insert(fc1.end(), fc_props.begin(), fc_props.end());
+  for (auto &node : makeGraph({
+         {"input", {"name=in", "input_shape=1:1:" + std::to_string(IN)}},
+         {"fully_connected", fc1},
+         {"batch_normalization", {"name=bn", "input_layers=fc1"}},
+         {"fully_connected",
+          {"name=fc2", "input_layers=bn", "unit=" + std::to_string(OUT)}},
+       }))
+    nn->addLayer(node);
+  return nn;
+}
+
+/**
+ * @brief the model allocated for inference with random weights
+ */
+static std::unique_ptr<NeuralNetwork>
+makeModel(const std::vector<std::string> &fc_props = {}) {
+  auto nn = configureModel(fc_props);
+  nn->compile(ml::train::ExecutionMode::INFERENCE);
+  nn->initialize(ml::train::ExecutionMode::INFERENCE);
+  setRandomWeights(*nn);
+  nn->allocate(ml::train::ExecutionMode::INFERENCE);
+  return nn;
+}
+
+/**
+ * @brief random input of a batch
+ */
+static std::vector<float> makeInput(unsigned int seed) {
+  return makeRandomInput(BATCH * IN, seed);
+}
+
+/**
+ * @brief threads more than the contexts run the model at once
+ */
+TEST(nntrainer_models_inference_context_pool, concurrent_01_p) {
+  auto model = makeModel();
+  InferenceContextPool pool(*model, 3, [] { return configureModel(); });
+  EXPECT_EQ(pool.size(), 3u);
+
+  std::vector<std::vector<float>> inputs, expected;
+  for (unsigned int i = 0; i < 8; ++i) {
+    inputs.push_back(makeInput(i));
+    auto out = model->inference(BATCH, {inputs[i].data()}, {});
+    expected.emplace_back(out[0], out[0] + BATCH * OUT);
+  }
+
+  std::vector<std::vector<std::vector<float>>> results(inputs.size());
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < inputs.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      for (unsigned int iter = 0; iter < 10; ++iter)
+        results[i] = pool.inference(BATCH, {inputs[i].data()});
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (unsigned int i = 0; i < inputs.size(); ++i) {
+    ASSERT_EQ(results[i].size(), 1u);
+    EXPECT_EQ(results[i][0], expected[i]);
+  }
+}
+
+/**
+ * @brief a context runs a batch other than the batch of the model
+ */
+TEST(nntrainer_models_inference_context_pool, batch_01_p) {
+  auto model = makeModel();
+  InferenceContextPool pool(*model, 1, [] { return configureModel(); });
+
+  auto input = makeInput(0);
+  auto out = pool.inference(1, {input.data()});
+  ASSERT_EQ(out.size(), 1u);
+  EXPECT_EQ(out[0].size(), OUT);
+
+  auto expected = model->inference(1, {input.data()}, {});
+  EXPECT_EQ(out[0], std::vector<float>(expected[0], expected[0] + OUT));
+}
+
+/**
+ * @brief the batch normalization is folded when the weights are shared or
+ * loaded, before the model runs
+ */
+TEST(nntrainer_models_inference_context_pool, fold_01_p) {
+  const std::string file = "inference_context_pool_fold.bin";
+  auto reference = makeModel();
+  auto initial = getWeightValues(*reference);
+  reference->save(file, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+
+  auto input = makeInput(0);
+  auto out = reference->inference(BATCH, {input.data()}, {});
+  std::vector<float> expected(out[0], out[0] + BATCH * OUT);
+
+  auto model = makeModel();
+  setWeightValues(*model, initial);
+  InferenceContextPool pool(*model, 2, [] { return configureModel(); });
+  EXPECT_NE(getWeightValues(*model), initial);
+  auto shared = pool.inference(BATCH, {input.data()});
+  ASSERT_EQ(shared.size(), 1u);
+  EXPECT_EQ(shared[0], expected);
+
+  auto loaded = makeModel();
+  loaded->load(file, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  std::remove(file.c_str());
+  EXPECT_EQ(getWeightValues(*loaded), getWeightValues(*model));
+  out = loaded->inference(BATCH, {input.data()}, {});
+  EXPECT_EQ(std::vector<float>(out[0], out[0] + BATCH * OUT), expected);
+}
+
+/**
+ * @brief a pool needs a context, and a LoRA merged on the first run of the
+ * model is not shared
+ */
+TEST(nntrainer_models_inference_context_pool, invalid_01_n) {
+  auto model = makeModel();
+  EXPECT_THROW(InferenceContextPool(*model, 0, [] { return configureModel(); }),
+               std::invalid_argument);
+
+  const std::vector<std::string> lora = {"lora_rank=2", "lora_merged=true"};
+  auto merged = makeModel(lora);
+  EXPECT_THROW(
+    InferenceContextPool(*merged, 2, [&lora] { return configureModel(lora); }),
+    std::invalid_argument);
+}
@@ -0,0 +1,386 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file unittest_models_lora_adapters.cpp
+ * @date 18 Oct 2026
+ * @brief unittest of serving many LoRA adapters on a single base model
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <layer_context.h>
+#include <lora_adapter_registry.h>
+#include <neuralnet.h>
+#include <nntrainer_test_util.h>
+
+using namespace nntrainer;
+
+static constexpr unsigned int BATCH = 4;
+static constexpr unsigned int LEN = 3;
+static constexpr unsigned int IN = 8;
+static constexpr unsigned int OUT = 5;
+
+/**
+ * @brief two fully connected layers of the given properties on 1:LEN:IN, which
+ * also take the adapter input of 1:1:1 for multiple adapters, and a loss to
+ * train on in the train mode
+ */
+static std::unique_ptr<NeuralNetwork>
+makeModel(const std::vector<std::string> &lora_props,
+          bool adapter_input = false,
+          const std::string &tensor_type = "FP32-FP32",
+          ml::train::ExecutionMode mode = ml::train::ExecutionMode::INFERENCE) {
+  std::unique_ptr<NeuralNetwork> nn(new NeuralNetwork());
+  nn->setProperty({"batch_size=" + std::to_string(BATCH),
+                   "model_tensor_type=" + tensor_type});
+
+  const std::string ids = adapter_input ? ",ids" : "";
+  std::vector<std::string> fc1 = {"name=fc1", "input_layers=in" + ids,
+                                  "unit=16", "activation=relu"};
+  std::vector<std::string> fc2 = {"name=fc2", "input_layers=fc1" + ids,
+                                  "unit=" + std::to_string(OUT)};
+  fc1.insert(fc1.end(), lora_props.begin(), lora_props.end());
+  fc2.insert(fc2.end(), lora_props.begin(), lora_props.end());
+
+  std::vector<LayerRepresentation> layers = {
+    {"input",
+     {"name=in", "input_shape=1:" + std::to_string(LEN) + ":" +
+                   std::to_string(IN)}}};
+  if (adapter_input)
+    layers.push_back({"input", {"name=ids", "input_shape=1:1:1"}});
+  layers.push_back({"fully_connected", fc1});
+  layers.push_back({"fully_connected", fc2});
+  if (mode == ml::train::ExecutionMode::TRAIN) {
+    layers.push_back({"mse", {"name=loss", "input_layers=fc2"}});
+    nn->setOptimizer(ml::train::createOptimizer("sgd", {"learning_rate=0.1"}));
+  }
+
+  for (auto &node : makeGraph(layers))
+    nn->addLayer(node);
+
+  nn->compile(mode);
+  nn->initialize(mode);
+  nn->allocate(mode);
+  return nn;
+}
+
+/**
+ * @brief copy the base weights of a model, and fill the LoRA weights
+ */
+static void setWeights(NeuralNetwork &nn,
+                       std::map<std::string, std::vector<Tensor>> &base) {
+  nn.forEachLayer([&](ml::train::Layer &l, RunLayerContext &rc, void *) {
+    auto &weights = base[l.getName()];
+    for (unsigned int i = 0; i < rc.getNumWeights(); ++i) {
+      if (i < weights.size()) {
+        rc.getWeight(i).copyData(weights[i]);
+      } else {
+        rc.getWeight(i).setRandNormal(0.0f, 0.3f);
+      }
+    }
+  });
+}
+
+/**
+ * @brief run a batch of the inputs, and of the adapter input if given, which
+ * the sorted graph takes first
+ */
+static std::vector<float> infer(NeuralNetwork &nn, std::vector<float> &input,
+                                std::vector<float> adapters = {}) {
+  std::vector<float *> inputs = {input.data()};
+  if (!adapters.empty()) {
+    adapters.resize(BATCH, 0.0f);
+    inputs.insert(inputs.begin(), adapters.data());
+  }
+  auto out = nn.inference(BATCH, inputs, {});
+  return std::vector<float>(out[0], out[0] + BATCH * LEN * OUT);
+}
+
+/**
+ * @brief a batch mixes the adapters and the base model
+ */
+TEST(nntrainer_models_lora_adapters, mixed_batch_01_p) {
+  const std::string base_file = "lora_base.bin";
+  const std::vector<std::string> adapter_files = {"lora_a.bin", "lora_b.bin"};
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> input(BATCH * LEN * IN);
+  for (auto &x : input)
+    x = dist(rng);
+
+  auto base = makeModel({});
+  std::map<std::string, std::vector<Tensor>> base_weights;
+  base->forEachLayer([&](ml::train::Layer &l, RunLayerContext &rc, void *) {
+    for (unsigned int i = 0; i < rc.getNumWeights(); ++i) {
+      rc.getWeight(i).setRandNormal(0.0f, 0.3f);
+      base_weights[l.getName()].push_back(rc.getWeight(i).clone());
+    }
+  });
+  base->save(base_file, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  std::vector<std::vector<float>> expected = {infer(*base, input)};
+
+  for (unsigned int a = 0; a < adapter_files.size(); ++a) {
+    auto tuned = makeModel({"lora_rank=2", "lora_alpha=4"});
+    setWeights(*tuned, base_weights);
+    LoraAdapterRegistry::save(*tuned, adapter_files[a]);
+    expected.push_back(infer(*tuned, input));
+  }
+
+  auto nn =
+    makeModel({"lora_rank=2", "lora_alpha=4", "lora_adapters=3"}, true);
+  nn->load(base_file, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  std::remove(base_file.c_str());
+
+  LoraAdapterRegistry registry;
+  EXPECT_EQ(registry.load(*nn, "a", adapter_files[0]), 0u);
+  EXPECT_EQ(registry.load(*nn, "b", adapter_files[1]), 1u);
+  EXPECT_EQ(registry.size(), 2u);
+
+  /** items take b, the base, a and b, whose expected outputs are 2, 0, 1, 2 */
+  auto actual =
+    infer(*nn, input, registry.getAdapterInput({"b", "", "a", "b"}));
+  const unsigned int source[BATCH] = {2, 0, 1, 2};
+  const unsigned int item = LEN * OUT;
+  for (unsigned int b = 0; b < BATCH; ++b) {
+    for (unsigned int i = b * item; i < (b + 1) * item; ++i)
+      EXPECT_NEAR(actual[i], expected[source[b]][i], 1e-4f)
+        << "item " << b << " at " << i;
+  }
+
+  /** a freed slot takes the next adapter */
+  registry.unload("a");
+  EXPECT_FALSE(registry.contains("a"));
+  EXPECT_EQ(registry.load(*nn, "a2", adapter_files[1]), 0u);
+  actual = infer(*nn, input, registry.getAdapterInput({"a2"}));
+  for (unsigned int i = 0; i < item; ++i)
+    EXPECT_NEAR(actual[i], expected[2][i], 1e-4f) << "at " << i;
+  for (unsigned int i = item; i < BATCH * item; ++i)
+    EXPECT_NEAR(actual[i], expected[0][i], 1e-4f) << "at " << i;
+
+  for (auto &file : adapter_files)
+    std::remove(file.c_str());
+}
+
+/**
+ * @brief copy the bytes of the weights of a model
+ */
+static std::vector<std::vector<char>> getWeightBytes(NeuralNetwork &nn) {
+  std::vector<std::vector<char>> bytes;
+  nn.forEachLayer([&](ml::train::Layer &, RunLayerContext &rc, void *) {
+    for (unsigned int i = 0; i < rc.getNumWeights(); ++i) {
+      const char *data = rc.getWeight(i).getData<char>();
+      bytes.emplace_back(data, data + rc.getWeight(i).getMemoryBytes());
+    }
+  });
+  return bytes;
+}
+
+/**
+ * @brief merge the LoRA of a model, which gives the outputs of the LoRA apart.
+ * A model of the train mode restores the weights exactly, and one of the
+ * inference mode merges in place for good.
+ */
+static void runMerge(const std::string &tensor_type, float max_error,
+                     ml::train::ExecutionMode mode) {
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> input(BATCH * LEN * IN);
+  for (auto &x : input)
+    x = dist(rng);
+
+  auto nn =
+    makeModel({"lora_rank=2", "lora_alpha=4"}, false, tensor_type, mode);
+  nn->forEachLayer([&](ml::train::Layer &, RunLayerContext &rc, void *) {
+    for (unsigned int i = 0; i < rc.getNumWeights(); ++i) {
+      Tensor &w = rc.getWeight(i);
+      if (w.getDataType() == ml::train::TensorDim::DataType::QINT8) {
+        for (unsigned int j = 0; j < w.size(); ++j)
+          w.getData<int8_t>()[j] = static_cast<int8_t>(dist(rng) * 127.0f);
+        for (unsigned int j = 0; j < w.scale_size(); ++j)
+          w.getScale<float>()[j] = 0.003f;
+      } else {
+        w.setRandNormal(0.0f, 0.3f);
+      }
+    }
+  });
+
+  const auto base = getWeightBytes(*nn);
+  const auto expected = infer(*nn, input);
+
+  nn->setLoraMerged(true);
+  auto actual = infer(*nn, input);
+  EXPECT_NE(getWeightBytes(*nn), base);
+  for (unsigned int i = 0; i < expected.size(); ++i)
+    EXPECT_NEAR(actual[i], expected[i], max_error) << "at " << i;
+
+  const std::string weights = "lora_merged_" + tensor_type + ".bin";
+  if (mode == ml::train::ExecutionMode::INFERENCE) {
+    EXPECT_THROW(nn->save(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN),
+                 std::invalid_argument);
+    std::remove(weights.c_str());
+    nn->setLoraMerged(false);
+    EXPECT_THROW(infer(*nn, input), std::invalid_argument);
+    return;
+  }
+
+  /** a merged model saves the weights apart from the LoRA */
+  nn->save(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  EXPECT_EQ(infer(*nn, input), actual);
+  auto loaded =
+    makeModel({"lora_rank=2", "lora_alpha=4"}, false, tensor_type, mode);
+  loaded->load(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  std::remove(weights.c_str());
+  EXPECT_EQ(getWeightBytes(*loaded), base);
+
+  nn->setLoraMerged(false);
+  EXPECT_EQ(infer(*nn, input), expected);
+  EXPECT_EQ(getWeightBytes(*nn), base);
+}
+
+/**
+ * @brief LoRA merged into a float weight
+ */
+TEST(nntrainer_models_lora_adapters, merge_01_p) {
+  runMerge("FP32-FP32", 1e-4f, ml::train::ExecutionMode::TRAIN);
+  runMerge("FP32-FP32", 1e-4f, ml::train::ExecutionMode::INFERENCE);
+}
+
+/**
+ * @brief LoRA merged into a quantized weight, which is requantized
+ */
+TEST(nntrainer_models_lora_adapters, merge_02_p) {
+  runMerge("QINT8-FP32", 0.05f, ml::train::ExecutionMode::INFERENCE);
+}
+
+/**
+ * @brief training runs with the LoRA apart from the weight
+ */
+TEST(nntrainer_models_lora_adapters, merge_03_p) {
+  NeuralNetwork nn;
+  nn.setProperty({"batch_size=" + std::to_string(BATCH)});
+  auto graph = makeGraph({
+    {"input", {"name=in", "input_shape=1:" + std::to_string(LEN) + ":" +
+                            std::to_string(IN)}},
+    {"fully_connected",
+     {"name=fc", "input_layers=in", "unit=" + std::to_string(OUT),
+      "lora_rank=2", "lora_alpha=4"}},
+    {"mse", {"name=loss", "input_layers=fc"}},
+  });
+  for (auto &node : graph)
+    nn.addLayer(node);
+  nn.setOptimizer(ml::train::createOptimizer("sgd", {"learning_rate=0.1"}));
+  nn.compile();
+  nn.initialize();
+  nn.allocate();
+  nn.forEachLayer([](ml::train::Layer &, RunLayerContext &rc, void *) {
+    for (unsigned int i = 0; i < rc.getNumWeights(); ++i)
+      rc.getWeight(i).setRandNormal(0.0f, 0.3f);
+  });
+  const auto base = getWeightBytes(nn);
+
+  auto input = MAKE_SHARED_TENSOR(TensorDim(BATCH, 1, LEN, IN));
+  auto label = MAKE_SHARED_TENSOR(TensorDim(BATCH, 1, LEN, OUT));
+  input->setRandNormal();
+  label->setRandNormal();
+
+  nn.setLoraMerged(true);
+  auto merged = *nn.inference({input}, false)[0];
+  EXPECT_NE(getWeightBytes(nn), base);
+
+  auto output = *nn.forwarding({input}, {label})[0];
+  EXPECT_EQ(getWeightBytes(nn), base);
+  EXPECT_EQ(output, merged);
+}
+
+/**
+ * @brief invalid adapters are refused
+ */
+TEST(nntrainer_models_lora_adapters, invalid_01_n) {
+  const std::string adapter_file = "lora_c.bin";
+  auto nn = makeModel({"lora_rank=2", "lora_adapters=1"}, true);
+  auto base = makeModel({});
+
+  EXPECT_THROW(LoraAdapterRegistry::save(*base, adapter_file),
+               std::invalid_argument);
+
+  auto tuned = makeModel({"lora_rank=2"});
+  tuned->forEachLayer([](ml::train::Layer &, RunLayerContext &rc, void *) {
+    for (unsigned int i = 0; i < rc.getNumWeights(); ++i)
+      rc.getWeight(i).setRandNormal(0.0f, 0.3f);
+  });
+  LoraAdapterRegistry::save(*tuned, adapter_file);
+
+  LoraAdapterRegistry registry;
+  EXPECT_THROW(registry.load(*base, "c", adapter_file), std::invalid_argument);
+  EXPECT_NO_THROW(registry.load(*nn, "c", adapter_file));
+  EXPECT_THROW(registry.load(*nn, "c", adapter_file), std::invalid_argument);
+  EXPECT_THROW(registry.load(*nn, "d", adapter_file), std::invalid_argument);
+
+  auto other = makeModel({"lora_rank=3", "lora_adapters=1"}, true);
+  LoraAdapterRegistry other_registry;
+  EXPECT_THROW(other_registry.load(*other, "c", adapter_file),
+               std::invalid_argument);
+  std::remove(adapter_file.c_str());
+
+  EXPECT_THROW(registry.getAdapterInput({"c", "d"}), std::invalid_argument);
+  EXPECT_EQ(registry.getAdapterInput({"", "c"}),
+            (std::vector<float>{0.0f, 1.0f}));
+
+  /** the slot of the adapter input is out of the range */
+  std::vector<float> input(BATCH * LEN * IN, 0.0f);
+  EXPECT_THROW(infer(*nn, input, {2.0f}), std::invalid_argument);
+  EXPECT_THROW(registry.unload("d"), std::invalid_argument);
+}
+
+/**
+ * @brief lora_adapters needs a rank, the adapter input and inference
+ */
+TEST(nntrainer_models_lora_adapters, invalid_02_n) {
+  auto initialize = [](const std::string &input_layers,
+                       const std::string &lora_rank,
+                       ml::train::ExecutionMode mode) {
+    NeuralNetwork nn;
+    auto graph = makeGraph({
+      {"input", {"name=in", "input_shape=1:1:8"}},
+      {"input", {"name=ids", "input_shape=1:1:1"}},
+      {"fully_connected",
+       {"name=fc", "input_layers=" + input_layers, "unit=4", lora_rank,
+        "lora_adapters=2"}},
+      {"mse", {"name=loss", "input_layers=fc"}},
+    });
+    for (auto &node : graph)
+      nn.addLayer(node);
+    nn.compile(mode);
+    nn.initialize(mode);
+  };
+
+  EXPECT_NO_THROW(initialize("in,ids", "lora_rank=2",
+                             ml::train::ExecutionMode::INFERENCE));
+  EXPECT_THROW(
+    initialize("in,ids", "unit=4", ml::train::ExecutionMode::INFERENCE),
+    std::invalid_argument);
+  EXPECT_THROW(
+    initialize("in", "lora_rank=2", ml::train::ExecutionMode::INFERENCE),
+    std::invalid_argument);
+  EXPECT_THROW(initialize("in,in", "lora_rank=2",
+                          ml::train::ExecutionMode::INFERENCE),
+               std::invalid_argument);
+  EXPECT_THROW(
+    initialize("in,ids", "lora_rank=2", ml::train::ExecutionMode::TRAIN),
+    std::invalid_argument);
+  EXPECT_THROW(
+    makeModel({"lora_rank=2", "lora_adapters=1", "lora_merged=true"}, true),
+    std::invalid_argument);
+}
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file unittest_models_prefix_cache.cpp
+ * @date 18 Oct 2026
+ * @brief unittest of the key / value prefix cache
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <models_test_utils.h>
+#include <neuralnet.h>
+#include <nntrainer_test_util.h>
+#include <prefix_cache.h>
+
+using namespace nntrainer;
+
+static constexpr unsigned int VOCAB = TINY_LM_VOCAB;
+static constexpr unsigned int MAX_LEN = TINY_LM_MAX_LEN;
+
+/**
+ * @brief prefill tokens from a position and return the logits of the last one
+ */
+static std::vector<float> prefill(NeuralNetwork &nn,
+                                  const std::vector<unsigned int> &tokens,
+                                  unsigned int from) {
+  std::vector<float> input(MAX_LEN, 0.0f);
+  std::copy(tokens.begin() + from, tokens.end(), input.begin());
+
+  auto out = nn.incremental_inference(1, {input.data()}, {}, MAX_LEN, from,
+                                      tokens.size(), true);
+  const float *last = out[0] + (tokens.size() - from - 1) * VOCAB;
+  return std::vector<float>(last, last + VOCAB);
+}
+
+/**
+ * @brief prefill from the restored position gives the logits of a full prefill
+ */
+TEST(nntrainer_models_prefix_cache, restore_01_p) {
+  auto nn = makeTinyLM();
+  PrefixCache cache(4, 16);
+
+  std::vector<unsigned int> system = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  prefill(*nn, system, 0);
+  cache.store(*nn, system);
+  EXPECT_EQ(cache.size(), 2u);
+
+  std::vector<unsigned int> prompt = {1, 2, 3, 4, 5, 6, 7, 8, 10, 3, 7};
+  auto expected = prefill(*nn, prompt, 0);
+
+  prefill(*nn, {9, 9, 9, 9, 9, 9, 9, 9, 9}, 0);
+  unsigned int from = cache.restore(*nn, prompt);
+  EXPECT_EQ(from, 8u);
+  auto actual = prefill(*nn, prompt, from);
+
+  for (unsigned int i = 0; i < VOCAB; ++i)
+    EXPECT_NEAR(actual[i], expected[i], 1e-5) << "at " << i;
+  EXPECT_EQ(cache.getNumHitTokens(), 8u);
+  EXPECT_EQ(cache.getNumLookupTokens(), prompt.size());
+}
+
+/**
+ * @brief a single step past the restored prefix returns the logits of its last
+ * position, as the application reads them
+ */
+TEST(nntrainer_models_prefix_cache, restore_03_p) {
+  auto nn = makeTinyLM();
+  PrefixCache cache(4, 16);
+
+  std::vector<unsigned int> prompt = {1, 2, 3, 4, 5, 6, 7};
+  auto expected = prefill(*nn, prompt, 0);
+  cache.store(*nn, prompt);
+
+  prefill(*nn, {9, 9, 9, 9, 9, 9, 9}, 0);
+  unsigned int from = cache.restore(*nn, prompt);
+  ASSERT_EQ(from, 4u);
+
+  std::vector<float> input(MAX_LEN, 0.0f);
+  std::copy(prompt.begin() + from, prompt.end(), input.begin());
+  auto out = nn->incremental_inference(1, {input.data()}, {}, MAX_LEN, from,
+                                       prompt.size());
+  std::vector<float> actual(out[0], out[0] + VOCAB);
+  delete[] out[0];
+
+  for (unsigned int i = 0; i < VOCAB; ++i)
+    EXPECT_NEAR(actual[i], expected[i], 1e-5) << "at " << i;
+}
+
+/**
+ * @brief the last token of a prompt and diverging blocks are not restored
+ */
+TEST(nntrainer_models_prefix_cache, restore_02_p) {
+  auto nn = makeTinyLM();
+  PrefixCache cache(4, 16);
+
+  std::vector<unsigned int> prompt = {1, 2, 3, 4, 5, 6, 7, 8};
+  prefill(*nn, prompt, 0);
+  cache.store(*nn, prompt);
+
+  EXPECT_EQ(cache.restore(*nn, prompt), 4u);
+  EXPECT_EQ(cache.restore(*nn, {1, 2, 3, 4}), 0u);
+  EXPECT_EQ(cache.restore(*nn, {1, 2, 3, 5, 5, 6, 7, 8, 9}), 0u);
+  EXPECT_EQ(cache.restore(*nn, {1, 2, 3, 4, 5, 6, 7, 9, 9}), 4u);
+}
+
+/**
+ * @brief least recently used blocks are evicted first
+ */
+TEST(nntrainer_models_prefix_cache, evict_01_p) {
+  auto nn = makeTinyLM();
+  PrefixCache cache(4, 2);
+
+  std::vector<unsigned int> first = {1, 1, 1, 1, 2};
+  std::vector<unsigned int> second = {2, 2, 2, 2, 3};
+  std::vector<unsigned int> third = {3, 3, 3, 3, 4};
+  for (auto &prompt : {first, second}) {
+    prefill(*nn, prompt, 0);
+    cache.store(*nn, prompt);
+  }
+
+  EXPECT_EQ(cache.restore(*nn, first), 4u);
+  prefill(*nn, third, 0);
+  cache.store(*nn, third);
+
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_EQ(cache.restore(*nn, second), 0u);
+  EXPECT_EQ(cache.restore(*nn, first), 4u);
+  EXPECT_EQ(cache.restore(*nn, third), 4u);
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(cache.restore(*nn, first), 0u);
+}
+
+/**
+ * @brief invalid settings are refused
+ */
+TEST(nntrainer_models_prefix_cache, invalid_01_n) {
+  EXPECT_THROW(PrefixCache(0, 4), std::invalid_argument);
+  EXPECT_THROW(PrefixCache(4, 0), std::invalid_argument);
+}
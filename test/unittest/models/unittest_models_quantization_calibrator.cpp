@@ -0,0 +1,375 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file unittest_models_quantization_calibrator.cpp
+ * @date 18 Oct 2026
+ * @brief unittest of the post training quantization calibrator
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <databuffer.h>
+#include <func_data_producer.h>
+#include <layer_context.h>
+#include <neuralnet.h>
+#include <nntrainer_test_util.h>
+#include <quantization_calibrator.h>
+#include <tensor.h>
+
+using namespace nntrainer;
+
+static constexpr unsigned int BATCH = 2;
+static constexpr unsigned int NUM_SAMPLES = 8;
+
+/**
+ * @brief samples fed by the data buffer
+ */
+struct Samples {
+  std::vector<std::vector<float>> data;
+  unsigned int idx = 0;
+};
+
+/**
+ * @brief generator of the samples, one per call
+ */
+static int generate(float **input, float **label, bool *last, void *user_data) {
+  auto samples = reinterpret_cast<Samples *>(user_data);
+  auto &sample = samples->data[samples->idx++];
+  std::copy(sample.begin(), sample.end(), input[0]);
+
+  *last = samples->idx == samples->data.size();
+  if (*last)
+    samples->idx = 0;
+  return ML_ERROR_NONE;
+}
+
+/**
+ * @brief make random samples of a length
+ */
+static Samples makeSamples(unsigned int len, unsigned int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+  Samples samples;
+  samples.data.resize(NUM_SAMPLES, std::vector<float>(len));
+  for (auto &sample : samples.data)
+    for (auto &x : sample)
+      x = dist(rng);
+  return samples;
+}
+
+/**
+ * @brief model of fully connected layers, or of a convolution before them
+ */
+static std::unique_ptr<NeuralNetwork>
+makeModel(bool conv, const std::string &tensor_type = "FP32-FP32",
+          const std::vector<std::string> &model_props = {}) {
+  std::unique_ptr<NeuralNetwork> nn(new NeuralNetwork());
+  nn->setProperty({"batch_size=" + std::to_string(BATCH),
+                   "model_tensor_type=" + tensor_type});
+  nn->setProperty(model_props);
+
+  const std::string input_shape = conv ? "2:4:4" : "1:1:8";
+  const std::string fc_input = conv ? "conv" : "in";
+  std::vector<LayerRepresentation> layers = {
+    {"input", {"name=in", "input_shape=" + input_shape}}};
+  if (conv)
+    layers.push_back({"conv2d",
+                      {"name=conv", "input_layers=in", "filters=3",
+                       "kernel_size=3,3", "padding=same", "activation=relu"}});
+  layers.push_back({"fully_connected",
+                    {"name=fc1", "input_layers=" + fc_input, "unit=16",
+                     "activation=relu"}});
+  layers.push_back(
+    {"fully_connected", {"name=fc2", "input_layers=fc1", "unit=4"}});
+
+  for (auto &node : makeGraph(layers))
+    nn->addLayer(node);
+
+  nn->compile(ml::train::ExecutionMode::INFERENCE);
+  nn->initialize(ml::train::ExecutionMode::INFERENCE);
+  nn->allocate(ml::train::ExecutionMode::INFERENCE);
+
+  /** weights are not initialized for inference */
+  if (tensor_type == "FP32-FP32") {
+    nn->forEachLayer([](ml::train::Layer &, RunLayerContext &rc, void *) {
+      for (unsigned int i = 0; i < rc.getNumWeights(); ++i)
+        rc.getWeight(i).setRandNormal(0.0f, 0.5f);
+    });
+  }
+  return nn;
+}
+
+/**
+ * @brief run the samples through a model and gather the outputs
+ */
+static std::vector<float> infer(NeuralNetwork &nn, Samples &samples) {
+  size_t len = 0;
+  nn.forEachLayer([&len](ml::train::Layer &l, RunLayerContext &rc, void *) {
+    if (l.getName() == "fc2")
+      len = rc.getOutput(0).size();
+  });
+  std::vector<float> outputs;
+  for (unsigned int b = 0; b < NUM_SAMPLES; b += BATCH) {
+    std::vector<float> input;
+    for (unsigned int i = b; i < b + BATCH; ++i)
+      input.insert(input.end(), samples.data[i].begin(),
+                   samples.data[i].end());
+    auto out = nn.inference(BATCH, {input.data()}, {});
+    outputs.insert(outputs.end(), out[0], out[0] + len);
+  }
+  return outputs;
+}
+
+/**
+ * @brief relative error of outputs to the reference
+ */
+static float relativeError(const std::vector<float> &out,
+                           const std::vector<float> &ref) {
+  double err = 0.0, norm = 0.0;
+  for (unsigned int i = 0; i < ref.size(); ++i) {
+    err += (out[i] - ref[i]) * (out[i] - ref[i]);
+    norm += ref[i] * ref[i];
+  }
+  return std::sqrt(err / norm);
+}
+
+/**
+ * @brief calibrate, save and load a quantized model, which stays close to the
+ * float one
+ */
+static void runQuantizedModel(bool conv, const std::string &tensor_type,
+                              ml::train::TensorDim::DataType weight_type,
+                              float max_error) {
+  const std::string weights = "ptq_" + tensor_type + ".bin";
+  auto samples = makeSamples(conv ? 32 : 8, 7);
+  DataBuffer buffer(std::make_unique<FuncDataProducer>(generate, &samples));
+
+  auto nn = makeModel(conv);
+  QuantizationCalibrator calibrator(*nn, weight_type);
+  calibrator.calibrate(buffer);
+  calibrator.save(weights);
+  auto expected = infer(*nn, samples);
+
+  auto qnn = makeModel(conv, tensor_type);
+  qnn->load(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  std::remove(weights.c_str());
+
+  qnn->forEachLayer([&](ml::train::Layer &l, RunLayerContext &rc, void *) {
+    if (l.getType() == "fully_connected") {
+      EXPECT_EQ(rc.getWeight(0).getDataType(), weight_type);
+      EXPECT_EQ(rc.getWeight(0).q_scheme(), QScheme::PER_CHANNEL_AFFINE);
+    } else if (l.getType() == "conv2d") {
+      EXPECT_EQ(rc.getWeight(0).q_scheme(), QScheme::PER_TENSOR_AFFINE);
+    }
+  });
+
+  auto actual = infer(*qnn, samples);
+  float error = relativeError(actual, expected);
+  EXPECT_LT(error, max_error);
+  EXPECT_GT(error, 0.0f);
+}
+
+/**
+ * @brief percentile and mse clip the outliers the min max range keeps
+ */
+TEST(nntrainer_models_quantization_calibrator, range_observer_01_p) {
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  Tensor values(1, 1, 1, 10000);
+  for (unsigned int i = 0; i < values.size(); ++i)
+    values.getData<float>()[i] = dist(rng);
+
+  Tensor outlier(1, 1, 1, 1);
+  outlier.setValue(100.0f);
+
+  RangeObserver observer;
+  observer.observe(values);
+  observer.observe(outlier);
+  EXPECT_EQ(observer.getCount(), 10001u);
+
+  auto min_max = observer.getRange(CalibrationMethod::MIN_MAX);
+  EXPECT_NEAR(min_max.first, -1.0f, 1e-3);
+  EXPECT_FLOAT_EQ(min_max.second, 100.0f);
+
+  auto percentile = observer.getRange(CalibrationMethod::PERCENTILE, 99.9f);
+  EXPECT_NEAR(percentile.first, -1.0f, 0.1f);
+  EXPECT_NEAR(percentile.second, 1.0f, 0.1f);
+
+  /** a single outlier costs more clipped than its rounding error */
+  auto mse = observer.getRange(CalibrationMethod::MSE);
+  EXPECT_LT(mse.second, 100.0f);
+  EXPECT_GT(mse.second, 90.0f);
+  EXPECT_FLOAT_EQ(mse.first, min_max.first);
+
+  Tensor outliers(1, 1, 1, 10);
+  outliers.setValue(100.0f);
+  observer.observe(outliers);
+  /** but many are worth keeping, up to the width of a bin */
+  EXPECT_NEAR(observer.getRange(CalibrationMethod::MSE).second, 100.0f, 1.0f);
+}
+
+/**
+ * @brief the inputs of the fully connected layers are observed
+ */
+TEST(nntrainer_models_quantization_calibrator, calibrate_01_p) {
+  auto samples = makeSamples(8, 1);
+  DataBuffer buffer(std::make_unique<FuncDataProducer>(generate, &samples));
+
+  auto nn = makeModel(false);
+  QuantizationCalibrator calibrator(*nn);
+  EXPECT_EQ(calibrator.getQuantizedLayers(),
+            (std::vector<std::string>{"fc1", "fc2"}));
+
+  calibrator.calibrate(buffer);
+
+  float lo = 0.0f, hi = 0.0f;
+  for (auto &sample : samples.data) {
+    lo = std::min(lo, *std::min_element(sample.begin(), sample.end()));
+    hi = std::max(hi, *std::max_element(sample.begin(), sample.end()));
+  }
+  auto range = calibrator.getActivationRange("fc1");
+  EXPECT_FLOAT_EQ(range.first, lo);
+  EXPECT_FLOAT_EQ(range.second, hi);
+
+  /** fc2 follows a relu */
+  EXPECT_GE(calibrator.getActivationRange("fc2").first, 0.0f);
+}
+
+/**
+ * @brief the report gives a small delta for every quantized layer
+ */
+TEST(nntrainer_models_quantization_calibrator, evaluate_01_p) {
+  auto samples = makeSamples(32, 2);
+  DataBuffer buffer(std::make_unique<FuncDataProducer>(generate, &samples));
+
+  auto nn = makeModel(true);
+  QuantizationCalibrator calibrator(*nn, ml::train::TensorDim::DataType::QINT8,
+                                    CalibrationMethod::MSE);
+  calibrator.calibrate(buffer);
+  auto expected = infer(*nn, samples);
+
+  auto deltas = calibrator.evaluate(buffer);
+  ASSERT_EQ(deltas.size(), 3u);
+  EXPECT_EQ(deltas[0].layer, "conv");
+  for (auto &delta : deltas) {
+    EXPECT_GT(delta.relative_error, 0.0f) << delta.layer;
+    EXPECT_LT(delta.relative_error, 0.05f) << delta.layer;
+    EXPECT_GT(delta.max_abs_error, 0.0f) << delta.layer;
+  }
+
+  /** the float weights are restored */
+  auto actual = infer(*nn, samples);
+  EXPECT_EQ(actual, expected);
+}
+
+/**
+ * @brief the report of the last layer is the error of the saved model, which
+ * quantizes its activations on the fly
+ */
+static void expectEvaluated(bool conv, const std::string &tensor_type,
+                            ml::train::TensorDim::DataType weight_type) {
+  const std::string weights = "ptq_evaluate_" + tensor_type + ".bin";
+  auto samples = makeSamples(conv ? 32 : 8, 5);
+  DataBuffer buffer(std::make_unique<FuncDataProducer>(generate, &samples));
+
+  auto nn = makeModel(conv);
+  QuantizationCalibrator calibrator(*nn, weight_type);
+  auto deltas = calibrator.evaluate(buffer);
+  calibrator.save(weights);
+  auto expected = infer(*nn, samples);
+
+  auto qnn = makeModel(conv, tensor_type);
+  qnn->load(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  std::remove(weights.c_str());
+  auto actual = infer(*qnn, samples);
+
+  float max_error = 0.0f;
+  for (unsigned int i = 0; i < expected.size(); ++i)
+    max_error = std::max(max_error, std::abs(actual[i] - expected[i]));
+  float error = relativeError(actual, expected);
+
+  ASSERT_EQ(deltas.back().layer, "fc2");
+  EXPECT_GT(error, 0.0f);
+  EXPECT_NEAR(deltas.back().relative_error, error, 0.01f * error);
+  EXPECT_NEAR(deltas.back().max_abs_error, max_error, 0.01f * max_error);
+}
+
+/**
+ * @brief the rows of the input of a QINT8 fully connected layer are quantized
+ */
+TEST(nntrainer_models_quantization_calibrator, evaluate_02_p) {
+  expectEvaluated(false, "QINT8-FP32", ml::train::TensorDim::DataType::QINT8);
+}
+
+/**
+ * @brief the patches of a convolution are quantized by its int8 gemm
+ */
+TEST(nntrainer_models_quantization_calibrator, evaluate_03_p) {
+  expectEvaluated(true, "QINT8-FP32", ml::train::TensorDim::DataType::QINT8);
+}
+
+/**
+ * @brief a QINT4 fully connected layer runs on the float input
+ */
+TEST(nntrainer_models_quantization_calibrator, evaluate_04_p) {
+  expectEvaluated(false, "QINT4-FP32", ml::train::TensorDim::DataType::QINT4);
+}
+
+/**
+ * @brief a QINT8 model reads the weights quantized per channel
+ */
+TEST(nntrainer_models_quantization_calibrator, save_qint8_01_p) {
+  runQuantizedModel(false, "QINT8-FP32", ml::train::TensorDim::DataType::QINT8,
+                    0.02f);
+}
+
+/**
+ * @brief a convolution is quantized per tensor with the int8 gemm
+ */
+TEST(nntrainer_models_quantization_calibrator, save_qint8_02_p) {
+  runQuantizedModel(true, "QINT8-FP32", ml::train::TensorDim::DataType::QINT8,
+                    0.03f);
+}
+
+/**
+ * @brief a QINT4 model reads the weights quantized per channel
+ */
+TEST(nntrainer_models_quantization_calibrator, save_qint4_01_p) {
+  runQuantizedModel(false, "QINT4-FP32", ml::train::TensorDim::DataType::QINT4,
+                    0.3f);
+}
+
+/**
+ * @brief invalid settings are refused
+ */
+TEST(nntrainer_models_quantization_calibrator, invalid_01_n) {
+  auto nn = makeModel(false);
+  EXPECT_THROW(
+    QuantizationCalibrator(*nn, ml::train::TensorDim::DataType::UINT8),
+    std::invalid_argument);
+  EXPECT_THROW(QuantizationCalibrator(*nn,
+                                      ml::train::TensorDim::DataType::QINT8,
+                                      CalibrationMethod::PERCENTILE, 0.0f),
+               std::invalid_argument);
+
+  QuantizationCalibrator calibrator(*nn);
+  EXPECT_THROW(calibrator.getActivationRange("in"), std::invalid_argument);
+  EXPECT_THROW(calibrator.getActivationRange("fc1"), std::invalid_argument);
+
+  /** a single sample fills no batch */
+  auto samples = makeSamples(8, 1);
+  samples.data.resize(1);
+  DataBuffer buffer(std::make_unique<FuncDataProducer>(generate, &samples));
+  EXPECT_THROW(calibrator.evaluate(buffer), std::invalid_argument);
+}
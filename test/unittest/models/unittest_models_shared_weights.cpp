@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file unittest_models_shared_weights.cpp
+ * @date 18 Oct 2026
+ * @brief unittest of inference sessions sharing the weights of a model
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <layer_context.h>
+#include <models_test_utils.h>
+#include <neuralnet.h>
+#include <nntrainer_test_util.h>
+
+using namespace nntrainer;
+
+static constexpr unsigned int BATCH = 2;
+static constexpr unsigned int IN = 8;
+static constexpr unsigned int OUT = 4;
+
+/**
+ * @brief two fully connected layers on 1:1:IN, initialized but not allocated
+ */
+static std::unique_ptr<NeuralNetwork>
+makeModel(unsigned int hidden = 16,
+          ml::train::ExecutionMode mode = ml::train::ExecutionMode::INFERENCE) {
+  std::unique_ptr<NeuralNetwork> nn(new NeuralNetwork());
+  nn->setProperty({"batch_size=" + std::to_string(BATCH), "loss=mse"});
+
+  for (auto &node : makeGraph({
+         {"input", {"name=in", "input_shape=1:1:" + std::to_string(IN)}},
+         {"fully_connected",
+          {"name=fc1", "input_layers=in", "unit=" + std::to_string(hidden),
+           "activation=relu"}},
+         {"fully_connected",
+          {"name=fc2", "input_layers=fc1", "unit=" + std::to_string(OUT)}},
+       }))
+    nn->addLayer(node);
+
+  if (mode == ml::train::ExecutionMode::TRAIN)
+    nn->setOptimizer(ml::train::createOptimizer("sgd", {"learning_rate=0.1"}));
+
+  nn->compile(mode);
+  nn->initialize(mode);
+  return nn;
+}
+
+/**
+ * @brief the owner of random weights, allocated for inference
+ */
+static std::unique_ptr<NeuralNetwork> makeOwner() {
+  auto nn = makeModel();
+  setRandomWeights(*nn);
+  nn->allocate(ml::train::ExecutionMode::INFERENCE);
+  return nn;
+}
+
+/**
+ * @brief a session sharing the weights of the owner
+ */
+static std::unique_ptr<NeuralNetwork> makeSession(NeuralNetwork &owner) {
+  auto nn = makeModel();
+  nn->shareWeights(owner);
+  nn->allocate(ml::train::ExecutionMode::INFERENCE);
+  return nn;
+}
+
+/**
+ * @brief get the data of every weight of a model
+ */
+static std::vector<const void *> getWeightData(NeuralNetwork &nn) {
+  std::vector<const void *> data;
+  nn.forEachLayer([&data](ml::train::Layer &, RunLayerContext &rc, void *) {
+    for (unsigned int i = 0; i < rc.getNumWeights(); ++i)
+      data.push_back(rc.getWeight(i).getData());
+  });
+  return data;
+}
+
+/**
+ * @brief run a batch of the input
+ */
+static std::vector<float> infer(NeuralNetwork &nn, std::vector<float> input) {
+  auto out = nn.inference(BATCH, {input.data()}, {});
+  return std::vector<float>(out[0], out[0] + BATCH * OUT);
+}
+
+/**
+ * @brief random input of a batch
+ */
+static std::vector<float> makeInput(unsigned int seed) {
+  return makeRandomInput(BATCH * IN, seed);
+}
+
+/**
+ * @brief sessions run on the memory of the owner, which they keep alive
+ */
+TEST(nntrainer_models_shared_weights, share_01_p) {
+  auto owner = makeOwner();
+  auto input = makeInput(0);
+  auto expected = infer(*owner, input);
+
+  auto session1 = makeSession(*owner);
+  auto session2 = makeSession(*owner);
+  EXPECT_EQ(getWeightData(*session1), getWeightData(*owner));
+  EXPECT_EQ(getWeightData(*session2), getWeightData(*owner));
+  EXPECT_EQ(infer(*session1, input), expected);
+  EXPECT_EQ(infer(*session2, input), expected);
+
+  owner.reset();
+  EXPECT_EQ(infer(*session1, input), expected);
+  session1->deallocate();
+  EXPECT_EQ(infer(*session2, input), expected);
+}
+
+/**
+ * @brief sessions run concurrently on the shared weights
+ */
+TEST(nntrainer_models_shared_weights, concurrent_01_p) {
+  auto owner = makeOwner();
+  std::vector<std::unique_ptr<NeuralNetwork>> sessions;
+  std::vector<std::vector<float>> inputs, expected, results(4);
+  for (unsigned int i = 0; i < results.size(); ++i) {
+    sessions.push_back(makeSession(*owner));
+    inputs.push_back(makeInput(i));
+    expected.push_back(infer(*owner, inputs[i]));
+  }
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < sessions.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      for (unsigned int iter = 0; iter < 10; ++iter)
+        results[i] = infer(*sessions[i], inputs[i]);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (unsigned int i = 0; i < sessions.size(); ++i)
+    EXPECT_EQ(results[i], expected[i]);
+}
+
+/**
+ * @brief weights are shared between models of the same layers for inference
+ */
+TEST(nntrainer_models_shared_weights, invalid_01_n) {
+  auto owner = makeOwner();
+
+  auto other = makeModel(12);
+  EXPECT_THROW(other->shareWeights(*owner), std::invalid_argument);
+
+  auto train = makeModel(16, ml::train::ExecutionMode::TRAIN);
+  EXPECT_THROW(train->shareWeights(*owner), std::invalid_argument);
+
+  EXPECT_THROW(owner->shareWeights(*owner), std::invalid_argument);
+}
+
+/**
+ * @brief the weights of a session are read only
+ */
+TEST(nntrainer_models_shared_weights, read_only_01_n) {
+  auto owner = makeOwner();
+  auto session = makeSession(*owner);
+
+  EXPECT_THROW(session->load("shared_weights.bin"), std::invalid_argument);
+  EXPECT_THROW(session->setLoraMerged(true), std::invalid_argument);
+}
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file unittest_models_speculative.cpp
+ * @date 18 Oct 2026
+ * @brief unittest of multi step incremental inference and speculative decoding
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug No known bugs except for NYI items
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <models_test_utils.h>
+#include <neuralnet.h>
+#include <nntrainer_test_util.h>
+#include <speculative_decoder.h>
+
+using namespace nntrainer;
+
+static constexpr unsigned int VOCAB = TINY_LM_VOCAB;
+static constexpr unsigned int MAX_LEN = TINY_LM_MAX_LEN;
+
+/**
+ * @brief run an incremental step and copy the logits of its positions
+ */
+static std::vector<float> runSteps(NeuralNetwork &nn,
+                                   const std::vector<unsigned int> &tokens,
+                                   unsigned int from) {
+  std::vector<float> input(MAX_LEN, 0.0f);
+  std::copy(tokens.begin(), tokens.end(), input.begin());
+
+  unsigned int to = from + tokens.size();
+  auto out =
+    nn.incremental_inference(1, {input.data()}, {}, MAX_LEN, from, to, true);
+  return std::vector<float>(out[0], out[0] + tokens.size() * VOCAB);
+}
+
+/**
+ * @brief greedy decoding of the model one token at a time
+ */
+static std::vector<unsigned int>
+greedyDecode(NeuralNetwork &nn, const std::vector<unsigned int> &prompt,
+             unsigned int max_tokens) {
+  auto argmax = [](const float *logits) {
+    return static_cast<unsigned int>(std::max_element(logits, logits + VOCAB) -
+                                     logits);
+  };
+
+  auto logits = runSteps(nn, prompt, 0);
+  unsigned int pos = prompt.size();
+  std::vector<unsigned int> generated = {
+    argmax(logits.data() + (pos - 1) * VOCAB)};
+  while (generated.size() < max_tokens && pos + 1 < MAX_LEN) {
+    logits = runSteps(nn, {generated.back()}, pos++);
+    generated.push_back(argmax(logits.data()));
+  }
+  return generated;
+}
+
+/**
+ * @brief steps of several positions give the logits of prefilling them all
+ */
+TEST(nntrainer_models_speculative, multi_step_01_p) {
+  auto nn = makeTinyLM(8);
+  std::vector<unsigned int> tokens = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3};
+
+  auto expected = runSteps(*nn, tokens, 0);
+
+  std::vector<float> actual = runSteps(*nn, {3, 1, 4}, 0);
+  for (auto [from, to] : std::vector<std::pair<unsigned int, unsigned int>>{
+         {3, 4}, {4, 7}, {7, 8}, {8, 10}}) {
+    std::vector<unsigned int> step_tokens(tokens.begin() + from,
+                                          tokens.begin() + to);
+    auto step = runSteps(*nn, step_tokens, from);
+    actual.insert(actual.end(), step.begin(), step.end());
+  }
+
+  ASSERT_EQ(actual.size(), expected.size());
+  for (unsigned int i = 0; i < expected.size(); ++i)
+    EXPECT_NEAR(actual[i], expected[i], 1e-4) << "at " << i;
+}
+
+/**
+ * @brief steps overwrite what a rejected step has cached
+ */
+TEST(nntrainer_models_speculative, rollback_01_p) {
+  auto nn = makeTinyLM(8);
+
+  runSteps(*nn, {3, 1, 4}, 0);
+  auto expected = runSteps(*nn, {1, 5}, 3);
+
+  runSteps(*nn, {3, 1, 4}, 0);
+  runSteps(*nn, {7, 7, 7}, 3);
+  auto actual = runSteps(*nn, {1, 5}, 3);
+
+  for (unsigned int i = 0; i < expected.size(); ++i)
+    EXPECT_NEAR(actual[i], expected[i], 1e-5) << "at " << i;
+}
+
+/**
+ * @brief greedy speculative decoding reproduces greedy decoding of the target
+ */
+TEST(nntrainer_models_speculative, greedy_01_p) {
+  auto target = makeTinyLM(8);
+  auto draft = makeTinyLM(4);
+  std::vector<unsigned int> prompt = {2, 7, 1};
+
+  auto expected = greedyDecode(*target, prompt, 10);
+
+  SpeculativeDecoder decoder(*target, *draft, VOCAB, 3);
+  auto generated = decoder.generate(prompt, 10);
+
+  EXPECT_EQ(generated, expected);
+  EXPECT_LE(decoder.getNumAccepted(), decoder.getNumDrafted());
+}
+
+/**
+ * @brief every proposal of a draft identical to the target is accepted
+ */
+TEST(nntrainer_models_speculative, greedy_same_draft_01_p) {
+  const std::string weights = "speculative_target.bin";
+  auto target = makeTinyLM(8);
+  auto draft = makeTinyLM(8);
+  target->save(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  draft->load(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  std::remove(weights.c_str());
+
+  std::vector<unsigned int> prompt = {4, 4};
+  auto expected = greedyDecode(*target, prompt, 12);
+
+  SpeculativeDecoder decoder(*target, *draft, VOCAB, 4);
+  auto generated = decoder.generate(prompt, 12);
+
+  EXPECT_EQ(generated, expected);
+  EXPECT_GT(decoder.getNumDrafted(), 0u);
+  EXPECT_EQ(decoder.getNumAccepted(), decoder.getNumDrafted());
+}
+
+/**
+ * @brief sampling generates valid tokens and honors the stop callback
+ */
+TEST(nntrainer_models_speculative, sampling_01_p) {
+  auto target = makeTinyLM(8);
+  auto draft = makeTinyLM(4);
+
+  SpeculativeDecoder decoder(*target, *draft, VOCAB, 2, 1.0f, 42);
+  auto generated = decoder.generate({1, 2}, 8);
+  EXPECT_LE(generated.size(), 8u);
+  EXPECT_GE(generated.size(), 1u);
+  for (auto token : generated)
+    EXPECT_LT(token, VOCAB);
+
+  auto stopped = decoder.generate({1, 2}, 8, [](unsigned int) { return true; });
+  EXPECT_EQ(stopped.size(), 1u);
+}
+
+/**
+ * @brief invalid settings are refused
+ */
+TEST(nntrainer_models_speculative, invalid_01_n) {
+  auto target = makeTinyLM(8);
+  auto draft = makeTinyLM(4);
+
+  EXPECT_THROW(SpeculativeDecoder(*target, *draft, 0, 2),
+               std::invalid_argument);
+  EXPECT_THROW(SpeculativeDecoder(*target, *draft, VOCAB, 0),
+               std::invalid_argument);
+  EXPECT_THROW(SpeculativeDecoder(*target, *draft, VOCAB, 2, -1.0f),
+               std::invalid_argument);
+
+  SpeculativeDecoder decoder(*target, *draft, VOCAB, 2);
+  EXPECT_THROW(decoder.generate({}, 4), std::invalid_argument);
+  EXPECT_THROW(decoder.generate(std::vector<unsigned int>(MAX_LEN, 1), 4),
+               std::invalid_argument);
+}
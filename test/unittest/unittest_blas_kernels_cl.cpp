@@ -10,6 +10,7 @@
  * @bug		No known bugs except for NYI items
  */
 
+#include <cstdio>
 #include <fstream>
 #include <gtest/gtest.h>
 #include <type_traits>
@@ -18,7 +19,9 @@
 #include "util_func.h"
 #include <blas_kernel_interface.h>
 #include <cl_context.h>
+#include <cl_kernel_tuner.h>
 #include <layer_context.h>
+#include <opencl_program_cache.h>
 #include <tensor.h>
 
 #define EXPECT_IN_RANGE(VAL, MIN, MAX)                                         \
@@ -382,6 +385,176 @@ TEST(blas_kernels, addition_i) {
   EXPECT_IN_RANGE((float)cosSimNeon, 0.99, 1);
 }
 
+/**
+ * @brief compare dotCl against the cpu implementation for gemm shapes which
+ * are not a multiple of any tile size of the tiled kernels
+ */
+static void test_dotCl_gemm_tile_edge(int height, int width, int height_b,
+                                      int width_b, bool transA, bool transB) {
+  int batch = 1;
+  int channel = 1;
+
+  const float alpha = 1e-1;
+  const int MOD = 10;
+
+  nntrainer::TensorDim::TensorType t_type_nchw_fp32 = {
+    nntrainer::Tformat::NCHW, nntrainer::Tdatatype::FP32};
+
+  nntrainer::Tensor A_fp32(batch, channel, height, width, t_type_nchw_fp32);
+  nntrainer::Tensor B_fp32(batch, channel, height_b, width_b, t_type_nchw_fp32);
+
+  GEN_TEST_INPUT(A_fp32, ((i * (batch * height * channel) +
+                           j * (batch * height) + k * (width) + l + 1) %
+                          MOD) *
+                           alpha);
+  GEN_TEST_INPUT_B(B_fp32, ((i * (batch * height_b * channel) +
+                             j * (batch * height_b) + k * (width_b) + l + 1) %
+                            MOD) *
+                             alpha);
+
+  nntrainer::Tensor C = dotCl(A_fp32, B_fp32, transA, transB);
+  nntrainer::Tensor C_fp32 = A_fp32.dot(B_fp32, transA, transB);
+
+  float mseErrorNeon =
+    mse<float>(C.getData<float>(), C_fp32.getData<float>(), C.size());
+
+  double cosSimNeon = cosine_similarity<float>(
+    C.getData<float>(), C_fp32.getData<float>(), C.size());
+
+  const float epsilon = 1e-3 * width;
+
+  EXPECT_IN_RANGE(mseErrorNeon, 0, epsilon);
+  EXPECT_IN_RANGE((float)cosSimNeon, 0.99, 1);
+}
+
+TEST(blas_kernels, dot_gemm_37_65_129_noTrans_tile_edge) {
+  test_dotCl_gemm_tile_edge(37, 65, 65, 129, false, false);
+}
+
+TEST(blas_kernels, dot_gemm_37_65_129_transA_tile_edge) {
+  test_dotCl_gemm_tile_edge(65, 37, 65, 129, true, false);
+}
+
+TEST(blas_kernels, dot_gemm_37_65_129_transB_tile_edge) {
+  test_dotCl_gemm_tile_edge(37, 65, 129, 65, false, true);
+}
+
+TEST(blas_kernels, dot_gemm_37_65_129_transAB_tile_edge) {
+  test_dotCl_gemm_tile_edge(65, 37, 129, 65, true, true);
+}
+
+TEST(blas_kernels, dotCL_sgemv_tile_edge) {
+  /// (1 x 771) X (771 x 333), reduction length is not a multiple of 4
+  test_dotCl_gemm_tile_edge(1, 771, 771, 333, false, false);
+  /// (333 x 771) X (771 x 1)
+  test_dotCl_gemm_tile_edge(333, 771, 771, 1, false, false);
+}
+
+TEST(blas_kernels, sgemm_tuner_cache) {
+  nntrainer::ClKernelTuner &tuner = nntrainer::ClKernelTuner::getInstance();
+  tuner.clear();
+
+  /// batch, M, N, K, lda, ldb, ldc of (24 x 40) X (40 x 56)
+  const std::vector<unsigned int> shape = {1, 24, 56, 40, 40, 56, 56};
+  EXPECT_FALSE(tuner.isTuned("sgemm_cl_tiled", shape));
+
+  /// a shape not tuned ahead of time runs with the default configuration
+  test_dotCl_gemm_tile_edge(24, 40, 40, 56, false, false);
+  EXPECT_FALSE(tuner.isTuned("sgemm_cl_tiled", shape));
+
+  tuner.setTuning(true);
+  test_dotCl_gemm_tile_edge(24, 40, 40, 56, false, false);
+  tuner.setTuning(false);
+  EXPECT_TRUE(tuner.isTuned("sgemm_cl_tiled", shape));
+
+  /// second run reuses the cached configuration
+  test_dotCl_gemm_tile_edge(24, 40, 40, 56, false, false);
+  EXPECT_TRUE(tuner.isTuned("sgemm_cl_tiled", shape));
+}
+
+TEST(blas_kernels, sgemm_tuner_save_load) {
+  nntrainer::ClKernelTuner &tuner = nntrainer::ClKernelTuner::getInstance();
+  tuner.clear();
+
+  const std::vector<unsigned int> shape = {1, 24, 56, 40, 40, 56, 56};
+  tuner.set("sgemm_cl_tiled", shape, {32, 4});
+  ASSERT_TRUE(tuner.save("sgemm_tuner_save_load.txt"));
+
+  tuner.clear();
+  EXPECT_FALSE(tuner.isTuned("sgemm_cl_tiled", shape));
+  ASSERT_TRUE(tuner.load("sgemm_tuner_save_load.txt"));
+  EXPECT_TRUE(tuner.isTuned("sgemm_cl_tiled", shape));
+
+  nntrainer::ClKernelTuneParam param = tuner.tune(
+    "sgemm_cl_tiled", shape, {{16, 4}},
+    [](const nntrainer::ClKernelTuneParam &) { return false; });
+  EXPECT_EQ(param.tile_size, 32u);
+  EXPECT_EQ(param.work_per_item, 4u);
+
+  /// the tuned configuration computes the same product
+  test_dotCl_gemm_tile_edge(24, 40, 40, 56, false, false);
+
+  tuner.clear();
+  std::remove("sgemm_tuner_save_load.txt");
+}
+
+TEST(opencl_program_cache, store_load_p) {
+  const std::string dir = "opencl_program_cache_test";
+  nntrainer::opencl::ProgramCache cache(dir);
+  const std::string identity = "device=test;options=-DTS=16;source=0";
+  const std::vector<unsigned char> binary = {1, 2, 3, 4, 5, 6, 7, 8};
+
+  ASSERT_TRUE(cache.Store("test_kernel", identity, binary));
+
+  std::vector<unsigned char> loaded;
+  EXPECT_TRUE(cache.Load("test_kernel", identity, loaded));
+  EXPECT_EQ(loaded, binary);
+
+  /// another build configuration does not hit the entry
+  EXPECT_FALSE(cache.Load("test_kernel", identity + "x", loaded));
+
+  std::remove(cache.GetEntryPath("test_kernel", identity).c_str());
+  std::remove(dir.c_str());
+}
+
+TEST(opencl_program_cache, corrupted_entry_n) {
+  const std::string dir = "opencl_program_cache_test";
+  nntrainer::opencl::ProgramCache cache(dir);
+  const std::string identity = "device=test;options=;source=1";
+  const std::vector<unsigned char> binary(64, 7);
+
+  ASSERT_TRUE(cache.Store("test_kernel", identity, binary));
+  const std::string path = cache.GetEntryPath("test_kernel", identity);
+
+  /// flip the last byte of the binary
+  {
+    std::fstream fs(path, std::ios::in | std::ios::out | std::ios::binary);
+    fs.seekp(-1, std::ios::end);
+    fs.put(8);
+  }
+
+  std::vector<unsigned char> loaded;
+  EXPECT_FALSE(cache.Load("test_kernel", identity, loaded));
+
+  /// truncated entry
+  {
+    std::ofstream fs(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    fs.write("NNTRCLB", 4);
+  }
+  EXPECT_FALSE(cache.Load("test_kernel", identity, loaded));
+
+  std::remove(path.c_str());
+  std::remove(dir.c_str());
+}
+
+TEST(opencl_program_cache, disabled_n) {
+  nntrainer::opencl::ProgramCache cache("");
+  std::vector<unsigned char> binary = {1};
+  EXPECT_FALSE(cache.IsEnabled());
+  EXPECT_FALSE(cache.Store("test_kernel", "id", binary));
+  EXPECT_FALSE(cache.Load("test_kernel", "id", binary));
+}
+
 #ifdef ENABLE_FP16
 
 TEST(blas_kernels, dotCL_sgemv_M_1_1_fp16) {
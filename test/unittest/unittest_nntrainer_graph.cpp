@@ -12,9 +12,15 @@
 
 #include <gtest/gtest.h>
 #include <ini_wrapper.h>
+#include <layer_context.h>
 #include <neuralnet.h>
 #include <util_func.h>
 
+#include <functional>
+#include <random>
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include "nntrainer_test_util.h"
 
 using LayerRepresentation = std::pair<std::string, std::vector<std::string>>;
@@ -335,6 +341,228 @@ TEST(nntrainerGraphUnitTest, call_functions) {
   }
 }
 
+TEST(nntrainerGraphUnitTest, recompute_p) {
+  auto input0 = LayerRepresentation("input", {"name=in0", "input_shape=1:1:8"});
+  auto fc0 = LayerRepresentation(
+    "fully_connected", {"name=fc0", "unit=8", "activation=relu",
+                        "input_layers=in0", "recompute=true"});
+  auto fc1 = LayerRepresentation(
+    "fully_connected",
+    {"name=fc1", "unit=8", "input_layers=fc0", "recompute=true"});
+  auto fc2 =
+    LayerRepresentation("fully_connected", {"name=fc2", "unit=4",
+                                            "activation=softmax",
+                                            "input_layers=fc1"});
+
+  auto g = makeGraph({input0, fc0, fc1, fc2});
+
+  ModelHandle nn_model = ml::train::createModel(
+    ml::train::ModelType::NEURAL_NET,
+    {nntrainer::withKey("loss", "cross"), nntrainer::withKey("batch_size", 4),
+     nntrainer::withKey("memory_budget", 1)});
+
+  for (auto &node : g) {
+    EXPECT_NO_THROW(nn_model->addLayer(node));
+  }
+
+  auto optimizer = ml::train::createOptimizer("sgd", {"learning_rate=0.001"});
+  EXPECT_EQ(nn_model->setOptimizer(std::move(optimizer)), ML_ERROR_NONE);
+  EXPECT_EQ(nn_model->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(nn_model->initialize(), ML_ERROR_NONE);
+}
+
+/**
+ * @brief run a function in a child process and get its result. The child
+ * starts from the state of the random number generator of the tensors at the
+ * fork, so the dropout masks drawn by the children are the same
+ */
+static std::vector<float>
+runForked(const std::function<std::vector<float>()> &fn) {
+  int fd[2];
+  if (pipe(fd) != 0)
+    return {};
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fd[0]);
+    std::vector<float> result;
+    try {
+      result = fn();
+    } catch (...) {
+    }
+    const char *data = reinterpret_cast<const char *>(result.data());
+    size_t left = result.size() * sizeof(float);
+    while (left > 0) {
+      ssize_t written = write(fd[1], data, left);
+      if (written <= 0)
+        break;
+      data += written;
+      left -= written;
+    }
+    close(fd[1]);
+    _exit(0);
+  }
+
+  close(fd[1]);
+  std::vector<char> bytes;
+  char buf[4096];
+  ssize_t len;
+  while ((len = read(fd[0], buf, sizeof(buf))) > 0)
+    bytes.insert(bytes.end(), buf, buf + len);
+  close(fd[0]);
+  waitpid(pid, nullptr, 0);
+
+  std::vector<float> result(bytes.size() / sizeof(float));
+  std::copy(bytes.begin(), bytes.begin() + result.size() * sizeof(float),
+            reinterpret_cast<char *>(result.data()));
+  return result;
+}
+
+/**
+ * @brief train fully connected layers with batch normalization and dropout
+ * for a few iterations
+ *
+ * @param props properties of the model
+ * @param layer_props properties added to every layer but the input and loss
+ * @return std::vector<float> losses of the iterations, the gradients of the
+ * last iteration and the weights after the training including the moving
+ * statistics of the batch normalization
+ */
+static std::vector<float>
+trainRecompute(const std::vector<std::string> &props,
+               const std::vector<std::string> &layer_props = {}) {
+  constexpr unsigned int batch = 64, width = 512, out = 8, iterations = 3;
+
+  std::unique_ptr<nntrainer::NeuralNetwork> nn(new nntrainer::NeuralNetwork());
+  nn->setProperty({"batch_size=" + std::to_string(batch),
+                   "clip_grad_by_norm=1e9"});
+  nn->setProperty(props);
+
+  std::vector<LayerRepresentation> layers = {
+    {"input", {"name=in", "input_shape=1:1:" + std::to_string(width)}}};
+  std::string prev = "in";
+  for (unsigned int i = 0; i < 3; ++i) {
+    std::string idx = std::to_string(i);
+    layers.push_back({"fully_connected",
+                      {"name=fc" + idx, "unit=" + std::to_string(width),
+                       "input_layers=" + prev}});
+    layers.push_back(
+      {"batch_normalization", {"name=bn" + idx, "input_layers=fc" + idx}});
+    layers.push_back({"activation",
+                      {"name=act" + idx, "activation=relu",
+                       "input_layers=bn" + idx}});
+    layers.push_back({"dropout",
+                      {"name=drop" + idx, "dropout_rate=0.3",
+                       "input_layers=act" + idx}});
+    prev = "drop" + idx;
+  }
+  layers.push_back({"fully_connected",
+                    {"name=fc_out", "unit=" + std::to_string(out),
+                     "input_layers=" + prev}});
+  for (unsigned int i = 1; i < layers.size(); ++i)
+    layers[i].second.insert(layers[i].second.end(), layer_props.begin(),
+                            layer_props.end());
+  layers.push_back({"mse", {"name=loss", "input_layers=fc_out"}});
+  for (auto &node : makeGraph(layers))
+    nn->addLayer(node);
+
+  nn->setOptimizer(ml::train::createOptimizer("sgd", {"learning_rate=0.1"}));
+  nn->compile(ml::train::ExecutionMode::TRAIN);
+  nn->initialize(ml::train::ExecutionMode::TRAIN);
+  nn->allocate(ml::train::ExecutionMode::TRAIN);
+
+  std::mt19937 rng(0);
+  std::normal_distribution<float> dist(0.0f, 0.1f);
+  nn->forEachLayer(
+    [&](ml::train::Layer &, nntrainer::RunLayerContext &rc, void *) {
+      for (unsigned int i = 0; i < rc.getNumWeights(); ++i) {
+        auto &w = rc.getWeight(i);
+        for (unsigned int j = 0; j < w.size(); ++j)
+          w.getData<float>()[j] = rc.getWeightName(i).find("variance") !=
+                                      std::string::npos
+                                    ? 1.0f + std::abs(dist(rng))
+                                    : dist(rng);
+      }
+    });
+
+  auto input = std::make_shared<nntrainer::Tensor>(
+    nntrainer::TensorDim(batch, 1, 1, width));
+  auto label = std::make_shared<nntrainer::Tensor>(
+    nntrainer::TensorDim(batch, 1, 1, out));
+
+  std::vector<float> result;
+  for (unsigned int iter = 0; iter < iterations; ++iter) {
+    for (unsigned int j = 0; j < input->size(); ++j)
+      input->getData<float>()[j] = dist(rng) * 10.0f;
+    for (unsigned int j = 0; j < label->size(); ++j)
+      label->getData<float>()[j] = dist(rng) * 10.0f;
+
+    nn->forwarding({input}, {label}, true);
+    result.push_back(nn->getLoss());
+    nn->backwarding(iter);
+  }
+
+  /// the gradients are kept until the end of the backwarding to be clipped
+  nn->forEachLayer(
+    [&](ml::train::Layer &, nntrainer::RunLayerContext &rc, void *) {
+      for (unsigned int i = 0; i < rc.getNumWeights(); ++i) {
+        if (!rc.weightHasGradient(i))
+          continue;
+        auto &g = rc.getWeightGrad(i);
+        result.insert(result.end(), g.getData<float>(),
+                      g.getData<float>() + g.size());
+      }
+    });
+  nn->forEachLayer(
+    [&](ml::train::Layer &, nntrainer::RunLayerContext &rc, void *) {
+      for (unsigned int i = 0; i < rc.getNumWeights(); ++i) {
+        auto &w = rc.getWeight(i);
+        result.insert(result.end(), w.getData<float>(),
+                      w.getData<float>() + w.size());
+      }
+    });
+  return result;
+}
+
+/**
+ * @brief the layers recomputed to fit the memory budget, and every layer set
+ * to be recomputed, give the losses, the gradients and the weights of the
+ * training without recomputation. The batch normalization restores its moving
+ * statistics and the dropout its mask when they are forwarded again
+ */
+TEST(nntrainerGraphUnitTest, recompute_memory_budget_p) {
+  auto expected = runForked([] { return trainRecompute({}); });
+  ASSERT_FALSE(expected.empty());
+
+  for (auto &recomputed :
+       {runForked([] { return trainRecompute({"memory_budget=1"}); }),
+        runForked([] { return trainRecompute({}, {"recompute=true"}); })}) {
+    ASSERT_EQ(recomputed.size(), expected.size());
+    for (unsigned int i = 0; i < expected.size(); ++i)
+      ASSERT_FLOAT_EQ(recomputed[i], expected[i]) << "at " << i;
+  }
+}
+
+TEST(nntrainerGraphUnitTest, recompute_with_memory_swap_n) {
+  auto input0 = LayerRepresentation("input", {"name=in0", "input_shape=1:1:8"});
+  auto fc0 = LayerRepresentation(
+    "fully_connected",
+    {"name=fc0", "unit=4", "input_layers=in0", "recompute=true"});
+
+  auto g = makeGraph({input0, fc0});
+
+  ModelHandle nn_model = ml::train::createModel(
+    ml::train::ModelType::NEURAL_NET,
+    {nntrainer::withKey("loss", "mse"),
+     nntrainer::withKey("memory_swap", "true")});
+
+  for (auto &node : g) {
+    EXPECT_NO_THROW(nn_model->addLayer(node));
+  }
+
+  EXPECT_THROW(nn_model->compile(), std::invalid_argument);
+}
+
 TEST(nntrainerGraphUnitTest, NoLossLayerWhenInferenceMode) {
   std::unique_ptr<ml::train::Model> model =
     ml::train::createModel(ml::train::ModelType::NEURAL_NET);
@@ -384,6 +612,87 @@ TEST(nntrainerGraphUnitTest, NoLossLayerWhenInferenceMode) {
   ans.clear();
 }
 
+/**
+ * @brief fully connected layer with a batch normalization and an activation
+ * after it, compiled for inference with the fusion given
+ */
+static std::unique_ptr<nntrainer::NeuralNetwork>
+makeFusionModel(bool fuse, const std::string &input_shape,
+                const std::string &bn_axis = "") {
+  std::unique_ptr<nntrainer::NeuralNetwork> nn(new nntrainer::NeuralNetwork());
+  nn->setProperty(
+    {"batch_size=2", std::string("fuse_layers=") + (fuse ? "true" : "false")});
+
+  std::vector<std::string> bn = {"name=bn", "input_layers=fc0"};
+  if (!bn_axis.empty())
+    bn.push_back("axis=" + bn_axis);
+  for (auto &node : makeGraph({
+         {"input", {"name=in", "input_shape=" + input_shape}},
+         {"fully_connected", {"name=fc0", "unit=6", "input_layers=in"}},
+         {"batch_normalization", bn},
+         {"activation", {"name=act", "activation=relu", "input_layers=bn"}},
+         {"fully_connected", {"name=fc1", "unit=4", "input_layers=act"}},
+       }))
+    nn->addLayer(node);
+
+  nn->compile(ml::train::ExecutionMode::INFERENCE);
+  nn->initialize(ml::train::ExecutionMode::INFERENCE);
+  return nn;
+}
+
+/**
+ * @brief the batch normalization folded into the fully connected layer and
+ * the fused activation give the output of the layers run one by one
+ */
+TEST(nntrainerGraphUnitTest, fuse_layers_p) {
+  auto reference = makeFusionModel(false, "1:1:8");
+  auto fused = makeFusionModel(true, "1:1:8");
+  EXPECT_EQ(fused->getFlatGraph().size() + 2,
+            reference->getFlatGraph().size());
+
+  /// the fused layer takes over the weights of the batch normalization in the
+  /// order they are requested, so the weights are set in the same order
+  std::vector<nntrainer::Tensor> weights;
+  reference->forEachLayer(
+    [&weights](ml::train::Layer &, nntrainer::RunLayerContext &rc, void *) {
+      for (unsigned int i = 0; i < rc.getNumWeights(); ++i) {
+        auto &w = rc.getWeight(i);
+        if (rc.getWeightName(i).find("var") != std::string::npos)
+          w.setRandUniform(0.5f, 1.5f);
+        else
+          w.setRandNormal(0.0f, 0.3f);
+        weights.push_back(w.clone());
+      }
+    });
+  unsigned int idx = 0;
+  fused->forEachLayer(
+    [&](ml::train::Layer &, nntrainer::RunLayerContext &rc, void *) {
+      for (unsigned int i = 0; i < rc.getNumWeights(); ++i, ++idx)
+        rc.getWeight(i).copyData(weights[idx]);
+    });
+  EXPECT_EQ(idx, weights.size());
+
+  std::vector<float> input(2 * 8);
+  for (unsigned int i = 0; i < input.size(); ++i)
+    input[i] = static_cast<float>(i % 5) / 5.0f - 0.4f;
+
+  auto expected = reference->inference(2, {input.data()}, {});
+  std::vector<float> expected_out(expected[0], expected[0] + 2 * 4);
+  auto out = fused->inference(2, {input.data()}, {});
+  for (unsigned int i = 0; i < expected_out.size(); ++i)
+    EXPECT_NEAR(out[0][i], expected_out[i], 1e-5);
+}
+
+/**
+ * @brief the batch normalization along the channel of the output of a fully
+ * connected layer can not be folded into it
+ */
+TEST(nntrainerGraphUnitTest, fuse_layers_axis_n) {
+  EXPECT_THROW(makeFusionModel(true, "2:1:8"), std::invalid_argument);
+  EXPECT_NO_THROW(makeFusionModel(true, "2:1:8", "3"));
+  EXPECT_NO_THROW(makeFusionModel(false, "2:1:8"));
+}
+
 int main(int argc, char **argv) {
   int result = -1;
 
@@ -16,6 +16,8 @@
 #include <chrono>
 #include <memory>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include <profiler.h>
 
@@ -190,6 +192,29 @@ TEST_F(ProfileTest, timeTest_01_n) {
   EXPECT_EQ(ss.str(), "2 0");
 }
 
+TEST_F(ProfileTest, record_01_p) {
+  EXPECT_CALL(*listener, notify(testing::_, testing::_)).Times(1);
+
+  int kernel = profiler->registerTimeItem("opencl_kernel");
+
+  EXPECT_NO_THROW(profiler->subscribe(listener, {kernel}));
+
+  profiler->record(kernel, std::chrono::microseconds{42});
+
+  EXPECT_EQ(listener->result(kernel), std::chrono::microseconds{42});
+
+  std::stringstream ss;
+  listener->report(ss);
+  EXPECT_EQ(ss.str(), "1 0");
+}
+
+TEST_F(ProfileTest, record_01_n) {
+  EXPECT_CALL(*listener, notify(testing::_, testing::_)).Times(0);
+
+  EXPECT_THROW(profiler->record(1, std::chrono::microseconds{1}),
+               std::invalid_argument);
+}
+
 TEST_F(ProfileTest, memoryTestAlloc_01_p) {
   EXPECT_CALL(*listener, notify(testing::_, testing::_))
     .Times(testing::AtLeast(1));
@@ -216,6 +241,88 @@ TEST_F(ProfileTest, memoryTestDealloc_01_p) {
   EXPECT_EQ(ss.str(), "0 0");
 }
 
+/**
+ * @brief count the occurrences of the pattern in the string
+ */
+static size_t countOf(const std::string &str, const std::string &pattern) {
+  size_t cnt = 0;
+  for (auto pos = str.find(pattern); pos != std::string::npos;
+       pos = str.find(pattern, pos + pattern.size()))
+    cnt++;
+  return cnt;
+}
+
+TEST_F(ProfileTest, chromeTrace_01_p) {
+  auto trace = std::make_shared<ChromeTraceListener>();
+  profiler->subscribe(trace);
+
+  int nn_forward = profiler->registerTimeItem("fc:forward \"fc\"");
+  profiler->start(nn_forward);
+  profiler->end(nn_forward);
+  profiler->alloc((void *)0x1, (size_t)10, "");
+  profiler->dealloc((void *)0x1);
+  profiler->annotate("Initialize");
+
+  EXPECT_NO_THROW(trace->result(nn_forward));
+
+  std::stringstream ss;
+  trace->report(ss);
+  auto json = ss.str();
+  EXPECT_EQ(json.find("{\"traceEvents\":["), 0u);
+  EXPECT_EQ(countOf(json, R"("name":"fc:forward \"fc\"","cat":"time")"), 1u);
+  EXPECT_EQ(countOf(json, R"("ph":"C")"), 2u);
+  EXPECT_EQ(countOf(json, R"("args":{"total":10})"), 1u);
+  EXPECT_EQ(countOf(json, R"("name":"Initialize","cat":"annotation")"), 1u);
+  EXPECT_EQ(countOf(json, R"("dropped_events":0)"), 1u);
+}
+
+TEST_F(ProfileTest, chromeTrace_threads_p) {
+  auto trace = std::make_shared<ChromeTraceListener>();
+  profiler->subscribe(trace);
+
+  int item = profiler->registerTimeItem("load");
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([this, item]() {
+      for (int i = 0; i < 100; ++i) {
+        profiler->start(item);
+        profiler->end(item);
+      }
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+
+  std::stringstream ss;
+  trace->report(ss);
+  EXPECT_EQ(countOf(ss.str(), R"("ph":"X")"), 400u);
+  EXPECT_EQ(countOf(ss.str(), R"("name":"thread_name")"), 4u);
+}
+
+TEST_F(ProfileTest, chromeTrace_dropped_p) {
+  auto trace = std::make_shared<ChromeTraceListener>(2);
+  profiler->subscribe(trace);
+
+  int item = profiler->registerTimeItem("load");
+  for (int i = 0; i < 3; ++i)
+    profiler->record(item, std::chrono::microseconds{i});
+
+  EXPECT_EQ(trace->result(item), std::chrono::microseconds{1});
+
+  std::stringstream ss;
+  trace->report(ss);
+  EXPECT_EQ(countOf(ss.str(), R"("ph":"X")"), 2u);
+  EXPECT_EQ(countOf(ss.str(), R"("dropped_events":1)"), 1u);
+}
+
+TEST_F(ProfileTest, chromeTrace_result_n) {
+  auto trace = std::make_shared<ChromeTraceListener>();
+  profiler->subscribe(trace);
+
+  int item = profiler->registerTimeItem("load");
+  EXPECT_THROW(trace->result(item), std::invalid_argument);
+}
+
 /**
  * @brief Main gtest
  */
@@ -13,9 +13,14 @@
 
 #include "nntrainer_test_util.h"
 #include "util_func.h"
+#include <cpu_backend.h>
 #include <fstream>
+#include <functional>
+#include <layer_context.h>
+#include <neuralnet.h>
 #include <nntrainer_error.h>
 #include <quantizer.h>
+#include <random>
 #include <tensor.h>
 
 /**
@@ -403,6 +408,407 @@ TEST(nntrainer_Quantizer, per_tensor_affine_05_p) {
   ASSERT_EQ(output_u8, float_answer);
 }
 
+/**
+ * @brief Quantize per channel to an unsupported data type (negative test)
+ */
+TEST(nntrainer_Quantizer, per_channel_affine_01_n) {
+  nntrainer::Tensor input(1, 1, 4, 5);
+  input.setRandNormal(0.0f, 1.0f);
+
+  std::unique_ptr<nntrainer::Quantizer> quantizer =
+    nntrainer::Quantization::createQuantizer(
+      nntrainer::QScheme::PER_CHANNEL_AFFINE);
+
+  EXPECT_THROW(quantizer->quantize(input, nntrainer::Tdatatype::UINT8),
+               std::invalid_argument);
+
+  nntrainer::Tensor per_tensor(
+    {1, 1, 4, 5, {nntrainer::Tformat::NCHW, nntrainer::Tdatatype::QINT8}},
+    true);
+  float scale = 0.1f;
+  EXPECT_THROW(quantizer->quantize(input, per_tensor, &scale),
+               std::invalid_argument);
+}
+
+/**
+ * @brief Quantize to QINT8 with a scale per column and dequantize
+ */
+TEST(nntrainer_Quantizer, per_channel_affine_01_p) {
+  std::vector<float> data = {1.0f,  -20.0f, 0.01f, 0.5f, 10.0f, -0.02f,
+                             -0.5f, 5.0f,   0.03f, 0.0f, -2.5f, 0.0f};
+  nntrainer::Tensor input(1, 1, 4, 3);
+  std::copy(data.begin(), data.end(), input.getData<float>());
+
+  std::unique_ptr<nntrainer::Quantizer> quantizer =
+    nntrainer::Quantization::createQuantizer(
+      nntrainer::QScheme::PER_CHANNEL_AFFINE);
+
+  nntrainer::Tensor q = quantizer->quantize(input, nntrainer::Tdatatype::QINT8);
+  ASSERT_EQ(q.q_scheme(), nntrainer::QScheme::PER_CHANNEL_AFFINE);
+  ASSERT_EQ(q.scale_size(), 3u);
+
+  const float *scales = q.getScale<float>();
+  EXPECT_FLOAT_EQ(scales[0], 1.0f / 127.5f);
+  EXPECT_FLOAT_EQ(scales[1], 20.0f / 127.5f);
+  EXPECT_FLOAT_EQ(scales[2], 0.03f / 127.5f);
+  EXPECT_EQ(q.getData<int8_t>()[0], 127);
+  EXPECT_EQ(q.getData<int8_t>()[1], -127);
+  EXPECT_EQ(q.getData<int8_t>()[8], 127);
+
+  nntrainer::Tensor output =
+    quantizer->dequantize(q, nntrainer::Tdatatype::FP32);
+  for (unsigned int i = 0; i < data.size(); ++i)
+    EXPECT_NEAR(output.getData<float>()[i], data[i], 0.51f * scales[i % 3])
+      << "at " << i;
+}
+
+/**
+ * @brief Quantize to QINT4 with a scale per row and dequantize
+ */
+TEST(nntrainer_Quantizer, per_channel_affine_02_p) {
+  nntrainer::Tensor input(1, 1, 3, 5);
+  input.setRandNormal(0.0f, 1.0f);
+  for (unsigned int w = 0; w < 5; ++w)
+    input.setValue(0, 0, 2, w, input.getValue(0, 0, 2, w) * 100.0f);
+
+  std::unique_ptr<nntrainer::Quantizer> quantizer =
+    nntrainer::Quantization::createQuantizer(
+      nntrainer::QScheme::PER_CHANNEL_AFFINE);
+
+  nntrainer::Tensor q = quantizer->quantize(input, nntrainer::Tdatatype::QINT4);
+  ASSERT_EQ(q.scale_size(), 3u);
+
+  nntrainer::Tensor output =
+    quantizer->dequantize(q, nntrainer::Tdatatype::FP32);
+  const float *scales = q.getScale<float>();
+  for (unsigned int h = 0; h < 3; ++h) {
+    float max_abs = 0.0f;
+    for (unsigned int w = 0; w < 5; ++w)
+      max_abs = std::max(max_abs, std::abs(input.getValue(0, 0, h, w)));
+    EXPECT_FLOAT_EQ(scales[h], max_abs / 7.5f);
+
+    for (unsigned int w = 0; w < 5; ++w)
+      EXPECT_NEAR(output.getValue(0, 0, h, w), input.getValue(0, 0, h, w),
+                  0.51f * scales[h]);
+  }
+}
+
+/**
+ * @brief naive int8 gemm of the dequantized result
+ */
+static std::vector<float> naive_qgemm(unsigned int M, unsigned int N,
+                                      unsigned int K, const int8_t *A,
+                                      const float *a_scales, const int8_t *B,
+                                      const float *b_scales, bool trans_b,
+                                      const float *bias) {
+  std::vector<float> C(M * N);
+  for (unsigned int m = 0; m < M; ++m) {
+    for (unsigned int n = 0; n < N; ++n) {
+      int32_t sum = 0;
+      for (unsigned int k = 0; k < K; ++k)
+        sum += A[m * K + k] * (trans_b ? B[n * K + k] : B[k * N + n]);
+      C[m * N + n] = sum * a_scales[m] * b_scales[n] + (bias ? bias[n] : 0);
+    }
+  }
+  return C;
+}
+
+/**
+ * @brief int8 gemm matches the naive one on both layouts and every tail
+ */
+TEST(nntrainer_Quantizer, qgemm_s8_01_p) {
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> a_dist(-127, 127);
+  std::uniform_int_distribution<int> b_dist(-128, 127);
+  std::uniform_real_distribution<float> f_dist(0.001f, 0.1f);
+
+  for (unsigned int M : {1u, 3u, 4u, 9u}) {
+    for (unsigned int N : {1u, 15u, 16u, 70u}) {
+      for (unsigned int K : {1u, 5u, 32u, 67u}) {
+        for (bool trans_b : {false, true}) {
+          std::vector<int8_t> A(M * K), B(K * N);
+          std::vector<float> a_scales(M), b_scales(N), bias(N), C(M * N);
+          for (auto &a : A)
+            a = a_dist(rng);
+          for (auto &b : B)
+            b = b_dist(rng);
+          for (auto &s : a_scales)
+            s = f_dist(rng);
+          for (auto &s : b_scales)
+            s = f_dist(rng);
+          for (auto &b : bias)
+            b = f_dist(rng) - 0.05f;
+
+          const float *bias_data = (M % 2) ? bias.data() : nullptr;
+          nntrainer::qgemm_s8(M, N, K, A.data(), a_scales.data(), B.data(),
+                              b_scales.data(), trans_b, bias_data, C.data());
+          auto expected =
+            naive_qgemm(M, N, K, A.data(), a_scales.data(), B.data(),
+                        b_scales.data(), trans_b, bias_data);
+
+          for (unsigned int i = 0; i < M * N; ++i)
+            ASSERT_NEAR(C[i], expected[i], 1e-4f * (1 + std::abs(expected[i])))
+              << "M " << M << " N " << N << " K " << K << " trans_b "
+              << trans_b << " at " << i;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief rows are quantized symmetrically with a scale of their own
+ */
+TEST(nntrainer_Quantizer, quantize_rows_s8_01_p) {
+  const unsigned int M = 3, K = 45;
+  std::vector<float> X(M * K);
+  for (unsigned int i = 0; i < K; ++i) {
+    X[i] = std::sin(0.7f * i) * 3.0f;
+    X[K + i] = 0.0f;
+    X[2 * K + i] = (i % 5) * -0.25f;
+  }
+
+  std::vector<int8_t> Y(M * K);
+  std::vector<float> scales(M);
+  nntrainer::quantize_rows_s8(M, K, X.data(), Y.data(), scales.data());
+
+  EXPECT_FLOAT_EQ(scales[1], 0.0f);
+  EXPECT_FLOAT_EQ(scales[2], 1.0f / 127.0f);
+  EXPECT_EQ(Y[2 * K + 4], -127);
+  for (unsigned int m = 0; m < M; ++m) {
+    for (unsigned int k = 0; k < K; ++k) {
+      EXPECT_GE(Y[m * K + k], -127);
+      EXPECT_NEAR(Y[m * K + k] * scales[m], X[m * K + k],
+                  scales[m] * 0.5f + 1e-6f);
+    }
+  }
+}
+
+/**
+ * @brief fake quantization rounds to the grid of scales of rows or columns
+ */
+TEST(nntrainer_Quantizer, fake_quantize_01_p) {
+  const unsigned int M = 3, N = 21;
+  std::vector<float> X(M * N), Y(M * N);
+  for (unsigned int i = 0; i < M * N; ++i)
+    X[i] = std::sin(0.37f * i) * 4.0f;
+
+  for (bool col_scales : {false, true}) {
+    std::vector<float> scales(col_scales ? N : M);
+    for (unsigned int i = 0; i < scales.size(); ++i)
+      scales[i] = 0.01f + 0.003f * i;
+
+    nntrainer::fake_quantize(M, N, X.data(), Y.data(), scales.data(),
+                             col_scales, -128.0f, 127.0f);
+
+    for (unsigned int m = 0; m < M; ++m) {
+      for (unsigned int n = 0; n < N; ++n) {
+        float scale = scales[col_scales ? n : m];
+        float q = std::round(X[m * N + n] / scale);
+        float expected = std::min(std::max(q, -128.0f), 127.0f) * scale;
+        ASSERT_NEAR(Y[m * N + n], expected, 1e-5f)
+          << "col_scales " << col_scales << " at " << m << ", " << n;
+      }
+    }
+  }
+}
+
+/**
+ * @brief gradient of fake quantization passes where the input is not clipped
+ */
+TEST(nntrainer_Quantizer, fake_quantize_grad_01_p) {
+  const unsigned int N = 19;
+  const float scale = 0.1f;
+  std::vector<float> X(N), dY(N), dX(N);
+  for (unsigned int i = 0; i < N; ++i) {
+    X[i] = (static_cast<float>(i) - 9.0f) * 0.2f;
+    dY[i] = 1.0f + i;
+  }
+
+  nntrainer::fake_quantize_grad(N, X.data(), dY.data(), dX.data(), scale,
+                                -8.0f, 7.0f);
+
+  for (unsigned int i = 0; i < N; ++i) {
+    float q = std::round(X[i] / scale);
+    float expected = (q >= -8.0f && q <= 7.0f) ? dY[i] : 0.0f;
+    EXPECT_FLOAT_EQ(dX[i], expected) << "at " << i;
+  }
+}
+
+/**
+ * @brief fake quantization rounds halfway values away from zero as the
+ * quantizer, so the largest value of a QINT4 channel, which is halfway at
+ * 7.5, is clipped to 7 and its negation kept at -8
+ */
+TEST(nntrainer_Quantizer, fake_quantize_02_p) {
+  const unsigned int N = 19;
+  const float scale = 0.25f;
+  std::vector<float> X(N), Y(N), dY(N, 1.0f), dX(N);
+  for (unsigned int i = 0; i < N; ++i)
+    X[i] = (static_cast<float>(i) - 9.0f + 0.5f) * scale;
+  X[0] = -7.5f * scale;
+  X[N - 1] = 7.5f * scale;
+
+  nntrainer::fake_quantize(1, N, X.data(), Y.data(), &scale, false, -8.0f,
+                           7.0f);
+  nntrainer::fake_quantize_grad(N, X.data(), dY.data(), dX.data(), scale,
+                                -8.0f, 7.0f);
+
+  for (unsigned int i = 0; i < N; ++i) {
+    float q = X[i] > 0.0f ? std::floor(X[i] / scale) + 1.0f
+                          : std::ceil(X[i] / scale) - 1.0f;
+    EXPECT_FLOAT_EQ(Y[i], std::min(std::max(q, -8.0f), 7.0f) * scale)
+      << "at " << i;
+    EXPECT_FLOAT_EQ(dX[i], (q >= -8.0f && q <= 7.0f) ? 1.0f : 0.0f)
+      << "at " << i;
+  }
+  EXPECT_FLOAT_EQ(Y[0], -8.0f * scale);
+  EXPECT_FLOAT_EQ(Y[N - 1], 7.0f * scale);
+}
+
+/**
+ * @brief run a single layer model of int8 weights on random input
+ *
+ * @param layer layer type
+ * @param props properties of the layer
+ * @param input_shape input shape of the model
+ * @param fill fills the weights of the allocated layer
+ * @param input input of the model, filled with random values
+ * @param out_len length of the output of the batch
+ * @return output of the model
+ */
+static std::vector<float>
+runInt8Layer(const std::string &layer, const std::vector<std::string> &props,
+             const std::string &input_shape,
+             std::function<void(nntrainer::RunLayerContext &)> fill,
+             std::vector<float> &input, unsigned int out_len) {
+  nntrainer::NeuralNetwork nn;
+  nn.setProperty({"batch_size=2", "model_tensor_type=QINT8-FP32"});
+
+  auto graph = makeGraph({
+    {"input", {"name=in", "input_shape=" + input_shape}},
+    {layer, props},
+  });
+  for (auto &node : graph)
+    nn.addLayer(node);
+  nn.compile(ml::train::ExecutionMode::INFERENCE);
+  nn.initialize(ml::train::ExecutionMode::INFERENCE);
+  nn.allocate(ml::train::ExecutionMode::INFERENCE);
+
+  nn.forEachLayer([&](ml::train::Layer &l, nntrainer::RunLayerContext &rc,
+                      void *) {
+    if (l.getType() == layer)
+      fill(rc);
+  });
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+  for (auto &x : input)
+    x = dist(rng);
+
+  auto out = nn.inference(2, {input.data()}, {});
+  return std::vector<float>(out[0], out[0] + out_len);
+}
+
+/**
+ * @brief fully connected layer of an int8 weight runs the int8 gemm
+ */
+TEST(nntrainer_Quantizer, fc_int8_gemm_01_p) {
+  const unsigned int H = 3, K = 37, N = 21;
+  const float w_scale = 0.01f;
+  std::vector<float> weight(K * N), bias(N);
+
+  auto fill = [&](nntrainer::RunLayerContext &rc) {
+    nntrainer::Tensor &w = rc.getWeight(0);
+    nntrainer::Tensor &b = rc.getWeight(1);
+    int8_t *w_data = w.getData<int8_t>();
+    for (unsigned int i = 0; i < K * N; ++i) {
+      w_data[i] = static_cast<int8_t>((i * 37) % 255 - 127);
+      weight[i] = w_data[i] * w_scale;
+    }
+    *w.getScale<float>() = w_scale;
+    for (unsigned int n = 0; n < N; ++n)
+      bias[n] = b.getData<float>()[n] = 0.1f * n - 1.0f;
+  };
+
+  std::vector<float> input(2 * H * K);
+  auto out = runInt8Layer("fully_connected",
+                          {"name=fc", "input_layers=in", "unit=21"},
+                          "1:3:37", fill, input, 2 * H * N);
+
+  for (unsigned int r = 0; r < 2 * H; ++r) {
+    const float *x = input.data() + r * K;
+    float amax = 0.0f;
+    for (unsigned int k = 0; k < K; ++k)
+      amax = std::max(amax, std::abs(x[k]));
+
+    for (unsigned int n = 0; n < N; ++n) {
+      float expected = bias[n], bound = 1e-4f;
+      for (unsigned int k = 0; k < K; ++k) {
+        expected += x[k] * weight[k * N + n];
+        bound += std::abs(weight[k * N + n]) * amax / 254.0f;
+      }
+      EXPECT_NEAR(out[r * N + n], expected, bound) << "at " << r << ", " << n;
+    }
+  }
+}
+
+/**
+ * @brief conv2d layer of an int8 filter runs the int8 gemm
+ */
+TEST(nntrainer_Quantizer, conv2d_int8_gemm_01_p) {
+  const unsigned int C = 3, H = 5, W = 6, F = 4, R = 3;
+  const float w_scale = 0.02f;
+  std::vector<float> filter(F * C * R * R), bias(F);
+
+  auto fill = [&](nntrainer::RunLayerContext &rc) {
+    nntrainer::Tensor &w = rc.getWeight(0);
+    nntrainer::Tensor &b = rc.getWeight(1);
+    int8_t *w_data = w.getData<int8_t>();
+    for (unsigned int i = 0; i < filter.size(); ++i) {
+      w_data[i] = static_cast<int8_t>((i * 53) % 255 - 127);
+      filter[i] = w_data[i] * w_scale;
+    }
+    *w.getScale<float>() = w_scale;
+    for (unsigned int f = 0; f < F; ++f)
+      bias[f] = b.getData<float>()[f] = 0.5f * f - 1.0f;
+  };
+
+  std::vector<float> input(2 * C * H * W);
+  auto out = runInt8Layer("conv2d",
+                          {"name=conv", "input_layers=in", "filters=4",
+                           "kernel_size=3,3", "padding=same"},
+                          "3:5:6", fill, input, 2 * F * H * W);
+
+  for (unsigned int b = 0; b < 2; ++b) {
+    const float *x = input.data() + b * C * H * W;
+    for (unsigned int f = 0; f < F; ++f) {
+      for (unsigned int oh = 0; oh < H; ++oh) {
+        for (unsigned int ow = 0; ow < W; ++ow) {
+          float expected = bias[f], bound = 1e-4f, amax = 0.0f;
+          for (unsigned int c = 0; c < C; ++c) {
+            for (unsigned int i = 0; i < R; ++i) {
+              for (unsigned int j = 0; j < R; ++j) {
+                int h = oh + i - 1, w = ow + j - 1;
+                if (h < 0 || h >= (int)H || w < 0 || w >= (int)W)
+                  continue;
+                float v = x[(c * H + h) * W + w];
+                float k = filter[((f * C + c) * R + i) * R + j];
+                expected += v * k;
+                bound += std::abs(k);
+                amax = std::max(amax, std::abs(v));
+              }
+            }
+          }
+          bound *= amax / 254.0f;
+          EXPECT_NEAR(out[((b * F + f) * H + oh) * W + ow], expected,
+                      bound + 1e-4f);
+        }
+      }
+    }
+  }
+}
+
 int main(int argc, char **argv) {
   int result = -1;
 
@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @file   unittest_nntrainer_runtime_metrics.cpp
+ * @date   18 Oct 2026
+ * @brief  Runtime metrics Tester
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <runtime_metrics.h>
+
+using namespace nntrainer;
+
+/**
+ * @brief every value falls into the bucket whose bounds contain it
+ */
+TEST(nntrainer_runtime_metrics, bucket_01_p) {
+  for (uint64_t v : {0ull, 1ull, 3ull, 4ull, 5ull, 7ull, 8ull, 1000ull,
+                     123456789ull, 1ull << 40}) {
+    unsigned int b = LatencyHistogram::bucketOf(v);
+    EXPECT_LE(LatencyHistogram::lowerBoundOf(b), v);
+    EXPECT_GT(LatencyHistogram::lowerBoundOf(b + 1), v);
+  }
+
+  EXPECT_EQ(LatencyHistogram::bucketOf(~0ull),
+            LatencyHistogram::NUM_BUCKETS - 1);
+}
+
+/**
+ * @brief percentiles are within a bucket of the exact value
+ */
+TEST(nntrainer_runtime_metrics, percentile_01_p) {
+  LatencyHistogram hist;
+  for (uint64_t i = 1; i <= 1000; ++i)
+    hist.record(i * 1000);
+
+  EXPECT_EQ(hist.count(), 1000u);
+  EXPECT_EQ(hist.total(), 500500u * 1000);
+  EXPECT_EQ(hist.max(), 1000000u);
+  EXPECT_NEAR(hist.percentile(50), 500000, 500000 / 4);
+  EXPECT_NEAR(hist.percentile(99), 990000, 990000 / 4);
+  EXPECT_LE(hist.percentile(100), hist.max());
+}
+
+/**
+ * @brief durations are recorded in nanoseconds
+ */
+TEST(nntrainer_runtime_metrics, duration_01_p) {
+  LatencyHistogram hist;
+  hist.record(std::chrono::microseconds(3));
+  EXPECT_EQ(hist.max(), 3000u);
+
+  {
+    ScopedLatency scoped(hist);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(hist.count(), 2u);
+  EXPECT_GE(hist.max(), 1000000u);
+}
+
+/**
+ * @brief concurrent records are not lost
+ */
+TEST(nntrainer_runtime_metrics, threads_01_p) {
+  LatencyHistogram hist;
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < 4; ++t)
+    threads.emplace_back([&hist, t] {
+      for (uint64_t i = 0; i < 10000; ++i)
+        hist.record(t * 100 + i % 7);
+    });
+  for (auto &t : threads)
+    t.join();
+
+  EXPECT_EQ(hist.count(), 40000u);
+  EXPECT_EQ(hist.max(), 306u);
+}
+
+/**
+ * @brief an empty histogram reports zero, also after reset
+ */
+TEST(nntrainer_runtime_metrics, reset_01_n) {
+  LatencyHistogram hist;
+  EXPECT_EQ(hist.percentile(50), 0u);
+
+  hist.record(100);
+  hist.reset();
+  EXPECT_EQ(hist.count(), 0u);
+  EXPECT_EQ(hist.max(), 0u);
+  EXPECT_EQ(hist.percentile(99), 0u);
+}
+
+/**
+ * @brief swap counters are cleared while the live counters are kept
+ */
+TEST(nntrainer_runtime_metrics, counters_01_p) {
+  auto &counters = RuntimeCounters::Global();
+  uint64_t pool = counters.get(RuntimeCounters::MEMORY_POOL_BYTES);
+
+  counters.add(RuntimeCounters::MEMORY_POOL_BYTES, 64);
+  counters.add(RuntimeCounters::SWAP_READ_BYTES, 32);
+  EXPECT_EQ(counters.get(RuntimeCounters::MEMORY_POOL_BYTES), pool + 64);
+
+  counters.resetCumulative();
+  EXPECT_EQ(counters.get(RuntimeCounters::SWAP_READ_BYTES), 0u);
+  EXPECT_EQ(counters.get(RuntimeCounters::MEMORY_POOL_BYTES), pool + 64);
+
+  counters.sub(RuntimeCounters::MEMORY_POOL_BYTES, 64);
+  EXPECT_EQ(counters.get(RuntimeCounters::MEMORY_POOL_BYTES), pool);
+}
+
+/**
+ * @brief Main gtest
+ */
+int main(int argc, char **argv) {
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest(&argc, argv);
+  } catch (...) {
+    std::cerr << "Failed to init gtest\n";
+  }
+
+  try {
+    result = RUN_ALL_TESTS();
+  } catch (...) {
+    std::cerr << "Failed to run test.\n";
+  }
+
+  return result;
+}
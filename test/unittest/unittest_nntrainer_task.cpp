@@ -14,6 +14,7 @@
 #include <future>
 #include <mutex>
 #include <stdexcept>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -177,6 +178,97 @@ TEST_F(TaskExecutorTest, run_async_02_p) {
   f.wait();
 }
 
+TEST_F(TaskExecutorTest, run_async_priority_01_p) {
+  EXPECT_CALL(*executor, handleWork).Times(3);
+
+  std::promise<void> blocker;
+  auto blocked = blocker.get_future().share();
+  std::promise<void> p;
+  auto f = p.get_future();
+
+  std::mutex order_mutex;
+  std::vector<int> order;
+  auto work = [&](std::atomic_bool &running, void *data) {
+    if (data == nullptr) {
+      blocked.wait();
+    } else {
+      std::scoped_lock lock(order_mutex);
+      order.push_back(*static_cast<int *>(data));
+    }
+    return 0;
+  };
+
+  int complete_cnt = 0;
+  auto complete = [&](int id, nntrainer::TaskExecutor::CompleteStatus status) {
+    EXPECT_EQ(status, nntrainer::TaskExecutor::CompleteStatus::SUCCESS);
+    if (++complete_cnt >= 3)
+      p.set_value();
+  };
+
+  int low_data = 1, high_data = 2;
+  auto task_block = std::make_shared<nntrainer::TaskAsync<>>(work, nullptr);
+  auto task_low = std::make_shared<nntrainer::TaskAsync<>>(
+    work, static_cast<void *>(&low_data));
+  auto task_high = std::make_shared<nntrainer::TaskAsync<>>(
+    work, static_cast<void *>(&high_data));
+  task_low->setPriority(nntrainer::TaskAsync<>::LOW);
+  task_high->setPriority(nntrainer::TaskAsync<>::HIGH);
+
+  // the worker is busy while the other two tasks are queued
+  executor->run(task_block, complete);
+  executor->run(task_low, complete);
+  executor->run(task_high, complete);
+  blocker.set_value();
+
+  f.wait();
+  ASSERT_EQ(order.size(), 2u);
+  EXPECT_EQ(order[0], high_data);
+  EXPECT_EQ(order[1], low_data);
+}
+
+TEST(TaskExecutor, run_async_workers_01_p) {
+  nntrainer::TaskExecutor executor("workers", 2);
+
+  std::promise<void> first_started;
+  std::promise<void> p;
+  auto f = p.get_future();
+
+  // the first task only finishes when the second one runs alongside
+  auto work1 = [&](std::atomic_bool &running, void *data) {
+    first_started.set_value();
+    return static_cast<std::promise<void> *>(data)->get_future().wait_for(
+             std::chrono::seconds(5)) == std::future_status::ready
+             ? 0
+             : -1;
+  };
+  auto work2 = [&](std::atomic_bool &running, void *data) {
+    static_cast<std::promise<void> *>(data)->set_value();
+    return 0;
+  };
+
+  std::atomic_int complete_cnt = 0;
+  std::atomic_bool success = true;
+  auto complete = [&](int id, nntrainer::TaskExecutor::CompleteStatus status) {
+    if (status != nntrainer::TaskExecutor::CompleteStatus::SUCCESS)
+      success = false;
+    if (++complete_cnt >= 2)
+      p.set_value();
+  };
+
+  std::promise<void> second_done;
+  auto task1 = std::make_shared<nntrainer::TaskAsync<>>(
+    work1, static_cast<void *>(&second_done));
+  auto task2 = std::make_shared<nntrainer::TaskAsync<>>(
+    work2, static_cast<void *>(&second_done));
+
+  executor.run(task1, complete);
+  first_started.get_future().wait();
+  executor.run(task2, complete);
+
+  f.wait();
+  EXPECT_TRUE(success);
+}
+
 /**
  * Cancel and timeout feature are instantly removed now.
  * It needs to implement the features more precisely.
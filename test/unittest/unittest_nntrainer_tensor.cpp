@@ -3720,6 +3720,66 @@ TEST(nntrainer_Tensor, dot_shortcuts_p) {
   }
 }
 
+TEST(nntrainer_Tensor, dot_batched_p) {
+  const unsigned int batch = 3, M = 4, N = 6, K = 5;
+
+  for (bool trans : {false, true}) {
+    for (bool trans_m : {false, true}) {
+      nntrainer::Tensor input =
+        trans ? randUniform(batch, 1, K, M) : randUniform(batch, 1, M, K);
+      nntrainer::Tensor m =
+        trans_m ? randUniform(batch, 1, N, K) : randUniform(batch, 1, K, N);
+      nntrainer::Tensor result = randUniform(batch, 1, M, N);
+      nntrainer::Tensor answer = result.clone();
+
+      for (unsigned int b = 0; b < batch; ++b) {
+        nntrainer::Tensor answer_b = answer.getBatchSlice(b, 1);
+        input.getBatchSlice(b, 1).dot(m.getBatchSlice(b, 1), answer_b, trans,
+                                      trans_m, 0.5f);
+      }
+
+      input.dotBatched(m, result, trans, trans_m, 0.5f);
+      for (unsigned int i = 0; i < result.size(); ++i)
+        EXPECT_NEAR(result.getValue(i), answer.getValue(i), 1e-5f);
+    }
+  }
+}
+
+TEST(nntrainer_Tensor, dot_batched_shared_p) {
+  const unsigned int batch = 3, M = 4, N = 6, K = 5;
+
+  for (bool trans : {false, true}) {
+    for (bool trans_m : {false, true}) {
+      nntrainer::Tensor input =
+        trans ? randUniform(batch, 1, K, M) : randUniform(batch, 1, M, K);
+      nntrainer::Tensor m =
+        trans_m ? randUniform(1, 1, N, K) : randUniform(1, 1, K, N);
+      nntrainer::Tensor result(batch, 1, M, N);
+      nntrainer::Tensor answer(batch, 1, M, N);
+
+      for (unsigned int b = 0; b < batch; ++b) {
+        nntrainer::Tensor answer_b = answer.getBatchSlice(b, 1);
+        input.getBatchSlice(b, 1).dot(m, answer_b, trans, trans_m);
+      }
+
+      input.dotBatched(m, result, trans, trans_m);
+      for (unsigned int i = 0; i < result.size(); ++i)
+        EXPECT_NEAR(result.getValue(i), answer.getValue(i), 1e-5f);
+    }
+  }
+}
+
+TEST(nntrainer_Tensor, dot_batched_n) {
+  nntrainer::Tensor input = randUniform(3, 1, 4, 5);
+  nntrainer::Tensor result(3, 1, 4, 6);
+
+  nntrainer::Tensor m = randUniform(3, 1, 4, 6);
+  EXPECT_THROW(input.dotBatched(m, result), std::runtime_error);
+
+  m = randUniform(2, 1, 5, 6);
+  EXPECT_THROW(input.dotBatched(m, result), std::invalid_argument);
+}
+
 TEST(nntrainer_Tensor, transpose_p) {
   nntrainer::TensorDim ref_dim(3, 2, 4, 5);
 
@@ -6044,6 +6104,96 @@ TEST(nntrainer_Tensor, transpose_5122048) {
   EXPECT_EQ(A_fp32, A_T_T);
 }
 
+/**
+ * @brief count the elements of @a out which are not @a in transposed along
+ * @a direction
+ */
+template <typename T>
+static unsigned int countTransposeMismatch(const nntrainer::Tensor &in,
+                                           const nntrainer::Tensor &out,
+                                           const std::string &direction) {
+  const unsigned int dirs[3] = {(unsigned int)direction[0] - '0',
+                                (unsigned int)direction[2] - '0',
+                                (unsigned int)direction[4] - '0'};
+  unsigned int mismatch = 0;
+  for (unsigned int b = 0; b < out.batch(); ++b)
+    for (unsigned int i = 0; i < out.channel(); ++i)
+      for (unsigned int j = 0; j < out.height(); ++j)
+        for (unsigned int k = 0; k < out.width(); ++k) {
+          unsigned int idx[3];
+          idx[dirs[0]] = i, idx[dirs[1]] = j, idx[dirs[2]] = k;
+          mismatch += out.getValue<T>(b, i, j, k) !=
+                      in.getValue<T>(b, idx[0], idx[1], idx[2]);
+        }
+  return mismatch;
+}
+
+TEST(nntrainer_Tensor, transpose_all_directions_p) {
+  nntrainer::Tensor t = randUniform(2, 37, 65, 130);
+
+  for (auto direction :
+       {"0:1:2", "0:2:1", "1:0:2", "1:2:0", "2:0:1", "2:1:0"}) {
+    nntrainer::Tensor m = t.transpose(direction);
+    EXPECT_EQ(m.getDim(), t.getDim().transpose(direction));
+    EXPECT_EQ(countTransposeMismatch<float>(t, m, direction), 0u)
+      << direction;
+  }
+}
+
+TEST(nntrainer_Tensor, transpose_unit_axes_p) {
+  for (auto t : {randUniform(3, 1, 65, 130), randUniform(3, 37, 1, 130),
+                 randUniform(3, 37, 65, 1), randUniform(3, 1, 1, 130)}) {
+    for (auto direction :
+         {"0:1:2", "0:2:1", "1:0:2", "1:2:0", "2:0:1", "2:1:0"}) {
+      nntrainer::Tensor m = t.transpose(direction);
+      EXPECT_EQ(countTransposeMismatch<float>(t, m, direction), 0u)
+        << direction << " of " << t.getDim();
+    }
+  }
+}
+
+TEST(nntrainer_Tensor, transpose_int_p) {
+  nntrainer::TensorDim dim(2, 3, 17, 9);
+  const auto directions = {"0:2:1", "1:0:2", "1:2:0", "2:0:1", "2:1:0"};
+
+  for (auto dtype :
+       {nntrainer::Tdatatype::QINT8, nntrainer::Tdatatype::QINT16,
+        nntrainer::Tdatatype::UINT8, nntrainer::Tdatatype::UINT16,
+        nntrainer::Tdatatype::UINT32}) {
+    dim.setDataType(dtype);
+    nntrainer::Tensor t(dim);
+    for (unsigned int b = 0; b < t.batch(); ++b)
+      for (unsigned int c = 0; c < t.channel(); ++c)
+        for (unsigned int h = 0; h < t.height(); ++h)
+          for (unsigned int w = 0; w < t.width(); ++w)
+            t.setValue(b, c, h, w, (c * 31 + h * 7 + w) % 100);
+    t.getScale<float>()[0] = 0.5f;
+
+    for (auto direction : directions) {
+      nntrainer::Tensor m = t.transpose(direction);
+      EXPECT_FLOAT_EQ(m.getScale<float>()[0], 0.5f);
+      unsigned int mismatch = 0;
+      if (dtype == nntrainer::Tdatatype::QINT8)
+        mismatch = countTransposeMismatch<int8_t>(t, m, direction);
+      else if (dtype == nntrainer::Tdatatype::QINT16)
+        mismatch = countTransposeMismatch<int16_t>(t, m, direction);
+      else if (dtype == nntrainer::Tdatatype::UINT8)
+        mismatch = countTransposeMismatch<uint8_t>(t, m, direction);
+      else if (dtype == nntrainer::Tdatatype::UINT16)
+        mismatch = countTransposeMismatch<uint16_t>(t, m, direction);
+      else
+        mismatch = countTransposeMismatch<uint32_t>(t, m, direction);
+      EXPECT_EQ(mismatch, 0u) << direction;
+    }
+  }
+}
+
+TEST(nntrainer_Tensor, transpose_direction_n) {
+  nntrainer::Tensor t = ranged(2, 3, 4, 5);
+  nntrainer::Tensor out(2, 3, 4, 5);
+  EXPECT_THROW(t.transpose("0:0:1", out), std::invalid_argument);
+}
+
 int main(int argc, char **argv) {
   int result = -1;
 
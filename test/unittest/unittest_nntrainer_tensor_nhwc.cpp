@@ -4787,6 +4787,43 @@ TEST(nntrainer_Tensor, tranpose_invalid_format_04_n) {
 //   EXPECT_THROW({ input.dequantize(output, 1); }, std::invalid_argument);
 // }
 
+/**
+ * @brief count the elements of @a out which are not @a in transposed along
+ * @a direction
+ */
+template <typename T>
+static unsigned int countTransposeMismatch(const nntrainer::Tensor &in,
+                                           const nntrainer::Tensor &out,
+                                           const std::string &direction) {
+  const unsigned int dirs[3] = {(unsigned int)direction[0] - '0',
+                                (unsigned int)direction[2] - '0',
+                                (unsigned int)direction[4] - '0'};
+  unsigned int mismatch = 0;
+  for (unsigned int b = 0; b < out.batch(); ++b)
+    for (unsigned int i = 0; i < out.channel(); ++i)
+      for (unsigned int j = 0; j < out.height(); ++j)
+        for (unsigned int k = 0; k < out.width(); ++k) {
+          unsigned int idx[3];
+          idx[dirs[0]] = i, idx[dirs[1]] = j, idx[dirs[2]] = k;
+          mismatch += out.getValue<T>(b, i, j, k) !=
+                      in.getValue<T>(b, idx[0], idx[1], idx[2]);
+        }
+  return mismatch;
+}
+
+TEST(nntrainer_Tensor, transpose_all_directions_nhwc_p) {
+  nntrainer::Tensor t =
+    randUniform(2, 37, 65, 130, -1, 1, nntrainer::Tformat::NHWC);
+
+  for (auto direction :
+       {"0:1:2", "0:2:1", "1:0:2", "1:2:0", "2:0:1", "2:1:0"}) {
+    nntrainer::Tensor m = t.transpose(direction);
+    EXPECT_EQ(m.getDim(), t.getDim().transpose(direction));
+    EXPECT_EQ(countTransposeMismatch<float>(t, m, direction), 0u)
+      << direction;
+  }
+}
+
 int main(int argc, char **argv) {
   int result = -1;
 
@@ -876,6 +876,76 @@ TEST(TensorPool, createOrExtend_unmanaged_n) {
     pool.requestOrExtend("t", {10}, {0}, nntrainer::TensorLifespan::UNMANAGED));
 }
 
+/**
+ * @brief recomputed tensor does not hold memory until the recomputation
+ */
+TEST(TensorPool, recompute_p) {
+  constexpr auto fwd_ls = nntrainer::TensorLifespan::FORWARD_FUNC_LIFESPAN;
+  nntrainer::TensorPool pool;
+  nntrainer::Tensor *t1 = nullptr, *t2 = nullptr;
+
+  EXPECT_NO_THROW(t1 = pool.request("t1", {100}, {1, 9}, fwd_ls));
+  EXPECT_NO_THROW(t2 = pool.request("t2", {100}, {2, 7}, fwd_ls));
+  EXPECT_NO_THROW(pool.setRecompute("t1", 8, true));
+
+  EXPECT_NO_THROW(pool.finalize(nntrainer::OptimizedV1Planner(), 0, 10));
+  EXPECT_EQ(pool.minMemoryRequirement(), 100 * sizeof(float));
+  EXPECT_NO_THROW(pool.allocate());
+
+  EXPECT_EQ(t1->getData(), t2->getData());
+
+  EXPECT_NO_THROW(pool.deallocate());
+}
+
+/**
+ * @brief recomputed tensor switches to its memory after the recomputation
+ */
+TEST(TensorPool, recompute_switch_p) {
+  constexpr auto fwd_ls = nntrainer::TensorLifespan::FORWARD_FUNC_LIFESPAN;
+  nntrainer::TensorPool pool;
+  nntrainer::Tensor *t1 = nullptr, *t2 = nullptr;
+
+  EXPECT_NO_THROW(t1 = pool.request("t1", {100}, {1, 9}, fwd_ls));
+  EXPECT_NO_THROW(t2 = pool.view("t2", "t1", {50}, {2}, fwd_ls, 50));
+  EXPECT_NO_THROW(pool.setRecompute("t1", 8, true));
+
+  EXPECT_NO_THROW(pool.finalize(nntrainer::BasicPlanner(), 0, 10));
+  EXPECT_EQ(pool.size(), 2 * 100 * sizeof(float));
+  EXPECT_NO_THROW(pool.allocate());
+
+  float *forward_data = t1->getData();
+  EXPECT_EQ(t2->getData(), forward_data + 50);
+
+  EXPECT_NO_THROW(pool.activateRecompute(8));
+  EXPECT_NE(t1->getData(), forward_data);
+  EXPECT_EQ(t2->getData(), t1->getData() + 50);
+  EXPECT_NO_THROW(pool.deactivateRecompute());
+  EXPECT_EQ(t1->getData(), forward_data);
+  EXPECT_EQ(t2->getData(), forward_data + 50);
+
+  EXPECT_NO_THROW(pool.deallocate());
+}
+
+/**
+ * @brief recompute of tensor with long term lifespan is not split
+ */
+TEST(TensorPool, recompute_long_term_p) {
+  nntrainer::TensorPool pool;
+  nntrainer::Tensor *t1 = nullptr;
+
+  EXPECT_NO_THROW(t1 = pool.request("t1", {100}, {1, 9}, max_ls));
+  EXPECT_NO_THROW(pool.setRecompute("t1", 8, true));
+  EXPECT_NO_THROW(pool.finalize(nntrainer::BasicPlanner(), 0, 10));
+  EXPECT_EQ(pool.size(), 100 * sizeof(float));
+  EXPECT_NO_THROW(pool.allocate());
+
+  float *data = t1->getData();
+  EXPECT_NO_THROW(pool.activateRecompute(8));
+  EXPECT_EQ(t1->getData(), data);
+
+  EXPECT_NO_THROW(pool.deallocate());
+}
+
 /**
  * @brief Main gtest
  */